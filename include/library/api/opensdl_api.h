@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the definitions for embedding OpenSDL in another
+ *  program.  The SDL source is taken from a buffer, and the output for each
+ *  language, and the diagnostics, are returned in buffers owned by the
+ *  caller.  Nothing is read from the command line, and nothing calls exit.
+ *
+ *  The language plugins are kept between compilations, and are shared by all
+ *  the compilations in the process.  Each is loaded the first time it is
+ *  requested.  They are released by sdl_compile_release, which must not be
+ *  called while any compilation is still running.  A later compilation loads
+ *  them again.  Everything else, including the pool of identifiers in the
+ *  source, belongs to one compilation and is released when it is done.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	16-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_compile_release, to release what is kept between compilations.
+ *
+ *  V01.002	16-OCT-2026	Jonathan D. Belanger
+ *  The identifier pool is no longer kept between compilations.
+ */
+#ifndef _OPENSDL_API_H_
+#define _OPENSDL_API_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * A symbol, and its value, for the IFSYMBOL statements.  This is the same as
+ * the --symbol command line argument.
+ */
+typedef struct
+{
+    const char      *symbol;
+    int             value;
+} SDL_COMPILE_SYMBOL;
+
+/*
+ * The options for a compilation.  Each one is the same as the command line
+ * argument with the same name.  Use sdl_compile_options_init to get the same
+ * defaults as the command line.
+ */
+typedef struct
+{
+    const SDL_COMPILE_SYMBOL *symbols;
+    int             symbolCount;
+    int             alignment;
+    int             wordSize;
+    bool            checkAlignment;
+    bool            comments;
+    bool            header;
+    bool            memberAlign;
+    bool            suppressPrefix;
+    bool            suppressTag;
+} SDL_COMPILE_OPTIONS;
+
+/*
+ * The output generated for one language.  The buffer is null terminated, and
+ * the length does not include the null.
+ */
+typedef struct
+{
+    const char      *lang;
+    char            *buffer;
+    size_t          length;
+} SDL_COMPILE_OUTPUT;
+
+/*
+ * The results of a compilation.  These are released with
+ * sdl_compile_result_free.
+ */
+typedef struct
+{
+    char            *diagnostics;
+    size_t          diagLen;
+    SDL_COMPILE_OUTPUT *outputs;
+    int             outputCount;
+} SDL_COMPILE_RESULT;
+
+void sdl_compile_options_init(SDL_COMPILE_OPTIONS *options);
+uint32_t sdl_compile_buffer(const char *source,
+                            size_t length,
+                            const char *sourceName,
+                            const SDL_COMPILE_OPTIONS *options,
+                            const char **languages,
+                            int langCount,
+                            SDL_COMPILE_RESULT *result);
+void sdl_compile_result_free(SDL_COMPILE_RESULT *result);
+void sdl_compile_release(void);
+
+#endif /* _OPENSDL_API_H_ */
@@ -23,10 +23,52 @@
  *
  *  V01.000	17-NOV-2018	Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  Added the per-module arena functions.
+ *
+ *  V01.002	15-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_arena_alloc, for the identifier pool.
+ *
+ *  V01.003	16-OCT-2026	Jonathan D. Belanger
+ *  Added the memory sites, and the calls to allocate a buffer for one, for
+ *  the memory profile reported by --trace.
+ *
+ *  V01.004	16-OCT-2026	Jonathan D. Belanger
+ *  Added the MemIntern site, which marks the length in front of an interned
+ *  identifier.
  */
 #ifndef _OPENSDL_BLOCKS_H_
 #define _OPENSDL_BLOCKS_H_
 
+/*
+ * The length stored in front of each buffer has this bit set when the buffer
+ * was carved out of an arena.  These buffers are not freed individually.
+ */
+#define SDL_M_ARENA	0x8000000000000000ULL
+
+/*
+ * The length also has the site that allocated the buffer, so that its bytes
+ * can be taken back from the site when it is released.  The blocks are their
+ * own sites, and everything not allocated for one of the other sites is
+ * charged to MemOther.
+ */
+#define SDL_M_MEM_SITE	0x7f00000000000000ULL
+#define SDL_V_MEM_SITE	56
+#define SDL_M_LENGTH	0x00ffffffffffffffULL
+
+typedef enum
+{
+    MemOther = NotABlock,
+    MemString = EntryBlock + 1,
+    MemOptions,
+    MemStateStack,
+    MemCondStack,
+    MemArenaAlloc,
+    MemIntern,
+    MemMax
+} SDL_MEM_SITE;
+
 void sdl_set_trace_memory(void);
 void *sdl_allocate_block(
 		SDL_BLOCK_ID blockID,
@@ -36,9 +78,15 @@ void sdl_deallocate_block(SDL_HEADER *block);
 char *sdl_strupr(const char *string);
 char *sdl_strlwr(const char *string);
 char *sdl_strdup(const char *string);
+char *sdl_strdup_heap(const char *string);
 void *sdl_calloc(size_t count, size_t size);
 void *sdl_realloc(void *ptr, size_t newSize);
+void *sdl_calloc_site(SDL_MEM_SITE site, size_t count, size_t size);
+void *sdl_realloc_site(SDL_MEM_SITE site, void *ptr, size_t newSize);
 void sdl_free(void *ptr);
+void sdl_set_arena(SDL_ARENA *arena);
+void *sdl_arena_alloc(SDL_ARENA *arena, size_t size);
+void sdl_arena_release(SDL_ARENA *arena);
 
 #endif /* _OPENSDL_BLOCKS_H_ */
 
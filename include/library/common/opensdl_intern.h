@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the function prototypes for the identifier pool.
+ *  Each distinct identifier is stored once in a pool, so two identifiers
+ *  interned in the same pool are the same if, and only if, their pointers are
+ *  the same.  Interned strings
+ *  must never be modified.  Passing one to sdl_free does nothing, so they can
+ *  be handed to code that expects an sdl_strdup copy.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	16-OCT-2026	Jonathan D. Belanger
+ *  Removed sdl_intern_hash, which had no callers.
+ *
+ *  V01.002	16-OCT-2026	Jonathan D. Belanger
+ *  The pool is passed to each call, as each compilation has its own.  Added
+ *  sdl_intern_init, and sdl_intern_hash back, which the symbol tables now use
+ *  for interned names.
+ */
+#ifndef _OPENSDL_INTERN_H_
+#define _OPENSDL_INTERN_H_
+
+void sdl_intern_init(SDL_INTERN_POOL *pool);
+char *sdl_intern(SDL_INTERN_POOL *pool, const char *string);
+uint32_t sdl_intern_hash(const char *name);
+void sdl_intern_release(SDL_INTERN_POOL *pool);
+
+#endif /* _OPENSDL_INTERN_H_ */
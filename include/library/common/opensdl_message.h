@@ -23,6 +23,12 @@
  *
  *  V01.000    08-OCT-2018    Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001    15-OCT-2026    Jonathan D. Belanger
+ *  Added SRVSOCKET, for the compile server.
+ *
+ *  V01.002    16-OCT-2026    Jonathan D. Belanger
+ *  Added BADREPLAY, for replaying a recording.
  */
 #ifndef _OPENSDL_MESSAGES_H_
 #define _OPENSDL_MESSAGES_H_
@@ -112,6 +118,8 @@
 #define SDL_PARSEERR            0x00ba027a
 #define SDL_DUPLISTQUAL         0x00ba0292
 #define SDL_CONFLDUPLQ          0x00ba029a
+#define SDL_SRVSOCKET           0x00ba02a2
+#define SDL_BADREPLAY           0x00ba02aa
 
 /*
  * Warning SDL Errors.
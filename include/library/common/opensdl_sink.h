@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the definitions for the output sink given to
+ *  the language plugins.  A sink collects everything written to an output
+ *  file in a buffer that grows as needed, and writes it to the file all at
+ *  once when it is flushed.  The first error is remembered, and later
+ *  writes do nothing, so a plugin need only check for an error when the
+ *  sink is flushed.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#ifndef _OPENSDL_SINK_H_
+#define _OPENSDL_SINK_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * The initial size of the buffer, which is doubled each time it fills.
+ */
+#define SDL_K_SINK_SIZE		8192
+
+typedef struct
+{
+    FILE		*fp;
+    char		*buffer;
+    size_t		size;
+    size_t		used;
+    int			error;
+} SDL_SINK;
+
+void sdl_sink_init(SDL_SINK *sink, FILE *fp);
+int sdl_sink_write(SDL_SINK *sink, const char *buffer, size_t length);
+int sdl_sink_puts(SDL_SINK *sink, const char *string);
+int sdl_sink_putc(SDL_SINK *sink, char character);
+int sdl_sink_dec(SDL_SINK *sink, int64_t value);
+int sdl_sink_hex(SDL_SINK *sink, uint64_t value);
+int sdl_sink_printf(SDL_SINK *sink, const char *format, ...)
+	__attribute__ ((format (printf, 2, 3)));
+int sdl_sink_flush(SDL_SINK *sink);
+int sdl_sink_close(SDL_SINK *sink);
+
+#endif	/* _OPENSDL_SINK_H_ */
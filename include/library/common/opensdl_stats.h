@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the function prototypes for gathering and
+ *  reporting the statistics for the --stats qualifier.  The statistics being
+ *  gathered are kept per thread, and when there are none, nothing is
+ *  gathered, so the calls can be left in place.
+ *
+ * Revision History:
+ *
+ *  V01.000	16-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	16-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_stats_counters, for --counters.
+ */
+#ifndef _OPENSDL_STATS_H_
+#define _OPENSDL_STATS_H_
+
+#define SDL_K_STATS_TEXT    0
+#define SDL_K_STATS_JSON    1
+
+SDL_STATS *sdl_stats_set(SDL_STATS *stats);
+bool sdl_stats_counters(void);
+bool sdl_stats_init(SDL_STATS *stats, uint32_t langCount);
+void sdl_stats_finish(SDL_STATS *stats);
+void sdl_stats_free(SDL_STATS *stats);
+void sdl_stats_clock(SDL_STATS_CLOCK *clock);
+void sdl_stats_begin(SDL_STATS_PHASE phase);
+void sdl_stats_end(void);
+void sdl_stats_block(SDL_BLOCK_ID blockID);
+void sdl_stats_lookup(void);
+void sdl_stats_insert(void);
+void sdl_stats_token(void);
+void sdl_stats_lang(SDL_STATS *stats,
+                    uint32_t langId,
+                    SDL_STATS_CLOCK *start);
+void sdl_stats_write(FILE *fp, SDL_STATS *stats, char *name, bool json);
+
+#endif /* _OPENSDL_STATS_H_ */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the definitions for the symbol tables used to
+ *  index the DECLARE, ITEM, AGGREGATE, ENUM and LOCAL definitions by name and
+ *  by type ID.  The symbol tables are an index only, the blocks themselves
+ *  remain on their queues so that they are emitted in the order parsed.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	16-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_symtab_insert_hash and sdl_symtab_lookup_hash.
+ */
+#ifndef _OPENSDL_SYMTAB_H_
+#define _OPENSDL_SYMTAB_H_
+
+#include <stdint.h>
+
+/*
+ * The initial number of name buckets (must be a power of 2) and the number of
+ * type IDs added to the type ID vector each time it needs to grow.
+ */
+#define SDL_K_SYMTAB_SIZE	64
+#define SDL_K_SYMTAB_ID_INCR	256
+
+/*
+ * The following definitions are used to maintain a symbol table.  The names
+ * are not copied, the pointer to the name in the indexed block is saved.
+ */
+typedef struct
+{
+    char		*name;
+    void		*block;
+    uint32_t		hash;
+} SDL_SYMTAB_ENTRY;
+
+typedef struct
+{
+    SDL_SYMTAB_ENTRY	*bucket;
+    void		**byID;
+    uint32_t		bucketSize;
+    uint32_t		bucketUsed;
+    int			baseID;
+    int			idSize;
+} SDL_SYMTAB;
+
+void sdl_symtab_init(SDL_SYMTAB *symtab, int baseID);
+uint32_t sdl_symtab_hash(const char *name);
+uint32_t sdl_symtab_insert(
+		SDL_SYMTAB *symtab,
+		char *name,
+		int typeID,
+		void *block);
+uint32_t sdl_symtab_insert_hash(
+		SDL_SYMTAB *symtab,
+		char *name,
+		uint32_t hash,
+		int typeID,
+		void *block);
+void *sdl_symtab_lookup(SDL_SYMTAB *symtab, const char *name);
+void *sdl_symtab_lookup_hash(
+		SDL_SYMTAB *symtab,
+		const char *name,
+		uint32_t hash);
+void *sdl_symtab_lookup_id(SDL_SYMTAB *symtab, int typeID);
+void sdl_symtab_reset(SDL_SYMTAB *symtab);
+
+#endif	/* _OPENSDL_SYMTAB_H_ */
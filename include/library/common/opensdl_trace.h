@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the definitions for the trace.  When tracing is
+ *  turned on, each call that is traced records a small binary event in a
+ *  ring buffer kept for the thread making it, rather than writing out a
+ *  line of text.  The ring buffers are written to the trace file when the
+ *  image exits, or when it is about to be terminated by a signal, and are
+ *  turned into text by the OpenSDL_trace utility.
+ *
+ *  In a release build (NDEBUG defined), the trace is compiled out
+ *  altogether, unless SDL_TRACE_ENABLE is also defined.
+ *
+ * Revision History:
+ *
+ *  V01.000	16-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#ifndef _OPENSDL_TRACE_H_
+#define _OPENSDL_TRACE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if !defined(NDEBUG) || defined(SDL_TRACE_ENABLE)
+#define SDL_TRACE_ENABLED   1
+#endif
+
+#define SDL_K_TRACE_MAGIC       "OpenSDLt"
+#define SDL_K_TRACE_MAGIC_LEN   8
+#define SDL_K_TRACE_VERSION     1
+#define SDL_K_TRACE_FILE        "opensdl.sdltrace"
+#define SDL_K_TRACE_ARGS        4
+
+/*
+ * The number of events kept for each thread, which must be a power of 2.
+ * Once a ring buffer is full, each new event replaces the oldest one.
+ */
+#define SDL_K_TRACE_EVENTS      16384
+
+/*
+ * Each place an event is recorded from has one of these, in static storage.
+ * It is given an identifier the first time an event is recorded from it.
+ */
+typedef struct
+{
+    const char      *name;
+    const char      *file;
+    uint32_t        line;
+    uint32_t        argCount;
+    uint32_t        id;
+} SDL_TRACE_SITE;
+
+typedef struct
+{
+    uint64_t        timestamp;
+    uint32_t        siteID;
+    uint32_t        thread;
+    int64_t         arg[SDL_K_TRACE_ARGS];
+} SDL_TRACE_EVENT;
+
+/*
+ * A trace file starts with this header, followed by a record for each of the
+ * places an event was recorded from, and then a record for each of the ring
+ * buffers.  A place record is followed by its name and then its file name,
+ * neither of them null-terminated.  A ring buffer record is followed by its
+ * events, oldest first.  Everything is in the byte order of the machine the
+ * trace was made on.
+ */
+typedef struct
+{
+    char            magic[SDL_K_TRACE_MAGIC_LEN];
+    uint32_t        version;
+    uint32_t        siteCount;
+    uint32_t        ringCount;
+    uint32_t        eventSize;
+} SDL_TRACE_HEADER;
+
+typedef struct
+{
+    uint32_t        id;
+    uint32_t        line;
+    uint32_t        argCount;
+    uint32_t        nameLength;
+    uint32_t        fileLength;
+    uint32_t        reserved;
+} SDL_TRACE_SITE_REC;
+
+typedef struct
+{
+    uint64_t        recorded;
+    uint32_t        count;
+    uint32_t        reserved;
+} SDL_TRACE_RING_REC;
+
+typedef void (*SDL_TRACE_FUNC)(SDL_TRACE_SITE *site,
+                               int64_t arg0,
+                               int64_t arg1,
+                               int64_t arg2,
+                               int64_t arg3);
+
+void sdl_trace_event(SDL_TRACE_SITE *site,
+                     int64_t arg0,
+                     int64_t arg1,
+                     int64_t arg2,
+                     int64_t arg3);
+bool sdl_trace_init(char *fileName);
+bool sdl_trace_dump(void);
+
+/*
+ * SDL_TRACE_AT records an event, from the place it is used, when flag is
+ * true, by calling func.  The others record an event with up to 4 integer
+ * arguments, when the trace flag is set, and are what is normally used.
+ */
+#ifdef SDL_TRACE_ENABLED
+#define SDL_TRACE_AT(flag, func, name, count, arg0, arg1, arg2, arg3)      \
+    do                                                                      \
+    {                                                                       \
+        if ((flag) == true)                                                 \
+        {                                                                   \
+            static SDL_TRACE_SITE _sdl_trace_site =                         \
+                {(name), __FILE__, __LINE__, (count), 0};                   \
+                                                                            \
+            (func)(&_sdl_trace_site,                                        \
+                   (int64_t) (arg0),                                        \
+                   (int64_t) (arg1),                                        \
+                   (int64_t) (arg2),                                        \
+                   (int64_t) (arg3));                                       \
+        }                                                                   \
+    } while (0)
+#else
+#define SDL_TRACE_AT(flag, func, name, count, arg0, arg1, arg2, arg3)      \
+    do                                                                      \
+    {                                                                       \
+    } while (0)
+#endif
+
+#define SDL_TRACE(name)                                                     \
+    SDL_TRACE_AT(trace, sdl_trace_event, name, 0, 0, 0, 0, 0)
+#define SDL_TRACE1(name, arg0)                                              \
+    SDL_TRACE_AT(trace, sdl_trace_event, name, 1, arg0, 0, 0, 0)
+#define SDL_TRACE2(name, arg0, arg1)                                        \
+    SDL_TRACE_AT(trace, sdl_trace_event, name, 2, arg0, arg1, 0, 0)
+#define SDL_TRACE3(name, arg0, arg1, arg2)                                  \
+    SDL_TRACE_AT(trace, sdl_trace_event, name, 3, arg0, arg1, arg2, 0)
+#define SDL_TRACE4(name, arg0, arg1, arg2, arg3)                            \
+    SDL_TRACE_AT(trace, sdl_trace_event, name, 4, arg0, arg1, arg2, arg3)
+
+/*
+ * A call given the location of what was parsed records the location as its
+ * 4 arguments.
+ */
+#define SDL_TRACE_LOC(name, loc)                                            \
+    SDL_TRACE4(name,                                                        \
+               (loc)->first_line,                                           \
+               (loc)->first_column,                                         \
+               (loc)->last_line,                                            \
+               (loc)->last_column)
+
+#endif /* _OPENSDL_TRACE_H_ */
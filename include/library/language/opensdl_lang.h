@@ -26,6 +26,10 @@
  *
  *  V01.001	06-SEP-2018	Jonathan D. Belanger
  *  Updated the copyright to be GNUGPL V3 compliant.
+ *
+ *  V01.002	15-OCT-2026	Jonathan D. Belanger
+ *  Added SDL_LANG_MEMBER and SDL_LANG_LAYOUT, the layout of a whole
+ *  AGGREGATE.
  */
 #ifndef _OPENSDL_LANG_H_
 #define _OPENSDL_LANG_H_ 1
@@ -66,4 +70,51 @@ typedef struct
     };
 } SDL_LANG_AGGR;
 
+/*
+ * The layout of an AGGREGATE is a flat array, with an entry for each call
+ * that would be made to the sdl_c_aggregate function, in the same order.  So
+ * there is an entry to start and one to end the AGGREGATE and each of its
+ * subaggregates, and an entry for each ITEM and comment.  Everything that
+ * does not depend on the language has already been determined.
+ *
+ *  name:           The prefix, tag and identifier (for the AGGREGATE, the
+ *                  marker is used in place of the prefix), as they are to be
+ *                  output.  The first prefixLength characters came from the
+ *                  prefix.  NULL for a comment.
+ *  typeID:         The type, with any user type that is an ITEM or
+ *                  AGGREGATE resolved to the type it was declared as.
+ *  baseType:       The type to be declared.  For an ADDRESS or POINTER, this
+ *                  is the resolved type of what is pointed to.  For an
+ *                  AGGREGATE or subaggregate, typeID and baseType are the
+ *                  aggregate type.  Both are -1 if the type could not be
+ *                  resolved.
+ *  typeName:       When baseType is a DECLARE, its name, as for name.
+ *  elements:       The number of elements, when dimensioned, otherwise 0.
+ */
+typedef struct
+{
+    SDL_LANG_AGGR       param;
+    char                *name;
+    char                *typeName;
+    int64_t             offset;
+    int64_t             size;
+    int64_t             length;
+    int64_t             elements;
+    int                 bitOffset;
+    int                 typeID;
+    int                 baseType;
+    int                 depth;
+    uint16_t            prefixLength;
+    uint16_t            typePrefixLength;
+    SDL_LANG_AGGR_TYPE  type;
+    bool                ending;
+    bool                _unsigned;
+} SDL_LANG_MEMBER;
+typedef struct _sdl_lang_layout
+{
+    SDL_AGGREGATE       *aggregate;
+    SDL_LANG_MEMBER     *members;
+    uint32_t            memberCount;
+} SDL_LANG_LAYOUT;
+
 #endif	/* _OPENSDL_LANG_H_ */
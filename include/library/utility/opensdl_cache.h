@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the definitions and function prototypes for the
+ *  output cache.  The output files generated from an input file are kept in a
+ *  cache directory, and are used again when the input file, the INCLUDE files
+ *  it used, the arguments and the plugins have not changed.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	16-OCT-2026	Jonathan D. Belanger
+ *  Added the hash and write functions, which are shared with the precompiled
+ *  INCLUDE files.
+ *
+ *  V01.002	16-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_cache_hash_image.
+ */
+#ifndef _OPENSDL_CACHE_H_
+#define _OPENSDL_CACHE_H_
+
+/*
+ * The key for an input file is a 64-bit hash, as hexadecimal digits.
+ */
+#define SDL_K_CACHE_KEY_LEN	16
+typedef char SDL_CACHE_KEY[SDL_K_CACHE_KEY_LEN + 1];
+
+/*
+ * The hash is the 64-bit FNV-1a hash, which starts with this value.
+ */
+#define SDL_K_FNV64_BASIS	0xcbf29ce484222325ULL
+
+uint32_t sdl_cache_key(SDL_CONTEXT *context,
+                       const char *fileName,
+                       SDL_CACHE_KEY key);
+bool sdl_cache_fetch(const char *cacheDir,
+                     SDL_CACHE_KEY key,
+                     SDL_CONTEXT *context,
+                     char **outFileName);
+uint32_t sdl_cache_store(const char *cacheDir,
+                         SDL_CACHE_KEY key,
+                         SDL_CONTEXT *context,
+                         char **outFileName,
+                         const char *diagnostics,
+                         size_t diagLen);
+uint64_t sdl_cache_hash(uint64_t hash, const void *data, size_t length);
+uint64_t sdl_cache_hash_str(uint64_t hash, const char *str);
+bool sdl_cache_hash_image(uint64_t *hash);
+bool sdl_cache_write(const char *fileName,
+                     const char *buffer,
+                     size_t length);
+
+#endif /* _OPENSDL_CACHE_H_ */
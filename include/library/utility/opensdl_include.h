@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the function prototypes for the INCLUDE file
+ *  cache.  When the cache is enabled, the contents of each INCLUDE file are
+ *  kept in memory, and are used for as long as the file is not changed.  It
+ *  also has the functions for the list of INCLUDE files a compilation opened,
+ *  and for mapping an input file into memory, so that it can be scanned
+ *  where it is.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_include_record and sdl_include_list_free.
+ *
+ *  V01.002	16-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_include_map and sdl_include_unmap.
+ */
+#ifndef _OPENSDL_INCLUDE_H_
+#define _OPENSDL_INCLUDE_H_
+
+void sdl_include_cache_enable(void);
+FILE *sdl_include_open(const char *fileName);
+uint32_t sdl_include_cache_load(const char *fileName);
+void sdl_include_write_misses(FILE *fp);
+void sdl_include_cache_release(void);
+uint32_t sdl_include_record(SDL_INPUT_LIST *list, const char *fileName);
+void sdl_include_list_free(SDL_INPUT_LIST *list);
+char *sdl_include_map(FILE *fp, size_t *length);
+void sdl_include_unmap(char *map, size_t length);
+
+#endif /* _OPENSDL_INCLUDE_H_ */
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the function prototypes for building the module
+ *  IR as a MODULE is parsed, and emitting it to the plugins once END_MODULE
+ *  has been parsed.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  sdl_ir_emit takes a mask of the languages to be emitted.
+ */
+#ifndef _OPENSDL_IR_H_
+#define _OPENSDL_IR_H_
+
+void sdl_ir_begin(SDL_CONTEXT *context);
+uint32_t sdl_ir_add(SDL_CONTEXT *context, SDL_IR_TYPE type, void *data);
+uint32_t sdl_ir_comment(SDL_CONTEXT *context,
+                        char *comment,
+                        bool lineComment,
+                        bool startComment,
+                        bool middleComment,
+                        bool endComment);
+uint32_t sdl_ir_end(SDL_CONTEXT *context);
+uint32_t sdl_ir_emit(SDL_CONTEXT *context, SDL_MODULE_IR *ir, bool *langMask);
+void sdl_ir_reset(SDL_CONTEXT *context);
+
+#endif /* _OPENSDL_IR_H_ */
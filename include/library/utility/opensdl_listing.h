@@ -22,13 +22,16 @@
  *
  *  V01.000	25-AUG-2018	Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  The write routines take the listing state from the context.
  */
 #ifndef _OPENSDL_LISTING_H_
 #define _OPENSDL_LISTING_H_
 
 FILE *sdl_open_list(SDL_CONTEXT *context);
-void sdl_write_list(FILE *fp, char *buf, size_t len);
-void sdl_write_err(FILE *fp, char *msgText);
+void sdl_write_list(SDL_LISTING *listing, char *buf, size_t len);
+void sdl_write_err(SDL_LISTING *listing, char *msgText);
 void sdl_close_list(SDL_CONTEXT *context);
 
 #endif /* _OPENSDL_LISTING_H_ */
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the function prototypes for writing output
+ *  files.  In update mode, an output file is only replaced when what would
+ *  be written to it is different from what is already in it.  It also has
+ *  the function that writes a dependency file for make, which Ninja also
+ *  reads.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_output_depfile.
+ *
+ *  V01.002	16-OCT-2026	Jonathan D. Belanger
+ *  Removed the Ninja dyndep format from sdl_output_depfile.
+ */
+#ifndef _OPENSDL_OUTPUT_H_
+#define _OPENSDL_OUTPUT_H_
+
+FILE *sdl_output_open(const char *fileName, bool update, char **tmpName);
+uint32_t sdl_output_commit(const char *fileName, char *tmpName);
+uint32_t sdl_output_write(const char *fileName,
+                          const char *buffer,
+                          size_t length,
+                          bool update);
+uint32_t sdl_output_depfile(SDL_CONTEXT *context,
+                            const char *depFileName,
+                            const char *fileName,
+                            char **outFileName);
+
+#endif /* _OPENSDL_OUTPUT_H_ */
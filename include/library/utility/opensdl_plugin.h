@@ -31,6 +31,22 @@
  *
  *  V01.000 13-Apr-2019 Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001 15-OCT-2026 Jonathan D. Belanger
+ *  Added SDL_API_OUTPUT_SINK, which gives the plugin an output sink to write
+ *  to, rather than writing directly to the output file.
+ *
+ *  V01.002 15-OCT-2026 Jonathan D. Belanger
+ *  Added SDL_API_AGGREGATE_V2, which gives the plugin the layout of a whole
+ *  AGGREGATE in a single call.
+ *
+ *  V01.003 15-OCT-2026 Jonathan D. Belanger
+ *  Added SDL_PLUGIN_ONLOAD, so that a language can be built into the OpenSDL
+ *  image.
+ *
+ *  V01.004 16-OCT-2026 Jonathan D. Belanger
+ *  Added SDL_API_TRACE_EVENT, which gives the plugin the function to record
+ *  its trace events with.
  */
 #ifndef _OPENSDL_PLUGIN_H_
 #define _OPENSDL_PLUGIN_H_
@@ -50,6 +66,7 @@
 #include "opensdl_defs.h"
 #include "library/language/opensdl_lang.h"
 #include "library/common/opensdl_message.h"
+#include "library/common/opensdl_trace.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -73,7 +90,7 @@ typedef struct
 #define SDL_VER_TYPE_RC         'R'
 #define SDL_VER_TYPE_RELEASE    'V'
 #define SDL_API_VERSION_MAJOR   1
-#define SDL_API_VERSION_MINOR   0
+#define SDL_API_VERSION_MINOR   2
 #define SDL_API_VERSION_PATCH   0
 
 typedef uint32_t (*sdl_plugin_commentStars)(void);
@@ -96,6 +113,15 @@ typedef uint32_t (*sdl_plugin_aggregate)(void *param,
                                          bool ending,
                                          int depth,
                                          SDL_CONTEXT *context);
+
+/*
+ * A plugin that returns an SDL_API_AGGREGATE_V2 function is given the layout
+ * of each AGGREGATE (see opensdl_lang.h) in a single call, rather than
+ * having its SDL_API_AGGREGATE function called for each entry in it.  The
+ * layout is shared by all the languages, and must not be changed.
+ */
+typedef uint32_t (*sdl_plugin_aggregateV2)(SDL_LANG_LAYOUT *layout,
+                                           SDL_CONTEXT *context);
 typedef uint32_t (*sdl_plugin_entry)(SDL_ENTRY *entry, SDL_CONTEXT *context);
 typedef uint32_t (*sdl_plugin_literal)(char *line);
 typedef uint32_t (*sdl_plugin_close)(void);
@@ -121,6 +147,9 @@ typedef enum
     SDL_API_FILE_EXTENSION,
     SDL_API_LITERAL,
     SDL_API_CLOSE,
+    SDL_API_OUTPUT_SINK,
+    SDL_API_AGGREGATE_V2,
+    SDL_API_TRACE_EVENT,
     SDL_API_MAX
 } SDL_API_TAG;
 
@@ -134,6 +163,7 @@ typedef struct
         bool *sdl_tv_boolean;
         char *sdl_tv_string;
         FILE *sdl_tv_fp;
+        SDL_SINK *sdl_tv_sink;
         SDL_MSG_VECTOR *sdl_tv_msgVec;
         sdl_plugin_commentStars sdl_tv_commentStars;
         sdl_plugin_createdByInfo sdl_tv_createdByInfo;
@@ -145,14 +175,28 @@ typedef struct
         sdl_plugin_constant sdl_tv_constant;
         sdl_plugin_enumerate sdl_tv_enumerate;
         sdl_plugin_aggregate sdl_tv_aggregate;
+        sdl_plugin_aggregateV2 sdl_tv_aggregateV2;
         sdl_plugin_entry sdl_tv_entry;
         sdl_plugin_literal sdl_tv_literal;
         sdl_plugin_close sdl_tv_close;
+        SDL_TRACE_FUNC sdl_tv_traceEvent;
     };
 } SDL_API_TV;
 
 typedef uint32_t (*sdl_plugin_onload)(SDL_API_TV *tv);
 
+/*
+ * A language can also be built into the OpenSDL image, rather than being a
+ * shared library, by compiling it with SDL_BUILTIN_LANG defined.  Its onLoad
+ * function is then named sdl_<language>_onLoad, so that more than one
+ * language can be built in.
+ */
+#ifdef SDL_BUILTIN_LANG
+#define SDL_PLUGIN_ONLOAD(lang) sdl_ ## lang ## _onLoad
+#else
+#define SDL_PLUGIN_ONLOAD(lang) onLoad
+#endif
+
 #ifdef __cplusplus
 }
 #endif
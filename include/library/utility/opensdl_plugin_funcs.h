@@ -24,6 +24,26 @@
  *
  *  V01.000	14-Apr-2019 Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001	15-OCT-2026 Jonathan D. Belanger
+ *  sdl_load_plugin and sdl_load_fp take the context.  Added
+ *  sdl_unload_plugins.
+ *
+ *  V01.002	15-OCT-2026 Jonathan D. Belanger
+ *  The header calls take the language enabled array.  Added sdl_plugin_count
+ *  and sdl_plugin_lang.
+ *
+ *  V01.003	15-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_plugin_image.
+ *
+ *  V01.004	15-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_plugin_attach.
+ *
+ *  V01.005	15-OCT-2026	Jonathan D. Belanger
+ *  sdl_plugin_attach takes the output sink.
+ *
+ *  V01.006	15-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_call_layout.
  */
 #ifndef _OPENSDL_PLUGIN_FUNCS_H_
 #define _OPENSDL_PLUGIN_FUNCS_H_
@@ -31,11 +51,18 @@
 #include "../language/opensdl_lang.h"
 #include "opensdl_defs.h"
 
-uint32_t sdl_load_plugin(char *lang, char **fileExt, uint32_t *langId);
-uint32_t sdl_load_fp(uint32_t langId, FILE *fp);
-uint32_t sdl_call_commentStars(void);
-uint32_t sdl_call_createdByInfo(struct tm *timeInfo);
-uint32_t sdl_call_fileInfo(struct tm *timeInfo, char *filePath);
+uint32_t sdl_load_plugin(SDL_CONTEXT *context,
+                         char *lang,
+                         char **fileExt,
+                         uint32_t *langId);
+uint32_t sdl_load_fp(SDL_CONTEXT *context, uint32_t langId, FILE *fp);
+uint32_t sdl_plugin_attach(uint32_t langId,
+                           FILE *fp,
+                           SDL_SINK *sink,
+                           SDL_MSG_VECTOR *msgVec);
+uint32_t sdl_call_commentStars(bool *langEna);
+uint32_t sdl_call_createdByInfo(bool *langEna, struct tm *timeInfo);
+uint32_t sdl_call_fileInfo(bool *langEna, struct tm *timeInfo, char *filePath);
 uint32_t sdl_call_comment(bool *langEna,
                           char *comment,
                           bool lineComment,
@@ -57,8 +84,15 @@ uint32_t sdl_call_aggregate(bool *langEna,
                             bool ending,
                             int depth,
                             SDL_CONTEXT *context);
+uint32_t sdl_call_layout(bool *langEna,
+                         SDL_LANG_LAYOUT *layout,
+                         SDL_CONTEXT *context);
 uint32_t sdl_call_entry(bool *langEna, SDL_ENTRY *entry, SDL_CONTEXT *context);
 uint32_t sdl_call_literal(bool *langEna, char *line);
 uint32_t sdl_call_close(void);
+uint32_t sdl_plugin_count(void);
+char *sdl_plugin_lang(uint32_t langId);
+char *sdl_plugin_image(uint32_t langId);
+void sdl_unload_plugins(void);
 
 #endif /* _OPENSDL_PLUGIN_FUNCS_H_ */
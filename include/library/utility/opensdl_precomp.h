@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the definitions and function prototypes for
+ *  precompiled INCLUDE files.  An INCLUDE file that is included outside of a
+ *  MODULE is kept in the cache directory as a recording of the module IR for
+ *  each of its MODULEs, with their DECLAREs, ITEMs, AGGREGATEs and
+ *  CONSTANTs (see opensdl_record.h).  The next time it is included, it is
+ *  replayed, rather than being scanned and parsed again, as long as it and
+ *  every file it INCLUDEs have not changed.
+ *
+ * Revision History:
+ *
+ *  V01.000	16-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#ifndef _OPENSDL_PRECOMP_H_
+#define _OPENSDL_PRECOMP_H_
+
+#define SDL_K_PRECOMP_MAGIC     "OpenSDLp"
+#define SDL_K_PRECOMP_MAGIC_LEN 8
+#define SDL_K_PRECOMP_VERSION   1
+#define SDL_K_PRECOMP_EXT       "sdlpcm"
+
+/*
+ * A precompiled INCLUDE file starts with this header, followed by the files
+ * it was made from, and then the recording.  Everything is in the byte order
+ * of the machine it was made on, and each part starts on an 8 byte boundary,
+ * so that the file can be mapped into memory and used where it is.
+ */
+typedef struct
+{
+    char            magic[SDL_K_PRECOMP_MAGIC_LEN];
+    uint32_t        version;
+    uint32_t        fileCount;
+    uint64_t        fileLength;
+    uint64_t        bodyLength;
+    uint64_t        bodyHash;
+} SDL_PRECOMP_HEADER;
+
+/*
+ * Each of the files has the size and modification time it had when it was
+ * read, followed by its name, null-terminated and padded to an 8 byte
+ * boundary.  The name length includes the null-terminator.
+ */
+typedef struct
+{
+    int64_t         size;
+    int64_t         mtimeSec;
+    int64_t         mtimeNsec;
+    uint32_t        nameLength;
+    uint32_t        reserved;
+} SDL_PRECOMP_FILE;
+
+uint32_t sdl_precomp_include(SDL_CONTEXT *context,
+                             char *fileName,
+                             bool *loaded,
+                             bool *precompile);
+void sdl_precomp_node(SDL_CONTEXT *context, SDL_IR_NODE *node);
+void sdl_precomp_module(SDL_CONTEXT *context);
+void sdl_precomp_end(SDL_CONTEXT *context);
+void sdl_precomp_release(SDL_CONTEXT *context);
+
+#endif /* _OPENSDL_PRECOMP_H_ */
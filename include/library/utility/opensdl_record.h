@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the definitions for recording the calls made to
+ *  the language plugins, and replaying a recording to the plugins without
+ *  parsing anything.  The recorder is the built-in "record" language, whose
+ *  output file is the recording.
+ *
+ * Revision History:
+ *
+ *  V01.000	16-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	16-OCT-2026	Jonathan D. Belanger
+ *  Added the languages record, and recordings made from the module IR.
+ */
+#ifndef _OPENSDL_RECORD_H_
+#define _OPENSDL_RECORD_H_
+
+/*
+ * A recording starts with the magic string, followed by the version of the
+ * recording format, and then one record for each call made to the recorder,
+ * in the order they were made.  A record is an event code followed by what
+ * was passed on the call.  Integers are written as variable length integers,
+ * 7 bits at a time, low order first, with signed integers zig-zag encoded
+ * first.  Strings are written as their length plus 1 (0 for a NULL pointer),
+ * followed by the string and its null-terminator, so that they can be used
+ * where they are in the recording.
+ *
+ * A recording made from the module IR, rather than by the record language,
+ * also has a languages record ahead of any call that is not made to the same
+ * languages as the one before it.  It has the number of languages, then a
+ * flag for each of them.  Until the first one, the calls are made to the
+ * languages that are enabled.
+ */
+#define SDL_K_RECORD_MAGIC      "OpenSDL\032"
+#define SDL_K_RECORD_MAGIC_LEN  8
+#define SDL_K_RECORD_VERSION    1
+#define SDL_K_RECORD_EXT        "sdlrec"
+
+typedef enum
+{
+    RecNull,
+    RecCommentStars,
+    RecCreatedBy,
+    RecFileInfo,
+    RecComment,
+    RecModule,
+    RecModuleEnd,
+    RecItem,
+    RecConstant,
+    RecEnumerate,
+    RecAggregate,
+    RecEntry,
+    RecLiteral,
+    RecClose,
+    RecLanguages,
+    RecMax
+} SDL_RECORD_EVENT;
+
+/*
+ * A recording being made from the module IR.  It is kept in a sink that is
+ * never flushed, so the caller can write it out wherever it needs to go.
+ */
+typedef struct
+{
+    SDL_SINK        sink;
+    bool            *langEna;
+    bool            langRecorded;
+} SDL_RECORDING;
+
+uint32_t sdl_replay_file(SDL_CONTEXT *context, FILE *fp);
+uint32_t sdl_replay_buffer(SDL_CONTEXT *context,
+                           uint8_t *buffer,
+                           size_t length,
+                           char *name);
+bool sdl_record_init(SDL_RECORDING *recording);
+bool sdl_record_node(SDL_RECORDING *recording,
+                     SDL_IR_NODE *node,
+                     SDL_CONTEXT *context);
+void sdl_record_finish(SDL_RECORDING *recording);
+void sdl_record_free(SDL_RECORDING *recording);
+
+#endif /* _OPENSDL_RECORD_H_ */
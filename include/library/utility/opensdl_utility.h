@@ -23,10 +23,18 @@
  *
  *  V01.000	04-OCT-2018	Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  sdl_str2int takes the context, for its message vector.
+ *
+ *  V01.002	16-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_context_init and sdl_context_free.
  */
 #ifndef _OPENSDL_UTILITY_H_
 #define _OPENSDL_UTILITY_H_
 
+uint32_t sdl_context_init(SDL_CONTEXT *context, uint32_t pluginCount);
+void sdl_context_free(SDL_CONTEXT *context);
 uint32_t sdl_state_transition(
 		SDL_CONTEXT *context,
 		SDL_STATE action,
@@ -41,7 +49,7 @@ uint32_t sdl_get_local(SDL_CONTEXT *context, char *name, __int64_t *value);
 int sdl_usertype_idx(SDL_CONTEXT *context, char *usertype);
 int sdl_aggrtype_idx(SDL_CONTEXT *context, char *aggregateName);
 int64_t sdl_bin2int(char *binStr);
-uint32_t sdl_str2int(char *strVal, int64_t *val);
+uint32_t sdl_str2int(SDL_CONTEXT *context, char *strVal, int64_t *val);
 int64_t sdl_offset(SDL_CONTEXT *context, int offsetType, SDL_YYLTYPE *loc);
 int sdl_dimension(SDL_CONTEXT *context, size_t lbound, size_t hbound);
 uint32_t sdl_add_option(
@@ -22,12 +22,14 @@
  *
  *  V01.000	08-NOV-2018	Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  The message vector and listing file are now kept in the context.  Only
+ *  the trace flag, which is set once at start-up, remains global.
  */
 #ifndef _OPENSDL_MAIN_H_
 #define _OPENSDL_MAIN_H_
 
 extern _Bool trace;
-extern SDL_MSG_VECTOR msgVec[];
-extern FILE *listingFP;
 
 #endif /* _OPENSDL_MAIN_H_ */
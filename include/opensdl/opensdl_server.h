@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This header file contains the definitions for the compile server and its
+ *  client.  The client sends its working directory, its command line
+ *  arguments, and its standard output and error, over a Unix domain socket.
+ *  The server runs the command line in a child process, which writes straight
+ *  to the client's standard output and error, and sends back the exit status.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#ifndef _OPENSDL_SERVER_H_
+#define _OPENSDL_SERVER_H_
+
+/*
+ * A request starts with this header, sent along with the client's standard
+ * output and error file descriptors.  It is followed by the working directory
+ * and then each of the arguments, each null terminated.
+ */
+#define SDL_K_SERVER_MAGIC	0x4c445353
+#define SDL_K_SERVER_MAXREQ	(1024 * 1024)
+
+typedef struct
+{
+    uint32_t	magic;
+    uint32_t	argc;
+    uint32_t	length;
+} SDL_SERVER_REQUEST;
+
+/*
+ * The function the server calls, in the child process, to run a command line.
+ * This is the same as main.
+ */
+typedef int (*SDL_SERVER_MAIN)(int argc, char *argv[]);
+
+uint32_t sdl_server(SDL_CONTEXT *context,
+                    char *socketPath,
+                    SDL_SERVER_MAIN compile);
+bool sdl_client(char *socketPath, int argc, char *argv[], int *exitStatus);
+
+#endif /* _OPENSDL_SERVER_H_ */
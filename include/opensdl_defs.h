@@ -33,16 +33,101 @@
  *
  *  V01.003 14-OCT-2018 Jonathan D. Belanger
  *  Added a block header definition to be used for all allocated blocks.
+ *
+ *  V01.004 15-OCT-2026 Jonathan D. Belanger
+ *  Added symbol tables to the DECLARE, ITEM, AGGREGATE and ENUM lists, and for
+ *  the local variables, so that lookups do not have to walk the queues.
+ *
+ *  V01.005 15-OCT-2026 Jonathan D. Belanger
+ *  Added the per-module memory arena.
+ *
+ *  V01.006 15-OCT-2026 Jonathan D. Belanger
+ *  The message vector, listing, literal queue and scanner state are now kept
+ *  in the context, so that each context is an independent compilation.
+ *
+ *  V01.007 15-OCT-2026 Jonathan D. Belanger
+ *  Added the list of input files, the number of jobs, and the file to which
+ *  a compilation writes its diagnostics.
+ *
+ *  V01.008 15-OCT-2026 Jonathan D. Belanger
+ *  Added the status of a parse that was abandoned.
+ *
+ *  V01.009 15-OCT-2026 Jonathan D. Belanger
+ *  Added the output cache directory argument, and the list of INCLUDE files
+ *  opened while compiling.
+ *
+ *  V01.010 15-OCT-2026 Jonathan D. Belanger
+ *  Added the update argument, to only replace output files that change.
+ *
+ *  V01.011 15-OCT-2026 Jonathan D. Belanger
+ *  Added the dependency file arguments.
+ *
+ *  V01.012 15-OCT-2026 Jonathan D. Belanger
+ *  Added the module IR, which records everything that generates output until
+ *  END_MODULE, when it is emitted to the plugins.
+ *
+ *  V01.013 15-OCT-2026 Jonathan D. Belanger
+ *  Added the output file for each language to the context, so that each
+ *  language can be emitted on a thread of its own.
+ *
+ *  V01.014 15-OCT-2026 Jonathan D. Belanger
+ *  Added the output sink for each language to the context.
+ *
+ *  V01.015 15-OCT-2026 Jonathan D. Belanger
+ *  An AGGREGATE node in the module IR refers to the layout of the AGGREGATE.
+ *
+ *  V01.016 16-OCT-2026 Jonathan D. Belanger
+ *  Added the replay argument.
+ *
+ *  V01.017 16-OCT-2026 Jonathan D. Belanger
+ *  Added the INCLUDE file being precompiled and the number of diagnostics
+ *  reported to the context, and the precompile flag to the file list.
+ *
+ *  V01.018 16-OCT-2026 Jonathan D. Belanger
+ *  Added the memory mapped contents of an INCLUDE file to the file list.
+ *
+ *  V01.019 16-OCT-2026 Jonathan D. Belanger
+ *  Added the indicator to the scanner state that an inactive IFSYMBOL
+ *  region is to be skipped.
+ *
+ *  V01.020 16-OCT-2026 Jonathan D. Belanger
+ *  Added the variants given on the command line, and the token recording
+ *  being replayed to the parser.
+ *
+ *  V01.021 16-OCT-2026 Jonathan D. Belanger
+ *  Added the statistics gathered for the --stats qualifier.
+ *
+ *  V01.022 16-OCT-2026 Jonathan D. Belanger
+ *  The conditional state stack is grown by whole entries, before the entry
+ *  being pushed would be past the end of it.
+ *
+ *  V01.023 16-OCT-2026 Jonathan D. Belanger
+ *  Added the hardware counters gathered for the --counters qualifier.
+ *
+ *  V01.024 16-OCT-2026 Jonathan D. Belanger
+ *  Removed the argument for --dyndep.
+ *
+ *  V01.025 16-OCT-2026 Jonathan D. Belanger
+ *  Added the count of characters put back by the scanner that are already in
+ *  the listing.
+ *
+ *  V01.026 16-OCT-2026 Jonathan D. Belanger
+ *  Added the identifier pool to the context, so that each compilation has
+ *  its own.
  */
 #ifndef _OPENSDL_DEFS_H_
 #define _OPENSDL_DEFS_H_
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <time.h>
 
 #include "library/common/opensdl_queue.h"
+#include "library/common/opensdl_symtab.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_sink.h"
 
 #ifdef _WIN64
 #define PATH_SEP    '\\'
@@ -60,6 +145,12 @@ typedef struct
     int last_column;
 } SDL_YYLTYPE;
 
+/*
+ * State that is not part of a context, but must not be shared between
+ * compilations running on different threads, is kept per thread.
+ */
+#define SDL_THREAD_LOCAL    __thread
+
 #define SDL_K_VERSION_TYPE    'V'
 #define SDL_K_VERSION_MAJOR    3
 #define SDL_K_VERSION_MINOR    4
@@ -271,6 +362,41 @@ typedef struct _sdl_header
     bool            top;
 } SDL_HEADER;
 
+/*
+ * The following definitions are used to maintain a per-module memory arena.
+ * While a MODULE is being parsed, blocks and strings are carved out of large
+ * chunks, which are all released at once after the END_MODULE.
+ */
+#define SDL_K_ARENA_CHUNK   (64 * 1024)
+
+typedef struct _sdl_arena_chunk
+{
+    struct _sdl_arena_chunk *next;
+    uint64_t        size;
+    uint64_t        used;
+    uint64_t        reserved;
+} SDL_ARENA_CHUNK;
+
+typedef struct
+{
+    SDL_ARENA_CHUNK *chunks;
+    uint64_t        used;
+    uint64_t        peak;
+    uint64_t        chunkCount;
+    uint64_t        allocations;
+} SDL_ARENA;
+
+/*
+ * The following definitions are used to maintain an identifier pool.  The
+ * identifiers are carved out of the arena and indexed in the symbol table,
+ * until the pool is released at the end of the compilation.
+ */
+typedef struct
+{
+    SDL_ARENA       arena;
+    SDL_SYMTAB      symtab;
+} SDL_INTERN_POOL;
+
 /*
  * The following definitions are used to maintain a list of zero or more local
  * variables
@@ -348,6 +474,7 @@ typedef struct
 typedef struct
 {
     SDL_QUEUE       header;
+    SDL_SYMTAB      symtab;
     int             nextID;
 } SDL_ENUM_LIST;
 
@@ -370,6 +497,7 @@ typedef struct
 typedef struct
 {
     SDL_QUEUE       header;
+    SDL_SYMTAB      symtab;
     int             nextID;
 } SDL_DECLARE_LIST;
 
@@ -410,6 +538,7 @@ typedef struct
 typedef struct
 {
     SDL_QUEUE       header;
+    SDL_SYMTAB      symtab;
     int             nextID;
 } SDL_ITEM_LIST;
 
@@ -551,6 +680,7 @@ typedef struct
 typedef struct
 {
     SDL_QUEUE       header;
+    SDL_SYMTAB      symtab;
     int             nextID;
 } SDL_AGGREGATE_LIST;
 
@@ -681,12 +811,13 @@ typedef struct
         (context)->condState.top--;                             \
     }
 #define SDL_PUSH_COND_STATE(ctx, myS)                           \
-    if ((ctx)->condState.top >= (ctx)->condState.bottom)        \
+    if (((ctx)->condState.top + 1) >= (ctx)->condState.bottom)  \
     {                                                           \
         (ctx)->condState.bottom += SDL_K_COND_STATE_SIZE;       \
         (ctx)->condState.state = sdl_realloc(                   \
                    (ctx)->condState.state,                      \
-                   (ctx)->condState.bottom);                    \
+                   (ctx)->condState.bottom *                    \
+                       sizeof(SDL_COND_STATES));                \
     }                                                           \
     if ((ctx)->condState.state != NULL)                         \
     {                                                           \
@@ -746,6 +877,38 @@ typedef struct
     int             listSize;
 } SDL_SYMBOL_LIST;
 
+/*
+ * This is the list of input files specified on the command line, either
+ * directly or in a response file (@filespec).
+ */
+typedef struct
+{
+    char            **files;
+    int             listUsed;
+    int             listSize;
+} SDL_INPUT_LIST;
+
+/*
+ * This is the list of variants specified on the command line.  Each variant
+ * is compiled from the same scan of the input file, with its own symbols,
+ * word size and alignment, into output files that have its name added to
+ * them.  A word size of 0 or an alignment of -1 is the one from the rest of
+ * the command line.
+ */
+typedef struct
+{
+    char            *name;
+    SDL_SYMBOL_LIST symbols;
+    int             wordSize;
+    int             alignment;
+} SDL_VARIANT;
+typedef struct
+{
+    SDL_VARIANT     *variants;
+    int             listUsed;
+    int             listSize;
+} SDL_VARIANT_LIST;
+
 /*
  * This is the structure where the command line arguments values are stored.
  * There is one argument entry for each unique argument.  So, things like
@@ -763,32 +926,245 @@ typedef struct
         bool on;
         int value;
         SDL_SYMBOL_LIST *symbol;
+        SDL_INPUT_LIST *inputs;
         SDL_LANGUAGES *languages;
+        SDL_VARIANT_LIST *variants;
     };
 } SDL_ARGUMENTS;
 typedef enum
 {
     ArgAlignment,
+    ArgCacheDir,
     ArgCheckAlignment,
     ArgComments,
     ArgCopyright,
     ArgCopyrightFile,
+    ArgCounters,
+    ArgDepend,
+    ArgDependFile,
     ArgHeader,
     ArgInputFile,
+    ArgInputList,
+    ArgJobs,
     ArgLanguage,
     ArgListing,
     ArgListingFile,
     ArgMemberAlign,
+    ArgReplay,
+    ArgStats,
     ArgSymbols,
     ArgSuppressPrefix,
     ArgSuppressTag,
     ArgTraceMemory,
     ArgTrace,
+    ArgUpdate,
+    ArgVariant,
     ArgVerbose,
     ArgWordSize,
     SDL_MAX_ARGS
 } SDL_ARG_ENTRY;
 
+/*
+ * The following definitions are used by the scanner.  The file list is pushed
+ * any time an INCLUDE is detected and popped at End-Of-File (EOF).  The start
+ * state stack is used to push and pop the Start State whenever it is changed
+ * from one to another.  The bufferState is really a YY_BUFFER_STATE, which is
+ * only known to the scanner.  The parser is told when the end of an INCLUDE
+ * file that is being precompiled is reached.  When the file could be mapped
+ * into memory, it is scanned where it is, and map is the mapping.  When a
+ * recording of the tokens is being parsed, rather than the input file, tape
+ * is the recording and tapeIndex is the next token in it.  When a rule puts
+ * back characters it has already written to the listing, listSkip is the
+ * number of them, so they are not written again when they are scanned.
+ */
+typedef struct _sdl_file_list_
+{
+    struct _sdl_file_list_ *previous;
+    FILE            *fp;
+    char            *fileName;
+    void            *bufferState;
+    char            *map;
+    size_t          mapLength;
+    int             lineNumber;
+    bool            precompile;
+} SDL_FILE_LIST;
+
+#define SDL_K_LIT_LINES    42
+typedef struct
+{
+    char            *litLines[SDL_K_LIT_LINES];
+    int             *startState;
+    SDL_FILE_LIST   *fileList;
+    char            *currentFileName;
+    struct _sdl_tape *tape;
+    size_t          tapeIndex;
+    int             litIdx;
+    int             listSkip;
+    int             stateSize;
+    int             stateInuse;
+    int             aggregateDepth;
+    bool            endLiteral;
+    bool            aggregateStarted;
+    bool            skipInactive;
+} SDL_LEX_STATE;
+
+/*
+ * The following definition is used to maintain the listing file.
+ */
+#define SDL_PAGE_WIDTH    132
+typedef char SDL_HEADER_DEF[SDL_PAGE_WIDTH + 1];
+typedef struct
+{
+    FILE            *fp;
+    char            **messages;
+    SDL_HEADER_DEF  header[2];
+    char            xBuf[SDL_PAGE_WIDTH + 1];
+    int             messagesIndex;
+    int             messagesSize;
+    int             xBufLoc;
+    uint32_t        listLine;
+    uint32_t        pageLine;
+    uint32_t        pageNo;
+    bool            on;
+} SDL_LISTING;
+
+/*
+ * The following definitions are used for the module IR.  Each statement that
+ * generates output is recorded as a node, in the order it was parsed, along
+ * with the languages that were enabled for it.  The nodes refer to the blocks
+ * that were built for the statement, such as an ITEM or an AGGREGATE with
+ * all its offsets determined, which are not changed once the statement is
+ * complete.  An AGGREGATE is recorded as its layout (see opensdl_lang.h),
+ * which is determined once, when it is added.  When END_MODULE is parsed,
+ * the IR is complete, and it is emitted to the plugins.  The nodes are
+ * carved out of the context's arena.
+ */
+typedef enum
+{
+    IrComment,
+    IrModule,
+    IrItem,
+    IrConstant,
+    IrEnumerate,
+    IrAggregate,
+    IrEntry,
+    IrLiteral,
+    IrModuleEnd
+} SDL_IR_TYPE;
+typedef struct
+{
+    SDL_QUEUE       queue;
+    SDL_IR_TYPE     type;
+    bool            *langEna;
+    union
+    {
+        struct
+        {
+            char    *text;
+            bool    lineComment;
+            bool    startComment;
+            bool    middleComment;
+            bool    endComment;
+        } comment;
+        SDL_ITEM        *item;
+        SDL_CONSTANT    *constant;
+        SDL_ENUMERATE   *_enum;
+        struct _sdl_lang_layout *layout;
+        SDL_ENTRY       *entry;
+        char            *literal;
+    };
+} SDL_IR_NODE;
+typedef struct
+{
+    SDL_QUEUE       nodes;
+    bool            *lastLangEna;
+    uint32_t        nodeCount;
+    bool            open;
+    bool            complete;
+} SDL_MODULE_IR;
+
+/*
+ * The following definitions are used to gather the statistics reported by
+ * the --stats qualifier.  The time spent in each phase is exclusive, so the
+ * time spent scanning while the parser asks for a token is counted as
+ * scanning and not as parsing.  Phases are kept in a small stack for this.
+ */
+#define SDL_K_STATS_DEPTH   16
+
+typedef enum
+{
+    PhaseOptions,
+    PhasePlugins,
+    PhaseLex,
+    PhaseParse,
+    PhaseLayout,
+    PhaseEmit,
+    PhaseListing,
+    PhaseTeardown,
+    PhaseMax
+} SDL_STATS_PHASE;
+
+/*
+ * With --counters, the hardware counters for the calling thread are read with
+ * the clocks.  The mask has a bit set for each of the counters that could be
+ * read, as not every processor, or operating system, has all of them.
+ */
+typedef enum
+{
+    CounterCycles,
+    CounterInstructions,
+    CounterCacheMisses,
+    CounterBranchMisses,
+    CounterMax
+} SDL_STATS_COUNTER;
+
+typedef struct
+{
+    uint64_t        wallNs;
+    uint64_t        cpuNs;
+    uint64_t        counter[CounterMax];
+    uint32_t        counterMask;
+} SDL_STATS_CLOCK;
+
+typedef struct
+{
+    uint64_t        wallNs;
+    uint64_t        cpuNs;
+    uint64_t        count;
+    uint64_t        counter[CounterMax];
+    uint32_t        counterMask;
+} SDL_STATS_TIME;
+
+typedef struct
+{
+    char            *name;
+    SDL_STATS_TIME  time;
+    uint64_t        bytes;
+} SDL_STATS_LANG;
+
+typedef struct
+{
+    SDL_STATS_TIME  phase[PhaseMax];
+    SDL_STATS_TIME  total;
+    SDL_STATS_LANG  *lang;
+    uint64_t        blocks[EntryBlock + 1];
+    uint64_t        lookups;
+    uint64_t        inserts;
+    uint64_t        tokens;
+    SDL_STATS_CLOCK mark;
+    SDL_STATS_CLOCK start;
+    SDL_STATS_PHASE stack[SDL_K_STATS_DEPTH];
+    uint32_t        langCount;
+    int             depth;
+} SDL_STATS;
+
+/*
+ * Each entry in the message vector contains a 32-bit message code, followed
+ * by a 16-bit Formatted ASCII Output (FAO) count, and a 16-bit FAO information
+ * field.  So, each message vector entry is 64-bits long.
+ */
+#define SDL_K_MSG_VEC_LEN    1024
+
 /*
  * This is the context data structure.  It maintains everything about what has
  * been parsed and is being parsed.  It is initialized when a MODULE has been
@@ -800,7 +1176,10 @@ typedef struct
     char            *module;
     char            *inputPath;
     void            *currentAggr;
+    FILE            *errFP;
     bool            *langEnableVec;
+    FILE            **langFP;
+    SDL_SINK        *langSink;
     SDL_ARGUMENTS   argument[SDL_MAX_ARGS];
     SDL_DIMENSION   dimensions[SDL_K_MAX_DIMENSIONS];
     SDL_OPTION      *options;
@@ -813,17 +1192,30 @@ typedef struct
     SDL_STATE       *stateStack;
     SDL_COND_STATE  condState;
     SDL_QUEUE       locals;
+    SDL_SYMTAB      localSymtab;
+    SDL_ARENA       arena;
+    SDL_INTERN_POOL names;
     SDL_QUEUE       constants;
     SDL_QUEUE       entries;
     SDL_CONSTANT_DEF constDef;
     SDL_YYLTYPE     modEndloc;
     SDL_YYLTYPE     modStartloc;
     SDL_LANGUAGE_LIST langCondList;
+    SDL_QUEUE       literal;
+    SDL_LEX_STATE   lexState;
+    SDL_INPUT_LIST  includes;
+    SDL_MODULE_IR   ir;
+    struct _sdl_precomp *precomp;
+    SDL_LISTING     listing;
+    SDL_STATS       stats;
+    SDL_MSG_VECTOR  msgVec[SDL_K_MSG_VEC_LEN];
     struct tm       inputTimeInfo;
     struct tm       runTimeInfo;
     int64_t         precision;
     int64_t         scale;
     uint32_t        languagesSpecified;
+    uint32_t        parseStatus;
+    uint32_t        diagnostics;
     int             aggregateDepth;
     int             fillerCount;
     int             optionsIdx;
@@ -833,6 +1225,7 @@ typedef struct
     int             stateIdx;
     int             stateSize;
     bool            processingEnabled;
+    bool            bitfieldUpdated;
 } SDL_CONTEXT;
 
 #define SDL_COPY_LOC(dest, src)                                 \
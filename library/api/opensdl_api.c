@@ -0,0 +1,560 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the functions used to embed OpenSDL in another
+ *  program.  A compilation reads its input from a memory stream over the
+ *  caller's buffer, and each language plugin, and the diagnostics, write to a
+ *  memory stream of their own.  Each call has a context of its own, so any
+ *  number of calls can be made at the same time, once the languages they use
+ *  have been loaded.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  The language enabled vector is indexed by plugin identifier, so only the
+ *  requested languages need an output stream.
+ *
+ *  V01.002	15-OCT-2026	Jonathan D. Belanger
+ *  Free the list of INCLUDE files opened by the compilation.
+ *
+ *  V01.003	15-OCT-2026	Jonathan D. Belanger
+ *  The context records the output stream for each language, so that each
+ *  language can be generated on a thread of its own.
+ *
+ *  V01.004	15-OCT-2026	Jonathan D. Belanger
+ *  The context has an output sink for each language.  An error writing out
+ *  an output stream, when it is closed, is returned.
+ *
+ *  V01.005	16-OCT-2026	Jonathan D. Belanger
+ *  Calls are recorded in the trace rather than written to standard output.
+ *
+ *  V01.006	16-OCT-2026	Jonathan D. Belanger
+ *  The conditional state stack is charged to its own site in the memory
+ *  profile.
+ *
+ *  V01.007	16-OCT-2026	Jonathan D. Belanger
+ *  The context is set up, and cleaned up, by sdl_context_init and
+ *  sdl_context_free.
+ *
+ *  V01.008	16-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_compile_release, which releases the language plugins and the
+ *  identifier pool kept between compilations.
+ *
+ *  V01.009	16-OCT-2026	Jonathan D. Belanger
+ *  Each compilation has its own identifier pool, released with its context,
+ *  so sdl_compile_release only releases the language plugins.
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_symtab.h"
+#include "library/common/opensdl_trace.h"
+#include "library/utility/opensdl_plugin_funcs.h"
+#include "library/utility/opensdl_include.h"
+#include "library/utility/opensdl_utility.h"
+#include "library/parser/opensdl_parser.h"
+#include "library/api/opensdl_api.h"
+
+/*
+ * These are normally defined by the opensdl main program.
+ */
+bool trace = false;
+int _verbose = 0;
+
+/*
+ * Local Variables
+ */
+static pthread_mutex_t _sdl_api_load_mutex = PTHREAD_MUTEX_INITIALIZER;
+static char _sdl_api_empty[] = "\n";
+
+/*
+ * Local Prototypes
+ */
+static void _sdl_api_report(SDL_CONTEXT *context);
+
+/*
+ * sdl_compile_options_init
+ *  This function is called to initialize the compilation options to the same
+ *  defaults used by the command line.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  options:
+ *      A pointer to the options structure to be initialized.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_compile_options_init(SDL_COMPILE_OPTIONS *options)
+{
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_compile_options_init");
+
+    options->symbols = NULL;
+    options->symbolCount = 0;
+    options->alignment = 0;
+    options->wordSize = 64;
+    options->checkAlignment = false;
+    options->comments = true;
+    options->header = true;
+    options->memberAlign = true;
+    options->suppressPrefix = false;
+    options->suppressTag = false;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_compile_buffer
+ *  This function is called to compile SDL source held in memory, and return
+ *  the output for each of the requested languages in memory.  The plugin for
+ *  a language is loaded the first time it is requested.  Loading a plugin
+ *  changes the plugin table, so when calls are to be made on more than one
+ *  thread, each language should be requested once before the threads are
+ *  started.
+ *
+ * Input Parameters:
+ *  source:
+ *      A pointer to the SDL source to be compiled.  This does not need to be
+ *      null terminated.
+ *  length:
+ *      A value indicating the number of bytes in the source.
+ *  sourceName:
+ *      A pointer to the name to use for the source in the header comments.
+ *      This may be NULL.
+ *  options:
+ *      A pointer to the compilation options.  If this is NULL, the defaults
+ *      from sdl_compile_options_init are used.
+ *  languages:
+ *      An array of pointers to the names of the languages for which output is
+ *      to be generated (for example "c").
+ *  langCount:
+ *      A value indicating the number of entries in the languages array.
+ *
+ * Output Parameters:
+ *  result:
+ *      A pointer to the results structure to receive the diagnostics and the
+ *      output for each language, in the order the languages were specified.
+ *      This must be released with sdl_compile_result_free, whatever the
+ *      status returned.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_SYNTAXERR:  A syntax error was found in the source.
+ *  SDL_INVSHRIMG:  A language is not known.
+ *  SDL_BUGCHECK:   The compilation was abandoned because of an internal
+ *                  consistency failure.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ *  Any other status reported by the parser or a plugin.  The diagnostics
+ *  contain the messages for all of these.
+ */
+uint32_t sdl_compile_buffer(const char *source,
+                            size_t length,
+                            const char *sourceName,
+                            const SDL_COMPILE_OPTIONS *options,
+                            const char **languages,
+                            int langCount,
+                            SDL_COMPILE_RESULT *result)
+{
+    SDL_COMPILE_OPTIONS defOptions;
+    SDL_CONTEXT     *context;
+    SDL_ARGUMENTS   *args;
+    SDL_LANGUAGES   *langList = NULL;
+    SDL_SYMBOL_LIST symbols;
+    FILE            *fp = NULL;
+    uint32_t        *langId = NULL;
+    uint32_t        pluginCount;
+    uint32_t        retVal = SDL_NORMAL;
+    time_t          now;
+    int             ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_compile_buffer");
+
+    memset(result, 0, sizeof(SDL_COMPILE_RESULT));
+    symbols.symbols = NULL;
+    if (options == NULL)
+    {
+        sdl_compile_options_init(&defOptions);
+        options = &defOptions;
+    }
+
+    /*
+     * The context is allocated from the heap, so that it is not confused with
+     * the arena the last MODULE on this thread may have used.
+     */
+    sdl_set_arena(NULL);
+    context = sdl_calloc(1, sizeof(SDL_CONTEXT));
+    langId = sdl_calloc(langCount + 1, sizeof(uint32_t));
+    result->outputs = calloc(langCount + 1, sizeof(SDL_COMPILE_OUTPUT));
+    if ((context == NULL) || (langId == NULL) || (result->outputs == NULL))
+    {
+        if (context != NULL)
+        {
+            sdl_free(context);
+        }
+        if (langId != NULL)
+        {
+            sdl_free(langId);
+        }
+        return(SDL_ABORT);
+    }
+    context->errFP = open_memstream(&result->diagnostics, &result->diagLen);
+    if (context->errFP == NULL)
+    {
+        sdl_free(context);
+        sdl_free(langId);
+        return(SDL_ABORT);
+    }
+    sdl_set_message(context->msgVec, 1, SDL_NORMAL);
+
+    /*
+     * Load the plugin for each of the requested languages.  This is
+     * serialized, so that two callers do not both try to load the same
+     * plugin.
+     */
+    pthread_mutex_lock(&_sdl_api_load_mutex);
+    for (ii = 0; ((ii < langCount) && (retVal == SDL_NORMAL)); ii++)
+    {
+        char *fileExt;
+
+        retVal = sdl_load_plugin(context,
+                                 (char *) languages[ii],
+                                 &fileExt,
+                                 &langId[ii]);
+    }
+    pluginCount = sdl_plugin_count();
+    pthread_mutex_unlock(&_sdl_api_load_mutex);
+    if (retVal != SDL_NORMAL)
+    {
+        _sdl_api_report(context);
+    }
+
+    /*
+     * Initialize the parsing context, starting with the arguments.  The
+     * enabled vector is indexed by plugin, so it has an entry for every
+     * plugin loaded, but only the requested languages are ever enabled.
+     */
+    if (retVal == SDL_NORMAL)
+    {
+        langList = sdl_calloc(langCount + 1, sizeof(SDL_LANGUAGES));
+        retVal = sdl_context_init(context, pluginCount);
+        if (langList == NULL)
+        {
+            retVal = SDL_ABORT;
+        }
+    }
+    if (retVal == SDL_NORMAL)
+    {
+        symbols.symbols = sdl_calloc(options->symbolCount + 1,
+                                     sizeof(SDL_SYMBOL));
+        symbols.listSize = options->symbolCount;
+        symbols.listUsed = options->symbolCount;
+        if (symbols.symbols == NULL)
+        {
+            retVal = SDL_ABORT;
+        }
+        for (ii = 0;
+             ((ii < options->symbolCount) && (retVal == SDL_NORMAL));
+             ii++)
+        {
+            symbols.symbols[ii].symbol = (char *) options->symbols[ii].symbol;
+            symbols.symbols[ii].value = options->symbols[ii].value;
+        }
+    }
+    if (retVal == SDL_NORMAL)
+    {
+        args = context->argument;
+        args[ArgAlignment].present = options->alignment != 0;
+        args[ArgAlignment].value = options->alignment;
+        args[ArgCheckAlignment].on = options->checkAlignment;
+        args[ArgComments].on = options->comments;
+        args[ArgHeader].on = options->header;
+        args[ArgInputFile].present = true;
+        args[ArgInputFile].fileName = (char *) sourceName;
+        args[ArgLanguage].present = true;
+        args[ArgLanguage].languages = langList;
+        args[ArgListing].on = false;
+        args[ArgMemberAlign].on = options->memberAlign;
+        args[ArgSymbols].present = options->symbolCount > 0;
+        args[ArgSymbols].symbol = &symbols;
+        args[ArgSuppressPrefix].on = options->suppressPrefix;
+        args[ArgSuppressTag].on = options->suppressTag;
+        args[ArgWordSize].value = options->wordSize;
+        context->languagesSpecified = langCount;
+    }
+
+    /*
+     * Give the plugin for each of the requested languages a memory stream to
+     * write into the results.  A language requested more than once only has
+     * output in its first entry.
+     */
+    for (ii = 0; ((ii < langCount) && (retVal == SDL_NORMAL)); ii++)
+    {
+        SDL_COMPILE_OUTPUT *output = &result->outputs[ii];
+
+        output->lang = languages[ii];
+        langList[ii].langStr = (char *) languages[ii];
+        langList[ii].langVal = langId[ii];
+        result->outputCount++;
+        if (context->langEnableVec[langId[ii]] == false)
+        {
+            FILE *outFP = open_memstream(&output->buffer, &output->length);
+
+            if (outFP == NULL)
+            {
+                retVal = SDL_ABORT;
+            }
+            else
+            {
+                retVal = sdl_load_fp(context, langId[ii], outFP);
+                if (retVal == SDL_NORMAL)
+                {
+                    context->langEnableVec[langId[ii]] = true;
+                }
+                else
+                {
+                    fclose(outFP);
+                    _sdl_api_report(context);
+                }
+            }
+        }
+    }
+
+    /*
+     * Insert the header comments, using the current time for both the time
+     * of the run and the time of the input.
+     */
+    if ((retVal == SDL_NORMAL) && (options->header == true))
+    {
+        now = time(NULL);
+        localtime_r(&now, &context->runTimeInfo);
+        memcpy(&context->inputTimeInfo,
+               &context->runTimeInfo,
+               sizeof(struct tm));
+        retVal = sdl_call_commentStars(context->langEnableVec);
+        if (retVal == SDL_NORMAL)
+        {
+            retVal = sdl_call_createdByInfo(context->langEnableVec,
+                                            &context->runTimeInfo);
+        }
+        if (retVal == SDL_NORMAL)
+        {
+            retVal = sdl_call_fileInfo(context->langEnableVec,
+                                       &context->inputTimeInfo,
+                                       (char *) ((sourceName != NULL) ?
+                                                 sourceName : "<buffer>"));
+        }
+        if (retVal == SDL_NORMAL)
+        {
+            retVal = sdl_call_commentStars(context->langEnableVec);
+        }
+        if (retVal != SDL_NORMAL)
+        {
+            _sdl_api_report(context);
+        }
+    }
+
+    /*
+     * Now parse the source.  The parser writes its own diagnostics.
+     */
+    if (retVal == SDL_NORMAL)
+    {
+        fp = (length > 0) ?
+                fmemopen((void *) source, length, "r") :
+                fmemopen(_sdl_api_empty, 1, "r");
+        if (fp != NULL)
+        {
+            retVal = sdl_parse_file(context, fp);
+            if ((retVal == SDL_ABORT) || (retVal == SDL_ERREXIT))
+            {
+                _sdl_api_report(context);
+            }
+            fclose(fp);
+        }
+        else
+        {
+            retVal = SDL_ABORT;
+        }
+    }
+    if ((retVal == SDL_ABORT) && (fp == NULL))
+    {
+        fprintf(context->errFP,
+                "%%SDL-F-ABORT, Fatal internal error. Unable to continue "
+                "execution\n-SYSTEM-E-ENOMEM, Not enough space\n");
+    }
+
+    /*
+     * Close the output streams, which makes their buffers available to the
+     * caller, and clean-up memory, starting with what is left in the arena
+     * from the last MODULE.
+     */
+    if ((sdl_call_close() != SDL_NORMAL) && (retVal == SDL_NORMAL))
+    {
+        retVal = SDL_ABORT;
+        _sdl_api_report(context);
+    }
+    fclose(context->errFP);
+    sdl_context_free(context);
+    if (symbols.symbols != NULL)
+    {
+        sdl_free(symbols.symbols);
+    }
+    if (langList != NULL)
+    {
+        sdl_free(langList);
+    }
+    sdl_free(langId);
+    sdl_free(context);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_compile_result_free
+ *  This function is called to release the buffers returned in the results of
+ *  a compilation.
+ *
+ * Input Parameters:
+ *  result:
+ *      A pointer to the results structure filled in by sdl_compile_buffer.
+ *
+ * Output Parameters:
+ *  result:
+ *      A pointer to the results structure, which is now empty.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_compile_result_free(SDL_COMPILE_RESULT *result)
+{
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_compile_result_free");
+
+    if (result->outputs != NULL)
+    {
+        for (ii = 0; ii < result->outputCount; ii++)
+        {
+            free(result->outputs[ii].buffer);
+        }
+        free(result->outputs);
+    }
+    free(result->diagnostics);
+    memset(result, 0, sizeof(SDL_COMPILE_RESULT));
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_compile_release
+ *  This function is called to release what is kept between compilations,
+ *  which is the table of loaded language plugins.  It must not be called
+ *  while any compilation is still running.  A later compilation loads the
+ *  plugins it needs.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_compile_release(void)
+{
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_compile_release");
+
+    pthread_mutex_lock(&_sdl_api_load_mutex);
+    sdl_unload_plugins();
+    pthread_mutex_unlock(&_sdl_api_load_mutex);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_api_report
+ *  This function is called to write the message in the message vector to the
+ *  diagnostics.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for this compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_api_report(SDL_CONTEXT *context)
+{
+    char *msgTxt = NULL;
+
+    if (sdl_get_message(context->msgVec, &msgTxt) == SDL_NORMAL)
+    {
+        fprintf(context->errFP, "%s\n", msgTxt);
+    }
+    if (msgTxt != NULL)
+    {
+        sdl_free(msgTxt);
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
@@ -23,6 +23,29 @@
  *
  *  V01.000 17-NOV-2018 Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001 15-OCT-2026 Jonathan D. Belanger
+ *  Added the per-module memory arena.  Blocks and strings are carved out of
+ *  the current arena, when there is one, and are all released at once.  The
+ *  memory trace now reports arena usage once per arena, rather than a line for
+ *  every call.
+ *
+ *  V01.002 15-OCT-2026 Jonathan D. Belanger
+ *  The current arena and the memory trace counters are kept per thread, so
+ *  that compilations running on different threads do not share them.
+ *
+ *  V01.003 16-OCT-2026 Jonathan D. Belanger
+ *  Count the blocks allocated of each type for --stats.
+ *
+ *  V01.004 16-OCT-2026 Jonathan D. Belanger
+ *  The memory trace is a profile of the bytes allocated for each type of
+ *  block and each of the other memory sites, for all threads, reported once
+ *  when the program exits, with the peak resident set size.  The site is kept
+ *  in the length in front of each buffer, so its bytes can be taken back when
+ *  the buffer, or the arena it was carved out of, is released.
+ *
+ *  V01.005 16-OCT-2026 Jonathan D. Belanger
+ *  Added the name of the MemIntern site.
  */
 #include <errno.h>
 #include <stdio.h>
@@ -30,27 +53,82 @@
 #include <stdint.h>
 #include <string.h>
 #include <ctype.h>
+#include <pthread.h>
+#include <sys/resource.h>
 #include "opensdl_defs.h"
 #include <library/common/opensdl_blocks.h>
+#include <library/common/opensdl_stats.h>
 /* #include <library/utility/opensdl_utility.h> */
 
 static bool traceMemory = false;
 
 /*
- * Local Variables
+ * The memory profile for each site.  The bytes include the length in front
+ * of each buffer and the rounding up to a multiple of 8.
+ */
+typedef struct
+{
+    uint64_t        allocs;
+    uint64_t        frees;
+    uint64_t        bytes;
+    uint64_t        current;
+    uint64_t        peak;
+} SDL_MEM_USAGE;
+
+/*
+ * Local Variables (shared by all threads, and only updated when memory is
+ * being traced)
+ */
+static pthread_mutex_t _sdl_mem_mutex = PTHREAD_MUTEX_INITIALIZER;
+static SDL_MEM_USAGE _sdl_mem_usage[MemMax];
+static uint64_t _sdl_mem_current = 0;
+static uint64_t _sdl_mem_peak = 0;
+static uint64_t _sdl_arena_releases = 0;
+static uint64_t _sdl_arena_chunks = 0;
+static uint64_t _sdl_arena_peak = 0;
+
+static const char *_sdl_mem_site[MemMax] =
+{
+    "other",
+    "local",
+    "literal",
+    "constant",
+    "enum_member",
+    "enumerate",
+    "declare",
+    "item",
+    "aggr_member",
+    "aggregate",
+    "parameter",
+    "entry",
+    "string",
+    "options",
+    "state_stack",
+    "cond_stack",
+    "arena_alloc",
+    "intern"
+};
+
+/*
+ * Local Variables (one set for each thread)
+ */
+static SDL_THREAD_LOCAL SDL_ARENA *_sdl_arena = NULL;
+
+/*
+ * Local Prototypes
  */
-static uint64_t _bytes_allocated = 0;
-static uint64_t _bytes_deallocated = 0;
-static uint64_t _allocate_calls = 0;
-static uint64_t _deallocate_calls = 0;
-static uint64_t _strdup_calls = 0;
-static uint64_t _calloc_calls = 0;    /* Not the system calloc */
-static uint64_t _realloc_calls = 0;
-static uint64_t _free_calls = 0;
+static void *_sdl_alloc(SDL_ARENA *arena, size_t size, SDL_MEM_SITE site);
+static void _sdl_release(void *ptr);
+static char *_sdl_strdup(SDL_ARENA *arena, const char *string);
+static void _sdl_mem_charge(SDL_MEM_SITE site, uint64_t length);
+static void _sdl_mem_credit(SDL_MEM_SITE site, uint64_t length);
+static void _sdl_mem_report(void);
 
 /*
  * sdl_set_trace_memory
- *  This function is called to set the traceMemory flag.
+ *  This function is called to set the traceMemory flag.  From then on, the
+ *  memory allocated and released is profiled, and the profile is reported
+ *  when the program exits.
  *
  * Input Parameters:
  *  None.
@@ -63,7 +141,11 @@ static uint64_t _free_calls = 0;
  */
 void sdl_set_trace_memory(void)
 {
-    traceMemory = true;
+    if (traceMemory == false)
+    {
+        traceMemory = true;
+        atexit(_sdl_mem_report);
+    }
 
     /*
      * Return back to the caller.
@@ -100,12 +182,11 @@ void *sdl_allocate_block(
         SDL_YYLTYPE *loc)
 {
     void    *retVal = NULL;
-    uint64_t    size = 0;
 
     /*
-     * Increment the call counter.
+     * Count the block for --stats.
      */
-    _allocate_calls++;
+    sdl_stats_block(blockID);
 
     /*
      * Determine which block to allocate.
@@ -113,7 +194,9 @@ void *sdl_allocate_block(
     switch(blockID)
     {
         case LocalBlock:
-            retVal = calloc(1, sizeof(SDL_LOCAL_VARIABLE));
+            retVal = _sdl_alloc(_sdl_arena,
+                                sizeof(SDL_LOCAL_VARIABLE),
+                                blockID);
             if (retVal != NULL)
             {
                 SDL_LOCAL_VARIABLE *local = (SDL_LOCAL_VARIABLE *) retVal;
@@ -122,12 +205,11 @@ void *sdl_allocate_block(
                 local->header.blockID = blockID;
                 local->header.top = false;
                 SDL_COPY_LOC(local->loc, loc);
-                size = sizeof(SDL_LOCAL_VARIABLE);
             }
             break;
 
         case LiteralBlock:
-            retVal = calloc(1, sizeof(SDL_LITERAL));
+            retVal = _sdl_alloc(_sdl_arena, sizeof(SDL_LITERAL), blockID);
             if (retVal != NULL)
             {
                 SDL_LITERAL *literal = (SDL_LITERAL *) retVal;
@@ -136,12 +218,11 @@ void *sdl_allocate_block(
                 literal->header.blockID = blockID;
                 literal->header.top = false;
                 SDL_COPY_LOC(literal->loc, loc);
-                size = sizeof(SDL_LITERAL);
             }
             break;
 
         case ConstantBlock:
-            retVal = calloc(1, sizeof(SDL_CONSTANT));
+            retVal = _sdl_alloc(_sdl_arena, sizeof(SDL_CONSTANT), blockID);
             if (retVal != NULL)
             {
                 SDL_CONSTANT *constBlk = (SDL_CONSTANT *) retVal;
@@ -150,12 +231,11 @@ void *sdl_allocate_block(
                 constBlk->header.blockID = blockID;
                 constBlk->header.top = false;
                 SDL_COPY_LOC(constBlk->loc, loc);
-                size = sizeof(SDL_CONSTANT);
             }
             break;
 
         case EnumMemberBlock:
-            retVal = calloc(1, sizeof(SDL_ENUM_MEMBER));
+            retVal = _sdl_alloc(_sdl_arena, sizeof(SDL_ENUM_MEMBER), blockID);
             if (retVal != NULL)
             {
                 SDL_ENUM_MEMBER *member = (SDL_ENUM_MEMBER *) retVal;
@@ -164,12 +244,11 @@ void *sdl_allocate_block(
                 member->header.blockID = blockID;
                 member->header.top = false;
                 SDL_COPY_LOC(member->loc, loc);
-                size = sizeof(SDL_ENUM_MEMBER);
             }
             break;
 
         case EnumerateBlock:
-            retVal = calloc(1, sizeof(SDL_ENUMERATE));
+            retVal = _sdl_alloc(_sdl_arena, sizeof(SDL_ENUMERATE), blockID);
             if (retVal != NULL)
             {
                 SDL_ENUMERATE *myEnum  = (SDL_ENUMERATE *) retVal;
@@ -179,12 +258,11 @@ void *sdl_allocate_block(
                 myEnum->header.top = false;
                 SDL_COPY_LOC(myEnum->loc, loc);
                 SDL_Q_INIT(&myEnum->members);
-                size = sizeof(SDL_ENUMERATE);
             }
             break;
 
         case DeclareBlock:
-            retVal = calloc(1, sizeof(SDL_DECLARE));
+            retVal = _sdl_alloc(_sdl_arena, sizeof(SDL_DECLARE), blockID);
             if (retVal != NULL)
             {
                 SDL_DECLARE *decl = (SDL_DECLARE *) retVal;
@@ -193,12 +271,11 @@ void *sdl_allocate_block(
                 decl->header.blockID = blockID;
                 decl->header.top = false;
                 SDL_COPY_LOC(decl->loc, loc);
-                size = sizeof(SDL_DECLARE);
             }
             break;
 
         case ItemBlock:
-            retVal = calloc(1, sizeof(SDL_ITEM));
+            retVal = _sdl_alloc(_sdl_arena, sizeof(SDL_ITEM), blockID);
             if (retVal != NULL)
             {
                 SDL_ITEM *item = (SDL_ITEM *) retVal;
@@ -207,12 +284,11 @@ void *sdl_allocate_block(
                 item->header.blockID = blockID;
                 item->header.top = false;
                 SDL_COPY_LOC(item->loc, loc);
-                size = sizeof(SDL_ITEM);
             }
             break;
 
         case AggrMemberBlock:
-            retVal = calloc(1, sizeof(SDL_MEMBERS));
+            retVal = _sdl_alloc(_sdl_arena, sizeof(SDL_MEMBERS), blockID);
             if (retVal != NULL)
             {
                 SDL_MEMBERS *member = (SDL_MEMBERS *) retVal;
@@ -221,12 +297,11 @@ void *sdl_allocate_block(
                 member->header.blockID = blockID;
                 member->header.top = false;
                 SDL_COPY_LOC(member->loc, loc);
-                size = sizeof(SDL_MEMBERS);
             }
             break;
 
         case AggregateBlock:
-            retVal = calloc(1, sizeof(SDL_AGGREGATE));
+            retVal = _sdl_alloc(_sdl_arena, sizeof(SDL_AGGREGATE), blockID);
             if (retVal != NULL)
             {
                 SDL_AGGREGATE *aggr= (SDL_AGGREGATE *) retVal;
@@ -236,12 +311,11 @@ void *sdl_allocate_block(
                 aggr->header.top = false;
                 SDL_COPY_LOC(aggr->loc, loc);
                 SDL_Q_INIT(&aggr->members);
-                size = sizeof(SDL_AGGREGATE);
             }
             break;
 
         case ParameterBlock:
-            retVal = calloc(1, sizeof(SDL_PARAMETER));
+            retVal = _sdl_alloc(_sdl_arena, sizeof(SDL_PARAMETER), blockID);
             if (retVal != NULL)
             {
                 SDL_PARAMETER *param = (SDL_PARAMETER *) retVal;
@@ -250,12 +324,11 @@ void *sdl_allocate_block(
                 param->header.blockID = blockID;
                 param->header.top = false;
                 SDL_COPY_LOC(param->loc, loc);
-                size = sizeof(SDL_PARAMETER);
             }
             break;
 
         case EntryBlock:
-            retVal = calloc(1, sizeof(SDL_ENTRY));
+            retVal = _sdl_alloc(_sdl_arena, sizeof(SDL_ENTRY), blockID);
             if (retVal != NULL)
             {
                 SDL_ENTRY *entry = (SDL_ENTRY *) retVal;
@@ -265,7 +338,6 @@ void *sdl_allocate_block(
                 entry->header.top = false;
                 SDL_COPY_LOC(entry->loc, loc);
                 SDL_Q_INIT(&entry->parameters);
-                size = sizeof(SDL_ENTRY);
             }
             break;
 
@@ -273,39 +345,6 @@ void *sdl_allocate_block(
             break;
     }
 
-    /*
-     * Count the newly allocated bytes (size will be zero if nothing was
-     * allocated).
-     */
-    _bytes_allocated += size;
-
-    /*
-     * Trace the newly allocated block, plus additional relevant information.
-     */
-    if (traceMemory == true)
-    {
-        printf("%s:%d:sdl_allocate_block: ID = %d, size = %ld, "
-               "address: 0x%016lx\n\tsdl_allocate_blk Calls: %ld\n"
-               "\tsdl_deallocate_blk Calls: %ld\n\tsdl_strdup Calls: %ld\n"
-               "\tsdl_calloc Calls: %ld\n\tsdl_realloc Calls: %ld\n"
-               "\tsdl_free Calls: %ld\nBytes Allocated: %ld, "
-               "Bytes Deallocated: %ld, Bytes Remaining %ld\n",
-               __FILE__,
-               __LINE__,
-               blockID,
-               size,
-               (uint64_t) retVal,
-               _allocate_calls,
-               _deallocate_calls,
-               _strdup_calls,
-               _calloc_calls,
-               _realloc_calls,
-               _free_calls,
-               _bytes_allocated,
-               _bytes_deallocated,
-               _bytes_allocated - _bytes_deallocated);
-    }
-
     /*
      * Return the results back to the caller.
      */
@@ -330,12 +369,6 @@ void *sdl_allocate_block(
 void sdl_deallocate_block(SDL_HEADER *block)
 {
     SDL_BLOCK_ID blockID = block->blockID;
-    uint64_t size = 0;
-
-    /*
-     * Increment the call counter.
-     */
-    _deallocate_calls++;
 
     /*
      * Determine which block to allocate.
@@ -351,7 +384,6 @@ void sdl_deallocate_block(SDL_HEADER *block)
                 {
                     sdl_free(local->id);
                 }
-                size = sizeof(SDL_LOCAL_VARIABLE);
             }
             break;
 
@@ -364,7 +396,6 @@ void sdl_deallocate_block(SDL_HEADER *block)
                 {
                     sdl_free(literal->line);
                 }
-                size = sizeof(SDL_LITERAL);
             }
             break;
 
@@ -398,7 +429,6 @@ void sdl_deallocate_block(SDL_HEADER *block)
                 {
                     sdl_free(constBlk->string);
                 }
-                size = sizeof(SDL_CONSTANT);
             }
             break;
 
@@ -415,7 +445,6 @@ void sdl_deallocate_block(SDL_HEADER *block)
                 {
                     sdl_free(member->id);
                 }
-                size = sizeof(SDL_ENUM_MEMBER);
             }
             break;
 
@@ -442,7 +471,6 @@ void sdl_deallocate_block(SDL_HEADER *block)
                 {
                     sdl_free(myEnum->tag);
                 }
-                size = sizeof(SDL_ENUMERATE);
             }
             break;
 
@@ -463,7 +491,6 @@ void sdl_deallocate_block(SDL_HEADER *block)
                 {
                     sdl_free(decl->tag);
                 }
-                size = sizeof(SDL_DECLARE);
             }
             break;
 
@@ -484,7 +511,6 @@ void sdl_deallocate_block(SDL_HEADER *block)
                 {
                     sdl_free(item->tag);
                 }
-                size = sizeof(SDL_ITEM);
             }
             break;
 
@@ -539,7 +565,6 @@ void sdl_deallocate_block(SDL_HEADER *block)
                         sdl_free(member->comment.comment);
                     }
                 }
-                size = sizeof(SDL_MEMBERS);
                 }
             break;
 
@@ -574,7 +599,6 @@ void sdl_deallocate_block(SDL_HEADER *block)
                 {
                     sdl_free(aggr->tag);
                 }
-                size = sizeof(SDL_AGGREGATE);
             }
             break;
 
@@ -595,7 +619,6 @@ void sdl_deallocate_block(SDL_HEADER *block)
                 {
                     sdl_free(param->typeName);
                 }
-                size = sizeof(SDL_PARAMETER);
             }
             break;
 
@@ -626,42 +649,13 @@ void sdl_deallocate_block(SDL_HEADER *block)
                 {
                     sdl_free(entry->typeName);
                 }
-                size = sizeof(SDL_ENTRY);
             }
             break;
 
         default:
             break;
     }
-    free(block);
-    _bytes_deallocated += size;
-
-    /*
-     * Trace the deallocated block, plus additional relevant information.
-     */
-    if (traceMemory == true)
-    {
-        printf("%s:%d:sdl_deallocate_block: ID = %d, size = %ld, "
-                "address: 0x%016lx\n\tsdl_allocate_blk Calls: %ld\n"
-                "\tsdl_deallocate_blk Calls: %ld\n\tsdl_strdup Calls: %ld\n"
-                "\tsdl_calloc Calls: %ld\n\tsdl_realloc Calls: %ld\n"
-                "\tsdl_free Calls: %ld\nBytes Allocated: %ld, "
-                "Bytes Deallocated: %ld, Bytes Remaining %ld\n",
-                __FILE__,
-                __LINE__,
-                blockID,
-                size,
-                (uint64_t) block,
-                _allocate_calls,
-                _deallocate_calls,
-                _strdup_calls,
-                _calloc_calls,
-                _realloc_calls,
-                _free_calls,
-                _bytes_allocated,
-                _bytes_deallocated,
-                _bytes_allocated - _bytes_deallocated);
-    }
+    _sdl_release(block);
 
     /*
      * Return back to the caller.
@@ -757,83 +751,157 @@ char *sdl_strupr(const char *string)
  */
 char *sdl_strdup(const char *string)
 {
-    char *retVal;
-    size_t length = sizeof(uint64_t) + 1;
 
     /*
-     * Increment the call counter.
+     * Strings are carved out of the current arena, if there is one.
      */
-    _strdup_calls++;
+    return(_sdl_strdup(_sdl_arena, string));
+}
 
-    /*
-     * If the pointer to the string is NULL, then we are just going to create
-     * a buffer to hold a zero length, null-terminated string.
-     */
-    if (string != NULL)
-        length += strlen(string);
+/*
+ * sdl_strdup_heap
+ *  This function is called to duplicate a string that needs to outlive the
+ *  current module.  The duplicated string is never carved out of the current
+ *  arena.
+ *
+ * Input Parameters:
+ *  string:
+ *    A pointer to the string to be duplicated.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:           An error occurred allocating the buffer for the duplicated
+ *                  string.
+ *  !NULL:          A pointer to the duplicated string.
+ */
+char *sdl_strdup_heap(const char *string)
+{
+    return(_sdl_strdup(NULL, string));
+}
 
-    /*
-     * Allocate a buffer large enough for the supplied string to be copied.
-     */
-    retVal = calloc(length, 1);
+/*
+ * sdl_calloc
+ *  This function is called to allocate a buffer of memory.  We have this
+ *  function so that we can keep track of allocated and deallocated memory.
+ *
+ * Input Parameters:
+ *  count:
+ *    A value indicating the number of items to be allocated.
+ *  size:
+ *    A value indicating the size of each item to be allocated.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:    An error occurred allocating the buffer.
+ *  !NULL:    A pointer to the buffer.
+ */
+void *sdl_calloc(size_t count, size_t size)
+{
+    return(_sdl_alloc(NULL, count * size, MemOther));
+}
 
-    /*
-     * If the allocate was successful, then copy the string into the new
-     * buffer.
-     */
-    if (retVal != NULL)
-    {
-        uint64_t *bufLen = (uint64_t *) retVal;
+/*
+ * sdl_calloc_site
+ *  This function is called to allocate a buffer of memory for a particular
+ *  site, so that it is charged to that site in the memory profile.
+ *
+ * Input Parameters:
+ *  site:
+ *    A value indicating the site for which the buffer is being allocated.
+ *  count:
+ *    A value indicating the number of items to be allocated.
+ *  size:
+ *    A value indicating the size of each item to be allocated.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:           An error occurred allocating the buffer.
+ *  !NULL:          A pointer to the buffer.
+ */
+void *sdl_calloc_site(SDL_MEM_SITE site, size_t count, size_t size)
+{
+    return(_sdl_alloc(NULL, count * size, site));
+}
 
-        /*
-         * Put the length of the allocated buffer in the buffer at the
-         * beginning, then move the address we are returning to be just after
-         * the length information.  We use a 64-bit length so that we do not
-         * run into any alignment issues (we assume calloc always returns an
-         * aligned buffer).
-         */
-        *bufLen = length;
-        retVal += sizeof(uint64_t);
+/*
+ * sdl_realloc
+ *  This function is called to reallocate a larger buffer of memory.  We have
+ *  this function so that we can keep track of allocated and deallocated
+ *  memory.  NOTE: If ptr is not NULL, it is returned to the free memory pool.
+ *  The new buffer is charged to the same site as the old one.
+ *
+ * Input Parameters:
+ *  ptr:
+ *    A pointer to the buffer to be reallocated.
+ *  newSize:
+ *    A value indicating the new size that should be allocated.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:           An error occurred allocating the buffer.
+ *  !NULL:          A pointer to the buffer.
+ */
+void *sdl_realloc(void *ptr, size_t newSize)
+{
+    SDL_MEM_SITE site = MemOther;
 
-        /*
-         * If a string was supplied, then duplicate the string into the return
-         * buffer.  Otherwise, set the first byte to a null-terminator.
-         */
-        if (string != NULL)
-        {
-            strcpy(retVal, string);
-        }
-        else
-        {
-            retVal[0] = '\0';
-        }
-        _bytes_allocated += length;
+    if (ptr != NULL)
+    {
+        uint64_t *oldBufLen = (uint64_t *) ptr - 1;
+
+        site = (*oldBufLen & SDL_M_MEM_SITE) >> SDL_V_MEM_SITE;
     }
+    return(sdl_realloc_site(site, ptr, newSize));
+}
+
+/*
+ * sdl_realloc_site
+ *  This function is called to reallocate a larger buffer of memory for a
+ *  particular site, so that it is charged to that site in the memory profile.
+ *  NOTE: If ptr is not NULL, it is returned to the free memory pool.
+ *
+ * Input Parameters:
+ *  site:
+ *    A value indicating the site for which the buffer is being allocated.
+ *  ptr:
+ *    A pointer to the buffer to be reallocated.
+ *  newSize:
+ *    A value indicating the new size that should be allocated.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:           An error occurred allocating the buffer.
+ *  !NULL:          A pointer to the buffer.
+ */
+void *sdl_realloc_site(SDL_MEM_SITE site, void *ptr, size_t newSize)
+{
+    void *retVal = _sdl_alloc(NULL, newSize, site);
 
     /*
-     * Trace the strdup, plus additional relevant information.
+     * Copy the contents of the old buffer to the new one, but only if there
+     * is an old one, and then free the old one, as we no longer need it.
      */
-    if (traceMemory == true)
+    if ((retVal != NULL) && (ptr != NULL))
     {
-        printf("%s:%d:sdl_strdup: size = %ld, address: 0x%016lx\n"
-               "\tsdl_allocate_blk Calls: %ld\n\tsdl_deallocate_blk Calls: %ld\n"
-               "\tsdl_strdup Calls: %ld\n\tsdl_calloc Calls: %ld\n"
-               "\tsdl_realloc Calls: %ld\n\tsdl_free Calls: %ld\n"
-               "Bytes Allocated: %ld, Bytes Deallocated: %ld, "
-               "Bytes Remaining %ld\n",
-               __FILE__,
-               __LINE__,
-               length,
-               (uint64_t) retVal,
-               _allocate_calls,
-               _deallocate_calls,
-               _strdup_calls,
-               _calloc_calls,
-               _realloc_calls,
-               _free_calls,
-               _bytes_allocated,
-               _bytes_deallocated,
-               _bytes_allocated - _bytes_deallocated);
+        uint64_t *oldBufLen = (uint64_t *) ptr - 1;
+        size_t copyLen = (*oldBufLen & SDL_M_LENGTH) - sizeof(uint64_t);
+
+        if (copyLen > newSize)
+        {
+            copyLen = newSize;
+        }
+        memcpy(retVal, ptr, copyLen);
+        _sdl_release(ptr);
     }
 
     /*
@@ -843,215 +911,315 @@ char *sdl_strdup(const char *string)
 }
 
 /*
- * sdl_calloc
- *  This function is called to allocate a buffer of memory.  We have this
- *  function so that we can keep track of allocated and deallocated memory.
+ * sdl_free
+ *  This function is called to free a buffer of memory.  We have this function
+ *  so that we can keep track of allocated and deallocated memory.
  *
  * Input Parameters:
- *  count:
- *    A value indicating the number of items to be allocated.
- *  size:
- *    A value indicating the size of each item to be allocated.
+ *  ptr:
+ *    A pointer to a buffer to be deallocated.
  *
  * Output Parameters:
  *  None.
  *
  * Return Values:
- *  NULL:    An error occurred allocating the buffer.
- *  !NULL:    A pointer to the buffer.
+ *  None.
  */
-void *sdl_calloc(size_t count, size_t size)
+void sdl_free(void *ptr)
 {
-    void *retVal;
-    size_t length = sizeof(uint64_t) + (count * size);
 
     /*
-     * Increment the call counter.
+     * If there is a buffer supplied on the call, then free it.
      */
-    _calloc_calls++;
+    if (ptr != NULL)
+    {
+        _sdl_release(ptr);
+    }
 
     /*
-     * Allocate a buffer large enough for the requested size plus the bit of
-     * overhead we have.
+     * Return back to the caller.
      */
-    retVal = calloc(length, 1);
+    return;
+}
+
+
+
+/*
+ * sdl_set_arena
+ *  This function is called to set the arena out of which blocks and strings
+ *  are allocated.  Until the next call, sdl_allocate_block and sdl_strdup
+ *  carve their memory out of this arena.  The arena is set for the calling
+ *  thread only.
+ *
+ * Input Parameters:
+ *  arena:
+ *    A pointer to the arena to use.  If this is NULL, memory is allocated
+ *    from the heap.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_set_arena(SDL_ARENA *arena)
+{
+    _sdl_arena = arena;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_arena_alloc
+ *  This function is called to carve a zeroed buffer out of a specific arena,
+ *  regardless of the current arena.
+ *
+ * Input Parameters:
+ *  arena:
+ *    A pointer to the arena out of which to carve the buffer.
+ *  size:
+ *    A value indicating the number of bytes needed.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:           An error occurred allocating the buffer.
+ *  !NULL:          A pointer to the buffer.
+ */
+void *sdl_arena_alloc(SDL_ARENA *arena, size_t size)
+{
+    return(_sdl_alloc(arena, size, MemArenaAlloc));
+}
+
+/*
+ * sdl_arena_release
+ *  This function is called to release all the memory carved out of an arena
+ *  at once.  Every block and string allocated from the arena is no longer
+ *  valid after this call.  The peak usage is retained across releases.  When
+ *  memory is being traced, the bytes of each buffer carved out of the arena
+ *  are taken back from the site that allocated it.
+ *
+ * Input Parameters:
+ *  arena:
+ *    A pointer to the arena to be released.
+ *
+ * Output Parameters:
+ *  arena:
+ *    A pointer to the now empty arena.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_arena_release(SDL_ARENA *arena)
+{
+    SDL_ARENA_CHUNK *chunk = arena->chunks;
+
+    if (arena == _sdl_arena)
+    {
+        _sdl_arena = NULL;
+    }
 
     /*
-     * If the allocate was successful, then set the length information, and
-     * change the returned pointer to just after the length field.
+     * Free each of the chunks.
      */
-    if (retVal != NULL)
+    while (chunk != NULL)
     {
-        uint64_t *bufLen = (uint64_t *) retVal;
+        SDL_ARENA_CHUNK *next = chunk->next;
 
-        /*
-         * Put the length of the allocated buffer in the buffer at the
-         * beginning, then move the address we are returning to be just after
-         * the length information.  We use a 64-bit length so that we do not
-         * run into any alignment issues (we assume calloc always returns an
-         * aligned buffer).
-         */
-        *bufLen = length;
-        retVal += sizeof(uint64_t);
-        _bytes_allocated += length;
+        if (traceMemory == true)
+        {
+            uint64_t offset = 0;
+
+            while (offset < chunk->used)
+            {
+                uint64_t *bufLen = (uint64_t *) ((char *) (chunk + 1) + offset);
+                uint64_t length = *bufLen & SDL_M_LENGTH;
+
+                _sdl_mem_credit((*bufLen & SDL_M_MEM_SITE) >> SDL_V_MEM_SITE,
+                                length);
+                offset += length;
+            }
+        }
+        free(chunk);
+        chunk = next;
     }
 
     /*
-     * Trace the calloc, plus additional relevant information.
+     * Add the arena to the memory profile.
      */
-    if (traceMemory == true)
+    if ((traceMemory == true) && (arena->chunkCount > 0))
     {
-        printf("%s:%d:sdl_calloc: size = %ld, address: 0x%016lx\n"
-               "\tsdl_allocate_blk Calls: %ld\n\tsdl_deallocate_blk Calls: %ld\n"
-               "\tsdl_strdup Calls: %ld\n\tsdl_calloc Calls: %ld\n"
-               "\tsdl_realloc Calls: %ld\n\tsdl_free Calls: %ld\n"
-               "Bytes Allocated: %ld, Bytes Deallocated: %ld, "
-               "Bytes Remaining %ld\n",
-               __FILE__,
-               __LINE__,
-               length,
-               (uint64_t) retVal,
-               _allocate_calls,
-               _deallocate_calls,
-               _strdup_calls,
-               _calloc_calls,
-               _realloc_calls,
-               _free_calls,
-               _bytes_allocated,
-               _bytes_deallocated,
-               _bytes_allocated - _bytes_deallocated);
+        pthread_mutex_lock(&_sdl_mem_mutex);
+        _sdl_arena_releases++;
+        _sdl_arena_chunks += arena->chunkCount;
+        if (arena->peak > _sdl_arena_peak)
+        {
+            _sdl_arena_peak = arena->peak;
+        }
+        pthread_mutex_unlock(&_sdl_mem_mutex);
     }
+    arena->chunks = NULL;
+    arena->used = 0;
+    arena->chunkCount = 0;
+    arena->allocations = 0;
 
     /*
-     * Return the results back to the caller.
+     * Return back to the caller.
      */
-    return(retVal);
+    return;
 }
 
 /*
- * sdl_realloc
- *  This function is called to reallocate a larger buffer of memory.  We have
- *  this function so that we can keep track of allocated and deallocated
- *  memory.  NOTE: If ptr is not NULL, it is returned to the free memory pool.
+ * _sdl_strdup
+ *  This function is called to duplicate the memory associated with a string.
  *
  * Input Parameters:
- *  ptr:
- *    A pointer to the buffer to be reallocated.
- *  newSize:
- *    A value indicating the new size that should be allocated.
+ *  arena:
+ *    A pointer to the arena out of which to carve the string.  If this is
+ *    NULL, the string is allocated from the heap.
+ *  string:
+ *    A pointer to the string to be duplicated.
  *
  * Output Parameters:
  *  None.
  *
  * Return Values:
- *  NULL:           An error occurred allocating the buffer.
- *  !NULL:          A pointer to the buffer.
+ *  NULL:           An error occurred allocating the buffer for the duplicated
+ *                  string.
+ *  !NULL:          A pointer to the duplicated string.
  */
-void *sdl_realloc(void *ptr, size_t newSize)
+static char *_sdl_strdup(SDL_ARENA *arena, const char *string)
 {
-    void *retVal;
-    size_t length = sizeof(uint64_t) + newSize;
+    char *retVal;
+    size_t length = 1;
 
     /*
-     * Increment the call counter.
+     * If the pointer to the string is NULL, then we are just going to create
+     * a buffer to hold a zero length, null-terminated string.
      */
-    _realloc_calls++;
+    if (string != NULL)
+    {
+        length += strlen(string);
+    }
 
     /*
-     * Allocate a buffer large enough for the requested size plus the bit of
-     * overhead we have.
+     * Allocate a buffer large enough for the supplied string to be copied.
+     * The buffer is already zeroed, so a NULL string needs nothing more.
      */
-    retVal = calloc(length, 1);
+    retVal = _sdl_alloc(arena, length, MemString);
+    if ((retVal != NULL) && (string != NULL))
+    {
+        memcpy(retVal, string, length);
+    }
 
     /*
-     * If the allocate was successful, then set the length information, and
-     * change the returned pointer to just after the length field.
+     * Return the results back to the caller.
      */
-    if (retVal != NULL)
-    {
-        uint64_t *newBufLen = (uint64_t *) retVal;
-        char *oldPtr = NULL;
-        uint64_t *oldBufLen = NULL;
-        size_t copyLen = 0;
+    return(retVal);
+}
 
-        /*
-         * If ptr is NULL, then there is nothing to copy, so set things up so
-         * that we don't try.
-         */
-        if (ptr != NULL)
-        {
-            oldPtr = (char *) ptr - sizeof(uint64_t);
-            oldBufLen = (uint64_t *) oldPtr;
-            copyLen = *oldBufLen - sizeof(uint64_t);
-        }
+/*
+ * _sdl_alloc
+ *  This function is called to allocate a zeroed buffer, preceded by the
+ *  64-bit length used by sdl_free and sdl_realloc.  If an arena is supplied,
+ *  the buffer is carved out of it, and the length is flagged so the buffer is
+ *  not freed individually.  The length also has the site the buffer is
+ *  charged to.
+ *
+ * Input Parameters:
+ *  arena:
+ *    A pointer to the arena out of which to carve the buffer.  If this is
+ *    NULL, the buffer is allocated from the heap.
+ *  size:
+ *    A value indicating the number of bytes needed.
+ *  site:
+ *    A value indicating the site to which the buffer is charged.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:           An error occurred allocating the buffer.
+ *  !NULL:          A pointer to the buffer.
+ */
+static void *_sdl_alloc(SDL_ARENA *arena, size_t size, SDL_MEM_SITE site)
+{
+    uint64_t *bufLen = NULL;
+    uint64_t length = (sizeof(uint64_t) + size + 7) & ~7ULL;
+    uint64_t siteBits = (uint64_t) site << SDL_V_MEM_SITE;
 
-        /*
-         * Put the length of the allocated buffer in the buffer at the
-         * beginning, then move the address we are returning to be just after
-         * the length information.  We use a 64-bit length so that we do not
-         * run into any alignment issues (we assume calloc always returns an
-         * aligned buffer).
-         */
-        *newBufLen = length;
-        retVal += sizeof(uint64_t);
+    if (arena != NULL)
+    {
+        SDL_ARENA_CHUNK *chunk = arena->chunks;
 
         /*
-         * Now copy the contents of the old buffer to the new one, but only if
-         * there is an old one.
+         * If the current chunk does not have enough room left, then get
+         * another one.  Anything larger than a chunk gets a chunk of its own.
          */
-        if (ptr != NULL)
+        if ((chunk == NULL) || ((chunk->size - chunk->used) < length))
         {
-            memcpy(retVal, ptr, copyLen);
+            uint64_t chunkSize = (length > SDL_K_ARENA_CHUNK) ?
+                                    length : SDL_K_ARENA_CHUNK;
 
-            /*
-             * Free the old buffer, as we no longer need it.
-             */
-            free(oldPtr);
-            _bytes_deallocated += *oldBufLen;
+            chunk = calloc(1, sizeof(SDL_ARENA_CHUNK) + chunkSize);
+            if (chunk != NULL)
+            {
+                chunk->size = chunkSize;
+                chunk->next = arena->chunks;
+                arena->chunks = chunk;
+                arena->chunkCount++;
+            }
+        }
+        if (chunk != NULL)
+        {
+            bufLen = (uint64_t *) ((char *) (chunk + 1) + chunk->used);
+            chunk->used += length;
+            *bufLen = length | siteBits | SDL_M_ARENA;
+            arena->used += length;
+            arena->allocations++;
+            if (arena->used > arena->peak)
+            {
+                arena->peak = arena->used;
+            }
         }
-        _bytes_allocated += length;
     }
-
-    /*
-     * Trace the realloc, plus additional relevant information.
-     */
-    if (traceMemory == true)
+    else
     {
-        printf("%s:%d:sdl_realloc: size = %ld, address: 0x%016lx\n"
-               "\tsdl_allocate_blk Calls: %ld\n\tsdl_deallocate_blk Calls: %ld\n"
-               "\tsdl_strdup Calls: %ld\n\tsdl_calloc Calls: %ld\n"
-               "\tsdl_realloc Calls: %ld\n\tsdl_free Calls: %ld\n"
-               "Bytes Allocated: %ld, Bytes Deallocated: %ld, "
-               "Bytes Remaining %ld\n",
-               __FILE__,
-               __LINE__,
-               length,
-               (uint64_t) retVal,
-               _allocate_calls,
-               _deallocate_calls,
-               _strdup_calls,
-               _calloc_calls,
-               _realloc_calls,
-               _free_calls,
-               _bytes_allocated,
-               _bytes_deallocated,
-               _bytes_allocated - _bytes_deallocated);
+        bufLen = calloc(length, 1);
+        if (bufLen != NULL)
+        {
+            *bufLen = length | siteBits;
+        }
     }
 
     /*
-     * Return the results back to the caller.
+     * Charge the allocated bytes to the site and return the address just
+     * after the length.
      */
-    return(retVal);
+    if (bufLen != NULL)
+    {
+        if (traceMemory == true)
+        {
+            _sdl_mem_charge(site, length);
+        }
+        bufLen++;
+    }
+    return((void *) bufLen);
 }
 
 /*
- * sdl_free
- *  This function is called to free a buffer of memory.  We have this function
- *  so that we can keep track of allocated and deallocated memory.
+ * _sdl_release
+ *  This function is called to release a buffer allocated by _sdl_alloc.
+ *  Buffers carved out of an arena are released with the arena, so nothing is
+ *  done for them here.
  *
  * Input Parameters:
  *  ptr:
- *    A pointer to a buffer to be deallocated.
+ *    A pointer to the buffer to be released.
  *
  * Output Parameters:
  *  None.
@@ -1059,58 +1227,99 @@ void *sdl_realloc(void *ptr, size_t newSize)
  * Return Values:
  *  None.
  */
-void sdl_free(void *ptr)
+static void _sdl_release(void *ptr)
 {
-    char *bufPtr;
-    size_t length;
+    uint64_t *bufLen = (uint64_t *) ptr - 1;
 
-    /*
-     * Increment the call counter.
-     */
-    _free_calls++;
+    if ((*bufLen & SDL_M_ARENA) == 0)
+    {
+        if (traceMemory == true)
+        {
+            _sdl_mem_credit((*bufLen & SDL_M_MEM_SITE) >> SDL_V_MEM_SITE,
+                            *bufLen & SDL_M_LENGTH);
+        }
+        free(bufLen);
+    }
 
     /*
-     * If there is a buffer supplied on the call, then get the real beginning
-     * of the buffer, where the length information is stored.  Then free the
-     * buffer.
+     * Return back to the caller.
      */
-    if (ptr != NULL)
+    return;
+}
+
+/*
+ * _sdl_mem_charge
+ *  This function is called to charge the bytes of a buffer just allocated to
+ *  the site for which it was allocated.
+ *
+ * Input Parameters:
+ *  site:
+ *    A value indicating the site to which the buffer is charged.
+ *  length:
+ *    A value indicating the number of bytes in the buffer.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_mem_charge(SDL_MEM_SITE site, uint64_t length)
+{
+    SDL_MEM_USAGE *usage = &_sdl_mem_usage[site];
+
+    pthread_mutex_lock(&_sdl_mem_mutex);
+    usage->allocs++;
+    usage->bytes += length;
+    usage->current += length;
+    if (usage->current > usage->peak)
     {
-        bufPtr = (char *) ptr - sizeof(uint64_t);
-        length = *((uint64_t *) bufPtr);
-        free(bufPtr);
-        _bytes_deallocated += length;
+        usage->peak = usage->current;
     }
-    else
+    _sdl_mem_current += length;
+    if (_sdl_mem_current > _sdl_mem_peak)
     {
-        length = 0;
+        _sdl_mem_peak = _sdl_mem_current;
     }
+    pthread_mutex_unlock(&_sdl_mem_mutex);
 
     /*
-     * Trace the free, plus additional relevant information.
+     * Return back to the caller.
      */
-    if (traceMemory == true)
+    return;
+}
+
+/*
+ * _sdl_mem_credit
+ *  This function is called to take the bytes of a buffer being released back
+ *  from the site for which it was allocated.  Buffers allocated before memory
+ *  was being traced were never charged, so a site never goes below zero.
+ *
+ * Input Parameters:
+ *  site:
+ *    A value indicating the site to which the buffer was charged.
+ *  length:
+ *    A value indicating the number of bytes in the buffer.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_mem_credit(SDL_MEM_SITE site, uint64_t length)
+{
+    SDL_MEM_USAGE *usage = &_sdl_mem_usage[site];
+
+    pthread_mutex_lock(&_sdl_mem_mutex);
+    if (length > usage->current)
     {
-        printf("%s:%d:sdl_free: size = %ld, address: 0x%016lx\n"
-               "\tsdl_allocate_blk Calls: %ld\n\tsdl_deallocate_blk Calls: %ld\n"
-               "\tsdl_strdup Calls: %ld\n\tsdl_calloc Calls: %ld\n"
-               "\tsdl_realloc Calls: %ld\n\tsdl_free Calls: %ld\n"
-               "Bytes Allocated: %ld, Bytes Deallocated: %ld, "
-               "Bytes Remaining %ld\n",
-               __FILE__,
-               __LINE__,
-               length,
-               (uint64_t) ptr,
-               _allocate_calls,
-               _deallocate_calls,
-               _strdup_calls,
-               _calloc_calls,
-               _realloc_calls,
-               _free_calls,
-               _bytes_allocated,
-               _bytes_deallocated,
-               _bytes_allocated - _bytes_deallocated);
+        length = usage->current;
     }
+    usage->frees++;
+    usage->current -= length;
+    _sdl_mem_current -= length;
+    pthread_mutex_unlock(&_sdl_mem_mutex);
 
     /*
      * Return back to the caller.
@@ -1118,5 +1327,83 @@ void sdl_free(void *ptr)
     return;
 }
 
+/*
+ * _sdl_mem_report
+ *  This function is called when the program exits, when memory is being
+ *  traced, to write out the memory profile.  It has a line for each site
+ *  that allocated anything, with the number of allocations and releases, the
+ *  bytes allocated, the most bytes in use at once, and the bytes still in use,
+ *  followed by the arenas and the peak resident set size of the process.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_mem_report(void)
+{
+    SDL_MEM_USAGE total;
+    struct rusage rusage;
+    int ii;
+
+    memset(&total, 0, sizeof(total));
+    pthread_mutex_lock(&_sdl_mem_mutex);
+    fprintf(stderr,
+            "\nMemory profile:\n  %-12s %10s %10s %14s %14s %14s\n",
+            "Site",
+            "Allocs",
+            "Frees",
+            "Bytes",
+            "Peak",
+            "In Use");
+    for (ii = 0; ii < MemMax; ii++)
+    {
+        SDL_MEM_USAGE *usage = &_sdl_mem_usage[ii];
 
+        if (usage->allocs > 0)
+        {
+            fprintf(stderr,
+                    "  %-12s %10lu %10lu %14lu %14lu %14lu\n",
+                    _sdl_mem_site[ii],
+                    usage->allocs,
+                    usage->frees,
+                    usage->bytes,
+                    usage->peak,
+                    usage->current);
+            total.allocs += usage->allocs;
+            total.frees += usage->frees;
+            total.bytes += usage->bytes;
+        }
+    }
+    fprintf(stderr,
+            "  %-12s %10lu %10lu %14lu %14lu %14lu\n",
+            "total",
+            total.allocs,
+            total.frees,
+            total.bytes,
+            _sdl_mem_peak,
+            _sdl_mem_current);
+    fprintf(stderr,
+            "  Arenas released: %lu, chunks: %lu, largest peak: %lu bytes\n",
+            _sdl_arena_releases,
+            _sdl_arena_chunks,
+            _sdl_arena_peak);
+    pthread_mutex_unlock(&_sdl_mem_mutex);
+
+    /*
+     * The peak resident set size is in kilobytes.
+     */
+    if (getrusage(RUSAGE_SELF, &rusage) == 0)
+    {
+        fprintf(stderr, "  Peak RSS: %ld KB\n", rusage.ru_maxrss);
+    }
 
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the identifier pool routines.  Each compilation
+ *  has a pool of its own, in its context, so no lock is needed.  Identifiers
+ *  are carved out of the pool's arena, which lives until the pool is released
+ *  at the end of the compilation, and are indexed in the pool's symbol table.
+ *  Each interned identifier is laid out as:
+ *
+ *      +--------------------+
+ *      | hash   | length    |    SDL_INTERN_HDR
+ *      +--------------------+
+ *      | length | ARENA     |    what sdl_free and sdl_realloc look at, with
+ *      |        | MemIntern |    the MemIntern site to mark it as interned
+ *      +--------------------+
+ *      | string ... \0      |    <- returned pointer
+ *      +--------------------+
+ *
+ * Revision History:
+ *
+ *  V01.000 15-OCT-2026 Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001 15-OCT-2026 Jonathan D. Belanger
+ *  The pool is shared by every compilation in the process, so it is now
+ *  protected by a mutex.
+ *
+ *  V01.002 16-OCT-2026 Jonathan D. Belanger
+ *  Nothing used the hash saved with each identifier, so it is no longer
+ *  saved.  The symbol tables already compare the pointers before the strings.
+ *
+ *  V01.003 16-OCT-2026 Jonathan D. Belanger
+ *  The pool is kept in the context, rather than shared by every compilation
+ *  in the process behind a mutex, and is released with the context.  The
+ *  hash is saved with each identifier again, and sdl_intern_hash returns it,
+ *  so that the symbol tables do not hash an interned name a second time.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_intern.h"
+
+typedef struct
+{
+    uint32_t    hash;
+    uint32_t    length;
+    uint64_t    bufLen;
+} SDL_INTERN_HDR;
+
+#define SDL_M_INTERN    (SDL_M_ARENA | ((uint64_t) MemIntern << SDL_V_MEM_SITE))
+
+/*
+ * sdl_intern_init
+ *  This function is called to initialize an empty identifier pool.  No memory
+ *  is allocated until the first identifier is interned.
+ *
+ * Input Parameters:
+ *  pool:
+ *    A pointer to the identifier pool to be initialized.
+ *
+ * Output Parameters:
+ *  pool:
+ *    A pointer to the initialized identifier pool.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_intern_init(SDL_INTERN_POOL *pool)
+{
+    memset(&pool->arena, 0, sizeof(SDL_ARENA));
+    sdl_symtab_init(&pool->symtab, 0);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_intern
+ *  This function is called to get the interned copy of a string.  If the
+ *  string has not been seen before, it is added to the pool.  The string is
+ *  hashed once, for both the lookup and the insert, and the hash is saved
+ *  with the identifier.
+ *
+ * Input Parameters:
+ *  pool:
+ *    A pointer to the identifier pool.
+ *  string:
+ *    A pointer to the string to be interned.  This may itself be an interned
+ *    string.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:           The string was NULL, or an error occurred allocating
+ *                  memory.
+ *  !NULL:          A pointer to the interned string.
+ */
+char *sdl_intern(SDL_INTERN_POOL *pool, const char *string)
+{
+    char *retVal = NULL;
+
+    if (string != NULL)
+    {
+        uint32_t hash = sdl_symtab_hash(string);
+
+        retVal = sdl_symtab_lookup_hash(&pool->symtab, string, hash);
+        if (retVal == NULL)
+        {
+            size_t length = strlen(string);
+            SDL_INTERN_HDR *hdr = sdl_arena_alloc(&pool->arena,
+                                                  sizeof(SDL_INTERN_HDR) +
+                                                  length + 1);
+
+            if (hdr != NULL)
+            {
+                hdr->hash = hash;
+                hdr->length = length;
+                hdr->bufLen = (sizeof(uint64_t) + length + 1) | SDL_M_INTERN;
+                retVal = (char *) (hdr + 1);
+                memcpy(retVal, string, length + 1);
+                if (sdl_symtab_insert_hash(&pool->symtab,
+                                           retVal,
+                                           hash,
+                                           0,
+                                           retVal) != SDL_NORMAL)
+                {
+                    retVal = NULL;
+                }
+            }
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_intern_hash
+ *  This function is called to get the hash of a name, for a symbol table.  If
+ *  the name is interned, then the hash saved with it is returned.  Otherwise,
+ *  it is calculated.
+ *
+ * Input Parameters:
+ *  name:
+ *    A pointer to the name.  This must be an interned string, or one that
+ *    could be passed to sdl_free, so that there is a length in front of it.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  The hash value for the name, as returned by sdl_symtab_hash.
+ */
+uint32_t sdl_intern_hash(const char *name)
+{
+    const uint64_t *bufLen = (const uint64_t *) name - 1;
+    uint32_t retVal;
+
+    if ((*bufLen & (SDL_M_ARENA | SDL_M_MEM_SITE)) == SDL_M_INTERN)
+    {
+        retVal = ((const SDL_INTERN_HDR *) name - 1)->hash;
+    }
+    else
+    {
+        retVal = sdl_symtab_hash(name);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_intern_release
+ *  This function is called to release an identifier pool.  Every string
+ *  interned in it is no longer valid after this call.  The pool is left empty,
+ *  and may be used again.
+ *
+ * Input Parameters:
+ *  pool:
+ *    A pointer to the identifier pool to be released.
+ *
+ * Output Parameters:
+ *  pool:
+ *    A pointer to the empty identifier pool.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_intern_release(SDL_INTERN_POOL *pool)
+{
+    sdl_symtab_reset(&pool->symtab);
+    sdl_arena_release(&pool->arena);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
@@ -22,6 +22,12 @@
  *
  *  V01.000    09-OCT-2018    Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001    15-OCT-2026    Jonathan D. Belanger
+ *  Added SRVSOCKET, for the compile server.
+ *
+ *  V01.002    16-OCT-2026    Jonathan D. Belanger
+ *  Added BADREPLAY, for replaying a recording.
  */
 #include <errno.h>
 #include <stdarg.h>
@@ -561,6 +567,18 @@ static SDL_MSG_ARRAY sdlmsg[] =
         1,
         0
     },
+    {
+        "SRVSOCKET",
+        "Unable to use compile server socket %.*s",
+        1,
+        0
+    },
+    {
+        "BADREPLAY",
+        "%.*s is not a recording that can be replayed",
+        1,
+        0
+    },
     {"", "", 0, 0}
 };
 
@@ -0,0 +1,448 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the output sink routines.  The language plugins
+ *  append their output to a sink, rather than writing each piece of it to
+ *  the output file.  The sink is written to the output file with a single
+ *  write when it is flushed, which is normally only when the output file is
+ *  closed.  The first error that occurs is remembered, after which nothing
+ *  more is appended, and is returned when the sink is flushed.
+ *
+ * Revision History:
+ *
+ *  V01.000 15-OCT-2026 Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_sink.h"
+
+/*
+ * Local Prototypes
+ */
+static char *_sdl_sink_reserve(SDL_SINK *sink, size_t length);
+
+/*
+ * sdl_sink_init
+ *  This function is called to initialize an empty sink for an output file.
+ *  No buffer is allocated until something is written.
+ *
+ * Input Parameters:
+ *  sink:
+ *    A pointer to the sink to be initialized.
+ *  fp:
+ *    A pointer to the output file to which the sink is flushed.
+ *
+ * Output Parameters:
+ *  sink:
+ *    A pointer to the initialized sink.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_sink_init(SDL_SINK *sink, FILE *fp)
+{
+    sink->fp = fp;
+    sink->buffer = NULL;
+    sink->size = 0;
+    sink->used = 0;
+    sink->error = 0;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_sink_write
+ *  This function is called to append a number of bytes to a sink.
+ *
+ * Input Parameters:
+ *  sink:
+ *    A pointer to the sink.
+ *  buffer:
+ *    A pointer to the bytes to be appended.
+ *  length:
+ *    A value indicating the number of bytes to be appended.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  0:      Normal Successful Completion.
+ *  EOF:    The sink has had an error, and errno is set.
+ */
+int sdl_sink_write(SDL_SINK *sink, const char *buffer, size_t length)
+{
+    char *ptr = _sdl_sink_reserve(sink, length);
+    int retVal = EOF;
+
+    if (ptr != NULL)
+    {
+        memcpy(ptr, buffer, length);
+        sink->used += length;
+        retVal = 0;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_sink_puts
+ *  This function is called to append a null-terminated string to a sink.
+ *  Unlike puts, a new-line is not appended.
+ *
+ * Input Parameters:
+ *  sink:
+ *    A pointer to the sink.
+ *  string:
+ *    A pointer to the string to be appended.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  0:      Normal Successful Completion.
+ *  EOF:    The sink has had an error, and errno is set.
+ */
+int sdl_sink_puts(SDL_SINK *sink, const char *string)
+{
+    return(sdl_sink_write(sink, string, strlen(string)));
+}
+
+/*
+ * sdl_sink_putc
+ *  This function is called to append a single character to a sink.
+ *
+ * Input Parameters:
+ *  sink:
+ *    A pointer to the sink.
+ *  character:
+ *    A value containing the character to be appended.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  0:      Normal Successful Completion.
+ *  EOF:    The sink has had an error, and errno is set.
+ */
+int sdl_sink_putc(SDL_SINK *sink, char character)
+{
+    char *ptr = _sdl_sink_reserve(sink, 1);
+    int retVal = EOF;
+
+    if (ptr != NULL)
+    {
+        *ptr = character;
+        sink->used++;
+        retVal = 0;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_sink_dec
+ *  This function is called to append a signed integer, in decimal, to a
+ *  sink.  This is the same as the "%ld" format, without having to parse the
+ *  format.
+ *
+ * Input Parameters:
+ *  sink:
+ *    A pointer to the sink.
+ *  value:
+ *    A value to be appended.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  0:      Normal Successful Completion.
+ *  EOF:    The sink has had an error, and errno is set.
+ */
+int sdl_sink_dec(SDL_SINK *sink, int64_t value)
+{
+    char digits[24];
+    char *ptr = &digits[sizeof(digits)];
+    uint64_t magnitude = (value < 0) ? -(uint64_t) value : (uint64_t) value;
+
+    do
+    {
+        *--ptr = '0' + (magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0)
+    {
+        *--ptr = '-';
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(sdl_sink_write(sink, ptr, &digits[sizeof(digits)] - ptr));
+}
+
+/*
+ * sdl_sink_hex
+ *  This function is called to append an unsigned integer, in hexadecimal, to
+ *  a sink.  This is the same as the "%lx" format, without having to parse the
+ *  format.
+ *
+ * Input Parameters:
+ *  sink:
+ *    A pointer to the sink.
+ *  value:
+ *    A value to be appended.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  0:      Normal Successful Completion.
+ *  EOF:    The sink has had an error, and errno is set.
+ */
+int sdl_sink_hex(SDL_SINK *sink, uint64_t value)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    char digits[16];
+    char *ptr = &digits[sizeof(digits)];
+
+    do
+    {
+        *--ptr = hexDigits[value & 0xf];
+        value >>= 4;
+    } while (value != 0);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(sdl_sink_write(sink, ptr, &digits[sizeof(digits)] - ptr));
+}
+
+/*
+ * sdl_sink_printf
+ *  This function is called to append formatted output to a sink.  The output
+ *  is formatted directly into the sink's buffer.
+ *
+ * Input Parameters:
+ *  sink:
+ *    A pointer to the sink.
+ *  format:
+ *    A pointer to the printf format string.
+ *  ...:
+ *    The arguments for the format string.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  >=0:    The number of characters appended.
+ *  <0:     The sink has had an error, and errno is set.
+ */
+int sdl_sink_printf(SDL_SINK *sink, const char *format, ...)
+{
+    va_list ap;
+    size_t avail = sink->size - sink->used;
+    int retVal = EOF;
+
+    if (sink->error == 0)
+    {
+        va_start(ap, format);
+        retVal = vsnprintf(&sink->buffer[sink->used], avail, format, ap);
+        va_end(ap);
+
+        /*
+         * If it did not fit, then make room for it and format it again.
+         */
+        if ((retVal >= 0) && ((size_t) retVal >= avail))
+        {
+            if (_sdl_sink_reserve(sink, retVal + 1) != NULL)
+            {
+                va_start(ap, format);
+                vsnprintf(&sink->buffer[sink->used], retVal + 1, format, ap);
+                va_end(ap);
+            }
+            else
+            {
+                retVal = EOF;
+            }
+        }
+        else if (retVal < 0)
+        {
+            sink->error = errno;
+        }
+        if (retVal > 0)
+        {
+            sink->used += retVal;
+        }
+    }
+    else
+    {
+        errno = sink->error;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_sink_flush
+ *  This function is called to write everything appended to a sink out to its
+ *  output file, with a single write, and empty the sink.
+ *
+ * Input Parameters:
+ *  sink:
+ *    A pointer to the sink.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  0:      Normal Successful Completion.
+ *  !0:     The errno value for the first error the sink has had.
+ */
+int sdl_sink_flush(SDL_SINK *sink)
+{
+    if ((sink->error == 0) && (sink->used > 0))
+    {
+        if ((fwrite(sink->buffer, 1, sink->used, sink->fp) != sink->used) ||
+            (fflush(sink->fp) != 0))
+        {
+            sink->error = (errno != 0) ? errno : EIO;
+        }
+    }
+    sink->used = 0;
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(sink->error);
+}
+
+/*
+ * sdl_sink_close
+ *  This function is called to flush a sink and free its buffer.  The output
+ *  file is not closed.
+ *
+ * Input Parameters:
+ *  sink:
+ *    A pointer to the sink.
+ *
+ * Output Parameters:
+ *  sink:
+ *    A pointer to the now empty sink.
+ *
+ * Return Values:
+ *  0:      Normal Successful Completion.
+ *  !0:     The errno value for the first error the sink has had.
+ */
+int sdl_sink_close(SDL_SINK *sink)
+{
+    int retVal = sdl_sink_flush(sink);
+
+    if (sink->buffer != NULL)
+    {
+        sdl_free(sink->buffer);
+    }
+    sdl_sink_init(sink, sink->fp);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/************************************************************************/
+/* Local Functions                            */
+/************************************************************************/
+
+/*
+ * _sdl_sink_reserve
+ *  This function is called to make sure there is room in a sink's buffer for
+ *  a number of bytes to be appended, growing the buffer if there is not.
+ *
+ * Input Parameters:
+ *  sink:
+ *    A pointer to the sink.
+ *  length:
+ *    A value indicating the number of bytes needed.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:   The sink has had an error, and errno is set.
+ *  !NULL:  A pointer to where the bytes are to be appended.
+ */
+static char *_sdl_sink_reserve(SDL_SINK *sink, size_t length)
+{
+    char *retVal = NULL;
+
+    if (sink->error == 0)
+    {
+        if ((sink->size - sink->used) < length)
+        {
+            size_t newSize = (sink->size == 0) ? SDL_K_SINK_SIZE : sink->size;
+            char *buffer;
+
+            while ((newSize - sink->used) < length)
+            {
+                newSize *= 2;
+            }
+            buffer = sdl_realloc(sink->buffer, newSize);
+            if (buffer != NULL)
+            {
+                sink->buffer = buffer;
+                sink->size = newSize;
+            }
+            else
+            {
+                sink->error = ENOMEM;
+            }
+        }
+        if (sink->error == 0)
+        {
+            retVal = &sink->buffer[sink->used];
+        }
+    }
+    if (retVal == NULL)
+    {
+        errno = sink->error;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
@@ -0,0 +1,1290 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the routines that gather and report the
+ *  statistics for the --stats qualifier.  The time for each phase is taken
+ *  from the monotonic clock and from the CPU time clock for the calling
+ *  thread.  When a phase is begun while another is in progress, the time up
+ *  to that point is charged to the one in progress, and the time after it
+ *  ends is charged to it again, so that the time for each phase does not
+ *  include the time for the phases within it.
+ *
+ *  With --counters, the hardware counters for the calling thread are read
+ *  with the clocks, and charged to the phases the same way.  On Linux, they
+ *  are opened with perf_event_open, as one group for each thread, so that
+ *  they are all read with a single call.  Only what runs in user mode is
+ *  counted, which is usually allowed without any privileges.  When a counter
+ *  cannot be opened, it is left out, and when none can be, only the time is
+ *  reported.
+ *
+ * Revision History:
+ *
+ *  V01.000 16-OCT-2026 Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001 16-OCT-2026 Jonathan D. Belanger
+ *  Added the hardware counters for --counters.
+ *
+ *  V01.002 16-OCT-2026 Jonathan D. Belanger
+ *  The language statistics are allocated with sdl_calloc, like the rest of
+ *  the library's memory.
+ *
+ *  V01.003 16-OCT-2026 Jonathan D. Belanger
+ *  So are the hardware counters for each thread.
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#include "opensdl_defs.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_stats.h"
+
+/*
+ * The hardware counters opened for a thread.  The first one opened leads the
+ * group, and the values are read from it in the order they were opened.
+ */
+typedef struct
+{
+    int             fd[CounterMax];
+    int             leader;
+    uint32_t        mask;
+} SDL_STATS_PERF;
+
+/*
+ * Local Variables
+ */
+static bool _sdl_stats_counters = false;
+static bool _sdl_stats_counters_open = false;
+static int _sdl_stats_counter_errno = 0;
+static pthread_once_t _sdl_stats_once = PTHREAD_ONCE_INIT;
+static pthread_key_t _sdl_stats_key;
+
+/*
+ * Local Variables (one for each thread)
+ */
+static SDL_THREAD_LOCAL SDL_STATS *_sdl_stats = NULL;
+static SDL_THREAD_LOCAL SDL_STATS_PERF *_sdl_stats_perf = NULL;
+
+static const char *_sdl_stats_phase[PhaseMax] =
+{
+    "options",
+    "plugins",
+    "lex",
+    "parse",
+    "layout",
+    "emit",
+    "listing",
+    "teardown"
+};
+
+static const char *_sdl_stats_block[EntryBlock + 1] =
+{
+    NULL,
+    "local",
+    "literal",
+    "constant",
+    "enum_member",
+    "enumerate",
+    "declare",
+    "item",
+    "aggr_member",
+    "aggregate",
+    "parameter",
+    "entry"
+};
+
+static const char *_sdl_stats_counter[CounterMax] =
+{
+    "cycles",
+    "instructions",
+    "cache_misses",
+    "branch_misses"
+};
+
+/*
+ * Local Functions
+ */
+static void _sdl_stats_charge(SDL_STATS *stats);
+static void _sdl_stats_add(SDL_STATS_TIME *time,
+                           SDL_STATS_CLOCK *now,
+                           SDL_STATS_CLOCK *then);
+static void _sdl_stats_json_time(FILE *fp, SDL_STATS_TIME *time);
+static void _sdl_stats_json_counters(FILE *fp, SDL_STATS_TIME *time);
+static void _sdl_stats_json_string(FILE *fp, char *string);
+static void _sdl_stats_text_counters(FILE *fp,
+                                     const char *name,
+                                     SDL_STATS_TIME *time);
+static SDL_STATS_PERF *_sdl_stats_perf_open(void);
+static void _sdl_stats_perf_read(SDL_STATS_CLOCK *clock);
+static void _sdl_stats_perf_key_init(void);
+static void _sdl_stats_perf_close(void *arg);
+
+/*
+ * sdl_stats_set
+ *  This function is called to set the statistics being gathered by the
+ *  calling thread.
+ *
+ * Input Parameters:
+ *  stats:
+ *    A pointer to the statistics to be gathered, or NULL to stop gathering
+ *    them.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  A pointer to the statistics that were being gathered, so that they can be
+ *  set again, or NULL.
+ */
+SDL_STATS *sdl_stats_set(SDL_STATS *stats)
+{
+    SDL_STATS *retVal = _sdl_stats;
+
+    _sdl_stats = stats;
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_stats_counters
+ *  This function is called to have the hardware counters read with the
+ *  clocks, from now on, for every thread.  They are opened for the calling
+ *  thread right away, so that the caller knows whether any can be read.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:       At least one of the counters can be read.
+ *  false:      None of the counters can be read, only the time is reported.
+ */
+bool sdl_stats_counters(void)
+{
+    SDL_STATS_PERF *perf;
+
+    _sdl_stats_counters = true;
+    perf = _sdl_stats_perf_open();
+
+    /*
+     * Return the results back to the caller.
+     */
+    return((perf != NULL) && (perf->mask != 0));
+}
+
+/*
+ * sdl_stats_init
+ *  This function is called to initialize a set of statistics and start the
+ *  clock for their total time.
+ *
+ * Input Parameters:
+ *  stats:
+ *    A pointer to the statistics to be initialized.
+ *  langCount:
+ *    A value indicating the number of languages there are to be statistics
+ *    for.  The caller sets the name of each of them.
+ *
+ * Output Parameters:
+ *  stats:
+ *    A pointer to the initialized statistics.
+ *
+ * Return Values:
+ *  true:       Normal Successful Completion.
+ *  false:      An error occurred allocating memory.
+ */
+bool sdl_stats_init(SDL_STATS *stats, uint32_t langCount)
+{
+    bool retVal = true;
+
+    memset(stats, 0, sizeof(SDL_STATS));
+    if (langCount > 0)
+    {
+        stats->lang = sdl_calloc(langCount, sizeof(SDL_STATS_LANG));
+        if (stats->lang != NULL)
+        {
+            stats->langCount = langCount;
+        }
+        else
+        {
+            retVal = false;
+        }
+    }
+    sdl_stats_clock(&stats->start);
+    stats->mark = stats->start;
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_stats_finish
+ *  This function is called to stop the clock for the total time of a set of
+ *  statistics.  If the calling thread was gathering them, it no longer is.
+ *
+ * Input Parameters:
+ *  stats:
+ *    A pointer to the statistics.
+ *
+ * Output Parameters:
+ *  stats:
+ *    A pointer to the statistics, with their total time.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_stats_finish(SDL_STATS *stats)
+{
+    SDL_STATS_CLOCK now;
+
+    sdl_stats_clock(&now);
+    _sdl_stats_add(&stats->total, &now, &stats->start);
+    if (_sdl_stats == stats)
+    {
+        _sdl_stats = NULL;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_stats_free
+ *  This function is called to free the memory allocated for a set of
+ *  statistics.
+ *
+ * Input Parameters:
+ *  stats:
+ *    A pointer to the statistics.
+ *
+ * Output Parameters:
+ *  stats:
+ *    A pointer to the now empty statistics.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_stats_free(SDL_STATS *stats)
+{
+    if (stats->lang != NULL)
+    {
+        sdl_free(stats->lang);
+    }
+    memset(stats, 0, sizeof(SDL_STATS));
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_stats_clock
+ *  This function is called to read the wall clock and the CPU time for the
+ *  calling thread, both in nanoseconds, and with --counters, the hardware
+ *  counters for the calling thread.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  clock:
+ *    A pointer to where the clocks are to be returned.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_stats_clock(SDL_STATS_CLOCK *clock)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    clock->wallNs = (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    clock->cpuNs = (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+    clock->counterMask = 0;
+    if (_sdl_stats_counters == true)
+    {
+        _sdl_stats_perf_read(clock);
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_stats_begin
+ *  This function is called when a phase is begun.  Phases may be begun
+ *  within other phases, and each one must be ended by calling sdl_stats_end.
+ *
+ * Input Parameters:
+ *  phase:
+ *    A value indicating the phase being begun.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_stats_begin(SDL_STATS_PHASE phase)
+{
+    SDL_STATS *stats = _sdl_stats;
+
+    if (stats != NULL)
+    {
+        _sdl_stats_charge(stats);
+        if (stats->depth < SDL_K_STATS_DEPTH)
+        {
+            stats->stack[stats->depth] = phase;
+        }
+        stats->depth++;
+        stats->phase[phase].count++;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_stats_end
+ *  This function is called when the phase last begun has ended.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_stats_end(void)
+{
+    SDL_STATS *stats = _sdl_stats;
+
+    if ((stats != NULL) && (stats->depth > 0))
+    {
+        _sdl_stats_charge(stats);
+        stats->depth--;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_stats_block
+ *  This function is called when a block has been allocated.
+ *
+ * Input Parameters:
+ *  blockID:
+ *    A value indicating the type of block that was allocated.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_stats_block(SDL_BLOCK_ID blockID)
+{
+    if ((_sdl_stats != NULL) && (blockID <= EntryBlock))
+    {
+        _sdl_stats->blocks[blockID]++;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_stats_lookup
+ *  This function is called when a symbol table is searched.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_stats_lookup(void)
+{
+    if (_sdl_stats != NULL)
+    {
+        _sdl_stats->lookups++;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_stats_insert
+ *  This function is called when a symbol is inserted into a symbol table.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_stats_insert(void)
+{
+    if (_sdl_stats != NULL)
+    {
+        _sdl_stats->inserts++;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_stats_token
+ *  This function is called when the scanner has returned a token.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_stats_token(void)
+{
+    if (_sdl_stats != NULL)
+    {
+        _sdl_stats->tokens++;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_stats_lang
+ *  This function is called when a language has finished generating its
+ *  output for a MODULE.  It may be called from the thread generating the
+ *  output, as each language only ever updates its own statistics.
+ *
+ * Input Parameters:
+ *  stats:
+ *    A pointer to the statistics.  If there are no statistics for the
+ *    languages, nothing is done.
+ *  langId:
+ *    A value indicating the language.
+ *  start:
+ *    A pointer to the clocks read, on the same thread, when the language
+ *    started generating its output.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_stats_lang(SDL_STATS *stats,
+                    uint32_t langId,
+                    SDL_STATS_CLOCK *start)
+{
+    if ((stats->lang != NULL) && (langId < stats->langCount))
+    {
+        SDL_STATS_CLOCK now;
+
+        sdl_stats_clock(&now);
+        _sdl_stats_add(&stats->lang[langId].time, &now, start);
+        stats->lang[langId].time.count++;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_stats_write
+ *  This function is called to write out a set of statistics, either as text
+ *  or as a JSON object on a single line.
+ *
+ * Input Parameters:
+ *  fp:
+ *    A pointer to the file to write to.
+ *  stats:
+ *    A pointer to the statistics to be written.
+ *  name:
+ *    A pointer to the name of the file the statistics are for, or NULL when
+ *    they are for the whole run.
+ *  json:
+ *    A boolean indicating that the statistics are to be written as JSON.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_stats_write(FILE *fp, SDL_STATS *stats, char *name, bool json)
+{
+    SDL_STATS_TIME other = stats->total;
+    uint32_t counterMask = stats->total.counterMask;
+    int blocks = 0;
+    int ii, jj;
+
+    for (ii = 0; ii < PhaseMax; ii++)
+    {
+        SDL_STATS_TIME *phase = &stats->phase[ii];
+
+        other.wallNs -= (phase->wallNs < other.wallNs) ?
+            phase->wallNs : other.wallNs;
+        other.cpuNs -= (phase->cpuNs < other.cpuNs) ?
+            phase->cpuNs : other.cpuNs;
+        for (jj = 0; jj < CounterMax; jj++)
+        {
+            other.counter[jj] -= (phase->counter[jj] < other.counter[jj]) ?
+                phase->counter[jj] : other.counter[jj];
+        }
+        counterMask |= phase->counterMask;
+    }
+    other.count = 0;
+    for (ii = 0; ii < (int) stats->langCount; ii++)
+    {
+        counterMask |= stats->lang[ii].time.counterMask;
+    }
+
+    if (json == true)
+    {
+        fprintf(fp, "{\"file\":");
+        _sdl_stats_json_string(fp, name);
+        fprintf(fp, ",\"total\":");
+        _sdl_stats_json_time(fp, &stats->total);
+        fprintf(fp, ",\"phases\":{");
+        for (ii = 0; ii < PhaseMax; ii++)
+        {
+            fprintf(fp, "\"%s\":", _sdl_stats_phase[ii]);
+            _sdl_stats_json_time(fp, &stats->phase[ii]);
+            fprintf(fp, ",");
+        }
+        fprintf(fp, "\"other\":");
+        _sdl_stats_json_time(fp, &other);
+        fprintf(fp, "},\"languages\":{");
+        for (ii = 0; ii < (int) stats->langCount; ii++)
+        {
+            SDL_STATS_LANG *lang = &stats->lang[ii];
+
+            fprintf(fp, "%s", (ii > 0) ? "," : "");
+            _sdl_stats_json_string(fp, lang->name);
+            fprintf(fp,
+                    ":{\"count\":%lu,\"wall_ns\":%lu,\"cpu_ns\":%lu,"
+                        "\"bytes\":%lu",
+                    lang->time.count,
+                    lang->time.wallNs,
+                    lang->time.cpuNs,
+                    lang->bytes);
+            _sdl_stats_json_counters(fp, &lang->time);
+            fprintf(fp, "}");
+        }
+        fprintf(fp, "},\"blocks\":{");
+        for (ii = LocalBlock; ii <= EntryBlock; ii++)
+        {
+            fprintf(fp,
+                    "%s\"%s\":%lu",
+                    (ii > LocalBlock) ? "," : "",
+                    _sdl_stats_block[ii],
+                    stats->blocks[ii]);
+        }
+        fprintf(fp,
+                "},\"symbols\":{\"lookups\":%lu,\"inserts\":%lu},"
+                    "\"tokens\":%lu",
+                stats->lookups,
+                stats->inserts,
+                stats->tokens);
+        if ((_sdl_stats_counters == true) &&
+            (_sdl_stats_counters_open == false))
+        {
+            fprintf(fp, ",\"counters_unavailable\":");
+            _sdl_stats_json_string(fp, strerror(_sdl_stats_counter_errno));
+        }
+        fprintf(fp, "}\n");
+    }
+    else
+    {
+        if (name != NULL)
+        {
+            fprintf(fp, "\nStatistics for %s:\n", name);
+        }
+        else
+        {
+            fprintf(fp, "\nStatistics for this run:\n");
+        }
+        fprintf(fp,
+                "  %-12s %10s %12s %12s\n",
+                "Phase",
+                "Count",
+                "Wall (ms)",
+                "CPU (ms)");
+        for (ii = 0; ii < PhaseMax; ii++)
+        {
+            if (stats->phase[ii].count > 0)
+            {
+                fprintf(fp,
+                        "  %-12s %10lu %12.3f %12.3f\n",
+                        _sdl_stats_phase[ii],
+                        stats->phase[ii].count,
+                        stats->phase[ii].wallNs / 1.0e6,
+                        stats->phase[ii].cpuNs / 1.0e6);
+            }
+        }
+        fprintf(fp,
+                "  %-12s %10s %12.3f %12.3f\n",
+                "other",
+                "",
+                other.wallNs / 1.0e6,
+                other.cpuNs / 1.0e6);
+        fprintf(fp,
+                "  %-12s %10s %12.3f %12.3f\n",
+                "total",
+                "",
+                stats->total.wallNs / 1.0e6,
+                stats->total.cpuNs / 1.0e6);
+        if (stats->langCount > 0)
+        {
+            fprintf(fp,
+                    "  %-12s %10s %12s %12s %12s\n",
+                    "Language",
+                    "Modules",
+                    "Wall (ms)",
+                    "CPU (ms)",
+                    "Bytes");
+            for (ii = 0; ii < (int) stats->langCount; ii++)
+            {
+                SDL_STATS_LANG *lang = &stats->lang[ii];
+
+                if ((lang->time.count > 0) || (lang->bytes > 0))
+                {
+                    fprintf(fp,
+                            "  %-12s %10lu %12.3f %12.3f %12lu\n",
+                            (lang->name != NULL) ? lang->name : "",
+                            lang->time.count,
+                            lang->time.wallNs / 1.0e6,
+                            lang->time.cpuNs / 1.0e6,
+                            lang->bytes);
+                }
+            }
+        }
+        if (counterMask != 0)
+        {
+            fprintf(fp,
+                    "  %-12s %14s %14s %6s %14s %14s\n",
+                    "Counters",
+                    "Cycles",
+                    "Instructions",
+                    "IPC",
+                    "Cache Misses",
+                    "Branch Misses");
+            for (ii = 0; ii < PhaseMax; ii++)
+            {
+                if (stats->phase[ii].count > 0)
+                {
+                    _sdl_stats_text_counters(fp,
+                                             _sdl_stats_phase[ii],
+                                             &stats->phase[ii]);
+                }
+            }
+            _sdl_stats_text_counters(fp, "other", &other);
+            _sdl_stats_text_counters(fp, "total", &stats->total);
+            for (ii = 0; ii < (int) stats->langCount; ii++)
+            {
+                SDL_STATS_LANG *lang = &stats->lang[ii];
+
+                if (lang->time.count > 0)
+                {
+                    _sdl_stats_text_counters(fp,
+                                             (lang->name != NULL) ?
+                                                lang->name : "",
+                                             &lang->time);
+                }
+            }
+        }
+        else if ((_sdl_stats_counters == true) &&
+                 (_sdl_stats_counters_open == false))
+        {
+            fprintf(fp,
+                    "  Hardware counters are not available: %s\n",
+                    strerror(_sdl_stats_counter_errno));
+        }
+        for (ii = LocalBlock; ii <= EntryBlock; ii++)
+        {
+            if (stats->blocks[ii] > 0)
+            {
+                fprintf(fp,
+                        "%s %s=%lu",
+                        (blocks++ == 0) ? "  Blocks allocated:" : "",
+                        _sdl_stats_block[ii],
+                        stats->blocks[ii]);
+            }
+        }
+        if (blocks > 0)
+        {
+            fprintf(fp, "\n");
+        }
+        if ((stats->lookups > 0) || (stats->tokens > 0))
+        {
+            fprintf(fp,
+                    "  Symbol lookups: %lu, inserts: %lu\n"
+                        "  Tokens scanned: %lu\n",
+                    stats->lookups,
+                    stats->inserts,
+                    stats->tokens);
+        }
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/************************************************************************/
+/* Local Functions                            */
+/************************************************************************/
+
+/*
+ * _sdl_stats_charge
+ *  This function is called to charge the time since the statistics were last
+ *  updated to the phase in progress, if there is one.
+ *
+ * Input Parameters:
+ *  stats:
+ *    A pointer to the statistics.
+ *
+ * Output Parameters:
+ *  stats:
+ *    A pointer to the updated statistics.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_stats_charge(SDL_STATS *stats)
+{
+    SDL_STATS_CLOCK now;
+
+    sdl_stats_clock(&now);
+    if (stats->depth > 0)
+    {
+        int top = ((stats->depth < SDL_K_STATS_DEPTH) ?
+                   stats->depth : SDL_K_STATS_DEPTH) - 1;
+        SDL_STATS_TIME *time = &stats->phase[stats->stack[top]];
+
+        _sdl_stats_add(time, &now, &stats->mark);
+    }
+    stats->mark = now;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_stats_add
+ *  This function is called to add the time, and the counts, between two
+ *  readings of the clocks to a time.
+ *
+ * Input Parameters:
+ *  time:
+ *    A pointer to the time to be added to.
+ *  now:
+ *    A pointer to the later reading of the clocks.
+ *  then:
+ *    A pointer to the earlier reading of the clocks.
+ *
+ * Output Parameters:
+ *  time:
+ *    A pointer to the updated time.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_stats_add(SDL_STATS_TIME *time,
+                           SDL_STATS_CLOCK *now,
+                           SDL_STATS_CLOCK *then)
+{
+    if (now->wallNs > then->wallNs)
+    {
+        time->wallNs += now->wallNs - then->wallNs;
+    }
+    if (now->cpuNs > then->cpuNs)
+    {
+        time->cpuNs += now->cpuNs - then->cpuNs;
+    }
+
+    /*
+     * The counters are only added when both readings have them.
+     */
+    if ((now->counterMask & then->counterMask) != 0)
+    {
+        uint32_t mask = now->counterMask & then->counterMask;
+        int ii;
+
+        for (ii = 0; ii < CounterMax; ii++)
+        {
+            if (((mask & (1 << ii)) != 0) &&
+                (now->counter[ii] > then->counter[ii]))
+            {
+                time->counter[ii] += now->counter[ii] - then->counter[ii];
+            }
+        }
+        time->counterMask |= mask;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_stats_json_time
+ *  This function is called to write out a time as a JSON object.
+ *
+ * Input Parameters:
+ *  fp:
+ *    A pointer to the file to write to.
+ *  time:
+ *    A pointer to the time to be written.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_stats_json_time(FILE *fp, SDL_STATS_TIME *time)
+{
+    fprintf(fp,
+            "{\"count\":%lu,\"wall_ns\":%lu,\"cpu_ns\":%lu",
+            time->count,
+            time->wallNs,
+            time->cpuNs);
+    _sdl_stats_json_counters(fp, time);
+    fprintf(fp, "}");
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_stats_json_counters
+ *  This function is called to write out the counters for a time as JSON
+ *  members, and the instructions per cycle when there are both.  A counter
+ *  that was not read is left out.
+ *
+ * Input Parameters:
+ *  fp:
+ *    A pointer to the file to write to.
+ *  time:
+ *    A pointer to the time with the counters to be written.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_stats_json_counters(FILE *fp, SDL_STATS_TIME *time)
+{
+    uint32_t ipcMask = (1 << CounterCycles) | (1 << CounterInstructions);
+    int ii;
+
+    for (ii = 0; ii < CounterMax; ii++)
+    {
+        if ((time->counterMask & (1 << ii)) != 0)
+        {
+            fprintf(fp,
+                    ",\"%s\":%lu",
+                    _sdl_stats_counter[ii],
+                    time->counter[ii]);
+        }
+    }
+    if (((time->counterMask & ipcMask) == ipcMask) &&
+        (time->counter[CounterCycles] > 0))
+    {
+        fprintf(fp,
+                ",\"ipc\":%.3f",
+                (double) time->counter[CounterInstructions] /
+                    time->counter[CounterCycles]);
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_stats_json_string
+ *  This function is called to write out a string as a JSON string, or null.
+ *
+ * Input Parameters:
+ *  fp:
+ *    A pointer to the file to write to.
+ *  string:
+ *    A pointer to the string to be written, or NULL.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_stats_json_string(FILE *fp, char *string)
+{
+    if (string != NULL)
+    {
+        fputc('"', fp);
+        for (; *string != '\0'; string++)
+        {
+            unsigned char ch = (unsigned char) *string;
+
+            if ((ch == '"') || (ch == '\\'))
+            {
+                fprintf(fp, "\\%c", ch);
+            }
+            else if (ch < ' ')
+            {
+                fprintf(fp, "\\u%04x", ch);
+            }
+            else
+            {
+                fputc(ch, fp);
+            }
+        }
+        fputc('"', fp);
+    }
+    else
+    {
+        fprintf(fp, "null");
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_stats_text_counters
+ *  This function is called to write out a line with the counters for a time
+ *  as text.  A counter that was not read is written as a dash.
+ *
+ * Input Parameters:
+ *  fp:
+ *    A pointer to the file to write to.
+ *  name:
+ *    A pointer to the name of the phase or language.
+ *  time:
+ *    A pointer to the time with the counters to be written.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_stats_text_counters(FILE *fp,
+                                     const char *name,
+                                     SDL_STATS_TIME *time)
+{
+    uint32_t ipcMask = (1 << CounterCycles) | (1 << CounterInstructions);
+    char value[CounterMax][24];
+    char ipc[16] = "-";
+    int ii;
+
+    for (ii = 0; ii < CounterMax; ii++)
+    {
+        if ((time->counterMask & (1 << ii)) != 0)
+        {
+            snprintf(value[ii], sizeof(value[ii]), "%lu", time->counter[ii]);
+        }
+        else
+        {
+            strcpy(value[ii], "-");
+        }
+    }
+    if (((time->counterMask & ipcMask) == ipcMask) &&
+        (time->counter[CounterCycles] > 0))
+    {
+        snprintf(ipc,
+                 sizeof(ipc),
+                 "%.2f",
+                 (double) time->counter[CounterInstructions] /
+                    time->counter[CounterCycles]);
+    }
+    fprintf(fp,
+            "  %-12s %14s %14s %6s %14s %14s\n",
+            name,
+            value[CounterCycles],
+            value[CounterInstructions],
+            ipc,
+            value[CounterCacheMisses],
+            value[CounterBranchMisses]);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_stats_perf_open
+ *  This function is called to get the hardware counters for the calling
+ *  thread, opening them the first time.  Each counter that cannot be opened
+ *  is left out of the group, and the reason is kept for the report.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:       An error occurred allocating memory.
+ *  !NULL:      A pointer to the counters for the calling thread.
+ */
+static SDL_STATS_PERF *_sdl_stats_perf_open(void)
+{
+    SDL_STATS_PERF *retVal = _sdl_stats_perf;
+
+    if (retVal == NULL)
+    {
+        retVal = sdl_calloc(1, sizeof(SDL_STATS_PERF));
+        if (retVal != NULL)
+        {
+            int ii;
+
+            retVal->leader = -1;
+            for (ii = 0; ii < CounterMax; ii++)
+            {
+#ifdef __linux__
+                static const uint64_t config[CounterMax] =
+                {
+                    PERF_COUNT_HW_CPU_CYCLES,
+                    PERF_COUNT_HW_INSTRUCTIONS,
+                    PERF_COUNT_HW_CACHE_MISSES,
+                    PERF_COUNT_HW_BRANCH_MISSES
+                };
+                struct perf_event_attr attr;
+
+                memset(&attr, 0, sizeof(attr));
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.size = sizeof(attr);
+                attr.config = config[ii];
+                attr.read_format = PERF_FORMAT_GROUP;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                retVal->fd[ii] = syscall(__NR_perf_event_open,
+                                         &attr,
+                                         0,
+                                         -1,
+                                         retVal->leader,
+                                         PERF_FLAG_FD_CLOEXEC);
+#else
+                retVal->fd[ii] = -1;
+                errno = ENOSYS;
+#endif
+                if (retVal->fd[ii] >= 0)
+                {
+                    if (retVal->leader < 0)
+                    {
+                        retVal->leader = retVal->fd[ii];
+                    }
+                    retVal->mask |= 1 << ii;
+                    _sdl_stats_counters_open = true;
+                }
+                else
+                {
+                    _sdl_stats_counter_errno = errno;
+                }
+            }
+
+            /*
+             * Close the counters when the thread exits.
+             */
+            pthread_once(&_sdl_stats_once, _sdl_stats_perf_key_init);
+            pthread_setspecific(_sdl_stats_key, retVal);
+            _sdl_stats_perf = retVal;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_stats_perf_read
+ *  This function is called to read the hardware counters for the calling
+ *  thread into a reading of the clocks.  If they cannot be read, the reading
+ *  is left without them.
+ *
+ * Input Parameters:
+ *  clock:
+ *    A pointer to the reading of the clocks.
+ *
+ * Output Parameters:
+ *  clock:
+ *    A pointer to the reading of the clocks, with the counters that were
+ *    read, and a bit set in the mask for each of them.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_stats_perf_read(SDL_STATS_CLOCK *clock)
+{
+    SDL_STATS_PERF *perf = _sdl_stats_perf_open();
+
+    if ((perf != NULL) && (perf->mask != 0))
+    {
+        uint64_t values[CounterMax + 1];
+        ssize_t length = read(perf->leader, values, sizeof(values));
+
+        if (length >= (ssize_t) sizeof(uint64_t))
+        {
+            uint64_t jj = 1;
+            int ii;
+
+            for (ii = 0; ii < CounterMax; ii++)
+            {
+                if (((perf->mask & (1 << ii)) != 0) && (jj <= values[0]))
+                {
+                    clock->counter[ii] = values[jj++];
+                    clock->counterMask |= 1 << ii;
+                }
+            }
+        }
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_stats_perf_key_init
+ *  This function is called once to create the key used to close the hardware
+ *  counters for each thread when it exits.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_stats_perf_key_init(void)
+{
+    pthread_key_create(&_sdl_stats_key, _sdl_stats_perf_close);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_stats_perf_close
+ *  This function is called when a thread with hardware counters exits, to
+ *  close them.
+ *
+ * Input Parameters:
+ *  arg:
+ *    A pointer to the counters for the thread.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_stats_perf_close(void *arg)
+{
+    SDL_STATS_PERF *perf = (SDL_STATS_PERF *) arg;
+    int ii;
+
+    for (ii = 0; ii < CounterMax; ii++)
+    {
+        if (perf->fd[ii] >= 0)
+        {
+            close(perf->fd[ii]);
+        }
+    }
+    sdl_free(perf);
+    _sdl_stats_perf = NULL;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
@@ -0,0 +1,482 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the symbol table routines used to index the
+ *  DECLARE, ITEM, AGGREGATE, ENUM and LOCAL definitions by name and by type
+ *  ID.  Names are kept in an open addressed hash table, with linear probing,
+ *  and type IDs in a vector indexed by the type ID less the base ID for the
+ *  list.  Entries are never removed individually, the entire table is reset
+ *  when the module ends.
+ *
+ * Revision History:
+ *
+ *  V01.000 15-OCT-2026 Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001 15-OCT-2026 Jonathan D. Belanger
+ *  Compare the name pointers before the strings, interned names are almost
+ *  always the same pointer.
+ *
+ *  V01.002 16-OCT-2026 Jonathan D. Belanger
+ *  Count the lookups and inserts for --stats.
+ *
+ *  V01.003 16-OCT-2026 Jonathan D. Belanger
+ *  Added sdl_symtab_insert_hash and sdl_symtab_lookup_hash, for a caller
+ *  that already has the hash of the name, such as the one saved with an
+ *  interned name.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_symtab.h"
+#include "library/common/opensdl_stats.h"
+
+/*
+ * Local Prototypes
+ */
+static uint32_t _sdl_symtab_grow(SDL_SYMTAB *symtab);
+
+/*
+ * sdl_symtab_init
+ *  This function is called to initialize a symbol table.  No memory is
+ *  allocated until the first symbol is inserted.
+ *
+ * Input Parameters:
+ *  symtab:
+ *    A pointer to the symbol table to be initialized.
+ *  baseID:
+ *    A value indicating the lowest type ID that will be inserted into this
+ *    symbol table.  For symbol tables that are only indexed by name, this
+ *    should be zero.
+ *
+ * Output Parameters:
+ *  symtab:
+ *    A pointer to the initialized symbol table.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_symtab_init(SDL_SYMTAB *symtab, int baseID)
+{
+    symtab->bucket = NULL;
+    symtab->byID = NULL;
+    symtab->bucketSize = 0;
+    symtab->bucketUsed = 0;
+    symtab->baseID = baseID;
+    symtab->idSize = 0;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_symtab_hash
+ *  This function is called to calculate the hash value for a name.  This is
+ *  the 32-bit FNV-1a hash.
+ *
+ * Input Parameters:
+ *  name:
+ *    A pointer to the null-terminated name to be hashed.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  The hash value for the name.
+ */
+uint32_t sdl_symtab_hash(const char *name)
+{
+    const unsigned char *ptr = (const unsigned char *) name;
+    uint32_t retVal = 2166136261U;
+
+    while (*ptr != '\0')
+    {
+        retVal ^= *ptr++;
+        retVal *= 16777619U;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_symtab_insert
+ *  This function is called to insert a block into a symbol table.  If a block
+ *  with the same name has already been inserted, the existing one is kept for
+ *  name lookups, which matches searching the queue from its head.
+ *
+ * Input Parameters:
+ *  symtab:
+ *    A pointer to the symbol table to receive the block.
+ *  name:
+ *    A pointer to the name of the block.  This pointer is saved, so it must
+ *    remain valid until the symbol table is reset.
+ *  typeID:
+ *    A value indicating the type ID assigned to the block.  If this is less
+ *    than the base ID for the symbol table, the block is only indexed by
+ *    name.
+ *  block:
+ *    A pointer to the block being indexed.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ */
+uint32_t sdl_symtab_insert(
+        SDL_SYMTAB *symtab,
+        char *name,
+        int typeID,
+        void *block)
+{
+    return(sdl_symtab_insert_hash(symtab,
+                                  name,
+                                  sdl_symtab_hash(name),
+                                  typeID,
+                                  block));
+}
+
+/*
+ * sdl_symtab_insert_hash
+ *  This function is called to insert a block into a symbol table, when the
+ *  hash of its name is already known.
+ *
+ * Input Parameters:
+ *  symtab:
+ *    A pointer to the symbol table to receive the block.
+ *  name:
+ *    A pointer to the name of the block.  This pointer is saved, so it must
+ *    remain valid until the symbol table is reset.
+ *  hash:
+ *    A value indicating the hash of the name, as returned by sdl_symtab_hash.
+ *  typeID:
+ *    A value indicating the type ID assigned to the block.  If this is less
+ *    than the base ID for the symbol table, the block is only indexed by
+ *    name.
+ *  block:
+ *    A pointer to the block being indexed.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ */
+uint32_t sdl_symtab_insert_hash(
+        SDL_SYMTAB *symtab,
+        char *name,
+        uint32_t hash,
+        int typeID,
+        void *block)
+{
+    uint32_t retVal = SDL_NORMAL;
+
+    sdl_stats_insert();
+
+    /*
+     * Keep the load factor at or below one half, so that the probe sequences
+     * stay short.
+     */
+    if ((symtab->bucketUsed + 1) * 2 > symtab->bucketSize)
+    {
+        retVal = _sdl_symtab_grow(symtab);
+    }
+
+    /*
+     * Index the block by name.
+     */
+    if (retVal == SDL_NORMAL)
+    {
+        uint32_t mask = symtab->bucketSize - 1;
+        uint32_t ii = hash & mask;
+
+        while (symtab->bucket[ii].name != NULL)
+        {
+            if ((symtab->bucket[ii].name == name) ||
+                ((symtab->bucket[ii].hash == hash) &&
+                 (strcmp(symtab->bucket[ii].name, name) == 0)))
+            {
+                break;
+            }
+            ii = (ii + 1) & mask;
+        }
+        if (symtab->bucket[ii].name == NULL)
+        {
+            symtab->bucket[ii].name = name;
+            symtab->bucket[ii].block = block;
+            symtab->bucket[ii].hash = hash;
+            symtab->bucketUsed++;
+        }
+    }
+
+    /*
+     * Index the block by type ID, if it has one.
+     */
+    if ((retVal == SDL_NORMAL) && (typeID >= symtab->baseID) &&
+        (symtab->baseID > 0))
+    {
+        int idx = typeID - symtab->baseID;
+
+        if (idx >= symtab->idSize)
+        {
+            int newSize = idx + SDL_K_SYMTAB_ID_INCR;
+            void **newID = sdl_realloc(symtab->byID, newSize * sizeof(void *));
+
+            /*
+             * sdl_realloc zeros the new part of the buffer for us.
+             */
+            if (newID != NULL)
+            {
+                symtab->byID = newID;
+                symtab->idSize = newSize;
+            }
+            else
+            {
+                retVal = SDL_ABORT;
+            }
+        }
+        if (retVal == SDL_NORMAL)
+        {
+            symtab->byID[idx] = block;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_symtab_lookup
+ *  This function is called to find a block in a symbol table by name.
+ *
+ * Input Parameters:
+ *  symtab:
+ *    A pointer to the symbol table to be searched.
+ *  name:
+ *    A pointer to the name of the block to be found.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:           The name is not in the symbol table.
+ *  !NULL:          A pointer to the block with the name.
+ */
+void *sdl_symtab_lookup(SDL_SYMTAB *symtab, const char *name)
+{
+    return(sdl_symtab_lookup_hash(symtab, name, sdl_symtab_hash(name)));
+}
+
+/*
+ * sdl_symtab_lookup_hash
+ *  This function is called to find a block in a symbol table by name, when
+ *  the hash of the name is already known.
+ *
+ * Input Parameters:
+ *  symtab:
+ *    A pointer to the symbol table to be searched.
+ *  name:
+ *    A pointer to the name of the block to be found.
+ *  hash:
+ *    A value indicating the hash of the name, as returned by sdl_symtab_hash.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:           The name is not in the symbol table.
+ *  !NULL:          A pointer to the block with the name.
+ */
+void *sdl_symtab_lookup_hash(SDL_SYMTAB *symtab,
+                             const char *name,
+                             uint32_t hash)
+{
+    void *retVal = NULL;
+
+    sdl_stats_lookup();
+    if (symtab->bucketSize > 0)
+    {
+        uint32_t mask = symtab->bucketSize - 1;
+        uint32_t ii = hash & mask;
+
+        while (symtab->bucket[ii].name != NULL)
+        {
+            if ((symtab->bucket[ii].name == name) ||
+                ((symtab->bucket[ii].hash == hash) &&
+                 (strcmp(symtab->bucket[ii].name, name) == 0)))
+            {
+                retVal = symtab->bucket[ii].block;
+                break;
+            }
+            ii = (ii + 1) & mask;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_symtab_lookup_id
+ *  This function is called to find a block in a symbol table by type ID.
+ *
+ * Input Parameters:
+ *  symtab:
+ *    A pointer to the symbol table to be searched.
+ *  typeID:
+ *    A value indicating the type ID of the block to be found.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:           The type ID is not in the symbol table.
+ *  !NULL:          A pointer to the block with the type ID.
+ */
+void *sdl_symtab_lookup_id(SDL_SYMTAB *symtab, int typeID)
+{
+    void *retVal = NULL;
+    int idx = typeID - symtab->baseID;
+
+    sdl_stats_lookup();
+    if ((idx >= 0) && (idx < symtab->idSize))
+    {
+        retVal = symtab->byID[idx];
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_symtab_reset
+ *  This function is called to release all the memory allocated for a symbol
+ *  table and return it to its initialized state.  The indexed blocks are not
+ *  touched.
+ *
+ * Input Parameters:
+ *  symtab:
+ *    A pointer to the symbol table to be reset.
+ *
+ * Output Parameters:
+ *  symtab:
+ *    A pointer to the reset symbol table.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_symtab_reset(SDL_SYMTAB *symtab)
+{
+    if (symtab->bucket != NULL)
+    {
+        sdl_free(symtab->bucket);
+    }
+    if (symtab->byID != NULL)
+    {
+        sdl_free(symtab->byID);
+    }
+    sdl_symtab_init(symtab, symtab->baseID);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_symtab_grow
+ *  This function is called to double the number of name buckets in a symbol
+ *  table and rehash the existing entries into the new buckets.
+ *
+ * Input Parameters:
+ *  symtab:
+ *    A pointer to the symbol table to be grown.
+ *
+ * Output Parameters:
+ *  symtab:
+ *    A pointer to the grown symbol table.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ */
+static uint32_t _sdl_symtab_grow(SDL_SYMTAB *symtab)
+{
+    SDL_SYMTAB_ENTRY *newBucket;
+    uint32_t newSize;
+    uint32_t retVal = SDL_NORMAL;
+
+    newSize = (symtab->bucketSize == 0) ?
+                SDL_K_SYMTAB_SIZE : (symtab->bucketSize * 2);
+    newBucket = sdl_calloc(newSize, sizeof(SDL_SYMTAB_ENTRY));
+    if (newBucket != NULL)
+    {
+        uint32_t mask = newSize - 1;
+        uint32_t ii;
+
+        /*
+         * The names are already unique, so all we need to do is find the
+         * first empty bucket for each one.
+         */
+        for (ii = 0; ii < symtab->bucketSize; ii++)
+        {
+            if (symtab->bucket[ii].name != NULL)
+            {
+                uint32_t jj = symtab->bucket[ii].hash & mask;
+
+                while (newBucket[jj].name != NULL)
+                {
+                    jj = (jj + 1) & mask;
+                }
+                newBucket[jj] = symtab->bucket[ii];
+            }
+        }
+        if (symtab->bucket != NULL)
+        {
+            sdl_free(symtab->bucket);
+        }
+        symtab->bucket = newBucket;
+        symtab->bucketSize = newSize;
+    }
+    else
+    {
+        retVal = SDL_ABORT;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
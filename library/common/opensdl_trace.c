@@ -0,0 +1,577 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the trace routines.  Each thread records its
+ *  events in a ring buffer of its own, without locking, so recording an
+ *  event costs little more than reading the clock.  When a thread exits,
+ *  its ring buffer is kept, and is carried on with by the next thread to
+ *  record an event, so that there are never more ring buffers than there
+ *  have been threads running at the same time.  Each event has the number of
+ *  the thread that recorded it.
+ *
+ *  The trace file is written with nothing but open, write and close, so that
+ *  it can also be written when a signal is about to terminate the image.
+ *
+ * Revision History:
+ *
+ *  V01.000 16-OCT-2026 Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_trace.h"
+
+typedef struct _sdl_trace_ring
+{
+    struct _sdl_trace_ring *next;
+    uint64_t        recorded;
+    bool            inUse;
+    SDL_TRACE_EVENT events[SDL_K_TRACE_EVENTS];
+} SDL_TRACE_RING;
+
+#define SDL_K_TRACE_SITE_INCR  256
+
+/*
+ * Local Variables
+ */
+static SDL_THREAD_LOCAL SDL_TRACE_RING *_sdl_trace_ring = NULL;
+static SDL_THREAD_LOCAL uint32_t _sdl_trace_thread = 0;
+static SDL_TRACE_RING *_sdl_trace_rings = NULL;
+static SDL_TRACE_SITE *_sdl_trace_sites = NULL;
+static uint32_t _sdl_trace_site_count = 0;
+static uint32_t _sdl_trace_site_size = 0;
+static uint32_t _sdl_trace_threads = 0;
+static char *_sdl_trace_file = NULL;
+static pthread_mutex_t _sdl_trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t _sdl_trace_once = PTHREAD_ONCE_INIT;
+static pthread_key_t _sdl_trace_key;
+static const int _sdl_trace_signals[] =
+{
+    SIGSEGV,
+    SIGBUS,
+    SIGILL,
+    SIGFPE,
+    SIGABRT,
+    0
+};
+
+/*
+ * Local Functions
+ */
+static SDL_TRACE_RING *_sdl_trace_attach(void);
+static void _sdl_trace_key_init(void);
+static void _sdl_trace_detach(void *arg);
+static uint32_t _sdl_trace_register(SDL_TRACE_SITE *site);
+static void _sdl_trace_exit(void);
+static void _sdl_trace_signal(int sig);
+static bool _sdl_trace_write(int fd, const void *buffer, size_t length);
+
+/*
+ * sdl_trace_event
+ *  This function is called to record an event in the ring buffer for the
+ *  calling thread.  It is normally called through one of the SDL_TRACE
+ *  macros.
+ *
+ * Input Parameters:
+ *  site:
+ *    A pointer to the place the event is being recorded from.
+ *  arg0:
+ *  arg1:
+ *  arg2:
+ *  arg3:
+ *    Values to be recorded with the event.  The place has the number of them
+ *    that are meaningful.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_trace_event(SDL_TRACE_SITE *site,
+                     int64_t arg0,
+                     int64_t arg1,
+                     int64_t arg2,
+                     int64_t arg3)
+{
+    SDL_TRACE_RING *ring = _sdl_trace_ring;
+    uint32_t id = __atomic_load_n(&site->id, __ATOMIC_ACQUIRE);
+
+    if (ring == NULL)
+    {
+        ring = _sdl_trace_attach();
+    }
+    if (id == 0)
+    {
+        id = _sdl_trace_register(site);
+    }
+    if ((ring != NULL) && (id != 0))
+    {
+        SDL_TRACE_EVENT *event;
+        struct timespec ts;
+
+        event = &ring->events[ring->recorded & (SDL_K_TRACE_EVENTS - 1)];
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        event->timestamp = (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+        event->siteID = id;
+        event->thread = _sdl_trace_thread;
+        event->arg[0] = arg0;
+        event->arg[1] = arg1;
+        event->arg[2] = arg2;
+        event->arg[3] = arg3;
+        ring->recorded++;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_trace_init
+ *  This function is called when tracing is turned on, to arrange for the
+ *  trace to be written to a file when the image exits, or is terminated by
+ *  a signal that indicates an error.
+ *
+ * Input Parameters:
+ *  fileName:
+ *    A pointer to the name of the trace file, or NULL for the default.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:       Normal Successful Completion.
+ *  false:      An error occurred allocating memory.
+ */
+bool sdl_trace_init(char *fileName)
+{
+    bool retVal = false;
+
+    if (_sdl_trace_file == NULL)
+    {
+        _sdl_trace_file = strdup((fileName != NULL) ?
+                                 fileName : SDL_K_TRACE_FILE);
+        if (_sdl_trace_file != NULL)
+        {
+            int ii;
+
+            atexit(_sdl_trace_exit);
+            for (ii = 0; _sdl_trace_signals[ii] != 0; ii++)
+            {
+                signal(_sdl_trace_signals[ii], _sdl_trace_signal);
+            }
+            retVal = true;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_trace_dump
+ *  This function is called to write the trace file.  The ring buffers are
+ *  not locked, so the threads that are still running should not be
+ *  recording events.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:       Normal Successful Completion.
+ *  false:      Tracing was never turned on, or an error occurred writing the
+ *              trace file.
+ */
+bool sdl_trace_dump(void)
+{
+    SDL_TRACE_HEADER header;
+    SDL_TRACE_RING *ring;
+    uint32_t ii;
+    bool retVal = false;
+    int fd = -1;
+
+    if (_sdl_trace_file != NULL)
+    {
+        fd = open(_sdl_trace_file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (fd >= 0)
+    {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SDL_K_TRACE_MAGIC, SDL_K_TRACE_MAGIC_LEN);
+        header.version = SDL_K_TRACE_VERSION;
+        header.siteCount = _sdl_trace_site_count;
+        header.eventSize = sizeof(SDL_TRACE_EVENT);
+        for (ring = _sdl_trace_rings; ring != NULL; ring = ring->next)
+        {
+            header.ringCount++;
+        }
+        retVal = _sdl_trace_write(fd, &header, sizeof(header));
+
+        /*
+         * Write out each of the places an event was recorded from.
+         */
+        for (ii = 0; ((ii < header.siteCount) && (retVal == true)); ii++)
+        {
+            SDL_TRACE_SITE *site = &_sdl_trace_sites[ii];
+            SDL_TRACE_SITE_REC rec;
+
+            memset(&rec, 0, sizeof(rec));
+            rec.id = site->id;
+            rec.line = site->line;
+            rec.argCount = site->argCount;
+            rec.nameLength = strlen(site->name);
+            rec.fileLength = strlen(site->file);
+            retVal = _sdl_trace_write(fd, &rec, sizeof(rec)) &&
+                     _sdl_trace_write(fd, site->name, rec.nameLength) &&
+                     _sdl_trace_write(fd, site->file, rec.fileLength);
+        }
+
+        /*
+         * Then write out each of the ring buffers, oldest event first.  Once
+         * a ring buffer has wrapped, the oldest event is the next one to be
+         * replaced.
+         */
+        for (ring = _sdl_trace_rings;
+             ((ring != NULL) && (retVal == true));
+             ring = ring->next)
+        {
+            SDL_TRACE_RING_REC rec;
+            uint64_t recorded = ring->recorded;
+            uint32_t start = 0;
+
+            memset(&rec, 0, sizeof(rec));
+            rec.recorded = recorded;
+            if (recorded > SDL_K_TRACE_EVENTS)
+            {
+                rec.count = SDL_K_TRACE_EVENTS;
+                start = recorded & (SDL_K_TRACE_EVENTS - 1);
+            }
+            else
+            {
+                rec.count = recorded;
+            }
+            retVal = _sdl_trace_write(fd, &rec, sizeof(rec)) &&
+                     _sdl_trace_write(fd,
+                                      &ring->events[start],
+                                      (rec.count - start) *
+                                        sizeof(SDL_TRACE_EVENT)) &&
+                     _sdl_trace_write(fd,
+                                      ring->events,
+                                      start * sizeof(SDL_TRACE_EVENT));
+        }
+        if (close(fd) != 0)
+        {
+            retVal = false;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/************************************************************************/
+/* Local Functions                            */
+/************************************************************************/
+
+/*
+ * _sdl_trace_attach
+ *  This function is called the first time a thread records an event, to
+ *  give it a ring buffer.  A ring buffer given up by a thread that has
+ *  exited is used, if there is one.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:       An error occurred allocating memory.
+ *  !NULL:      A pointer to the ring buffer for the calling thread.
+ */
+static SDL_TRACE_RING *_sdl_trace_attach(void)
+{
+    SDL_TRACE_RING *retVal;
+
+    pthread_once(&_sdl_trace_once, _sdl_trace_key_init);
+    pthread_mutex_lock(&_sdl_trace_mutex);
+    for (retVal = _sdl_trace_rings; retVal != NULL; retVal = retVal->next)
+    {
+        if (retVal->inUse == false)
+        {
+            break;
+        }
+    }
+    if (retVal == NULL)
+    {
+        retVal = calloc(1, sizeof(SDL_TRACE_RING));
+        if (retVal != NULL)
+        {
+            retVal->next = _sdl_trace_rings;
+            _sdl_trace_rings = retVal;
+        }
+    }
+    if (retVal != NULL)
+    {
+        retVal->inUse = true;
+        _sdl_trace_ring = retVal;
+        _sdl_trace_thread = ++_sdl_trace_threads;
+        pthread_setspecific(_sdl_trace_key, retVal);
+    }
+    pthread_mutex_unlock(&_sdl_trace_mutex);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_trace_key_init
+ *  This function is called once, to create the key that has a thread's ring
+ *  buffer given up when the thread exits.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_trace_key_init(void)
+{
+    pthread_key_create(&_sdl_trace_key, _sdl_trace_detach);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_trace_detach
+ *  This function is called when a thread that has recorded events exits, to
+ *  give up its ring buffer, so that the next thread can carry on with it.
+ *
+ * Input Parameters:
+ *  arg:
+ *    A pointer to the ring buffer for the thread.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_trace_detach(void *arg)
+{
+    SDL_TRACE_RING *ring = (SDL_TRACE_RING *) arg;
+
+    pthread_mutex_lock(&_sdl_trace_mutex);
+    ring->inUse = false;
+    pthread_mutex_unlock(&_sdl_trace_mutex);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_trace_register
+ *  This function is called the first time an event is recorded from a place,
+ *  to give it an identifier.  The place is copied, as it may be in a plugin
+ *  that is unloaded before the trace file is written.
+ *
+ * Input Parameters:
+ *  site:
+ *    A pointer to the place an event is being recorded from.
+ *
+ * Output Parameters:
+ *  site:
+ *    A pointer to the place, with its identifier.
+ *
+ * Return Values:
+ *  0:          An error occurred allocating memory.
+ *  !0:         The identifier for the place.
+ */
+static uint32_t _sdl_trace_register(SDL_TRACE_SITE *site)
+{
+    uint32_t retVal;
+
+    pthread_mutex_lock(&_sdl_trace_mutex);
+    retVal = site->id;
+    if (retVal == 0)
+    {
+        if (_sdl_trace_site_count >= _sdl_trace_site_size)
+        {
+            SDL_TRACE_SITE *sites;
+
+            sites = realloc(_sdl_trace_sites,
+                            (_sdl_trace_site_size + SDL_K_TRACE_SITE_INCR) *
+                                sizeof(SDL_TRACE_SITE));
+            if (sites != NULL)
+            {
+                _sdl_trace_sites = sites;
+                _sdl_trace_site_size += SDL_K_TRACE_SITE_INCR;
+            }
+        }
+        if (_sdl_trace_site_count < _sdl_trace_site_size)
+        {
+            SDL_TRACE_SITE *copy = &_sdl_trace_sites[_sdl_trace_site_count];
+
+            copy->name = strdup(site->name);
+            copy->file = strdup(site->file);
+            if ((copy->name != NULL) && (copy->file != NULL))
+            {
+                copy->line = site->line;
+                copy->argCount = site->argCount;
+                copy->id = retVal = ++_sdl_trace_site_count;
+                __atomic_store_n(&site->id, retVal, __ATOMIC_RELEASE);
+            }
+            else
+            {
+                free((void *) copy->name);
+                free((void *) copy->file);
+            }
+        }
+    }
+    pthread_mutex_unlock(&_sdl_trace_mutex);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_trace_exit
+ *  This function is called when the image exits, to write the trace file.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_trace_exit(void)
+{
+    sdl_trace_dump();
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_trace_signal
+ *  This function is called when a signal that indicates an error is about to
+ *  terminate the image.  The trace file is written, and then the signal is
+ *  delivered again, to do whatever it would have done.
+ *
+ * Input Parameters:
+ *  sig:
+ *    A value indicating the signal.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_trace_signal(int sig)
+{
+    sdl_trace_dump();
+    signal(sig, SIG_DFL);
+    raise(sig);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_trace_write
+ *  This function is called to write a buffer to the trace file, in as many
+ *  pieces as it takes.
+ *
+ * Input Parameters:
+ *  fd:
+ *    A value indicating the trace file.
+ *  buffer:
+ *    A pointer to the buffer to be written.
+ *  length:
+ *    A value indicating the number of bytes to be written.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:       Normal Successful Completion.
+ *  false:      An error occurred writing the trace file.
+ */
+static bool _sdl_trace_write(int fd, const void *buffer, size_t length)
+{
+    const char *ptr = (const char *) buffer;
+    bool retVal = true;
+
+    while ((length > 0) && (retVal == true))
+    {
+        ssize_t written = write(fd, ptr, length);
+
+        if (written > 0)
+        {
+            ptr += written;
+            length -= written;
+        }
+        else if ((written < 0) && (errno != EINTR))
+        {
+            retVal = false;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
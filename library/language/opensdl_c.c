@@ -29,6 +29,35 @@
  *
  *  V01.002 14-APR-2019 Jonathan D. Belanger
  *  Updated to a shared library to be used as a plugin for OpenSDL.
+ *
+ *  V01.003 15-OCT-2026 Jonathan D. Belanger
+ *  Look up user types by type ID in the symbol tables.
+ *
+ *  V01.004 15-OCT-2026 Jonathan D. Belanger
+ *  Upcase a copy of the module name at END_MODULE, as names are now interned
+ *  and must not be modified in place.
+ *
+ *  V01.005 15-OCT-2026 Jonathan D. Belanger
+ *  The output file and message vector are kept per thread, so that more than
+ *  one compilation can be using this plugin at a time.
+ *
+ *  V01.006 15-OCT-2026 Jonathan D. Belanger
+ *  The output is appended to an output sink, rather than written to the
+ *  output file a piece at a time, and is written to the output file when it
+ *  is closed.  Write errors are checked for just once, at that time.
+ *
+ *  V01.007 15-OCT-2026 Jonathan D. Belanger
+ *  Added sdl_c_layout, which writes out a whole AGGREGATE from its layout,
+ *  with the names and types already determined.  The leading spaces are
+ *  written out directly, rather than being put into an allocated string.
+ *
+ *  V01.008 15-OCT-2026 Jonathan D. Belanger
+ *  The onLoad function is named with SDL_PLUGIN_ONLOAD, so that this language
+ *  can be built into the OpenSDL image.
+ *
+ *  V01.009 16-OCT-2026 Jonathan D. Belanger
+ *  Trace events are recorded with the function given by SDL_API_TRACE_EVENT,
+ *  so that they are recorded in the same trace as the OpenSDL image's.
  */
 #include <errno.h>
 #include <stdio.h>
@@ -39,13 +68,33 @@
 #include "opensdl_defs.h"
 #include "library/common/opensdl_blocks.h"
 #include "library/common/opensdl_message.h"
+#include "library/common/opensdl_trace.h"
 #include "library/language/opensdl_lang.h"
 #include "library/utility/opensdl_plugin.h"
 /* #include "library/utility/opensdl_utility.h" */
 
-static FILE *fp = NULL;
-static SDL_MSG_VECTOR *msgVec;
+/*
+ * Our trace events are recorded with the function we are given by onLoad
+ * with SDL_API_TRACE_EVENT, rather than our own copy of sdl_trace_event,
+ * when we are loaded as a shared library.
+ */
+#define SDL_C_TRACE(name)                                                   \
+    SDL_TRACE_AT(*trace, _sdl_c_trace_event, name, 0, 0, 0, 0, 0)
+#define SDL_C_TRACE1(name, arg0)                                            \
+    SDL_TRACE_AT(*trace, _sdl_c_trace_event, name, 1, arg0, 0, 0, 0)
+
+/*
+ * The output file, output sink and message vector belong to the compilation
+ * running on this thread.  They are given to us by each call to onLoad with
+ * SDL_API_OUTPUT_FP, SDL_API_OUTPUT_SINK and SDL_API_MESSAGE_VECTOR.  If we
+ * are given an output file without a sink, we use one of our own.
+ */
+static SDL_THREAD_LOCAL FILE *fp = NULL;
+static SDL_THREAD_LOCAL SDL_SINK *sink = NULL;
+static SDL_THREAD_LOCAL SDL_SINK _sdl_c_sink;
+static SDL_THREAD_LOCAL SDL_MSG_VECTOR *msgVec;
 static bool *trace;
+static SDL_TRACE_FUNC _sdl_c_trace_event = sdl_trace_event;
 static char *_sdl_months_str[] =
 {
     "JAN",
@@ -294,12 +343,26 @@ static uint32_t sdl_c_comment(char *comment,
 static uint32_t sdl_c_module(SDL_CONTEXT *context);
 static uint32_t sdl_c_module_end(SDL_CONTEXT *context);
 static uint32_t sdl_c_item(SDL_ITEM *item, SDL_CONTEXT *context);
+static uint32_t _sdl_c_item_decl(SDL_ITEM *item,
+                                 char *name,
+                                 size_t prefixLength,
+                                 char *type,
+                                 size_t typePrefixLength,
+                                 SDL_CONTEXT *context);
 static uint32_t sdl_c_constant(SDL_CONSTANT *constant, SDL_CONTEXT *context);
 static uint32_t sdl_c_aggregate(void *param,
                                 SDL_LANG_AGGR_TYPE type,
                                 bool ending,
                                 int depth,
                                 SDL_CONTEXT *context);
+static uint32_t sdl_c_layout(SDL_LANG_LAYOUT *layout, SDL_CONTEXT *context);
+static uint32_t _sdl_c_aggr_line(SDL_LANG_AGGR my,
+                                 SDL_LANG_AGGR_TYPE type,
+                                 bool ending,
+                                 char *name,
+                                 size_t prefixLength,
+                                 int depth,
+                                 SDL_CONTEXT *context);
 static uint32_t sdl_c_entry(SDL_ENTRY *entry, SDL_CONTEXT *context);
 static uint32_t sdl_c_enumerate(SDL_ENUMERATE *_enum, SDL_CONTEXT *context);
 static uint32_t _sdl_c_output_alignment(int alignment,
@@ -313,7 +376,8 @@ static char *_sdl_c_typeidStr(int typeID,
                               bool _unsigned,
                               SDL_CONTEXT *context,
                               bool *freeMe);
-static char *_sdl_c_leading_spaces(int depth);
+static void _sdl_c_indent(int depth);
+static void _sdl_c_put_name(char *name, size_t prefixLength);
 
 /*
  * onLoad
@@ -323,7 +387,9 @@ static char *_sdl_c_leading_spaces(int depth);
  *  twice.  The first time for the version and message vector are supplied, and
  *  this function returns the addresses of all the functions OpenSDL needs to
  *  call to perform the necessary steps to generate the output.  The second
- *  time is so that the output file pointer can be provided.
+ *  time is so that the output file pointer can be provided.  When this
+ *  language is built into the OpenSDL image, this function is named
+ *  sdl_c_onLoad.
  *
  * Input Parameters:
  *  tv:
@@ -339,11 +405,13 @@ static char *_sdl_c_leading_spaces(int depth);
  *  SDL_NORMAL      - Normal successful completion
  *  SDL_REVCHECK    - Front-end/back-end version mismatch. Check installation.
  */
-uint32_t onLoad(SDL_API_TV *tv)
+uint32_t SDL_PLUGIN_ONLOAD(c)(SDL_API_TV *tv)
 {
     uint32_t retVal = SDL_NORMAL;
     uint32_t ii = 0;
+    SDL_SINK *mySink = NULL;
     bool versionPresent = false;
+    bool fpPresent = false;
 
     /*
      * Loop through the transfer vector.
@@ -371,8 +439,17 @@ uint32_t onLoad(SDL_API_TV *tv)
                 trace = tv[ii].sdl_tv_boolean;
                 break;
 
+            case SDL_API_TRACE_EVENT:
+                _sdl_c_trace_event = tv[ii].sdl_tv_traceEvent;
+                break;
+
             case SDL_API_OUTPUT_FP:
                 fp = tv[ii].sdl_tv_fp;
+                fpPresent = true;
+                break;
+
+            case SDL_API_OUTPUT_SINK:
+                mySink = tv[ii].sdl_tv_sink;
                 break;
 
             case SDL_API_COMMENT_STAR:
@@ -415,6 +492,10 @@ uint32_t onLoad(SDL_API_TV *tv)
                 tv[ii].sdl_tv_aggregate = sdl_c_aggregate;
                 break;
 
+            case SDL_API_AGGREGATE_V2:
+                tv[ii].sdl_tv_aggregateV2 = sdl_c_layout;
+                break;
+
             case SDL_API_ENTRY:
                 tv[ii].sdl_tv_entry = sdl_c_entry;
                 break;
@@ -437,6 +518,19 @@ uint32_t onLoad(SDL_API_TV *tv)
         ii++;
     }
 
+    /*
+     * If we were given an output file, then we need a sink for it.
+     */
+    if (fpPresent == true)
+    {
+        if (mySink == NULL)
+        {
+            mySink = &_sdl_c_sink;
+            sdl_sink_init(mySink, fp);
+        }
+        sink = mySink;
+    }
+
     /*
      * If we did not see a version and we have a success, then return an error.
      */
@@ -454,6 +548,8 @@ uint32_t onLoad(SDL_API_TV *tv)
 /*
  * sdl_c_close
  *  This function is called to close the output file for this language.
+ *  Everything appended to the output sink is written to the output file
+ *  first, and this is where any error writing the output is reported.
  *
  * Input Parameters:
  *  None.
@@ -463,15 +559,39 @@ uint32_t onLoad(SDL_API_TV *tv)
  *
  * Return Values:
  *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred writing the output file.
+ *  SDL_ERREXIT:    Error exit.
  */
 static uint32_t sdl_c_close(void)
 {
     uint32_t retVal = SDL_NORMAL;
+    int status;
 
     /*
-     * Call the system routine to close the output file.
+     * Write out the sink, then call the system routine to close the output
+     * file, if this thread has one.
      */
-    fclose(fp);
+    if (sink != NULL)
+    {
+        status = sdl_sink_close(sink);
+        sink = NULL;
+        if (status != 0)
+        {
+            retVal = SDL_ABORT;
+            if (sdl_set_message(msgVec,
+                                2,
+                                retVal,
+                                status) != SDL_NORMAL)
+            {
+                retVal = SDL_ERREXIT;
+            }
+        }
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+        fp = NULL;
+    }
 
     /*
      * Return back to the caller.
@@ -502,24 +622,11 @@ static uint32_t sdl_c_literal(char *line)
     uint32_t retVal = SDL_NORMAL;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_literal\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("sdl_c_literal");
 
-    if (fprintf(fp, "%s\n", line) < 0)
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
+    sdl_sink_printf(sink, "%s\n", line);
 
     /*
      * Return back to the caller.
@@ -551,12 +658,9 @@ static uint32_t sdl_c_commentStars(void)
     int ii;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_commentStars\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("sdl_c_commentStars");
 
     /*
      * This is specifically for the C language.  When and if we support more,
@@ -574,17 +678,7 @@ static uint32_t sdl_c_commentStars(void)
     /*
      * Write out the string to the output file.
      */
-    if (fprintf(fp, "%s\n", str) < 0)
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
+    sdl_sink_printf(sink, "%s\n", str);
 
     /*
      * Return back to the caller.
@@ -620,12 +714,9 @@ static uint32_t sdl_c_createdByInfo(struct tm *timeInfo)
     int len, ii, jj;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_createdByInfo\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("sdl_c_createdByInfo");
 
     /*
      * Let's write out the beginning of the comment.
@@ -655,17 +746,7 @@ static uint32_t sdl_c_createdByInfo(struct tm *timeInfo)
     /*
      * Write out the string to the output file.
      */
-    if (fprintf(fp, "%s\n", str) < 0)
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
+    sdl_sink_printf(sink, "%s\n", str);
 
 
     /*
@@ -704,12 +785,9 @@ static uint32_t sdl_c_fileInfo(struct tm *timeInfo, char *fullFilePath)
     int len, remLen, fileLen = strlen(fullFilePath);
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_fileInfo\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("sdl_c_fileInfo");
 
     /*
      * Set the output string to all spaces and the closing comment.  This will
@@ -762,17 +840,7 @@ static uint32_t sdl_c_fileInfo(struct tm *timeInfo, char *fullFilePath)
     /*
      * Write out the string to the output file.
      */
-    if (fprintf(fp, "%s\n", str) < 0)
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
+    sdl_sink_printf(sink, "%s\n", str);
 
     /*
      * Return back to the caller.
@@ -818,12 +886,9 @@ static uint32_t sdl_c_comment(char *comment,
     char *whichComment;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_comment\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("sdl_c_comment");
 
     /*
      * Determine the type of comment being used.
@@ -867,28 +932,8 @@ static uint32_t sdl_c_comment(char *comment,
         whichComment = "%s";
     }
 
-    if (fprintf(fp, whichComment, comment) < 0)
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
-    else if (fprintf(fp, "\n") < 0)
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
+    sdl_sink_printf(sink, whichComment, comment);
+    sdl_sink_putc(sink, '\n');
 
     /*
      * Return the results of this call back to the caller.
@@ -919,97 +964,42 @@ static uint32_t sdl_c_module(SDL_CONTEXT *context)
     uint32_t retVal = SDL_NORMAL;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_module\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("sdl_c_module");
 
     /*
      * Write out the MODULE comment at near the top of the file.
      */
-    if (fprintf(fp, "\n/*** MODULE %s ", context->module) < 0)
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
-    else if ((context->ident != NULL) && (strlen(context->ident) > 0))
-    {
-        if (fprintf(fp, "IDENT = %s ", context->ident) < 0)
-        {
-            retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
-                                2,
-                                retVal,
-                                errno) != SDL_NORMAL)
-            {
-                retVal = SDL_ERREXIT;
-            }
-        }
-    }
-    if ((retVal == SDL_NORMAL) && (fprintf(fp, "***/\n") < 0))
+    sdl_sink_printf(sink, "\n/*** MODULE %s ", context->module);
+    if ((context->ident != NULL) && (strlen(context->ident) > 0))
     {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
+        sdl_sink_printf(sink, "IDENT = %s ", context->ident);
     }
+    sdl_sink_puts(sink, "***/\n");
 
     /*
      * We include some standard C headers that will simplify the rest of
      * the definitions.
      */
-    if ((retVal == SDL_NORMAL) &&
-         (fprintf(fp,
+    sdl_sink_puts(sink,
                   "#include <ctype.h>\n"
                   "#include <stdint.h>\n"
                   "#include <stdbool.h>\n"
-                  "#include <complex.h>\n") < 0))
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
+                  "#include <complex.h>\n");
 
     /*
      * We now put in the "if not defined" statements to make sure that this
      * header file, itself, can only be included once.
      */
-    if (retVal == SDL_NORMAL)
     {
         char *moduleName = sdl_strdup(context->module);
 
         sdl_strupr(moduleName);
-        if (fprintf(fp,
-                    "\n#ifndef _%s_\n#define _%s_ 1\n",
-                    moduleName,
-                    moduleName) < 0)
-        {
-            retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
-                                2,
-                                retVal,
-                                errno) != SDL_NORMAL)
-            {
-                retVal = SDL_ERREXIT;
-            }
-        }
+        sdl_sink_printf(sink,
+                        "\n#ifndef _%s_\n#define _%s_ 1\n",
+                        moduleName,
+                        moduleName);
         sdl_free(moduleName);
     }
 
@@ -1017,20 +1007,7 @@ static uint32_t sdl_c_module(SDL_CONTEXT *context)
      * Finally, put in the items to allow C++ to be able to include this
      * header file.
      */
-    if ((retVal == SDL_NORMAL) &&
-        (fprintf(fp,
-                 "#ifdef __cplusplus\nextern \"C\" {\n"
-                 "#endif\n") < 0))
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
+    sdl_sink_puts(sink, "#ifdef __cplusplus\nextern \"C\" {\n#endif\n");
 
     /*
      * Return the results of this call back to the caller.
@@ -1058,33 +1035,24 @@ static uint32_t sdl_c_module(SDL_CONTEXT *context)
  */
 static uint32_t sdl_c_module_end(SDL_CONTEXT *context)
 {
+    char *moduleName;
     uint32_t retVal = SDL_NORMAL;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_cmodule_end\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("sdl_c_cmodule_end");
 
     /*
      * Finally, close of the C++ mode and the close to only allow this
-     * header file to be included once.
+     * header file to be included once.  The module name is interned, so
+     * upcase a copy of it.
      */
-    if (fprintf(fp,
-                "\n#ifdef __cplusplus\n}\n#endif\n#endif /* _%s_ */\n",
-                sdl_strupr(context->module)) < 0)
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
+    moduleName = sdl_strupr(sdl_strdup(context->module));
+    sdl_sink_printf(sink,
+                    "\n#ifdef __cplusplus\n}\n#endif\n#endif /* _%s_ */\n",
+                    moduleName);
+    sdl_free(moduleName);
 
     /*
      * Return the results of this call back to the caller.
@@ -1114,7 +1082,6 @@ static uint32_t sdl_c_module_end(SDL_CONTEXT *context)
  */
 static uint32_t sdl_c_item(SDL_ITEM *item, SDL_CONTEXT *context)
 {
-    SDL_MEMBERS dummy = { .type = item->type };
     char *type = NULL;
     char *name = _sdl_c_generate_name(item->id,
                                       item->prefix,
@@ -1124,12 +1091,9 @@ static uint32_t sdl_c_item(SDL_ITEM *item, SDL_CONTEXT *context)
     bool freeMe = false;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_item\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("sdl_c_item");
 
     /*
      * Output the ITEM declaration.
@@ -1141,172 +1105,8 @@ static uint32_t sdl_c_item(SDL_ITEM *item, SDL_CONTEXT *context)
                                 item->_unsigned,
                                 context,
                                 &freeMe);
-
-        /*
-         * If typedef is indicated, then let's start with that.
-         */
-        if (item->typeDef == true)
-        {
-            if (fprintf(fp, "typedef ") < 0)
-            {
-                retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
-                                    2,
-                                    retVal,
-                                    errno) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
-            }
-        }
-        else if (item->commonDef == true)
-        {
-            if (fprintf(fp, "extern ") < 0)
-            {
-                retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
-                                    2,
-                                    retVal,
-                                    errno) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
-            }
-        }
-
-        /*
-         * Now we need to output the type and name.
-         */
-        if (retVal == SDL_NORMAL)
-        {
-            if (item->type == SDL_K_TYPE_CHAR_VARY)
-            {
-                if (fprintf(fp,
-                            "struct {short string_length; "
-                            "char string_text[%ld];} %s",
-                            item->length,
-                            name) < 0)
-                {
-                    retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
-                                        2,
-                                        retVal,
-                                        errno) != SDL_NORMAL)
-                    {
-                        retVal = SDL_ERREXIT;
-                    }
-                }
-            }
-            else
-            {
-                char *addr = ((item->type == SDL_K_TYPE_ADDR) ||
-                          (item->type == SDL_K_TYPE_PTR)) ? "*" : "";
-
-                if (fprintf(fp, "%s %s%s", type, addr, name) < 0)
-                {
-                    retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
-                                        2,
-                                        retVal,
-                                        errno) != SDL_NORMAL)
-                    {
-                        retVal = SDL_ERREXIT;
-                    }
-                }
-            }
-        }
-
-        /*
-         * If there is a dimension specified, then generate that.
-         */
-        if (retVal == SDL_NORMAL)
-        {
-            if ((dummy.type == SDL_K_TYPE_BITFLD) ||
-                (dummy.type == SDL_K_TYPE_BITFLD_B) ||
-                (dummy.type == SDL_K_TYPE_BITFLD_W) ||
-                (dummy.type == SDL_K_TYPE_BITFLD_L) ||
-                (dummy.type == SDL_K_TYPE_BITFLD_Q) ||
-                (dummy.type == SDL_K_TYPE_BITFLD_O))
-            {
-                if (fprintf(fp, " : %ld", item->length) < 0)
-                {
-                    retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
-                                        2,
-                                        retVal,
-                                        errno) != SDL_NORMAL)
-                    {
-                        retVal = SDL_ERREXIT;
-                    }
-                }
-            }
-            else if ((item->dimension == true) ||
-                     (item->type == SDL_K_TYPE_DECIMAL))
-            {
-                int64_t len;
-
-                if (item->type == SDL_K_TYPE_DECIMAL)
-                {
-                    len = (item->precision / 2) + 1;
-                }
-                else
-                {
-                    len = item->hbound - item->lbound + 1;
-                }
-                if (fprintf(fp, "[%ld]", len) < 0)
-                {
-                    retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
-                                        2,
-                                        retVal,
-                                        errno) != SDL_NORMAL)
-                    {
-                        retVal = SDL_ERREXIT;
-                    }
-                }
-            }
-            else if ((item->length > 0) && (item->type == SDL_K_TYPE_CHAR))
-            {
-                if (fprintf(fp, "[%ld]", item->length) < 0)
-                {
-                    retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
-                                        2,
-                                        retVal,
-                                        errno) != SDL_NORMAL)
-                    {
-                        retVal = SDL_ERREXIT;
-                    }
-                }
-            }
-        }
-
-        /*
-         * Next, if there is an alignment need, then we add an attribute
-         * statement.
-         */
-        if ((retVal == SDL_NORMAL) && (item->parentAlignment == false))
-        {
-            retVal = _sdl_c_output_alignment(item->alignment, context);
-        }
-
-        /*
-         * Finally, we close off the declaration.
-         */
-        if (retVal == SDL_NORMAL)
-        {
-            if (fprintf(fp, ";\n") < 0)
-            {
-                retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
-                                    2,
-                                    retVal,
-                                    errno) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
-            }
-        }
+        retVal = _sdl_c_item_decl(item, name, 0, type, 0, context);
+        sdl_free(name);
     }
     else
     {
@@ -1331,16 +1131,151 @@ static uint32_t sdl_c_item(SDL_ITEM *item, SDL_CONTEXT *context)
 }
 
 /*
- * sdl_c_constant
- *  This function is called when it gets a CONSTANT keyword.  It writes out a
- *  declaration consistent with the information provided on the CONSTANT.
+ * _sdl_c_item_decl
+ *  This function is called to write out the declaration of an ITEM, once its
+ *  name and type string have been determined.  The prefix at the start of
+ *  each of these is written out in lowercase.
  *
  * Input Parameters:
- *  constant:
- *      A pointer to the CONSTANT record.
- *  context:
- *    A pointer to the context block to be used to determine the type string.
- *
+ *  item:
+ *      A pointer to the ITEM record.
+ *  name:
+ *      A pointer to the name of the ITEM.
+ *  prefixLength:
+ *      A value indicating the number of characters at the start of the name
+ *      that came from the prefix.
+ *  type:
+ *      A pointer to the type string for the ITEM.
+ *  typePrefixLength:
+ *      A value indicating the number of characters at the start of the type
+ *      string that came from a prefix.
+ *  context:
+ *    A pointer to the context block.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An unexpected error occurred.
+ *  SDL_ERREXIT:    Error exit.
+ */
+static uint32_t _sdl_c_item_decl(SDL_ITEM *item,
+                                 char *name,
+                                 size_t prefixLength,
+                                 char *type,
+                                 size_t typePrefixLength,
+                                 SDL_CONTEXT *context)
+{
+    SDL_MEMBERS dummy = { .type = item->type };
+    uint32_t retVal = SDL_NORMAL;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_C_TRACE("_sdl_c_item_decl");
+
+    /*
+     * If typedef is indicated, then let's start with that.
+     */
+    if (item->typeDef == true)
+    {
+        sdl_sink_puts(sink, "typedef ");
+    }
+    else if (item->commonDef == true)
+    {
+        sdl_sink_puts(sink, "extern ");
+    }
+
+    /*
+     * Now we need to output the type and name.
+     */
+    if (item->type == SDL_K_TYPE_CHAR_VARY)
+    {
+        sdl_sink_printf(sink,
+                        "struct {short string_length; "
+                        "char string_text[%ld];} ",
+                        item->length);
+    }
+    else
+    {
+        _sdl_c_put_name((type != NULL) ? type : "(null)", typePrefixLength);
+        sdl_sink_putc(sink, ' ');
+        if ((item->type == SDL_K_TYPE_ADDR) || (item->type == SDL_K_TYPE_PTR))
+        {
+            sdl_sink_putc(sink, '*');
+        }
+    }
+    _sdl_c_put_name(name, prefixLength);
+
+    /*
+     * If there is a dimension specified, then generate that.
+     */
+    if ((dummy.type == SDL_K_TYPE_BITFLD) ||
+        (dummy.type == SDL_K_TYPE_BITFLD_B) ||
+        (dummy.type == SDL_K_TYPE_BITFLD_W) ||
+        (dummy.type == SDL_K_TYPE_BITFLD_L) ||
+        (dummy.type == SDL_K_TYPE_BITFLD_Q) ||
+        (dummy.type == SDL_K_TYPE_BITFLD_O))
+    {
+        sdl_sink_printf(sink, " : %ld", item->length);
+    }
+    else if ((item->dimension == true) ||
+             (item->type == SDL_K_TYPE_DECIMAL))
+    {
+        int64_t len;
+
+        if (item->type == SDL_K_TYPE_DECIMAL)
+        {
+            len = (item->precision / 2) + 1;
+        }
+        else
+        {
+            len = item->hbound - item->lbound + 1;
+        }
+        sdl_sink_printf(sink, "[%ld]", len);
+    }
+    else if ((item->length > 0) && (item->type == SDL_K_TYPE_CHAR))
+    {
+        sdl_sink_putc(sink, '[');
+        sdl_sink_dec(sink, item->length);
+        sdl_sink_putc(sink, ']');
+    }
+
+    /*
+     * Next, if there is an alignment need, then we add an attribute
+     * statement.
+     */
+    if (item->parentAlignment == false)
+    {
+        retVal = _sdl_c_output_alignment(item->alignment, context);
+    }
+
+    /*
+     * Finally, we close off the declaration.
+     */
+    if (retVal == SDL_NORMAL)
+    {
+        sdl_sink_puts(sink, ";\n");
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_c_constant
+ *  This function is called when it gets a CONSTANT keyword.  It writes out a
+ *  declaration consistent with the information provided on the CONSTANT.
+ *
+ * Input Parameters:
+ *  constant:
+ *      A pointer to the CONSTANT record.
+ *  context:
+ *    A pointer to the context block to be used to determine the type string.
+ *
  * Output Parameters:
  *  None.
  *
@@ -1362,12 +1297,9 @@ static uint32_t sdl_c_constant(SDL_CONSTANT *constant, SDL_CONTEXT *context)
     int size = constant->size * 8;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_constant\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("sdl_c_constant");
 
     /*
      * Make sure we have the size set correctly.
@@ -1382,17 +1314,7 @@ static uint32_t sdl_c_constant(SDL_CONSTANT *constant, SDL_CONTEXT *context)
      *
      * First the #define <name> portion.
      */
-    if (fprintf(fp, "#define %s\t", name) < 0)
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
+    sdl_sink_printf(sink, "#define %s\t", name);
 
     /*
      * If first part was successful and this is a string constant, then output
@@ -1403,68 +1325,29 @@ static uint32_t sdl_c_constant(SDL_CONSTANT *constant, SDL_CONTEXT *context)
         switch (constant->type)
         {
             case SDL_K_CONST_STR:
-                if (fprintf(fp, "\"%s\"\t", constant->string) < 0)
-                {
-                    retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
-                                        2,
-                                        retVal,
-                                        errno) != SDL_NORMAL)
-                    {
-                        retVal = SDL_ERREXIT;
-                    }
-                }
+                sdl_sink_printf(sink, "\"%s\"\t", constant->string);
                 break;
 
             case SDL_K_CONST_NUM:
                 switch (constant->radix)
                 {
                     case SDL_K_RADIX_DEC:
-                        if (fprintf(fp, "%ld\t", constant->value) < 0)
-                        {
-                            retVal = SDL_ABORT;
-                            if (sdl_set_message(msgVec,
-                                                2,
-                                                retVal,
-                                                errno) != SDL_NORMAL)
-                            {
-                                retVal = SDL_ERREXIT;
-                            }
-                        }
+                        sdl_sink_dec(sink, constant->value);
+                        sdl_sink_putc(sink, '\t');
                         break;
 
                     case SDL_K_RADIX_OCT:
-                        if (fprintf(fp,
-                                    "0%0*lo\t",
-                                    (size / 3) + 1,
-                                    constant->value) < 0)
-                        {
-                            retVal = SDL_ABORT;
-                            if (sdl_set_message(msgVec,
-                                                2,
-                                                retVal,
-                                                errno) != SDL_NORMAL)
-                            {
-                                retVal = SDL_ERREXIT;
-                            }
-                        }
+                        sdl_sink_printf(sink,
+                                        "0%0*lo\t",
+                                        (size / 3) + 1,
+                                        constant->value);
                         break;
 
                     case SDL_K_RADIX_HEX:
-                        if (fprintf(fp,
-                                    "0x%0*lx\t",
-                                    (size / 4),
-                                    constant->value) < 0)
-                        {
-                            retVal = SDL_ABORT;
-                            if (sdl_set_message(msgVec,
-                                                2,
-                                                retVal,
-                                                errno) != SDL_NORMAL)
-                            {
-                                retVal = SDL_ERREXIT;
-                            }
-                        }
+                        sdl_sink_printf(sink,
+                                        "0x%0*lx\t",
+                                        (size / 4),
+                                        constant->value);
                         break;
 
                     default:
@@ -1501,32 +1384,15 @@ static uint32_t sdl_c_constant(SDL_CONSTANT *constant, SDL_CONTEXT *context)
      */
     if ((retVal == SDL_NORMAL) && (constant->comment != NULL))
     {
-        if (fprintf(fp, "/*%s */", constant->comment) < 0)
-        {
-            retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
-                                2,
-                                retVal,
-                                errno) != SDL_NORMAL)
-            {
-                retVal = SDL_ERREXIT;
-            }
-        }
+        sdl_sink_printf(sink, "/*%s */", constant->comment);
     }
 
     /*
      * Move to the next line in the output file.
      */
-    if ((retVal == SDL_NORMAL) && (fprintf(fp, "\n") < 0))
+    if (retVal == SDL_NORMAL)
     {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
+        sdl_sink_putc(sink, '\n');
     }
 
     /*
@@ -1542,7 +1408,7 @@ static uint32_t sdl_c_constant(SDL_CONSTANT *constant, SDL_CONTEXT *context)
  *  each member in the struct/union.  It is also called after all the members
  *  have been written in order to close out the definition.  It writes out a
  *  single item (struct/union or member declaration) for each call to this.
- *  function.
+ *  function.  This is only called when sdl_c_layout is not.
  *
  * Input Parameters:
  *  param:
@@ -1586,31 +1452,13 @@ static uint32_t sdl_c_aggregate(void *param,
                                 SDL_CONTEXT *context)
 {
     char *name = NULL;
-    char *spaces = _sdl_c_leading_spaces(depth);
     SDL_LANG_AGGR my = { .parameter = param };
-    int bits = (context->argument[ArgWordSize].value / 32) - 1;  /* 0=32, 1=64 */
     uint32_t retVal = SDL_NORMAL;
-    bool defVariable = false;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_aggregate\n", __FILE__, __LINE__);
-    }
-
-    if (fprintf(fp, spaces) < 0)
-    {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
-    }
+    SDL_C_TRACE("sdl_c_aggregate");
 
     switch (type)
     {
@@ -1619,137 +1467,15 @@ static uint32_t sdl_c_aggregate(void *param,
                                         my.aggr->marker,
                                         my.aggr->tag,
                                         context);
-            if ((name != NULL) && (retVal == SDL_NORMAL))
+            if (name != NULL)
             {
-
-                /*
-                 * Are we starting or ending an AGGREGATE?
-                 */
-                if (ending == false)
-                {
-                    if (my.aggr->commonDef == true)
-                    {
-                        if (fprintf(fp, "extern ") < 0)
-                        {
-                            retVal = SDL_ABORT;
-                            if (sdl_set_message(
-                                msgVec,
-                                2,
-                                retVal,
-                                errno) != SDL_NORMAL)
-                            retVal = SDL_ERREXIT;
-                        }
-                    }
-                    if ((retVal == SDL_NORMAL) && (my.aggr->typeDef == true))
-                    {
-                        if (fprintf(fp, "typedef ") < 0)
-                        {
-                            retVal = SDL_ABORT;
-                            if (sdl_set_message(msgVec,
-                                                2,
-                                                retVal,
-                                                errno) != SDL_NORMAL)
-                            {
-                                retVal = SDL_ERREXIT;
-                            }
-                        }
-                    }
-                    defVariable = my.aggr->commonDef || my.aggr->typeDef;
-                    if (retVal == SDL_NORMAL)
-                    {
-                        char *which = _types[my.aggr->aggType][bits][my.aggr->_unsigned];
-                        char *td = (defVariable == true ? "_" : "");
-
-                        if (fprintf(fp, "%s", which) < 0)
-                        {
-                            retVal = SDL_ABORT;
-                            if (sdl_set_message(msgVec,
-                                                2,
-                                                retVal,
-                                                errno) != SDL_NORMAL)
-                            {
-                                retVal = SDL_ERREXIT;
-                            }
-                        }
-                        if ((retVal == SDL_NORMAL) &&
-                            (my.aggr->alignmentPresent == true))
-                        {
-                            retVal = _sdl_c_output_alignment(my.aggr->alignment,
-                                                             context);
-                        }
-                        if ((retVal == SDL_NORMAL) &&
-                            (fprintf(fp, " %s%s\n%s{\n", td, name, spaces) < 0))
-                        {
-                            retVal = SDL_ABORT;
-                            if (sdl_set_message(msgVec,
-                                                2,
-                                                retVal,
-                                                errno) != SDL_NORMAL)
-                            {
-                                retVal = SDL_ERREXIT;
-                            }
-                        }
-                    }
-                }
-                else
-                {
-                    defVariable = my.aggr->commonDef || my.aggr->typeDef;
-                    if (defVariable == true)
-                    {
-                        if (fprintf(fp, "} %s", name) < 0)
-                        {
-                            retVal = SDL_ABORT;
-                            if (sdl_set_message(msgVec,
-                                                2,
-                                                retVal,
-                                                errno) != SDL_NORMAL)
-                            {
-                                retVal = SDL_ERREXIT;
-                            }
-                        }
-                        else if (my.aggr->dimension == true)
-                        {
-                            int64_t dimension = my.aggr->hbound - my.aggr->lbound + 1;
-
-                            if (fprintf(fp, "[%ld]", dimension) < 0)
-                            {
-                                retVal = SDL_ABORT;
-                                if (sdl_set_message(msgVec,
-                                                    2,
-                                                    retVal,
-                                                    errno) != SDL_NORMAL)
-                                {
-                                    retVal = SDL_ERREXIT;
-                                }
-                            }
-                        }
-                    }
-                    else
-                    {
-                        if (fprintf(fp, "}") < 0)
-                        {
-                            retVal = SDL_ABORT;
-                            if (sdl_set_message(msgVec,
-                                                2,
-                                                retVal,
-                                                errno) != SDL_NORMAL)
-                            {
-                                retVal = SDL_ERREXIT;
-                            }
-                        }
-                    }
-                    if ((retVal == SDL_NORMAL) && (fprintf(fp, ";\n") < 0))
-                    {
-                        retVal = SDL_ABORT;
-                        if (sdl_set_message(msgVec,
-                                            2,
-                                            retVal,
-                                            errno) != SDL_NORMAL)
-                        {
-                            retVal = SDL_ERREXIT;
-                        }
-                    }
-                }
+                retVal = _sdl_c_aggr_line(my,
+                                          type,
+                                          ending,
+                                          name,
+                                          0,
+                                          depth,
+                                          context);
             }
             else
             {
@@ -1769,125 +1495,305 @@ static uint32_t sdl_c_aggregate(void *param,
                                         my.subaggr->prefix,
                                         my.subaggr->tag,
                                         context);
-            if ((name != NULL) && (retVal == SDL_NORMAL))
+            if (name != NULL)
+            {
+                retVal = _sdl_c_aggr_line(my,
+                                          type,
+                                          ending,
+                                          name,
+                                          0,
+                                          depth,
+                                          context);
+            }
+            else
             {
+                retVal = SDL_INVAGGRNAM;
+                if (sdl_set_message(msgVec,
+                                    1,
+                                    retVal) != SDL_NORMAL)
+                {
+                    retVal = SDL_ERREXIT;
+                }
+            }
+            break;
+
+        case LangItem:
+            _sdl_c_indent(depth);
+            retVal = sdl_c_item(my.item, context);
+            break;
+
+        case LangComment:
+            _sdl_c_indent(depth);
+            if (context->argument[ArgComments].on == true)
+            retVal = sdl_c_comment(my.comment->comment,
+                                   my.comment->lineComment,
+                                   my.comment->startComment,
+                                   my.comment->middleComment,
+                                   my.comment->endComment);
+            break;
+    }
+
+    /*
+     * Deallocate any allocated memory.
+     */
+    if (name != NULL)
+    {
+        sdl_free(name);
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_c_layout
+ *  This function is called with the layout of a whole AGGREGATE, rather than
+ *  calling sdl_c_aggregate for each of its entries.  The names and types
+ *  have already been determined, so all that is left to do is write out each
+ *  entry.
+ *
+ * Input Parameters:
+ *  layout:
+ *    A pointer to the layout of the AGGREGATE.
+ *  context:
+ *    A pointer to the context block.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_INVNAME:    Invalid item name specified.
+ *  SDL_ABORT:      An error occurred.
+ *  SDL_ERREXIT:    Error exit.
+ */
+static uint32_t sdl_c_layout(SDL_LANG_LAYOUT *layout, SDL_CONTEXT *context)
+{
+    int bits = (context->argument[ArgWordSize].value / 32) - 1;  /* 0=32, 1=64 */
+    uint32_t retVal = SDL_NORMAL;
+    uint32_t ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_C_TRACE("sdl_c_layout");
+
+    for (ii = 0; ((ii < layout->memberCount) && (retVal == SDL_NORMAL)); ii++)
+    {
+        SDL_LANG_MEMBER *member = &layout->members[ii];
+
+        switch (member->type)
+        {
+            case LangAggregate:
+            case LangSubaggregate:
+                retVal = _sdl_c_aggr_line(member->param,
+                                          member->type,
+                                          member->ending,
+                                          member->name,
+                                          member->prefixLength,
+                                          member->depth,
+                                          context);
+                break;
 
-                /*
-                 * Are we starting or ending an AGGREGATE?
-                 */
-                if (ending == false)
+            case LangItem:
+                _sdl_c_indent(member->depth);
+                if (member->typeName != NULL)
                 {
-                    char *which = _types[my.subaggr->aggType][bits][my.subaggr->_unsigned];
+                    retVal = _sdl_c_item_decl(member->param.item,
+                                              member->name,
+                                              member->prefixLength,
+                                              member->typeName,
+                                              member->typePrefixLength,
+                                              context);
+                }
+                else if (member->baseType >= 0)
+                {
+                    int baseType = member->baseType;
 
-                    if (fprintf(fp, "%s ", which) < 0)
-                    {
-                        retVal = SDL_ABORT;
-                        if (sdl_set_message(msgVec,
-                                            2,
-                                            retVal,
-                                            errno) != SDL_NORMAL)
-                        {
-                            retVal = SDL_ERREXIT;
-                        }
-                    }
-                    if ((retVal == SDL_NORMAL) &&
-                        (my.subaggr->parentAlignment == false))
+                    if (baseType == SDL_K_TYPE_NONE)
                     {
-                        retVal = _sdl_c_output_alignment(my.subaggr->alignment,
-                                                         context);
-                    }
-                    if ((retVal == SDL_NORMAL) &&
-                        (fprintf(fp, "\n%s{\n", spaces) < 0))
-                    {
-                        retVal = SDL_ABORT;
-                        if (sdl_set_message(msgVec,
-                                            2,
-                                            retVal,
-                                            errno) != SDL_NORMAL)
-                        {
-                            retVal = SDL_ERREXIT;
-                        }
+                        baseType = SDL_K_TYPE_VOID;
                     }
+                    retVal = _sdl_c_item_decl(
+                                member->param.item,
+                                member->name,
+                                member->prefixLength,
+                                _types[baseType][bits][member->_unsigned],
+                                0,
+                                context);
+                }
+                else
+                {
+                    retVal = sdl_c_item(member->param.item, context);
+                }
+                break;
+
+            case LangComment:
+                _sdl_c_indent(member->depth);
+                if (context->argument[ArgComments].on == true)
+                {
+                    SDL_COMMENT *comment = member->param.comment;
+
+                    retVal = sdl_c_comment(comment->comment,
+                                           comment->lineComment,
+                                           comment->startComment,
+                                           comment->middleComment,
+                                           comment->endComment);
+                }
+                break;
+        }
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_c_aggr_line
+ *  This function is called to write out the start or the end of an
+ *  AGGREGATE or subaggregate, once its name has been determined.
+ *
+ * Input Parameters:
+ *  my:
+ *    A pointer to the AGGREGATE or subaggregate record.
+ *  type:
+ *    A value indicating whether this is an AGGREGATE or subaggregate.
+ *  ending:
+ *    A boolean value indicating that we are ending the definition.
+ *  name:
+ *    A pointer to the name of the AGGREGATE or subaggregate.
+ *  prefixLength:
+ *    A value indicating the number of characters at the start of the name
+ *    that came from the prefix.
+ *  depth:
+ *    A value indicating the depth at which we are defining it.
+ *  context:
+ *    A pointer to the context block.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred.
+ *  SDL_ERREXIT:    Error exit.
+ */
+static uint32_t _sdl_c_aggr_line(SDL_LANG_AGGR my,
+                                 SDL_LANG_AGGR_TYPE type,
+                                 bool ending,
+                                 char *name,
+                                 size_t prefixLength,
+                                 int depth,
+                                 SDL_CONTEXT *context)
+{
+    int bits = (context->argument[ArgWordSize].value / 32) - 1;  /* 0=32, 1=64 */
+    uint32_t retVal = SDL_NORMAL;
+    bool defVariable = false;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_C_TRACE("_sdl_c_aggr_line");
+
+    _sdl_c_indent(depth);
+    if (type == LangAggregate)
+    {
+
+        /*
+         * Are we starting or ending an AGGREGATE?
+         */
+        if (ending == false)
+        {
+            char *which = _types[my.aggr->aggType][bits][my.aggr->_unsigned];
+
+            if (my.aggr->commonDef == true)
+            {
+                sdl_sink_puts(sink, "extern ");
+            }
+            if (my.aggr->typeDef == true)
+            {
+                sdl_sink_puts(sink, "typedef ");
+            }
+            defVariable = my.aggr->commonDef || my.aggr->typeDef;
+            sdl_sink_puts(sink, which);
+            if (my.aggr->alignmentPresent == true)
+            {
+                retVal = _sdl_c_output_alignment(my.aggr->alignment, context);
+            }
+            if (retVal == SDL_NORMAL)
+            {
+                sdl_sink_putc(sink, ' ');
+                if (defVariable == true)
+                {
+                    sdl_sink_putc(sink, '_');
                 }
-                else
+                _sdl_c_put_name(name, prefixLength);
+                sdl_sink_putc(sink, '\n');
+                _sdl_c_indent(depth);
+                sdl_sink_puts(sink, "{\n");
+            }
+        }
+        else
+        {
+            defVariable = my.aggr->commonDef || my.aggr->typeDef;
+            if (defVariable == true)
+            {
+                sdl_sink_puts(sink, "} ");
+                _sdl_c_put_name(name, prefixLength);
+                if (my.aggr->dimension == true)
                 {
-                    if (fprintf(fp, "} %s", name) < 0)
-                    {
-                        retVal = SDL_ABORT;
-                        if (sdl_set_message(msgVec,
-                                            2,
-                                            retVal,
-                                            errno) != SDL_NORMAL)
-                        {
-                            retVal = SDL_ERREXIT;
-                        }
-                    }
-                    else if (my.subaggr->dimension == true)
-                    {
-                        int64_t dimension = my.subaggr->hbound -
-                                            my.subaggr->lbound + 1;
+                    int64_t dimension = my.aggr->hbound - my.aggr->lbound + 1;
 
-                        if (fprintf(fp, "[%ld]", dimension) < 0)
-                        {
-                            retVal = SDL_ABORT;
-                            if (sdl_set_message(msgVec,
-                                                2,
-                                                retVal,
-                                                errno) != SDL_NORMAL)
-                            {
-                                retVal = SDL_ERREXIT;
-                            }
-                        }
-                    }
-                    if ((retVal == SDL_NORMAL) && fprintf(fp, ";\n") < 0)
-                    {
-                        retVal = SDL_ABORT;
-                        if (sdl_set_message(msgVec,
-                                            2,
-                                            retVal,
-                                            errno) != SDL_NORMAL)
-                        {
-                            retVal = SDL_ERREXIT;
-                        }
-                    }
+                    sdl_sink_printf(sink, "[%ld]", dimension);
                 }
             }
             else
             {
-                retVal = SDL_INVAGGRNAM;
-                if (sdl_set_message(msgVec,
-                                    1,
-                                    retVal) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
+                sdl_sink_putc(sink, '}');
             }
-            break;
+            sdl_sink_puts(sink, ";\n");
+        }
+    }
+    else
+    {
 
-        case LangItem:
-            retVal = sdl_c_item(my.item, context);
-            break;
+        /*
+         * Are we starting or ending a subaggregate?
+         */
+        if (ending == false)
+        {
+            char *which = _types[my.subaggr->aggType][bits][my.subaggr->_unsigned];
 
-        case LangComment:
-            if (context->argument[ArgComments].on == true)
-            retVal = sdl_c_comment(my.comment->comment,
-                                   my.comment->lineComment,
-                                   my.comment->startComment,
-                                   my.comment->middleComment,
-                                   my.comment->endComment);
-            break;
-    }
+            sdl_sink_printf(sink, "%s ", which);
+            if (my.subaggr->parentAlignment == false)
+            {
+                retVal = _sdl_c_output_alignment(my.subaggr->alignment,
+                                                 context);
+            }
+            if (retVal == SDL_NORMAL)
+            {
+                sdl_sink_putc(sink, '\n');
+                _sdl_c_indent(depth);
+                sdl_sink_puts(sink, "{\n");
+            }
+        }
+        else
+        {
+            sdl_sink_puts(sink, "} ");
+            _sdl_c_put_name(name, prefixLength);
+            if (my.subaggr->dimension == true)
+            {
+                int64_t dimension = my.subaggr->hbound -
+                                    my.subaggr->lbound + 1;
 
-    /*
-     * Deallocate any allocated memory.
-     */
-    if (name != NULL)
-    {
-        sdl_free(name);
-    }
-    if (spaces != NULL)
-    {
-        sdl_free(spaces);
+                sdl_sink_printf(sink, "[%ld]", dimension);
+            }
+            sdl_sink_puts(sink, ";\n");
+        }
     }
 
     /*
@@ -1926,12 +1832,9 @@ static uint32_t sdl_c_entry(SDL_ENTRY *entry, SDL_CONTEXT *context)
     bool        firstLine = false;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_entry\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("sdl_c_entry");
 
     /*
      * If there is no type assigned to this ENTRY, then this is a procedure.
@@ -1940,17 +1843,7 @@ static uint32_t sdl_c_entry(SDL_ENTRY *entry, SDL_CONTEXT *context)
      */
     if (entry->returns.type == SDL_K_TYPE_NONE)
     {
-        if (fprintf(fp, "void %s(", entry->id) < 0)
-        {
-            retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
-                                2,
-                                retVal,
-                                errno) != SDL_NORMAL)
-            {
-                retVal = SDL_ERREXIT;
-            }
-        }
+        sdl_sink_printf(sink, "void %s(", entry->id);
     }
     else
     {
@@ -1970,17 +1863,7 @@ static uint32_t sdl_c_entry(SDL_ENTRY *entry, SDL_CONTEXT *context)
             outLen += sprintf(&outBuf[outLen], "%s", "*");
         }
         outLen += sprintf(&outBuf[outLen], "%s(", entry->id);
-        if (fprintf(fp, outBuf) < 0)
-        {
-            retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
-                                2,
-                                retVal,
-                                errno) != SDL_NORMAL)
-            {
-                retVal = SDL_ERREXIT;
-            }
-        }
+        sdl_sink_puts(sink, outBuf);
         if ((freeMe == true) && (type != NULL))
         {
             sdl_free(type);
@@ -2041,59 +1924,22 @@ static uint32_t sdl_c_entry(SDL_ENTRY *entry, SDL_CONTEXT *context)
         if ((firstLine == false) &&
             (param == (SDL_PARAMETER *) &entry->parameters))
         {
-            if (fprintf(fp, outBuf) < 0)        /* only parameter */
-            {
-                retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
-                                    2,
-                                    retVal,
-                                    errno) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
-            }
+            sdl_sink_puts(sink, outBuf);
         }
         else if ((firstLine == true) &&
                  (param == (SDL_PARAMETER *) &entry->parameters))
         {
-            if (fprintf(fp, "\n\t%s", outBuf) < 0)    /* last parameter */
-            {
-                retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
-                                    2,
-                                    retVal,
-                                    errno) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
-            }
+            sdl_sink_printf(sink, "\n\t%s", outBuf);
         }
         else
         {
-            if (fprintf(fp, "\n\t%s,", outBuf) < 0)    /* other parameter */
-            {
-                retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
-                                    2,
-                                    retVal,
-                                    errno) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
-            }
+            sdl_sink_printf(sink, "\n\t%s,", outBuf);
             firstLine = true;
         }
     }
-    if ((retVal == SDL_NORMAL) && (fprintf(fp, ");\n") < 0))
+    if (retVal == SDL_NORMAL)
     {
-        retVal = SDL_ABORT;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            errno) != SDL_NORMAL)
-        {
-            retVal = SDL_ERREXIT;
-        }
+        sdl_sink_puts(sink, ");\n");
     }
 
     /*
@@ -2132,12 +1978,9 @@ static uint32_t sdl_c_enumerate(SDL_ENUMERATE *_enum, SDL_CONTEXT *context)
     uint32_t retVal = SDL_NORMAL;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:sdl_c_enumerate\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("sdl_c_enumerate");
 
     if (name != NULL)
     {
@@ -2148,31 +1991,11 @@ static uint32_t sdl_c_enumerate(SDL_ENUMERATE *_enum, SDL_CONTEXT *context)
          */
         if (_enum->typeDef == true)
         {
-            if (fprintf(fp, "typedef enum _%s\n{\n", name) < 0)
-            {
-                retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
-                                    2,
-                                    retVal,
-                                    errno) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
-            }
+            sdl_sink_printf(sink, "typedef enum _%s\n{\n", name);
         }
         else
         {
-            if (fprintf(fp, "enum %s\n{\n", name) < 0)
-            {
-                retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
-                                    2,
-                                    retVal,
-                                    errno) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
-            }
+            sdl_sink_printf(sink, "enum %s\n{\n", name);
         }
 
         /*
@@ -2181,90 +2004,36 @@ static uint32_t sdl_c_enumerate(SDL_ENUMERATE *_enum, SDL_CONTEXT *context)
         while((retVal == SDL_NORMAL) &&
               (myMem != (SDL_ENUM_MEMBER *) &_enum->members))
         {
-            if (fprintf(fp, "    %s", myMem->id) < 0)
+            sdl_sink_printf(sink, "    %s", myMem->id);
+            if (myMem->valueSet == true)
             {
-                retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
-                                    2,
-                                    retVal,
-                                    errno) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
+                sdl_sink_printf(sink, " = %ld,\n", myMem->value);
             }
             else
             {
-                if (myMem->valueSet == true)
-                {
-                    if (fprintf(fp, " = %ld,\n", myMem->value) < 0)
-                    {
-                        retVal = SDL_ABORT;
-                        if (sdl_set_message(msgVec,
-                                            2,
-                                            retVal,
-                                            errno) != SDL_NORMAL)
-                        {
-                            retVal = SDL_ERREXIT;
-                        }
-                    }
-                }
-                else if (fprintf(fp, ",\n") < 0)
-                {
-                    retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
-                                        2,
-                                        retVal,
-                                        errno) != SDL_NORMAL)
-                    {
-                        retVal = SDL_ERREXIT;
-                    }
-                }
+                sdl_sink_puts(sink, ",\n");
             }
         }
 
         /*
          * Finally, we need to close of the enum definition.
          */
-        if ((retVal == SDL_NORMAL) && (fprintf(fp, "}") < 0))
+        if (retVal == SDL_NORMAL)
         {
-            retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
-                                2,
-                                retVal,
-                                errno) != SDL_NORMAL)
-            {
-                retVal = SDL_ERREXIT;
-            }
+            sdl_sink_putc(sink, '}');
         }
         if ((retVal == SDL_NORMAL) && (_enum->typeDef == true))
         {
-            if (fprintf(fp, " %s", name) < 0)
-            {
-                retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
-                                    2,
-                                    retVal,
-                                    errno) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
-            }
+            sdl_sink_printf(sink, " %s", name);
         }
         if (retVal == SDL_NORMAL)
         {
             retVal = _sdl_c_output_alignment(_enum->alignment,
                                              context);
         }
-        if ((retVal == SDL_NORMAL) && (fprintf(fp, ";\n") < 0))
+        if (retVal == SDL_NORMAL)
         {
-            retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
-                                2,
-                                retVal,
-                                errno) != SDL_NORMAL)
-            {
-                retVal = SDL_ERREXIT;
-            }
+            sdl_sink_puts(sink, ";\n");
         }
         sdl_free(name);
     }
@@ -2319,47 +2088,17 @@ static uint32_t _sdl_c_output_alignment(int alignment,
         switch(alignment)
         {
             case SDL_K_NOALIGN:
-                if (fprintf(fp, " __attribute__ ((__packed__))") < 0)
-                {
-                    retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
-                                        2,
-                                        retVal,
-                                        errno) != SDL_NORMAL)
-                    {
-                        retVal = SDL_ERREXIT;
-                    }
-                }
+                sdl_sink_puts(sink, " __attribute__ ((__packed__))");
                 break;
 
             case SDL_K_ALIGN:
-                if (fprintf(fp, " __attribute__ ((aligned))") < 0)
-                {
-                    retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
-                                        2,
-                                        retVal,
-                                        errno) != SDL_NORMAL)
-                    {
-                        retVal = SDL_ERREXIT;
-                    }
-                }
+                sdl_sink_puts(sink, " __attribute__ ((aligned))");
                 break;
 
             default:
-                if (fprintf(fp,
-                            " __attribute__ ((aligned (%d)))",
-                            alignment) < 0)
-                {
-                    retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
-                                        2,
-                                        retVal,
-                                        errno) != SDL_NORMAL)
-                    {
-                        retVal = SDL_ERREXIT;
-                    }
-                }
+                sdl_sink_printf(sink,
+                                " __attribute__ ((aligned (%d)))",
+                                alignment);
             break;
         }
     }
@@ -2403,12 +2142,9 @@ static char *_sdl_c_generate_name(char *name,
     size_t tagLen = 0;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:_sdl_c_generate_name\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("_sdl_c_generate_name");
 
     /*
      * First, if we have a prefix, let's get it's length.  Also, the presents
@@ -2521,12 +2257,9 @@ static char *_sdl_c_typeidStr(int typeID,
     int sign = (_unsigned ? 1 : 0);
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
-    {
-        printf("%s:%d:_sdl_c_typeidStr\n", __FILE__, __LINE__);
-    }
+    SDL_C_TRACE("_sdl_c_typeidStr");
 
     *freeMe = false;
     if (typeID == SDL_K_TYPE_NONE)
@@ -2546,17 +2279,10 @@ static char *_sdl_c_typeidStr(int typeID,
     }
     else if ((typeID >= SDL_K_DECLARE_MIN) && (typeID <= SDL_K_DECLARE_MAX))
     {
-        SDL_DECLARE_LIST *declare = &context->declares;
-        SDL_DECLARE *myDeclare = (SDL_DECLARE *) declare->header.flink;
+        SDL_DECLARE *myDeclare = sdl_symtab_lookup_id(&context->declares.symtab,
+                                                      typeID);
 
-        while (myDeclare != (SDL_DECLARE *) &declare->header)
-        {
-            if (myDeclare->typeID == typeID)
-                break;
-            else
-                myDeclare = (SDL_DECLARE *) myDeclare->header.queue.flink;
-        }
-        if (myDeclare != (SDL_DECLARE *) &declare->header)
+        if (myDeclare != NULL)
         {
             retVal = _sdl_c_generate_name(myDeclare->id,
                                           myDeclare->prefix,
@@ -2570,18 +2296,9 @@ static char *_sdl_c_typeidStr(int typeID,
     }
     else if ((typeID >= SDL_K_ITEM_MIN) && (typeID <= SDL_K_ITEM_MAX))
     {
-        SDL_ITEM_LIST *item = &context->items;
-        SDL_ITEM *myItem;
-
-        while (myItem != (SDL_ITEM *) &item->header)
-        {
-            if (myItem->typeID == typeID)
-                break;
-            else
-                myItem = (SDL_ITEM *) myItem->header.queue.flink;
+        SDL_ITEM *myItem = sdl_symtab_lookup_id(&context->items.symtab, typeID);
 
-        }
-        if (myItem != (SDL_ITEM *) &item->header)
+        if (myItem != NULL)
         {
             retVal = _sdl_c_typeidStr(myItem->type,
                                       subType,
@@ -2593,17 +2310,10 @@ static char *_sdl_c_typeidStr(int typeID,
     else if ((typeID >= SDL_K_AGGREGATE_MIN) &&
              (typeID <= SDL_K_AGGREGATE_MAX))
     {
-        SDL_AGGREGATE_LIST *aggregate = &context->aggregates;
-        SDL_AGGREGATE *myAggregate;
+        SDL_AGGREGATE *myAggregate =
+                    sdl_symtab_lookup_id(&context->aggregates.symtab, typeID);
 
-        while (myAggregate != (SDL_AGGREGATE *) &aggregate->header)
-        {
-            if (myAggregate->typeID == typeID)
-                break;
-            else
-                myAggregate = (SDL_AGGREGATE *) myAggregate->header.queue.flink;
-        }
-        if (myAggregate!= (SDL_AGGREGATE *) &aggregate->header)
+        if (myAggregate != NULL)
         {
             retVal = _sdl_c_typeidStr(myAggregate->type,
                                       subType,
@@ -2620,11 +2330,10 @@ static char *_sdl_c_typeidStr(int typeID,
 }
 
 /*
- * _sdl_c_leading_spaces
- *  This function is called to determine and generate the number of leading
- *  spaces to be used while writing out a struct/union declaration.  For each
- *  depth, 4 spaces are added.  A tab will be used instead of 4 spaces when it
- *  make sense.
+ * _sdl_c_indent
+ *  This function is called to write out the leading spaces to be used while
+ *  writing out a struct/union declaration.  For each depth, 4 spaces are
+ *  added.  A tab will be used instead of 8 spaces when it make sense.
  *
  * Input Parameters:
  *  depth:
@@ -2634,58 +2343,65 @@ static char *_sdl_c_typeidStr(int typeID,
  *  None.
  *
  * Return Values:
- *  NULL:    An error occurred trying to allocate memory for the string.
- *  !NULL:    A pointer to the spaces to use for the output.
+ *  None.
  */
-static char *_sdl_c_leading_spaces(int depth)
+static void _sdl_c_indent(int depth)
 {
-    char *retVal = NULL;
-    int spaces = depth * 4;
-    int tabs = spaces / 8;
-    int remaining = spaces - (tabs * 8);
     int ii;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (*trace == true)
+    SDL_C_TRACE1("_sdl_c_indent", depth);
+
+    for (ii = 0; ii < (depth / 2); ii++)
+    {
+        sdl_sink_putc(sink, '\t');
+    }
+    if ((depth % 2) != 0)
     {
-        printf("%s:%d:_sdl_c_leading_spaces(%d)\n", __FILE__, __LINE__, depth);
+        sdl_sink_puts(sink, "    ");
     }
 
     /*
-     * Allocate enough memory for the return string.
+     * Return back to the caller.
      */
-    retVal = sdl_calloc(1, (tabs + remaining + 1));
-    if (retVal != NULL)
-    {
-
-        /*
-         * First, insert zero or more tabs.
-         */
-        for (ii = 0; ii < tabs; ii++)
-        {
-            retVal[ii] = '\t';
-        }
+    return;
+}
 
-        /*
-         * Next, insert zero to four spaces.
-         */
-        for (ii = tabs; ii < (tabs + remaining); ii++)
-        {
-            retVal[ii] = ' ';
-        }
+/*
+ * _sdl_c_put_name
+ *  This function is called to write out a name, or type string, that was
+ *  put together from a prefix, tag and identifier.  The characters that came
+ *  from the prefix are written out in lowercase.
+ *
+ * Input Parameters:
+ *  name:
+ *    A pointer to the name to be written out.
+ *  prefixLength:
+ *    A value indicating the number of characters at the start of the name
+ *    that came from the prefix.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_c_put_name(char *name, size_t prefixLength)
+{
+    size_t ii;
 
-        /*
-         * Finally, null-terminate the string.
-         */
-        retVal[tabs + remaining] = '\0';
+    for (ii = 0; ii < prefixLength; ii++)
+    {
+        sdl_sink_putc(sink, tolower((unsigned char) name[ii]));
     }
+    sdl_sink_puts(sink, &name[prefixLength]);
 
     /*
-     * Return the results back to the caller.
+     * Return back to the caller.
      */
-    return(retVal);
+    return;
 }
 
 
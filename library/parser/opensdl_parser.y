@@ -37,6 +37,60 @@
  *  V01.003 10-NOV-2018 Jonathan D. Belanger
  *  Added a macro to keep track of the line numbers so that they can be
  *  reported in error messages.
+ *
+ *  V01.004 15-OCT-2026 Jonathan D. Belanger
+ *  The parser is now reentrant.  The context is passed in as a parse
+ *  parameter, rather than being a global, and the scanner gets it as its
+ *  extra data.  Added sdl_parse_file to run the scanner and parser over a
+ *  file for a context, and moved yyerror here from the main program.
+ *  Diagnostics are written to the context's error file.
+ *
+ *  V01.005 15-OCT-2026 Jonathan D. Belanger
+ *  Internal failures no longer exit.  The status is saved in the context and
+ *  the parse is aborted, so that sdl_parse_file can return it to the caller.
+ *
+ *  V01.006 15-OCT-2026 Jonathan D. Belanger
+ *  A MODULE that was not completed because the parse was aborted is
+ *  discarded from the module IR, so that it does not generate any output.
+ *
+ *  V01.007 16-OCT-2026 Jonathan D. Belanger
+ *  When there is a cache directory, INCLUDE is given to the parser, so that
+ *  an INCLUDE file outside of a MODULE can be replayed from its precompiled
+ *  form, or precompiled as it is parsed.  The number of diagnostics reported
+ *  is kept in the context.
+ *
+ *  V01.008 16-OCT-2026 Jonathan D. Belanger
+ *  An input file that was opened on disk is mapped into memory and scanned
+ *  where it is.
+ *
+ *  V01.009 16-OCT-2026 Jonathan D. Belanger
+ *  When IFSYMBOL, ELSE_IFSYMBOL or ELSE turns processing off, the scanner is
+ *  told to skip to the end of the inactive region.
+ *
+ *  V01.010 16-OCT-2026 Jonathan D. Belanger
+ *  Added sdl_tape_record, to scan an input file once into a recording of its
+ *  tokens, and sdl_parse_tape, to parse that recording as many times as
+ *  needed, each time for its own context.  The context is passed to yylex,
+ *  so that the tokens can come from the recording.
+ *
+ *  V01.011 16-OCT-2026 Jonathan D. Belanger
+ *  The time spent scanning and parsing, and the tokens scanned, are counted
+ *  for --stats.
+ *
+ *  V01.012 16-OCT-2026 Jonathan D. Belanger
+ *  Each call is recorded in the trace, rather than written to standard
+ *  output.
+ *
+ *  V01.013 16-OCT-2026 Jonathan D. Belanger
+ *  An INCLUDE is kept in a recording as a token, and the file is only
+ *  scanned, into a recording of its own, when a parse of the recording
+ *  reaches it with processing turned on.  An INCLUDE in an inactive
+ *  IFSYMBOL region is never read, just as when the input file is parsed.
+ *
+ *  V01.014 16-OCT-2026 Jonathan D. Belanger
+ *  A recording interns the names in it into a pool of its own, as it is
+ *  parsed by the compilation of each variant, after the compilation that
+ *  made it, and the pool the scanner interned them into, is gone.
  */
 %verbose
 %define parse.lac   full
@@ -52,7 +106,28 @@
 %verbose
 
 %lex-param {void *scanner}
+%lex-param {SDL_CONTEXT *context}
 %parse-param {void *scanner}
+%parse-param {SDL_CONTEXT *context}
+
+/*
+ * The parser header needs the context definition for the yyparse prototype,
+ * and provides the entry points used to parse a file, or a recording of the
+ * tokens in one.
+ */
+%code requires
+{
+#include "opensdl_defs.h"
+}
+%code provides
+{
+uint32_t sdl_parse_file(SDL_CONTEXT *context, FILE *fp);
+uint32_t sdl_tape_record(SDL_CONTEXT *context,
+                         FILE *fp,
+                         struct _sdl_tape **tape);
+uint32_t sdl_parse_tape(SDL_CONTEXT *context, struct _sdl_tape *tape);
+void sdl_tape_free(struct _sdl_tape *tape);
+}
 
 /*
  * Prologue
@@ -68,17 +143,17 @@
 #include "opensdl_lexical.h"
 #include "opensdl_parser.h"
 #include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_intern.h"
 #include "library/common/opensdl_message.h"
+#include "library/common/opensdl_stats.h"
+#include "library/common/opensdl_trace.h"
 #include "library/utility/opensdl_actions.h"
+#include "library/utility/opensdl_ir.h"
+#include "library/utility/opensdl_include.h"
 #include "library/utility/opensdl_listing.h"
+#include "library/utility/opensdl_precomp.h"
 #include "opensdl/opensdl_main.h"
 
-extern bool     listing;
-extern FILE     *listingFP;
-
-SDL_CONTEXT    context;
-SDL_QUEUE    literal;
-
 #define YYLLOC_DEFAULT(_cur, _rhs, _n)                                      \
 do                                                                          \
 {                                                                           \
@@ -98,7 +173,50 @@ do                                                                          \
     }                                                                       \
 } while (false)
 
-void yyerror(YYLTYPE *locp, yyscan_t *scanner, char const *msg);
+void yyerror(YYLTYPE *locp,
+             yyscan_t *scanner,
+             SDL_CONTEXT *context,
+             char const *msg);
+bool sdl_lex_include(char *fileName, bool precompile, void *scanner);
+static int _sdl_yylex(YYSTYPE *lvalp,
+                      YYLTYPE *llocp,
+                      void *scanner,
+                      SDL_CONTEXT *context);
+static uint32_t _sdl_tape_include(SDL_CONTEXT *context,
+                                  char *fileName,
+                                  int lineNumber);
+#define yylex   _sdl_yylex
+
+/*
+ * A recording of the tokens returned by the scanner for an input file.  The
+ * strings the scanner duplicated for the tokens are kept in the recording's
+ * arena, and are duplicated again each time they are given to the parser,
+ * since the actions may keep or free them.  Interned strings are kept as
+ * they are.  An INCLUDE is recorded as its token, and include is the
+ * recording of the file, which is only made the first time a parse reaches
+ * the INCLUDE with processing turned on.  That recording has the one it was
+ * included from as its parent, and resume is the token in the parent that
+ * follows the INCLUDE.
+ */
+#define SDL_K_TAPE_INCR     1024
+typedef struct
+{
+    YYSTYPE         value;
+    YYLTYPE         loc;
+    struct _sdl_tape *include;
+    int             token;
+} SDL_TAPE_TOKEN;
+struct _sdl_tape
+{
+    SDL_TAPE_TOKEN  *tokens;
+    SDL_ARENA       arena;
+    SDL_INTERN_POOL names;
+    struct _sdl_tape *parent;
+    size_t          resume;
+    size_t          used;
+    size_t          size;
+    uint32_t        status;
+};
 static char *bugchk = "%%SDL-F-BUGCHECK, Internal consistency failure "
                       "[Line %d] - please submit a bug report\n";
 static char *errexit = "-SDL-F-ERREXIT, Error exit\n";
@@ -112,20 +230,23 @@ do                                                                          \
     {                                                                       \
         char     *_msgTxt;                                                  \
                                                                             \
+        context->diagnostics++;                                             \
         if ((status != SDL_ERREXIT) &&                                      \
-            (sdl_get_message(msgVec, &_msgTxt) == SDL_NORMAL))              \
+            (sdl_get_message(context->msgVec, &_msgTxt) == SDL_NORMAL))     \
         {                                                                   \
-            if (listing == true)                                            \
-            sdl_write_err(listingFP, _msgTxt);                              \
-            fprintf(stderr, "%s", _msgTxt);                                 \
+            if (context->listing.on == true)                                \
+            sdl_write_err(&context->listing, _msgTxt);                      \
+            fprintf(context->errFP, "%s", _msgTxt);                         \
             sdl_free(_msgTxt);                                              \
         }                                                                   \
         else                                                                \
         {                                                                   \
-            fprintf(stderr, bugchk, (loc).first_line);                      \
+            fprintf(context->errFP, bugchk, (loc).first_line);              \
             if (status == SDL_ERREXIT)                                      \
-            fprintf(stderr, errexit);                                       \
-            exit(0);                                                        \
+            fprintf(context->errFP, errexit);                               \
+            context->parseStatus = (status == SDL_ERREXIT) ?                \
+                                    status : SDL_BUGCHECK;                  \
+            YYABORT;                                                        \
         }                                                                   \
     }                                                                       \
 } while (false)
@@ -293,6 +414,9 @@ do                                                                          \
 %token <tval> t_variable
 %token <tval> t_aggr_str
 %token <tval> t_aggr_name
+%token <tval> t_include
+
+%token SDL_K_END_INCLUDE
 
 %type <ival> _v_expression
 %type <ival> _v_number
@@ -337,14 +461,59 @@ beginning
 file_layout
     : comments
     | module_format
+    | include
+    ;
+
+include
+    : t_include {
+            bool loaded;
+            bool precompile;
+
+            /*
+             * When a recording is being parsed, the INCLUDE file is always
+             * replayed from its own recording, rather than its precompiled
+             * form, since the recording has to do for every context.
+             */
+            if (context->lexState.tape != NULL)
+            {
+                uint32_t inclStatus;
+
+                inclStatus = _sdl_tape_include(context, $1, @1.first_line);
+                if (inclStatus != SDL_NORMAL)
+                {
+                    SDL_CALL(inclStatus, @$);
+                    context->parseStatus = inclStatus;
+                    sdl_free($1);
+                    YYABORT;
+                }
+            }
+            else
+            {
+                SDL_CALL(sdl_precomp_include(context,
+                                             $1,
+                                             &loaded,
+                                             &precompile),
+                         @$);
+                if ((loaded == false) &&
+                    (sdl_lex_include($1, precompile, scanner) == false))
+                {
+                    sdl_free($1);
+                    YYABORT;
+                }
+            }
+            sdl_free($1);
+        }
+    | SDL_K_END_INCLUDE {
+            sdl_precomp_end(context);
+        }
     ;
 
 comments
     : t_line_comment {
-            SDL_CALL(sdl_comment_line(&context, $1, (SDL_YYLTYPE *) &@1), @$);
+            SDL_CALL(sdl_comment_line(context, $1, (SDL_YYLTYPE *) &@1), @$);
         }
     | t_block_comment {
-            SDL_CALL(sdl_comment_block(&context, $1, (SDL_YYLTYPE *) &@1), @$);
+            SDL_CALL(sdl_comment_block(context, $1, (SDL_YYLTYPE *) &@1), @$);
         }
     ;
 
@@ -360,18 +529,18 @@ _t_id
 
 module
     : SDL_K_MODULE t_name { 
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Module,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_module(&context, $2, NULL, (SDL_YYLTYPE *) &@2), @$);
+            SDL_CALL(sdl_module(context, $2, NULL, (SDL_YYLTYPE *) &@2), @$);
         }
     | SDL_K_MODULE t_name SDL_K_IDENT t_string {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Module,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_module(&context, $2, $4, (SDL_YYLTYPE *) &@2), @$);
+            SDL_CALL(sdl_module(context, $2, $4, (SDL_YYLTYPE *) &@2), @$);
         }
     ;
 
@@ -382,11 +551,11 @@ _t_module_name
 
 end_module
     : SDL_K_END_MODULE _t_module_name {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           DefinitionEnd,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_module_end(&context, $2, (SDL_YYLTYPE *) &@2), @$);
+            SDL_CALL(sdl_module_end(context, $2, (SDL_YYLTYPE *) &@2), @$);
         }
     ;
 
@@ -416,14 +585,14 @@ module_body
 
 definition_end
     : SDL_K_SEMI {
-            switch (context.state)
+            switch (context->state)
             {
                 case Local:
                 case Declare:
                 case Constant:
                 case Item:
                 case Entry:
-                    SDL_CALL(sdl_state_transition(&context,
+                    SDL_CALL(sdl_state_transition(context,
                                                   DefinitionEnd,
                                                   (SDL_YYLTYPE *) &@1),
                              @$);
@@ -446,26 +615,27 @@ _v_terminal
     | _v_terminal SDL_K_DIVIDE _v_boolean {
             if ($3 == 0)
             {
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     1,
                                     SDL_ZERODIV,
                                     @3.first_line) == SDL_NORMAL)
                 {
                     char *msgText;
         
-                    if (sdl_get_message(msgVec, &msgText) == SDL_NORMAL)
+                    if (sdl_get_message(context->msgVec, &msgText) == SDL_NORMAL)
                     {
-                        fprintf(stderr, "%s\n", msgText);
+                        fprintf(context->errFP, "%s\n", msgText);
                         sdl_free(msgText);
                     }
                     else
                     {
-                        fprintf(stderr,
+                        fprintf(context->errFP,
                                 "%%SDL-F-BUGCHECK, Internal consistency "
                                 "failure [Line %d] - please submit a bug "
                                 "report\n",
                                 @3.first_line);
-                        exit(0);
+                        context->parseStatus = SDL_BUGCHECK;
+                        YYABORT;
                     }
                 }
                 $$ = 0;
@@ -496,54 +666,61 @@ _v_factor
     | SDL_K_NOT _v_factor { $$ = ~$2; }
     | SDL_K_OPENP _v_expression SDL_K_CLOSEP { $$ = $2; }
     | _v_number { $$ = $1; }
-    | t_string { SDL_CALL(sdl_str2int(sdl_unquote_str($1), &$$), @$); }
+    | t_string { SDL_CALL(sdl_str2int(context, sdl_unquote_str($1), &$$), @$); }
     ;
 
 _v_number
     : v_int { $$ = $1; }
-    | t_variable { SDL_CALL(sdl_get_local(&context, $1, &$$), @$); }
+    | t_variable { SDL_CALL(sdl_get_local(context, $1, &$$), @$); }
     | t_hex { sscanf($1, "%lx", &$$); sdl_free($1); }
     | t_octal { sscanf($1, "%lo", &$$); sdl_free($1); }
     | t_binary { $$ = sdl_bin2int($1); }
     | t_ascii { $$ = (__int64_t) $1[0]; sdl_free($1); }
     | SDL_K_DOT {
-            $$ = sdl_offset(&context, SDL_K_OFF_BYTE_REL, (SDL_YYLTYPE *) &@1);
+            $$ = sdl_offset(context, SDL_K_OFF_BYTE_REL, (SDL_YYLTYPE *) &@1);
         }
     | SDL_K_FULL {
-            $$ = sdl_offset(&context, SDL_K_OFF_BYTE_BEG, (SDL_YYLTYPE *) &@1);
+            $$ = sdl_offset(context, SDL_K_OFF_BYTE_BEG, (SDL_YYLTYPE *) &@1);
         }
     | SDL_K_CARAT {
-            $$ = sdl_offset(&context, SDL_K_OFF_BIT, (SDL_YYLTYPE *) &@1);
+            $$ = sdl_offset(context, SDL_K_OFF_BIT, (SDL_YYLTYPE *) &@1);
         }
     ;
 
 varset
     : t_variable SDL_K_EQ _v_expression{
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Local,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_set_local(&context, $1, $3, (SDL_YYLTYPE *) &@1), @$);
+            SDL_CALL(sdl_set_local(context, $1, $3, (SDL_YYLTYPE *) &@1), @$);
         }
     ;
 
 literal
     : SDL_K_LITERAL
     | t_literal_string {
-        SDL_CALL(sdl_literal(&context, &literal, $1, (SDL_YYLTYPE *) &@1), @$);
+        SDL_CALL(sdl_literal(context,
+                             &context->literal,
+                             $1,
+                             (SDL_YYLTYPE *) &@1),
+                 @$);
         }
     | SDL_K_END_LITERAL {
-        SDL_CALL(sdl_literal_end(&context, &literal, (SDL_YYLTYPE *) &@1), @$);
+        SDL_CALL(sdl_literal_end(context,
+                                 &context->literal,
+                                 (SDL_YYLTYPE *) &@1),
+                 @$);
         }
     ;
 
 declare
     : SDL_K_DECLARE _t_id SDL_K_SIZEOF _v_sizeof { 
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Declare,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_declare(&context, $2, $4, (SDL_YYLTYPE *) &@2), @$);
+            SDL_CALL(sdl_declare(context, $2, $4, (SDL_YYLTYPE *) &@2), @$);
         }
     ;
 
@@ -554,7 +731,7 @@ _v_sizeof
 
 prefix
     : SDL_K_PREFIX _t_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Prefix,
                                     0,
                                     $2,
@@ -562,7 +739,7 @@ prefix
                      @$);
         }
     | SDL_K_PREFIX _t_aggr_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Prefix,
                                     0,
                                     $2,
@@ -573,7 +750,7 @@ prefix
 
 marker
     : SDL_K_MARKER _t_aggr_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Marker,
                                     0,
                                     $2,
@@ -584,7 +761,7 @@ marker
 
 tag
     : SDL_K_TAG _t_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Tag,
                                     0,
                                     $2,
@@ -592,7 +769,7 @@ tag
                      @$);
         }
     | SDL_K_TAG _t_aggr_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Tag,
                                     0,
                                     $2,
@@ -603,7 +780,7 @@ tag
 
 origin
     : SDL_K_ORIGIN _t_aggr_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Origin,
                                     0,
                                     $2,
@@ -614,7 +791,7 @@ origin
 
 counter
     : SDL_K_COUNTER t_variable {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Counter,
                                     0,
                                     $2,
@@ -625,7 +802,7 @@ counter
 
 _typename
     : SDL_K_TYPENAME _t_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     TypeName,
                                     0,
                                     $2,
@@ -636,7 +813,7 @@ _typename
 
 radix
     : SDL_K_RADIX v_int {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Radix,
                                     $2,
                                     NULL,
@@ -647,7 +824,7 @@ radix
 
 increment
     : SDL_K_INCR _v_expression {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Increment,
                                     $2,
                                     NULL,
@@ -658,7 +835,7 @@ increment
 
 enumerate
     : SDL_K_ENUM _t_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Enumerate,
                                     0,
                                     $2,
@@ -683,11 +860,11 @@ _clause_list
 
 _clause
     : t_constant_name SDL_K_EQUALS _v_expression {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Constant,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_constant(&context,
+            SDL_CALL(sdl_constant(context,
                                   $1,
                                   $3,
                                   NULL,
@@ -695,11 +872,11 @@ _clause
                      @$);
         }
     | t_constant_names SDL_K_EQUALS _v_expression {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Constant,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_constant(&context,
+            SDL_CALL(sdl_constant(context,
                                   $1,
                                   $3,
                                   NULL,
@@ -710,11 +887,11 @@ _clause
 
 _complex_clause
     : t_constant_name SDL_K_EQUALS SDL_K_STRING t_string {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Constant,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_constant(&context,
+            SDL_CALL(sdl_constant(context,
                                   $1,
                                   0,
                                   $4,
@@ -722,11 +899,11 @@ _complex_clause
                      @$);
         }
     | t_constant_name SDL_K_EQUALS _v_expression {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Constant,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_constant(&context,
+            SDL_CALL(sdl_constant(context,
                                   $1,
                                   $3,
                                   NULL,
@@ -734,11 +911,11 @@ _complex_clause
                      @$);
         }
     | t_constant_names SDL_K_EQUALS _v_expression {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Constant,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_constant(&context,
+            SDL_CALL(sdl_constant(context,
                                   $1,
                                   $3,
                                   NULL,
@@ -754,10 +931,10 @@ _v_datatypes
 
 _v_usertypes
     : _t_id {
-            $$ = sdl_usertype_idx(&context, $1);
+            $$ = sdl_usertype_idx(context, $1);
             if ($$ == 0)
             {
-                $$ = sdl_aggrtype_idx(&context, $1);
+                $$ = sdl_aggrtype_idx(context, $1);
             }
         }
     ;
@@ -767,7 +944,7 @@ _v_basetypes
     | _v_float { $$ = $1; }
     | SDL_K_CHAR { $$ = SDL_K_TYPE_CHAR; }
     | SDL_K_CHAR SDL_K_LENGTH _v_expression _v_char_opt {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Length,
                                     $3,
                                     NULL,
@@ -818,7 +995,7 @@ _v_float
     | SDL_K_HFLOAT SDL_K_COMPLEX { $$ = SDL_K_TYPE_HFLT_C; }
     | SDL_K_DECIMAL SDL_K_PRECISION SDL_K_OPENP _v_expression SDL_K_COMMA
       _v_expression SDL_K_CLOSEP {
-            SDL_CALL(sdl_precision(&context, $4, $6), @$);
+            SDL_CALL(sdl_precision(context, $4, $6), @$);
             $$ = SDL_K_TYPE_DECIMAL;
         }
     ;
@@ -831,7 +1008,7 @@ _v_signed
 
 _v_address
     : SDL_K_ADDR _v_object {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     $2,
                                     NULL,
@@ -840,7 +1017,7 @@ _v_address
             $$ = -SDL_K_TYPE_ADDR;
         }
     | SDL_K_ADDR_L _v_object {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     $2,
                                     NULL,
@@ -849,7 +1026,7 @@ _v_address
             $$ = -SDL_K_TYPE_ADDR_L;
         }
     | SDL_K_ADDR_Q _v_object {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     $2,
                                     NULL,
@@ -858,7 +1035,7 @@ _v_address
             $$ = -SDL_K_TYPE_ADDR_Q;
         }
     | SDL_K_ADDR_HW _v_object {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     $2,
                                     NULL,
@@ -867,7 +1044,7 @@ _v_address
             $$ = -SDL_K_TYPE_ADDR_HW;
         }
     | SDL_K_HW_ADDR _v_object {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     $2,
                                     NULL,
@@ -876,7 +1053,7 @@ _v_address
             $$ = -SDL_K_TYPE_HW_ADDR;
         }
     | SDL_K_PTR _v_object {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     $2,
                                     NULL,
@@ -885,7 +1062,7 @@ _v_address
             $$ = -SDL_K_TYPE_PTR;
         }
     | SDL_K_PTR_L _v_object {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     $2,
                                     NULL,
@@ -894,7 +1071,7 @@ _v_address
             $$ = -SDL_K_TYPE_PTR_L;
         }
     | SDL_K_PTR_Q _v_object {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     $2,
                                     NULL,
@@ -903,7 +1080,7 @@ _v_address
             $$ = -SDL_K_TYPE_PTR_Q;
         }
     | SDL_K_PTR_HW _v_object {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     $2,
                                     NULL,
@@ -927,7 +1104,7 @@ _basealign
 
 basealign
     : SDL_K_BASEALIGN SDL_K_OPENP _v_expression SDL_K_CLOSEP {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     BaseAlign,
                                     pow(2, $3),
                                     NULL,
@@ -935,9 +1112,9 @@ basealign
                      @$);
         }
     | SDL_K_BASEALIGN _v_datatypes {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     BaseAlign,
-                                    sdl_sizeof(&context, $2),
+                                    sdl_sizeof(context, $2),
                                     NULL,
                                     (SDL_YYLTYPE *) &@1),
                      @$);
@@ -946,17 +1123,17 @@ basealign
 
 item
     : SDL_K_ITEM _t_id _v_datatypes {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Item,
                                           (SDL_YYLTYPE *) &@1),
                                           @$);
-            SDL_CALL(sdl_item(&context, $2, $3, (SDL_YYLTYPE *) &@2), @$);
+            SDL_CALL(sdl_item(context, $2, $3, (SDL_YYLTYPE *) &@2), @$);
         }
     ;
 
 _typedef
     : SDL_K_TYPEDEF {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Typedef,
                                     0,
                                     NULL,
@@ -967,7 +1144,7 @@ _typedef
 
 storage
     : SDL_K_COMMON {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Common,
                                     0,
                                     NULL,
@@ -975,7 +1152,7 @@ storage
                      @$);
         }
     | SDL_K_GLOBAL {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Global,
                                     0,
                                     NULL,
@@ -983,7 +1160,7 @@ storage
                      @$);
         }
     | SDL_K_BASED _t_aggr_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Based,
                                     0,
                                     $2,
@@ -991,7 +1168,7 @@ storage
                      @$);
         }
     | SDL_K_FILL {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Fill,
                                     0,
                                     NULL,
@@ -999,7 +1176,7 @@ storage
                      @$);
         }
     | SDL_KWD_ALIGN {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Align,
                                     0,
                                     NULL,
@@ -1007,7 +1184,7 @@ storage
                      @$);
         }
     | SDL_KWD_NOALIGN {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     NoAlign,
                                     0,
                                     NULL,
@@ -1019,17 +1196,17 @@ storage
 
 dimension
     : SDL_K_DIMENSION _v_expression {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Dimension,
-                                    sdl_dimension(&context, 1, $2),
+                                    sdl_dimension(context, 1, $2),
                                     NULL,
                                     (SDL_YYLTYPE *) &@2),
                      @$);
         }
     | SDL_K_DIMENSION _v_expression SDL_K_FULL _v_expression {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Dimension,
-                                    sdl_dimension(&context, $2, $4),
+                                    sdl_dimension(context, $2, $4),
                                     NULL,
                                     (SDL_YYLTYPE *) &@2),
                      @$);
@@ -1043,11 +1220,11 @@ _v_aggtypes
 
 aggregate
     : SDL_K_AGGREGATE _t_id SDL_K_STRUCTURE _v_aggtypes {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Aggregate,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_aggregate(&context,
+            SDL_CALL(sdl_aggregate(context,
                                    $2,
                                    $4,
                                    SDL_K_TYPE_STRUCT,
@@ -1055,11 +1232,11 @@ aggregate
                      @$);
        }
     | SDL_K_AGGREGATE _t_id SDL_K_UNION _v_aggtypes {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Aggregate,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_aggregate(&context,
+            SDL_CALL(sdl_aggregate(context,
                                    $2,
                                    $4,
                                    SDL_K_TYPE_UNION,
@@ -1068,27 +1245,27 @@ aggregate
        }
     | aggregate_body
     | SDL_K_END _t_aggr_id SDL_K_SEMI {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           DefinitionEnd,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_aggregate_compl(&context, $2, (SDL_YYLTYPE *) &@2),
+            SDL_CALL(sdl_aggregate_compl(context, $2, (SDL_YYLTYPE *) &@2),
                      @$);
        }
     | SDL_K_END SDL_K_SEMI {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           DefinitionEnd,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_aggregate_compl(&context, NULL, (SDL_YYLTYPE *) &@1),
+            SDL_CALL(sdl_aggregate_compl(context, NULL, (SDL_YYLTYPE *) &@1),
                      @$);
        }
     | SDL_K_END _t_id SDL_K_SEMI{
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           DefinitionEnd,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_aggregate_compl(&context, $2, (SDL_YYLTYPE *) &@2),
+            SDL_CALL(sdl_aggregate_compl(context, $2, (SDL_YYLTYPE *) &@2),
                      @$);
        }
     ;
@@ -1100,7 +1277,7 @@ _t_aggr_id
 
 aggregate_body
     : _t_aggr_id _v_datatypes {
-            SDL_CALL(sdl_aggregate_member(&context,
+            SDL_CALL(sdl_aggregate_member(context,
                                           $1,
                                           $2,
                                           SDL_K_TYPE_NONE,
@@ -1112,9 +1289,9 @@ aggregate_body
                      @$);
         }
     | _t_aggr_id _t_aggr_id {
-            SDL_CALL(sdl_aggregate_member(&context,
+            SDL_CALL(sdl_aggregate_member(context,
                                           $1,
-                                          sdl_aggrtype_idx(&context, $2),
+                                          sdl_aggrtype_idx(context, $2),
                                           SDL_K_TYPE_NONE,
                                           (SDL_YYLTYPE *) &@1,
                                           false,
@@ -1124,11 +1301,11 @@ aggregate_body
                      @$);
         }
     | _t_aggr_id SDL_K_STRUCTURE _v_aggtypes {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Subaggregate,
                                           (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_aggregate_member(&context,
+            SDL_CALL(sdl_aggregate_member(context,
                                           $1,
                                           $3,
                                           SDL_K_TYPE_STRUCT,
@@ -1140,11 +1317,11 @@ aggregate_body
                      @$);
         }
     | _t_aggr_id SDL_K_UNION _v_aggtypes {
-            SDL_CALL(sdl_state_transition(&context,
+            SDL_CALL(sdl_state_transition(context,
                                           Subaggregate,
                                           (SDL_YYLTYPE *) &@1),
                                           @$);
-            SDL_CALL(sdl_aggregate_member(&context,
+            SDL_CALL(sdl_aggregate_member(context,
                                           $1,
                                           $3,
                                           SDL_K_TYPE_UNION,
@@ -1156,7 +1333,7 @@ aggregate_body
                      @$);
         }
     | _t_aggr_id SDL_K_BITFIELD bitfield_options SDL_K_SEMI {
-            SDL_CALL(sdl_aggregate_member(&context,
+            SDL_CALL(sdl_aggregate_member(context,
                                           $1,
                                           SDL_K_TYPE_BITFLD,
                                           SDL_K_TYPE_NONE,
@@ -1176,7 +1353,7 @@ bitfield_options
 
 bitfield_choices
     : SDL_K_BYTE {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     SDL_K_TYPE_BYTE,
                                     NULL,
@@ -1184,7 +1361,7 @@ bitfield_choices
                      @$);
         }
     | SDL_K_WORD {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     SDL_K_TYPE_WORD,
                                     NULL,
@@ -1192,7 +1369,7 @@ bitfield_choices
                      @$);
         }
     | SDL_K_LONG {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     SDL_K_TYPE_LONG,
                                     NULL,
@@ -1200,7 +1377,7 @@ bitfield_choices
                      @$);
         }
     | SDL_K_QUAD {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     SubType,
                                     SDL_K_TYPE_QUAD,
                                     NULL,
@@ -1208,7 +1385,7 @@ bitfield_choices
                      @$);
         }
     | SDL_K_OCTA {
-        SDL_CALL(sdl_add_option(&context,
+        SDL_CALL(sdl_add_option(context,
                                 SubType,
                                 SDL_K_TYPE_OCTA,
                                 NULL,
@@ -1216,7 +1393,7 @@ bitfield_choices
                  @$);
         }
     | SDL_K_LENGTH _v_expression {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Length,
                                     $2,
                                     NULL,
@@ -1224,7 +1401,7 @@ bitfield_choices
                      @$);
         }
     | SDL_K_MASK {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Mask,
                                     0,
                                     NULL,
@@ -1232,7 +1409,7 @@ bitfield_choices
                      @$);
         }
     | SDL_K_SIGNED {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Signed,
                                     0,
                                     NULL,
@@ -1243,9 +1420,9 @@ bitfield_choices
 
 entry
     : SDL_K_ENTRY _t_id entry_options {
-            SDL_CALL(sdl_state_transition(&context, Entry, (SDL_YYLTYPE *) &@1),
+            SDL_CALL(sdl_state_transition(context, Entry, (SDL_YYLTYPE *) &@1),
                      @$);
-            SDL_CALL(sdl_entry(&context, $2, (SDL_YYLTYPE *) &@2), @$);
+            SDL_CALL(sdl_entry(context, $2, (SDL_YYLTYPE *) &@2), @$);
         }
     ;
 
@@ -1256,7 +1433,7 @@ entry_options
 
 entry_choices
     : SDL_K_ALIAS _t_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Alias,
                                     0,
                                     $2,
@@ -1264,7 +1441,7 @@ entry_choices
                      @$);
         }
     | SDL_K_LINKAGE _t_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Linkage,
                                     0,
                                     $2,
@@ -1272,7 +1449,7 @@ entry_choices
                      @$);
         }
     | SDL_K_VARIABLE {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Variable,
                                     0,
                                     NULL,
@@ -1280,13 +1457,13 @@ entry_choices
                      @$);
         }
     | SDL_K_RETURNS _v_datatypes _a_returns_options {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     ReturnsType,
                                     $2,
                                     NULL,
                                     (SDL_YYLTYPE *) &@2),
                      @$);
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     ReturnsNamed,
                                     0,
                                     $3,
@@ -1302,7 +1479,7 @@ parameter_desc
 
 parameter_options
     : _v_datatypes _v_passing_option parameter_choices {
-            SDL_CALL(sdl_add_parameter(&context, $1, $2, (SDL_YYLTYPE *) &@1),
+            SDL_CALL(sdl_add_parameter(context, $1, $2, (SDL_YYLTYPE *) &@1),
                      @$);
         }
     ;
@@ -1321,11 +1498,11 @@ parameter_choices
     ;
 
 parameter_loop
-    : SDL_K_IN { sdl_add_option(&context, In, 0, NULL, (SDL_YYLTYPE *) &@1); }
-    | SDL_K_OUT { sdl_add_option(&context, Out, 0, NULL, (SDL_YYLTYPE *) &@1); }
-    | _a_named { sdl_add_option(&context, Named, 0, $1, (SDL_YYLTYPE *) &@1); }
+    : SDL_K_IN { sdl_add_option(context, In, 0, NULL, (SDL_YYLTYPE *) &@1); }
+    | SDL_K_OUT { sdl_add_option(context, Out, 0, NULL, (SDL_YYLTYPE *) &@1); }
+    | _a_named { sdl_add_option(context, Named, 0, $1, (SDL_YYLTYPE *) &@1); }
     | SDL_K_DIMENSION _v_expression {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Dimension,
                                     $2,
                                     NULL,
@@ -1333,7 +1510,7 @@ parameter_loop
                      @$);
         }
     | SDL_K_DEFAULT _v_expression {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Default,
                                     $2,
                                     NULL,
@@ -1341,7 +1518,7 @@ parameter_loop
                      @$);
         }
     | SDL_K_TYPENAME _t_id {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     TypeName,
                                     0,
                                     $2,
@@ -1349,7 +1526,7 @@ parameter_loop
                      @$);
         }
     | SDL_K_OPT {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     Optional,
                                     0,
                                     NULL,
@@ -1357,7 +1534,7 @@ parameter_loop
                      @$);
         }
     | SDL_K_LIST {
-            SDL_CALL(sdl_add_option(&context,
+            SDL_CALL(sdl_add_option(context,
                                     List,
                                     0,
                                     NULL,
@@ -1377,44 +1554,50 @@ _a_named
 
 conditionals
     : SDL_K_IFLANG language_list {
-            SDL_CALL(sdl_conditional(&context,
+            SDL_CALL(sdl_conditional(context,
                                      SDL_K_COND_LANG,
-                                     sdl_get_language(&context,
+                                     sdl_get_language(context,
                                                       (SDL_YYLTYPE *) &@2),
                                      (SDL_YYLTYPE *) &@1),
                      @$);
         }
     | SDL_K_ELSE {
-            SDL_CALL(sdl_conditional(&context,
+            SDL_CALL(sdl_conditional(context,
                                      SDL_K_COND_ELSE,
                                      NULL,
                                      (SDL_YYLTYPE *) &@1),
                      @$);
+            context->lexState.skipInactive =
+                (context->processingEnabled == false);
         }
     | SDL_K_END_IFLANG language_list {
-            SDL_CALL(sdl_conditional(&context,
+            SDL_CALL(sdl_conditional(context,
                                      SDL_K_COND_END_LANG,
-                                     sdl_get_language(&context,
+                                     sdl_get_language(context,
                                                       (SDL_YYLTYPE *) &@2),
                                      (SDL_YYLTYPE *) &@1),
                      @$);
         }
     | SDL_K_IFSYMB _t_id {
-            SDL_CALL(sdl_conditional(&context,
+            SDL_CALL(sdl_conditional(context,
                                      SDL_K_COND_SYMB,
                                      $2,
                                      (SDL_YYLTYPE *) &@2),
                      @$);
+            context->lexState.skipInactive =
+                (context->processingEnabled == false);
         }
     | SDL_K_ELSE_IFSYMB _t_id {
-            SDL_CALL(sdl_conditional(&context,
+            SDL_CALL(sdl_conditional(context,
                                      SDL_K_COND_ELSEIF,
                                      $2,
                                      (SDL_YYLTYPE *) &@2),
                      @$);
+            context->lexState.skipInactive =
+                (context->processingEnabled == false);
         }
     | SDL_K_END_IFSYMB {
-            SDL_CALL(sdl_conditional(&context,
+            SDL_CALL(sdl_conditional(context,
                                      SDL_K_COND_END_SYMB,
                                      NULL,
                                      (SDL_YYLTYPE *) &@1),
@@ -1425,9 +1608,971 @@ conditionals
 language_list
     : %empty
     | language_list _t_id {
-            SDL_CALL(sdl_add_language(&context, $2, (SDL_YYLTYPE *) &@2), @$);
+            SDL_CALL(sdl_add_language(context, $2, (SDL_YYLTYPE *) &@2), @$);
         }
     ;
 
 %%    /* End Grammar rules */
 
+/*
+ * yyerror
+ *  This is the error handler to be used by Bison when a syntax error has been
+ *  detected.
+ *
+ * Input Parameters:
+ *  locp:
+ *      A pointer to a structure containing the information about the syntax
+ *      error.  Specifically, we are interested in the first line number of the
+ *      input file.
+ *  scanner:
+ *      A pointer to the Bison scanner structure.  This parameter is ignored.
+ *  context:
+ *      A pointer to the context structure, where the message vector is
+ *      maintained.
+ *  msg:
+ *      A pointer to a string containing what specifically caused the parse
+ *      error.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void yyerror(YYLTYPE *locp,
+             yyscan_t *scanner,
+             SDL_CONTEXT *context,
+             char const *msg)
+{
+    context->diagnostics++;
+    if (sdl_set_message(context->msgVec,
+                        2,
+                        SDL_SYNTAXERR,
+                        locp->first_line,
+                        SDL_PARSEERR,
+                        msg) == SDL_NORMAL)
+    {
+        char *msgText;
+
+        if (sdl_get_message(context->msgVec, &msgText) == SDL_NORMAL)
+        {
+            fprintf(context->errFP, "%s\n", msgText);
+            sdl_free(msgText);
+        }
+    }
+    return;
+}
+
+#undef yylex
+
+/*
+ * _sdl_tape_owned
+ *  This function is called to determine if the value of a token is a string
+ *  the scanner duplicated for it, which the parser may keep or free.
+ *
+ * Input Parameters:
+ *  token:
+ *      A value indicating the token.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:       The value is a duplicated string.
+ *  false:      The value is an interned string, a number or nothing.
+ */
+static bool _sdl_tape_owned(int token)
+{
+    bool retVal;
+
+    switch (token)
+    {
+        case t_hex:
+        case t_octal:
+        case t_binary:
+        case t_ascii:
+        case t_literal_string:
+        case t_line_comment:
+        case t_block_comment:
+        case t_string:
+        case t_constant_names:
+        case t_aggr_str:
+        case t_include:
+            retVal = true;
+            break;
+
+        default:
+            retVal = false;
+            break;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_tape_interned
+ *  This function is called to determine if the value of a token is a string
+ *  the scanner interned for it.
+ *
+ * Input Parameters:
+ *  token:
+ *      A value indicating the token.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:       The value is an interned string.
+ *  false:      The value is a duplicated string, a number or nothing.
+ */
+static bool _sdl_tape_interned(int token)
+{
+    bool retVal;
+
+    switch (token)
+    {
+        case t_name:
+        case t_constant_name:
+        case t_variable:
+        case t_aggr_name:
+            retVal = true;
+            break;
+
+        default:
+            retVal = false;
+            break;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_yylex
+ *  This function is called by the parser to get the next token.  When an
+ *  input file is being parsed, it is the one returned by the scanner.  When
+ *  a recording of the tokens is being parsed, it is the next one in the
+ *  recording.  If processing has just been turned off by an IFSYMBOL,
+ *  ELSE_IFSYMBOL or ELSE, the recorded tokens up to the ELSE_IFSYMBOL, ELSE
+ *  or END_IFSYMBOL that ends the inactive region are skipped, just as the
+ *  scanner skips them in an input file.  At the end of the recording of an
+ *  INCLUDE file, the parse goes on with the token after the INCLUDE, unless
+ *  the scanner stopped in the INCLUDE file, in which case the parse stops
+ *  there too.
+ *
+ * Input Parameters:
+ *  scanner:
+ *      A pointer to the scanner, which is NULL when a recording is being
+ *      parsed.
+ *  context:
+ *      A pointer to the context structure, containing the scanner state.
+ *
+ * Output Parameters:
+ *  lvalp:
+ *      A pointer to the location to receive the value of the token.
+ *  llocp:
+ *      A pointer to the location to receive the location of the token.
+ *
+ * Return Values:
+ *  0:      The end of the input has been reached.
+ *  >0:     The token.
+ */
+static int _sdl_yylex(YYSTYPE *lvalp,
+                      YYLTYPE *llocp,
+                      void *scanner,
+                      SDL_CONTEXT *context)
+{
+    SDL_LEX_STATE *lexState = &context->lexState;
+    struct _sdl_tape *tape = lexState->tape;
+    int symbDepth = 0;
+    int langDepth = 0;
+    int retVal = 0;
+    bool skip;
+
+    if (tape == NULL)
+    {
+        sdl_stats_begin(PhaseLex);
+        retVal = yylex(lvalp, llocp, scanner);
+        sdl_stats_end();
+        if (retVal != 0)
+        {
+            sdl_stats_token();
+        }
+        return(retVal);
+    }
+    skip = (lexState->skipInactive == true) &&
+           (context->processingEnabled == false);
+    lexState->skipInactive = false;
+    while (retVal == 0)
+    {
+        SDL_TAPE_TOKEN *token;
+
+        if (lexState->tapeIndex >= tape->used)
+        {
+            if (tape->parent == NULL)
+            {
+                break;
+            }
+            if (tape->status != SDL_NORMAL)
+            {
+                context->parseStatus = tape->status;
+                break;
+            }
+            lexState->tapeIndex = tape->resume;
+            lexState->tape = tape = tape->parent;
+            continue;
+        }
+        token = &tape->tokens[lexState->tapeIndex++];
+
+        /*
+         * Nested IFSYMBOLs and IFLANGUAGEs are counted, so that their ELSEs
+         * and ENDs are skipped too.
+         */
+        if (skip == true)
+        {
+            switch (token->token)
+            {
+                case SDL_K_IFSYMB:
+                    symbDepth++;
+                    break;
+
+                case SDL_K_IFLANG:
+                    langDepth++;
+                    break;
+
+                case SDL_K_END_IFLANG:
+                    if (langDepth > 0)
+                    {
+                        langDepth--;
+                    }
+                    break;
+
+                case SDL_K_ELSE:
+                    skip = (symbDepth > 0) || (langDepth > 0);
+                    break;
+
+                case SDL_K_ELSE_IFSYMB:
+                    skip = (symbDepth > 0);
+                    break;
+
+                case SDL_K_END_IFSYMB:
+                    if (symbDepth > 0)
+                    {
+                        symbDepth--;
+                    }
+                    else
+                    {
+                        skip = false;
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+        }
+        if (skip == false)
+        {
+            *llocp = token->loc;
+            if (_sdl_tape_owned(token->token) == true)
+            {
+                lvalp->tval = sdl_strdup(token->value.tval);
+                if (lvalp->tval == NULL)
+                {
+                    fprintf(context->errFP,
+                            "%%SDL-F-ABORT, Fatal internal error. Unable to "
+                            "continue execution\n-SYSTEM-E-ENOMEM, Not enough "
+                            "space\n");
+                    context->parseStatus = SDL_ABORT;
+                    break;
+                }
+            }
+            else
+            {
+                *lvalp = token->value;
+            }
+            retVal = token->token;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_parse
+ *  This function is called to run the parser, once the tokens are ready to
+ *  be read, either from a scanner or from a recording.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for this compilation.
+ *  scanner:
+ *      A pointer to the scanner, which is NULL when a recording is being
+ *      parsed.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  See sdl_parse_file.
+ */
+static uint32_t _sdl_parse(SDL_CONTEXT *context, yyscan_t scanner)
+{
+    uint32_t retVal;
+    int status;
+
+    sdl_stats_begin(PhaseParse);
+    status = yyparse(scanner, context);
+    sdl_stats_end();
+    switch (status)
+    {
+        case 0:
+            retVal = context->parseStatus;
+            break;
+
+        case 1:
+            retVal = (context->parseStatus != SDL_NORMAL) ?
+                        context->parseStatus : SDL_SYNTAXERR;
+            break;
+
+        default:
+            retVal = SDL_ABORT;
+            if (sdl_set_message(context->msgVec,
+                                2,
+                                retVal,
+                                ENOMEM) != SDL_NORMAL)
+            {
+                retVal = SDL_ERREXIT;
+            }
+            break;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_lex_reset
+ *  This function is called when the scanner has finished, to close whatever
+ *  INCLUDE files are still open, and reset the scanner state for the next
+ *  file.
+ *
+ * Input Parameters:
+ *  lexState:
+ *      A pointer to the scanner state.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_lex_reset(SDL_LEX_STATE *lexState)
+{
+    int ii;
+
+    /*
+     * If the parse was stopped in the middle of an INCLUDE file, then close
+     * whatever is left on the file list.  Then, return any saved LITERAL
+     * lines and the start state stack, and reset the scanner state for the
+     * next file.
+     */
+    while (lexState->fileList != NULL)
+    {
+        SDL_FILE_LIST *entry = lexState->fileList;
+
+        lexState->fileList = entry->previous;
+        fclose(entry->fp);
+        sdl_include_unmap(entry->map, entry->mapLength);
+        sdl_free(entry->fileName);
+        sdl_free(entry);
+    }
+    for (ii = 0; ii < lexState->litIdx; ii++)
+    {
+        sdl_free(lexState->litLines[ii]);
+    }
+    if (lexState->startState != NULL)
+    {
+        sdl_free(lexState->startState);
+    }
+    memset(lexState, 0, sizeof(SDL_LEX_STATE));
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_parse_reset
+ *  This function is called when the parser or scanner has finished, to
+ *  discard a MODULE that was not completed, close whatever INCLUDE files are
+ *  still open, and reset the scanner state for the next file.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for this compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_parse_reset(SDL_CONTEXT *context)
+{
+
+    /*
+     * If the parse was aborted in the middle of a MODULE, then discard
+     * whatever has been added to its IR.
+     */
+    if (context->ir.open == true)
+    {
+        sdl_ir_reset(context);
+    }
+    _sdl_lex_reset(&context->lexState);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_scan_init
+ *  This function is called to create a scanner for an input file, with the
+ *  context as its extra data.  If the input file can be mapped into memory,
+ *  it is scanned where it is, rather than being read.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for this compilation.
+ *  fp:
+ *      A pointer to the opened input file.
+ *
+ * Output Parameters:
+ *  scanner:
+ *      A pointer to the location to receive the scanner.
+ *  map:
+ *      A pointer to the location to receive the mapping of the input file,
+ *      or NULL if it is being read.
+ *  mapLength:
+ *      A pointer to the location to receive the length of the mapping.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred creating the scanner.
+ *  SDL_ERREXIT:    Error exit.
+ */
+static uint32_t _sdl_scan_init(SDL_CONTEXT *context,
+                               FILE *fp,
+                               yyscan_t *scanner,
+                               char **map,
+                               size_t *mapLength)
+{
+    uint32_t retVal = SDL_NORMAL;
+
+    if (context->errFP == NULL)
+    {
+        context->errFP = stderr;
+    }
+    context->parseStatus = SDL_NORMAL;
+    *map = NULL;
+    *mapLength = 0;
+    if (yylex_init_extra(context, scanner) == 0)
+    {
+        yyset_debug(context->argument[ArgVerbose].on ? 1 : 0, *scanner);
+        *map = sdl_include_map(fp, mapLength);
+        if ((*map == NULL) ||
+            (yy_scan_buffer(*map, *mapLength, *scanner) == NULL))
+        {
+            sdl_include_unmap(*map, *mapLength);
+            *map = NULL;
+            yyset_in(fp, *scanner);
+        }
+    }
+    else
+    {
+        retVal = SDL_ABORT;
+        if (sdl_set_message(context->msgVec,
+                            2,
+                            retVal,
+                            errno) != SDL_NORMAL)
+        {
+            retVal = SDL_ERREXIT;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_parse_file
+ *  This function is called to parse an input file, calling the action
+ *  routines for the context as each definition is parsed.  A scanner is
+ *  created for just this call, with the context as its extra data, so any
+ *  number of files can be parsed at the same time for different contexts.
+ *  Diagnostics are written to the context's error file, or to stderr if the
+ *  context does not have one.  If the input file can be mapped into memory,
+ *  it is scanned where it is, rather than being read.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for this compilation.
+ *  fp:
+ *      A pointer to the opened input file.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_SYNTAXERR:  The parse was stopped by a syntax error, which has already
+ *                  been reported.
+ *  SDL_BUGCHECK:   The parse was abandoned because of an internal
+ *                  consistency failure.
+ *  SDL_UNDEFFIL:   An include file could not be opened.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ */
+uint32_t sdl_parse_file(SDL_CONTEXT *context, FILE *fp)
+{
+    yyscan_t scanner;
+    char *map;
+    size_t mapLength;
+    uint32_t retVal;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_parse_file");
+
+    retVal = _sdl_scan_init(context, fp, &scanner, &map, &mapLength);
+    if (retVal == SDL_NORMAL)
+    {
+        retVal = _sdl_parse(context, scanner);
+        yylex_destroy(scanner);
+        sdl_include_unmap(map, mapLength);
+        sdl_precomp_release(context);
+    }
+    _sdl_parse_reset(context);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_tape_scan
+ *  This function is called to scan an input file into a recording of the
+ *  tokens, without parsing them.  An INCLUDE is recorded as its token, and
+ *  the file is not read.  A problem found by the scanner is kept in the
+ *  recording, to be returned once the tokens before it have been parsed.
+ *  The caller resets the scanner state afterwards.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation that needs
+ *      the recording.
+ *  fp:
+ *      A pointer to the opened input file.
+ *
+ * Output Parameters:
+ *  tape:
+ *      A pointer to the location to receive the recording.  It is to be
+ *      freed by calling sdl_tape_free.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ */
+static uint32_t _sdl_tape_scan(SDL_CONTEXT *context,
+                               FILE *fp,
+                               struct _sdl_tape **tape)
+{
+    struct _sdl_tape *newTape;
+    yyscan_t scanner;
+    YYSTYPE value;
+    YYLTYPE loc;
+    char *map;
+    size_t mapLength;
+    uint32_t retVal;
+    int token;
+
+    *tape = NULL;
+    newTape = sdl_calloc(1, sizeof(struct _sdl_tape));
+    if (newTape == NULL)
+    {
+        retVal = SDL_ABORT;
+        if (sdl_set_message(context->msgVec,
+                            2,
+                            retVal,
+                            ENOMEM) != SDL_NORMAL)
+        {
+            retVal = SDL_ERREXIT;
+        }
+        return(retVal);
+    }
+    newTape->status = SDL_NORMAL;
+    sdl_intern_init(&newTape->names);
+    retVal = _sdl_scan_init(context, fp, &scanner, &map, &mapLength);
+    if (retVal == SDL_NORMAL)
+    {
+
+        /*
+         * The locations start where the parser starts them.  The whole scan
+         * is counted as scanning.
+         */
+        sdl_stats_begin(PhaseLex);
+        loc.first_line = loc.last_line = 1;
+        loc.first_column = loc.last_column = 1;
+        token = yylex(&value, &loc, scanner);
+        while ((token != 0) && (retVal == SDL_NORMAL))
+        {
+            SDL_TAPE_TOKEN *entry;
+
+            if (newTape->used >= newTape->size)
+            {
+                SDL_TAPE_TOKEN *tokens;
+
+                tokens = sdl_realloc(newTape->tokens,
+                                     (newTape->size + SDL_K_TAPE_INCR) *
+                                        sizeof(SDL_TAPE_TOKEN));
+                if (tokens == NULL)
+                {
+                    retVal = SDL_ABORT;
+                    break;
+                }
+                newTape->tokens = tokens;
+                newTape->size += SDL_K_TAPE_INCR;
+            }
+            entry = &newTape->tokens[newTape->used++];
+            sdl_stats_token();
+            entry->token = token;
+            entry->loc = loc;
+            entry->value = value;
+            entry->include = NULL;
+            if (_sdl_tape_interned(token) == true)
+            {
+                entry->value.tval = sdl_intern(&newTape->names, value.tval);
+                if (entry->value.tval == NULL)
+                {
+                    retVal = SDL_ABORT;
+                    break;
+                }
+            }
+            else if (_sdl_tape_owned(token) == true)
+            {
+                size_t len = strlen(value.tval) + 1;
+
+                entry->value.tval = sdl_arena_alloc(&newTape->arena, len);
+                if (entry->value.tval == NULL)
+                {
+                    retVal = SDL_ABORT;
+                    break;
+                }
+                memcpy(entry->value.tval, value.tval, len);
+                sdl_free(value.tval);
+            }
+            token = yylex(&value, &loc, scanner);
+        }
+        yylex_destroy(scanner);
+        sdl_include_unmap(map, mapLength);
+        sdl_stats_end();
+
+        /*
+         * Keep whatever stopped the scanner.
+         */
+        if (retVal == SDL_NORMAL)
+        {
+            newTape->status = context->parseStatus;
+        }
+        else
+        {
+            retVal = SDL_ABORT;
+            if (sdl_set_message(context->msgVec,
+                                2,
+                                retVal,
+                                ENOMEM) != SDL_NORMAL)
+            {
+                retVal = SDL_ERREXIT;
+            }
+        }
+    }
+
+    /*
+     * If the recording was made, return it to the caller.  Otherwise, free
+     * what there is of it.
+     */
+    if (retVal == SDL_NORMAL)
+    {
+        *tape = newTape;
+    }
+    else
+    {
+        sdl_tape_free(newTape);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_tape_include
+ *  This function is called by the parser when a recording being parsed
+ *  reaches an INCLUDE with processing turned on.  The first time, the
+ *  INCLUDE file is scanned into a recording of its own, which is kept with
+ *  the INCLUDE for the parses that follow.  The parse then goes on with the
+ *  INCLUDE file's recording, and the file is added to the context's list of
+ *  INCLUDE files.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for this compilation.
+ *  fileName:
+ *      A pointer to the name of the INCLUDE file.
+ *  lineNumber:
+ *      A value indicating the line on which the INCLUDE was found.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_UNDEFFIL:   The INCLUDE file could not be opened.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ */
+static uint32_t _sdl_tape_include(SDL_CONTEXT *context,
+                                  char *fileName,
+                                  int lineNumber)
+{
+    SDL_LEX_STATE *lexState = &context->lexState;
+    SDL_TAPE_TOKEN *token = &lexState->tape->tokens[lexState->tapeIndex - 1];
+    uint32_t retVal = SDL_NORMAL;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("_sdl_tape_include");
+
+    /*
+     * The INCLUDE file is scanned with a scanner state of its own, so that
+     * the state for the recording being parsed is left as it is.
+     */
+    if (token->include == NULL)
+    {
+        FILE *fp = sdl_include_open(fileName);
+
+        if (fp == NULL)
+        {
+            retVal = SDL_UNDEFFIL;
+            if (sdl_set_message(context->msgVec,
+                                2,
+                                retVal,
+                                fileName,
+                                lineNumber,
+                                errno) != SDL_NORMAL)
+            {
+                retVal = SDL_ERREXIT;
+            }
+        }
+        else
+        {
+            SDL_LEX_STATE saved = *lexState;
+            uint32_t parseStatus = context->parseStatus;
+
+            memset(lexState, 0, sizeof(SDL_LEX_STATE));
+            retVal = _sdl_tape_scan(context, fp, &token->include);
+            _sdl_lex_reset(lexState);
+            *lexState = saved;
+            context->parseStatus = parseStatus;
+            fclose(fp);
+            if (retVal == SDL_NORMAL)
+            {
+                token->include->parent = lexState->tape;
+                token->include->resume = lexState->tapeIndex;
+            }
+        }
+    }
+    if ((retVal == SDL_NORMAL) &&
+        (sdl_include_record(&context->includes, fileName) != SDL_NORMAL))
+    {
+        retVal = SDL_ABORT;
+        if (sdl_set_message(context->msgVec,
+                            2,
+                            retVal,
+                            ENOMEM) != SDL_NORMAL)
+        {
+            retVal = SDL_ERREXIT;
+        }
+    }
+    if (retVal == SDL_NORMAL)
+    {
+        lexState->tape = token->include;
+        lexState->tapeIndex = 0;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_tape_record
+ *  This function is called to scan an input file into a recording of the
+ *  tokens, without parsing them.  The recording can then be parsed by
+ *  sdl_parse_tape any number of times, for contexts that differ in the
+ *  symbols, word size or alignment, without scanning the input file again.
+ *  An INCLUDE file is not read here, but when a parse of the recording first
+ *  reaches the INCLUDE with processing turned on, so one in an inactive
+ *  IFSYMBOL region is never read.  It is always read, rather than replayed
+ *  from its precompiled form, since its recording has to do for every
+ *  context.  A problem found by the scanner is reported here, and then
+ *  returned by sdl_parse_tape once the tokens before it have been parsed, as
+ *  it would have been by sdl_parse_file.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the first compilation that
+ *      needs the recording.
+ *  fp:
+ *      A pointer to the opened input file.
+ *
+ * Output Parameters:
+ *  tape:
+ *      A pointer to the location to receive the recording.  It is to be
+ *      freed by calling sdl_tape_free.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ */
+uint32_t sdl_tape_record(SDL_CONTEXT *context,
+                         FILE *fp,
+                         struct _sdl_tape **tape)
+{
+    uint32_t retVal;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_tape_record");
+
+    retVal = _sdl_tape_scan(context, fp, tape);
+    _sdl_parse_reset(context);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_parse_tape
+ *  This function is called to parse a recording of the tokens in an input
+ *  file, made by sdl_tape_record, calling the action routines for the
+ *  context as each definition is parsed.  The recordings of the INCLUDE
+ *  files reached are kept with the recording, so the recording can only be
+ *  parsed for one context at a time, but it can be parsed again for another
+ *  context.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for this compilation.
+ *  tape:
+ *      A pointer to the recording.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  See sdl_parse_file.
+ */
+uint32_t sdl_parse_tape(SDL_CONTEXT *context, struct _sdl_tape *tape)
+{
+    uint32_t retVal;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_parse_tape");
+
+    if (context->errFP == NULL)
+    {
+        context->errFP = stderr;
+    }
+    context->parseStatus = SDL_NORMAL;
+    context->lexState.tape = tape;
+    context->lexState.tapeIndex = 0;
+    retVal = _sdl_parse(context, NULL);
+    if (retVal == SDL_NORMAL)
+    {
+        retVal = tape->status;
+    }
+    _sdl_parse_reset(context);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_tape_free
+ *  This function is called to free a recording of the tokens in an input
+ *  file, and the recordings of the INCLUDE files in it, once it has been
+ *  parsed for every context that needs it.
+ *
+ * Input Parameters:
+ *  tape:
+ *      A pointer to the recording, which may be NULL.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_tape_free(struct _sdl_tape *tape)
+{
+    size_t ii;
+
+    if (tape != NULL)
+    {
+        for (ii = 0; ii < tape->used; ii++)
+        {
+            sdl_tape_free(tape->tokens[ii].include);
+        }
+        sdl_arena_release(&tape->arena);
+        sdl_intern_release(&tape->names);
+        if (tape->tokens != NULL)
+        {
+            sdl_free(tape->tokens);
+        }
+        sdl_free(tape);
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
@@ -30,6 +30,54 @@
  *  V01.002    10-OCT-2018    Jonathan D. Belanger
  *  Added a more complete definition of the possible data type keywords we can
  *  get from the parser.
+ *
+ *  V01.003    15-OCT-2026    Jonathan D. Belanger
+ *  DECLAREs, ITEMs, AGGREGATEs, ENUMs and local variables are now indexed in
+ *  symbol tables as they are queued, and the tables reset at END_MODULE.
+ *
+ *  V01.004    15-OCT-2026    Jonathan D. Belanger
+ *  Blocks and strings for a MODULE are carved out of the context's arena.
+ *
+ *  V01.005    15-OCT-2026    Jonathan D. Belanger
+ *  Identifiers, prefixes and tags are interned in the identifier pool, rather
+ *  than duplicated for each block that refers to them.
+ *
+ *  V01.006    15-OCT-2026    Jonathan D. Belanger
+ *  Messages are reported in the context's message vector, and the bitfield
+ *  sizing state is kept in the context rather than a static variable.
+ *
+ *  V01.007    15-OCT-2026    Jonathan D. Belanger
+ *  The language enabled vector is indexed by the plugin identifier of each
+ *  language, which need not be the order the languages were specified in.
+ *
+ *  V01.008    15-OCT-2026    Jonathan D. Belanger
+ *  The plugins are no longer called as each statement is parsed.  Instead,
+ *  each statement is added to the module IR, which is emitted to the plugins
+ *  once END_MODULE has been parsed.
+ *
+ *  V01.009    16-OCT-2026    Jonathan D. Belanger
+ *  The time spent laying out AGGREGATEs, and tearing down each MODULE once
+ *  it has been emitted, is counted for --stats.
+ *
+ *  V01.010    16-OCT-2026    Jonathan D. Belanger
+ *  Calls are recorded in the trace, rather than written to standard output.
+ *  The definitions cleaned out at END_MODULE, and the members of each
+ *  AGGREGATE, are recorded as numbers, rather than dumped as text.
+ *
+ *  V01.011    16-OCT-2026    Jonathan D. Belanger
+ *  END_MODULE no longer walks the definitions, freeing each one.  They are
+ *  all in the arena, which is released in one go, so the queues and symbol
+ *  tables are just emptied.
+ *
+ *  V01.012    16-OCT-2026    Jonathan D. Belanger
+ *  Each ENUM member has a copy of its own name.  They pointed at the name
+ *  of the CONSTANT, which is freed before the END_MODULE writes the members
+ *  out, and for a list, is the first name in it.
+ *
+ *  V01.013    16-OCT-2026    Jonathan D. Belanger
+ *  Names are interned in the context's identifier pool, and the hash saved
+ *  with an interned name is used to insert it into, and look it up in, the
+ *  symbol tables.
  */
 #include <errno.h>
 #include <stdio.h>
@@ -44,8 +92,12 @@
 #include "library/utility/opensdl_plugin_funcs.h"
 #include "library/common/opensdl_blocks.h"
 #include "library/common/opensdl_message.h"
+#include "library/common/opensdl_intern.h"
+#include "library/common/opensdl_stats.h"
+#include "library/common/opensdl_trace.h"
 #include "library/utility/opensdl_utility.h"
 #include "library/utility/opensdl_actions.h"
+#include "library/utility/opensdl_ir.h"
 #include "opensdl/opensdl_main.h"
 
 /*
@@ -111,17 +163,18 @@ static char *_defaultTag[] =
 /*
  * Local Prototypes (found at the end of this module).
  */
-static uint32_t _sdl_aggregate_callback(SDL_CONTEXT *context,
-                                        SDL_MEMBERS *member,
-                                        bool ending,
-                                        int depth);
 static SDL_DECLARE *_sdl_get_declare(SDL_DECLARE_LIST *declare, char *name);
 static SDL_ITEM *_sdl_get_item(SDL_ITEM_LIST *item, char *name);
 static char *_sdl_get_tag(SDL_CONTEXT *context,
                           char *tag,
                           int datatype,
                           bool lower);
-static SDL_CONSTANT *_sdl_create_constant(char *id,
+static char *_sdl_build_tag(SDL_CONTEXT *context,
+                            char *tag,
+                            int datatype,
+                            bool lower);
+static SDL_CONSTANT *_sdl_create_constant(SDL_CONTEXT *context,
+                                          char *id,
                                           char *prefix,
                                           char *tag,
                                           char *comment,
@@ -141,17 +194,12 @@ static SDL_ENUMERATE *_sdl_create_enum(SDL_CONTEXT *context,
                                        SDL_YYLTYPE *loc);
 static uint32_t _sdl_enum_compl(SDL_CONTEXT *context, SDL_ENUMERATE *myEnum);
 static void _sdl_reset_options(SDL_CONTEXT *context);
-static uint32_t _sdl_iterate_members(SDL_CONTEXT *context,
-                                     SDL_MEMBERS *member,
-                                     void *qhead,
-                                     int (*callback)(),
-                                     int depth,
-                                     int count);
 static void _sdl_determine_offsets(SDL_CONTEXT *context,
                                    SDL_MEMBERS *member,
                                    SDL_QUEUE *memberList,
                                    bool parentIsUnion);
-static void _sdl_fill_bitfield(SDL_QUEUE *memberList,
+static void _sdl_fill_bitfield(SDL_CONTEXT *context,
+                               SDL_QUEUE *memberList,
                                SDL_MEMBERS *member,
                                int bits,
                                int number,
@@ -216,16 +264,8 @@ uint32_t sdl_comment_line(SDL_CONTEXT *context,
         sdl_trim_str(comment, SDL_M_TRAIL);
 
         /*
-         * If tracing is turned on, write out this call (calls only, no returns).
-         */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_comment_line ([%d:%d] to [%d:%d])\n",
-                   __FILE__,
-                   __LINE__,
-                   loc->first_line, loc->first_column,
-                   loc->last_line, loc->last_column);
-        }
+         * If tracing is turned on, record this call.         */
+        SDL_TRACE_LOC("sdl_comment_line", loc);
 
         /*
          * If this comment is in an AGGREGATE or subaggregate, then store it as
@@ -246,12 +286,12 @@ uint32_t sdl_comment_line(SDL_CONTEXT *context,
         }
         else
         {
-            retVal = sdl_call_comment(context->langEnableVec,
-                                      &comment[2],  /* ignore comment token */
-                                      true,
-                                      false,
-                                      false,
-                                      false);
+            retVal = sdl_ir_comment(context,
+                                    &comment[2],    /* ignore comment token */
+                                    true,
+                                    false,
+                                    false,
+                                    false);
         }
     }
 
@@ -309,19 +349,8 @@ uint32_t sdl_comment_block(SDL_CONTEXT *context,
         sdl_trim_str(comment, SDL_M_TRAIL);
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
-         */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_comment_block ([%d:%d] to [%d:%d])\n",
-                   __FILE__,
-                   __LINE__,
-                   loc->first_line,
-                   loc->first_column,
-                   loc->last_line,
-                   loc->last_column);
-        }
+         * If tracing is turned on, record this call.         */
+        SDL_TRACE_LOC("sdl_comment_block", loc);
 
         /*
          * Loop through each line of the comment until we reach the end of the
@@ -398,12 +427,12 @@ uint32_t sdl_comment_block(SDL_CONTEXT *context,
             }
             else
             {
-                retVal = sdl_call_comment(context->langEnableVec,
-                                          ptr,
-                                          false,
-                                          start_comment,
-                                          middle_comment,
-                                          end_comment);
+                retVal = sdl_ir_comment(context,
+                                        ptr,
+                                        false,
+                                        start_comment,
+                                        middle_comment,
+                                        end_comment);
             }
 
             /*
@@ -464,18 +493,9 @@ uint32_t sdl_set_local(SDL_CONTEXT *context,
         SDL_LOCAL_VARIABLE *local = sdl_find_local(context, name);
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_set_local(", __FILE__, __LINE__);
-            printf("%s, %ld (%016lx - %4.4s)\n",
-                   name,
-                   value,
-                   value,
-                   (char *) &value);
-        }
+        SDL_TRACE1("sdl_set_local", value);
 
         /*
          * OK, if we did not find a local variable with the same name, then we
@@ -488,13 +508,28 @@ uint32_t sdl_set_local(SDL_CONTEXT *context,
             {
                 local->id = name;
                 SDL_INSQUE(&context->locals, &local->header.queue);
-                retVal = SDL_CREATED;
+                retVal = sdl_symtab_insert_hash(&context->localSymtab,
+                                                local->id,
+                                                sdl_intern_hash(local->id),
+                                                0,
+                                                local);
+                if (retVal == SDL_NORMAL)
+                {
+                    retVal = SDL_CREATED;
+                }
+                else if (sdl_set_message(context->msgVec,
+                                         2,
+                                         retVal,
+                                         ENOMEM) != SDL_NORMAL)
+                {
+                    retVal = SDL_ERREXIT;
+                }
             }
             else
             {
                 sdl_free(name);
                 retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     2,
                                     retVal,
                                     ENOMEM) != SDL_NORMAL)
@@ -553,18 +588,15 @@ uint32_t sdl_module(SDL_CONTEXT *context,
     uint32_t retVal = SDL_NORMAL;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.     */
+    SDL_TRACE_LOC("sdl_module", loc);
+
+    /*
+     * Release whatever was carved out of the arena for the previous MODULE,
+     * and carve everything for this MODULE out of it.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_module ([%d:%d] to [%d:%d])\n",
-               __FILE__,
-               __LINE__,
-               loc->first_line,
-               loc->first_column,
-               loc->last_line,
-               loc->last_column);
-    }
+    sdl_arena_release(&context->arena);
+    sdl_set_arena(&context->arena);
 
     /*
      * Save the MODULE's module-name (and the source line number for it).
@@ -577,7 +609,12 @@ uint32_t sdl_module(SDL_CONTEXT *context,
      */
     context->ident = identName;
 
-    retVal = sdl_call_module(context->langEnableVec, context);
+    /*
+     * Start the IR for this MODULE.  Nothing is written out until the
+     * END_MODULE.
+     */
+    sdl_ir_begin(context);
+    retVal = sdl_ir_add(context, IrModule, NULL);
 
     /*
      * Return the results of this call back to the caller.
@@ -617,18 +654,8 @@ uint32_t sdl_module_end(SDL_CONTEXT *context,
     int ii;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
-     */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_module_end ([%d:%d] to [%d:%d])\n",
-               __FILE__,
-               __LINE__,
-               loc->first_line,
-               loc->first_column,
-               loc->last_line,
-               loc->last_column);
-    }
+     * If tracing is turned on, record this call.     */
+    SDL_TRACE_LOC("sdl_module_end", loc);
 
     /*
      * Save the source line number for the END_MODULE.
@@ -638,7 +665,7 @@ uint32_t sdl_module_end(SDL_CONTEXT *context,
     if ((moduleName != NULL) && (strcmp(context->module, moduleName) != 0))
     {
         retVal = SDL_MATCHEND;
-        if (sdl_set_message(msgVec,
+        if (sdl_set_message(context->msgVec,
                             1,
                             retVal,
                             context->module,
@@ -649,343 +676,51 @@ uint32_t sdl_module_end(SDL_CONTEXT *context,
     }
 
     /*
-     * OK, time to write out the OpenSDL Parser's MODULE footer.
+     * OK, the IR for the MODULE is complete.  Time to write it all out,
+     * ending with the OpenSDL Parser's MODULE footer.  This needs to be done
+     * before the blocks the IR refers to are cleaned out below.
      */
     if (retVal == SDL_NORMAL)
     {
-        retVal = sdl_call_moduleEnd(context->langEnableVec, context);
-    }
-
-    /*
-     * Reset all the dimension entries.
-     */
-    for (ii = 0; ii < SDL_K_MAX_DIMENSIONS; ii++)
-    {
-        context->dimensions[ii].inUse = 0;
-    }
-
-    /*
-     * Clean out all the local variables.
-     */
-    ii = 1;
-    while(SDL_Q_EMPTY(&context->locals) == false)
-    {
-        SDL_LOCAL_VARIABLE *local;
-
-        SDL_REMQUE(&context->locals, local);
-        if (trace == true)
-        {
-            printf("--------------------------------\n");
-            if (ii == 1)
-            {
-                printf("    Local Variables:\n");
-            }
-            printf("\t%2d: name: %s\n\t    value: %ld\n",
-                   ii++,
-                   local->id,
-                   local->value);
-        }
-        sdl_deallocate_block(&local->header);
-    }
-
-    /*
-     * Clean out all the constant definitions.
-     */
-    ii = 1;
-    while(SDL_Q_EMPTY(&context->constants) == false)
-    {
-        SDL_CONSTANT *constant;
-
-        SDL_REMQUE(&context->constants, constant);
-        if (trace == true)
-        {
-            printf("--------------------------------\n");
-            if (ii == 1)
-            {
-                printf("    CONSTANTs:\n");
-            }
-            printf("\t%2d: name: %s\n\t    prefix: %s\n\t    tag: %s\n"
-                   "\t    typeName: %s\n\t    type: %s\n",
-                   ii++,
-                   constant->id,
-                   (constant->prefix == NULL ? "" : constant->prefix),
-                   (constant->tag == NULL ? "" : constant->tag),
-                   (constant->typeName == NULL ? "" : constant->typeName),
-                   (constant->type == SDL_K_CONST_STR ? "String" : "Number"));
-            if (constant->type == SDL_K_CONST_STR)
-            {
-                printf("\t    value: %s\n", constant->string);
-            }
-            else
-            {
-                printf("\t    value: %ld (%s)\n",
-                       constant->value,
-                       (constant->radix <= SDL_K_RADIX_DEC ? "Decimal" :
-                           (constant->radix == SDL_K_RADIX_OCT ? "Octal" :
-                               (constant->radix == SDL_K_RADIX_HEX ?
-                                   "Hexidecimal" : "Invalid"))));
-            }
-            if (constant->comment != NULL)
-            {
-                printf("\t    comment: %s\n", constant->comment);
-            }
-        }
-        sdl_deallocate_block(&constant->header);
-    }
-
-    /*
-     * Clean out all the enumeration definitions.
-     */
-    ii = 1;
-    while(SDL_Q_EMPTY(&context->enums.header) == false)
-    {
-        SDL_ENUMERATE *_enum;
-        SDL_ENUM_MEMBER *member;
-        int jj;
-
-        SDL_REMQUE(&context->enums.header, _enum);
-        if (trace == true)
-        {
-            printf("--------------------------------\n");
-            if (ii == 1)
-            {
-                printf("    ENUMs:\n");
-            }
-            printf("\t%2d: name: %s\n\t    prefix: %s\n\t    tag: %s\n"
-                   "\t    _typeDef: %s\n",
-                   ii++,
-                   _enum->id,
-                   (_enum->prefix == NULL ? "" : _enum->prefix),
-                   (_enum->tag == NULL ? "" : _enum->tag),
-                   (_enum->typeDef == true ? "True" : "False"));
-        }
-        jj = 1;
-        member = (SDL_ENUM_MEMBER *) _enum->members.flink;
-        while (&member->header.queue != &_enum->members)
-        {
-            if (trace == true)
-            {
-                if (jj == 1)
-                {
-                    printf("    ENUM_MEMBERs:\n");
-                }
-                printf("\t%2d: name: %s\n\t    value: %ld\n\t    valueSet: %s\n",
-                       jj++,
-                       member->id,
-                       member->value,
-                       (member->valueSet == true ? "True" : "False"));
-                if (member->comment != NULL)
-                {
-                    printf("\t    comment: %s\n", member->comment);
-                }
-            }
-            member = (SDL_ENUM_MEMBER *) member->header.queue.flink;
-        }
-        sdl_deallocate_block(&_enum->header);
-    }
-
-    /*
-     * Clean out all the declares.
-     */
-    ii = 1;
-    while (SDL_Q_EMPTY(&context->declares.header) == false)
-    {
-        SDL_DECLARE *declare;
-
-        SDL_REMQUE(&context->declares.header, declare);
-        if (trace == true)
-        {
-            printf("--------------------------------\n");
-            if (ii == 1)
-            {
-                printf("    DECLAREs:\n");
-            }
-            printf("\t%2d: name: %s\n\t    prefix: %s\n\t    tag: %s\n"
-                   "\t    typeID: %d\n\t    type: %d\n\t    size: %ld\n",
-                   ii++,
-                   declare->id,
-                   (declare->prefix != NULL ? declare->prefix : ""),
-                   (declare->tag != NULL ? declare->tag : ""),
-                   declare->typeID,
-                   declare->type,
-                   declare->size);
-        }
-        sdl_deallocate_block(&declare->header);
+        retVal = sdl_ir_end(context);
     }
-
-    /*
-     * Clean out all the items.
-     */
-    ii = 1;
-    while (SDL_Q_EMPTY(&context->items.header) == false)
+    else
     {
-        SDL_ITEM *item;
-
-        SDL_REMQUE(&context->items.header, item);
-        if (trace == true)
-        {
-            printf("--------------------------------\n");
-            if (ii == 1)
-            {
-                printf("    ITEMs:\n");
-            }
-            printf("\t%2d: name: %s\n\t    prefix: %s\n\t    tag: %s\n"
-                   "\t    typeID: %d\n\t    alignment: %d\n\t    type: %d\n"
-                   "\t    size: %ld\n\t    commonDef: %s\n"
-                   "\t    globalDef: %s\n\t    typeDef: %s\n",
-                   ii++,
-                   item->id,
-                   (item->prefix != NULL ? item->prefix : ""),
-                   (item->tag != NULL ? item->tag : ""),
-                   item->typeID,
-                   item->alignment,
-                   item->type,
-                   item->size,
-                   (item->commonDef == true ? "True" : "False"),
-                   (item->globalDef == true ? "True" : "False"),
-                   (item->typeDef == true ? "True" : "False"));
-            if (item->dimension == true)
-            {
-                printf("\t    dimension: [%ld:%ld]\n",
-                       item->lbound,
-                       item->hbound);
-            }
-        }
-        sdl_deallocate_block(&item->header);
+        sdl_ir_reset(context);
     }
 
     /*
-     * Clean out all the aggregates.
+     * Everything from here on is tearing down what was built for the MODULE.
+     * Every definition was carved out of the arena, so none of them is freed
+     * on its own.  The queues and symbol tables are emptied, and the arena
+     * is released, all at once, when the next MODULE starts.  Reset all the
+     * dimension entries.
      */
-    ii = 1;
-    while (SDL_Q_EMPTY(&context->aggregates.header) == false)
+    sdl_stats_begin(PhaseTeardown);
+    for (ii = 0; ii < SDL_K_MAX_DIMENSIONS; ii++)
     {
-        SDL_AGGREGATE *aggregate;
-
-        SDL_REMQUE(&context->aggregates.header, aggregate);
-        if (trace == true)
-        {
-            printf("--------------------------------\n");
-            if (ii == 1)
-            {
-                printf("    AGGREGATEs:\n");
-            }
-            printf("\t%2d: name: %s\n\t    structUnion: %s\n\t    prefix: %s\n"
-                   "\t    marker: %s\n\t    tag: %s\n\t    origin: %s\n"
-                   "\t    typeID: %d\n\t    alignment: %d\n\t    type: %d\n"
-                   "\t    bitOffset: %d\n\t    byteOffset: %ld\n\t    size: %ld\n"
-                   "\t    commonDef: %s\n"
-                   "\t    globalDef: %s\n\t    typeDef: %s\n\t    fill: %s\n"
-                   "\t    _unsigned: %s\n",
-                   ii++,
-                   aggregate->id,
-                   (aggregate->aggType == SDL_K_TYPE_STRUCT ? "STRUCTURE" : "UNION"),
-                   (aggregate->prefix != NULL ? aggregate->prefix : ""),
-                   (aggregate->marker != NULL ? aggregate->marker : ""),
-                   (aggregate->tag != NULL ? aggregate->tag : ""),
-                   (aggregate->origin.id != NULL ? aggregate->origin.id : ""),
-                   aggregate->typeID,
-                   aggregate->alignment,
-                   aggregate->type,
-                   aggregate->currentBitOffset,
-                   aggregate->currentOffset,
-                   aggregate->size,
-                   (aggregate->commonDef == true ? "True" : "False"),
-                   (aggregate->globalDef == true ? "True" : "False"),
-                   (aggregate->typeDef == true ? "True" : "False"),
-                   (aggregate->fill == true ? "True" : "False"),
-                   (aggregate->_unsigned == true ? "True" : "False"));
-            if (aggregate->dimension == true)
-            {
-                printf("\t    dimension: [%ld:%ld]\n",
-                       aggregate->lbound,
-                       aggregate->hbound);
-            }
-        }
-        if (SDL_Q_EMPTY(&aggregate->members) == false)
-        {
-            _sdl_iterate_members(context,
-                                 aggregate->members.flink,
-                                 &aggregate->members,
-                                 NULL,
-                                 1,
-                                 1);
-        }
-        sdl_deallocate_block(&aggregate->header);
+        context->dimensions[ii].inUse = 0;
     }
+    SDL_Q_INIT(&context->locals);
+    sdl_symtab_reset(&context->localSymtab);
+    SDL_Q_INIT(&context->constants);
+    SDL_Q_INIT(&context->enums.header);
+    sdl_symtab_reset(&context->enums.symtab);
+    SDL_Q_INIT(&context->declares.header);
+    sdl_symtab_reset(&context->declares.symtab);
+    SDL_Q_INIT(&context->items.header);
+    sdl_symtab_reset(&context->items.symtab);
+    SDL_Q_INIT(&context->aggregates.header);
+    sdl_symtab_reset(&context->aggregates.symtab);
+    SDL_Q_INIT(&context->entries);
 
     /*
-     * Clean out all the entries.
+     * Stop carving memory out of the arena.  The arena itself is released when
+     * the next MODULE starts (or the context is freed), because the parser
+     * may already have read a token past the END_MODULE, which was put in the
+     * arena.
      */
-    ii = 1;
-    while (SDL_Q_EMPTY(&context->entries) == false)
-    {
-        SDL_ENTRY *entry;
-        SDL_PARAMETER *param;
-        int jj;
-
-        SDL_REMQUE(&context->entries, entry);
-        if (trace == true)
-        {
-            printf("--------------------------------\n");
-            if (ii == 1)
-            {
-                printf("    ENTRYs:\n");
-            }
-            printf("\t%2d: name: %s\n", ii++, entry->id);
-            if (entry->alias != NULL)
-            {
-                printf("\t    alias: %s\n", entry->alias);
-            }
-            if (entry->typeName != NULL)
-            {
-                printf("\t    typeName: %s\n", entry->typeName);
-            }
-            if (entry->linkage != NULL)
-            {
-                printf("\t    linkage: %s\n", entry->linkage);
-            }
-            printf("\t    returns.type: %ld\n\t    returns._unsigned: %s\n",
-                   entry->returns.type,
-                   (entry->returns._unsigned ? "True" : "False"));
-            if (entry->returns.name != NULL)
-            {
-                printf("\t    returns.named: %s\n", entry->returns.name);
-            }
-        }
-        jj = 1;
-        param = (SDL_PARAMETER *) entry->parameters.flink;
-        while (&param->header.queue != &entry->parameters)
-        {
-            if (trace == true)
-            {
-                if (jj == 1)
-                {
-                    printf("    PARAMETERs:\n");
-                }
-                printf("\t%2d: name: %s\n\t    type: %d\n\t    typeName: %s\n"
-                       "\t    bound: %ld\n\t    defaultValue: %ld\n"
-                       "\t    defaultPresent: %s\n\t    dimension: %s\n"
-                       "\t    in: %s\n\t    out: %s\n\t    list: %s\n"
-                       "\t    optional: %s\n\t    _unsigned: %s\n",
-                       jj++,
-                       param->name,
-                       param->type,
-                       param->typeName,
-                       param->bound,
-                       param->defaultValue,
-                       (param->defaultPresent == true ? "True" : "False"),
-                       (param->dimension== true ? "True" : "False"),
-                       (param->in == true ? "True" : "False"),
-                       (param->out == true ? "True" : "False"),
-                       (param->list == true ? "True" : "False"),
-                       (param->optional == true ? "True" : "False"),
-                       (param->_unsigned == true ? "True" : "False"));
-            }
-            param = (SDL_PARAMETER *) param->header.queue.flink;
-        }
-        sdl_deallocate_block(&entry->header);
-    }
+    sdl_set_arena(NULL);
 
     /*
      * Reset the module-name and ident-string to zero length.
@@ -997,6 +732,7 @@ uint32_t sdl_module_end(SDL_CONTEXT *context,
         sdl_free(context->ident);
     }
     context->ident = NULL;
+    sdl_stats_end();
 
     /*
      * Return the results of this call back to the caller.
@@ -1058,17 +794,9 @@ uint32_t sdl_literal(SDL_CONTEXT *context,
         }
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_literal(%.*s)\n",
-                   __FILE__,
-                   __LINE__,
-                   (int) len,
-                   line);
-        }
+        SDL_TRACE1("sdl_literal", len);
 
         literalLine = sdl_allocate_block(LiteralBlock, NULL, loc);
         if (literalLine != NULL)
@@ -1079,7 +807,7 @@ uint32_t sdl_literal(SDL_CONTEXT *context,
         else
         {
             retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
+            if (sdl_set_message(context->msgVec,
                                 2,
                                 retVal,
                                 ENOMEM) != SDL_NORMAL)
@@ -1138,13 +866,9 @@ uint32_t sdl_literal_end(SDL_CONTEXT *context,
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_literal_end\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_literal_end");
 
         /*
          * Keep pulling off literal lines until there are no more.
@@ -1153,8 +877,7 @@ uint32_t sdl_literal_end(SDL_CONTEXT *context,
         {
             SDL_REMQUE(literals, literalLine);
 
-            retVal = sdl_call_literal(context->langEnableVec,
-                                      literalLine->line);
+            retVal = sdl_ir_add(context, IrLiteral, literalLine->line);
 
             /*
              * Free up all the memory we allocated for this literal line.
@@ -1210,13 +933,9 @@ uint32_t sdl_declare(SDL_CONTEXT *context,
         SDL_DECLARE *myDeclare = _sdl_get_declare(&context->declares, name);
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_declare\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_declare");
 
         /*
          * We only create, never update.
@@ -1241,11 +960,24 @@ uint32_t sdl_declare(SDL_CONTEXT *context,
                 }
                 SDL_INSQUE(&context->declares.header,
                            &myDeclare->header.queue);
+                retVal = sdl_symtab_insert_hash(&context->declares.symtab,
+                                                myDeclare->id,
+                                                sdl_intern_hash(myDeclare->id),
+                                                myDeclare->typeID,
+                                                myDeclare);
+                if ((retVal != SDL_NORMAL) &&
+                    (sdl_set_message(context->msgVec,
+                                     2,
+                                     retVal,
+                                     ENOMEM) != SDL_NORMAL))
+                {
+                    retVal = SDL_ERREXIT;
+                }
             }
             else
             {
                 retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     2,
                                     retVal,
                                     ENOMEM) != SDL_NORMAL)
@@ -1300,13 +1032,9 @@ uint32_t sdl_declare_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_declare_compl\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_declare_compl");
 
         /*
          * Go find our options
@@ -1387,13 +1115,9 @@ uint32_t sdl_item(
         SDL_ITEM    *myItem = _sdl_get_item(&context->items, name);
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_item\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_item");
 
         /*
          * If we did not find a item that had already been created, then go and
@@ -1415,12 +1139,25 @@ uint32_t sdl_item(
                 }
                 myItem->size = sdl_sizeof(context, datatype);
                 SDL_INSQUE(&context->items.header, &myItem->header.queue);
+                retVal = sdl_symtab_insert_hash(&context->items.symtab,
+                                                myItem->id,
+                                                sdl_intern_hash(myItem->id),
+                                                myItem->typeID,
+                                                myItem);
+                if ((retVal != SDL_NORMAL) &&
+                    (sdl_set_message(context->msgVec,
+                                     2,
+                                     retVal,
+                                     ENOMEM) != SDL_NORMAL))
+                {
+                    retVal = SDL_ERREXIT;
+                }
             }
         }
         else
         {
             retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
+            if (sdl_set_message(context->msgVec,
                                 2,
                                 retVal,
                                 ENOMEM) != SDL_NORMAL)
@@ -1482,13 +1219,9 @@ uint32_t sdl_item_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_item_compl\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_item_compl");
 
         /*
          * Go find our options
@@ -1573,7 +1306,7 @@ uint32_t sdl_item_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
                     if ((myAggr != NULL) && (myAggr->basedPtrName == NULL))
                     {
                         retVal = SDL_ADROBJBAS;
-                        if (sdl_set_message(msgVec,
+                        if (sdl_set_message(context->msgVec,
                                             1,
                                             retVal,
                                             myAggr->id,
@@ -1586,9 +1319,7 @@ uint32_t sdl_item_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
             }
             if (retVal == SDL_NORMAL)
             {
-                retVal = sdl_call_item(context->langEnableVec,
-                                       myItem,
-                                       context);
+                retVal = sdl_ir_add(context, IrItem, myItem);
             }
         }
     }
@@ -1642,12 +1373,9 @@ uint32_t sdl_constant(SDL_CONTEXT *context,
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_constant\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_constant");
 
         /*
          * Set up the information needed when we get around to completing the
@@ -1733,12 +1461,9 @@ uint32_t sdl_constant_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_constant_compl\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_constant_compl");
 
         /*
          * Go find our options
@@ -1825,7 +1550,8 @@ uint32_t sdl_constant_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
              */
             if ((valueStr != NULL) || (enumName == NULL))
             {
-                myConst = _sdl_create_constant(id,
+                myConst = _sdl_create_constant(context,
+                                               id,
                                                prefix,
                                                tag,
                                                NULL,
@@ -1842,7 +1568,7 @@ uint32_t sdl_constant_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
                 else
                 {
                     retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
+                    if (sdl_set_message(context->msgVec,
                                         2,
                                         retVal,
                                         ENOMEM) != SDL_NORMAL)
@@ -1869,14 +1595,22 @@ uint32_t sdl_constant_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
                                                                 &myEnum->header,
                                                                 loc);
 
+                    /*
+                     * The member gets a copy of the name, because the name
+                     * is freed below, and the member is not written out
+                     * until the END_MODULE.
+                     */
                     if (myMem != NULL)
+                    {
+                        myMem->id = sdl_strdup(id);
+                    }
+                    if ((myMem != NULL) && (myMem->id != NULL))
                     {
 
                         /*
                          * Initialize the lone enumeration member and queue it
                          * up.
                          */
-                        myMem->id = id;
                         myMem->value = value;
                         myMem->valueSet = value != 0;
                         SDL_INSQUE(&myEnum->members, &myMem->header.queue);
@@ -1886,7 +1620,7 @@ uint32_t sdl_constant_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
                         sdl_free(myEnum);
                         myEnum = NULL;
                         retVal = SDL_ABORT;
-                        if (sdl_set_message(msgVec,
+                        if (sdl_set_message(context->msgVec,
                                             2,
                                             retVal,
                                             ENOMEM) != SDL_NORMAL)
@@ -1898,7 +1632,7 @@ uint32_t sdl_constant_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
                 else
                 {
                     myEnum = NULL;
-                    if (sdl_set_message(msgVec,
+                    if (sdl_set_message(context->msgVec,
                                         2,
                                         retVal,
                                         ENOMEM) != SDL_NORMAL)
@@ -1933,7 +1667,7 @@ uint32_t sdl_constant_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
                 if (myEnum == NULL)
                 {
                     retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
+                    if (sdl_set_message(context->msgVec,
                                         2,
                                         retVal,
                                         ENOMEM) != SDL_NORMAL)
@@ -2010,7 +1744,8 @@ uint32_t sdl_constant_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
                                                datatype,
                                                sdl_all_lower(id));
                         }
-                        myConst = _sdl_create_constant(name,
+                        myConst = _sdl_create_constant(context,
+                                                       name,
                                                        prefix,
                                                        tag,
                                                        comment,
@@ -2027,7 +1762,7 @@ uint32_t sdl_constant_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
                         else
                         {
                             retVal = SDL_ABORT;
-                            if (sdl_set_message(msgVec,
+                            if (sdl_set_message(context->msgVec,
                                                 2,
                                                 retVal,
                                                 ENOMEM) != SDL_NORMAL)
@@ -2049,11 +1784,25 @@ uint32_t sdl_constant_compl(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
 
                         if (myMem != NULL)
                         {
-                            myMem->id = id;
+                            myMem->id = sdl_strdup(name);
+                        }
+                        if ((myMem != NULL) && (myMem->id != NULL))
+                        {
                             myMem->value = value;
                             myMem->valueSet = (value - prevValue) != 1;
                             SDL_INSQUE(&myEnum->members, &myMem->header.queue);
                         }
+                        else
+                        {
+                            retVal = SDL_ABORT;
+                            if (sdl_set_message(context->msgVec,
+                                                2,
+                                                retVal,
+                                                ENOMEM) != SDL_NORMAL)
+                            {
+                                retVal = SDL_ERREXIT;
+                            }
+                        }
                     }
                 }
                 if ((retVal == SDL_NORMAL) &&
@@ -2166,19 +1915,8 @@ uint32_t sdl_aggregate(SDL_CONTEXT *context,
                                                       loc);
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
-         */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_aggregate ([%d:%d] to [%d:%d])\n",
-                   __FILE__,
-                   __LINE__,
-                   loc->first_line,
-                   loc->first_column,
-                   loc->last_line,
-                   loc->last_column);
-        }
+         * If tracing is turned on, record this call.         */
+        SDL_TRACE_LOC("sdl_aggregate", loc);
 
         if (myAggr != NULL)
         {
@@ -2202,11 +1940,24 @@ uint32_t sdl_aggregate(SDL_CONTEXT *context,
             SDL_INSQUE(&context->aggregates.header, &myAggr->header.queue);
             context->currentAggr = myAggr;
             context->aggregateDepth++;
+            retVal = sdl_symtab_insert_hash(&context->aggregates.symtab,
+                                            myAggr->id,
+                                            sdl_intern_hash(myAggr->id),
+                                            myAggr->typeID,
+                                            myAggr);
+            if ((retVal != SDL_NORMAL) &&
+                (sdl_set_message(context->msgVec,
+                                 2,
+                                 retVal,
+                                 ENOMEM) != SDL_NORMAL))
+            {
+                retVal = SDL_ERREXIT;
+            }
         }
         else
         {
             retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
+            if (sdl_set_message(context->msgVec,
                                 2,
                                 retVal,
                                 ENOMEM) != SDL_NORMAL)
@@ -2284,18 +2035,8 @@ uint32_t sdl_aggregate_member(SDL_CONTEXT *context,
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no returns).
-         */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_aggregate_member ([%d:%d] to [%d:%d])\n",
-                   __FILE__,
-                   __LINE__,
-                   loc->first_line,
-                   loc->first_column,
-                   loc->last_line,
-                   loc->last_column);
-        }
+         * If tracing is turned on, record this call.         */
+        SDL_TRACE_LOC("sdl_aggregate_member", loc);
 
         /*
          * Before we go too far, there may have been one or more options
@@ -2792,7 +2533,7 @@ uint32_t sdl_aggregate_member(SDL_CONTEXT *context,
                                 if (myMember->item.length < 0)
                                 {
                                     retVal = SDL_ZEROLEN;
-                                    if (sdl_set_message(msgVec,
+                                    if (sdl_set_message(context->msgVec,
                                                         1,
                                                         retVal,
                                                         myMember->item.id,
@@ -2810,7 +2551,7 @@ uint32_t sdl_aggregate_member(SDL_CONTEXT *context,
 
                             case SDL_K_TYPE_CHAR_STAR:
                                 retVal = SDL_INVUNKLEN;
-                                if (sdl_set_message(msgVec,
+                                if (sdl_set_message(context->msgVec,
                                                     1,
                                                     retVal,
                                                     loc->first_line) != SDL_NORMAL)
@@ -2840,7 +2581,7 @@ uint32_t sdl_aggregate_member(SDL_CONTEXT *context,
                                         (lclAggr->basedPtrName == NULL))
                                     {
                                         retVal = SDL_ADROBJBAS;
-                                        if (sdl_set_message(msgVec,
+                                        if (sdl_set_message(context->msgVec,
                                                             1,
                                                             retVal,
                                                             lclAggr->id,
@@ -2915,6 +2656,7 @@ uint32_t sdl_aggregate_member(SDL_CONTEXT *context,
                 {
                     _sdl_checkAndSetOrigin(context, myMember);
                 }
+                sdl_stats_begin(PhaseLayout);
                 if (mySubAggr != NULL)
                 {
                     _sdl_determine_offsets(context,
@@ -2931,11 +2673,12 @@ uint32_t sdl_aggregate_member(SDL_CONTEXT *context,
                                            (myAggr->aggType == SDL_K_TYPE_UNION));
                     SDL_INSQUE(&myAggr->members, &myMember->header.queue);
                 }
+                sdl_stats_end();
             }
             else
             {
                 retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     2,
                                     retVal,
                                     ENOMEM) != SDL_NORMAL)
@@ -2947,7 +2690,7 @@ uint32_t sdl_aggregate_member(SDL_CONTEXT *context,
         else
         {
             retVal = SDL_INVAGGRNAM;
-            if (sdl_set_message(msgVec,
+            if (sdl_set_message(context->msgVec,
                                 1,
                                 retVal) != SDL_NORMAL)
             {
@@ -3003,19 +2746,8 @@ uint32_t sdl_aggregate_compl(SDL_CONTEXT *context, char *name, SDL_YYLTYPE *loc)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
-         */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_aggregate_compl ([%d:%d] to [%d:%d])\n",
-                   __FILE__,
-                   __LINE__,
-                   loc->first_line,
-                   loc->first_column,
-                   loc->last_line,
-                   loc->last_column);
-        }
+         * If tracing is turned on, record this call.         */
+        SDL_TRACE_LOC("sdl_aggregate_compl", loc);
 
         /*
          * If we have any options that had been processed, they are for the
@@ -3184,11 +2916,13 @@ uint32_t sdl_aggregate_compl(SDL_CONTEXT *context, char *name, SDL_YYLTYPE *loc)
              * actual size of the aggregate.
              */
             context->currentAggr = NULL;
+            sdl_stats_begin(PhaseLayout);
             myAggr->size = _sdl_aggregate_size(context, myAggr, NULL);
+            sdl_stats_end();
             if ((name != NULL) && (strcmp(myAggr->id, name) != 0))
             {
                 retVal = SDL_MATCHEND;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     1,
                                     retVal,
                                     myAggr->id,
@@ -3200,7 +2934,7 @@ uint32_t sdl_aggregate_compl(SDL_CONTEXT *context, char *name, SDL_YYLTYPE *loc)
             else if (SDL_Q_EMPTY(&myAggr->members) == true)
             {
                 retVal = SDL_NULLSTRUCT;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     1,
                                     retVal,
                                     myAggr->id,
@@ -3212,32 +2946,7 @@ uint32_t sdl_aggregate_compl(SDL_CONTEXT *context, char *name, SDL_YYLTYPE *loc)
 
             if (retVal == SDL_NORMAL)
             {
-                retVal = sdl_call_aggregate(context->langEnableVec,
-                                            myAggr,
-                                            LangAggregate,
-                                            false,
-                                            0,
-                                            context);
-            }
-            if ((retVal == SDL_NORMAL) &&
-                (SDL_Q_EMPTY(&myAggr->members) == false))
-            {
-                retVal = _sdl_iterate_members(context,
-                                              myAggr->members.flink,
-                                              &myAggr->members,
-                                              (int (*)()) &_sdl_aggregate_callback,
-                                              1,
-                                              1);
-            }
-
-            if (retVal == SDL_NORMAL)
-            {
-                retVal = sdl_call_aggregate(context->langEnableVec,
-                                            myAggr,
-                                            LangAggregate,
-                                            true,
-                                            0,
-                                            context);
+                retVal = sdl_ir_add(context, IrAggregate, myAggr);
             }
         }
 
@@ -3249,11 +2958,13 @@ uint32_t sdl_aggregate_compl(SDL_CONTEXT *context, char *name, SDL_YYLTYPE *loc)
         else
         {
             context->currentAggr = mySubAggr->parent;
+            sdl_stats_begin(PhaseLayout);
             mySubAggr->size = _sdl_aggregate_size(context, NULL, mySubAggr);
+            sdl_stats_end();
             if ((name != NULL) && (strcmp(mySubAggr->id, name) != 0))
             {
                 retVal = SDL_MATCHEND;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     1,
                                     retVal,
                                     mySubAggr->id,
@@ -3265,7 +2976,7 @@ uint32_t sdl_aggregate_compl(SDL_CONTEXT *context, char *name, SDL_YYLTYPE *loc)
             else if (SDL_Q_EMPTY(&mySubAggr->members) == true)
             {
                 retVal = SDL_NULLSTRUCT;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     1,
                                     retVal,
                                     mySubAggr->id,
@@ -3321,13 +3032,9 @@ uint32_t sdl_entry(SDL_CONTEXT *context, char *name, SDL_YYLTYPE *loc)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_entry\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_entry");
 
         if (myEntry != NULL)
         {
@@ -3384,15 +3091,13 @@ uint32_t sdl_entry(SDL_CONTEXT *context, char *name, SDL_YYLTYPE *loc)
 
             if (retVal == SDL_NORMAL)
             {
-                retVal = sdl_call_entry(context->langEnableVec,
-                                        myEntry,
-                                        context);
+                retVal = sdl_ir_add(context, IrEntry, myEntry);
             }
         }
         else
         {
             retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
+            if (sdl_set_message(context->msgVec,
                                 2,
                                 retVal,
                                 ENOMEM) != SDL_NORMAL)
@@ -3456,13 +3161,9 @@ uint32_t sdl_add_parameter(
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_add_parameter\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_add_parameter");
 
         /*
          * If the stack is full, reallocate a larger stack.
@@ -3543,7 +3244,7 @@ uint32_t sdl_add_parameter(
         else
         {
             retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
+            if (sdl_set_message(context->msgVec,
                                 2,
                                 retVal,
                                 ENOMEM) != SDL_NORMAL)
@@ -3620,6 +3321,7 @@ uint32_t sdl_conditional(
         SDL_YYLTYPE *loc)
 {
     SDL_ARGUMENTS *args = context->argument;
+    SDL_LANGUAGES *languages = args[ArgLanguage].languages;
     char *symbol = (char *) expr;
     SDL_LANGUAGE_LIST *langs = (SDL_LANGUAGE_LIST *) expr;
     uint32_t retVal = SDL_NORMAL;
@@ -3627,12 +3329,9 @@ uint32_t sdl_conditional(
     bool done = false;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_conditional\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_conditional");
 
     /*
      * Perform the processing based on the conditional provided.
@@ -3690,7 +3389,7 @@ uint32_t sdl_conditional(
                 if (done == false)
                 {
                     retVal = SDL_SYMNOTDEF;
-                    if (sdl_set_message(msgVec,
+                    if (sdl_set_message(context->msgVec,
                                         1,
                                         retVal,
                                         symbol,
@@ -3701,7 +3400,7 @@ uint32_t sdl_conditional(
             else
             {
                 retVal = SDL_INVCONDST;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     1,
                                     retVal,
                                     loc->first_line) != SDL_NORMAL)
@@ -3750,16 +3449,17 @@ uint32_t sdl_conditional(
                      */
                     for (ii = 0; ii < context->languagesSpecified; ii++)
                     {
-                        context->langEnableVec[ii] = false;
+                        context->langEnableVec[languages[ii].langVal] = false;
                     }
                     for (ii = 0; ii < langs->listUsed; ii++)
                     {
                         for (jj = 0; jj < context->languagesSpecified; jj++)
                         {
                             if (strcasecmp(langs->lang[ii],
-                                           args[ArgLanguage].languages[jj].langStr) == 0)
+                                           languages[jj].langStr) == 0)
                             {
-                                context->langEnableVec[jj] = true;
+                                context->langEnableVec[languages[jj].langVal] =
+                                    true;
                             }
                         }
                     }
@@ -3767,7 +3467,7 @@ uint32_t sdl_conditional(
                 else
                 {
                     retVal = SDL_INVCONDST;
-                    if (sdl_set_message(msgVec,
+                    if (sdl_set_message(context->msgVec,
                                         1,
                                         retVal,
                                         loc->first_line) != SDL_NORMAL)
@@ -3827,7 +3527,7 @@ uint32_t sdl_conditional(
             else
             {
                 retVal = SDL_INVCONDST;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     1,
                                     retVal,
                                     loc->first_line) != SDL_NORMAL)
@@ -3858,13 +3558,15 @@ uint32_t sdl_conditional(
 
                 for (ii = 0; ii < context->languagesSpecified; ii++)
                 {
-                    if (context->langEnableVec[ii] == true)
+                    int langId = languages[ii].langVal;
+
+                    if (context->langEnableVec[langId] == true)
                     {
-                        context->langEnableVec[ii] = false;
+                        context->langEnableVec[langId] = false;
                     }
                     else
                     {
-                        context->langEnableVec[ii] = true;
+                        context->langEnableVec[langId] = true;
                     }
                 }
             }
@@ -3878,7 +3580,7 @@ uint32_t sdl_conditional(
             else if (context->processingEnabled == true)
             {
                 retVal = SDL_INVCONDST;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     1,
                                     retVal,
                                     loc->first_line) != SDL_NORMAL)
@@ -3911,7 +3613,7 @@ uint32_t sdl_conditional(
             else
             {
                 retVal = SDL_INVCONDST;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     1,
                                     retVal,
                                     loc->first_line) != SDL_NORMAL)
@@ -3947,13 +3649,13 @@ uint32_t sdl_conditional(
                     SDL_POP_COND_STATE(context);
                     for (ii = 0; ii < context->languagesSpecified; ii++)
                     {
-                        context->langEnableVec[ii] = true;
+                        context->langEnableVec[languages[ii].langVal] = true;
                     }
                 }
                 else
                 {
                     retVal = SDL_INVCONDST;
-                    if (sdl_set_message(msgVec,
+                    if (sdl_set_message(context->msgVec,
                                         1,
                                         retVal,
                                         loc->first_line) != SDL_NORMAL)
@@ -3970,7 +3672,7 @@ uint32_t sdl_conditional(
 
         default:
             retVal = SDL_INVCONDST;
-            if (sdl_set_message(msgVec,
+            if (sdl_set_message(context->msgVec,
                                 1,
                                 retVal,
                                 loc->first_line) != SDL_NORMAL)
@@ -4023,13 +3725,9 @@ uint32_t sdl_add_language(SDL_CONTEXT *context, char *langStr, SDL_YYLTYPE *loc)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_add_language\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_add_language");
 
         if (langStr != NULL)
         {
@@ -4046,7 +3744,7 @@ uint32_t sdl_add_language(SDL_CONTEXT *context, char *langStr, SDL_YYLTYPE *loc)
             else
             {
                 retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     2,
                                     retVal,
                                     ENOMEM) != SDL_NORMAL)
@@ -4058,7 +3756,7 @@ uint32_t sdl_add_language(SDL_CONTEXT *context, char *langStr, SDL_YYLTYPE *loc)
         else
         {
             retVal = SDL_ABORT;
-            if (sdl_set_message(msgVec,
+            if (sdl_set_message(context->msgVec,
                                 1,
                                 retVal) != SDL_NORMAL)
             {
@@ -4106,13 +3804,9 @@ void *sdl_get_language(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_get_language\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_get_language");
 
         if (context->langCondList.listUsed > 0)
         {
@@ -4130,77 +3824,6 @@ void *sdl_get_language(SDL_CONTEXT *context, SDL_YYLTYPE *loc)
 /* Local Functions                            */
 /************************************************************************/
 
-/*
- * _sdl_aggregate_callback
- *  This function is called to iterate through each of the languages for a
- *  particular member of an AGGREGATE.
- *
- * Input Parameters:
- *  context:
- *    A pointer to the context structure where we maintain information about
- *    the current state of the parsing.
- *  member:
- *    A pointer to the member item needing to be written out.
- *  ending:
- *      A boolean value indicating that we are ending a subaggregate.
- *  depth:
- *    A value indicating the depth of the member.
- *
- * Output Parameters:
- *  None.
- *
- * Return Values:
- *  SDL_NORMAL:     Normal Successful Completion.
- *  SDL_ABORT:      An unexpected  error occurred.
- *  SDL_ERREXIT:    Error exit.
- */
-static uint32_t _sdl_aggregate_callback(
-            SDL_CONTEXT *context,
-            SDL_MEMBERS *member,
-            bool ending,
-            int depth)
-{
-    void *param;
-    SDL_LANG_AGGR_TYPE type;
-    uint32_t retVal = SDL_NORMAL;
-
-    /*
-     * If tracing is turned on, write out this call (calls only, no returns).
-     */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_aggregate_callback\n", __FILE__, __LINE__);
-    }
-
-    if (sdl_isItem(member) == false)
-    {
-        param = (void *) &member->subaggr;
-        type = LangSubaggregate;
-    }
-    else if (sdl_isComment(member) == true)
-    {
-        param = (void *) &member->comment;
-        type = LangComment;
-    }
-    else
-    {
-        param = (void *) &member->item;
-        type = LangItem;
-    }
-
-    retVal = sdl_call_aggregate(context->langEnableVec,
-                                 param,
-                                 type,
-                                 ending,
-                                 depth,
-                                 context);
-
-    /*
-     * Return the results of this call back to the caller.
-     */
-    return (retVal);
-}
-
 /*
  * _sdl_get_declare
  *  This function is called to get the record of a previously defined local
@@ -4223,27 +3846,16 @@ static uint32_t _sdl_aggregate_callback(
  */
 static SDL_DECLARE *_sdl_get_declare(SDL_DECLARE_LIST *declare, char *name)
 {
-    SDL_DECLARE *retVal = (SDL_DECLARE *) declare->header.flink;
+    SDL_DECLARE *retVal;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_get_declare\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_get_declare");
 
-    while (retVal != (SDL_DECLARE *) &declare->header)
-    {
-        if (strcmp(retVal->id, name) == 0)
-            break;
-        else
-            retVal = (SDL_DECLARE *) retVal->header.queue.flink;
-    }
-    if (retVal == (SDL_DECLARE *) &declare->header)
-    {
-        retVal = NULL;
-    }
+    retVal = (SDL_DECLARE *) sdl_symtab_lookup_hash(&declare->symtab,
+                                                    name,
+                                                    sdl_intern_hash(name));
 
     /*
      * Return the results of this call back to the caller.
@@ -4272,27 +3884,16 @@ static SDL_DECLARE *_sdl_get_declare(SDL_DECLARE_LIST *declare, char *name)
  */
 static SDL_ITEM *_sdl_get_item(SDL_ITEM_LIST *item, char *name)
 {
-    SDL_ITEM    *retVal = (SDL_ITEM *) item->header.flink;
+    SDL_ITEM    *retVal;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_get_item\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_get_item");
 
-    while (retVal != (SDL_ITEM *) &item->header)
-    {
-        if (strcmp(retVal->id, name) == 0)
-            break;
-        else
-            retVal = (SDL_ITEM *) retVal->header.queue.flink;
-    }
-    if (retVal == (SDL_ITEM *) &item->header)
-    {
-        retVal = NULL;
-    }
+    retVal = (SDL_ITEM *) sdl_symtab_lookup_hash(&item->symtab,
+                                                 name,
+                                                 sdl_intern_hash(name));
 
     /*
      * Return the results of this call back to the caller.
@@ -4303,7 +3904,58 @@ static SDL_ITEM *_sdl_get_item(SDL_ITEM_LIST *item, char *name)
 /*
  * _sdl_get_tag
  *  This function is used to determine the tag that should be used for a
- *  particular definition.  The user can specify a tag, which will be used
+ *  particular definition.  The tag is built by _sdl_build_tag and then
+ *  interned, so that every definition with the same tag shares one string.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current state of the parsing.
+ *  tag:
+ *    A pointer to a string containing the user specified tag (or NULL).
+ *  datatype:
+ *    An integer indicating either a base type or a user type.
+ *  lower:
+ *    A boolean value to indicate that the defaulted tag should be lower
+ *    case.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  A pointer to the interned user specified tag or default tag.
+ */
+static char *_sdl_get_tag(
+        SDL_CONTEXT *context,
+        char *tag,
+        int datatype,
+        bool lower)
+{
+    char *retVal = NULL;
+    char *myTag;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("_sdl_get_tag");
+
+    myTag = _sdl_build_tag(context, tag, datatype, lower);
+    if (myTag != NULL)
+    {
+        retVal = sdl_intern(&context->names, myTag);
+        sdl_free(myTag);
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_build_tag
+ *  This function is used by _sdl_get_tag to determine the tag that should be
+ *  used for a particular definition.  The user can specify a tag, which will be used
  *  instead of the default.  If one is not specified, then we need to determine
  *  what default tag should be used.  This is not necessarily as
  *  straightforward as you'd think.  Because a definition can be based off of a
@@ -4328,9 +3980,10 @@ static SDL_ITEM *_sdl_get_item(SDL_ITEM_LIST *item, char *name)
  *  None.
  *
  * Return Values:
- *  A pointer to a user specified tag or a default tag.
+ *  A pointer to a copy of the user specified tag or a default tag.  The copy
+ *  is modified in place, so it is never an interned string.
  */
-static char *_sdl_get_tag(
+static char *_sdl_build_tag(
         SDL_CONTEXT *context,
         char *tag,
         int datatype,
@@ -4339,12 +3992,9 @@ static char *_sdl_get_tag(
     char *retVal = tag;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_get_tag\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_build_tag");
 
     /*
      * If the user specified one, then we are done here.
@@ -4388,7 +4038,7 @@ static char *_sdl_get_tag(
                     }
                     else
                     {
-                        retVal = _sdl_get_tag(context,
+                        retVal = _sdl_build_tag(context,
                                               tag,
                                               myDeclare->typeID,
                                               lower);
@@ -4412,7 +4062,7 @@ static char *_sdl_get_tag(
                     }
                     else
                     {
-                        retVal = _sdl_get_tag(context,
+                        retVal = _sdl_build_tag(context,
                                               tag,
                                               myItem->typeID,
                                               lower);
@@ -4438,7 +4088,7 @@ static char *_sdl_get_tag(
                     }
                     else
                     {
-                        retVal = _sdl_get_tag(context,
+                        retVal = _sdl_build_tag(context,
                                               tag,
                                               myAggregate->typeID,
                                               lower);
@@ -4462,10 +4112,17 @@ static char *_sdl_get_tag(
     }
     else
     {
-        size_t len = strlen(retVal);
+        size_t len;
         size_t ii;
         _Bool done = false;
 
+        /*
+         * The user specified tag may be an interned string, so we trim a copy
+         * of it.
+         */
+        retVal = sdl_strdup(tag);
+        len = strlen(retVal);
+
         /*
          * Start at the end of the tag string and if the last character is an
          * underscore, then change it to a null character.  Then check the next
@@ -4497,6 +4154,8 @@ static char *_sdl_get_tag(
  *  the caller.
  *
  * Input Parameters:
+ *  context:
+ *    A pointer to the context structure, with the identifier pool.
  *  id:
  *      A pointer to the constant identifier string.
  *  prefix:
@@ -4528,6 +4187,7 @@ static char *_sdl_get_tag(
  *  !NULL:          Normal Successful Completion.
  */
 static SDL_CONSTANT *_sdl_create_constant(
+        SDL_CONTEXT *context,
         char *id,
         char *prefix,
         char *tag,
@@ -4542,28 +4202,25 @@ static SDL_CONSTANT *_sdl_create_constant(
     SDL_CONSTANT *retVal = sdl_allocate_block(ConstantBlock, NULL, loc);
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_create_constant\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_create_constant");
 
     /*
      * Initialize the constant information.
      */
     if (retVal != NULL)
     {
-        retVal->id = sdl_strdup(id);
+        retVal->id = sdl_intern(&context->names, id);
         if (prefix != NULL)
         {
-            retVal->prefix = sdl_strdup(prefix);
+            retVal->prefix = sdl_intern(&context->names, prefix);
         }
         else
         {
             retVal->prefix = NULL;
         }
-        retVal->tag = sdl_strdup(tag);
+        retVal->tag = sdl_intern(&context->names, tag);
         if (comment != NULL)
         {
             retVal->comment = sdl_strdup(comment);
@@ -4574,7 +4231,7 @@ static SDL_CONSTANT *_sdl_create_constant(
         }
         if (typeName != NULL)
         {
-            retVal->typeName = sdl_strdup(typeName);
+            retVal->typeName = sdl_intern(&context->names, typeName);
         }
         else
         {
@@ -4626,21 +4283,16 @@ static uint32_t _sdl_queue_constant(
     uint32_t retVal = SDL_NORMAL;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_queue_constant\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_queue_constant");
 
     /*
      * Queue up the constant for later searches.
      */
     SDL_INSQUE(&context->constants, &myConst->header.queue);
 
-    retVal = sdl_call_constant(context->langEnableVec,
-                               myConst,
-                               context);
+    retVal = sdl_ir_add(context, IrConstant, myConst);
 
     /*
      * Return the results back to the caller.
@@ -4690,30 +4342,41 @@ static SDL_ENUMERATE *_sdl_create_enum(
                                                loc);
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_create_enum\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_create_enum");
 
     if (retVal != NULL)
     {
         SDL_Q_INIT(&retVal->members);
-        retVal->id = sdl_strdup(id);
+        retVal->id = sdl_intern(&context->names, id);
         if (prefix != NULL)
         {
-            retVal->prefix = sdl_strdup(prefix);
+            retVal->prefix = sdl_intern(&context->names, prefix);
         }
         else
         {
             retVal->prefix = NULL;
         }
-        retVal->tag = sdl_strdup(tag);
+        retVal->tag = sdl_intern(&context->names, tag);
         retVal->typeDef = typeDef;
         retVal->size = sdl_sizeof(context, SDL_K_TYPE_ENUM);
         retVal->typeID = context->enums.nextID++;
         SDL_INSQUE(&context->enums.header, &retVal->header.queue);
+
+        /*
+         * If we cannot index the ENUM, then let the caller report the memory
+         * allocation failure.  The block is already queued, so it will be
+         * cleaned up at the END_MODULE.
+         */
+        if (sdl_symtab_insert_hash(&context->enums.symtab,
+                                   retVal->id,
+                                   sdl_intern_hash(retVal->id),
+                                   retVal->typeID,
+                                   retVal) != SDL_NORMAL)
+        {
+            retVal = NULL;
+        }
     }
 
     /*
@@ -4746,16 +4409,11 @@ static uint32_t _sdl_enum_compl(SDL_CONTEXT *context, SDL_ENUMERATE *myEnum)
     uint32_t retVal = SDL_NORMAL;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_enum_compl\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_enum_compl");
 
-    retVal = sdl_call_enumerate(context->langEnableVec,
-                                myEnum,
-                                context);
+    retVal = sdl_ir_add(context, IrEnumerate, myEnum);
 
     /*
      * Return the results back to the caller.
@@ -4784,12 +4442,9 @@ static void _sdl_reset_options(SDL_CONTEXT *context)
     int    ii;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_reset_options\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_reset_options");
 
     /*
      * Loop through each of the options, and if we have a string option and it
@@ -4825,191 +4480,6 @@ static void _sdl_reset_options(SDL_CONTEXT *context)
     return;
 }
 
-/*
- * _sdl_iterate_members
- *  This function is called to iterate through each of the members and if that
- *  member is a subaggregate, call itself to iterate through that level.  If
- *  callback is a NULL, then we are just cleaning up the member tree.
- *
- * Input Parameters:
- *  context:
- *    A pointer to the context structure where we maintain information about
- *    the current state of the parsing.
- *  member:
- *    A pointer to the current member are are iterating through.
- *  qhead:
- *    The address of the queue header.  Used to determine when we have
- *    search through each of the member entries in the AGGREGATE or
- *    subaggregate.
- *  callback:
- *    A pointer to the entry point to call to do something with the member
- *    information.  If this is NULL, then we are just deallocating all the
- *    member memory.  If tracing is turned on, we will display the records
- *    as we iterate through.
- *  depth:
- *    A value indicating the aggregate depth we are currently iterating.
- *  count
- *    A value indicating the number of members at the current depth.
- *
- * Output Parameters:
- *  None.
- *
- * Return Values:
- *  SDL_NORMAL:        Normal Successful Completion.
- *  SDL_ABORT:        An unexpected  error occurred.
- *  SDL_ERREXIT:    Error exit.
- */
-static uint32_t _sdl_iterate_members(
-        SDL_CONTEXT *context,
-        SDL_MEMBERS *member,
-        void *qhead,
-        int (*callback)(),
-        int depth,
-        int count)
-{
-    uint32_t    retVal = SDL_NORMAL;
-
-    /*
-     * If tracing is turned on, write out this call (calls only, no returns).
-     */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_iterate_members\n", __FILE__, __LINE__);
-    }
-
-    if (sdl_isItem(member) == false)
-    {
-        SDL_SUBAGGR *subaggr = &member->subaggr;
-
-        if ((trace == true) && (callback == NULL))
-        {
-            printf("\t%d: SUBAGGREGATE:\n\t    name: %s\n\t    prefix: %s\n"
-                   "\t    tag: %s\n\t    marker: %s\n\t    arrgType: %s\n"
-                   "\t    typeID: %d\n\t    alignment: %d\n\t    type: %d\n"
-                   "\t    _unsigned: %s\n\t    size: %ld\n\t    offset: %ld (%ld)\n"
-                   "\t    typeDef: %s\n\t    fill: %s\n\t    basedPtrName: %s\n"
-                   "\t    currentBitOffset: %d\n",
-                   count,
-                   subaggr->id,
-                   (subaggr->prefix != NULL ? subaggr->prefix : ""),
-                   (subaggr->tag != NULL ? subaggr->tag : ""),
-                   (subaggr->marker != NULL ? subaggr->marker : ""),
-                   (subaggr->aggType == SDL_K_TYPE_STRUCT ? "STRUCTURE" : "UNION"),
-                   subaggr->typeID,
-                   subaggr->alignment,
-                   subaggr->type,
-                   (subaggr->_unsigned == true ? "True" : "False"),
-                   subaggr->size,
-                   subaggr->offset, member->offset,
-                   (subaggr->typeDef == true ? "True" : "False"),
-                   (subaggr->fill == true ? "True" : "False"),
-                   (subaggr->basedPtrName!= NULL ? subaggr->basedPtrName: ""),
-                   subaggr->currentBitOffset);
-                if (subaggr->dimension == true)
-                {
-                    printf("\t    dimension[%ld:%ld]\n",
-                           subaggr->lbound,
-                           subaggr->hbound);
-                }
-        }
-        if (callback != NULL)
-        {
-            (*callback)(context, member, false, depth);
-        }
-        if (SDL_Q_EMPTY(&subaggr->members) == false)
-        {
-            retVal = _sdl_iterate_members(context,
-                                          (SDL_MEMBERS *) subaggr->members.flink,
-                                          &subaggr->members,
-                                          callback,
-                                          depth + 1,
-                                          1);
-        }
-        if (callback != NULL)
-        {
-            (*callback)(context, member, true, depth);
-        }
-        if (member->header.queue.flink != qhead)
-        {
-            retVal = _sdl_iterate_members(context,
-                                          member->header.queue.flink,
-                                          qhead,
-                                          callback,
-                                          depth,
-                                          count + 1);
-        }
-    }
-    else    /* Unknown */
-    {
-    if ((trace == true) && (callback == NULL))
-    {
-        if (sdl_isComment(member) == true)
-        {
-        printf(
-            "\t%d: COMMENT:\n\t    comment: %s\n\t    endComment: %s\n"
-            "\t    lineComment: %s\n\t    middleComment: %s\n"
-            "\t    startComment: %s\n",
-            count,
-            member->comment.comment,
-            (member->comment.endComment == true ? "True" : "False"),
-            (member->comment.lineComment == true ? "True" : "False"),
-            (member->comment.middleComment == true ? "True" : "False"),
-            (member->comment.startComment == true ? "True" : "False"));
-        }
-        else
-        {
-            printf("\t%d: ITEM:\n\t    name: %s\n\t    prefix: %s\n"
-                   "\t    tag: %s\n\t    typeID: %d\n\t    alignment: %d\n"
-                   "\t    type: %d\n\t    _unsigned: %s\n\t    size: %ld\n"
-                   "\t    typeDef: %s\n\t    fill: %s\n"
-                   "\t    offset: %ld (%ld)\n\t    length: %ld\n"
-                   "\t    mask: %s\n\t    bitfieldType: %ld\n"
-                   "\t    bitOffset: %d\n",
-                   count,
-                   member->item.id,
-                   (member->item.prefix != NULL ? member->item.prefix : ""),
-                   (member->item.tag != NULL ? member->item.tag : ""),
-                   member->item.typeID,
-                   member->item.alignment,
-                   member->item.type,
-                   (member->item._unsigned == true ? "True" : "False"),
-                   member->item.size,
-                   (member->item.typeDef == true ? "True" : "False"),
-                   (member->item.fill == true ? "True" : "False"),
-                   member->item.offset, member->offset,
-                   member->item.length,
-                   (member->item.mask == true ? "True" : "False"),
-                   member->item.subType,
-                   member->item.bitOffset);
-                if (member->item.dimension == true)
-                {
-                    printf("\t    dimension: [%ld:%ld]\n",
-                           member->item.lbound,
-                           member->item.hbound);
-                }
-            }
-        }
-        if (callback != NULL)
-        {
-            (*callback)(context, member, false, depth);
-        }
-        if (member->header.queue.flink != qhead)
-        {
-            retVal = _sdl_iterate_members(context,
-                                          member->header.queue.flink,
-                                          qhead,
-                                          callback,
-                                          depth,
-                                          count + 1);
-        }
-    }
-
-    /*
-     * Return the results back to the caller.
-     */
-    return(retVal);
-}
-
 /*
  * _sdl_determine_offsets
  *   This function is called to determine the offsets (byte and bit) for the
@@ -5050,12 +4520,9 @@ static void _sdl_determine_offsets(
     bool prevItem = false;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_determine_offsets\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_determine_offsets");
 
     /*
      * If the member to be inserted is a COMMENT, then there is nothing else we
@@ -5293,7 +4760,8 @@ static void _sdl_determine_offsets(
                     member->offset = prevMember->offset + prevMember->item.size;
                     if ((availBits > 0) && (parentIsUnion == false))
                     {
-                        _sdl_fill_bitfield(memberList,
+                        _sdl_fill_bitfield(context,
+                                           memberList,
                                            prevMember,
                                            availBits,
                                            context->fillerCount++,
@@ -5307,7 +4775,8 @@ static void _sdl_determine_offsets(
                 member->offset = prevMember->offset + prevMember->item.size;
                 if ((availBits > 0) && (parentIsUnion == false))
                 {
-                    _sdl_fill_bitfield(memberList,
+                    _sdl_fill_bitfield(context,
+                                       memberList,
                                        prevMember,
                                        availBits,
                                        context->fillerCount++,
@@ -5338,6 +4807,7 @@ static void _sdl_determine_offsets(
             if ((availBits > 0) && (parentIsUnion == false))
             {
                 _sdl_fill_bitfield(
+                        context,
                         memberList,
                         prevMember,
                         availBits,
@@ -5480,6 +4950,8 @@ static void _sdl_determine_offsets(
  *  member to fill out the remaining bits in a bitfield.
  *
  * Input Parameters:
+ *  context:
+ *    A pointer to the context structure, with the identifier pool.
  *  memberList:
  *    A pointer to the queue where the new member will be added.
  *  member:
@@ -5497,6 +4969,7 @@ static void _sdl_determine_offsets(
  *  None.
  */
 static void _sdl_fill_bitfield(
+            SDL_CONTEXT *context,
             SDL_QUEUE *memberList,
             SDL_MEMBERS *member,
             int bits,
@@ -5509,21 +4982,19 @@ static void _sdl_fill_bitfield(
     char    idBuf[32];
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_fill_bitfield\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_fill_bitfield");
 
     memcpy(filler, member, sizeof(SDL_MEMBERS));
     sprintf(idBuf, "filler_%03d", number);
-    filler->item.id = sdl_strdup(idBuf);
+    filler->item.id = sdl_intern(&context->names, idBuf);
     if (member->item.prefix != NULL)
     {
-        filler->item.prefix = sdl_strdup(member->item.prefix);
+        filler->item.prefix = sdl_intern(&context->names,
+                                         member->item.prefix);
     }
-    filler->item.tag = sdl_strdup(member->item.tag);
+    filler->item.tag = sdl_intern(&context->names, member->item.tag);
     filler->item.length = bits;
     filler->item.mask = false;
     filler->item.bitOffset = member->item.bitOffset + 1;
@@ -5576,12 +5047,9 @@ static int64_t _sdl_aggregate_size(
     bool isUnion;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_aggregate_size\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_aggregate_size");
 
     /*
      * Get the last member for either the AGGREGATE or subaggregate.  If we
@@ -5713,7 +5181,8 @@ static int64_t _sdl_aggregate_size(
 
         if (availBits > 0)
         {
-            _sdl_fill_bitfield(memberList,
+            _sdl_fill_bitfield(context,
+                               memberList,
                                member,
                                availBits,
                                context->fillerCount++,
@@ -5838,10 +5307,11 @@ static int64_t _sdl_aggregate_size(
                     filler->item.alignment = alignment;
                     filler->item.parentAlignment = true;
                     sprintf(idBuf, "filler_%03d", context->fillerCount++);
-                    filler->item.id = sdl_strdup(idBuf);
+                    filler->item.id = sdl_intern(&context->names, idBuf);
                     if (prefix != NULL)
                     {
-                        filler->item.prefix = sdl_strdup(prefix);
+                        filler->item.prefix = sdl_intern(&context->names,
+                                                         prefix);
                     }
                     filler->item.tag = _sdl_get_tag(context,
                                                     NULL,
@@ -5918,7 +5388,8 @@ static int64_t _sdl_aggregate_size(
     /*
      * Create the constant for the size of the AGGREGATE/subaggregate.
      */
-    constDef = _sdl_create_constant(name,
+    constDef = _sdl_create_constant(context,
+                                    name,
                                     (prefix == NULL ? "" : prefix),
                                     (sdl_all_lower(name) ? "s" : "S"),
                                     NULL,
@@ -5965,12 +5436,9 @@ static void _sdl_checkAndSetOrigin(SDL_CONTEXT *context, SDL_MEMBERS *member)
     char *id = (sdl_isItem(member) == true ? member->item.id : member->subaggr.id);
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_checkAndSetOrigin\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_checkAndSetOrigin");
 
     /*
      * If any aggregates have been defined, then check the member.id against
@@ -6037,15 +5505,11 @@ static void _sdl_check_bitfieldSizes(
             bool *updated)
 {
     SDL_MEMBERS *prevMember;
-    static bool myUpdated;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_check_bitfieldSizes\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_check_bitfieldSizes");
 
     /*
      * If the member parameter has not been passed, then the previous member is
@@ -6055,7 +5519,7 @@ static void _sdl_check_bitfieldSizes(
     if (member == NULL)
     {
         prevMember = (SDL_MEMBERS *) memberList->blink;
-        myUpdated = false;
+        context->bitfieldUpdated = false;
     }
     else
     {
@@ -6095,7 +5559,7 @@ static void _sdl_check_bitfieldSizes(
                                      prevMember,
                                      length,
                                      NULL,
-                                     &myUpdated);
+                                     &context->bitfieldUpdated);
         }
         else
         {
@@ -6109,7 +5573,7 @@ static void _sdl_check_bitfieldSizes(
      */
     if (member != NULL)
     {
-        if (myUpdated == false)
+        if (context->bitfieldUpdated == false)
         {
 
             /*
@@ -6203,12 +5667,9 @@ static uint32_t _sdl_create_bitfield_constants(
     uint32_t retVal = SDL_NORMAL;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_check_bitfieldSizes\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_check_bitfieldSizes");
 
     /*
      * Loop through the members in the member list until we've processed all of
@@ -6223,7 +5684,8 @@ static uint32_t _sdl_create_bitfield_constants(
              * OK, we have everything we need.  We now need to create a SIZE
              * constant and potentially a MASK constant.
              */
-            constDef = _sdl_create_constant(member->item.id,
+            constDef = _sdl_create_constant(context,
+                                            member->item.id,
                                             (member->item.prefix == NULL ?
                                                 "" : member->item.prefix),
                                             (sdl_all_lower(member->item.id) ? "s" : "S"),
@@ -6241,7 +5703,7 @@ static uint32_t _sdl_create_bitfield_constants(
             else
             {
                 retVal = SDL_ABORT;
-                if (sdl_set_message(msgVec,
+                if (sdl_set_message(context->msgVec,
                                     2,
                                     retVal,
                                     ENOMEM) != SDL_NORMAL)
@@ -6262,7 +5724,8 @@ static uint32_t _sdl_create_bitfield_constants(
                 mask = ((uint64_t) pow((double) 2,
                                        (double) member->item.length) - 1) <<
                                                member->item.bitOffset;
-                constDef = _sdl_create_constant(member->item.id,
+                constDef = _sdl_create_constant(context,
+                                                member->item.id,
                                                 (member->item.prefix == NULL ?
                                                     "" : member->item.prefix),
                                                 (sdl_all_lower(member->item.id) ? "m" : "M"),
@@ -6280,7 +5743,7 @@ static uint32_t _sdl_create_bitfield_constants(
                 else
                 {
                     retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
+                    if (sdl_set_message(context->msgVec,
                                         2,
                                         retVal,
                                         ENOMEM) != SDL_NORMAL)
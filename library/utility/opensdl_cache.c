@@ -0,0 +1,949 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the output cache.  The key for an input file is
+ *  a hash of its contents, its full path, the current directory, the
+ *  arguments that change the output, the copyright file, the image that is
+ *  running, and the version and shared library of each plugin that output is
+ *  being generated for.
+ *
+ *  Which INCLUDE files an input file uses is not known until it has been
+ *  parsed, so the cache directory has a manifest for each key.  The manifest
+ *  lists each INCLUDE file with a hash of its contents, and the output files
+ *  and diagnostics that were generated.  The output files and diagnostics are
+ *  kept in the cache directory under a hash of their contents.  A manifest is
+ *  only used if every one of its INCLUDE files still has the same contents.
+ *
+ *  All files are written to a temporary file and renamed, so a cache
+ *  directory can be shared by any number of compilations running at the same
+ *  time.  A file that cannot be read or written is a cache miss, never an
+ *  error.
+ *
+ *  The hash is the 64-bit FNV-1a hash.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  Output files are written through sdl_output_write, so that update mode
+ *  applies to them.
+ *
+ *  V01.002	15-OCT-2026	Jonathan D. Belanger
+ *  On a hit, the INCLUDE files in the manifest are put in the context's list
+ *  of INCLUDE files, for the dependency file.
+ *
+ *  V01.003	16-OCT-2026	Jonathan D. Belanger
+ *  Whether the input file is a recording to be replayed is part of the key.
+ *
+ *  V01.004	16-OCT-2026	Jonathan D. Belanger
+ *  The hash and write functions are no longer local, so that precompiled
+ *  INCLUDE files can be kept in the cache directory as well.
+ *
+ *  V01.005	16-OCT-2026	Jonathan D. Belanger
+ *  Calls are recorded in the trace rather than written to standard output.
+ *
+ *  V01.006	16-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_cache_hash_image, and the image that is running is part of the
+ *  key, so that output generated by a different build of the scanner, parser
+ *  or built-in languages is never used.
+ */
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_trace.h"
+#include "library/utility/opensdl_cache.h"
+#include "library/utility/opensdl_include.h"
+#include "library/utility/opensdl_output.h"
+#include "library/utility/opensdl_plugin.h"
+#include "library/utility/opensdl_plugin_funcs.h"
+#include "opensdl/opensdl_main.h"
+
+#define SDL_K_FNV64_PRIME	0x00000100000001b3ULL
+
+/*
+ * The first line of every manifest.  This needs to change whenever what goes
+ * into a key, or the format of a manifest, changes.
+ */
+static const char *_sdl_cache_magic = "OpenSDL output cache 2";
+
+/*
+ * Local Prototypes
+ */
+static bool _sdl_cache_read(const char *fileName,
+                            char **buffer,
+                            size_t *length);
+static bool _sdl_cache_hash_file(const char *fileName,
+                                 uint64_t *hash,
+                                 size_t *length);
+static bool _sdl_cache_put(const char *cacheDir,
+                           const char *buffer,
+                           size_t length,
+                           uint64_t *hash);
+static bool _sdl_cache_get(const char *cacheDir,
+                           uint64_t hash,
+                           size_t length,
+                           char **buffer);
+
+/*
+ * sdl_cache_key
+ *  This function is called to calculate the key for an input file, before it
+ *  is parsed.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.  The arguments
+ *      and languages in it are part of the key.
+ *  fileName:
+ *      A pointer to the name of the input file.
+ *
+ * Output Parameters:
+ *  key:
+ *      A pointer to the buffer to receive the key.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_INFILOPN:   The input file, copyright file, the image that is running
+ *                  or a plugin could not be read.
+ */
+uint32_t sdl_cache_key(SDL_CONTEXT *context,
+                       const char *fileName,
+                       SDL_CACHE_KEY key)
+{
+    SDL_ARGUMENTS *args = context->argument;
+    SDL_LANGUAGES *languages = args[ArgLanguage].languages;
+    SDL_SYMBOL_LIST *symbols = args[ArgSymbols].symbol;
+    char buffer[PATH_MAX + 64];
+    char *path;
+    uint64_t hash = SDL_K_FNV64_BASIS;
+    uint64_t fileHash;
+    size_t length;
+    uint32_t retVal = SDL_NORMAL;
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_cache_key");
+
+    hash = sdl_cache_hash_str(hash, _sdl_cache_magic);
+
+    /*
+     * The full path to the input file goes in the header of each output file,
+     * and INCLUDE files are opened from the current directory.
+     */
+    path = realpath(fileName, NULL);
+    hash = sdl_cache_hash_str(hash, (path != NULL) ? path : fileName);
+    if (path != NULL)
+    {
+        free(path);
+    }
+    if (getcwd(buffer, sizeof(buffer)) != NULL)
+    {
+        hash = sdl_cache_hash_str(hash, buffer);
+    }
+    if (_sdl_cache_hash_file(fileName, &fileHash, &length) == true)
+    {
+        sprintf(buffer, "%016" PRIx64 " %zu", fileHash, length);
+        hash = sdl_cache_hash_str(hash, buffer);
+    }
+    else
+    {
+        retVal = SDL_INFILOPN;
+    }
+
+    /*
+     * The arguments that change what is generated.
+     */
+    sprintf(buffer,
+            "a%d k%d c%d C%d H%d m%d r%d Sp%d St%d b%d",
+            args[ArgAlignment].value,
+            args[ArgCheckAlignment].on,
+            args[ArgComments].on,
+            args[ArgCopyright].on,
+            args[ArgHeader].on,
+            args[ArgMemberAlign].on,
+            args[ArgReplay].on,
+            args[ArgSuppressPrefix].on,
+            args[ArgSuppressTag].on,
+            args[ArgWordSize].value);
+    hash = sdl_cache_hash_str(hash, buffer);
+    if ((retVal == SDL_NORMAL) &&
+        (args[ArgCopyright].on == true) &&
+        (args[ArgCopyrightFile].present == true))
+    {
+        if (_sdl_cache_hash_file(args[ArgCopyrightFile].fileName,
+                                 &fileHash,
+                                 &length) == true)
+        {
+            sprintf(buffer, "%016" PRIx64 " %zu", fileHash, length);
+            hash = sdl_cache_hash_str(hash, buffer);
+        }
+        else
+        {
+            retVal = SDL_INFILOPN;
+        }
+    }
+    for (ii = 0; ((symbols != NULL) && (ii < symbols->listUsed)); ii++)
+    {
+        hash = sdl_cache_hash_str(hash, symbols->symbols[ii].symbol);
+        sprintf(buffer, "=%d", symbols->symbols[ii].value);
+        hash = sdl_cache_hash_str(hash, buffer);
+    }
+
+    /*
+     * The image that is running has the scanner, the parser and the layout,
+     * as well as the built-in languages.
+     */
+    if ((retVal == SDL_NORMAL) && (sdl_cache_hash_image(&hash) == false))
+    {
+        retVal = SDL_INFILOPN;
+    }
+
+    /*
+     * The languages, in order, and the plugin for each of them.  The plugins
+     * do not have a version of their own, so the plugin interface version and
+     * the size and modification time of the shared library are used.
+     */
+    sprintf(buffer,
+            "V%d.%d.%d",
+            SDL_API_VERSION_MAJOR,
+            SDL_API_VERSION_MINOR,
+            SDL_API_VERSION_PATCH);
+    hash = sdl_cache_hash_str(hash, buffer);
+    for (ii = 0;
+         ((retVal == SDL_NORMAL) && (ii < context->languagesSpecified));
+         ii++)
+    {
+        char *image = sdl_plugin_image(languages[ii].langVal);
+        struct stat fileStats;
+
+        hash = sdl_cache_hash_str(hash, languages[ii].langStr);
+        if ((image != NULL) && (stat(image, &fileStats) == 0))
+        {
+            hash = sdl_cache_hash_str(hash, image);
+            sprintf(buffer,
+                    "%lld %lld.%09ld",
+                    (long long) fileStats.st_size,
+                    (long long) fileStats.st_mtim.tv_sec,
+                    fileStats.st_mtim.tv_nsec);
+            hash = sdl_cache_hash_str(hash, buffer);
+        }
+        else
+        {
+            retVal = SDL_INFILOPN;
+        }
+    }
+    sprintf(key, "%016" PRIx64, hash);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_cache_fetch
+ *  This function is called to look for the output files for a key in the
+ *  cache.  If there is a manifest for the key, and none of its INCLUDE files
+ *  have changed, the output files are written from the cache and the
+ *  diagnostics are written to the context's error file.  The INCLUDE files
+ *  are put in the context's list of INCLUDE files, as if they had been
+ *  opened.
+ *
+ * Input Parameters:
+ *  cacheDir:
+ *      A pointer to the name of the cache directory.
+ *  key:
+ *      A pointer to the key returned by sdl_cache_key.
+ *  context:
+ *      A pointer to the context structure for the compilation.
+ *  outFileName:
+ *      A pointer to the array of output file names, one for each language.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:   The output files were written from the cache.
+ *  false:  The output files are not in the cache, and nothing was written.
+ */
+bool sdl_cache_fetch(const char *cacheDir,
+                     SDL_CACHE_KEY key,
+                     SDL_CONTEXT *context,
+                     char **outFileName)
+{
+    char path[PATH_MAX];
+    char **outputs;
+    size_t *outputLen;
+    char *manifest = NULL;
+    char *diagnostics = NULL;
+    char *line;
+    char *savePtr = NULL;
+    size_t manifestLen;
+    size_t diagLen = 0;
+    uint32_t outputCount = 0;
+    bool retVal;
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_cache_fetch");
+
+    outputs = sdl_calloc(context->languagesSpecified + 1, sizeof(char *));
+    outputLen = sdl_calloc(context->languagesSpecified + 1, sizeof(size_t));
+    snprintf(path, sizeof(path), "%s/%s.manifest", cacheDir, key);
+    retVal = (outputs != NULL) && (outputLen != NULL) &&
+             (_sdl_cache_read(path, &manifest, &manifestLen) == true);
+    if (retVal == true)
+    {
+        line = strtok_r(manifest, "\n", &savePtr);
+        retVal = (line != NULL) && (strcmp(line, _sdl_cache_magic) == 0);
+    }
+
+    /*
+     * Go through the manifest, checking each INCLUDE file and getting the
+     * contents of each output file and the diagnostics.  Nothing is written
+     * until all of it has been found.
+     */
+    while ((retVal == true) &&
+           ((line = strtok_r(NULL, "\n", &savePtr)) != NULL))
+    {
+        uint64_t hash, fileHash;
+        size_t length, fileLen;
+        int offset = 0;
+
+        if (sscanf(line,
+                   "include %" SCNx64 " %zu %n",
+                   &hash,
+                   &length,
+                   &offset) == 2)
+        {
+            retVal = (offset > 0) &&
+                     (_sdl_cache_hash_file(&line[offset],
+                                           &fileHash,
+                                           &fileLen) == true) &&
+                     (fileHash == hash) &&
+                     (fileLen == length) &&
+                     (sdl_include_record(&context->includes,
+                                         &line[offset]) == SDL_NORMAL);
+        }
+        else if (sscanf(line, "output %" SCNx64 " %zu", &hash, &length) == 2)
+        {
+            retVal = (outputCount < context->languagesSpecified) &&
+                     (_sdl_cache_get(cacheDir,
+                                     hash,
+                                     length,
+                                     &outputs[outputCount]) == true);
+            if (retVal == true)
+            {
+                outputLen[outputCount++] = length;
+            }
+        }
+        else if (sscanf(line,
+                        "diagnostics %" SCNx64 " %zu",
+                        &hash,
+                        &length) == 2)
+        {
+            retVal = (diagnostics == NULL) &&
+                     (_sdl_cache_get(cacheDir,
+                                     hash,
+                                     length,
+                                     &diagnostics) == true);
+            diagLen = length;
+        }
+        else
+        {
+            retVal = false;
+        }
+    }
+    if (outputCount != context->languagesSpecified)
+    {
+        retVal = false;
+    }
+
+    /*
+     * Everything was found, so write out the output files and the
+     * diagnostics.
+     */
+    for (ii = 0; ((retVal == true) && (ii < outputCount)); ii++)
+    {
+        retVal = (sdl_output_write(outFileName[ii],
+                                   outputs[ii],
+                                   outputLen[ii],
+                                   context->argument[ArgUpdate].on) ==
+                  SDL_NORMAL);
+    }
+    if ((retVal == true) && (diagnostics != NULL))
+    {
+        fwrite(diagnostics, 1, diagLen, context->errFP);
+    }
+    if (retVal == false)
+    {
+        sdl_include_list_free(&context->includes);
+    }
+
+    /*
+     * Clean up.
+     */
+    for (ii = 0; ((outputs != NULL) && (ii < outputCount)); ii++)
+    {
+        sdl_free(outputs[ii]);
+    }
+    if (outputs != NULL)
+    {
+        sdl_free(outputs);
+    }
+    if (outputLen != NULL)
+    {
+        sdl_free(outputLen);
+    }
+    if (manifest != NULL)
+    {
+        sdl_free(manifest);
+    }
+    if (diagnostics != NULL)
+    {
+        sdl_free(diagnostics);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_cache_store
+ *  This function is called, after an input file has been compiled without
+ *  error, to put the output files and diagnostics in the cache, along with a
+ *  manifest for the key.
+ *
+ * Input Parameters:
+ *  cacheDir:
+ *      A pointer to the name of the cache directory.  It is created if it
+ *      does not exist.
+ *  key:
+ *      A pointer to the key returned by sdl_cache_key, before the input file
+ *      was compiled.
+ *  context:
+ *      A pointer to the context structure for the compilation.  This contains
+ *      the list of INCLUDE files that were opened.
+ *  outFileName:
+ *      A pointer to the array of output file names, one for each language.
+ *  diagnostics:
+ *      A pointer to the diagnostics written while compiling the input file.
+ *  diagLen:
+ *      A value indicating the length of the diagnostics.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_INFILOPN:   An INCLUDE or output file could not be read.
+ *  SDL_OUTFILOPN:  A file could not be written to the cache directory.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ */
+uint32_t sdl_cache_store(const char *cacheDir,
+                         SDL_CACHE_KEY key,
+                         SDL_CONTEXT *context,
+                         char **outFileName,
+                         const char *diagnostics,
+                         size_t diagLen)
+{
+    SDL_INPUT_LIST *includes = &context->includes;
+    FILE *fp;
+    char path[PATH_MAX];
+    char *manifest = NULL;
+    size_t manifestLen = 0;
+    uint64_t hash;
+    size_t length;
+    uint32_t retVal = SDL_NORMAL;
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_cache_store");
+
+    if ((mkdir(cacheDir, 0777) != 0) && (errno != EEXIST))
+    {
+        return(SDL_OUTFILOPN);
+    }
+    if ((fp = open_memstream(&manifest, &manifestLen)) == NULL)
+    {
+        return(SDL_ABORT);
+    }
+    fprintf(fp, "%s\n", _sdl_cache_magic);
+
+    /*
+     * The INCLUDE files, which are checked before the manifest is used.
+     */
+    for (ii = 0; ((retVal == SDL_NORMAL) && (ii < includes->listUsed)); ii++)
+    {
+        if (_sdl_cache_hash_file(includes->files[ii], &hash, &length) == true)
+        {
+            fprintf(fp,
+                    "include %016" PRIx64 " %zu %s\n",
+                    hash,
+                    length,
+                    includes->files[ii]);
+        }
+        else
+        {
+            retVal = SDL_INFILOPN;
+        }
+    }
+
+    /*
+     * The output files, in the order of the languages.
+     */
+    for (ii = 0;
+         ((retVal == SDL_NORMAL) && (ii < context->languagesSpecified));
+         ii++)
+    {
+        char *buffer = NULL;
+
+        if (_sdl_cache_read(outFileName[ii], &buffer, &length) == false)
+        {
+            retVal = SDL_INFILOPN;
+        }
+        else if (_sdl_cache_put(cacheDir, buffer, length, &hash) == false)
+        {
+            retVal = SDL_OUTFILOPN;
+        }
+        else
+        {
+            fprintf(fp, "output %016" PRIx64 " %zu\n", hash, length);
+        }
+        if (buffer != NULL)
+        {
+            sdl_free(buffer);
+        }
+    }
+
+    /*
+     * The diagnostics, if there were any.
+     */
+    if ((retVal == SDL_NORMAL) && (diagLen > 0))
+    {
+        if (_sdl_cache_put(cacheDir, diagnostics, diagLen, &hash) == true)
+        {
+            fprintf(fp, "diagnostics %016" PRIx64 " %zu\n", hash, diagLen);
+        }
+        else
+        {
+            retVal = SDL_OUTFILOPN;
+        }
+    }
+    fclose(fp);
+
+    /*
+     * The manifest is written last, so that it never refers to a file that is
+     * not yet in the cache.
+     */
+    if (retVal == SDL_NORMAL)
+    {
+        snprintf(path, sizeof(path), "%s/%s.manifest", cacheDir, key);
+        if (sdl_cache_write(path, manifest, manifestLen) == false)
+        {
+            retVal = SDL_OUTFILOPN;
+        }
+    }
+    if (manifest != NULL)
+    {
+        free(manifest);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_cache_hash
+ *  This function is called to add data to a 64-bit FNV-1a hash.
+ *
+ * Input Parameters:
+ *  hash:
+ *      A value indicating the hash so far.
+ *  data:
+ *      A pointer to the data to be added.
+ *  length:
+ *      A value indicating the length of the data.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  The new hash value.
+ */
+uint64_t sdl_cache_hash(uint64_t hash, const void *data, size_t length)
+{
+    const uint8_t *ptr = (const uint8_t *) data;
+    size_t ii;
+
+    for (ii = 0; ii < length; ii++)
+    {
+        hash ^= ptr[ii];
+        hash *= SDL_K_FNV64_PRIME;
+    }
+    return(hash);
+}
+
+/*
+ * sdl_cache_hash_str
+ *  This function is called to add a string, including its null terminator, to
+ *  a 64-bit FNV-1a hash.  The terminator keeps one string from running into
+ *  the next.
+ *
+ * Input Parameters:
+ *  hash:
+ *      A value indicating the hash so far.
+ *  str:
+ *      A pointer to the null-terminated string to be added.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  The new hash value.
+ */
+uint64_t sdl_cache_hash_str(uint64_t hash, const char *str)
+{
+    return(sdl_cache_hash(hash, str, strlen(str) + 1));
+}
+
+/*
+ * sdl_cache_hash_image
+ *  This function is called to add the image that is running to a 64-bit
+ *  FNV-1a hash.  There is no version that changes with every build, so the
+ *  path, size and modification time of the image are used, just as they are
+ *  for the shared library of a plugin.
+ *
+ * Input Parameters:
+ *  hash:
+ *      A pointer to the hash so far.
+ *
+ * Output Parameters:
+ *  hash:
+ *      A pointer to the location to receive the new hash value.
+ *
+ * Return Values:
+ *  true:   The image was added to the hash.
+ *  false:  The image could not be found.
+ */
+bool sdl_cache_hash_image(uint64_t *hash)
+{
+    char image[PATH_MAX];
+    char buffer[64];
+    struct stat fileStats;
+    bool retVal = false;
+
+    memset(image, 0, sizeof(image));
+    GET_IMAGE_PATH(image, PATH_MAX - 1);
+    if ((image[0] != '\0') && (stat(image, &fileStats) == 0))
+    {
+        *hash = sdl_cache_hash_str(*hash, image);
+        sprintf(buffer,
+                "%lld %lld.%09ld",
+                (long long) fileStats.st_size,
+                (long long) fileStats.st_mtim.tv_sec,
+                fileStats.st_mtim.tv_nsec);
+        *hash = sdl_cache_hash_str(*hash, buffer);
+        retVal = true;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_cache_write
+ *  This function is called to write a file in the cache directory.  It is
+ *  written to a temporary file, which is then renamed, so that no other
+ *  compilation ever sees a partially written file.
+ *
+ * Input Parameters:
+ *  fileName:
+ *      A pointer to the name of the file to be written.
+ *  buffer:
+ *      A pointer to the contents to be written.
+ *  length:
+ *      A value indicating the length of the contents.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:   The file was written.
+ *  false:  The file could not be written.
+ */
+bool sdl_cache_write(const char *fileName,
+                     const char *buffer,
+                     size_t length)
+{
+    char tmpName[PATH_MAX];
+    FILE *fp = NULL;
+    bool retVal = false;
+    int fd;
+
+    snprintf(tmpName, sizeof(tmpName), "%s.XXXXXX", fileName);
+    if ((fd = mkstemp(tmpName)) >= 0)
+    {
+        if ((fp = fdopen(fd, "w")) != NULL)
+        {
+            retVal = (fwrite(buffer, 1, length, fp) == length);
+            retVal = (fclose(fp) == 0) && (retVal == true);
+        }
+        else
+        {
+            close(fd);
+        }
+        if (retVal == true)
+        {
+            retVal = (rename(tmpName, fileName) == 0);
+        }
+        if (retVal == false)
+        {
+            unlink(tmpName);
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_cache_read
+ *  This function is called to read the entire contents of a file into memory.
+ *  The contents are null terminated.
+ *
+ * Input Parameters:
+ *  fileName:
+ *      A pointer to the name of the file to be read.
+ *
+ * Output Parameters:
+ *  buffer:
+ *      A pointer to the address to receive the contents of the file.  This
+ *      needs to be freed by the caller.
+ *  length:
+ *      A pointer to the length of the contents of the file.
+ *
+ * Return Values:
+ *  true:   The file was read.
+ *  false:  The file could not be read.
+ */
+static bool _sdl_cache_read(const char *fileName,
+                            char **buffer,
+                            size_t *length)
+{
+    FILE *fp = fopen(fileName, "r");
+    struct stat fileStats;
+    bool retVal = false;
+
+    *buffer = NULL;
+    *length = 0;
+    if ((fp != NULL) && (fstat(fileno(fp), &fileStats) == 0))
+    {
+        *buffer = sdl_calloc(fileStats.st_size + 1, 1);
+        if (*buffer != NULL)
+        {
+            *length = fread(*buffer, 1, fileStats.st_size, fp);
+            retVal = (ferror(fp) == 0) && (*length == fileStats.st_size);
+            if (retVal == false)
+            {
+                sdl_free(*buffer);
+                *buffer = NULL;
+            }
+        }
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_cache_hash_file
+ *  This function is called to get the hash of the contents of a file.
+ *
+ * Input Parameters:
+ *  fileName:
+ *      A pointer to the name of the file to be hashed.
+ *
+ * Output Parameters:
+ *  hash:
+ *      A pointer to the location to receive the hash.
+ *  length:
+ *      A pointer to the location to receive the length of the file.
+ *
+ * Return Values:
+ *  true:   The file was hashed.
+ *  false:  The file could not be read.
+ */
+static bool _sdl_cache_hash_file(const char *fileName,
+                                 uint64_t *hash,
+                                 size_t *length)
+{
+    FILE *fp = fopen(fileName, "r");
+    char buffer[BUFSIZ];
+    size_t readLen;
+    bool retVal = false;
+
+    *hash = SDL_K_FNV64_BASIS;
+    *length = 0;
+    if (fp != NULL)
+    {
+        while ((readLen = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+        {
+            *hash = sdl_cache_hash(*hash, buffer, readLen);
+            *length += readLen;
+        }
+        retVal = (ferror(fp) == 0);
+        fclose(fp);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_cache_put
+ *  This function is called to put contents in the cache directory, under the
+ *  hash of the contents.  If the contents are already there, they are not
+ *  written again.
+ *
+ * Input Parameters:
+ *  cacheDir:
+ *      A pointer to the name of the cache directory.
+ *  buffer:
+ *      A pointer to the contents to be put in the cache.
+ *  length:
+ *      A value indicating the length of the contents.
+ *
+ * Output Parameters:
+ *  hash:
+ *      A pointer to the location to receive the hash of the contents.
+ *
+ * Return Values:
+ *  true:   The contents are in the cache.
+ *  false:  The contents could not be written to the cache.
+ */
+static bool _sdl_cache_put(const char *cacheDir,
+                           const char *buffer,
+                           size_t length,
+                           uint64_t *hash)
+{
+    char path[PATH_MAX];
+    bool retVal = true;
+
+    *hash = sdl_cache_hash(SDL_K_FNV64_BASIS, buffer, length);
+    snprintf(path,
+             sizeof(path),
+             "%s/%016" PRIx64 "-%zx.obj",
+             cacheDir,
+             *hash,
+             length);
+    if (access(path, F_OK) != 0)
+    {
+        retVal = sdl_cache_write(path, buffer, length);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_cache_get
+ *  This function is called to get contents from the cache directory.  The
+ *  contents must still have the hash and length they were put there with.
+ *
+ * Input Parameters:
+ *  cacheDir:
+ *      A pointer to the name of the cache directory.
+ *  hash:
+ *      A value indicating the hash of the contents.
+ *  length:
+ *      A value indicating the length of the contents.
+ *
+ * Output Parameters:
+ *  buffer:
+ *      A pointer to the address to receive the contents, which are null
+ *      terminated.  This needs to be freed by the caller.
+ *
+ * Return Values:
+ *  true:   The contents were found.
+ *  false:  The contents are not in the cache.
+ */
+static bool _sdl_cache_get(const char *cacheDir,
+                           uint64_t hash,
+                           size_t length,
+                           char **buffer)
+{
+    char path[PATH_MAX];
+    size_t readLen;
+    bool retVal;
+
+    snprintf(path,
+             sizeof(path),
+             "%s/%016" PRIx64 "-%zx.obj",
+             cacheDir,
+             hash,
+             length);
+    retVal = (_sdl_cache_read(path, buffer, &readLen) == true) &&
+             (readLen == length) &&
+             (sdl_cache_hash(SDL_K_FNV64_BASIS, *buffer, length) == hash);
+    if ((retVal == false) && (*buffer != NULL))
+    {
+        sdl_free(*buffer);
+        *buffer = NULL;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
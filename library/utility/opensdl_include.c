@@ -0,0 +1,835 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the INCLUDE file cache.  The cache is indexed by
+ *  the device and inode of each file, so the same file is found no matter
+ *  what directory it was included from, and each entry remembers the size and
+ *  modification time the file had when it was read.  If either has changed,
+ *  the file is read again.  The contents are never freed while the cache is
+ *  in use, because a scanner on another thread may still be reading them.
+ *
+ *  The files read since the cache was enabled, that were not already in the
+ *  cache, are remembered so that a compile server child process can tell its
+ *  parent which files to load for the next request.
+ *
+ *  Each compilation also keeps a list of the INCLUDE files it opened, for the
+ *  output cache.
+ *
+ *  An input file that was opened on disk can be mapped into memory, with the
+ *  two null characters the scanner needs at the end of a buffer it scans in
+ *  place.  The mapping is private, so the scanner can write into it without
+ *  changing the file.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_include_record and sdl_include_list_free.
+ *
+ *  V01.002	16-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_include_map and sdl_include_unmap.
+ *
+ *  V01.003	16-OCT-2026	Jonathan D. Belanger
+ *  Calls are recorded in the trace rather than written to standard output.
+ */
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_symtab.h"
+#include "library/common/opensdl_trace.h"
+#include "library/utility/opensdl_include.h"
+#include "opensdl/opensdl_main.h"
+
+/*
+ * The scanner needs a buffer it scans in place to end with two null
+ * characters.
+ */
+#define SDL_K_MAP_PAD   2
+
+/*
+ * The contents of an INCLUDE file, as it was when it was read.
+ */
+typedef struct _sdl_include_data
+{
+    struct _sdl_include_data *next;
+    char            *buffer;
+    size_t          length;
+    struct timespec mtime;
+    off_t           size;
+} SDL_INCLUDE_DATA;
+
+/*
+ * The cache entry for an INCLUDE file.  The key is the device and inode
+ * numbers of the file.
+ */
+typedef struct
+{
+    char            key[40];
+    SDL_INCLUDE_DATA *data;
+} SDL_INCLUDE_ENTRY;
+
+/*
+ * Local Variables
+ */
+static SDL_SYMTAB _sdl_include_symtab;
+static SDL_INCLUDE_DATA *_sdl_include_retired = NULL;
+static SDL_INCLUDE_ENTRY **_sdl_include_entries = NULL;
+static int _sdl_include_entry_count = 0;
+static char **_sdl_include_misses = NULL;
+static int _sdl_include_miss_count = 0;
+static bool _sdl_include_enabled = false;
+static pthread_mutex_t _sdl_include_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Local Prototypes
+ */
+static SDL_INCLUDE_DATA *_sdl_include_read(const char *fileName,
+                                           struct stat *fileStats);
+static uint32_t _sdl_include_insert(const char *fileName,
+                                    struct stat *fileStats,
+                                    bool miss,
+                                    SDL_INCLUDE_DATA **data);
+static void _sdl_include_prepare(void);
+static void _sdl_include_resume(void);
+
+/*
+ * sdl_include_cache_enable
+ *  This function is called to turn on the INCLUDE file cache.  Until it is
+ *  called, sdl_include_open just opens the file.  The cache lock is taken
+ *  around a fork, so that a child process never inherits it locked.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_include_cache_enable(void)
+{
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_include_cache_enable");
+
+    if (_sdl_include_enabled == false)
+    {
+        sdl_symtab_init(&_sdl_include_symtab, 0);
+        pthread_atfork(_sdl_include_prepare,
+                       _sdl_include_resume,
+                       _sdl_include_resume);
+        _sdl_include_enabled = true;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_include_open
+ *  This function is called to open an INCLUDE file for reading.  If the cache
+ *  is enabled, the file is read from the cache, and if it is not in the cache,
+ *  or has been changed since it was put there, it is read into the cache
+ *  first.
+ *
+ * Input Parameters:
+ *  fileName:
+ *      A pointer to the name of the INCLUDE file.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:   The file could not be opened, errno has the reason.
+ *  !NULL:  A pointer to the file to be read.
+ */
+FILE *sdl_include_open(const char *fileName)
+{
+    SDL_INCLUDE_ENTRY *entry;
+    SDL_INCLUDE_DATA *data = NULL;
+    struct stat fileStats;
+    char key[40];
+    FILE *retVal;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_include_open");
+
+    if ((_sdl_include_enabled == false) || (stat(fileName, &fileStats) != 0))
+    {
+        return(fopen(fileName, "r"));
+    }
+
+    /*
+     * Look for the file in the cache, and make sure it has not changed since
+     * it was read.
+     */
+    sprintf(key,
+            "%lx:%lx",
+            (unsigned long) fileStats.st_dev,
+            (unsigned long) fileStats.st_ino);
+    pthread_mutex_lock(&_sdl_include_mutex);
+    entry = sdl_symtab_lookup(&_sdl_include_symtab, key);
+    if ((entry != NULL) &&
+        (entry->data->size == fileStats.st_size) &&
+        (entry->data->mtime.tv_sec == fileStats.st_mtim.tv_sec) &&
+        (entry->data->mtime.tv_nsec == fileStats.st_mtim.tv_nsec))
+    {
+        data = entry->data;
+    }
+    pthread_mutex_unlock(&_sdl_include_mutex);
+    if ((data == NULL) &&
+        (_sdl_include_insert(fileName, &fileStats, true, &data) != SDL_NORMAL))
+    {
+        return(fopen(fileName, "r"));
+    }
+
+    /*
+     * An empty file cannot be opened in memory, so it is opened on disk.
+     */
+    if (data->length == 0)
+    {
+        retVal = fopen(fileName, "r");
+    }
+    else
+    {
+        retVal = fmemopen(data->buffer, data->length, "r");
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_include_cache_load
+ *  This function is called to read a file into the cache, without opening
+ *  it.  The compile server calls this for the files its children read.
+ *
+ * Input Parameters:
+ *  fileName:
+ *      A pointer to the name of the file to be loaded.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_INFILOPN:   The file could not be read.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ */
+uint32_t sdl_include_cache_load(const char *fileName)
+{
+    SDL_INCLUDE_DATA *data;
+    struct stat fileStats;
+    uint32_t retVal = SDL_INFILOPN;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_include_cache_load");
+
+    if ((_sdl_include_enabled == true) && (stat(fileName, &fileStats) == 0))
+    {
+        retVal = _sdl_include_insert(fileName, &fileStats, false, &data);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_include_write_misses
+ *  This function is called to write out the full path of each file that was
+ *  read into the cache by sdl_include_open.  Each path is terminated by a
+ *  null character.
+ *
+ * Input Parameters:
+ *  fp:
+ *      A pointer to the file to which the paths are to be written.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_include_write_misses(FILE *fp)
+{
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_include_write_misses");
+
+    pthread_mutex_lock(&_sdl_include_mutex);
+    for (ii = 0; ii < _sdl_include_miss_count; ii++)
+    {
+        fwrite(_sdl_include_misses[ii],
+               1,
+               strlen(_sdl_include_misses[ii]) + 1,
+               fp);
+    }
+    pthread_mutex_unlock(&_sdl_include_mutex);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_include_cache_release
+ *  This function is called to release everything in the cache.  No file
+ *  opened by sdl_include_open can still be open when this is called.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_include_cache_release(void)
+{
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_include_cache_release");
+
+    pthread_mutex_lock(&_sdl_include_mutex);
+    for (ii = 0; ii < _sdl_include_entry_count; ii++)
+    {
+        SDL_INCLUDE_DATA *data = _sdl_include_entries[ii]->data;
+
+        if (data != NULL)
+        {
+            data->next = _sdl_include_retired;
+            _sdl_include_retired = data;
+        }
+        sdl_free(_sdl_include_entries[ii]);
+    }
+    while (_sdl_include_retired != NULL)
+    {
+        SDL_INCLUDE_DATA *data = _sdl_include_retired;
+
+        _sdl_include_retired = data->next;
+        if (data->buffer != NULL)
+        {
+            sdl_free(data->buffer);
+        }
+        sdl_free(data);
+    }
+    for (ii = 0; ii < _sdl_include_miss_count; ii++)
+    {
+        sdl_free(_sdl_include_misses[ii]);
+    }
+    if (_sdl_include_entries != NULL)
+    {
+        sdl_free(_sdl_include_entries);
+    }
+    if (_sdl_include_misses != NULL)
+    {
+        sdl_free(_sdl_include_misses);
+    }
+    _sdl_include_entries = NULL;
+    _sdl_include_entry_count = 0;
+    _sdl_include_misses = NULL;
+    _sdl_include_miss_count = 0;
+    sdl_symtab_reset(&_sdl_include_symtab);
+    pthread_mutex_unlock(&_sdl_include_mutex);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_include_record
+ *  This function is called to add the name of an INCLUDE file that was opened
+ *  to the list of INCLUDE files for a compilation.  A file that is already in
+ *  the list is not added again.
+ *
+ * Input Parameters:
+ *  list:
+ *      A pointer to the list of INCLUDE files for the compilation.
+ *  fileName:
+ *      A pointer to the name of the INCLUDE file, as it was opened.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ */
+uint32_t sdl_include_record(SDL_INPUT_LIST *list, const char *fileName)
+{
+    uint32_t retVal = SDL_NORMAL;
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_include_record");
+
+    for (ii = 0; ii < list->listUsed; ii++)
+    {
+        if (strcmp(list->files[ii], fileName) == 0)
+        {
+            return(retVal);
+        }
+    }
+    if (list->listUsed >= list->listSize)
+    {
+        char **newFiles = sdl_realloc(list->files,
+                                      ((list->listSize + 8) *
+                                       sizeof(char *)));
+
+        if (newFiles != NULL)
+        {
+            list->files = newFiles;
+            list->listSize += 8;
+        }
+        else
+        {
+            retVal = SDL_ABORT;
+        }
+    }
+    if (retVal == SDL_NORMAL)
+    {
+        list->files[list->listUsed] = sdl_strdup_heap(fileName);
+        if (list->files[list->listUsed] != NULL)
+        {
+            list->listUsed++;
+        }
+        else
+        {
+            retVal = SDL_ABORT;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_include_list_free
+ *  This function is called to free the list of INCLUDE files for a
+ *  compilation.
+ *
+ * Input Parameters:
+ *  list:
+ *      A pointer to the list of INCLUDE files for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_include_list_free(SDL_INPUT_LIST *list)
+{
+    int ii;
+
+    for (ii = 0; ii < list->listUsed; ii++)
+    {
+        sdl_free(list->files[ii]);
+    }
+    if (list->files != NULL)
+    {
+        sdl_free(list->files);
+    }
+    list->files = NULL;
+    list->listUsed = 0;
+    list->listSize = 0;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_include_map
+ *  This function is called to map an opened input file into memory, so that
+ *  the scanner can scan it where it is, rather than reading it into buffers
+ *  of its own.  Only a regular file, opened on disk and not yet read from,
+ *  can be mapped.  The file is mapped over anonymous memory that is at least
+ *  two bytes longer than the file, so the null characters after the end of
+ *  the file are there even when it ends on a page boundary.
+ *
+ * Input Parameters:
+ *  fp:
+ *      A pointer to the opened input file.
+ *
+ * Output Parameters:
+ *  length:
+ *      A pointer to a size to receive the length of the buffer to be given
+ *      to the scanner, which includes the two null characters.
+ *
+ * Return Values:
+ *  NULL:   The file could not be mapped, and is to be read.
+ *  !NULL:  A pointer to the contents of the file.
+ */
+char *sdl_include_map(FILE *fp, size_t *length)
+{
+    struct stat fileStats;
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    size_t mapLength;
+    char *retVal = NULL;
+    void *map;
+    int fd = (fp != NULL) ? fileno(fp) : -1;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_include_map");
+
+    if ((fd >= 0) &&
+        (fstat(fd, &fileStats) == 0) &&
+        (S_ISREG(fileStats.st_mode)) &&
+        (fileStats.st_size > 0) &&
+        (ftell(fp) == 0))
+    {
+        mapLength = (fileStats.st_size + SDL_K_MAP_PAD + pageSize - 1) &
+                    ~(pageSize - 1);
+        map = mmap(NULL,
+                   mapLength,
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS,
+                   -1,
+                   0);
+        if (map != MAP_FAILED)
+        {
+            if (mmap(map,
+                     fileStats.st_size,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_FIXED,
+                     fd,
+                     0) != MAP_FAILED)
+            {
+                madvise(map, fileStats.st_size, MADV_SEQUENTIAL);
+                *length = fileStats.st_size + SDL_K_MAP_PAD;
+                retVal = (char *) map;
+            }
+            else
+            {
+                munmap(map, mapLength);
+            }
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_include_unmap
+ *  This function is called to unmap an input file that was mapped by
+ *  sdl_include_map, once the scanner is done with it.
+ *
+ * Input Parameters:
+ *  map:
+ *      A pointer to the contents of the file, as returned by
+ *      sdl_include_map.
+ *  length:
+ *      A value indicating the length returned by sdl_include_map.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_include_unmap(char *map, size_t length)
+{
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_include_unmap");
+
+    if (map != NULL)
+    {
+        munmap(map, (length + pageSize - 1) & ~(pageSize - 1));
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_include_read
+ *  This function is called to read the entire contents of a file into
+ *  memory.
+ *
+ * Input Parameters:
+ *  fileName:
+ *      A pointer to the name of the file to be read.
+ *  fileStats:
+ *      A pointer to the status of the file, from stat.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:   The file could not be read.
+ *  !NULL:  A pointer to the contents of the file.
+ */
+static SDL_INCLUDE_DATA *_sdl_include_read(const char *fileName,
+                                           struct stat *fileStats)
+{
+    SDL_INCLUDE_DATA *retVal = sdl_calloc(1, sizeof(SDL_INCLUDE_DATA));
+    FILE *fp = fopen(fileName, "r");
+
+    if ((retVal != NULL) && (fp != NULL))
+    {
+        retVal->size = fileStats->st_size;
+        retVal->mtime = fileStats->st_mtim;
+        retVal->buffer = sdl_calloc(fileStats->st_size + 1, 1);
+        if (retVal->buffer != NULL)
+        {
+            retVal->length = fread(retVal->buffer, 1, fileStats->st_size, fp);
+        }
+        if ((retVal->buffer == NULL) || (ferror(fp) != 0))
+        {
+            if (retVal->buffer != NULL)
+            {
+                sdl_free(retVal->buffer);
+            }
+            sdl_free(retVal);
+            retVal = NULL;
+        }
+    }
+    else if (retVal != NULL)
+    {
+        sdl_free(retVal);
+        retVal = NULL;
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_include_insert
+ *  This function is called to read a file and put it in the cache.  If the
+ *  file was already in the cache, the old contents are retired, rather than
+ *  freed.
+ *
+ * Input Parameters:
+ *  fileName:
+ *      A pointer to the name of the file to be read.
+ *  fileStats:
+ *      A pointer to the status of the file, from stat.
+ *  miss:
+ *      A boolean indicating that the file is to be remembered for
+ *      sdl_include_write_misses.
+ *
+ * Output Parameters:
+ *  data:
+ *      A pointer to the address to receive the contents of the file.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_INFILOPN:   The file could not be read.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ */
+static uint32_t _sdl_include_insert(const char *fileName,
+                                    struct stat *fileStats,
+                                    bool miss,
+                                    SDL_INCLUDE_DATA **data)
+{
+    SDL_INCLUDE_ENTRY *entry;
+    char key[40];
+    uint32_t retVal = SDL_NORMAL;
+
+    /*
+     * Read the file before taking the lock, so that other threads can keep
+     * using the cache.
+     */
+    *data = _sdl_include_read(fileName, fileStats);
+    if (*data == NULL)
+    {
+        return(SDL_INFILOPN);
+    }
+    sprintf(key,
+            "%lx:%lx",
+            (unsigned long) fileStats->st_dev,
+            (unsigned long) fileStats->st_ino);
+
+    pthread_mutex_lock(&_sdl_include_mutex);
+    entry = sdl_symtab_lookup(&_sdl_include_symtab, key);
+    if (entry != NULL)
+    {
+        entry->data->next = _sdl_include_retired;
+        _sdl_include_retired = entry->data;
+        entry->data = *data;
+    }
+    else
+    {
+        SDL_INCLUDE_ENTRY **entries;
+
+        entry = sdl_calloc(1, sizeof(SDL_INCLUDE_ENTRY));
+        entries = sdl_realloc(_sdl_include_entries,
+                              (_sdl_include_entry_count + 1) *
+                              sizeof(SDL_INCLUDE_ENTRY *));
+        if ((entry != NULL) && (entries != NULL))
+        {
+            strcpy(entry->key, key);
+            entry->data = *data;
+            _sdl_include_entries = entries;
+            _sdl_include_entries[_sdl_include_entry_count++] = entry;
+            retVal = sdl_symtab_insert(&_sdl_include_symtab,
+                                       entry->key,
+                                       0,
+                                       entry);
+        }
+        else
+        {
+            if (entries != NULL)
+            {
+                _sdl_include_entries = entries;
+            }
+            retVal = SDL_ABORT;
+        }
+        if (retVal != SDL_NORMAL)
+        {
+            if (entry != NULL)
+            {
+                entry->data = NULL;
+            }
+            (*data)->next = _sdl_include_retired;
+            _sdl_include_retired = *data;
+            *data = NULL;
+        }
+    }
+
+    /*
+     * Remember the full path of the file, for the compile server.
+     */
+    if ((retVal == SDL_NORMAL) && (miss == true))
+    {
+        char *path = realpath(fileName, NULL);
+        char **misses = sdl_realloc(_sdl_include_misses,
+                                    (_sdl_include_miss_count + 1) *
+                                    sizeof(char *));
+
+        if ((path != NULL) && (misses != NULL))
+        {
+            _sdl_include_misses = misses;
+            _sdl_include_misses[_sdl_include_miss_count++] =
+                sdl_strdup_heap(path);
+        }
+        else if (misses != NULL)
+        {
+            _sdl_include_misses = misses;
+        }
+        if (path != NULL)
+        {
+            free(path);
+        }
+    }
+    pthread_mutex_unlock(&_sdl_include_mutex);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_include_prepare
+ *  This function is called just before a fork, to take the cache lock.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_include_prepare(void)
+{
+    pthread_mutex_lock(&_sdl_include_mutex);
+    return;
+}
+
+/*
+ * _sdl_include_resume
+ *  This function is called just after a fork, in both the parent and the
+ *  child, to release the cache lock.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_include_resume(void)
+{
+    pthread_mutex_unlock(&_sdl_include_mutex);
+    return;
+}
@@ -0,0 +1,1313 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the functions that build the module IR.  The
+ *  action routines add a node to the IR for each statement that generates
+ *  output, rather than calling the plugins themselves.  When END_MODULE is
+ *  parsed, the IR is complete, and every node is emitted to the plugins in
+ *  the order it was parsed.  Nothing in the IR is changed once it has been
+ *  added, so the plugins see the whole MODULE, with all the offsets of every
+ *  AGGREGATE already determined.  The layout of each AGGREGATE is
+ *  determined once, when it is added, and every language is given the same
+ *  layout.
+ *
+ *  Statements outside of a MODULE, such as the comments in a copyright file,
+ *  are emitted as soon as they are added.
+ *
+ *  When there is more than one language with an output file and sink, each
+ *  language emits the IR on a thread of its own, with its own message
+ *  vector.  The
+ *  IR is not changed while it is being emitted, so the threads can all read
+ *  it at the same time.  The threads are all done before sdl_ir_end returns,
+ *  so the output for a MODULE is still between whatever was written before
+ *  and after it.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  Each language is emitted on a thread of its own.
+ *
+ *  V01.002	15-OCT-2026	Jonathan D. Belanger
+ *  The threads are given the language's output sink.  Languages are only
+ *  emitted on threads of their own when the context has output sinks, so
+ *  that everything written to an output file goes through the same sink.
+ *
+ *  V01.003	15-OCT-2026	Jonathan D. Belanger
+ *  An AGGREGATE is added as its layout, which is a flat array of its
+ *  members, and is emitted with sdl_call_layout.
+ *
+ *  V01.004	16-OCT-2026	Jonathan D. Belanger
+ *  Whatever is emitted is also given to the INCLUDE file being precompiled,
+ *  if there is one.
+ *
+ *  V01.005	16-OCT-2026	Jonathan D. Belanger
+ *  The time spent laying out AGGREGATEs and emitting, and the time each
+ *  language took to emit each MODULE, are counted for --stats.
+ *
+ *  V01.006	16-OCT-2026	Jonathan D. Belanger
+ *  Calls are recorded in the trace rather than written to standard output.
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "opensdl_defs.h"
+#include "library/language/opensdl_lang.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_sink.h"
+#include "library/common/opensdl_stats.h"
+#include "library/common/opensdl_trace.h"
+#include "library/utility/opensdl_plugin_funcs.h"
+#include "library/utility/opensdl_utility.h"
+#include "library/utility/opensdl_ir.h"
+#include "library/utility/opensdl_record.h"
+#include "library/utility/opensdl_precomp.h"
+#include "opensdl/opensdl_main.h"
+
+/*
+ * The following is used to emit the IR for one language on a thread of its
+ * own.
+ */
+typedef struct
+{
+    SDL_CONTEXT     *context;
+    uint32_t        langId;
+    bool            *langMask;
+    pthread_t       thread;
+    bool            started;
+    uint32_t        status;
+    SDL_MSG_VECTOR  msgVec[SDL_K_MSG_VEC_LEN];
+} SDL_IR_BACKEND;
+
+/*
+ * Local Prototypes
+ */
+static SDL_IR_NODE *_sdl_ir_node(SDL_CONTEXT *context, SDL_IR_TYPE type);
+static uint32_t _sdl_ir_emit_node(SDL_CONTEXT *context,
+                                  SDL_IR_NODE *node,
+                                  bool *langEna);
+static uint32_t _sdl_ir_emit_parallel(SDL_CONTEXT *context);
+static void *_sdl_ir_backend(void *arg);
+static SDL_LANG_LAYOUT *_sdl_ir_layout(SDL_CONTEXT *context,
+                                       SDL_AGGREGATE *aggregate);
+static uint32_t _sdl_ir_layout_count(SDL_QUEUE *members);
+static bool _sdl_ir_layout_fill(SDL_CONTEXT *context,
+                                SDL_LANG_LAYOUT *layout,
+                                SDL_QUEUE *members,
+                                int depth);
+static char *_sdl_ir_name(SDL_CONTEXT *context,
+                          char *id,
+                          char *prefix,
+                          char *tag,
+                          uint16_t *prefixLength);
+static bool _sdl_ir_type(SDL_CONTEXT *context,
+                         SDL_ITEM *item,
+                         SDL_LANG_MEMBER *entry);
+
+/*
+ * sdl_ir_begin
+ *  This function is called when a MODULE is parsed, after the arena for the
+ *  MODULE has been set up, to start a new, empty IR.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_ir_begin(SDL_CONTEXT *context)
+{
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_ir_begin");
+
+    sdl_ir_reset(context);
+    context->ir.open = true;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_ir_add
+ *  This function is called to add a node to the IR.  If there is no open IR,
+ *  because we are not in a MODULE, the node is emitted right away.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *  type:
+ *    A value indicating the type of node to be added.
+ *  data:
+ *    A pointer to the block for the node (ITEM, CONSTANT, ENUMERATE,
+ *    AGGREGATE, or ENTRY), or the text of a LITERAL line.  The text of a
+ *    LITERAL line is copied, and the layout of an AGGREGATE is determined.
+ *    This is NULL for MODULE and END_MODULE.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ *  Any status returned by the plugins, if the node was emitted.
+ */
+uint32_t sdl_ir_add(SDL_CONTEXT *context, SDL_IR_TYPE type, void *data)
+{
+    SDL_IR_NODE local;
+    SDL_IR_NODE *node = &local;
+    uint32_t retVal = SDL_NORMAL;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_ir_add");
+
+    if (context->ir.open == true)
+    {
+        node = _sdl_ir_node(context, type);
+        if ((node != NULL) && (type == IrLiteral))
+        {
+            data = sdl_strdup((char *) data);
+            if (data == NULL)
+            {
+                node = NULL;
+            }
+        }
+    }
+    else
+    {
+        memset(&local, 0, sizeof(local));
+        local.type = type;
+        local.langEna = context->langEnableVec;
+    }
+    if ((node != NULL) && (type == IrAggregate))
+    {
+        sdl_stats_begin(PhaseLayout);
+        data = _sdl_ir_layout(context, (SDL_AGGREGATE *) data);
+        sdl_stats_end();
+        if (data == NULL)
+        {
+            node = NULL;
+        }
+    }
+
+    if (node != NULL)
+    {
+        switch (type)
+        {
+            case IrItem:
+                node->item = (SDL_ITEM *) data;
+                break;
+
+            case IrConstant:
+                node->constant = (SDL_CONSTANT *) data;
+                break;
+
+            case IrEnumerate:
+                node->_enum = (SDL_ENUMERATE *) data;
+                break;
+
+            case IrAggregate:
+                node->layout = (SDL_LANG_LAYOUT *) data;
+                break;
+
+            case IrEntry:
+                node->entry = (SDL_ENTRY *) data;
+                break;
+
+            case IrLiteral:
+                node->literal = (char *) data;
+                break;
+
+            default:
+                break;
+        }
+        if (node == &local)
+        {
+            sdl_stats_begin(PhaseEmit);
+            sdl_precomp_node(context, node);
+            retVal = _sdl_ir_emit_node(context, node, node->langEna);
+            sdl_stats_end();
+        }
+    }
+    else
+    {
+        retVal = SDL_ABORT;
+        if (sdl_set_message(context->msgVec, 2, retVal, ENOMEM) != SDL_NORMAL)
+        {
+            retVal = SDL_ERREXIT;
+        }
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_ir_comment
+ *  This function is called to add a comment, outside of an AGGREGATE, to the
+ *  IR.  If there is no open IR, the comment is emitted right away.
+ *  Otherwise, the text of the comment is copied, because the caller frees
+ *  it.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *  comment:
+ *    A pointer to the text of the comment.
+ *  lineComment:
+ *    A boolean indicating that this is a line comment.
+ *  startComment:
+ *    A boolean indicating that this is the first line of a block comment.
+ *  middleComment:
+ *    A boolean indicating that this is a middle line of a block comment.
+ *  endComment:
+ *    A boolean indicating that this is the last line of a block comment.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ *  Any status returned by the plugins, if the comment was emitted.
+ */
+uint32_t sdl_ir_comment(SDL_CONTEXT *context,
+                        char *comment,
+                        bool lineComment,
+                        bool startComment,
+                        bool middleComment,
+                        bool endComment)
+{
+    SDL_IR_NODE local;
+    SDL_IR_NODE *node;
+    uint32_t retVal = SDL_NORMAL;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_ir_comment");
+
+    if (context->ir.open == false)
+    {
+        if (context->precomp != NULL)
+        {
+            memset(&local, 0, sizeof(local));
+            local.type = IrComment;
+            local.langEna = context->langEnableVec;
+            local.comment.text = comment;
+            local.comment.lineComment = lineComment;
+            local.comment.startComment = startComment;
+            local.comment.middleComment = middleComment;
+            local.comment.endComment = endComment;
+            sdl_precomp_node(context, &local);
+        }
+        retVal = sdl_call_comment(context->langEnableVec,
+                                  comment,
+                                  lineComment,
+                                  startComment,
+                                  middleComment,
+                                  endComment);
+    }
+    else
+    {
+        node = _sdl_ir_node(context, IrComment);
+        if (node != NULL)
+        {
+            node->comment.text = sdl_strdup(comment);
+            node->comment.lineComment = lineComment;
+            node->comment.startComment = startComment;
+            node->comment.middleComment = middleComment;
+            node->comment.endComment = endComment;
+        }
+        if ((node == NULL) || (node->comment.text == NULL))
+        {
+            retVal = SDL_ABORT;
+            if (sdl_set_message(context->msgVec,
+                                2,
+                                retVal,
+                                ENOMEM) != SDL_NORMAL)
+            {
+                retVal = SDL_ERREXIT;
+            }
+        }
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_ir_end
+ *  This function is called when END_MODULE is parsed.  The END_MODULE node
+ *  is added, which completes the IR, and then the whole IR is emitted to
+ *  the plugins.  If more than one language has an output file, each of
+ *  them is emitted on a thread of its own.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ *  Any status returned by the plugins.
+ */
+uint32_t sdl_ir_end(SDL_CONTEXT *context)
+{
+    SDL_STATS_CLOCK start;
+    uint32_t retVal;
+    uint32_t langCount = 0;
+    uint32_t langId = 0;
+    uint32_t ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_ir_end");
+
+    retVal = sdl_ir_add(context, IrModuleEnd, NULL);
+    if ((retVal == SDL_NORMAL) && (context->ir.open == true))
+    {
+        context->ir.open = false;
+        context->ir.complete = true;
+        sdl_stats_begin(PhaseEmit);
+        if (context->precomp != NULL)
+        {
+            sdl_precomp_module(context);
+        }
+        if ((context->langFP != NULL) && (context->langSink != NULL))
+        {
+            for (ii = 0; ii < sdl_plugin_count(); ii++)
+            {
+                if (context->langFP[ii] != NULL)
+                {
+                    langId = ii;
+                    langCount++;
+                }
+            }
+        }
+        if (langCount > 1)
+        {
+            retVal = _sdl_ir_emit_parallel(context);
+        }
+        else
+        {
+            sdl_stats_clock(&start);
+            retVal = sdl_ir_emit(context, &context->ir, NULL);
+            if (langCount == 1)
+            {
+                sdl_stats_lang(&context->stats, langId, &start);
+            }
+        }
+        sdl_stats_end();
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_ir_emit
+ *  This function is called to emit each of the nodes in a completed IR to
+ *  the plugins, in order, for the languages that were enabled when each node
+ *  was added.  If a mask is supplied, only the languages in it are emitted.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *  ir:
+ *    A pointer to the completed IR.
+ *  langMask:
+ *    A pointer to an array containing a flag for each of the languages to be
+ *    emitted, or NULL to emit all of them.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ *  Any status returned by the plugins.
+ */
+uint32_t sdl_ir_emit(SDL_CONTEXT *context, SDL_MODULE_IR *ir, bool *langMask)
+{
+    SDL_IR_NODE *node = (SDL_IR_NODE *) ir->nodes.flink;
+    bool *langEna = NULL;
+    uint32_t langCount = sdl_plugin_count();
+    uint32_t retVal = SDL_NORMAL;
+    uint32_t ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_ir_emit");
+
+    if (langMask != NULL)
+    {
+        langEna = sdl_calloc(langCount + 1, sizeof(bool));
+        if (langEna == NULL)
+        {
+            retVal = SDL_ABORT;
+            if (sdl_set_message(context->msgVec,
+                                2,
+                                retVal,
+                                ENOMEM) != SDL_NORMAL)
+            {
+                retVal = SDL_ERREXIT;
+            }
+        }
+    }
+    while ((node != (SDL_IR_NODE *) &ir->nodes) && (retVal == SDL_NORMAL))
+    {
+        if (langMask == NULL)
+        {
+            retVal = _sdl_ir_emit_node(context, node, node->langEna);
+        }
+        else
+        {
+            bool enabled = false;
+
+            for (ii = 0; ii < langCount; ii++)
+            {
+                langEna[ii] = node->langEna[ii] && langMask[ii];
+                enabled |= langEna[ii];
+            }
+            if (enabled == true)
+            {
+                retVal = _sdl_ir_emit_node(context, node, langEna);
+            }
+        }
+        node = (SDL_IR_NODE *) node->queue.flink;
+    }
+    if (langEna != NULL)
+    {
+        sdl_free(langEna);
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_ir_reset
+ *  This function is called to discard the IR, without emitting it.  This is
+ *  done when a new MODULE is started, and when a parse ends, so that a MODULE
+ *  that was not completed because of an error does not generate any output.
+ *  The nodes themselves are released with the arena.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_ir_reset(SDL_CONTEXT *context)
+{
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_ir_reset");
+
+    SDL_Q_INIT(&context->ir.nodes);
+    context->ir.lastLangEna = NULL;
+    context->ir.nodeCount = 0;
+    context->ir.open = false;
+    context->ir.complete = false;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/************************************************************************/
+/* Local Functions                            */
+/************************************************************************/
+
+/*
+ * _sdl_ir_node
+ *  This function is called to carve a node out of the context's arena and
+ *  queue it to the end of the IR.  The languages currently enabled are
+ *  saved with the node.  Since these change only at IFLANGUAGE and
+ *  END_IFLANGUAGE, the copy saved with the previous node is used again, when
+ *  it is still the same.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *  type:
+ *    A value indicating the type of node to be added.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:           An error occurred allocating memory.
+ *  !NULL:          A pointer to the queued node.
+ */
+static SDL_IR_NODE *_sdl_ir_node(SDL_CONTEXT *context, SDL_IR_TYPE type)
+{
+    SDL_MODULE_IR *ir = &context->ir;
+    SDL_IR_NODE *retVal;
+    size_t langSize = sdl_plugin_count() * sizeof(bool);
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("_sdl_ir_node");
+
+    if ((ir->lastLangEna == NULL) ||
+        (memcmp(ir->lastLangEna, context->langEnableVec, langSize) != 0))
+    {
+        bool *langEna = sdl_arena_alloc(&context->arena, langSize + 1);
+
+        if (langEna != NULL)
+        {
+            memcpy(langEna, context->langEnableVec, langSize);
+            ir->lastLangEna = langEna;
+        }
+        else
+        {
+            ir->lastLangEna = NULL;
+        }
+    }
+    if (ir->lastLangEna != NULL)
+    {
+        retVal = sdl_arena_alloc(&context->arena, sizeof(SDL_IR_NODE));
+    }
+    else
+    {
+        retVal = NULL;
+    }
+    if (retVal != NULL)
+    {
+        retVal->type = type;
+        retVal->langEna = ir->lastLangEna;
+        SDL_INSQUE(&ir->nodes, &retVal->queue);
+        ir->nodeCount++;
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_ir_emit_node
+ *  This function is called to emit a single node to the plugins.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *  node:
+ *    A pointer to the node to be emitted.
+ *  langEna:
+ *    A pointer to the languages to which the node is to be emitted.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  Any status returned by the plugins.
+ */
+static uint32_t _sdl_ir_emit_node(SDL_CONTEXT *context,
+                                  SDL_IR_NODE *node,
+                                  bool *langEna)
+{
+    uint32_t retVal = SDL_NORMAL;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("_sdl_ir_emit_node");
+
+    switch (node->type)
+    {
+        case IrComment:
+            retVal = sdl_call_comment(langEna,
+                                      node->comment.text,
+                                      node->comment.lineComment,
+                                      node->comment.startComment,
+                                      node->comment.middleComment,
+                                      node->comment.endComment);
+            break;
+
+        case IrModule:
+            retVal = sdl_call_module(langEna, context);
+            break;
+
+        case IrItem:
+            retVal = sdl_call_item(langEna, node->item, context);
+            break;
+
+        case IrConstant:
+            retVal = sdl_call_constant(langEna, node->constant, context);
+            break;
+
+        case IrEnumerate:
+            retVal = sdl_call_enumerate(langEna, node->_enum, context);
+            break;
+
+        case IrAggregate:
+            retVal = sdl_call_layout(langEna, node->layout, context);
+            break;
+
+        case IrEntry:
+            retVal = sdl_call_entry(langEna, node->entry, context);
+            break;
+
+        case IrLiteral:
+            retVal = sdl_call_literal(langEna, node->literal);
+            break;
+
+        case IrModuleEnd:
+            retVal = sdl_call_moduleEnd(langEna, context);
+            break;
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_ir_emit_parallel
+ *  This function is called to emit the completed IR for each of the
+ *  languages with an output file, each on a thread of its own, and wait for
+ *  all of them to be done.  If a thread cannot be started, that language is
+ *  emitted on the current thread.  If a language fails, the message it
+ *  reported is moved to the context's message vector.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ *  Any status returned by the plugins.
+ */
+static uint32_t _sdl_ir_emit_parallel(SDL_CONTEXT *context)
+{
+    SDL_IR_BACKEND *backends;
+    uint32_t langCount = sdl_plugin_count();
+    uint32_t retVal = SDL_NORMAL;
+    uint32_t ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("_sdl_ir_emit_parallel");
+
+    backends = sdl_calloc(langCount, sizeof(SDL_IR_BACKEND));
+    if (backends == NULL)
+    {
+        retVal = SDL_ABORT;
+        if (sdl_set_message(context->msgVec, 2, retVal, ENOMEM) != SDL_NORMAL)
+        {
+            retVal = SDL_ERREXIT;
+        }
+        return(retVal);
+    }
+
+    /*
+     * Start a thread for each language with an output file.
+     */
+    for (ii = 0; ii < langCount; ii++)
+    {
+        SDL_IR_BACKEND *backend = &backends[ii];
+
+        if (context->langFP[ii] == NULL)
+        {
+            continue;
+        }
+        backend->context = context;
+        backend->langId = ii;
+        backend->langMask = sdl_calloc(langCount, sizeof(bool));
+        if (backend->langMask == NULL)
+        {
+            backend->status = SDL_ABORT;
+            sdl_set_message(backend->msgVec, 2, backend->status, ENOMEM);
+            continue;
+        }
+        backend->langMask[ii] = true;
+        if (pthread_create(&backend->thread,
+                           NULL,
+                           _sdl_ir_backend,
+                           backend) == 0)
+        {
+            backend->started = true;
+        }
+        else
+        {
+
+            /*
+             * Emit this language right here, and then give the plugin back
+             * the context's message vector for this thread.
+             */
+            _sdl_ir_backend(backend);
+            sdl_plugin_attach(ii,
+                              context->langFP[ii],
+                              &context->langSink[ii],
+                              context->msgVec);
+        }
+    }
+
+    /*
+     * Wait for all the threads to be done.  The first language to have
+     * failed determines the status returned.
+     */
+    for (ii = 0; ii < langCount; ii++)
+    {
+        SDL_IR_BACKEND *backend = &backends[ii];
+
+        if (backend->started == true)
+        {
+            pthread_join(backend->thread, NULL);
+        }
+        if ((backend->status != SDL_NORMAL) && (retVal == SDL_NORMAL))
+        {
+            retVal = backend->status;
+            memcpy(context->msgVec, backend->msgVec, sizeof(backend->msgVec));
+        }
+        if (backend->langMask != NULL)
+        {
+            sdl_free(backend->langMask);
+        }
+    }
+    sdl_free(backends);
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_ir_backend
+ *  This function is the start of a thread that emits the completed IR for a
+ *  single language.  The plugin is given the language's output file and the
+ *  thread's own message vector first.
+ *
+ * Input Parameters:
+ *  arg:
+ *    A pointer to the backend structure for the language.
+ *
+ * Output Parameters:
+ *  arg:
+ *    A pointer to the backend structure, with the status of the emission.
+ *
+ * Return Values:
+ *  NULL.
+ */
+static void *_sdl_ir_backend(void *arg)
+{
+    SDL_IR_BACKEND *backend = (SDL_IR_BACKEND *) arg;
+    SDL_CONTEXT *context = backend->context;
+    SDL_STATS_CLOCK start;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("_sdl_ir_backend");
+    sdl_stats_clock(&start);
+
+    backend->status = sdl_plugin_attach(backend->langId,
+                                        context->langFP[backend->langId],
+                                        &context->langSink[backend->langId],
+                                        backend->msgVec);
+    if (backend->status != SDL_NORMAL)
+    {
+        sdl_set_message(backend->msgVec, 1, backend->status);
+    }
+    else
+    {
+        backend->status = sdl_ir_emit(context,
+                                      &context->ir,
+                                      backend->langMask);
+    }
+    sdl_stats_lang(&context->stats, backend->langId, &start);
+
+    /*
+     * Return back to the caller.
+     */
+    return(NULL);
+}
+
+/*
+ * _sdl_ir_layout
+ *  This function is called to determine the layout of an AGGREGATE.  The
+ *  members are counted first, so that the layout can be carved out of the
+ *  arena in one piece.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *  aggregate:
+ *    A pointer to the completed AGGREGATE.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:   An error occurred allocating memory.
+ *  !NULL:  A pointer to the layout of the AGGREGATE.
+ */
+static SDL_LANG_LAYOUT *_sdl_ir_layout(SDL_CONTEXT *context,
+                                       SDL_AGGREGATE *aggregate)
+{
+    SDL_LANG_LAYOUT *retVal;
+    uint32_t count = _sdl_ir_layout_count(&aggregate->members) + 2;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("_sdl_ir_layout");
+
+    retVal = sdl_arena_alloc(&context->arena,
+                             sizeof(SDL_LANG_LAYOUT) +
+                             (count * sizeof(SDL_LANG_MEMBER)));
+    if (retVal != NULL)
+    {
+        SDL_LANG_MEMBER *start;
+        bool ok;
+
+        retVal->aggregate = aggregate;
+        retVal->members = (SDL_LANG_MEMBER *) &retVal[1];
+        retVal->memberCount = 0;
+
+        /*
+         * The AGGREGATE is started, its members are added one level deeper,
+         * and then it is ended.
+         */
+        start = &retVal->members[retVal->memberCount++];
+        memset(start, 0, sizeof(SDL_LANG_MEMBER));
+        start->param.aggr = aggregate;
+        start->type = LangAggregate;
+        start->name = _sdl_ir_name(context,
+                                   aggregate->id,
+                                   aggregate->marker,
+                                   aggregate->tag,
+                                   &start->prefixLength);
+        start->size = aggregate->size;
+        start->typeID = aggregate->aggType;
+        start->baseType = aggregate->aggType;
+        start->_unsigned = aggregate->_unsigned;
+        if (aggregate->dimension == true)
+        {
+            start->elements = aggregate->hbound - aggregate->lbound + 1;
+        }
+        ok = (start->name != NULL) &&
+             _sdl_ir_layout_fill(context, retVal, &aggregate->members, 1);
+        if (ok == true)
+        {
+            retVal->members[retVal->memberCount] = *start;
+            retVal->members[retVal->memberCount++].ending = true;
+        }
+        else
+        {
+            retVal = NULL;
+        }
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_ir_layout_count
+ *  This function is called to count the entries needed in the layout for
+ *  the members of an AGGREGATE or subaggregate.  A subaggregate needs an
+ *  entry to start it and one to end it.
+ *
+ * Input Parameters:
+ *  members:
+ *    A pointer to the queue of members to be counted.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  A value indicating the number of entries needed.
+ */
+static uint32_t _sdl_ir_layout_count(SDL_QUEUE *members)
+{
+    SDL_MEMBERS *member = (SDL_MEMBERS *) members->flink;
+    uint32_t retVal = 0;
+
+    while (member != (SDL_MEMBERS *) members)
+    {
+        if (sdl_isItem(member) == false)
+        {
+            retVal += _sdl_ir_layout_count(&member->subaggr.members) + 2;
+        }
+        else
+        {
+            retVal++;
+        }
+        member = (SDL_MEMBERS *) member->header.queue.flink;
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_ir_layout_fill
+ *  This function is called to add an entry to the layout for each of the
+ *  members of an AGGREGATE or subaggregate.  A subaggregate is added as a
+ *  start, each of its members one level deeper, and an end.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *  layout:
+ *    A pointer to the layout being filled in.
+ *  members:
+ *    A pointer to the queue of members to be added.
+ *  depth:
+ *    A value indicating the depth of the members.
+ *
+ * Output Parameters:
+ *  layout:
+ *    A pointer to the layout, with the members added to it.
+ *
+ * Return Values:
+ *  true:   Normal Successful Completion.
+ *  false:  An error occurred allocating memory.
+ */
+static bool _sdl_ir_layout_fill(SDL_CONTEXT *context,
+                                SDL_LANG_LAYOUT *layout,
+                                SDL_QUEUE *members,
+                                int depth)
+{
+    SDL_MEMBERS *member = (SDL_MEMBERS *) members->flink;
+    bool retVal = true;
+
+    while ((member != (SDL_MEMBERS *) members) && (retVal == true))
+    {
+        SDL_LANG_MEMBER *entry = &layout->members[layout->memberCount++];
+
+        memset(entry, 0, sizeof(SDL_LANG_MEMBER));
+        entry->depth = depth;
+        entry->offset = member->offset;
+        if (sdl_isItem(member) == false)
+        {
+            SDL_SUBAGGR *subaggr = &member->subaggr;
+
+            entry->param.subaggr = subaggr;
+            entry->type = LangSubaggregate;
+            entry->name = _sdl_ir_name(context,
+                                       subaggr->id,
+                                       subaggr->prefix,
+                                       subaggr->tag,
+                                       &entry->prefixLength);
+            entry->size = subaggr->size;
+            entry->typeID = subaggr->aggType;
+            entry->baseType = subaggr->aggType;
+            entry->_unsigned = subaggr->_unsigned;
+            if (subaggr->dimension == true)
+            {
+                entry->elements = subaggr->hbound - subaggr->lbound + 1;
+            }
+            retVal = (entry->name != NULL) &&
+                     _sdl_ir_layout_fill(context,
+                                         layout,
+                                         &subaggr->members,
+                                         depth + 1);
+            if (retVal == true)
+            {
+                layout->members[layout->memberCount] = *entry;
+                layout->members[layout->memberCount++].ending = true;
+            }
+        }
+        else if (sdl_isComment(member) == true)
+        {
+            entry->param.comment = &member->comment;
+            entry->type = LangComment;
+        }
+        else
+        {
+            SDL_ITEM *item = &member->item;
+
+            entry->param.item = item;
+            entry->type = LangItem;
+            entry->name = _sdl_ir_name(context,
+                                       item->id,
+                                       item->prefix,
+                                       item->tag,
+                                       &entry->prefixLength);
+            entry->size = item->size;
+            entry->length = item->length;
+            entry->bitOffset = item->bitOffset;
+            entry->_unsigned = item->_unsigned;
+            if (item->dimension == true)
+            {
+                entry->elements = item->hbound - item->lbound + 1;
+            }
+            retVal = (entry->name != NULL) &&
+                     _sdl_ir_type(context, item, entry);
+        }
+        member = (SDL_MEMBERS *) member->header.queue.flink;
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_ir_name
+ *  This function is called to put together the name to be output for an
+ *  AGGREGATE, subaggregate, ITEM, or DECLARE.  The prefix is only used when
+ *  it is not being suppressed, and the tag, followed by an underscore, is
+ *  only used when there is a prefix and the tag is not empty and not being
+ *  suppressed.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *  id:
+ *    A pointer to the identifier.
+ *  prefix:
+ *    A pointer to the prefix.  This may be NULL.
+ *  tag:
+ *    A pointer to the tag.  This may be NULL.
+ *
+ * Output Parameters:
+ *  prefixLength:
+ *    A pointer to a value to receive the number of characters at the start
+ *    of the name that came from the prefix.
+ *
+ * Return Values:
+ *  NULL:   An error occurred allocating memory.
+ *  !NULL:  A pointer to the name, carved out of the arena.
+ */
+static char *_sdl_ir_name(SDL_CONTEXT *context,
+                          char *id,
+                          char *prefix,
+                          char *tag,
+                          uint16_t *prefixLength)
+{
+    char *retVal;
+    size_t idLen = strlen(id);
+    size_t prefixLen = 0;
+    size_t tagLen = 0;
+
+    if (prefix != NULL)
+    {
+        if (context->argument[ArgSuppressPrefix].on == false)
+        {
+            prefixLen = strlen(prefix);
+        }
+        if ((tag != NULL) && (context->argument[ArgSuppressTag].on == false))
+        {
+            tagLen = strlen(tag);
+        }
+    }
+    retVal = sdl_arena_alloc(&context->arena,
+                             prefixLen + tagLen + idLen + 2);
+    if (retVal != NULL)
+    {
+        char *ptr = retVal;
+
+        if (prefixLen > 0)
+        {
+            memcpy(ptr, prefix, prefixLen);
+            ptr += prefixLen;
+        }
+        if (tagLen > 0)
+        {
+            memcpy(ptr, tag, tagLen);
+            ptr += tagLen;
+            *ptr++ = '_';
+        }
+        memcpy(ptr, id, idLen + 1);
+        *prefixLength = prefixLen;
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_ir_type
+ *  This function is called to resolve the type of an ITEM in an AGGREGATE.
+ *  A user type that is an ITEM or an AGGREGATE is resolved to the type it
+ *  was declared as, and an ADDRESS or POINTER to the resolved type of what
+ *  it points to.  A user type that is a DECLARE is not resolved any further,
+ *  but its name is put together.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure where we maintain information about
+ *    the current parsing.
+ *  item:
+ *    A pointer to the ITEM.
+ *
+ * Output Parameters:
+ *  entry:
+ *    A pointer to the layout entry for the ITEM, to receive the resolved
+ *    types.
+ *
+ * Return Values:
+ *  true:   Normal Successful Completion.
+ *  false:  An error occurred allocating memory.
+ */
+static bool _sdl_ir_type(SDL_CONTEXT *context,
+                         SDL_ITEM *item,
+                         SDL_LANG_MEMBER *entry)
+{
+    int typeID = item->type;
+    int subType = item->subType;
+    bool resolved = false;
+    bool retVal = true;
+
+    entry->typeID = -1;
+    entry->baseType = -1;
+    while ((resolved == false) && (typeID >= 0))
+    {
+        if ((typeID == SDL_K_TYPE_NONE) ||
+            ((typeID >= SDL_K_BASE_TYPE_MIN) &&
+             (typeID <= SDL_K_BASE_TYPE_MAX)))
+        {
+            if (entry->typeID == -1)
+            {
+                entry->typeID = typeID;
+            }
+            if ((typeID == SDL_K_TYPE_ADDR) || (typeID == SDL_K_TYPE_PTR))
+            {
+                typeID = subType;
+                subType = SDL_K_TYPE_NONE;
+            }
+            else
+            {
+                entry->baseType = typeID;
+                resolved = true;
+            }
+        }
+        else if ((typeID >= SDL_K_DECLARE_MIN) &&
+                 (typeID <= SDL_K_DECLARE_MAX))
+        {
+            SDL_DECLARE *myDeclare =
+                sdl_symtab_lookup_id(&context->declares.symtab, typeID);
+
+            if (entry->typeID == -1)
+            {
+                entry->typeID = typeID;
+            }
+            if (myDeclare != NULL)
+            {
+                entry->baseType = typeID;
+                entry->typeName = _sdl_ir_name(context,
+                                               myDeclare->id,
+                                               myDeclare->prefix,
+                                               myDeclare->tag,
+                                               &entry->typePrefixLength);
+                retVal = entry->typeName != NULL;
+            }
+            resolved = true;
+        }
+        else if ((typeID >= SDL_K_ITEM_MIN) && (typeID <= SDL_K_ITEM_MAX))
+        {
+            SDL_ITEM *myItem =
+                sdl_symtab_lookup_id(&context->items.symtab, typeID);
+
+            typeID = (myItem != NULL) ? myItem->type : -1;
+        }
+        else if ((typeID >= SDL_K_AGGREGATE_MIN) &&
+                 (typeID <= SDL_K_AGGREGATE_MAX))
+        {
+            SDL_AGGREGATE *myAggregate =
+                sdl_symtab_lookup_id(&context->aggregates.symtab, typeID);
+
+            typeID = (myAggregate != NULL) ? myAggregate->type : -1;
+        }
+        else
+        {
+            resolved = true;
+        }
+    }
+
+    /*
+     * Return the results of this call back to the caller.
+     */
+    return(retVal);
+}
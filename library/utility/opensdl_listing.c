@@ -28,6 +28,19 @@
  *
  *  V01.000 25-AUG-2018 Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001 15-OCT-2026 Jonathan D. Belanger
+ *  Pending message text is kept on the heap, as it can outlive the MODULE.
+ *
+ *  V01.002 15-OCT-2026 Jonathan D. Belanger
+ *  The listing state is kept in the context, rather than in local variables,
+ *  so that more than one listing can be generated at a time.
+ *
+ *  V01.003 16-OCT-2026 Jonathan D. Belanger
+ *  The time spent in each of the interface functions is counted for --stats.
+ *
+ *  V01.004 16-OCT-2026 Jonathan D. Belanger
+ *  Calls are recorded in the trace rather than written to standard output.
  */
 #include <errno.h>
 #include <stdio.h>
@@ -38,25 +51,16 @@
 #include "opensdl_defs.h"
 #include "library/common/opensdl_blocks.h"
 #include "library/common/opensdl_message.h"
+#include "library/common/opensdl_stats.h"
+#include "library/common/opensdl_trace.h"
 #include "opensdl/opensdl_main.h"
 
 /*
- * Local variables used while generating a listing file.
+ * Local definitions used while generating a listing file.  The page width is
+ * defined with the listing state, in opensdl_defs.h.
  */
-typedef char *SDL_MESSAGE_TXT;
-static SDL_MESSAGE_TXT *messages = NULL;
-static int messagesIndex = 0;
-static int messagesSize = 0;
-#define SDL_PAGE_WIDTH    132
 #define SDL_PAGE_LENGTH    66
 #define SDL_PAGE_LOC    122
-typedef char SDL_HEADER_DEF[SDL_PAGE_WIDTH + 1];
-static SDL_HEADER_DEF sdl_listing_header[2];
-static char xBuf[SDL_PAGE_WIDTH + 1];
-static int xBufLoc = 0;
-static uint32_t listLine = 1;
-static uint32_t pageLine = 1;
-static uint32_t pageNo = 1;
 static char *_sdl_months_str[] =
 {
     "JAN",
@@ -76,8 +80,8 @@ static char *_sdl_months_str[] =
 /*
  * Local Prototypes.
  */
-static void _sdl_end_page(FILE *fp);
-static void _sdl_msg_list(FILE *fp);
+static void _sdl_end_page(SDL_LISTING *listing);
+static void _sdl_msg_list(SDL_LISTING *listing);
 
 /*
  * sdl_open_list
@@ -102,12 +106,10 @@ FILE *sdl_open_list(SDL_CONTEXT *context)
     FILE *retVal;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_open_list\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_open_list");
+    sdl_stats_begin(PhaseListing);
 
     /*
      * Open the listing file for write.
@@ -120,12 +122,22 @@ FILE *sdl_open_list(SDL_CONTEXT *context)
      */
     if (retVal != NULL)
     {
+        SDL_LISTING *listing = &context->listing;
         int ii, len;
 
         /*
-         * Save the file pointer for the listing file in the context block.
+         * Save the file pointer for the listing file in the context block,
+         * start at the top of the first page, and turn the listing on.
          */
-        listingFP = retVal;
+        listing->fp = retVal;
+        listing->messages = NULL;
+        listing->messagesIndex = 0;
+        listing->messagesSize = 0;
+        listing->xBufLoc = 0;
+        listing->listLine = 1;
+        listing->pageLine = 1;
+        listing->pageNo = 1;
+        listing->on = true;
 
         /*
          * Initialize the first line for the header written at the start of
@@ -133,7 +145,7 @@ FILE *sdl_open_list(SDL_CONTEXT *context)
          * opensdl utility was executed, the name and version of the utility
          * itself, and the page number.
          */
-        sprintf(sdl_listing_header[0],
+        sprintf(listing->header[0],
                 "%*s%02d-%s-%04d %02d:%02d:%02d OpenSDL %c%d.%d-%d",
                 58,
                 "",
@@ -147,19 +159,19 @@ FILE *sdl_open_list(SDL_CONTEXT *context)
                 SDL_K_VERSION_MAJOR,
                 SDL_K_VERSION_MINOR,
                 SDL_K_VERSION_LEVEL);
-        len = strlen(sdl_listing_header[0]);
+        len = strlen(listing->header[0]);
         for (ii = len; ii < SDL_PAGE_LOC; ii++)
         {
-            sdl_listing_header[0][ii] = ' ';
+            listing->header[0][ii] = ' ';
         }
-        strcpy(&sdl_listing_header[0][SDL_PAGE_LOC], "Page ");
+        strcpy(&listing->header[0][SDL_PAGE_LOC], "Page ");
 
         /*
          * Initialize the second line for the header written at the start of
          * each listing page.  The second line contains the modify date and
          * time for the input file and the fill path of the input file.
          */
-        sprintf(sdl_listing_header[1],
+        sprintf(listing->header[1],
                 "%*s%02d-%s-%04d %02d:%02d:%02d %.*s",
                 58,
                 "",
@@ -173,6 +185,8 @@ FILE *sdl_open_list(SDL_CONTEXT *context)
                 context->inputPath);
     }
 
+    sdl_stats_end();
+
     /*
      * Return the results of this call back to the caller.
      */
@@ -189,8 +203,8 @@ FILE *sdl_open_list(SDL_CONTEXT *context)
  *  form-feed character to move to the next page.
  *
  * Input Parameters:
- *  fp:
- *    The address of the file pointer associated with the listing file.
+ *  listing:
+ *    A pointer to the listing state, which includes the listing file.
  *  buf:
  *    A pointer to the buffer of characters to be written out to the listing
  *    file.
@@ -205,18 +219,16 @@ FILE *sdl_open_list(SDL_CONTEXT *context)
  * Return Values:
  *  None.
  */
-void sdl_write_list(FILE *fp, char *buf, size_t len)
+void sdl_write_list(SDL_LISTING *listing, char *buf, size_t len)
 {
     int ii;
     size_t myLen = (len == 0) ? strlen(buf) : len;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_write_list\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_write_list");
+    sdl_stats_begin(PhaseListing);
 
     /*
      * Scan through the buffer, outputting lines as we go.  NOTE: We may end up
@@ -229,17 +241,19 @@ void sdl_write_list(FILE *fp, char *buf, size_t len)
         /*
          * If we are on the first line of a page, then display the listing headers.
          */
-        if (pageLine == 1)
+        if (listing->pageLine == 1)
         {
-            _sdl_end_page(fp);
+            _sdl_end_page(listing);
         }
 
         /*
          * If we are starting a new line, then insert the line number.
          */
-        if (xBufLoc == 0)
+        if (listing->xBufLoc == 0)
         {
-            xBufLoc = sprintf(xBuf, " %6d ", listLine);
+            listing->xBufLoc = sprintf(listing->xBuf,
+                                       " %6d ",
+                                       listing->listLine);
         }
 
         /*
@@ -256,14 +270,14 @@ void sdl_write_list(FILE *fp, char *buf, size_t len)
          */
         if (buf[ii] == '\n')
         {
-            xBuf[xBufLoc] = '\0';
-            fprintf(fp, "%s\n", xBuf);
-            listLine++;
-            pageLine++;
-            xBufLoc = 0;
-            if (messagesIndex > 0)
+            listing->xBuf[listing->xBufLoc] = '\0';
+            fprintf(listing->fp, "%s\n", listing->xBuf);
+            listing->listLine++;
+            listing->pageLine++;
+            listing->xBufLoc = 0;
+            if (listing->messagesIndex > 0)
             {
-                _sdl_msg_list(fp);
+                _sdl_msg_list(listing);
             }
             continue;
         }
@@ -272,9 +286,9 @@ void sdl_write_list(FILE *fp, char *buf, size_t len)
          * If the character is a form-feed, or we have exceeded the number of
          * lines in a page, then insert a form-feed and reset the pageLine.
          */
-        if ((buf[ii] == '\f') || (pageLine > SDL_PAGE_LENGTH))
+        if ((buf[ii] == '\f') || (listing->pageLine > SDL_PAGE_LENGTH))
         {
-            pageLine = 1;
+            listing->pageLine = 1;
             continue;
         }
 
@@ -282,12 +296,14 @@ void sdl_write_list(FILE *fp, char *buf, size_t len)
          * We have just a regular character.  If there is room, then add it to
          * the output buffer.  Otherwise, just swallow it.
          */
-        if (xBufLoc < SDL_PAGE_WIDTH)
+        if (listing->xBufLoc < SDL_PAGE_WIDTH)
         {
-            xBuf[xBufLoc++] = buf[ii];
+            listing->xBuf[listing->xBufLoc++] = buf[ii];
         }
     }
 
+    sdl_stats_end();
+
     /*
      * Return back to the caller.
      */
@@ -304,8 +320,8 @@ void sdl_write_list(FILE *fp, char *buf, size_t len)
  *  error for any particular line of code.
  *
  * Input Parameters:
- *  fp:
- *    The address of the file pointer associated with the listing file.
+ *  listing:
+ *    A pointer to the listing state, which includes the listing file.
  *  msgText:
  *    A pointer to the string containing all the information needed to
  *    display the error text.
@@ -316,42 +332,42 @@ void sdl_write_list(FILE *fp, char *buf, size_t len)
  * Return Values:
  *  None.
  */
-void sdl_write_err(FILE *fp, char *msgText)
+void sdl_write_err(SDL_LISTING *listing, char *msgText)
 {
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_write_err\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_write_err");
+    sdl_stats_begin(PhaseListing);
 
     /*
      * If we are in the process of producing a listing line, then store the
      * message text to be used later.
      */
-    if (messagesIndex >= messagesSize)
+    if (listing->messagesIndex >= listing->messagesSize)
     {
-        size_t    size = sizeof(SDL_MESSAGE_TXT) * (messagesSize + 1);
+        size_t    size = sizeof(char *) * (listing->messagesSize + 1);
 
-        messages = sdl_realloc(messages, size);;
-        if (messages != NULL)
+        listing->messages = sdl_realloc(listing->messages, size);;
+        if (listing->messages != NULL)
         {
-            messagesSize++;
+            listing->messagesSize++;
         }
     }
-    messages[messagesIndex++] = sdl_strdup(msgText);
+    listing->messages[listing->messagesIndex++] = sdl_strdup_heap(msgText);
 
     /*
      * If we are already at the beginning of a line, then we can display the
      * message text now.
      */
-    if (xBufLoc <= 8)
+    if (listing->xBufLoc <= 8)
     {
-        _sdl_msg_list(fp);
+        _sdl_msg_list(listing);
     }
 
+    sdl_stats_end();
+
     /*
      * Return back to the caller.
      */
@@ -377,32 +393,52 @@ void sdl_write_err(FILE *fp, char *msgText)
  */
 void sdl_close_list(SDL_CONTEXT *context)
 {
+    SDL_LISTING *listing = &context->listing;
+    int ii;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
+    SDL_TRACE("sdl_close_list");
+    sdl_stats_begin(PhaseListing);
+
+    /*
+     * If there is anything in the output buffer, write it out now.
+     */
+    if (listing->xBufLoc > 0)
     {
-        printf("%s:%d:sdl_close_list\n", __FILE__, __LINE__);
+        listing->xBuf[listing->xBufLoc] = '\0';
+        fprintf(listing->fp, "%s\n", listing->xBuf);
+        listing->xBufLoc = 0;
     }
 
     /*
-     * If there is anything in the output buffer, write it out now.
+     * Return any message text that never made it out, and the array of
+     * pointers to it.
      */
-    if (xBufLoc > 0)
+    for (ii = 0; ii < listing->messagesIndex; ii++)
     {
-        xBuf[xBufLoc] = '\0';
-        fprintf(listingFP, "%s\n", xBuf);
+        sdl_free(listing->messages[ii]);
     }
+    if (listing->messages != NULL)
+    {
+        sdl_free(listing->messages);
+        listing->messages = NULL;
+    }
+    listing->messagesIndex = 0;
+    listing->messagesSize = 0;
 
     /*
      * All that is left to do is close the file, if it was opened.
      */
-    if (listingFP != NULL)
+    if (listing->fp != NULL)
     {
-        fclose(listingFP);
-        listingFP = NULL;
+        fclose(listing->fp);
+        listing->fp = NULL;
     }
+    listing->on = false;
+
+    sdl_stats_end();
 
     /*
      * Return back to the caller.
@@ -415,8 +451,8 @@ void sdl_close_list(SDL_CONTEXT *context)
  *  This function is called to end the current page and start the next.
  *
  * Input Parameters:
- *  fp:
- *    The address of the file pointer associated with the listing file.
+ *  listing:
+ *    A pointer to the listing state, which includes the listing file.
  *
  * Output Parameters:
  *  None.
@@ -424,33 +460,30 @@ void sdl_close_list(SDL_CONTEXT *context)
  * Return Values:
  *  None.
  */
-static void _sdl_end_page(FILE *fp)
+static void _sdl_end_page(SDL_LISTING *listing)
 {
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_end_page\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_end_page");
 
     /*
      * For the first line of the file, we do not write a form-feed.  All other
      * times, we need a form-feed, so that we can move to the next page.
      */
-    if (listLine > 1)
+    if (listing->listLine > 1)
     {
-        fprintf(fp, "\f\n");
+        fprintf(listing->fp, "\f\n");
     }
 
     /*
      * Print the header at the top of each page.
      */
-    fprintf(fp, "%s%4d\n", sdl_listing_header[0], pageNo++);
-    pageLine++;
-    fprintf(fp, "%s\n", sdl_listing_header[1]);
-    pageLine++;
+    fprintf(listing->fp, "%s%4d\n", listing->header[0], listing->pageNo++);
+    listing->pageLine++;
+    fprintf(listing->fp, "%s\n", listing->header[1]);
+    listing->pageLine++;
 
     /*
      * Return back to the caller.
@@ -467,8 +500,8 @@ static void _sdl_end_page(FILE *fp)
  *  file, and insert a page break along with the page headers, as needed.
  *
  * Input Parameters:
- *  fp:
- *    The address of the file pointer associated with the listing file.
+ *  listing:
+ *    A pointer to the listing state, which includes the listing file.
  *
  * Output Parameters:
  *  None.
@@ -476,34 +509,31 @@ static void _sdl_end_page(FILE *fp)
  * Return Values:
  *  None.
  */
-static void _sdl_msg_list(FILE *fp)
+static void _sdl_msg_list(SDL_LISTING *listing)
 {
     int ii, jj, len, pageRoom, msgLines;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_msg_list\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_msg_list");
 
     /*
      * Determine if there is enough room to display the message in it's
      * entirety.  Each message in the messages array is considered separately.
      */
-    pageRoom = SDL_PAGE_LENGTH - pageLine + 1;
+    pageRoom = SDL_PAGE_LENGTH - listing->pageLine + 1;
 
     /*
      * Loop through each of the messages.
      */
-    for (ii = 0; ii < messagesIndex; ii++)
+    for (ii = 0; ii < listing->messagesIndex; ii++)
     {
 
         /*
          * Get the length of this specific message text.
          */
-        len = strlen(messages[ii]);
+        len = strlen(listing->messages[ii]);
 
         /*
          * Determine the number of lines this message occupies by counting the
@@ -512,7 +542,7 @@ static void _sdl_msg_list(FILE *fp)
         msgLines = 0;
         for (jj = 0; jj < len; jj++)
         {
-            if (messages[ii][jj] == '\n')
+            if (listing->messages[ii][jj] == '\n')
             {
                 msgLines++;
             }
@@ -525,8 +555,8 @@ static void _sdl_msg_list(FILE *fp)
          */
         if (pageRoom < msgLines)
         {
-            _sdl_end_page(fp);
-            pageRoom = SDL_PAGE_LENGTH - pageLine + 1;
+            _sdl_end_page(listing);
+            pageRoom = SDL_PAGE_LENGTH - listing->pageLine + 1;
         }
 
         /*
@@ -534,22 +564,22 @@ static void _sdl_msg_list(FILE *fp)
          * out to the listing file, and take into consideration the number of
          * lines just written out.
          */
-        fprintf(fp, "%s", messages[ii]);
+        fprintf(listing->fp, "%s", listing->messages[ii]);
         pageRoom -= msgLines;
-        pageLine += msgLines;
+        listing->pageLine += msgLines;
 
         /*
          * We no longer need the memory associated with this message text, so
          * return it.
          */
-        sdl_free(messages[ii]);
-        messages[ii] = 0;
+        sdl_free(listing->messages[ii]);
+        listing->messages[ii] = 0;
     }
 
     /*
      * Reset the message index.
      */
-    messagesIndex = 0;
+    listing->messagesIndex = 0;
 
     /*
      * Return back to the caller.
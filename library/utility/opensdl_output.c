@@ -0,0 +1,529 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the functions for writing output files.
+ *  Normally, an output file is just opened for write, which truncates it.
+ *  In update mode, the output is written to a temporary file in the same
+ *  directory.  When it is complete, it is compared with the existing output
+ *  file.  If they are the same, the temporary file is removed and the output
+ *  file, including its modification time, is left alone.  Otherwise, the
+ *  temporary file is renamed over the output file, so that no one ever sees
+ *  a partially written output file.
+ *
+ *  This file also writes dependency files, which list the files an input
+ *  file depended on, for make.  Ninja reads them too, as the depfile of a
+ *  build statement with "deps = gcc".
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	15-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_output_depfile.
+ *
+ *  V01.002	16-OCT-2026	Jonathan D. Belanger
+ *  Calls are recorded in the trace rather than written to standard output.
+ *
+ *  V01.003	16-OCT-2026	Jonathan D. Belanger
+ *  Removed the Ninja dyndep format from sdl_output_depfile.  A dyndep file
+ *  is only read for a build statement that already names it with dyndep,
+ *  so it cannot take the place of a depfile.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_trace.h"
+#include "library/utility/opensdl_output.h"
+#include "opensdl/opensdl_main.h"
+
+/*
+ * Local Variables
+ */
+static uint32_t _sdl_output_seq = 0;
+
+/*
+ * Local Prototypes
+ */
+static bool _sdl_output_same(const char *fileName1, const char *fileName2);
+static void _sdl_output_escape(FILE *fp, const char *fileName);
+
+/*
+ * sdl_output_open
+ *  This function is called to open an output file for write.  In update mode,
+ *  a temporary file is opened instead, and its name returned.  It is created
+ *  with the same permissions the output file would have, or already has.
+ *
+ * Input Parameters:
+ *  fileName:
+ *      A pointer to the name of the output file.
+ *  update:
+ *      A boolean indicating that the output file is only to be replaced if
+ *      it changes.
+ *
+ * Output Parameters:
+ *  tmpName:
+ *      A pointer to the address to receive the name of the temporary file,
+ *      which is to be passed to sdl_output_commit once the file has been
+ *      closed.  This is NULL when not in update mode.
+ *
+ * Return Values:
+ *  NULL:   The file could not be opened, and errno has the reason.
+ *  !NULL:  A pointer to the opened file.
+ */
+FILE *sdl_output_open(const char *fileName, bool update, char **tmpName)
+{
+    struct stat fileStats;
+    FILE *retVal = NULL;
+    size_t len;
+    mode_t mode = 0666;
+    bool exists = false;
+    int fd = -1;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_output_open");
+
+    *tmpName = NULL;
+    if (update == false)
+    {
+        return(fopen(fileName, "w"));
+    }
+
+    /*
+     * The temporary file name is made unique by the process ID and a
+     * sequence number, so that files compiled at the same time, in this or
+     * another process, never use the same one.
+     */
+    len = strlen(fileName) + 32;
+    if ((*tmpName = sdl_calloc(len, 1)) == NULL)
+    {
+        errno = ENOMEM;
+        return(NULL);
+    }
+    if (stat(fileName, &fileStats) == 0)
+    {
+        mode = fileStats.st_mode & 07777;
+        exists = true;
+    }
+    while (fd < 0)
+    {
+        snprintf(*tmpName,
+                 len,
+                 "%s.%ld.%u~",
+                 fileName,
+                 (long) getpid(),
+                 __sync_fetch_and_add(&_sdl_output_seq, 1));
+        fd = open(*tmpName, O_WRONLY | O_CREAT | O_EXCL, mode);
+        if ((fd < 0) && (errno != EEXIST))
+        {
+            break;
+        }
+    }
+    if (fd >= 0)
+    {
+
+        /*
+         * An existing output file keeps its permissions, as it would when
+         * being truncated.
+         */
+        if (exists == true)
+        {
+            fchmod(fd, mode);
+        }
+        if ((retVal = fdopen(fd, "w")) == NULL)
+        {
+            close(fd);
+            unlink(*tmpName);
+        }
+    }
+    if (retVal == NULL)
+    {
+        int saveErrno = errno;
+
+        sdl_free(*tmpName);
+        *tmpName = NULL;
+        errno = saveErrno;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_output_commit
+ *  This function is called, after the temporary file returned by
+ *  sdl_output_open has been closed, to replace the output file with it if the
+ *  contents are different.  The temporary file name is freed.
+ *
+ * Input Parameters:
+ *  fileName:
+ *      A pointer to the name of the output file.
+ *  tmpName:
+ *      A pointer to the name of the temporary file.  If this is NULL, the
+ *      output file was written directly and there is nothing to do.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_OUTFILOPN:  The output file could not be replaced.
+ */
+uint32_t sdl_output_commit(const char *fileName, char *tmpName)
+{
+    uint32_t retVal = SDL_NORMAL;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_output_commit");
+
+    if (tmpName != NULL)
+    {
+        if (_sdl_output_same(tmpName, fileName) == true)
+        {
+            unlink(tmpName);
+        }
+        else if (rename(tmpName, fileName) != 0)
+        {
+            unlink(tmpName);
+            retVal = SDL_OUTFILOPN;
+        }
+        sdl_free(tmpName);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_output_write
+ *  This function is called to write an output file from memory.
+ *
+ * Input Parameters:
+ *  fileName:
+ *      A pointer to the name of the output file.
+ *  buffer:
+ *      A pointer to the contents of the output file.
+ *  length:
+ *      A value indicating the length of the contents.
+ *  update:
+ *      A boolean indicating that the output file is only to be replaced if
+ *      it changes.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_OUTFILOPN:  The output file could not be written.
+ */
+uint32_t sdl_output_write(const char *fileName,
+                          const char *buffer,
+                          size_t length,
+                          bool update)
+{
+    char *tmpName;
+    FILE *fp = sdl_output_open(fileName, update, &tmpName);
+    uint32_t retVal = SDL_OUTFILOPN;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_output_write");
+
+    if (fp != NULL)
+    {
+        bool written = (fwrite(buffer, 1, length, fp) == length);
+
+        if ((fclose(fp) == 0) && (written == true))
+        {
+            retVal = sdl_output_commit(fileName, tmpName);
+        }
+        else if (tmpName != NULL)
+        {
+            unlink(tmpName);
+            sdl_free(tmpName);
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_output_depfile
+ *  This function is called, after an input file has been compiled, to write a
+ *  dependency file.  Every output file depends on the input file, the
+ *  copyright file, if one was used, and every INCLUDE file that was opened.
+ *
+ *  The format is the one written by "cc -MD -MP": a rule with the output
+ *  files as targets, and an empty rule for each of the other files, so that
+ *  make does not fail when one of them is removed.  Ninja reads the same
+ *  file, for example:
+ *
+ *      rule sdl
+ *        command = opensdl --lang=c --depfile=$out.d $in
+ *        depfile = $out.d
+ *        deps = gcc
+ *
+ *      build foo.h: sdl foo.sdl
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.  This contains
+ *      the list of INCLUDE files that were opened, and the arguments.
+ *  depFileName:
+ *      A pointer to the name of the dependency file.
+ *  fileName:
+ *      A pointer to the name of the input file.
+ *  outFileName:
+ *      A pointer to the array of output file names, one for each language.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_OUTFILOPN:  The dependency file could not be written.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ */
+uint32_t sdl_output_depfile(SDL_CONTEXT *context,
+                            const char *depFileName,
+                            const char *fileName,
+                            char **outFileName)
+{
+    SDL_ARGUMENTS *args = context->argument;
+    SDL_INPUT_LIST *includes = &context->includes;
+    FILE *fp;
+    char *buffer = NULL;
+    size_t length = 0;
+    uint32_t retVal;
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_output_depfile");
+
+    if ((fp = open_memstream(&buffer, &length)) == NULL)
+    {
+        return(SDL_ABORT);
+    }
+
+    /*
+     * The output files are the targets.
+     */
+    for (ii = 0; ii < context->languagesSpecified; ii++)
+    {
+        fputs((ii == 0) ? "" : " ", fp);
+        _sdl_output_escape(fp, outFileName[ii]);
+    }
+    fputs(":", fp);
+
+    /*
+     * Followed by everything they depend on.
+     */
+    fputs(" ", fp);
+    _sdl_output_escape(fp, fileName);
+    if ((args[ArgCopyright].on == true) &&
+        (args[ArgCopyrightFile].present == true))
+    {
+        fputs(" \\\n ", fp);
+        _sdl_output_escape(fp, args[ArgCopyrightFile].fileName);
+    }
+    for (ii = 0; ii < includes->listUsed; ii++)
+    {
+        fputs(" \\\n ", fp);
+        _sdl_output_escape(fp, includes->files[ii]);
+    }
+    fputs("\n", fp);
+
+    /*
+     * Then an empty rule for each of the files the input file depended on.
+     */
+    if ((args[ArgCopyright].on == true) &&
+        (args[ArgCopyrightFile].present == true))
+    {
+        fputs("\n", fp);
+        _sdl_output_escape(fp, args[ArgCopyrightFile].fileName);
+        fputs(":\n", fp);
+    }
+    for (ii = 0; ii < includes->listUsed; ii++)
+    {
+        fputs("\n", fp);
+        _sdl_output_escape(fp, includes->files[ii]);
+        fputs(":\n", fp);
+    }
+    fclose(fp);
+
+    /*
+     * Write the dependency file.  In update mode, it is only replaced when it
+     * changes, just like the output files.
+     */
+    if (buffer != NULL)
+    {
+        retVal = sdl_output_write(depFileName,
+                                  buffer,
+                                  length,
+                                  args[ArgUpdate].on);
+        free(buffer);
+    }
+    else
+    {
+        retVal = SDL_ABORT;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_output_escape
+ *  This function is called to write a file name to a dependency file, with
+ *  the characters that are special to make escaped.
+ *
+ * Input Parameters:
+ *  fp:
+ *      A pointer to the dependency file being written.
+ *  fileName:
+ *      A pointer to the file name to be written.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_output_escape(FILE *fp, const char *fileName)
+{
+    const char *ptr;
+
+    for (ptr = fileName; *ptr != '\0'; ptr++)
+    {
+        switch (*ptr)
+        {
+            case '$':
+                fputs("$$", fp);
+                break;
+
+            case ' ':
+                fputs("\\ ", fp);
+                break;
+
+            case '#':
+                fputs("\\#", fp);
+                break;
+
+            default:
+                fputc(*ptr, fp);
+                break;
+        }
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_output_same
+ *  This function is called to determine if two files have the same contents.
+ *
+ * Input Parameters:
+ *  fileName1:
+ *      A pointer to the name of the first file.
+ *  fileName2:
+ *      A pointer to the name of the second file.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:   Both files could be read and have the same contents.
+ *  false:  The files are different, or one of them could not be read.
+ */
+static bool _sdl_output_same(const char *fileName1, const char *fileName2)
+{
+    struct stat fileStats1, fileStats2;
+    FILE *fp1 = NULL;
+    FILE *fp2 = NULL;
+    bool retVal = false;
+
+    /*
+     * If the sizes are different, there is no need to read either file.
+     */
+    if ((stat(fileName1, &fileStats1) == 0) &&
+        (stat(fileName2, &fileStats2) == 0) &&
+        (fileStats1.st_size == fileStats2.st_size) &&
+        ((fp1 = fopen(fileName1, "r")) != NULL) &&
+        ((fp2 = fopen(fileName2, "r")) != NULL))
+    {
+        char buffer1[BUFSIZ], buffer2[BUFSIZ];
+        size_t len1, len2;
+
+        retVal = true;
+        do
+        {
+            len1 = fread(buffer1, 1, sizeof(buffer1), fp1);
+            len2 = fread(buffer2, 1, sizeof(buffer2), fp2);
+            if ((len1 != len2) || (memcmp(buffer1, buffer2, len1) != 0))
+            {
+                retVal = false;
+            }
+        } while ((retVal == true) && (len1 > 0));
+        if ((ferror(fp1) != 0) || (ferror(fp2) != 0))
+        {
+            retVal = false;
+        }
+    }
+    if (fp1 != NULL)
+    {
+        fclose(fp1);
+    }
+    if (fp2 != NULL)
+    {
+        fclose(fp2);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
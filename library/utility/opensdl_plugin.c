@@ -25,21 +25,68 @@
  *  The <language> portion will be what is provided on the --lang=<language>
  *  qualifier.
  *
+ *  The table of loaded plugins is shared by every context in the process.  All
+ *  the plugins must be loaded before any compilation is started on another
+ *  thread, after which the table is only read.  The output file and message
+ *  vector are given to the plugins, by sdl_load_fp, on the thread that will
+ *  be running the compilation.
+ *
  * Revision History:
  *
  *  V01.000	103-Apr-2019 Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001	15-OCT-2026 Jonathan D. Belanger
+ *  Messages are reported in the message vector of the context passed in, and
+ *  sdl_load_fp also gives the plugin the context's message vector.  Closing
+ *  the output files no longer unloads the plugins, sdl_unload_plugins does.
+ *
+ *  V01.002	15-OCT-2026	Jonathan D. Belanger
+ *  The header calls only call the enabled languages, and added
+ *  sdl_plugin_count and sdl_plugin_lang.
+ *
+ *  V01.003	15-OCT-2026	Jonathan D. Belanger
+ *  The path to each plugin's shared library is kept, and is returned by
+ *  sdl_plugin_image.
+ *
+ *  V01.004	15-OCT-2026	Jonathan D. Belanger
+ *  sdl_load_fp records the output file in the context, and added
+ *  sdl_plugin_attach, so that a language can be emitted on another thread.
+ *
+ *  V01.005	15-OCT-2026	Jonathan D. Belanger
+ *  The plugins are given an output sink for the output file, if the context
+ *  has one for the language.
+ *
+ *  V01.006	15-OCT-2026	Jonathan D. Belanger
+ *  Added sdl_call_layout, which gives the layout of a whole AGGREGATE to the
+ *  plugins that support SDL_API_AGGREGATE_V2, and calls the AGGREGATE
+ *  function for each entry in it for those that do not.
+ *
+ *  V01.007	15-OCT-2026	Jonathan D. Belanger
+ *  Languages can be built into the image.  A built-in language is used
+ *  without looking for a shared library, which is only done for the other
+ *  languages.
+ *
+ *  V01.008	16-OCT-2026	Jonathan D. Belanger
+ *  The event recorder is always built into the image, as the "record"
+ *  language.
+ *
+ *  V01.009	16-OCT-2026	Jonathan D. Belanger
+ *  Plugins are given the function to record their trace events with, so that
+ *  they are recorded in the same trace as the OpenSDL image's.
  */
 #include <stdint.h>
 #include "opensdl_defs.h"
 #include "library/common/opensdl_blocks.h"
 #include "library/utility/opensdl_plugin.h"
+#include "library/utility/opensdl_plugin_funcs.h"
 #include "opensdl/opensdl_main.h"
 
 typedef struct
 {
     char *lang;
     char *fileExt;
+    char *image;
     sdl_plugin_onload onLoad;
     sdl_plugin_commentStars sdl_tv_commentStars;
     sdl_plugin_createdByInfo sdl_tv_createdByInfo;
@@ -51,6 +98,7 @@ typedef struct
     sdl_plugin_constant sdl_tv_constant;
     sdl_plugin_enumerate sdl_tv_enumerate;
     sdl_plugin_aggregate sdl_tv_aggregate;
+    sdl_plugin_aggregateV2 sdl_tv_aggregateV2;
     sdl_plugin_entry sdl_tv_entry;
     sdl_plugin_literal sdl_tv_literal;
     sdl_plugin_close sdl_tv_close;
@@ -62,16 +110,61 @@ static char *_sdl_shared_image_name_fmt = "%s%c%sOpenSDL_%s.%s";
 static char _sdl_image_path[PATH_MAX];
 static bool _sdl_image_path_initialized = false;
 
+/*
+ * The languages built into this image, rather than loaded from a shared
+ * library.  The build defines SDL_BUILTIN_LANGUAGES as a list of
+ * SDL_BUILTIN(<language>) entries, one for each of the languages selected
+ * with the OPENSDL_BUILTIN_LANGUAGES option.  The onLoad function of a
+ * built-in language is named sdl_<language>_onLoad (see SDL_PLUGIN_ONLOAD).
+ * The event recorder (see opensdl_record.c) is always built in.
+ */
+#ifndef SDL_BUILTIN_LANGUAGES
+#define SDL_BUILTIN_LANGUAGES
+#endif
+#define SDL_BUILTIN_ALL     SDL_BUILTIN(record) SDL_BUILTIN_LANGUAGES
+#define SDL_BUILTIN(lang)   uint32_t sdl_ ## lang ## _onLoad(SDL_API_TV *tv);
+SDL_BUILTIN_ALL
+#undef SDL_BUILTIN
+
+typedef struct
+{
+    char *lang;
+    sdl_plugin_onload onLoad;
+} SDL_BUILTIN_INFO;
+#define SDL_BUILTIN(lang)   {#lang, sdl_ ## lang ## _onLoad},
+static const SDL_BUILTIN_INFO _sdl_builtin[] =
+{
+    SDL_BUILTIN_ALL
+    {NULL, NULL}
+};
+#undef SDL_BUILTIN
+static char _sdl_builtin_image[PATH_MAX];
+
+/*
+ * Local Prototypes
+ */
+static uint32_t _sdl_plugin_register(SDL_CONTEXT *context,
+                                     char *lang,
+                                     char *image,
+                                     sdl_plugin_onload onLoad,
+                                     char **fileExt,
+                                     uint32_t *langId);
+
 /*
  * sdl_load_plugin
  *  This function is called with a language string and attempts to load the
  *  shared library for.  The shared library will be located in the same
- *  directory.  The plugin is loaded while processing the --lang command line
- *  argument(s).  This is prior to any output file being opened.  Therefore, a
- *  second call to the onLoad plugin function must be performed prior to doing
- *  any real processing.
+ *  directory.  If the language is built into this image, then its onLoad
+ *  function is called directly, and no shared library is looked for.  The
+ *  plugin is loaded while processing the --lang command line argument(s).
+ *  This is prior to any output file being opened.  Therefore, a second call
+ *  to the onLoad plugin function must be performed prior to doing any real
+ *  processing.
  *
  * Input Parameters:
+ *  context:
+ *      A pointer to the context structure, where the message vector is
+ *      maintained.
  *  lang:
  *      A pointer to a null-terminated string containing the language name that
  *      will be used to located and open the language shared library.
@@ -90,7 +183,10 @@ static bool _sdl_image_path_initialized = false;
  *  SDL_ERREXIT     - Error exit
  *  SDL_ABORT       - Fatal internal error. Unable to continue execution
  */
-uint32_t sdl_load_plugin(char *lang, char **fileExt, uint32_t *langId)
+uint32_t sdl_load_plugin(SDL_CONTEXT *context,
+                         char *lang,
+                         char **fileExt,
+                         uint32_t *langId)
 {
     uint32_t retVal = SDL_NORMAL;
     char pathToSharedLib[PATH_MAX];
@@ -112,6 +208,27 @@ uint32_t sdl_load_plugin(char *lang, char **fileExt, uint32_t *langId)
         }
     }
 
+    /*
+     * If the language is built into this image, then there is no shared
+     * library to be found.  The image itself stands in for it.
+     */
+    for (ii = 0; _sdl_builtin[ii].lang != NULL; ii++)
+    {
+        if (strcmp(_sdl_builtin[ii].lang, lang) == 0)
+        {
+            if (_sdl_builtin_image[0] == '\0')
+            {
+                GET_IMAGE_PATH(_sdl_builtin_image, PATH_MAX - 1);
+            }
+            return(_sdl_plugin_register(context,
+                                        lang,
+                                        _sdl_builtin_image,
+                                        _sdl_builtin[ii].onLoad,
+                                        fileExt,
+                                        langId));
+        }
+    }
+
     /*
      * If this is the first time we've been called, then go get the path to
      * ourselves.  The shared library will be in the same directory.  If the
@@ -153,7 +270,7 @@ uint32_t sdl_load_plugin(char *lang, char **fileExt, uint32_t *langId)
     if (access(pathToSharedLib, X_OK) != 0)
     {
         retVal = SDL_INVSHRIMG;
-        if (sdl_set_message(msgVec,
+        if (sdl_set_message(context->msgVec,
                             2,
                             retVal,
                             pathToSharedLib,
@@ -182,7 +299,7 @@ uint32_t sdl_load_plugin(char *lang, char **fileExt, uint32_t *langId)
         if (dlerror() != NULL)
         {
             retVal = SDL_INVSHRIMG;
-            if (sdl_set_message(msgVec,
+            if (sdl_set_message(context->msgVec,
                                 2,
                                 retVal,
                                 pathToSharedLib,
@@ -194,192 +311,257 @@ uint32_t sdl_load_plugin(char *lang, char **fileExt, uint32_t *langId)
         }
         else
         {
-            SDL_API_TV tv[SDL_API_MAX - 1];
-            int ii = 0;
+            retVal = _sdl_plugin_register(context,
+                                          lang,
+                                          pathToSharedLib,
+                                          onLoad,
+                                          fileExt,
+                                          langId);
+        }
+    }
+    else
+    {
+        retVal = SDL_INVSHRIMG;
+        if (sdl_set_message(context->msgVec,
+                            2,
+                            retVal,
+                            pathToSharedLib,
+                            errno) != SDL_NORMAL)
+        {
+            retVal = SDL_ERREXIT;
+        }
+    }
 
-            /*
-             * Setup the transfer vector that will be passed to the share
-             * library's onLoad function, which will parse it and return the
-             * information we need to call into it as we perform our real
-             * processing.
-             */
-            tv[ii].tag = SDL_API_PROTOCOL_VER;
-            tv[ii].sdl_tv_version.type = SDL_VER_TYPE_TEST;
-            tv[ii].sdl_tv_version.major = SDL_API_VERSION_MAJOR;
-            tv[ii].sdl_tv_version.minor = SDL_API_VERSION_MINOR;
-            tv[ii++].sdl_tv_version.patch = SDL_API_VERSION_PATCH;
-            tv[ii].tag = SDL_API_MESSAGE_VECTOR;
-            tv[ii++].sdl_tv_msgVec = msgVec;
-            tv[ii].tag = SDL_API_TRACE_PTR;
-            tv[ii++].sdl_tv_boolean = &trace;
-            tv[ii].tag = SDL_API_COMMENT_STAR;
-            tv[ii++].sdl_tv_commentStars = NULL;
-            tv[ii].tag = SDL_API_CREATED_BY;
-            tv[ii++].sdl_tv_createdByInfo = NULL;
-            tv[ii].tag = SDL_API_FILE_INFO;
-            tv[ii++].sdl_tv_fileInfo = NULL;
-            tv[ii].tag = SDL_API_COMMENT;
-            tv[ii++].sdl_tv_comment = NULL;
-            tv[ii].tag = SDL_API_MODULE;
-            tv[ii++].sdl_tv_module = NULL;
-            tv[ii].tag = SDL_API_MODULE_END;
-            tv[ii++].sdl_tv_moduleEnd = NULL;
-            tv[ii].tag = SDL_API_ITEM;
-            tv[ii++].sdl_tv_item = NULL;
-            tv[ii].tag = SDL_API_CONSTANT;
-            tv[ii++].sdl_tv_constant = NULL;
-            tv[ii].tag = SDL_API_ENUMERATE;
-            tv[ii++].sdl_tv_enumerate = NULL;
-            tv[ii].tag = SDL_API_AGGREGATE;
-            tv[ii++].sdl_tv_aggregate = NULL;
-            tv[ii].tag = SDL_API_ENTRY;
-            tv[ii++].sdl_tv_entry = NULL;
-            tv[ii].tag = SDL_API_FILE_EXTENSION;
-            tv[ii++].sdl_tv_string = NULL;
-            tv[ii].tag = SDL_API_LITERAL;
-            tv[ii++].sdl_tv_literal = NULL;
-            tv[ii].tag = SDL_API_CLOSE;
-            tv[ii++].sdl_tv_close = NULL;
-            tv[ii].tag = SDL_API_NULL;
+    /*
+     * Return back to the caller.
+     */
+    return(retVal);
+}
 
-            /*
-             * Call the onLoad function.
-             */
-            retVal = (*onLoad)(tv);
-            if (retVal == SDL_NORMAL)
-            {
+/*
+ * _sdl_plugin_register
+ *  This function is called to call the onLoad function of a language, which
+ *  was either just loaded from a shared library or is built into this image,
+ *  and record the functions it returns.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure, where the message vector is
+ *      maintained.
+ *  lang:
+ *      A pointer to a null-terminated string containing the language name.
+ *  image:
+ *      A pointer to the path of the shared library, or of this image for a
+ *      built-in language.
+ *  onLoad:
+ *      The address of the language's onLoad function.
+ *
+ * Output Parameters:
+ *  fileExt:
+ *      A pointer to the address of a character string to receive the file
+ *      extension to use for the output file.
+ *  langId:
+ *      A pointer to an unsigned 32-bit integer to receive the identifier for
+ *      the loaded language.
+ *
+ * Return Values:
+ *  SDL_NORMAL      - Normal successful completion
+ *  SDL_ERREXIT     - Error exit
+ *  SDL_ABORT       - Fatal internal error. Unable to continue execution
+ *  Any status returned by the plugin's onLoad function.
+ */
+static uint32_t _sdl_plugin_register(SDL_CONTEXT *context,
+                                     char *lang,
+                                     char *image,
+                                     sdl_plugin_onload onLoad,
+                                     char **fileExt,
+                                     uint32_t *langId)
+{
+    uint32_t retVal = SDL_NORMAL;
+    SDL_API_TV tv[SDL_API_MAX - 1];
+    int ii = 0;
 
-                /*
-                 * So far, everything looks great.  Allocate a record to hold
-                 * this plugin's information.
-                 */
-                _sdl_plugin_info = sdl_realloc(_sdl_plugin_info,
-                                               ((_sdl_plugin_info_count + 1) *
-                                                sizeof(SDL_PLUGIN_INFO)));
-                if (_sdl_plugin_info != NULL)
-                {
-                    uint32_t index = _sdl_plugin_info_count++;
-
-                    _sdl_plugin_info[index].lang = sdl_strdup(lang);
-                    _sdl_plugin_info[index].onLoad = onLoad;
-                    ii = 0;
-                    while (tv[ii].tag != SDL_API_NULL)
-                    {
-                        switch (tv[ii].tag)
-                        {
-                            case SDL_API_COMMENT_STAR:
-                                _sdl_plugin_info[index].sdl_tv_commentStars =
-                                        tv[ii].sdl_tv_commentStars;
-                                break;
-
-                            case SDL_API_CREATED_BY:
-                                _sdl_plugin_info[index].sdl_tv_createdByInfo =
-                                    tv[ii].sdl_tv_createdByInfo;
-                                break;
-
-                            case SDL_API_FILE_INFO:
-                                _sdl_plugin_info[index].sdl_tv_fileInfo =
-                                    tv[ii].sdl_tv_fileInfo;
-                                break;
-
-                            case SDL_API_COMMENT:
-                                _sdl_plugin_info[index].sdl_tv_comment =
-                                    tv[ii].sdl_tv_comment;
-                                break;
-
-                            case SDL_API_MODULE:
-                                _sdl_plugin_info[index].sdl_tv_module =
-                                    tv[ii].sdl_tv_module;
-                                break;
-
-                            case SDL_API_MODULE_END:
-                                _sdl_plugin_info[index].sdl_tv_moduleEnd =
-                                    tv[ii].sdl_tv_moduleEnd;
-                                break;
-
-                            case SDL_API_ITEM:
-                                _sdl_plugin_info[index].sdl_tv_item =
-                                    tv[ii].sdl_tv_item;
-                                break;
-
-                            case SDL_API_CONSTANT:
-                                _sdl_plugin_info[index].sdl_tv_constant =
-                                    tv[ii].sdl_tv_constant;
-                                break;
-
-                            case SDL_API_ENUMERATE:
-                                _sdl_plugin_info[index].sdl_tv_enumerate =
-                                    tv[ii].sdl_tv_enumerate;
-                                break;
-
-                            case SDL_API_AGGREGATE:
-                                _sdl_plugin_info[index].sdl_tv_aggregate =
-                                    tv[ii].sdl_tv_aggregate;
-                                break;
-
-                            case SDL_API_ENTRY:
-                                _sdl_plugin_info[index].sdl_tv_entry =
-                                    tv[ii].sdl_tv_entry;
-                                break;
-
-                            case SDL_API_FILE_EXTENSION:
-                                _sdl_plugin_info[index].fileExt =
-                                   tv[ii].sdl_tv_string;
-                                break;
-
-                            case SDL_API_LITERAL:
-                                _sdl_plugin_info[index].sdl_tv_literal=
-                                   tv[ii].sdl_tv_literal;
-                                break;
-
-                            case SDL_API_CLOSE:
-                                _sdl_plugin_info[index].sdl_tv_close =
-                                    tv[ii].sdl_tv_close;
-                                break;
-
-                            default:
-                                break;
-                        }
-                        ii++;
-                    }
-
-                    /*
-                     * Now to initialize the output parameters.
-                     */
-                    *langId = index;
-                    *fileExt = _sdl_plugin_info[index].fileExt;
-                }
-                else
+    /*
+     * Setup the transfer vector that will be passed to the language's onLoad
+     * function, which will parse it and return the information we need to
+     * call into it as we perform our real processing.
+     */
+    tv[ii].tag = SDL_API_PROTOCOL_VER;
+    tv[ii].sdl_tv_version.type = SDL_VER_TYPE_TEST;
+    tv[ii].sdl_tv_version.major = SDL_API_VERSION_MAJOR;
+    tv[ii].sdl_tv_version.minor = SDL_API_VERSION_MINOR;
+    tv[ii++].sdl_tv_version.patch = SDL_API_VERSION_PATCH;
+    tv[ii].tag = SDL_API_MESSAGE_VECTOR;
+    tv[ii++].sdl_tv_msgVec = context->msgVec;
+    tv[ii].tag = SDL_API_TRACE_PTR;
+    tv[ii++].sdl_tv_boolean = &trace;
+    tv[ii].tag = SDL_API_TRACE_EVENT;
+    tv[ii++].sdl_tv_traceEvent = sdl_trace_event;
+    tv[ii].tag = SDL_API_COMMENT_STAR;
+    tv[ii++].sdl_tv_commentStars = NULL;
+    tv[ii].tag = SDL_API_CREATED_BY;
+    tv[ii++].sdl_tv_createdByInfo = NULL;
+    tv[ii].tag = SDL_API_FILE_INFO;
+    tv[ii++].sdl_tv_fileInfo = NULL;
+    tv[ii].tag = SDL_API_COMMENT;
+    tv[ii++].sdl_tv_comment = NULL;
+    tv[ii].tag = SDL_API_MODULE;
+    tv[ii++].sdl_tv_module = NULL;
+    tv[ii].tag = SDL_API_MODULE_END;
+    tv[ii++].sdl_tv_moduleEnd = NULL;
+    tv[ii].tag = SDL_API_ITEM;
+    tv[ii++].sdl_tv_item = NULL;
+    tv[ii].tag = SDL_API_CONSTANT;
+    tv[ii++].sdl_tv_constant = NULL;
+    tv[ii].tag = SDL_API_ENUMERATE;
+    tv[ii++].sdl_tv_enumerate = NULL;
+    tv[ii].tag = SDL_API_AGGREGATE;
+    tv[ii++].sdl_tv_aggregate = NULL;
+    tv[ii].tag = SDL_API_ENTRY;
+    tv[ii++].sdl_tv_entry = NULL;
+    tv[ii].tag = SDL_API_FILE_EXTENSION;
+    tv[ii++].sdl_tv_string = NULL;
+    tv[ii].tag = SDL_API_LITERAL;
+    tv[ii++].sdl_tv_literal = NULL;
+    tv[ii].tag = SDL_API_CLOSE;
+    tv[ii++].sdl_tv_close = NULL;
+    tv[ii].tag = SDL_API_AGGREGATE_V2;
+    tv[ii++].sdl_tv_aggregateV2 = NULL;
+    tv[ii].tag = SDL_API_NULL;
+
+    /*
+     * Call the onLoad function.
+     */
+    retVal = (*onLoad)(tv);
+    if (retVal == SDL_NORMAL)
+    {
+
+        /*
+         * So far, everything looks great.  Allocate a record to hold
+         * this plugin's information.
+         */
+        _sdl_plugin_info = sdl_realloc(_sdl_plugin_info,
+                                       ((_sdl_plugin_info_count + 1) *
+                                        sizeof(SDL_PLUGIN_INFO)));
+        if (_sdl_plugin_info != NULL)
+        {
+            uint32_t index = _sdl_plugin_info_count++;
+
+            memset(&_sdl_plugin_info[index],
+                   0,
+                   sizeof(SDL_PLUGIN_INFO));
+            _sdl_plugin_info[index].lang = sdl_strdup(lang);
+            _sdl_plugin_info[index].image = sdl_strdup(image);
+            _sdl_plugin_info[index].onLoad = onLoad;
+            ii = 0;
+            while (tv[ii].tag != SDL_API_NULL)
+            {
+                switch (tv[ii].tag)
                 {
-                    retVal = SDL_ABORT;
-                    if (sdl_set_message(msgVec,
-                                        2,
-                                        retVal,
-                                        ENOMEM) != SDL_NORMAL)
-                    {
-                        retVal = SDL_ERREXIT;
-                    }
+                    case SDL_API_COMMENT_STAR:
+                        _sdl_plugin_info[index].sdl_tv_commentStars =
+                                tv[ii].sdl_tv_commentStars;
+                        break;
+
+                    case SDL_API_CREATED_BY:
+                        _sdl_plugin_info[index].sdl_tv_createdByInfo =
+                            tv[ii].sdl_tv_createdByInfo;
+                        break;
+
+                    case SDL_API_FILE_INFO:
+                        _sdl_plugin_info[index].sdl_tv_fileInfo =
+                            tv[ii].sdl_tv_fileInfo;
+                        break;
+
+                    case SDL_API_COMMENT:
+                        _sdl_plugin_info[index].sdl_tv_comment =
+                            tv[ii].sdl_tv_comment;
+                        break;
+
+                    case SDL_API_MODULE:
+                        _sdl_plugin_info[index].sdl_tv_module =
+                            tv[ii].sdl_tv_module;
+                        break;
+
+                    case SDL_API_MODULE_END:
+                        _sdl_plugin_info[index].sdl_tv_moduleEnd =
+                            tv[ii].sdl_tv_moduleEnd;
+                        break;
+
+                    case SDL_API_ITEM:
+                        _sdl_plugin_info[index].sdl_tv_item =
+                            tv[ii].sdl_tv_item;
+                        break;
+
+                    case SDL_API_CONSTANT:
+                        _sdl_plugin_info[index].sdl_tv_constant =
+                            tv[ii].sdl_tv_constant;
+                        break;
+
+                    case SDL_API_ENUMERATE:
+                        _sdl_plugin_info[index].sdl_tv_enumerate =
+                            tv[ii].sdl_tv_enumerate;
+                        break;
+
+                    case SDL_API_AGGREGATE:
+                        _sdl_plugin_info[index].sdl_tv_aggregate =
+                            tv[ii].sdl_tv_aggregate;
+                        break;
+
+                    case SDL_API_AGGREGATE_V2:
+                        _sdl_plugin_info[index].sdl_tv_aggregateV2 =
+                            tv[ii].sdl_tv_aggregateV2;
+                        break;
+
+                    case SDL_API_ENTRY:
+                        _sdl_plugin_info[index].sdl_tv_entry =
+                            tv[ii].sdl_tv_entry;
+                        break;
+
+                    case SDL_API_FILE_EXTENSION:
+                        _sdl_plugin_info[index].fileExt =
+                           tv[ii].sdl_tv_string;
+                        break;
+
+                    case SDL_API_LITERAL:
+                        _sdl_plugin_info[index].sdl_tv_literal=
+                           tv[ii].sdl_tv_literal;
+                        break;
+
+                    case SDL_API_CLOSE:
+                        _sdl_plugin_info[index].sdl_tv_close =
+                            tv[ii].sdl_tv_close;
+                        break;
+
+                    default:
+                        break;
                 }
+                ii++;
             }
-            else
+
+            /*
+             * Now to initialize the output parameters.
+             */
+            *langId = index;
+            *fileExt = _sdl_plugin_info[index].fileExt;
+        }
+        else
+        {
+            retVal = SDL_ABORT;
+            if (sdl_set_message(context->msgVec,
+                                2,
+                                retVal,
+                                ENOMEM) != SDL_NORMAL)
             {
-                if (sdl_set_message(msgVec,
-                                    1,
-                                    retVal) != SDL_NORMAL)
-                {
-                    retVal = SDL_ERREXIT;
-                }
+                retVal = SDL_ERREXIT;
             }
         }
     }
     else
     {
-        retVal = SDL_INVSHRIMG;
-        if (sdl_set_message(msgVec,
-                            2,
-                            retVal,
-                            pathToSharedLib,
-                            errno) != SDL_NORMAL)
+        if (sdl_set_message(context->msgVec,
+                            1,
+                            retVal) != SDL_NORMAL)
         {
             retVal = SDL_ERREXIT;
         }
@@ -394,45 +576,116 @@ uint32_t sdl_load_plugin(char *lang, char **fileExt, uint32_t *langId)
 /*
  * sdl_load_fp
  *  This function is called to give the plugin the file pointer to which it
- *  will write its generated output.  This needs to be done after the
- *  sdl_load_plugin call and before any of the other calls to request the
- *  plugin to generate its output.
+ *  will write its generated output, and the message vector for the
+ *  compilation.  This needs to be done after the sdl_load_plugin call and
+ *  before any of the other calls to request the plugin to generate its output.
+ *  The plugin keeps these per thread, so this function must be called on the
+ *  thread that will run the compilation.  The output file is also recorded
+ *  in the context, if it has room for it, so that the language can be
+ *  attached to another thread later on.  If the context has an output sink
+ *  for the language, it is set up for the output file and given to the
+ *  plugin as well.
  *
  * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.
  *  langId:
- *      A value associated with this particular language plugin.
+ *      A value returned by sdl_load_plugin, indicating the plugin to be
+ *      called.
  *  fp:
- *      The file pointer to pass to the plugin.
+ *      A pointer to the opened output file for this language.
  *
  * Output Parameters:
  *  None.
  *
  * Return Values:
  *  SDL_NORMAL      - Normal successful completion
+ *  SDL_ERREXIT     - Error exit
+ *  Any status returned by the plugin's onLoad function.
  */
-uint32_t sdl_load_fp(uint32_t langId, FILE *fp)
+uint32_t sdl_load_fp(SDL_CONTEXT *context, uint32_t langId, FILE *fp)
 {
+    SDL_SINK *sink = NULL;
     uint32_t retVal = SDL_NORMAL;
-    SDL_API_TV tv[2];
 
-    /*
-     * We only provide one thing to the plugin, the output file pointer, so
-     * initialize the transfer vector with this information and call the
-     * plugin's onLoad function.
-     */
-    tv[0].tag = SDL_API_OUTPUT_FP;
-    tv[0].sdl_tv_fp = fp;
-    tv[1].tag = SDL_API_NULL;
-    retVal = (*_sdl_plugin_info[langId].onLoad)(tv);
+    if (context->langSink != NULL)
+    {
+        sink = &context->langSink[langId];
+        sdl_sink_init(sink, fp);
+    }
+    retVal = sdl_plugin_attach(langId, fp, sink, context->msgVec);
     if (retVal != SDL_NORMAL)
     {
-        if (sdl_set_message(msgVec,
+        if (sdl_set_message(context->msgVec,
                             1,
                             retVal) != SDL_NORMAL)
         {
             retVal = SDL_ERREXIT;
         }
     }
+    else if (context->langFP != NULL)
+    {
+        context->langFP[langId] = fp;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_plugin_attach
+ *  This function is called to give the plugin the file pointer to which it
+ *  will write its generated output, and the message vector in which it will
+ *  report any errors, for the current thread.  The file pointer and sink may
+ *  already have been given to the plugin on another thread, as long as only
+ *  one thread at a time writes to them.
+ *
+ * Input Parameters:
+ *  langId:
+ *      A value returned by sdl_load_plugin, indicating the plugin to be
+ *      called.
+ *  fp:
+ *      A pointer to the opened output file for this language.
+ *  sink:
+ *      A pointer to the output sink for the output file, or NULL to have
+ *      the plugin write to the output file.
+ *  msgVec:
+ *      A pointer to the message vector for the current thread.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL      - Normal successful completion
+ *  Any status returned by the plugin's onLoad function.
+ */
+uint32_t sdl_plugin_attach(uint32_t langId,
+                           FILE *fp,
+                           SDL_SINK *sink,
+                           SDL_MSG_VECTOR *msgVec)
+{
+    uint32_t retVal = SDL_NORMAL;
+    SDL_API_TV tv[4];
+    int ii = 2;
+
+    /*
+     * We provide the plugin with the output file pointer and the message
+     * vector, so initialize the transfer vector with this information and
+     * call the plugin's onLoad function.
+     */
+    tv[0].tag = SDL_API_OUTPUT_FP;
+    tv[0].sdl_tv_fp = fp;
+    tv[1].tag = SDL_API_MESSAGE_VECTOR;
+    tv[1].sdl_tv_msgVec = msgVec;
+    if (sink != NULL)
+    {
+        tv[ii].tag = SDL_API_OUTPUT_SINK;
+        tv[ii++].sdl_tv_sink = sink;
+    }
+    tv[ii].tag = SDL_API_NULL;
+    retVal = (*_sdl_plugin_info[langId].onLoad)(tv);
 
     /*
      * Return back to the caller.
@@ -446,7 +699,9 @@ uint32_t sdl_load_fp(uint32_t langId, FILE *fp)
  *  if it was returned by the plugin.
  *
  * Input Parameters:
- *  None.
+ *  langEna:
+ *      An array containing the language enabled flag for each of the
+ *      languages.
  *
  * Output Parameters:
  *  None.
@@ -454,7 +709,7 @@ uint32_t sdl_load_fp(uint32_t langId, FILE *fp)
  * Return Values:
  *  SDL_NORMAL  - Normal successful completion
  */
-uint32_t sdl_call_commentStars(void)
+uint32_t sdl_call_commentStars(bool *langEna)
 {
     uint32_t retVal = SDL_NORMAL;
     uint32_t ii;
@@ -466,7 +721,8 @@ uint32_t sdl_call_commentStars(void)
          ((ii < _sdl_plugin_info_count) && (retVal == SDL_NORMAL));
          ii++)
     {
-        if (_sdl_plugin_info[ii].sdl_tv_commentStars != NULL)
+        if ((_sdl_plugin_info[ii].sdl_tv_commentStars != NULL) &&
+            (langEna[ii] == true))
         {
             retVal = (*_sdl_plugin_info[ii].sdl_tv_commentStars)();
         }
@@ -484,6 +740,9 @@ uint32_t sdl_call_commentStars(void)
  *  if it was returned by the plugin.
  *
  * Input Parameters:
+ *  langEna:
+ *      An array containing the language enabled flag for each of the
+ *      languages.
  *  timeInfo:
  *      A pointer to a time structure containing the start time of this
  *      compile.
@@ -494,7 +753,7 @@ uint32_t sdl_call_commentStars(void)
  * Return Values:
  *  SDL_NORMAL  - Normal successful completion
  */
-uint32_t sdl_call_createdByInfo(struct tm *timeInfo)
+uint32_t sdl_call_createdByInfo(bool *langEna, struct tm *timeInfo)
 {
     uint32_t retVal = SDL_NORMAL;
     uint32_t ii;
@@ -506,7 +765,8 @@ uint32_t sdl_call_createdByInfo(struct tm *timeInfo)
          ((ii < _sdl_plugin_info_count) && (retVal == SDL_NORMAL));
          ii++)
     {
-        if (_sdl_plugin_info[ii].sdl_tv_createdByInfo != NULL)
+        if ((_sdl_plugin_info[ii].sdl_tv_createdByInfo != NULL) &&
+            (langEna[ii] == true))
         {
             retVal = (*_sdl_plugin_info[ii].sdl_tv_createdByInfo)(timeInfo);
         }
@@ -524,6 +784,9 @@ uint32_t sdl_call_createdByInfo(struct tm *timeInfo)
  *  if it was returned by the plugin.
  *
  * Input Parameters:
+ *  langEna:
+ *      An array containing the language enabled flag for each of the
+ *      languages.
  *  timeInfo:
  *      A pointer to a time structure containing the modify time of the input
  *      file.
@@ -537,7 +800,7 @@ uint32_t sdl_call_createdByInfo(struct tm *timeInfo)
  * Return Values:
  *  SDL_NORMAL  - Normal successful completion
  */
-uint32_t sdl_call_fileInfo(struct tm *timeInfo, char *filePath)
+uint32_t sdl_call_fileInfo(bool *langEna, struct tm *timeInfo, char *filePath)
 {
     uint32_t retVal = SDL_NORMAL;
     uint32_t ii;
@@ -549,7 +812,8 @@ uint32_t sdl_call_fileInfo(struct tm *timeInfo, char *filePath)
          ((ii < _sdl_plugin_info_count) && (retVal == SDL_NORMAL));
          ii++)
     {
-        if (_sdl_plugin_info[ii].sdl_tv_fileInfo != NULL)
+        if ((_sdl_plugin_info[ii].sdl_tv_fileInfo != NULL) &&
+            (langEna[ii] == true))
         {
             retVal = (*_sdl_plugin_info[ii].sdl_tv_fileInfo)(timeInfo,
                                                              filePath);
@@ -924,6 +1188,72 @@ uint32_t sdl_call_aggregate(bool *langEna,
     return(retVal);
 }
 
+/*
+ * sdl_call_layout
+ *  This function is called to give the layout of a whole AGGREGATE to each
+ *  of the plugins.  A plugin that supports SDL_API_AGGREGATE_V2 is given the
+ *  layout in a single call.  Otherwise, the plugin's AGGREGATE function is
+ *  called for each entry in the layout, just as it always has been.
+ *
+ * Input Parameters:
+ *  langEna:
+ *      An array containing the language enabled flag for each of the
+ *      languages.
+ *  layout:
+ *    A pointer to the layout of the AGGREGATE.
+ *  context:
+ *    A pointer to the context block to be used to determine the type string.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL  - Normal successful completion
+ */
+uint32_t sdl_call_layout(bool *langEna,
+                         SDL_LANG_LAYOUT *layout,
+                         SDL_CONTEXT *context)
+{
+    uint32_t retVal = SDL_NORMAL;
+    uint32_t ii;
+    uint32_t jj;
+
+    /*
+     * Loop through each of the plugins, calling their equivalent function.
+     */
+    for (ii = 0;
+         ((ii < _sdl_plugin_info_count) && (retVal == SDL_NORMAL));
+         ii++)
+    {
+        SDL_PLUGIN_INFO *info = &_sdl_plugin_info[ii];
+
+        if ((info->sdl_tv_aggregateV2 != NULL) && (langEna[ii] == true))
+        {
+            retVal = (*info->sdl_tv_aggregateV2)(layout, context);
+        }
+        else if ((info->sdl_tv_aggregate != NULL) && (langEna[ii] == true))
+        {
+            for (jj = 0;
+                 ((jj < layout->memberCount) && (retVal == SDL_NORMAL));
+                 jj++)
+            {
+                SDL_LANG_MEMBER *member = &layout->members[jj];
+
+                retVal = (*info->sdl_tv_aggregate)(member->param.parameter,
+                                                   member->type,
+                                                   member->ending,
+                                                   member->depth,
+                                                   context);
+            }
+        }
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return(retVal);
+}
+
 /*
  * sdl_call_entry
  *  This function is called to call the plugin specific version of this call,
@@ -1015,7 +1345,9 @@ uint32_t sdl_call_literal(bool *langEna, char *line)
 
 /*
  * sdl_close_all
- *  This function is called to close all the language files.
+ *  This function is called to close all the language files opened for the
+ *  compilation running on the current thread.  Every plugin is called, even
+ *  if one of them fails.
  *
  * Input Parameters:
  *  None.
@@ -1025,28 +1357,131 @@ uint32_t sdl_call_literal(bool *langEna, char *line)
  *
  * Return Values:
  *  SDL_NORMAL  - Normal successful completion
+ *  Any status returned by the first plugin to fail.
  */
 uint32_t sdl_call_close(void)
 {
     uint32_t retVal = SDL_NORMAL;
+    uint32_t status;
     uint32_t ii;
 
     /*
      * Loop through each of the plugins, calling their equivalent function.
      */
-    for (ii = 0;
-         ((ii < _sdl_plugin_info_count) && (retVal == SDL_NORMAL));
-         ii++)
+    for (ii = 0; ii < _sdl_plugin_info_count; ii++)
+    {
+        status = (*_sdl_plugin_info[ii].sdl_tv_close)();
+        if (retVal == SDL_NORMAL)
+        {
+            retVal = status;
+        }
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_plugin_count
+ *  This function is called to get the number of plugins loaded.  This is the
+ *  number of entries needed in a language enabled array.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  The number of plugins loaded.
+ */
+uint32_t sdl_plugin_count(void)
+{
+    return(_sdl_plugin_info_count);
+}
+
+/*
+ * sdl_plugin_lang
+ *  This function is called to get the language name for a loaded plugin.
+ *
+ * Input Parameters:
+ *  langId:
+ *      A value indicating the identifier returned by sdl_load_plugin.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:   There is no plugin loaded with this identifier.
+ *  !NULL:  A pointer to the language name for the plugin.
+ */
+char *sdl_plugin_lang(uint32_t langId)
+{
+    return((langId < _sdl_plugin_info_count) ?
+            _sdl_plugin_info[langId].lang : NULL);
+}
+
+/*
+ * sdl_plugin_image
+ *  This function is called to get the path to the shared library from which
+ *  a plugin was loaded.
+ *
+ * Input Parameters:
+ *  langId:
+ *      A value indicating the identifier returned by sdl_load_plugin.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:   There is no plugin loaded with this identifier.
+ *  !NULL:  A pointer to the path to the plugin's shared library.
+ */
+char *sdl_plugin_image(uint32_t langId)
+{
+    return((langId < _sdl_plugin_info_count) ?
+            _sdl_plugin_info[langId].image : NULL);
+}
+
+/*
+ * sdl_unload_plugins
+ *  This function is called to free the table of loaded plugins.  It must not
+ *  be called while any compilation is still running.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_unload_plugins(void)
+{
+    uint32_t ii;
+
+    for (ii = 0; ii < _sdl_plugin_info_count; ii++)
     {
-        retVal = (*_sdl_plugin_info[ii].sdl_tv_close)();
         sdl_free(_sdl_plugin_info[ii].lang);
         sdl_free(_sdl_plugin_info[ii].fileExt);
+        if (_sdl_plugin_info[ii].image != NULL)
+        {
+            sdl_free(_sdl_plugin_info[ii].image);
+        }
+    }
+    if (_sdl_plugin_info != NULL)
+    {
+        sdl_free(_sdl_plugin_info);
     }
-    sdl_free(_sdl_plugin_info);
+    _sdl_plugin_info = NULL;
+    _sdl_plugin_info_count = 0;
 
     /*
      * Return back to the caller.
      */
-    return(retVal);
+    return;
 }
 
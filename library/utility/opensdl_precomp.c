@@ -0,0 +1,772 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the precompiled INCLUDE files.  When there is a
+ *  cache directory, the scanner gives each INCLUDE to the parser, which
+ *  calls sdl_precomp_include.  An INCLUDE outside of a MODULE, and outside
+ *  of any IFLANGUAGE or IFSYMBOL, is the same no matter what file it is
+ *  included from, because a MODULE starts out with nothing defined.  So, the
+ *  module IR for each MODULE in the INCLUDE file, and anything outside of
+ *  them, is recorded as it is emitted, and the recording is written to the
+ *  cache directory when the end of the INCLUDE file is reached.
+ *
+ *  The key for a precompiled INCLUDE file is a hash of its full path, the
+ *  current directory, the image that is running, the arguments that change
+ *  what is parsed, and the languages.  The file also lists the size and modification time of the
+ *  INCLUDE file, and of every file it INCLUDEs, when they were read.  If
+ *  none of them have changed, the recording is mapped into memory and
+ *  replayed, in place of reading the INCLUDE file.
+ *
+ *  An INCLUDE file is only precompiled if it was parsed without a
+ *  diagnostic, and it ends outside of a MODULE and of any IFLANGUAGE or
+ *  IFSYMBOL, without leaving any local variables defined.  A file that
+ *  cannot be read or written is a cache miss, never an error.
+ *
+ * Revision History:
+ *
+ *  V01.000	16-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	16-OCT-2026	Jonathan D. Belanger
+ *  Calls are recorded in the trace rather than written to standard output.
+ *
+ *  V01.002	16-OCT-2026	Jonathan D. Belanger
+ *  The image that is running is part of the key, so that a precompiled
+ *  INCLUDE file recorded by a different build is never replayed.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_sink.h"
+#include "library/common/opensdl_trace.h"
+#include "library/utility/opensdl_cache.h"
+#include "library/utility/opensdl_include.h"
+#include "library/utility/opensdl_record.h"
+#include "library/utility/opensdl_precomp.h"
+#include "opensdl/opensdl_main.h"
+
+/*
+ * The length of a file name in a precompiled INCLUDE file, rounded up to the
+ * next 8 byte boundary.
+ */
+#define SDL_PRECOMP_PAD(len)    (((len) + 7) & ~((size_t) 7))
+
+/*
+ * The INCLUDE file being precompiled.  The files it was made from are kept
+ * in a sink, just as they are written out.
+ */
+typedef struct _sdl_precomp
+{
+    SDL_RECORDING   recording;
+    SDL_SINK        files;
+    char            *path;
+    uint32_t        fileCount;
+    uint32_t        diagnostics;
+    bool            valid;
+} SDL_PRECOMP;
+
+/*
+ * Local Prototypes
+ */
+static bool _sdl_precomp_eligible(SDL_CONTEXT *context);
+static bool _sdl_precomp_path(SDL_CONTEXT *context,
+                              const char *fileName,
+                              char *path);
+static uint32_t _sdl_precomp_load(SDL_CONTEXT *context,
+                                  const char *path,
+                                  bool *loaded);
+static bool _sdl_precomp_files(SDL_CONTEXT *context,
+                               uint8_t *files,
+                               uint8_t *end,
+                               uint32_t fileCount,
+                               bool record);
+static void _sdl_precomp_file(SDL_PRECOMP *precomp, const char *fileName);
+
+/*
+ * sdl_precomp_include
+ *  This function is called when the parser is given an INCLUDE.  If the
+ *  INCLUDE file has been precompiled, and it is up to date, it is replayed.
+ *  Otherwise, it is to be read by the scanner, and if it can be precompiled,
+ *  it is recorded as it is parsed.  If an INCLUDE file is already being
+ *  precompiled, this one is just one of the files it is made from.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.
+ *  fileName:
+ *      A pointer to the name of the INCLUDE file.
+ *
+ * Output Parameters:
+ *  loaded:
+ *      A pointer to a boolean to receive an indicator that the INCLUDE file
+ *      was replayed, and is not to be read.
+ *  precompile:
+ *      A pointer to a boolean to receive an indicator that the INCLUDE file
+ *      is being precompiled, and sdl_precomp_end is to be called when the
+ *      end of it is reached.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ *  Anything returned by sdl_replay_buffer.
+ */
+uint32_t sdl_precomp_include(SDL_CONTEXT *context,
+                             char *fileName,
+                             bool *loaded,
+                             bool *precompile)
+{
+    SDL_PRECOMP *precomp;
+    char path[PATH_MAX];
+    uint32_t retVal = SDL_NORMAL;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_precomp_include");
+
+    *loaded = false;
+    *precompile = false;
+    if (context->precomp != NULL)
+    {
+        _sdl_precomp_file(context->precomp, fileName);
+    }
+    else if ((_sdl_precomp_eligible(context) == true) &&
+             (_sdl_precomp_path(context, fileName, path) == true))
+    {
+        retVal = _sdl_precomp_load(context, path, loaded);
+
+        /*
+         * If it was not replayed, then start precompiling it.
+         */
+        if ((retVal == SDL_NORMAL) && (*loaded == false))
+        {
+            precomp = sdl_calloc(1, sizeof(SDL_PRECOMP));
+            if (precomp != NULL)
+            {
+                context->precomp = precomp;
+                sdl_sink_init(&precomp->files, NULL);
+                precomp->path = sdl_strdup_heap(path);
+                precomp->diagnostics = context->diagnostics;
+                precomp->valid = (sdl_record_init(&precomp->recording) ==
+                                  true) &&
+                                 (precomp->path != NULL);
+                _sdl_precomp_file(precomp, fileName);
+                if (precomp->valid == true)
+                {
+                    *precompile = true;
+                }
+                else
+                {
+                    sdl_precomp_release(context);
+                }
+            }
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_precomp_node
+ *  This function is called when a node is emitted outside of a MODULE, to
+ *  add it to the INCLUDE file being precompiled, if there is one.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.
+ *  node:
+ *      A pointer to the node being emitted.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_precomp_node(SDL_CONTEXT *context, SDL_IR_NODE *node)
+{
+    SDL_PRECOMP *precomp = context->precomp;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_precomp_node");
+
+    if ((precomp != NULL) && (precomp->valid == true))
+    {
+        precomp->valid = sdl_record_node(&precomp->recording, node, context);
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_precomp_module
+ *  This function is called when the IR for a MODULE is complete, before it
+ *  is emitted, to add the whole IR to the INCLUDE file being precompiled, if
+ *  there is one.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_precomp_module(SDL_CONTEXT *context)
+{
+    SDL_PRECOMP *precomp = context->precomp;
+    SDL_IR_NODE *node = (SDL_IR_NODE *) context->ir.nodes.flink;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_precomp_module");
+
+    while ((precomp != NULL) &&
+           (precomp->valid == true) &&
+           (node != (SDL_IR_NODE *) &context->ir.nodes))
+    {
+        precomp->valid = sdl_record_node(&precomp->recording, node, context);
+        node = (SDL_IR_NODE *) node->queue.flink;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_precomp_end
+ *  This function is called when the parser has been told that the end of
+ *  the INCLUDE file being precompiled has been reached.  If it can be
+ *  precompiled, it is written to the cache directory.  Either way, it is no
+ *  longer being precompiled.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_precomp_end(SDL_CONTEXT *context)
+{
+    SDL_PRECOMP *precomp = context->precomp;
+    SDL_PRECOMP_HEADER header;
+    char *buffer;
+    size_t length;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_precomp_end");
+
+    if ((precomp != NULL) &&
+        (precomp->valid == true) &&
+        (precomp->diagnostics == context->diagnostics) &&
+        (context->parseStatus == SDL_NORMAL) &&
+        (_sdl_precomp_eligible(context) == true))
+    {
+        sdl_record_finish(&precomp->recording);
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SDL_K_PRECOMP_MAGIC, SDL_K_PRECOMP_MAGIC_LEN);
+        header.version = SDL_K_PRECOMP_VERSION;
+        header.fileCount = precomp->fileCount;
+        header.fileLength = precomp->files.used;
+        header.bodyLength = precomp->recording.sink.used;
+        header.bodyHash = sdl_cache_hash(SDL_K_FNV64_BASIS,
+                                         precomp->recording.sink.buffer,
+                                         precomp->recording.sink.used);
+        length = sizeof(header) + header.fileLength + header.bodyLength;
+        buffer = sdl_calloc(length, 1);
+        if ((buffer != NULL) &&
+            (precomp->files.error == 0) &&
+            (precomp->recording.sink.error == 0))
+        {
+            memcpy(buffer, &header, sizeof(header));
+            memcpy(&buffer[sizeof(header)],
+                   precomp->files.buffer,
+                   header.fileLength);
+            memcpy(&buffer[sizeof(header) + header.fileLength],
+                   precomp->recording.sink.buffer,
+                   header.bodyLength);
+            sdl_cache_write(precomp->path, buffer, length);
+        }
+        if (buffer != NULL)
+        {
+            sdl_free(buffer);
+        }
+    }
+    sdl_precomp_release(context);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_precomp_release
+ *  This function is called to stop precompiling an INCLUDE file, without
+ *  writing it out.  This is done when the parse ends, in case it ended in
+ *  the middle of one.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_precomp_release(SDL_CONTEXT *context)
+{
+    SDL_PRECOMP *precomp = context->precomp;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_precomp_release");
+
+    if (precomp != NULL)
+    {
+        sdl_record_free(&precomp->recording);
+        if (precomp->files.buffer != NULL)
+        {
+            sdl_free(precomp->files.buffer);
+        }
+        if (precomp->path != NULL)
+        {
+            sdl_free(precomp->path);
+        }
+        sdl_free(precomp);
+        context->precomp = NULL;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/************************************************************************/
+/* Local Functions                                                      */
+/************************************************************************/
+
+/*
+ * _sdl_precomp_eligible
+ *  This function is called to determine if what has been parsed so far
+ *  makes no difference to an INCLUDE file, so that it can be precompiled.
+ *  This is the case outside of a MODULE, and outside of any IFLANGUAGE or
+ *  IFSYMBOL, when no local variables are defined.  A listing file needs the
+ *  INCLUDE file to be read, so nothing is precompiled when there is one.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:   An INCLUDE file can be precompiled, or replayed, here.
+ *  false:  An INCLUDE file needs to be read here.
+ */
+static bool _sdl_precomp_eligible(SDL_CONTEXT *context)
+{
+    return((context->argument[ArgCacheDir].present == true) &&
+           (context->listing.on == false) &&
+           (context->ir.open == false) &&
+           (context->condState.top == 0) &&
+           (context->processingEnabled == true) &&
+           (SDL_Q_EMPTY(&context->locals) == true));
+}
+
+/*
+ * _sdl_precomp_path
+ *  This function is called to get the name of the precompiled INCLUDE file
+ *  in the cache directory, which is the key for the INCLUDE file.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.  The
+ *      arguments and languages in it are part of the key.
+ *  fileName:
+ *      A pointer to the name of the INCLUDE file.
+ *
+ * Output Parameters:
+ *  path:
+ *      A pointer to a buffer of PATH_MAX characters to receive the name.
+ *
+ * Return Values:
+ *  true:   The name was determined.
+ *  false:  The INCLUDE file, or the image that is running, does not exist.
+ */
+static bool _sdl_precomp_path(SDL_CONTEXT *context,
+                              const char *fileName,
+                              char *path)
+{
+    SDL_ARGUMENTS *args = context->argument;
+    SDL_LANGUAGES *languages = args[ArgLanguage].languages;
+    SDL_SYMBOL_LIST *symbols = args[ArgSymbols].symbol;
+    char buffer[PATH_MAX + 64];
+    char *fullPath = realpath(fileName, NULL);
+    uint64_t hash = SDL_K_FNV64_BASIS;
+    int ii;
+
+    if (fullPath == NULL)
+    {
+        return(false);
+    }
+
+    /*
+     * The version goes into the key, so that a precompiled INCLUDE file in a
+     * format we do not know is never looked at.  The INCLUDE files it
+     * INCLUDEs are opened from the current directory.
+     */
+    sprintf(buffer,
+            "%s %d %d",
+            SDL_K_PRECOMP_EXT,
+            SDL_K_PRECOMP_VERSION,
+            SDL_K_RECORD_VERSION);
+    hash = sdl_cache_hash_str(hash, buffer);
+    hash = sdl_cache_hash_str(hash, fullPath);
+    free(fullPath);
+    if (getcwd(buffer, sizeof(buffer)) != NULL)
+    {
+        hash = sdl_cache_hash_str(hash, buffer);
+    }
+
+    /*
+     * The record version does not change with every build of the parser and
+     * the action routines that make the IR, so the image that is running goes
+     * into the key too.
+     */
+    if (sdl_cache_hash_image(&hash) == false)
+    {
+        return(false);
+    }
+
+    /*
+     * The arguments that change what is parsed, and the languages, in order,
+     * since each node is recorded with the languages it is for.
+     */
+    sprintf(buffer,
+            "a%d k%d c%d m%d Sp%d St%d b%d",
+            args[ArgAlignment].value,
+            args[ArgCheckAlignment].on,
+            args[ArgComments].on,
+            args[ArgMemberAlign].on,
+            args[ArgSuppressPrefix].on,
+            args[ArgSuppressTag].on,
+            args[ArgWordSize].value);
+    hash = sdl_cache_hash_str(hash, buffer);
+    for (ii = 0; ((symbols != NULL) && (ii < symbols->listUsed)); ii++)
+    {
+        hash = sdl_cache_hash_str(hash, symbols->symbols[ii].symbol);
+        sprintf(buffer, "=%d", symbols->symbols[ii].value);
+        hash = sdl_cache_hash_str(hash, buffer);
+    }
+    for (ii = 0; ii < context->languagesSpecified; ii++)
+    {
+        hash = sdl_cache_hash_str(hash, languages[ii].langStr);
+    }
+    snprintf(path,
+             PATH_MAX,
+             "%s/%016llx.%s",
+             args[ArgCacheDir].fileName,
+             (unsigned long long) hash,
+             SDL_K_PRECOMP_EXT);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(true);
+}
+
+/*
+ * _sdl_precomp_load
+ *  This function is called to replay a precompiled INCLUDE file, if there is
+ *  one and none of the files it was made from have changed.  It is mapped
+ *  into memory and replayed where it is.  The files it was made from are put
+ *  in the context's list of INCLUDE files, as if they had been opened.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.
+ *  path:
+ *      A pointer to the name of the precompiled INCLUDE file.
+ *
+ * Output Parameters:
+ *  loaded:
+ *      A pointer to a boolean to receive an indicator that the precompiled
+ *      INCLUDE file was replayed.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ *  Anything returned by sdl_replay_buffer.
+ */
+static uint32_t _sdl_precomp_load(SDL_CONTEXT *context,
+                                  const char *path,
+                                  bool *loaded)
+{
+    SDL_PRECOMP_HEADER *header;
+    struct stat fileStats;
+    uint8_t *map = MAP_FAILED;
+    uint8_t *files;
+    uint8_t *body;
+    size_t length = 0;
+    uint32_t retVal = SDL_NORMAL;
+    bool valid = false;
+    int fd = open(path, O_RDONLY);
+
+    /*
+     * The mapping is private and writable, so that the blocks rebuilt from it
+     * can be treated like any others, without changing the file.
+     */
+    if (fd >= 0)
+    {
+        if ((fstat(fd, &fileStats) == 0) &&
+            (fileStats.st_size >= sizeof(SDL_PRECOMP_HEADER)))
+        {
+            length = fileStats.st_size;
+            map = mmap(NULL,
+                       length,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE,
+                       fd,
+                       0);
+        }
+        close(fd);
+    }
+    if (map != MAP_FAILED)
+    {
+        header = (SDL_PRECOMP_HEADER *) map;
+        files = map + sizeof(SDL_PRECOMP_HEADER);
+        body = files + header->fileLength;
+        valid = (memcmp(header->magic,
+                        SDL_K_PRECOMP_MAGIC,
+                        SDL_K_PRECOMP_MAGIC_LEN) == 0) &&
+                (header->version == SDL_K_PRECOMP_VERSION) &&
+                (header->fileLength <= length) &&
+                (header->bodyLength <= length) &&
+                ((sizeof(SDL_PRECOMP_HEADER) +
+                  header->fileLength +
+                  header->bodyLength) == length);
+        if (valid == true)
+        {
+            valid = (_sdl_precomp_files(context,
+                                        files,
+                                        body,
+                                        header->fileCount,
+                                        false) == true) &&
+                    (sdl_cache_hash(SDL_K_FNV64_BASIS,
+                                    body,
+                                    header->bodyLength) == header->bodyHash);
+        }
+
+        /*
+         * It is up to date, so the files it was made from are now INCLUDE
+         * files of this compilation, and it is replayed.
+         */
+        if (valid == true)
+        {
+            *loaded = true;
+            if (_sdl_precomp_files(context,
+                                   files,
+                                   body,
+                                   header->fileCount,
+                                   true) == true)
+            {
+                retVal = sdl_replay_buffer(context,
+                                           body,
+                                           header->bodyLength,
+                                           (char *) path);
+            }
+            else
+            {
+                retVal = SDL_ABORT;
+                if (sdl_set_message(context->msgVec,
+                                    2,
+                                    retVal,
+                                    ENOMEM) != SDL_NORMAL)
+                {
+                    retVal = SDL_ERREXIT;
+                }
+            }
+        }
+        munmap(map, length);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_precomp_files
+ *  This function is called to go through the files a precompiled INCLUDE
+ *  file was made from, either to check that none of them have changed, or
+ *  to put them in the context's list of INCLUDE files.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure for the compilation.
+ *  files:
+ *      A pointer to the first of the files.
+ *  end:
+ *      A pointer to just past the last of the files.
+ *  fileCount:
+ *      A value indicating the number of files.
+ *  record:
+ *      A boolean indicating that the files are to be put in the context's
+ *      list of INCLUDE files, rather than checked.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:   None of the files have changed, or they were all put in the
+ *          list.
+ *  false:  A file has changed, or could not be put in the list.
+ */
+static bool _sdl_precomp_files(SDL_CONTEXT *context,
+                               uint8_t *files,
+                               uint8_t *end,
+                               uint32_t fileCount,
+                               bool record)
+{
+    SDL_PRECOMP_FILE *file;
+    struct stat fileStats;
+    char *name;
+    bool retVal = true;
+    uint32_t ii;
+
+    for (ii = 0; ((retVal == true) && (ii < fileCount)); ii++)
+    {
+        file = (SDL_PRECOMP_FILE *) files;
+        name = (char *) &file[1];
+        if (((uint8_t *) name > end) ||
+            (file->nameLength == 0) ||
+            (file->nameLength > (end - (uint8_t *) name)) ||
+            (name[file->nameLength - 1] != '\0'))
+        {
+            retVal = false;
+        }
+        else if (record == true)
+        {
+            retVal = sdl_include_record(&context->includes, name) ==
+                     SDL_NORMAL;
+        }
+        else
+        {
+            retVal = (stat(name, &fileStats) == 0) &&
+                     (fileStats.st_size == file->size) &&
+                     (fileStats.st_mtim.tv_sec == file->mtimeSec) &&
+                     (fileStats.st_mtim.tv_nsec == file->mtimeNsec);
+        }
+        files = (uint8_t *) name + SDL_PRECOMP_PAD(file->nameLength);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_precomp_file
+ *  This function is called to add a file to the files an INCLUDE file being
+ *  precompiled is made from, with the size and modification time it has
+ *  before it is read.  If it cannot be found, it is read from somewhere the
+ *  next compilation cannot check, so the INCLUDE file is not precompiled.
+ *
+ * Input Parameters:
+ *  precomp:
+ *      A pointer to the INCLUDE file being precompiled.
+ *  fileName:
+ *      A pointer to the name of the file, as it is opened.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_precomp_file(SDL_PRECOMP *precomp, const char *fileName)
+{
+    static const char padding[8] = {0};
+    SDL_PRECOMP_FILE file;
+    struct stat fileStats;
+    size_t nameLength = strlen(fileName) + 1;
+
+    if ((precomp->valid == true) && (stat(fileName, &fileStats) == 0))
+    {
+        memset(&file, 0, sizeof(file));
+        file.size = fileStats.st_size;
+        file.mtimeSec = fileStats.st_mtim.tv_sec;
+        file.mtimeNsec = fileStats.st_mtim.tv_nsec;
+        file.nameLength = nameLength;
+        sdl_sink_write(&precomp->files, (char *) &file, sizeof(file));
+        sdl_sink_write(&precomp->files, fileName, nameLength);
+        sdl_sink_write(&precomp->files,
+                       padding,
+                       SDL_PRECOMP_PAD(nameLength) - nameLength);
+        precomp->fileCount++;
+    }
+    else
+    {
+        precomp->valid = false;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
@@ -0,0 +1,2459 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the event recorder and the replay driver.  The
+ *  recorder is a language that is always built into the image, called
+ *  "record".  Everything it is called with is written to its output file,
+ *  the recording, in the order it was called (see opensdl_record.h for the
+ *  format).  Since it is called just like any other language, a recording
+ *  holds the calls any language would have been given, other than the ones
+ *  inside an IFLANGUAGE for other languages.
+ *
+ *  The replay driver reads a recording and makes the same calls to the
+ *  languages that have been loaded, without scanning or parsing anything.
+ *  The blocks for each call are rebuilt in the context's arena, with the
+ *  strings left where they are in the recording.  So that user types can
+ *  still be looked up, the DECLAREs, ITEMs and AGGREGATEs for each MODULE
+ *  are recorded with the MODULE, and put back in the context's queues and
+ *  symbol tables.  The options the plugins look at are recorded with each
+ *  MODULE as well, and replace the ones in the context.
+ *
+ *  A recording can also be made from the module IR, for a precompiled
+ *  INCLUDE file.  The same records are written, along with the languages
+ *  each node was added for, so that IFLANGUAGE is replayed as it was parsed.
+ *
+ * Revision History:
+ *
+ *  V01.000	16-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	16-OCT-2026	Jonathan D. Belanger
+ *  Split sdl_replay_buffer out of sdl_replay_file, and added the languages
+ *  record and the functions to make a recording from the module IR.
+ *
+ *  V01.002	16-OCT-2026	Jonathan D. Belanger
+ *  Calls are recorded in the trace rather than written to standard output.
+ */
+#include <errno.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "opensdl_defs.h"
+#include "library/language/opensdl_lang.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_sink.h"
+#include "library/common/opensdl_symtab.h"
+#include "library/common/opensdl_trace.h"
+#include "library/utility/opensdl_plugin.h"
+#include "library/utility/opensdl_plugin_funcs.h"
+#include "library/utility/opensdl_record.h"
+#include "opensdl/opensdl_main.h"
+
+/*
+ * The fields of a block that are recorded are described by a table, which is
+ * used both to write them out and to read them back in.  Pointers, other
+ * than strings, and queues are not recorded.
+ */
+typedef enum
+{
+    RecEnd,
+    RecStr,
+    RecInt64,
+    RecInt,
+    RecBool
+} SDL_RECORD_KIND;
+typedef struct
+{
+    size_t          offset;
+    SDL_RECORD_KIND kind;
+} SDL_RECORD_FIELD;
+#define SDL_REC(type, field, kind)  {offsetof(type, field), kind}
+#define SDL_REC_END                 {0, RecEnd}
+
+static const SDL_RECORD_FIELD _sdl_rec_tm[] =
+{
+    SDL_REC(struct tm, tm_sec, RecInt),
+    SDL_REC(struct tm, tm_min, RecInt),
+    SDL_REC(struct tm, tm_hour, RecInt),
+    SDL_REC(struct tm, tm_mday, RecInt),
+    SDL_REC(struct tm, tm_mon, RecInt),
+    SDL_REC(struct tm, tm_year, RecInt),
+    SDL_REC(struct tm, tm_wday, RecInt),
+    SDL_REC(struct tm, tm_yday, RecInt),
+    SDL_REC(struct tm, tm_isdst, RecInt),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_declare[] =
+{
+    SDL_REC(SDL_DECLARE, id, RecStr),
+    SDL_REC(SDL_DECLARE, prefix, RecStr),
+    SDL_REC(SDL_DECLARE, tag, RecStr),
+    SDL_REC(SDL_DECLARE, size, RecInt64),
+    SDL_REC(SDL_DECLARE, type, RecInt),
+    SDL_REC(SDL_DECLARE, typeID, RecInt),
+    SDL_REC(SDL_DECLARE, _unsigned, RecBool),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_item[] =
+{
+    SDL_REC(SDL_ITEM, id, RecStr),
+    SDL_REC(SDL_ITEM, prefix, RecStr),
+    SDL_REC(SDL_ITEM, tag, RecStr),
+    SDL_REC(SDL_ITEM, hbound, RecInt64),
+    SDL_REC(SDL_ITEM, lbound, RecInt64),
+    SDL_REC(SDL_ITEM, length, RecInt64),
+    SDL_REC(SDL_ITEM, subType, RecInt64),
+    SDL_REC(SDL_ITEM, offset, RecInt64),
+    SDL_REC(SDL_ITEM, precision, RecInt64),
+    SDL_REC(SDL_ITEM, scale, RecInt64),
+    SDL_REC(SDL_ITEM, size, RecInt64),
+    SDL_REC(SDL_ITEM, alignment, RecInt),
+    SDL_REC(SDL_ITEM, bitOffset, RecInt),
+    SDL_REC(SDL_ITEM, type, RecInt),
+    SDL_REC(SDL_ITEM, typeID, RecInt),
+    SDL_REC(SDL_ITEM, commonDef, RecBool),
+    SDL_REC(SDL_ITEM, dimension, RecBool),
+    SDL_REC(SDL_ITEM, fill, RecBool),
+    SDL_REC(SDL_ITEM, globalDef, RecBool),
+    SDL_REC(SDL_ITEM, mask, RecBool),
+    SDL_REC(SDL_ITEM, parentAlignment, RecBool),
+    SDL_REC(SDL_ITEM, sizedBitfield, RecBool),
+    SDL_REC(SDL_ITEM, tagSet, RecBool),
+    SDL_REC(SDL_ITEM, typeDef, RecBool),
+    SDL_REC(SDL_ITEM, _unsigned, RecBool),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_constant[] =
+{
+    SDL_REC(SDL_CONSTANT, comment, RecStr),
+    SDL_REC(SDL_CONSTANT, id, RecStr),
+    SDL_REC(SDL_CONSTANT, prefix, RecStr),
+    SDL_REC(SDL_CONSTANT, tag, RecStr),
+    SDL_REC(SDL_CONSTANT, typeName, RecStr),
+    SDL_REC(SDL_CONSTANT, radix, RecInt),
+    SDL_REC(SDL_CONSTANT, type, RecInt),
+    SDL_REC(SDL_CONSTANT, size, RecInt),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_enumerate[] =
+{
+    SDL_REC(SDL_ENUMERATE, id, RecStr),
+    SDL_REC(SDL_ENUMERATE, prefix, RecStr),
+    SDL_REC(SDL_ENUMERATE, tag, RecStr),
+    SDL_REC(SDL_ENUMERATE, size, RecInt64),
+    SDL_REC(SDL_ENUMERATE, typeID, RecInt),
+    SDL_REC(SDL_ENUMERATE, alignment, RecInt),
+    SDL_REC(SDL_ENUMERATE, typeDef, RecBool),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_enum_member[] =
+{
+    SDL_REC(SDL_ENUM_MEMBER, comment, RecStr),
+    SDL_REC(SDL_ENUM_MEMBER, id, RecStr),
+    SDL_REC(SDL_ENUM_MEMBER, value, RecInt64),
+    SDL_REC(SDL_ENUM_MEMBER, valueSet, RecBool),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_aggregate[] =
+{
+    SDL_REC(SDL_AGGREGATE, basedPtrName, RecStr),
+    SDL_REC(SDL_AGGREGATE, id, RecStr),
+    SDL_REC(SDL_AGGREGATE, marker, RecStr),
+    SDL_REC(SDL_AGGREGATE, prefix, RecStr),
+    SDL_REC(SDL_AGGREGATE, tag, RecStr),
+    SDL_REC(SDL_AGGREGATE, origin.id, RecStr),
+    SDL_REC(SDL_AGGREGATE, currentOffset, RecInt64),
+    SDL_REC(SDL_AGGREGATE, hbound, RecInt64),
+    SDL_REC(SDL_AGGREGATE, lbound, RecInt64),
+    SDL_REC(SDL_AGGREGATE, size, RecInt64),
+    SDL_REC(SDL_AGGREGATE, aggType, RecInt),
+    SDL_REC(SDL_AGGREGATE, alignment, RecInt),
+    SDL_REC(SDL_AGGREGATE, currentBitOffset, RecInt),
+    SDL_REC(SDL_AGGREGATE, type, RecInt),
+    SDL_REC(SDL_AGGREGATE, typeID, RecInt),
+    SDL_REC(SDL_AGGREGATE, alignmentPresent, RecBool),
+    SDL_REC(SDL_AGGREGATE, commonDef, RecBool),
+    SDL_REC(SDL_AGGREGATE, dimension, RecBool),
+    SDL_REC(SDL_AGGREGATE, fill, RecBool),
+    SDL_REC(SDL_AGGREGATE, globalDef, RecBool),
+    SDL_REC(SDL_AGGREGATE, typeDef, RecBool),
+    SDL_REC(SDL_AGGREGATE, _unsigned, RecBool),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_subaggr[] =
+{
+    SDL_REC(SDL_SUBAGGR, basedPtrName, RecStr),
+    SDL_REC(SDL_SUBAGGR, id, RecStr),
+    SDL_REC(SDL_SUBAGGR, marker, RecStr),
+    SDL_REC(SDL_SUBAGGR, prefix, RecStr),
+    SDL_REC(SDL_SUBAGGR, tag, RecStr),
+    SDL_REC(SDL_SUBAGGR, currentOffset, RecInt64),
+    SDL_REC(SDL_SUBAGGR, hbound, RecInt64),
+    SDL_REC(SDL_SUBAGGR, lbound, RecInt64),
+    SDL_REC(SDL_SUBAGGR, offset, RecInt64),
+    SDL_REC(SDL_SUBAGGR, size, RecInt64),
+    SDL_REC(SDL_SUBAGGR, alignment, RecInt),
+    SDL_REC(SDL_SUBAGGR, currentBitOffset, RecInt),
+    SDL_REC(SDL_SUBAGGR, aggType, RecInt),
+    SDL_REC(SDL_SUBAGGR, type, RecInt),
+    SDL_REC(SDL_SUBAGGR, typeID, RecInt),
+    SDL_REC(SDL_SUBAGGR, dimension, RecBool),
+    SDL_REC(SDL_SUBAGGR, fill, RecBool),
+    SDL_REC(SDL_SUBAGGR, parentAlignment, RecBool),
+    SDL_REC(SDL_SUBAGGR, typeDef, RecBool),
+    SDL_REC(SDL_SUBAGGR, _unsigned, RecBool),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_comment[] =
+{
+    SDL_REC(SDL_COMMENT, comment, RecStr),
+    SDL_REC(SDL_COMMENT, endComment, RecBool),
+    SDL_REC(SDL_COMMENT, lineComment, RecBool),
+    SDL_REC(SDL_COMMENT, middleComment, RecBool),
+    SDL_REC(SDL_COMMENT, startComment, RecBool),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_member[] =
+{
+    SDL_REC(SDL_MEMBERS, offset, RecInt64),
+    SDL_REC(SDL_MEMBERS, type, RecInt),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_layout[] =
+{
+    SDL_REC(SDL_LANG_MEMBER, name, RecStr),
+    SDL_REC(SDL_LANG_MEMBER, typeName, RecStr),
+    SDL_REC(SDL_LANG_MEMBER, offset, RecInt64),
+    SDL_REC(SDL_LANG_MEMBER, size, RecInt64),
+    SDL_REC(SDL_LANG_MEMBER, length, RecInt64),
+    SDL_REC(SDL_LANG_MEMBER, elements, RecInt64),
+    SDL_REC(SDL_LANG_MEMBER, bitOffset, RecInt),
+    SDL_REC(SDL_LANG_MEMBER, typeID, RecInt),
+    SDL_REC(SDL_LANG_MEMBER, baseType, RecInt),
+    SDL_REC(SDL_LANG_MEMBER, depth, RecInt),
+    SDL_REC(SDL_LANG_MEMBER, ending, RecBool),
+    SDL_REC(SDL_LANG_MEMBER, _unsigned, RecBool),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_entry[] =
+{
+    SDL_REC(SDL_ENTRY, alias, RecStr),
+    SDL_REC(SDL_ENTRY, id, RecStr),
+    SDL_REC(SDL_ENTRY, linkage, RecStr),
+    SDL_REC(SDL_ENTRY, typeName, RecStr),
+    SDL_REC(SDL_ENTRY, returns.name, RecStr),
+    SDL_REC(SDL_ENTRY, returns.type, RecInt64),
+    SDL_REC(SDL_ENTRY, returns._unsigned, RecBool),
+    SDL_REC(SDL_ENTRY, variable, RecBool),
+    SDL_REC_END
+};
+static const SDL_RECORD_FIELD _sdl_rec_parameter[] =
+{
+    SDL_REC(SDL_PARAMETER, comment, RecStr),
+    SDL_REC(SDL_PARAMETER, name, RecStr),
+    SDL_REC(SDL_PARAMETER, typeName, RecStr),
+    SDL_REC(SDL_PARAMETER, bound, RecInt64),
+    SDL_REC(SDL_PARAMETER, defaultValue, RecInt64),
+    SDL_REC(SDL_PARAMETER, data, RecInt),
+    SDL_REC(SDL_PARAMETER, passingMech, RecInt),
+    SDL_REC(SDL_PARAMETER, type, RecInt),
+    SDL_REC(SDL_PARAMETER, defaultPresent, RecBool),
+    SDL_REC(SDL_PARAMETER, dimension, RecBool),
+    SDL_REC(SDL_PARAMETER, in, RecBool),
+    SDL_REC(SDL_PARAMETER, list, RecBool),
+    SDL_REC(SDL_PARAMETER, optional, RecBool),
+    SDL_REC(SDL_PARAMETER, out, RecBool),
+    SDL_REC(SDL_PARAMETER, _unsigned, RecBool),
+    SDL_REC_END
+};
+
+/*
+ * The options the plugins look at, which are recorded with each MODULE.
+ */
+static const SDL_ARG_ENTRY _sdl_rec_args[] =
+{
+    ArgComments,
+    ArgMemberAlign,
+    ArgSuppressPrefix,
+    ArgSuppressTag
+};
+#define SDL_K_REC_ARGS  (sizeof(_sdl_rec_args) / sizeof(SDL_ARG_ENTRY))
+
+/*
+ * The output file, output sink and message vector belong to the compilation
+ * running on this thread, as they do for any other language.
+ */
+static SDL_THREAD_LOCAL FILE *fp = NULL;
+static SDL_THREAD_LOCAL SDL_SINK *sink = NULL;
+static SDL_THREAD_LOCAL SDL_SINK _sdl_record_sink;
+static SDL_THREAD_LOCAL SDL_MSG_VECTOR *msgVec;
+
+/*
+ * The following is used to read through a recording.  Once an error is
+ * detected, nothing more is read.
+ */
+typedef struct
+{
+    uint8_t         *ptr;
+    uint8_t         *end;
+    bool            error;
+} SDL_REPLAY;
+
+/*
+ * Local Prototypes
+ */
+static uint32_t sdl_record_commentStars(void);
+static uint32_t sdl_record_createdByInfo(struct tm *timeInfo);
+static uint32_t sdl_record_fileInfo(struct tm *timeInfo, char *filePath);
+static uint32_t sdl_record_comment(char *comment,
+                                   bool lineComment,
+                                   bool startComment,
+                                   bool middleComment,
+                                   bool endComment);
+static uint32_t sdl_record_module(SDL_CONTEXT *context);
+static uint32_t sdl_record_module_end(SDL_CONTEXT *context);
+static uint32_t sdl_record_item(SDL_ITEM *item, SDL_CONTEXT *context);
+static uint32_t sdl_record_constant(SDL_CONSTANT *constant,
+                                    SDL_CONTEXT *context);
+static uint32_t sdl_record_enumerate(SDL_ENUMERATE *_enum,
+                                     SDL_CONTEXT *context);
+static uint32_t sdl_record_layout(SDL_LANG_LAYOUT *layout,
+                                  SDL_CONTEXT *context);
+static uint32_t sdl_record_entry(SDL_ENTRY *entry, SDL_CONTEXT *context);
+static uint32_t sdl_record_literal(char *line);
+static uint32_t sdl_record_close(void);
+static void _sdl_record_event(SDL_RECORD_EVENT event);
+static void _sdl_record_uint(uint64_t value);
+static void _sdl_record_int(int64_t value);
+static void _sdl_record_str(char *string);
+static void _sdl_record_fields(const SDL_RECORD_FIELD *fields, void *block);
+static void _sdl_record_queue(const SDL_RECORD_FIELD *fields,
+                              SDL_QUEUE *queue,
+                              size_t offset);
+static uint64_t _sdl_replay_uint(SDL_REPLAY *replay);
+static int64_t _sdl_replay_int(SDL_REPLAY *replay);
+static char *_sdl_replay_str(SDL_REPLAY *replay);
+static void _sdl_replay_fields(SDL_REPLAY *replay,
+                               const SDL_RECORD_FIELD *fields,
+                               void *block);
+static void *_sdl_replay_block(SDL_CONTEXT *context,
+                               SDL_REPLAY *replay,
+                               const SDL_RECORD_FIELD *fields,
+                               size_t size,
+                               SDL_BLOCK_ID blockID);
+static void _sdl_replay_queue(SDL_CONTEXT *context,
+                              SDL_REPLAY *replay,
+                              const SDL_RECORD_FIELD *fields,
+                              size_t size,
+                              SDL_BLOCK_ID blockID,
+                              SDL_QUEUE *queue);
+static void _sdl_replay_types(SDL_CONTEXT *context,
+                              SDL_REPLAY *replay,
+                              const SDL_RECORD_FIELD *fields,
+                              size_t size,
+                              size_t idOffset,
+                              size_t typeIDOffset,
+                              SDL_BLOCK_ID blockID,
+                              SDL_QUEUE *queue,
+                              SDL_SYMTAB *symtab);
+static SDL_LANG_LAYOUT *_sdl_replay_layout(SDL_CONTEXT *context,
+                                           SDL_REPLAY *replay);
+static void _sdl_replay_reset(SDL_CONTEXT *context);
+
+/*
+ * sdl_record_onLoad
+ *  This function is called to exchange a transfer vector with the recorder,
+ *  just as is done for any other language.  The recorder is always built
+ *  into the image, as the "record" language.
+ *
+ * Input Parameters:
+ *  tv:
+ *      A pointer to a transfer vector with the API version and address of the
+ *      message vector, or the output file and sink.
+ *
+ * Output Parameters:
+ *  tv:
+ *      A pointer to a transfer vector to receive the addresses of the
+ *      functions that need to be called by OpenSDL.
+ *
+ * Return Values:
+ *  SDL_NORMAL      - Normal successful completion
+ */
+uint32_t sdl_record_onLoad(SDL_API_TV *tv)
+{
+    uint32_t retVal = SDL_NORMAL;
+    uint32_t ii = 0;
+    SDL_SINK *mySink = NULL;
+    bool fpPresent = false;
+
+    /*
+     * Loop through the transfer vector.
+     */
+    while (tv[ii].tag != SDL_API_NULL)
+    {
+        switch (tv[ii].tag)
+        {
+            case SDL_API_MESSAGE_VECTOR:
+                msgVec = tv[ii].sdl_tv_msgVec;
+                break;
+
+            case SDL_API_OUTPUT_FP:
+                fp = tv[ii].sdl_tv_fp;
+                fpPresent = true;
+                break;
+
+            case SDL_API_OUTPUT_SINK:
+                mySink = tv[ii].sdl_tv_sink;
+                break;
+
+            case SDL_API_COMMENT_STAR:
+                tv[ii].sdl_tv_commentStars = sdl_record_commentStars;
+                break;
+
+            case SDL_API_CREATED_BY:
+                tv[ii].sdl_tv_createdByInfo = sdl_record_createdByInfo;
+                break;
+
+            case SDL_API_FILE_INFO:
+                tv[ii].sdl_tv_fileInfo = sdl_record_fileInfo;
+                break;
+
+            case SDL_API_COMMENT:
+                tv[ii].sdl_tv_comment = sdl_record_comment;
+                break;
+
+            case SDL_API_MODULE:
+                tv[ii].sdl_tv_module = sdl_record_module;
+                break;
+
+            case SDL_API_MODULE_END:
+                tv[ii].sdl_tv_moduleEnd = sdl_record_module_end;
+                break;
+
+            case SDL_API_ITEM:
+                tv[ii].sdl_tv_item = sdl_record_item;
+                break;
+
+            case SDL_API_CONSTANT:
+                tv[ii].sdl_tv_constant = sdl_record_constant;
+                break;
+
+            case SDL_API_ENUMERATE:
+                tv[ii].sdl_tv_enumerate = sdl_record_enumerate;
+                break;
+
+            case SDL_API_AGGREGATE_V2:
+                tv[ii].sdl_tv_aggregateV2 = sdl_record_layout;
+                break;
+
+            case SDL_API_ENTRY:
+                tv[ii].sdl_tv_entry = sdl_record_entry;
+                break;
+
+            case SDL_API_FILE_EXTENSION:
+                tv[ii].sdl_tv_string = sdl_strdup(SDL_K_RECORD_EXT);
+                break;
+
+            case SDL_API_LITERAL:
+                tv[ii].sdl_tv_literal = sdl_record_literal;
+                break;
+
+            case SDL_API_CLOSE:
+                tv[ii].sdl_tv_close = sdl_record_close;
+                break;
+
+            default:
+                break;
+        }
+        ii++;
+    }
+
+    /*
+     * If we were given an output file, then we need a sink for it.
+     */
+    if (fpPresent == true)
+    {
+        if (mySink == NULL)
+        {
+            mySink = &_sdl_record_sink;
+            sdl_sink_init(mySink, fp);
+        }
+        sink = mySink;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_replay_file
+ *  This function is called to replay a recording to the languages that are
+ *  enabled in the context, in place of parsing an input file.  The recording
+ *  is read into memory in its entirety, and is not freed until it has been
+ *  replayed.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context for the compilation.
+ *  fp:
+ *      A pointer to the opened recording.
+ *
+ * Output Parameters:
+ *  context:
+ *      A pointer to the context, with the options from the recording.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_BADREPLAY:  The input file is not a recording, or is corrupt.
+ *  SDL_ABORT:      An error occurred reading the recording.
+ *  SDL_ERREXIT:    Error exit.
+ *  Anything returned by a language.
+ */
+uint32_t sdl_replay_file(SDL_CONTEXT *context, FILE *fp)
+{
+    uint8_t *buffer = NULL;
+    size_t size = 0;
+    size_t used = 0;
+    uint32_t retVal = SDL_NORMAL;
+    bool done = false;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_replay_file");
+
+    /*
+     * Read the whole recording into memory.
+     */
+    while ((retVal == SDL_NORMAL) && (done == false))
+    {
+        if (used == size)
+        {
+            uint8_t *newBuf;
+
+            size = (size == 0) ? SDL_K_SINK_SIZE : (size * 2);
+            newBuf = sdl_realloc(buffer, size);
+            if (newBuf != NULL)
+            {
+                buffer = newBuf;
+            }
+            else
+            {
+                retVal = SDL_ABORT;
+                if (sdl_set_message(context->msgVec,
+                                    2,
+                                    retVal,
+                                    ENOMEM) != SDL_NORMAL)
+                {
+                    retVal = SDL_ERREXIT;
+                }
+            }
+        }
+        if (retVal == SDL_NORMAL)
+        {
+            used += fread(&buffer[used], 1, size - used, fp);
+            if (ferror(fp) != 0)
+            {
+                retVal = SDL_ABORT;
+                if (sdl_set_message(context->msgVec,
+                                    2,
+                                    retVal,
+                                    errno) != SDL_NORMAL)
+                {
+                    retVal = SDL_ERREXIT;
+                }
+            }
+            done = feof(fp) != 0;
+        }
+    }
+
+    if (retVal == SDL_NORMAL)
+    {
+        retVal = sdl_replay_buffer(context,
+                                   buffer,
+                                   used,
+                                   context->argument[ArgInputFile].fileName);
+    }
+    if (buffer != NULL)
+    {
+        sdl_free(buffer);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_replay_buffer
+ *  This function is called to replay a recording that is in memory to the
+ *  languages that are enabled in the context.  The strings in the recording
+ *  are used where they are, so it cannot be freed until this returns.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context for the compilation.
+ *  buffer:
+ *      A pointer to the recording.
+ *  length:
+ *      A value indicating the length of the recording.
+ *  name:
+ *      A pointer to the name of the file the recording came from, for the
+ *      message if it cannot be replayed.
+ *
+ * Output Parameters:
+ *  context:
+ *      A pointer to the context, with the options from the recording.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_BADREPLAY:  The buffer is not a recording, or is corrupt.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ *  SDL_ERREXIT:    Error exit.
+ *  Anything returned by a language.
+ */
+uint32_t sdl_replay_buffer(SDL_CONTEXT *context,
+                           uint8_t *buffer,
+                           size_t length,
+                           char *name)
+{
+    SDL_REPLAY replay;
+    bool *langEna = context->langEnableVec;
+    bool *mask = NULL;
+    uint32_t langCount = sdl_plugin_count();
+    uint32_t retVal = SDL_NORMAL;
+    bool done = false;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_replay_buffer");
+
+    /*
+     * The recording must start with the magic string and a version we know.
+     */
+    replay.ptr = buffer;
+    replay.end = buffer + length;
+    if ((length < SDL_K_RECORD_MAGIC_LEN) ||
+        (memcmp(buffer, SDL_K_RECORD_MAGIC, SDL_K_RECORD_MAGIC_LEN) != 0))
+    {
+        replay.error = true;
+    }
+    else
+    {
+        replay.ptr += SDL_K_RECORD_MAGIC_LEN;
+        replay.error = false;
+        if (_sdl_replay_uint(&replay) != SDL_K_RECORD_VERSION)
+        {
+            replay.error = true;
+        }
+    }
+
+    /*
+     * Make each call that was recorded, until the recording is closed.
+     */
+    while ((retVal == SDL_NORMAL) && (replay.error == false) && (done == false))
+    {
+        SDL_RECORD_EVENT event = _sdl_replay_uint(&replay);
+        bool flags[4];
+        int ii;
+
+        switch (event)
+        {
+            case RecCommentStars:
+                retVal = sdl_call_commentStars(langEna);
+                break;
+
+            case RecCreatedBy:
+                {
+                    struct tm timeInfo;
+
+                    memset(&timeInfo, 0, sizeof(struct tm));
+                    _sdl_replay_fields(&replay, _sdl_rec_tm, &timeInfo);
+                    if (replay.error == false)
+                    {
+                        retVal = sdl_call_createdByInfo(langEna,
+                                                        &timeInfo);
+                    }
+                }
+                break;
+
+            case RecFileInfo:
+                {
+                    struct tm timeInfo;
+                    char *filePath;
+
+                    memset(&timeInfo, 0, sizeof(struct tm));
+                    _sdl_replay_fields(&replay, _sdl_rec_tm, &timeInfo);
+                    filePath = _sdl_replay_str(&replay);
+                    if (replay.error == false)
+                    {
+                        retVal = sdl_call_fileInfo(langEna,
+                                                   &timeInfo,
+                                                   filePath);
+                    }
+                }
+                break;
+
+            case RecComment:
+                {
+                    char *comment = _sdl_replay_str(&replay);
+
+                    for (ii = 0; ii < 4; ii++)
+                    {
+                        flags[ii] = _sdl_replay_uint(&replay) != 0;
+                    }
+                    if (replay.error == false)
+                    {
+                        retVal = sdl_call_comment(langEna,
+                                                  comment,
+                                                  flags[0],
+                                                  flags[1],
+                                                  flags[2],
+                                                  flags[3]);
+                    }
+                }
+                break;
+
+            case RecModule:
+
+                /*
+                 * Whatever was rebuilt for the previous MODULE is no longer
+                 * needed.
+                 */
+                _sdl_replay_reset(context);
+                sdl_arena_release(&context->arena);
+                context->module = _sdl_replay_str(&replay);
+                context->ident = _sdl_replay_str(&replay);
+                context->argument[ArgWordSize].value =
+                    _sdl_replay_int(&replay);
+                for (ii = 0; ii < SDL_K_REC_ARGS; ii++)
+                {
+                    context->argument[_sdl_rec_args[ii]].on =
+                        _sdl_replay_uint(&replay) != 0;
+                }
+                _sdl_replay_types(context,
+                                  &replay,
+                                  _sdl_rec_declare,
+                                  sizeof(SDL_DECLARE),
+                                  offsetof(SDL_DECLARE, id),
+                                  offsetof(SDL_DECLARE, typeID),
+                                  DeclareBlock,
+                                  &context->declares.header,
+                                  &context->declares.symtab);
+                _sdl_replay_types(context,
+                                  &replay,
+                                  _sdl_rec_item,
+                                  sizeof(SDL_ITEM),
+                                  offsetof(SDL_ITEM, id),
+                                  offsetof(SDL_ITEM, typeID),
+                                  ItemBlock,
+                                  &context->items.header,
+                                  &context->items.symtab);
+                _sdl_replay_types(context,
+                                  &replay,
+                                  _sdl_rec_aggregate,
+                                  sizeof(SDL_AGGREGATE),
+                                  offsetof(SDL_AGGREGATE, id),
+                                  offsetof(SDL_AGGREGATE, typeID),
+                                  AggregateBlock,
+                                  &context->aggregates.header,
+                                  &context->aggregates.symtab);
+                if ((replay.error == false) && (context->module != NULL))
+                {
+                    retVal = sdl_call_module(langEna, context);
+                }
+                else
+                {
+                    replay.error = true;
+                }
+                break;
+
+            case RecModuleEnd:
+                retVal = sdl_call_moduleEnd(langEna, context);
+                _sdl_replay_reset(context);
+                break;
+
+            case RecItem:
+                {
+                    SDL_ITEM *item = _sdl_replay_block(context,
+                                                       &replay,
+                                                       _sdl_rec_item,
+                                                       sizeof(SDL_ITEM),
+                                                       ItemBlock);
+
+                    if (replay.error == false)
+                    {
+                        retVal = sdl_call_item(langEna,
+                                               item,
+                                               context);
+                    }
+                }
+                break;
+
+            case RecConstant:
+                {
+                    SDL_CONSTANT *constant =
+                        _sdl_replay_block(context,
+                                          &replay,
+                                          _sdl_rec_constant,
+                                          sizeof(SDL_CONSTANT),
+                                          ConstantBlock);
+
+                    if (replay.error == false)
+                    {
+                        if (constant->type == SDL_K_CONST_STR)
+                        {
+                            constant->string = _sdl_replay_str(&replay);
+                        }
+                        else
+                        {
+                            constant->value = _sdl_replay_int(&replay);
+                        }
+                    }
+                    if (replay.error == false)
+                    {
+                        retVal = sdl_call_constant(langEna,
+                                                   constant,
+                                                   context);
+                    }
+                }
+                break;
+
+            case RecEnumerate:
+                {
+                    SDL_ENUMERATE *_enum =
+                        _sdl_replay_block(context,
+                                          &replay,
+                                          _sdl_rec_enumerate,
+                                          sizeof(SDL_ENUMERATE),
+                                          EnumerateBlock);
+
+                    if (replay.error == false)
+                    {
+                        _sdl_replay_queue(context,
+                                          &replay,
+                                          _sdl_rec_enum_member,
+                                          sizeof(SDL_ENUM_MEMBER),
+                                          EnumMemberBlock,
+                                          &_enum->members);
+                    }
+                    if (replay.error == false)
+                    {
+                        retVal = sdl_call_enumerate(langEna,
+                                                    _enum,
+                                                    context);
+                    }
+                }
+                break;
+
+            case RecAggregate:
+                {
+                    SDL_LANG_LAYOUT *layout = _sdl_replay_layout(context,
+                                                                 &replay);
+
+                    if (replay.error == false)
+                    {
+                        retVal = sdl_call_layout(langEna,
+                                                 layout,
+                                                 context);
+                    }
+                }
+                break;
+
+            case RecEntry:
+                {
+                    SDL_ENTRY *entry = _sdl_replay_block(context,
+                                                         &replay,
+                                                         _sdl_rec_entry,
+                                                         sizeof(SDL_ENTRY),
+                                                         EntryBlock);
+
+                    if (replay.error == false)
+                    {
+                        _sdl_replay_queue(context,
+                                          &replay,
+                                          _sdl_rec_parameter,
+                                          sizeof(SDL_PARAMETER),
+                                          ParameterBlock,
+                                          &entry->parameters);
+                    }
+                    if (replay.error == false)
+                    {
+                        retVal = sdl_call_entry(langEna,
+                                                entry,
+                                                context);
+                    }
+                }
+                break;
+
+            case RecLiteral:
+                {
+                    char *line = _sdl_replay_str(&replay);
+
+                    if ((replay.error == false) && (line != NULL))
+                    {
+                        retVal = sdl_call_literal(langEna,
+                                                  line);
+                    }
+                    else
+                    {
+                        replay.error = true;
+                    }
+                }
+                break;
+
+            case RecClose:
+                done = true;
+                break;
+
+            case RecLanguages:
+                if (_sdl_replay_uint(&replay) != langCount)
+                {
+                    replay.error = true;
+                }
+                else if (mask == NULL)
+                {
+                    mask = sdl_calloc(langCount + 1, sizeof(bool));
+                    if (mask == NULL)
+                    {
+                        retVal = SDL_ABORT;
+                        if (sdl_set_message(context->msgVec,
+                                            2,
+                                            retVal,
+                                            ENOMEM) != SDL_NORMAL)
+                        {
+                            retVal = SDL_ERREXIT;
+                        }
+                    }
+                }
+                for (ii = 0;
+                     ((mask != NULL) &&
+                      (replay.error == false) &&
+                      (ii < langCount));
+                     ii++)
+                {
+                    mask[ii] = (_sdl_replay_uint(&replay) != 0) &&
+                               context->langEnableVec[ii];
+                }
+                langEna = mask;
+                break;
+
+            default:
+                replay.error = true;
+                break;
+        }
+    }
+
+    /*
+     * A recording that ends before it was closed, or that has anything we do
+     * not recognize in it, cannot be replayed.
+     */
+    if ((retVal == SDL_NORMAL) && (replay.error == true))
+    {
+        retVal = SDL_BADREPLAY;
+        if (sdl_set_message(context->msgVec, 1, retVal, name) != SDL_NORMAL)
+        {
+            retVal = SDL_ERREXIT;
+        }
+    }
+
+    /*
+     * Nothing can be left pointing into the recording once it is freed.
+     */
+    _sdl_replay_reset(context);
+    sdl_arena_release(&context->arena);
+    context->module = NULL;
+    context->ident = NULL;
+    if (mask != NULL)
+    {
+        sdl_free(mask);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_record_init
+ *  This function is called to start an empty recording to be made from the
+ *  module IR.
+ *
+ * Input Parameters:
+ *  recording:
+ *      A pointer to the recording to be initialized.
+ *
+ * Output Parameters:
+ *  recording:
+ *      A pointer to the initialized recording.
+ *
+ * Return Values:
+ *  true:   Normal Successful Completion.
+ *  false:  An error occurred allocating memory.
+ */
+bool sdl_record_init(SDL_RECORDING *recording)
+{
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_record_init");
+
+    sdl_sink_init(&recording->sink, NULL);
+    recording->langEna = sdl_calloc(sdl_plugin_count() + 1, sizeof(bool));
+    recording->langRecorded = false;
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(recording->langEna != NULL);
+}
+
+/*
+ * sdl_record_node
+ *  This function is called to record a node of the module IR, just as the
+ *  record language would have been called with it.  If the node is not for
+ *  the same languages as the one recorded before it, they are recorded
+ *  first.
+ *
+ * Input Parameters:
+ *  recording:
+ *      A pointer to the recording.
+ *  node:
+ *      A pointer to the node to be recorded.
+ *  context:
+ *      A pointer to the context for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:   Normal Successful Completion.
+ *  false:  An error occurred adding to the recording.
+ */
+bool sdl_record_node(SDL_RECORDING *recording,
+                     SDL_IR_NODE *node,
+                     SDL_CONTEXT *context)
+{
+    SDL_SINK *savedSink = sink;
+    uint32_t langCount = sdl_plugin_count();
+    uint32_t ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_record_node");
+
+    /*
+     * The recorder functions write to this thread's sink, which is the
+     * record language's, if it has one.  So, it is put back when we are done.
+     */
+    sink = &recording->sink;
+    if ((recording->langRecorded == false) ||
+        (memcmp(recording->langEna,
+                node->langEna,
+                langCount * sizeof(bool)) != 0))
+    {
+        _sdl_record_event(RecLanguages);
+        _sdl_record_uint(langCount);
+        for (ii = 0; ii < langCount; ii++)
+        {
+            _sdl_record_uint(node->langEna[ii]);
+        }
+        memcpy(recording->langEna, node->langEna, langCount * sizeof(bool));
+        recording->langRecorded = true;
+    }
+    switch (node->type)
+    {
+        case IrComment:
+            sdl_record_comment(node->comment.text,
+                               node->comment.lineComment,
+                               node->comment.startComment,
+                               node->comment.middleComment,
+                               node->comment.endComment);
+            break;
+
+        case IrModule:
+            sdl_record_module(context);
+            break;
+
+        case IrItem:
+            sdl_record_item(node->item, context);
+            break;
+
+        case IrConstant:
+            sdl_record_constant(node->constant, context);
+            break;
+
+        case IrEnumerate:
+            sdl_record_enumerate(node->_enum, context);
+            break;
+
+        case IrAggregate:
+            sdl_record_layout(node->layout, context);
+            break;
+
+        case IrEntry:
+            sdl_record_entry(node->entry, context);
+            break;
+
+        case IrLiteral:
+            sdl_record_literal(node->literal);
+            break;
+
+        case IrModuleEnd:
+            sdl_record_module_end(context);
+            break;
+    }
+    sink = savedSink;
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(recording->sink.error == 0);
+}
+
+/*
+ * sdl_record_finish
+ *  This function is called to record the end of a recording made from the
+ *  module IR.  It is then complete, and can be replayed.
+ *
+ * Input Parameters:
+ *  recording:
+ *      A pointer to the recording.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_record_finish(SDL_RECORDING *recording)
+{
+    SDL_SINK *savedSink = sink;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_record_finish");
+
+    sink = &recording->sink;
+    _sdl_record_event(RecClose);
+    sink = savedSink;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * sdl_record_free
+ *  This function is called to free a recording made from the module IR.
+ *  Since its sink has no output file, it is never flushed, just freed.
+ *
+ * Input Parameters:
+ *  recording:
+ *      A pointer to the recording.
+ *
+ * Output Parameters:
+ *  recording:
+ *      A pointer to the now empty recording.
+ *
+ * Return Values:
+ *  None.
+ */
+void sdl_record_free(SDL_RECORDING *recording)
+{
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_record_free");
+
+    if (recording->sink.buffer != NULL)
+    {
+        sdl_free(recording->sink.buffer);
+    }
+    if (recording->langEna != NULL)
+    {
+        sdl_free(recording->langEna);
+    }
+    sdl_sink_init(&recording->sink, NULL);
+    recording->langEna = NULL;
+    recording->langRecorded = false;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/************************************************************************/
+/* Recorder Functions                                                   */
+/************************************************************************/
+
+/*
+ * sdl_record_commentStars
+ *  This function is called to record a line of stars in a comment.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_commentStars(void)
+{
+    _sdl_record_event(RecCommentStars);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_createdByInfo
+ *  This function is called to record the time OpenSDL was run.
+ *
+ * Input Parameters:
+ *  timeInfo:
+ *      A pointer to the time OpenSDL was run.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_createdByInfo(struct tm *timeInfo)
+{
+    _sdl_record_event(RecCreatedBy);
+    _sdl_record_fields(_sdl_rec_tm, timeInfo);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_fileInfo
+ *  This function is called to record the input file and the time it was
+ *  last modified.
+ *
+ * Input Parameters:
+ *  timeInfo:
+ *      A pointer to the time the input file was last modified.
+ *  filePath:
+ *      A pointer to the full path of the input file.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_fileInfo(struct tm *timeInfo, char *filePath)
+{
+    _sdl_record_event(RecFileInfo);
+    _sdl_record_fields(_sdl_rec_tm, timeInfo);
+    _sdl_record_str(filePath);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_comment
+ *  This function is called to record a comment.
+ *
+ * Input Parameters:
+ *  comment:
+ *      A pointer to the text of the comment.
+ *  lineComment:
+ *      A boolean indicating that this is a line comment.
+ *  startComment:
+ *      A boolean indicating that this starts a block comment.
+ *  middleComment:
+ *      A boolean indicating that this is in the middle of a block comment.
+ *  endComment:
+ *      A boolean indicating that this ends a block comment.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_comment(char *comment,
+                                   bool lineComment,
+                                   bool startComment,
+                                   bool middleComment,
+                                   bool endComment)
+{
+    _sdl_record_event(RecComment);
+    _sdl_record_str(comment);
+    _sdl_record_uint(lineComment);
+    _sdl_record_uint(startComment);
+    _sdl_record_uint(middleComment);
+    _sdl_record_uint(endComment);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_module
+ *  This function is called to record the start of a MODULE.  Along with the
+ *  name and ident of the MODULE, the options the plugins look at and every
+ *  DECLARE, ITEM and AGGREGATE that can be used as a user type are recorded.
+ *  Since the MODULE is emitted once it has been parsed, these are all the
+ *  ones in the MODULE.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_module(SDL_CONTEXT *context)
+{
+    int ii;
+
+    _sdl_record_event(RecModule);
+    _sdl_record_str(context->module);
+    _sdl_record_str(context->ident);
+    _sdl_record_int(context->argument[ArgWordSize].value);
+    for (ii = 0; ii < SDL_K_REC_ARGS; ii++)
+    {
+        _sdl_record_uint(context->argument[_sdl_rec_args[ii]].on);
+    }
+    _sdl_record_queue(_sdl_rec_declare,
+                      &context->declares.header,
+                      offsetof(SDL_DECLARE, header.queue));
+    _sdl_record_queue(_sdl_rec_item,
+                      &context->items.header,
+                      offsetof(SDL_ITEM, header.queue));
+    _sdl_record_queue(_sdl_rec_aggregate,
+                      &context->aggregates.header,
+                      offsetof(SDL_AGGREGATE, header.queue));
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_module_end
+ *  This function is called to record the end of a MODULE.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_module_end(SDL_CONTEXT *context)
+{
+    _sdl_record_event(RecModuleEnd);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_item
+ *  This function is called to record an ITEM.
+ *
+ * Input Parameters:
+ *  item:
+ *      A pointer to the ITEM.
+ *  context:
+ *      A pointer to the context for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_item(SDL_ITEM *item, SDL_CONTEXT *context)
+{
+    _sdl_record_event(RecItem);
+    _sdl_record_fields(_sdl_rec_item, item);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_constant
+ *  This function is called to record a CONSTANT.  Its value is recorded
+ *  after the rest of it, as either a string or a number.
+ *
+ * Input Parameters:
+ *  constant:
+ *      A pointer to the CONSTANT.
+ *  context:
+ *      A pointer to the context for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_constant(SDL_CONSTANT *constant,
+                                    SDL_CONTEXT *context)
+{
+    _sdl_record_event(RecConstant);
+    _sdl_record_fields(_sdl_rec_constant, constant);
+    if (constant->type == SDL_K_CONST_STR)
+    {
+        _sdl_record_str(constant->string);
+    }
+    else
+    {
+        _sdl_record_int(constant->value);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_enumerate
+ *  This function is called to record an ENUMERATE and its members.
+ *
+ * Input Parameters:
+ *  _enum:
+ *      A pointer to the ENUMERATE.
+ *  context:
+ *      A pointer to the context for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_enumerate(SDL_ENUMERATE *_enum,
+                                     SDL_CONTEXT *context)
+{
+    _sdl_record_event(RecEnumerate);
+    _sdl_record_fields(_sdl_rec_enumerate, _enum);
+    _sdl_record_queue(_sdl_rec_enum_member,
+                      &_enum->members,
+                      offsetof(SDL_ENUM_MEMBER, header.queue));
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_layout
+ *  This function is called to record the layout of an AGGREGATE.  The
+ *  AGGREGATE is recorded, followed by each entry in the layout.  An entry
+ *  that ends an AGGREGATE or subaggregate refers back to the one that
+ *  started it.  Otherwise, an entry is followed by the member it is for.
+ *
+ * Input Parameters:
+ *  layout:
+ *      A pointer to the layout of the AGGREGATE.
+ *  context:
+ *      A pointer to the context for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_layout(SDL_LANG_LAYOUT *layout,
+                                  SDL_CONTEXT *context)
+{
+    uint32_t ii, jj;
+
+    _sdl_record_event(RecAggregate);
+    _sdl_record_fields(_sdl_rec_aggregate, layout->aggregate);
+    _sdl_record_uint(layout->memberCount);
+    for (ii = 0; ii < layout->memberCount; ii++)
+    {
+        SDL_LANG_MEMBER *member = &layout->members[ii];
+
+        _sdl_record_uint(member->type);
+        _sdl_record_uint(member->prefixLength);
+        _sdl_record_uint(member->typePrefixLength);
+        _sdl_record_fields(_sdl_rec_layout, member);
+        if (member->ending == true)
+        {
+            for (jj = ii;
+                 ((jj > 0) &&
+                  ((layout->members[jj - 1].ending == true) ||
+                   (layout->members[jj - 1].param.parameter !=
+                    member->param.parameter)));
+                 jj--);
+            _sdl_record_uint(ii - jj + 1);
+        }
+        else if (member->type != LangAggregate)
+        {
+            SDL_MEMBERS *container = (SDL_MEMBERS *)
+                ((char *) member->param.parameter -
+                 offsetof(SDL_MEMBERS, item));
+
+            _sdl_record_fields(_sdl_rec_member, container);
+            switch (member->type)
+            {
+                case LangSubaggregate:
+                    _sdl_record_fields(_sdl_rec_subaggr, &container->subaggr);
+                    break;
+
+                case LangItem:
+                    _sdl_record_fields(_sdl_rec_item, &container->item);
+                    break;
+
+                default:
+                    _sdl_record_fields(_sdl_rec_comment, &container->comment);
+                    break;
+            }
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_entry
+ *  This function is called to record an ENTRY and its parameters.
+ *
+ * Input Parameters:
+ *  entry:
+ *      A pointer to the ENTRY.
+ *  context:
+ *      A pointer to the context for the compilation.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_entry(SDL_ENTRY *entry, SDL_CONTEXT *context)
+{
+    _sdl_record_event(RecEntry);
+    _sdl_record_fields(_sdl_rec_entry, entry);
+    _sdl_record_queue(_sdl_rec_parameter,
+                      &entry->parameters,
+                      offsetof(SDL_PARAMETER, header.queue));
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_literal
+ *  This function is called to record a line of LITERAL text.
+ *
+ * Input Parameters:
+ *  line:
+ *      A pointer to the line of text.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ */
+static uint32_t sdl_record_literal(char *line)
+{
+    _sdl_record_event(RecLiteral);
+    _sdl_record_str(line);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(SDL_NORMAL);
+}
+
+/*
+ * sdl_record_close
+ *  This function is called to record the end of the recording, and close
+ *  it.  Everything appended to the output sink is written to the recording
+ *  first, and this is where any error writing it is reported.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred writing the recording.
+ *  SDL_ERREXIT:    Error exit.
+ */
+static uint32_t sdl_record_close(void)
+{
+    uint32_t retVal = SDL_NORMAL;
+    int status;
+
+    /*
+     * Record the close and write out the sink, then close the recording, if
+     * this thread has one.
+     */
+    if (sink != NULL)
+    {
+        _sdl_record_event(RecClose);
+        status = sdl_sink_close(sink);
+        sink = NULL;
+        if (status != 0)
+        {
+            retVal = SDL_ABORT;
+            if (sdl_set_message(msgVec, 2, retVal, status) != SDL_NORMAL)
+            {
+                retVal = SDL_ERREXIT;
+            }
+        }
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+        fp = NULL;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_record_event
+ *  This function is called to start a record with its event code.  If
+ *  nothing has been written to the recording yet, the magic string and the
+ *  version are written first.  The sink is not flushed until the recording
+ *  is closed, so it is empty until the first record.
+ *
+ * Input Parameters:
+ *  event:
+ *      A value indicating the call being recorded.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_record_event(SDL_RECORD_EVENT event)
+{
+    if (sink->used == 0)
+    {
+        sdl_sink_write(sink, SDL_K_RECORD_MAGIC, SDL_K_RECORD_MAGIC_LEN);
+        _sdl_record_uint(SDL_K_RECORD_VERSION);
+    }
+    _sdl_record_uint(event);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_record_uint
+ *  This function is called to write an unsigned integer to the recording, 7
+ *  bits at a time, with the high bit set in every byte but the last.
+ *
+ * Input Parameters:
+ *  value:
+ *      A value to be written.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_record_uint(uint64_t value)
+{
+    char buffer[10];
+    size_t length = 0;
+
+    do
+    {
+        buffer[length] = value & 0x7f;
+        value >>= 7;
+        if (value != 0)
+        {
+            buffer[length] |= 0x80;
+        }
+        length++;
+    } while (value != 0);
+    sdl_sink_write(sink, buffer, length);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_record_int
+ *  This function is called to write a signed integer to the recording.  It
+ *  is zig-zag encoded, so that small negative numbers are short as well.
+ *
+ * Input Parameters:
+ *  value:
+ *      A value to be written.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_record_int(int64_t value)
+{
+    _sdl_record_uint(((uint64_t) value << 1) ^ (uint64_t) (value >> 63));
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_record_str
+ *  This function is called to write a string, and its null-terminator, to
+ *  the recording, preceded by its length plus 1.  A NULL pointer is written
+ *  as a length of 0.
+ *
+ * Input Parameters:
+ *  string:
+ *      A pointer to the string to be written.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_record_str(char *string)
+{
+    if (string != NULL)
+    {
+        size_t length = strlen(string) + 1;
+
+        _sdl_record_uint(length);
+        sdl_sink_write(sink, string, length);
+    }
+    else
+    {
+        _sdl_record_uint(0);
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_record_fields
+ *  This function is called to write the fields of a block to the recording,
+ *  as described by a table.
+ *
+ * Input Parameters:
+ *  fields:
+ *      A pointer to the table describing the fields to be written.
+ *  block:
+ *      A pointer to the block.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_record_fields(const SDL_RECORD_FIELD *fields, void *block)
+{
+    int ii;
+
+    for (ii = 0; fields[ii].kind != RecEnd; ii++)
+    {
+        void *field = (char *) block + fields[ii].offset;
+
+        switch (fields[ii].kind)
+        {
+            case RecStr:
+                _sdl_record_str(*(char **) field);
+                break;
+
+            case RecInt64:
+                _sdl_record_int(*(int64_t *) field);
+                break;
+
+            case RecInt:
+                _sdl_record_int(*(int *) field);
+                break;
+
+            default:
+                _sdl_record_uint(*(bool *) field);
+                break;
+        }
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_record_queue
+ *  This function is called to write the number of blocks in a queue, and
+ *  then the fields of each of them.
+ *
+ * Input Parameters:
+ *  fields:
+ *      A pointer to the table describing the fields to be written.
+ *  queue:
+ *      A pointer to the head of the queue.
+ *  offset:
+ *      A value indicating where the queue entry is in each block.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_record_queue(const SDL_RECORD_FIELD *fields,
+                              SDL_QUEUE *queue,
+                              size_t offset)
+{
+    SDL_QUEUE *entry;
+    uint64_t count = 0;
+
+    for (entry = queue->flink; entry != queue; entry = entry->flink)
+    {
+        count++;
+    }
+    _sdl_record_uint(count);
+    for (entry = queue->flink; entry != queue; entry = entry->flink)
+    {
+        _sdl_record_fields(fields, (char *) entry - offset);
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/************************************************************************/
+/* Replay Functions                                                     */
+/************************************************************************/
+
+/*
+ * _sdl_replay_uint
+ *  This function is called to read an unsigned integer from the recording.
+ *
+ * Input Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording.
+ *
+ * Output Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording, after the integer, or with
+ *      the error flag set.
+ *
+ * Return Values:
+ *  The value read, or 0 if there was an error.
+ */
+static uint64_t _sdl_replay_uint(SDL_REPLAY *replay)
+{
+    uint64_t retVal = 0;
+    int shift = 0;
+    bool more = true;
+
+    while ((more == true) && (replay->error == false))
+    {
+        if ((replay->ptr >= replay->end) || (shift > 63))
+        {
+            replay->error = true;
+            retVal = 0;
+        }
+        else
+        {
+            retVal |= (uint64_t) (*replay->ptr & 0x7f) << shift;
+            more = (*replay->ptr++ & 0x80) != 0;
+            shift += 7;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_replay_int
+ *  This function is called to read a zig-zag encoded signed integer from the
+ *  recording.
+ *
+ * Input Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording.
+ *
+ * Output Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording, after the integer, or with
+ *      the error flag set.
+ *
+ * Return Values:
+ *  The value read, or 0 if there was an error.
+ */
+static int64_t _sdl_replay_int(SDL_REPLAY *replay)
+{
+    uint64_t value = _sdl_replay_uint(replay);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return((int64_t) (value >> 1) ^ -(int64_t) (value & 1));
+}
+
+/*
+ * _sdl_replay_str
+ *  This function is called to read a string from the recording.  The string
+ *  is not copied, the address of where it is in the recording is returned.
+ *
+ * Input Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording.
+ *
+ * Output Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording, after the string, or with
+ *      the error flag set.
+ *
+ * Return Values:
+ *  NULL:   The string was recorded as a NULL pointer, or there was an error.
+ *  !NULL:  A pointer to the string.
+ */
+static char *_sdl_replay_str(SDL_REPLAY *replay)
+{
+    uint64_t length = _sdl_replay_uint(replay);
+    char *retVal = NULL;
+
+    if ((length > 0) && (replay->error == false))
+    {
+        if ((length > (uint64_t) (replay->end - replay->ptr)) ||
+            (replay->ptr[length - 1] != '\0'))
+        {
+            replay->error = true;
+        }
+        else
+        {
+            retVal = (char *) replay->ptr;
+            replay->ptr += length;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_replay_fields
+ *  This function is called to read the fields of a block from the recording,
+ *  as described by a table.
+ *
+ * Input Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording.
+ *  fields:
+ *      A pointer to the table describing the fields to be read.
+ *  block:
+ *      A pointer to the block to receive the fields.
+ *
+ * Output Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording, after the fields, or with
+ *      the error flag set.
+ *  block:
+ *      A pointer to the block with the fields set.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_replay_fields(SDL_REPLAY *replay,
+                               const SDL_RECORD_FIELD *fields,
+                               void *block)
+{
+    int ii;
+
+    for (ii = 0; fields[ii].kind != RecEnd; ii++)
+    {
+        void *field = (char *) block + fields[ii].offset;
+
+        switch (fields[ii].kind)
+        {
+            case RecStr:
+                *(char **) field = _sdl_replay_str(replay);
+                break;
+
+            case RecInt64:
+                *(int64_t *) field = _sdl_replay_int(replay);
+                break;
+
+            case RecInt:
+                *(int *) field = _sdl_replay_int(replay);
+                break;
+
+            default:
+                *(bool *) field = _sdl_replay_uint(replay) != 0;
+                break;
+        }
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_replay_block
+ *  This function is called to allocate a block out of the context's arena
+ *  and read its fields from the recording.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context for the compilation.
+ *  replay:
+ *      A pointer to where we are in the recording.
+ *  fields:
+ *      A pointer to the table describing the fields to be read.
+ *  size:
+ *      A value indicating the size of the block.
+ *  blockID:
+ *      A value indicating the type of block.
+ *
+ * Output Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording, after the fields, or with
+ *      the error flag set.
+ *
+ * Return Values:
+ *  NULL:   There was an error, and the error flag is set.
+ *  !NULL:  A pointer to the block.
+ */
+static void *_sdl_replay_block(SDL_CONTEXT *context,
+                               SDL_REPLAY *replay,
+                               const SDL_RECORD_FIELD *fields,
+                               size_t size,
+                               SDL_BLOCK_ID blockID)
+{
+    SDL_HEADER *retVal = NULL;
+
+    if (replay->error == false)
+    {
+        retVal = sdl_arena_alloc(&context->arena, size);
+    }
+    if (retVal != NULL)
+    {
+        SDL_Q_INIT(&retVal->queue);
+        retVal->blockID = blockID;
+        retVal->top = true;
+        switch (blockID)
+        {
+            case EnumerateBlock:
+                SDL_Q_INIT(&((SDL_ENUMERATE *) retVal)->members);
+                break;
+
+            case AggregateBlock:
+                SDL_Q_INIT(&((SDL_AGGREGATE *) retVal)->members);
+                break;
+
+            case EntryBlock:
+                SDL_Q_INIT(&((SDL_ENTRY *) retVal)->parameters);
+                break;
+
+            default:
+                break;
+        }
+        _sdl_replay_fields(replay, fields, retVal);
+    }
+    else
+    {
+        replay->error = true;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return((replay->error == false) ? retVal : NULL);
+}
+
+/*
+ * _sdl_replay_queue
+ *  This function is called to read a number of blocks from the recording and
+ *  insert them, in order, into a queue.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context for the compilation.
+ *  replay:
+ *      A pointer to where we are in the recording.
+ *  fields:
+ *      A pointer to the table describing the fields to be read.
+ *  size:
+ *      A value indicating the size of each block.
+ *  blockID:
+ *      A value indicating the type of block.
+ *  queue:
+ *      A pointer to the head of the queue.
+ *
+ * Output Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording, after the blocks, or with
+ *      the error flag set.
+ *  queue:
+ *      A pointer to the head of the queue, with the blocks inserted.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_replay_queue(SDL_CONTEXT *context,
+                              SDL_REPLAY *replay,
+                              const SDL_RECORD_FIELD *fields,
+                              size_t size,
+                              SDL_BLOCK_ID blockID,
+                              SDL_QUEUE *queue)
+{
+    uint64_t count = _sdl_replay_uint(replay);
+
+    while ((count-- > 0) && (replay->error == false))
+    {
+        SDL_HEADER *block = _sdl_replay_block(context,
+                                              replay,
+                                              fields,
+                                              size,
+                                              blockID);
+
+        if (block != NULL)
+        {
+            block->top = false;
+            SDL_INSQUE(queue, &block->queue);
+        }
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_replay_types
+ *  This function is called to read the DECLAREs, ITEMs or AGGREGATEs
+ *  recorded with a MODULE, and put them in their queue and symbol table,
+ *  as they were when the MODULE was parsed.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context for the compilation.
+ *  replay:
+ *      A pointer to where we are in the recording.
+ *  fields:
+ *      A pointer to the table describing the fields to be read.
+ *  size:
+ *      A value indicating the size of each block.
+ *  idOffset:
+ *      A value indicating where the name is in each block.
+ *  typeIDOffset:
+ *      A value indicating where the type ID is in each block.
+ *  blockID:
+ *      A value indicating the type of block.
+ *  queue:
+ *      A pointer to the head of the queue.
+ *  symtab:
+ *      A pointer to the symbol table.
+ *
+ * Output Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording, after the blocks, or with
+ *      the error flag set.
+ *  queue:
+ *      A pointer to the head of the queue, with the blocks inserted.
+ *  symtab:
+ *      A pointer to the symbol table, with the blocks inserted.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_replay_types(SDL_CONTEXT *context,
+                              SDL_REPLAY *replay,
+                              const SDL_RECORD_FIELD *fields,
+                              size_t size,
+                              size_t idOffset,
+                              size_t typeIDOffset,
+                              SDL_BLOCK_ID blockID,
+                              SDL_QUEUE *queue,
+                              SDL_SYMTAB *symtab)
+{
+    uint64_t count = _sdl_replay_uint(replay);
+
+    while ((count-- > 0) && (replay->error == false))
+    {
+        char *block = _sdl_replay_block(context,
+                                        replay,
+                                        fields,
+                                        size,
+                                        blockID);
+
+        if ((block != NULL) &&
+            ((*(char **) (block + idOffset) == NULL) ||
+             (sdl_symtab_insert(symtab,
+                                *(char **) (block + idOffset),
+                                *(int *) (block + typeIDOffset),
+                                block) != SDL_NORMAL)))
+        {
+            replay->error = true;
+        }
+        else if (block != NULL)
+        {
+            SDL_INSQUE(queue, &((SDL_HEADER *) block)->queue);
+        }
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_replay_layout
+ *  This function is called to read the layout of an AGGREGATE from the
+ *  recording.  Each member is put in a block of its own, the way it is when
+ *  the AGGREGATE is parsed, and the entries that end an AGGREGATE or
+ *  subaggregate use the same block as the one that started it.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context for the compilation.
+ *  replay:
+ *      A pointer to where we are in the recording.
+ *
+ * Output Parameters:
+ *  replay:
+ *      A pointer to where we are in the recording, after the layout, or with
+ *      the error flag set.
+ *
+ * Return Values:
+ *  NULL:   There was an error, and the error flag is set.
+ *  !NULL:  A pointer to the layout.
+ */
+static SDL_LANG_LAYOUT *_sdl_replay_layout(SDL_CONTEXT *context,
+                                           SDL_REPLAY *replay)
+{
+    SDL_LANG_LAYOUT *retVal = NULL;
+    SDL_AGGREGATE *aggregate = _sdl_replay_block(context,
+                                                 replay,
+                                                 _sdl_rec_aggregate,
+                                                 sizeof(SDL_AGGREGATE),
+                                                 AggregateBlock);
+    uint64_t count = _sdl_replay_uint(replay);
+    uint32_t ii;
+
+    /*
+     * The layout and its entries are allocated in one piece, the same as
+     * when the layout was determined.  Every entry takes at least 3 bytes of
+     * the recording, which keeps a bad count from asking for too much.
+     */
+    if ((replay->error == false) &&
+        (count <= (uint64_t) (replay->end - replay->ptr) / 3))
+    {
+        retVal = sdl_arena_alloc(&context->arena,
+                                 sizeof(SDL_LANG_LAYOUT) +
+                                 (count * sizeof(SDL_LANG_MEMBER)));
+    }
+    if (retVal != NULL)
+    {
+        retVal->aggregate = aggregate;
+        retVal->members = (SDL_LANG_MEMBER *) &retVal[1];
+        retVal->memberCount = count;
+    }
+    else
+    {
+        replay->error = true;
+    }
+    for (ii = 0; ((replay->error == false) && (ii < count)); ii++)
+    {
+        SDL_LANG_MEMBER *member = &retVal->members[ii];
+
+        member->type = _sdl_replay_uint(replay);
+        member->prefixLength = _sdl_replay_uint(replay);
+        member->typePrefixLength = _sdl_replay_uint(replay);
+        _sdl_replay_fields(replay, _sdl_rec_layout, member);
+        if (member->type > LangComment)
+        {
+            replay->error = true;
+        }
+        else if (member->ending == true)
+        {
+            uint64_t back = _sdl_replay_uint(replay);
+
+            if ((back == 0) ||
+                (back > ii) ||
+                (retVal->members[ii - back].type != member->type) ||
+                (retVal->members[ii - back].ending == true))
+            {
+                replay->error = true;
+            }
+            else
+            {
+                member->param = retVal->members[ii - back].param;
+            }
+        }
+        else if (member->type == LangAggregate)
+        {
+            member->param.aggr = aggregate;
+        }
+        else
+        {
+            SDL_MEMBERS *container = sdl_arena_alloc(&context->arena,
+                                                     sizeof(SDL_MEMBERS));
+
+            if (container != NULL)
+            {
+                SDL_Q_INIT(&container->header.queue);
+                container->header.blockID = AggrMemberBlock;
+                _sdl_replay_fields(replay, _sdl_rec_member, container);
+                switch (member->type)
+                {
+                    case LangSubaggregate:
+                        SDL_Q_INIT(&container->subaggr.members);
+                        _sdl_replay_fields(replay,
+                                           _sdl_rec_subaggr,
+                                           &container->subaggr);
+                        break;
+
+                    case LangItem:
+                        _sdl_replay_fields(replay,
+                                           _sdl_rec_item,
+                                           &container->item);
+                        break;
+
+                    default:
+                        _sdl_replay_fields(replay,
+                                           _sdl_rec_comment,
+                                           &container->comment);
+                        break;
+                }
+                member->param.item = &container->item;
+            }
+            else
+            {
+                replay->error = true;
+            }
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return((replay->error == false) ? retVal : NULL);
+}
+
+/*
+ * _sdl_replay_reset
+ *  This function is called to empty the queues and symbol tables that the
+ *  DECLAREs, ITEMs and AGGREGATEs recorded with a MODULE were put in.  The
+ *  blocks themselves are in the context's arena.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context for the compilation.
+ *
+ * Output Parameters:
+ *  context:
+ *      A pointer to the context, with the queues and symbol tables empty.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_replay_reset(SDL_CONTEXT *context)
+{
+    SDL_Q_INIT(&context->declares.header);
+    SDL_Q_INIT(&context->items.header);
+    SDL_Q_INIT(&context->aggregates.header);
+    sdl_symtab_reset(&context->declares.symtab);
+    sdl_symtab_reset(&context->items.symtab);
+    sdl_symtab_reset(&context->aggregates.symtab);
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
@@ -23,6 +23,37 @@
  *
  *  V01.000 04-OCT-2018 Jonathan D. Belanger
  *  Initially written.
+ *
+ *  V01.001 15-OCT-2026 Jonathan D. Belanger
+ *  The name and type ID lookups now use the symbol tables, rather than
+ *  walking the queues.
+ *
+ *  V01.002 15-OCT-2026 Jonathan D. Belanger
+ *  Messages are reported in the context's message vector.
+ *
+ *  V01.003 16-OCT-2026 Jonathan D. Belanger
+ *  Calls are recorded in the trace, with their numeric arguments, rather
+ *  than written to standard output.
+ *
+ *  V01.004 16-OCT-2026 Jonathan D. Belanger
+ *  The options list and the state stack are charged to their own sites in
+ *  the memory profile.  The state stack is grown by a whole entry.
+ *
+ *  V01.005 16-OCT-2026 Jonathan D. Belanger
+ *  Added sdl_context_init and sdl_context_free, so that every caller that
+ *  compiles a file sets up, and cleans up, its context the same way.
+ *
+ *  V01.006 16-OCT-2026 Jonathan D. Belanger
+ *  sdl_context_free releases the symbol tables, which are still in use when
+ *  a compilation stops part way through a MODULE.
+ *
+ *  V01.007 16-OCT-2026 Jonathan D. Belanger
+ *  The context has its own identifier pool, which is set up and released
+ *  with it.  Names are looked up with the hash saved when they were interned.
+ *
+ *  V01.008 16-OCT-2026 Jonathan D. Belanger
+ *  sdl_context_free releases the state stack, which was left behind by every
+ *  compilation.
  */
 #include <errno.h>
 #include <stdio.h>
@@ -32,9 +63,12 @@
 #include <ctype.h>
 #include "opensdl_defs.h"
 #include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_intern.h"
 #include "library/common/opensdl_message.h"
+#include "library/common/opensdl_trace.h"
 #include "library/utility/opensdl_utility.h"
 #include "library/utility/opensdl_actions.h"
+#include "library/utility/opensdl_include.h"
 #include "opensdl/opensdl_main.h"
 
 /*
@@ -44,6 +78,159 @@ static void _sdl_push_state(SDL_CONTEXT *context, SDL_STATE state);
 static SDL_STATE _sdl_pop_state(SDL_CONTEXT *context);
 
 
+/*
+ * sdl_context_init
+ *  This function is called to initialize the parsing states, and the queues
+ *  and symbol tables, of a context for a compilation.  The arguments, the
+ *  file for the diagnostics and the languages to be generated are set up by
+ *  the caller.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure to be initialized.  This must have
+ *    been zeroed.
+ *  pluginCount:
+ *    A value indicating the number of language plugins loaded.  The language
+ *    vectors have an entry for each one.
+ *
+ * Output Parameters:
+ *  context:
+ *    A pointer to the initialized context structure.
+ *
+ * Return Value:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_ABORT:      An error occurred allocating memory.  The context must
+ *                  still be cleaned up with sdl_context_free.
+ */
+uint32_t sdl_context_init(SDL_CONTEXT *context, uint32_t pluginCount)
+{
+    uint32_t retVal = SDL_NORMAL;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_context_init");
+
+    /*
+     * Initialize the parsing states.
+     */
+    context->processingEnabled = true;
+    context->state = Initial;
+    context->condState.state = sdl_calloc_site(MemCondStack,
+                                               SDL_K_COND_STATE_SIZE,
+                                               sizeof(SDL_COND_STATES));
+    context->condState.top = 0;
+    context->condState.bottom = SDL_K_COND_STATE_SIZE;
+    context->langEnableVec = sdl_calloc(pluginCount + 1, sizeof(bool));
+    context->langFP = sdl_calloc(pluginCount + 1, sizeof(FILE *));
+    context->langSink = sdl_calloc(pluginCount + 1, sizeof(SDL_SINK));
+    if ((context->condState.state == NULL) ||
+        (context->langEnableVec == NULL) ||
+        (context->langFP == NULL) ||
+        (context->langSink == NULL))
+    {
+        retVal = SDL_ABORT;
+    }
+    else
+    {
+        context->condState.state[0] = CondNone;
+    }
+
+    /*
+     * Initialize the context queues.
+     */
+    SDL_Q_INIT(&context->literal);
+    SDL_Q_INIT(&context->locals);
+    sdl_symtab_init(&context->localSymtab, 0);
+    SDL_Q_INIT(&context->constants);
+    SDL_Q_INIT(&context->declares.header);
+    context->declares.nextID = SDL_K_DECLARE_MIN;
+    sdl_symtab_init(&context->declares.symtab, SDL_K_DECLARE_MIN);
+    SDL_Q_INIT(&context->items.header);
+    context->items.nextID = SDL_K_ITEM_MIN;
+    sdl_symtab_init(&context->items.symtab, SDL_K_ITEM_MIN);
+    SDL_Q_INIT(&context->aggregates.header);
+    context->aggregates.nextID = SDL_K_AGGREGATE_MIN;
+    sdl_symtab_init(&context->aggregates.symtab, SDL_K_AGGREGATE_MIN);
+    SDL_Q_INIT(&context->enums.header);
+    context->enums.nextID = SDL_K_ENUM_MIN;
+    sdl_symtab_init(&context->enums.symtab, SDL_K_ENUM_MIN);
+    SDL_Q_INIT(&context->entries);
+    sdl_intern_init(&context->names);
+    sdl_set_message(context->msgVec, 1, SDL_NORMAL);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_context_free
+ *  This function is called to clean-up the memory used by a context for a
+ *  compilation, starting with what is left in the arena from the last
+ *  MODULE.  The symbol tables are released too, as a compilation that
+ *  stopped part way through a MODULE did not get to END_MODULE, where they
+ *  are normally emptied.  The identifier pool is released last, so none of
+ *  the names interned by the compilation are valid after this call.  The
+ *  context structure itself is not freed.
+ *
+ * Input Parameters:
+ *  context:
+ *    A pointer to the context structure to be cleaned up.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Value:
+ *  None.
+ */
+void sdl_context_free(SDL_CONTEXT *context)
+{
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_context_free");
+
+    sdl_symtab_reset(&context->localSymtab);
+    sdl_symtab_reset(&context->enums.symtab);
+    sdl_symtab_reset(&context->declares.symtab);
+    sdl_symtab_reset(&context->items.symtab);
+    sdl_symtab_reset(&context->aggregates.symtab);
+    sdl_set_arena(NULL);
+    sdl_arena_release(&context->arena);
+    sdl_intern_release(&context->names);
+    for (ii = 0; ii < context->langCondList.listUsed; ii++)
+    {
+        sdl_free(context->langCondList.lang[ii]);
+    }
+    if (context->inputPath != NULL)
+    {
+        free(context->inputPath);
+        context->inputPath = NULL;
+    }
+    sdl_include_list_free(&context->includes);
+    sdl_free(context->stateStack);
+    sdl_free(context->condState.state);
+    sdl_free(context->langEnableVec);
+    sdl_free(context->langFP);
+    sdl_free(context->langSink);
+    context->stateStack = NULL;
+    context->stateSize = 0;
+    context->stateIdx = 0;
+    context->condState.state = NULL;
+    context->langEnableVec = NULL;
+    context->langFP = NULL;
+    context->langSink = NULL;
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
 /*
  * sdl_get_local
  *  This function is called to get the value associated with a local definition
@@ -77,14 +264,6 @@ uint32_t sdl_get_local(SDL_CONTEXT *context, char *name, __int64_t *value)
     if (context->processingEnabled == true)
     {
 
-        /*
-         * If tracing is turned on, write out this call.
-         */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_get_local: ", __FILE__, __LINE__);
-        }
-
         /*
          * We should have already found the local variable definition
          */
@@ -99,7 +278,7 @@ uint32_t sdl_get_local(SDL_CONTEXT *context, char *name, __int64_t *value)
                 value = 0;
             }
             retVal = SDL_UNDEFSYM;
-            if (sdl_set_message(msgVec,
+            if (sdl_set_message(context->msgVec,
                                 1,
                                 retVal,
                                 name,
@@ -110,24 +289,11 @@ uint32_t sdl_get_local(SDL_CONTEXT *context, char *name, __int64_t *value)
         }
 
         /*
-         * If tracing is turned on, write out this call's return information.
+         * If tracing is turned on, record this call and what it returns.
          */
-        if (trace == true)
-        {
-            if (retVal == SDL_NORMAL)
-            {
-                printf("%s, %ld (%016lx - %4.4s)",
-                       name,
-                       *value,
-                       *value,
-                       (char *) value);
-            }
-            else
-            {
-                printf("%s not found", name);
-            }
-            printf("\n");
-        }
+        SDL_TRACE2("sdl_get_local",
+                   retVal,
+                   ((retVal == SDL_NORMAL) && (value != NULL)) ? *value : 0);
     }
 
     /*
@@ -158,36 +324,21 @@ uint32_t sdl_get_local(SDL_CONTEXT *context, char *name, __int64_t *value)
  */
 SDL_LOCAL_VARIABLE *sdl_find_local(SDL_CONTEXT *context, char *name)
 {
-    SDL_LOCAL_VARIABLE *retVal = (SDL_LOCAL_VARIABLE *) context->locals.flink;
+    SDL_LOCAL_VARIABLE *retVal;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_find_local\n", __FILE__, __LINE__);
-    }
-
-    /*
-     * Search through the list of local variables and see if one with the same
-     * name already exists.
-     */
-    while (retVal != (SDL_LOCAL_VARIABLE *) &context->locals)
-    {
-        if (strcmp(retVal->id, name) == 0)
-            break;
-        else
-            retVal = (SDL_LOCAL_VARIABLE *) retVal->header.queue.flink;
-    }
+    SDL_TRACE("sdl_find_local");
 
     /*
-     * If we ended up at the head of the queue, then we did not find what we
-     * were asked to locate.
+     * Look up the local variable in the symbol table.  If one with the same
+     * name does not already exist, this returns NULL.
      */
-    if (retVal == (SDL_LOCAL_VARIABLE *) &context->locals)
-    {
-        retVal = NULL;
-    }
+    retVal = (SDL_LOCAL_VARIABLE *) sdl_symtab_lookup_hash(
+                                                &context->localSymtab,
+                                                name,
+                                                sdl_intern_hash(name));
 
     /*
      * Return the results of this call back to the caller.
@@ -233,17 +384,9 @@ uint32_t sdl_state_transition(SDL_CONTEXT *context,
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_state_transition(state: %d, action: %d)\n",
-                   __FILE__,
-                   __LINE__,
-                   context->state,
-                   action);
-        }
+        SDL_TRACE2("sdl_state_transition", context->state, action);
 
         /*
          * Anything that will not cause a state transition is not included
@@ -469,7 +612,7 @@ uint32_t sdl_state_transition(SDL_CONTEXT *context,
 
     if (retVal != SDL_NORMAL)
     {
-        if (sdl_set_message(msgVec,
+        if (sdl_set_message(context->msgVec,
                             1,
                             retVal,
                             loc->first_line) != SDL_NORMAL)
@@ -547,31 +690,14 @@ char *sdl_unquote_str(char *str)
  */
 SDL_DECLARE *sdl_get_declare(SDL_DECLARE_LIST *declare, int typeID)
 {
-    SDL_DECLARE *retVal = (SDL_DECLARE *) declare->header.flink;
+    SDL_DECLARE *retVal;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_get_declare\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_get_declare");
 
-    while (retVal != (SDL_DECLARE *) &declare->header)
-    {
-        if (retVal->typeID == typeID)
-        {
-            break;
-        }
-        else
-        {
-            retVal = (SDL_DECLARE *) retVal->header.queue.flink;
-        }
-    }
-    if (retVal == (SDL_DECLARE *) &declare->header)
-    {
-        retVal = NULL;
-    }
+    retVal = (SDL_DECLARE *) sdl_symtab_lookup_id(&declare->symtab, typeID);
 
     /*
      * Return the results of this call back to the caller.
@@ -598,31 +724,14 @@ SDL_DECLARE *sdl_get_declare(SDL_DECLARE_LIST *declare, int typeID)
  */
 SDL_ITEM *sdl_get_item(SDL_ITEM_LIST *item, int typeID)
 {
-    SDL_ITEM *retVal = (SDL_ITEM *) item->header.flink;
+    SDL_ITEM *retVal;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_get_item\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_get_item");
 
-    while (retVal != (SDL_ITEM *) &item->header)
-    {
-        if (retVal->typeID == typeID)
-        {
-            break;
-        }
-        else
-        {
-            retVal = (SDL_ITEM *) retVal->header.queue.flink;
-        }
-    }
-    if (retVal == (SDL_ITEM *) &item->header)
-    {
-        retVal = NULL;
-    }
+    retVal = (SDL_ITEM *) sdl_symtab_lookup_id(&item->symtab, typeID);
 
     /*
      * Return the results of this call back to the caller.
@@ -650,31 +759,14 @@ SDL_ITEM *sdl_get_item(SDL_ITEM_LIST *item, int typeID)
  */
 SDL_AGGREGATE *sdl_get_aggregate(SDL_AGGREGATE_LIST *aggregate, int typeID)
 {
-    SDL_AGGREGATE *retVal = (SDL_AGGREGATE *) aggregate->header.flink;
+    SDL_AGGREGATE *retVal;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_get_aggregate\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_get_aggregate");
 
-    while (retVal != (SDL_AGGREGATE *) &aggregate->header)
-    {
-        if (retVal->typeID == typeID)
-        {
-            break;
-        }
-        else
-        {
-            retVal = (SDL_AGGREGATE *) retVal->header.queue.flink;
-        }
-    }
-    if (retVal == (SDL_AGGREGATE *) &aggregate->header)
-    {
-        retVal = NULL;
-    }
+    retVal = (SDL_AGGREGATE *) sdl_symtab_lookup_id(&aggregate->symtab, typeID);
 
     /*
      * Return the results of this call back to the caller.
@@ -702,31 +794,14 @@ SDL_AGGREGATE *sdl_get_aggregate(SDL_AGGREGATE_LIST *aggregate, int typeID)
  */
 SDL_ENUMERATE *sdl_get_enum(SDL_ENUM_LIST *enums, int typeID)
 {
-    SDL_ENUMERATE *retVal = (SDL_ENUMERATE *) enums->header.flink;
+    SDL_ENUMERATE *retVal;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_get_enum\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_get_enum");
 
-    while (retVal != (SDL_ENUMERATE *) &enums->header)
-    {
-        if (retVal->typeID == typeID)
-        {
-            break;
-        }
-        else
-        {
-            retVal = (SDL_ENUMERATE *) retVal->header.queue.flink;
-        }
-    }
-    if (retVal == (SDL_ENUMERATE *) &enums->header)
-    {
-        retVal = NULL;
-    }
+    retVal = (SDL_ENUMERATE *) sdl_symtab_lookup_id(&enums->symtab, typeID);
 
     /*
      * Return the results of this call back to the caller.
@@ -756,7 +831,6 @@ SDL_ENUMERATE *sdl_get_enum(SDL_ENUM_LIST *enums, int typeID)
 int sdl_usertype_idx(SDL_CONTEXT *context, char *usertype)
 {
     int retVal = 0;
-    SDL_DECLARE *myDeclare = (SDL_DECLARE *) context->declares.header.flink;
 
     /*
      * If processing is not turned off because of an IFSYMBOL..ELSE_IFSYMBOL..
@@ -766,25 +840,18 @@ int sdl_usertype_idx(SDL_CONTEXT *context, char *usertype)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_usertype_idx\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_usertype_idx");
+
+        SDL_DECLARE *myDeclare =
+                    sdl_symtab_lookup_hash(&context->declares.symtab,
+                                           usertype,
+                                           sdl_intern_hash(usertype));
 
-        while (myDeclare != (SDL_DECLARE *) &context->declares.header)
+        if (myDeclare != NULL)
         {
-            if (strcmp(myDeclare->id, usertype) == 0)
-            {
-                retVal = myDeclare->typeID;
-                break;
-            }
-            else
-            {
-                myDeclare = (SDL_DECLARE *) myDeclare->header.queue.flink;
-            }
+            retVal = myDeclare->typeID;
         }
     }
 
@@ -817,8 +884,6 @@ int sdl_usertype_idx(SDL_CONTEXT *context, char *usertype)
 int sdl_aggrtype_idx(SDL_CONTEXT *context, char *aggregateName)
 {
     int retVal = 0;
-    SDL_AGGREGATE *myAggregate =
-                (SDL_AGGREGATE *) context->aggregates.header.flink;
 
     /*
      * If processing is not turned off because of an IFSYMBOL..ELSE_IFSYMBOL..
@@ -828,25 +893,18 @@ int sdl_aggrtype_idx(SDL_CONTEXT *context, char *aggregateName)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_aggrtype_idx\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_aggrtype_idx");
 
-        while (myAggregate != (SDL_AGGREGATE *) &context->aggregates.header)
+        SDL_AGGREGATE *myAggregate =
+                    sdl_symtab_lookup_hash(&context->aggregates.symtab,
+                                           aggregateName,
+                                           sdl_intern_hash(aggregateName));
+
+        if (myAggregate != NULL)
         {
-            if (strcmp(myAggregate->id, aggregateName) == 0)
-            {
-                retVal = myAggregate->typeID;
-                break;
-            }
-            else
-            {
-                myAggregate = (SDL_AGGREGATE *) myAggregate->header.queue.flink;
-            }
+            retVal = myAggregate->typeID;
         }
     }
 
@@ -878,13 +936,9 @@ __int64_t sdl_bin2int(char *binStr)
     int ii;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no
-     * returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_bin2int\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_bin2int");
 
     while (binStr[ii] != '\0')
     {
@@ -906,6 +960,9 @@ __int64_t sdl_bin2int(char *binStr)
  *  value.  There is no attempt to interpret the contents of the string itself.
  *
  * Input Parameters:
+ *  context:
+ *    A pointer to the context structure, where the message vector is
+ *    maintained.
  *  strVal:
  *    A pointer to the string to be converted.
  *
@@ -919,19 +976,15 @@ __int64_t sdl_bin2int(char *binStr)
  *  SDL_STRINGCONST:    String constant used in arithmetic expression.
  *  SDL_ERREXIT:        Error exit.
  */
-uint32_t sdl_str2int(char *strVal, __int64_t *val)
+uint32_t sdl_str2int(SDL_CONTEXT *context, char *strVal, __int64_t *val)
 {
     uint32_t retVal = SDL_NORMAL;
     size_t len = strlen(strVal);
 
     /*
-     * If tracing is turned on, write out this call (calls only, no
-     * returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_str2int\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_str2int");
 
     /*
      * If the input string is less than or equal to the maximum size of a
@@ -963,7 +1016,7 @@ uint32_t sdl_str2int(char *strVal, __int64_t *val)
     else
     {
         retVal = SDL_STRINGCONST;
-        if (sdl_set_message(msgVec,
+        if (sdl_set_message(context->msgVec,
                             1,
                             retVal,
                             strVal,
@@ -1024,13 +1077,9 @@ int64_t sdl_offset(SDL_CONTEXT *context, int offsetType, SDL_YYLTYPE *loc)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_offset\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_offset");
 
         /*
          * Before we can do anything, if there are options still to be process,
@@ -1297,17 +1346,9 @@ int sdl_dimension(SDL_CONTEXT *context, size_t lbound, size_t hbound)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_dimension(%ld:%ld)\n",
-                   __FILE__,
-                   __LINE__,
-                   lbound,
-                   hbound);
-        }
+        SDL_TRACE2("sdl_dimension", lbound, hbound);
 
         /*
          * Loop through all the dimension array entries looking for an
@@ -1386,25 +1427,14 @@ uint32_t sdl_add_option(SDL_CONTEXT *context,
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.  A string is recorded as
+         * just whether there is one.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_add_option(%d, ",
-                   __FILE__,
-                   __LINE__,
-                   option);
-            if (string == NULL)
-            {
-                printf("%ld)", value);
-            }
-            else
-            {
-                printf("%s)", string);
-            }
-            printf(" at index %d\n", context->optionsIdx);
-        }
+        SDL_TRACE4("sdl_add_option",
+                   option,
+                   value,
+                   string != NULL,
+                   context->optionsIdx);
 
         /*
          * The options list is dynamically sized, and is never reduced.  So, if
@@ -1417,7 +1447,9 @@ uint32_t sdl_add_option(SDL_CONTEXT *context,
 
             context->optionsSize += SDL_K_OPTIONS_INCR;
             size = context->optionsSize * sizeof(SDL_OPTION);
-            context->options = sdl_realloc(context->options, size);
+            context->options = sdl_realloc_site(MemOptions,
+                                                context->options,
+                                                size);
             if (context->options == NULL)
             {
                 retVal = ENOMEM;
@@ -1438,7 +1470,7 @@ uint32_t sdl_add_option(SDL_CONTEXT *context,
                  */
                 case None:
                     retVal = SDL_UNKOPTION;
-                    if (sdl_set_message(msgVec,
+                    if (sdl_set_message(context->msgVec,
                                         1,
                                         retVal,
                                         loc->first_line) != SDL_NORMAL)
@@ -1552,17 +1584,9 @@ uint32_t sdl_precision(SDL_CONTEXT *context, int64_t precision, int64_t scale)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_precision(%ld, %ld)\n",
-                   __FILE__,
-                   __LINE__,
-                   precision,
-                   scale);
-        }
+        SDL_TRACE2("sdl_precision", precision, scale);
 
         /*
          * Save the precision and scale information where we can find it later.
@@ -1599,12 +1623,9 @@ bool sdl_all_lower(const char *str)
     bool retVal = true;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_all_lower\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_all_lower");
 
     for (ii = 0; ((ii < len) && (retVal == true)); ii++)
     {
@@ -1657,12 +1678,9 @@ void sdl_trim_str(char *str, int type)
     bool keepNL = (type & SDL_M_KEEP_NL) != 0;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_trim(0x%08x)\n", __FILE__, __LINE__, type);
-    }
+    SDL_TRACE1("sdl_trim", type);
 
     /*
      * If we are to convert control characters to spaces, do so now.  If we are
@@ -1848,13 +1866,9 @@ int64_t sdl_sizeof(SDL_CONTEXT *context, int item)
     {
 
         /*
-         * If tracing is turned on, write out this call (calls only, no
-         * returns).
+         * If tracing is turned on, record this call.
          */
-        if (trace == true)
-        {
-            printf("%s:%d:sdl_sizeof\n", __FILE__, __LINE__);
-        }
+        SDL_TRACE("sdl_sizeof");
 
         if ((item >= SDL_K_BASE_TYPE_MIN) && (item <= SDL_K_BASE_TYPE_MAX))
         {
@@ -2053,12 +2067,9 @@ bool sdl_isUnsigned(SDL_CONTEXT *context, int64_t *datatype)
     int64_t myDatatype = *datatype;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_isUnsigned\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_isUnsigned");
 
     /*
      * If the data type is less than zero, then it is signed.  Otherwise, it
@@ -2101,12 +2112,9 @@ bool sdl_isItem(SDL_MEMBERS *member)
     bool retVal = false;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_isItem\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_isItem");
 
     if ((member->type != SDL_K_TYPE_STRUCT) &&
         (member->type != SDL_K_TYPE_UNION))
@@ -2141,12 +2149,9 @@ bool sdl_isComment(SDL_MEMBERS *member)
     bool retVal = false;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_isComment\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_isComment");
 
     if (member->type == SDL_K_TYPE_COMMENT)
     {
@@ -2179,12 +2184,9 @@ bool sdl_isBitfield(SDL_MEMBERS *member)
     bool retVal = false;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_isBitfield\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_isBitfield");
 
     if ((member->type == SDL_K_TYPE_BITFLD) ||
         (member->type == SDL_K_TYPE_BITFLD_B) ||
@@ -2223,12 +2225,9 @@ bool sdl_isAddress(int type)
     bool retVal;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:sdl_isAddress\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("sdl_isAddress");
 
     switch (type)
     {
@@ -2279,12 +2278,9 @@ static void _sdl_push_state(SDL_CONTEXT *context, SDL_STATE state)
 {
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_push_state\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_push_state");
 
     /*
      * If there is no room for another value, then reallocate the stack to be
@@ -2294,10 +2290,11 @@ static void _sdl_push_state(SDL_CONTEXT *context, SDL_STATE state)
      */
     if (context->stateIdx >= context->stateSize)
     {
-        size_t    newSize = sizeof(SDL_STATE) * context->stateSize + 1;
+        size_t    newSize = sizeof(SDL_STATE) * (context->stateSize + 1);
 
-        context->stateStack = (SDL_STATE *) sdl_realloc(context->stateStack,
-                                                        newSize);
+        context->stateStack = sdl_realloc_site(MemStateStack,
+                                               context->stateStack,
+                                               newSize);
         context->stateSize++;
     }
 
@@ -2337,12 +2334,9 @@ static SDL_STATE _sdl_pop_state(SDL_CONTEXT *context)
     SDL_STATE retVal = Module;
 
     /*
-     * If tracing is turned on, write out this call (calls only, no returns).
+     * If tracing is turned on, record this call.
      */
-    if (trace == true)
-    {
-        printf("%s:%d:_sdl_pop_state\n", __FILE__, __LINE__);
-    }
+    SDL_TRACE("_sdl_pop_state");
 
     /*
      * If there is something on the stack, then pop it off.
@@ -21,13 +21,37 @@
  *  definition file.
  *
  * USAGE:
- *	$ ./opensdl <input_SDL_file>
+ *	$ ./opensdl <input_SDL_file>... [@response_file]...
+ *	$ ./opensdl --server=<socket> [lang]...
+ *	$ ./opensdl --connect=<socket> <input_SDL_file>...
+ *		--server=<socket>
+ *				Must be the first argument.  Run as a compile
+ *				server listening on the Unix domain socket,
+ *				with the plugins for the languages that follow
+ *				already loaded.  INCLUDE files are cached
+ *				between requests.
+ *		--connect=<socket>
+ *				Must be the first argument.  Have the compile
+ *				server listening on the socket run the rest of
+ *				the command line.  The diagnostics and exit
+ *				status are the same as running it here, which
+ *				is what is done if there is no server.
  *		-a, --align:<value>
  *				The assumed alignment.  A value that is a power
  *				two and between 0 and 8.  A value of 0 is no
  *				alignment (the default).
  *		-b32|b64 The number of bits that represent a longword.
  *				(64 is the default)
+ *		    --cache=<directory>
+ *				Keep the output files in a cache directory.
+ *				They are used again, without parsing the input
+ *				file, when the input file, the INCLUDE files it
+ *				used, the options and the plugins have not
+ *				changed.  The header is the one from when the
+ *				output files were put in the cache.  INCLUDE
+ *				files included outside of a MODULE are also
+ *				kept there precompiled.  Not used when a
+ *				listing file is being generated.
  *		-k, --[no]check	Diagnostic messages are generated for items
  *				the do not fall on their natural alignment.
  *				(nocheck is the default)
@@ -38,12 +62,29 @@
  *		-C, --[no]copy	Controls whether the copyright header is
  *				included in the output file (see copyright.sdl
  *				for what is included). (nocopy is the default)
+ *		    --counters	Add the cycles, instructions, cache misses and
+ *				branch misses, and the instructions per cycle,
+ *				for each phase and language to the statistics
+ *				(implies --stats).  A counter that cannot be
+ *				read is left out.
+ *		    --depfile[=filespec]
+ *				Write a dependency file listing the input file,
+ *				the copyright file and every INCLUDE file that
+ *				was opened, as "cc -MD -MP" does for make.  The
+ *				default file name is the input file with a file
+ *				extension of '.d'.  Ninja reads the same file,
+ *				given as the depfile of the build statement
+ *				with "deps = gcc".
  *		-H, --[no]header
  *				Controls whether a header containing the date
  *				and the source filename is included at the
  *				beginning of the output file(s). (header is the
  *				default)
  *		-?, --help	Display the usage information.
+ *		-j, --jobs:<count>
+ *				The number of input files compiled at the same
+ *				time, each on its own thread. (1 is the
+ *				default)
  *		-l, --lang:<lang[=filespec]>
  *				Specifies one of the language options.  At
  *				least one needs to be specified on the command
@@ -58,6 +99,22 @@
  *				the default)
  *		-p, --[no]parse	This has not yet been implemented. (parse is
  *				the default)
+ *		    --replay	The input files are recordings, made with
+ *				--lang=record, which are replayed to the other
+ *				languages, rather than SDL files to be parsed.
+ *				The header and copyright are the ones that were
+ *				recorded.
+ *		    --stats[=text|json]
+ *				Write out statistics for each input file (and
+ *				variant) after its diagnostics: the time spent
+ *				scanning, parsing, laying out, emitting, in the
+ *				listing and tearing down each MODULE, the time
+ *				each language took and the bytes it wrote, and
+ *				the blocks allocated, symbol lookups and tokens
+ *				scanned.  Then the time spent on the options and
+ *				loading plugins is written out for the whole
+ *				run.  The statistics are written as text (the
+ *				default), or as one JSON object per line.
  *		-S, --[no]suppress[:prefix|tag]
  *				Suppress outputting symbols with a prefix, tag,
  *				or both. (nosupress is the default).
@@ -66,9 +123,30 @@
  *				is specified in the input file.  A value of
  *				zero turns off the symbol and a non-zero value
  *				turns it on.
- *		-t, --trace	Trace memory allocations and deallocations.
- *		-v, --verbose	Verbose information during processing.  By
- *				default this is turned off.
+ *		-t, --trace	Report a memory profile when done.
+ *		-u, --[no]update
+ *				An output file is only replaced when what is
+ *				generated is different from what is already in
+ *				it, so its modification time only changes when
+ *				its contents do.  The creation time in the
+ *				header is the time the input file was
+ *				modified. (noupdate is the default)
+ *		    --variant=<name>[:<option>[,<option>]...]
+ *				Also generate the output files for a variant,
+ *				named by adding '_' and the name of the variant
+ *				to each output and dependency file name, ahead
+ *				of its extension.  The options are b32, b64,
+ *				align=<value> and <symbol>=<value>, and
+ *				override the ones given by -b32|b64, --align
+ *				and --symbol for this variant.  May be given
+ *				more than once.  The input file is only scanned
+ *				once for all the variants, which are then
+ *				parsed, laid out and generated one after the
+ *				other.  Not allowed with --list or --replay.
+ *		-v, --verbose	Verbose information during processing.  The
+ *				calls made are recorded in the trace file
+ *				opensdl.sdltrace, which OpenSDL_trace turns
+ *				into text.  By default this is turned off.
  *		    --version	Display the version information for the OpenSDL
  *				utility.  By default the version information is
  *				not displayed.
@@ -83,11 +161,105 @@
  *
  *  V01.002 30-MAR-2019 Jonathan D. Belanger
  *  Updated to use argp instead of a custom-rolled argument processor.
+ *
+ *  V01.003 15-OCT-2026 Jonathan D. Belanger
+ *  Initialize the symbol tables in the context, and release the arena from
+ *  the last MODULE at exit.
+ *
+ *  V01.004 15-OCT-2026 Jonathan D. Belanger
+ *  Release the identifier pool at exit.
+ *
+ *  V01.005 15-OCT-2026 Jonathan D. Belanger
+ *  The context is now local to this module and holds the message vector,
+ *  listing and LITERAL queue.  The scanner and parser are run through
+ *  sdl_parse_file, which also now has the yyerror function.
+ *
+ *  V01.006 15-OCT-2026 Jonathan D. Belanger
+ *  Any number of input files, and response files containing input file
+ *  names, can be specified.  The input files are compiled across a pool of
+ *  worker threads (-j), with the plugins loaded just once, and the
+ *  diagnostics for each input file are written out in the order the files
+ *  were specified.
+ *
+ *  V01.007 15-OCT-2026 Jonathan D. Belanger
+ *  Added the compile server (--server) and its client (--connect).  The
+ *  language enabled vector is indexed by plugin identifier.
+ *
+ *  V01.008 15-OCT-2026 Jonathan D. Belanger
+ *  Added the output cache (--cache).
+ *
+ *  V01.009 15-OCT-2026 Jonathan D. Belanger
+ *  Added update mode (--update), where output files are only replaced when
+ *  they change.
+ *
+ *  V01.010 15-OCT-2026 Jonathan D. Belanger
+ *  Added dependency files (--depfile and --dyndep).
+ *
+ *  V01.011 15-OCT-2026 Jonathan D. Belanger
+ *  The context records the output file for each language, so that each
+ *  language can be generated on a thread of its own.
+ *
+ *  V01.012 15-OCT-2026 Jonathan D. Belanger
+ *  The context has an output sink for each language.  An error writing out
+ *  an output file, when it is closed, is reported.
+ *
+ *  V01.013 16-OCT-2026 Jonathan D. Belanger
+ *  Added replaying recordings (--replay).
+ *
+ *  V01.014 16-OCT-2026 Jonathan D. Belanger
+ *  INCLUDE files are also precompiled into the cache directory (--cache).
+ *
+ *  V01.015 16-OCT-2026 Jonathan D. Belanger
+ *  Added --variant, to generate output files for more than one set of
+ *  symbols, word size and alignment from a single scan of each input file.
+ *
+ *  V01.016 16-OCT-2026 Jonathan D. Belanger
+ *  Added --stats, to report where the time goes for each input file.
+ *
+ *  V01.017 16-OCT-2026 Jonathan D. Belanger
+ *  The trace is recorded in binary ring buffers and written to the trace
+ *  file, rather than written to standard output as it happens.
+ *
+ *  V01.018 16-OCT-2026 Jonathan D. Belanger
+ *  --trace reports a memory profile, by block type and memory site, with the
+ *  peak resident set size, once when the program exits.  The language
+ *  strings are duplicated with sdl_strdup_heap, as they are freed with
+ *  sdl_free.
+ *
+ *  V01.019 16-OCT-2026 Jonathan D. Belanger
+ *  Added --counters, to add the hardware counters to --stats.
+ *
+ *  V01.020 16-OCT-2026 Jonathan D. Belanger
+ *  The compile server exits successfully when it is told to stop.
+ *
+ *  V01.021 16-OCT-2026 Jonathan D. Belanger
+ *  With --variant, the output files without a variant are generated too, as
+ *  the help says.
+ *
+ *  V01.022 16-OCT-2026 Jonathan D. Belanger
+ *  Removed --dyndep.  A Ninja dyndep file cannot be used as a depfile, and
+ *  Ninja reads the make dependency file as one.
+ *
+ *  V01.023 16-OCT-2026 Jonathan D. Belanger
+ *  In update mode, the creation time in the header of an output file is
+ *  the time the input file was modified, so that generating it again from
+ *  the same input file does not change it.
+ *
+ *  V01.024 16-OCT-2026 Jonathan D. Belanger
+ *  The context for an input file is set up, and cleaned up, by
+ *  sdl_context_init and sdl_context_free.
+ *
+ *  V01.025 16-OCT-2026 Jonathan D. Belanger
+ *  The identifier pool is released with the context for each input file,
+ *  rather than once when the program exits.
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
+#include <limits.h>
+#include <pthread.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -97,24 +269,29 @@
 #include "library/utility/opensdl_plugin_funcs.h"
 #include "library/common/opensdl_blocks.h"
 #include "library/common/opensdl_message.h"
+#include "library/common/opensdl_stats.h"
+#include "library/common/opensdl_trace.h"
+#include "library/utility/opensdl_listing.h"
+#include "library/utility/opensdl_include.h"
+#include "library/utility/opensdl_cache.h"
+#include "library/utility/opensdl_output.h"
+#include "library/utility/opensdl_record.h"
+#include "library/utility/opensdl_utility.h"
 #include "library/parser/opensdl_parser.h"
-#include "library/parser/opensdl_lexical.h"
+#include "opensdl/opensdl_server.h"
 
 /*
  * Function prototypes
  */
 static error_t _sdl_parse_opt(int, char *, struct argp_state *);
+static uint32_t _sdl_add_input(SDL_CONTEXT *, char *);
+static uint32_t _sdl_add_variant(SDL_CONTEXT *, char *);
+static int _sdl_main(int, char **);
 
 /*
  * Defines and includes for enable extend trace and logging
  */
-extern SDL_CONTEXT context;
-extern SDL_QUEUE literal;
-
-void *scanner = NULL;
 bool trace;
-bool listing;
-FILE *listingFP = NULL;
 int _verbose;
 
 #define SDL_K_STARS	0
@@ -135,11 +312,18 @@ int _verbose;
 #define SDL_K_ARG_NOMODULE       9
 #define SDL_K_ARG_NOPARSE       10
 #define SDL_K_ARG_NOSUPPRESS    11
+#define SDL_K_ARG_CACHE         12
+#define SDL_K_ARG_NOUPDATE      13
+#define SDL_K_ARG_DEPFILE       14
+#define SDL_K_ARG_REPLAY        15
+#define SDL_K_ARG_VARIANT       16
+#define SDL_K_ARG_STATS         17
+#define SDL_K_ARG_COUNTERS      18
 const char *argp_program_version = "OpenSDL V3.4.20181114";
 const char *argp_program_bug_address =
     "https://github.com/JonathanBelanger/OpenSDL/issues";
 static char doc[] = "Open Structure Definition Language";
-static char args_doc[] = "[FILENAME]";
+static char args_doc[] = "FILENAME... [@RESPONSE-FILE]...";
 static struct argp_option options[] =
 {
     {
@@ -167,6 +351,17 @@ static struct argp_option options[] =
         "The number of bits that represent a longword. (default)",
         0
     },
+    {
+        "cache",
+        SDL_K_ARG_CACHE,
+        "directory",
+        0,
+        "Keep the output files in a cache directory, and use them again when "
+            "the input file, its INCLUDE files, the options and the plugins "
+            "have not changed.  INCLUDE files outside of a MODULE are kept "
+            "there precompiled.",
+        0
+    },
     {
         "check",
         'k',
@@ -218,6 +413,27 @@ static struct argp_option options[] =
         "A copyright header is not included in the output file. (the default)",
         0
     },
+    {
+        "counters",
+        SDL_K_ARG_COUNTERS,
+        0,
+        0,
+        "Add the cycles, instructions, cache misses and branch misses, and the "
+            "instructions per cycle, for each phase and language to --stats "
+            "(implies --stats), when the hardware counters can be read.",
+        0
+    },
+    {
+        "depfile",
+        SDL_K_ARG_DEPFILE,
+        "filespec",
+        OPTION_ARG_OPTIONAL,
+        "Write a dependency file, listing the input file and every INCLUDE "
+            "file it used, for make, or for Ninja as the depfile of a build "
+            "statement with deps = gcc.  The default file name is the input "
+            "file name with '.d' as the file extension.",
+        0
+    },
     {
         "header",
         'H',
@@ -236,6 +452,15 @@ static struct argp_option options[] =
             "at the top of the output file(s)",
         0
     },
+    {
+        "jobs",
+        'j',
+        "count",
+        0,
+        "The number of input files compiled at the same time, each on its own "
+            "thread. (1 is the default)",
+        0
+    },
     {
         "lang",
         'l',
@@ -309,6 +534,25 @@ static struct argp_option options[] =
         "This has not yet been implemented.",
         0
     },
+    {
+        "replay",
+        SDL_K_ARG_REPLAY,
+        0,
+        0,
+        "The input files are recordings, made with --lang=record, to be "
+            "replayed to the other languages, rather than parsed.",
+        0
+    },
+    {
+        "stats",
+        SDL_K_ARG_STATS,
+        "text|json",
+        OPTION_ARG_OPTIONAL,
+        "Write out the time spent in each phase, and what was done in it, for "
+            "each input file, and then for the whole run, as text (the "
+            "default) or JSON.",
+        0
+    },
     {
         "suppress",
         'S',
@@ -343,7 +587,35 @@ static struct argp_option options[] =
         't',
         0,
         0,
-        "Trace memory allocations and deallocations.",
+        "Report a memory profile, by block type and memory site, when done.",
+        0
+    },
+    {
+        "update",
+        'u',
+        0,
+        0,
+        "An output file is only replaced when its contents change, so that "
+            "its modification time is left alone otherwise.  The creation "
+            "time in the header is the time the input file was modified.",
+        0
+    },
+    {
+        "noupdate",
+        SDL_K_ARG_NOUPDATE,
+        0,
+        0,
+        "Every output file is rewritten. (the default)",
+        0
+    },
+    {
+        "variant",
+        SDL_K_ARG_VARIANT,
+        "name[:option,...]",
+        0,
+        "Also generate the output files for a variant, with '_name' added to "
+            "their file names.  The options are b32, b64, align=value and "
+            "symbol=value.  The input file is scanned once for all variants.",
         0
     },
     {
@@ -360,58 +632,34 @@ static struct argp argp =
 {options, _sdl_parse_opt, args_doc, doc, 0, 0, 0};
 
 /*
- * Define the message vector to be used to report error messages throughout
- * the application.  Each entry in the message vector contains a 32-bit message
- * code, followed by a 16-bit Formatted ASCII Output (FAO) count, and a 16-bit
- * FAO information field.  The FAO information field contains an 8-bit type and
- * and 8-bit length field (256 character long strings should be long enough).
- * So, each message vector entry is 64-bits long.
+ * The context for the file being compiled.  This contains everything needed
+ * to parse a file and generate its output, including the message vector used
+ * to report error messages.
  */
-#define SDL_MSG_VEC_LEN	1024
-SDL_MSG_VECTOR msgVec[SDL_MSG_VEC_LEN];
+static SDL_CONTEXT context;
 static char *errFmt = "\n%s";
 
 /*
- * yyerror
- *  This is the error handler to be used by Bison when a syntax error has been
- *  detected.
- *
- * Input Parameters:
- *  locp:
- *      A pointer to a structure containing the information about the syntax
- *      error.  Specifically, we are interested in the first line number of the
- *      input file.
- *  scanner:
- *      A pointer to the Bison scanner structure.  This parameter is ignored.
- *  msg:
- *      A pointer to a string containing what specifically caused the parse
- *      error.
- *
- * Output Parameters:
- *  None.
- *
- * Return Values:
- *  None.
+ * The following structure is used to keep track of each of the input files to
+ * be compiled, and the diagnostics written while compiling it, so that they
+ * can be written out in the order the input files were specified.  The next
+ * job to be started and the done flags are protected by the job mutex.
  */
-void yyerror(YYLTYPE *locp, yyscan_t *scanner, char const *msg)
+#define SDL_K_INPUT_INCR	16
+typedef struct
 {
-    if (sdl_set_message(msgVec,
-                        2,
-                        SDL_SYNTAXERR,
-                        locp->first_line,
-                        SDL_PARSEERR,
-                        msg) == SDL_NORMAL)
-    {
-        char *msgText;
-
-        if (sdl_get_message(msgVec, &msgText) == SDL_NORMAL)
-        {
-            fprintf(stderr, "%s\n", msgText);
-            sdl_free(msgText);
-        }
-    }
-    return;
-}
+    char        *fileName;
+    char        *errBuf;
+    size_t      errLen;
+    int         retVal;
+    bool        done;
+} SDL_COMPILE_JOB;
+
+static SDL_COMPILE_JOB *_sdl_jobs = NULL;
+static int _sdl_job_count = 0;
+static int _sdl_job_next = 0;
+static pthread_mutex_t _sdl_job_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _sdl_job_done = PTHREAD_COND_INITIALIZER;
 
 /*
  * _sdl_parse_opt
@@ -457,19 +705,19 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
     switch (key)
     {
         case ARGP_KEY_ARG:
-            if (args[ArgInputFile].present == false)
+            args[ArgInputList].present = true;
+            switch (_sdl_add_input(context, arg))
             {
-                args[ArgInputFile].present = true;
-                args[ArgInputFile].fileName = sdl_strdup(arg);
+                case SDL_NORMAL:
+                    break;
 
-                /*
-                 * We at least need read access to the file.
-                 */
-                if (access(arg, R_OK) != 0)
-                {
-                    sdl_set_message(msgVec, 1, SDL_INFILOPN, arg);
+                case SDL_INFILOPN:
                     retVal = EACCES;
-                }
+                    break;
+
+                default:
+                    retVal = ENOMEM;
+                    break;
             }
             break;
 
@@ -481,7 +729,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec,
+                sdl_set_message(context->msgVec,
                                 1,
                                 SDL_CONFLDUPLQ,
                                 "--check|--nocheck");
@@ -497,7 +745,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec,
+                sdl_set_message(context->msgVec,
                                 1,
                                 SDL_CONFLDUPLQ,
                                 "--comment|--nocomment");
@@ -513,7 +761,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec, 1, SDL_CONFLDUPLQ, "--b32|--b64");
+                sdl_set_message(context->msgVec, 1, SDL_CONFLDUPLQ, "--b32|--b64");
                 retVal = EINVAL;
             }
             break;
@@ -526,7 +774,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec,
+                sdl_set_message(context->msgVec,
                                 1,
                                 SDL_CONFLDUPLQ,
                                 "--copy|--nocopy");
@@ -542,7 +790,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec,
+                sdl_set_message(context->msgVec,
                                 1,
                                 SDL_CONFLDUPLQ,
                                 "--header|--noheader");
@@ -558,7 +806,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec, 1, SDL_CONFLDUPLQ, "--b32|--b64");
+                sdl_set_message(context->msgVec, 1, SDL_CONFLDUPLQ, "--b32|--b64");
                 retVal = EINVAL;
             }
             break;
@@ -571,7 +819,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec, 1, SDL_DUPLISTQUAL);
+                sdl_set_message(context->msgVec, 1, SDL_DUPLISTQUAL);
                 retVal = EINVAL;
             }
             break;
@@ -584,7 +832,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec,
+                sdl_set_message(context->msgVec,
                                 1,
                                 SDL_CONFLDUPLQ,
                                 "--member|--nomember");
@@ -593,12 +841,12 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             break;
 
         case SDL_K_ARG_NOMODULE:
-            sdl_set_message(msgVec, 1, SDL_INVQUAL, "--nomodule");
+            sdl_set_message(context->msgVec, 1, SDL_INVQUAL, "--nomodule");
             retVal = ARGP_ERR_UNKNOWN;
             break;
 
         case SDL_K_ARG_NOPARSE:
-            sdl_set_message(msgVec, 1, SDL_INVQUAL, "--noparse");
+            sdl_set_message(context->msgVec, 1, SDL_INVQUAL, "--noparse");
             retVal = ARGP_ERR_UNKNOWN;
             break;
 
@@ -629,7 +877,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                 }
                 else
                 {
-                    sdl_set_message(msgVec,
+                    sdl_set_message(context->msgVec,
                                     1,
                                     SDL_INVQUAL,
                                     "--nosuppress");
@@ -649,7 +897,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                 }
                 else if (second != NULL)
                 {
-                    sdl_set_message(msgVec,
+                    sdl_set_message(context->msgVec,
                                     1,
                                     SDL_INVQUAL,
                                     "--nosuppress");
@@ -665,6 +913,99 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             break;
 
+        case SDL_K_ARG_NOUPDATE:
+            if (args[ArgUpdate].present == false)
+            {
+                args[ArgUpdate].present = true;
+                args[ArgUpdate].on = false;
+            }
+            else
+            {
+                sdl_set_message(context->msgVec,
+                                1,
+                                SDL_CONFLDUPLQ,
+                                "--update|--noupdate");
+                retVal = EINVAL;
+            }
+            break;
+
+        case SDL_K_ARG_DEPFILE:
+            if (args[ArgDepend].present == false)
+            {
+                args[ArgDepend].present = true;
+                args[ArgDepend].on = true;
+                if (arg != NULL)
+                {
+                    args[ArgDependFile].present = true;
+                    args[ArgDependFile].fileName = arg;
+                }
+            }
+            else
+            {
+                sdl_set_message(context->msgVec,
+                                1,
+                                SDL_CONFLDUPLQ,
+                                "--depfile");
+                retVal = EINVAL;
+            }
+            break;
+
+        case SDL_K_ARG_REPLAY:
+            args[ArgReplay].present = true;
+            args[ArgReplay].on = true;
+            break;
+
+        case SDL_K_ARG_COUNTERS:
+            args[ArgCounters].present = true;
+            args[ArgCounters].on = true;
+            if (args[ArgStats].present == false)
+            {
+                args[ArgStats].present = true;
+                args[ArgStats].value = SDL_K_STATS_TEXT;
+            }
+            break;
+
+        case SDL_K_ARG_STATS:
+            args[ArgStats].present = true;
+            if ((arg == NULL) || (strcmp(arg, "text") == 0))
+            {
+                args[ArgStats].value = SDL_K_STATS_TEXT;
+            }
+            else if (strcmp(arg, "json") == 0)
+            {
+                args[ArgStats].value = SDL_K_STATS_JSON;
+            }
+            else
+            {
+                sdl_set_message(context->msgVec, 1, SDL_INVQUAL, "--stats");
+                retVal = EINVAL;
+            }
+            break;
+
+        case SDL_K_ARG_VARIANT:
+            args[ArgVariant].present = true;
+            if (_sdl_add_variant(context, arg) != SDL_NORMAL)
+            {
+                retVal = EINVAL;
+            }
+            break;
+
+        case SDL_K_ARG_CACHE:
+            if (args[ArgCacheDir].present == false)
+            {
+                args[ArgCacheDir].present = true;
+                args[ArgCacheDir].fileName = arg;
+            }
+            else
+            {
+                sdl_set_message(context->msgVec,
+                                1,
+                                SDL_CONFLDUPLQ,
+                                "--cache");
+                retVal = EINVAL;
+            }
+            break;
+
         case 'C':
             if (args[ArgCopyright].present == false)
             {
@@ -691,7 +1032,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                     sdl_free(path);
                     if (access(args[ArgCopyrightFile].fileName, R_OK) != 0)
                     {
-                        sdl_set_message(msgVec,
+                        sdl_set_message(context->msgVec,
                                         1,
                                         SDL_NOCOPYFIL);
                         retVal = EACCES;
@@ -700,7 +1041,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec,
+                sdl_set_message(context->msgVec,
                                 1,
                                 SDL_CONFLDUPLQ,
                                 "--copy|--nocopy");
@@ -716,7 +1057,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec,
+                sdl_set_message(context->msgVec,
                                 1,
                                 SDL_CONFLDUPLQ,
                                 "--header|--noheader");
@@ -738,13 +1079,13 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec, 1, SDL_DUPLISTQUAL);
+                sdl_set_message(context->msgVec, 1, SDL_DUPLISTQUAL);
                 retVal = EINVAL;
             }
             break;
 
         case 'M':
-            sdl_set_message(msgVec, 1, SDL_INVQUAL, "-M|--module");
+            sdl_set_message(context->msgVec, 1, SDL_INVQUAL, "-M|--module");
             retVal = ARGP_ERR_UNKNOWN;
             break;
 
@@ -775,7 +1116,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                 }
                 else
                 {
-                    sdl_set_message(msgVec,
+                    sdl_set_message(context->msgVec,
                                     1,
                                     SDL_INVQUAL,
                                     "--suppress");
@@ -795,7 +1136,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                 }
                 else if (second != NULL)
                 {
-                    sdl_set_message(msgVec,
+                    sdl_set_message(context->msgVec,
                                     1,
                                     SDL_INVQUAL,
                                     "--suppress");
@@ -821,7 +1162,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                      (arg[0] != '4') &&
                      (arg[0] != '8')))
                 {
-                    sdl_set_message(msgVec,
+                    sdl_set_message(context->msgVec,
                                     1,
                                     SDL_INVALIGN);
                     retVal = EINVAL;
@@ -833,7 +1174,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                 }
                 else
                 {
-                    sdl_set_message(msgVec,
+                    sdl_set_message(context->msgVec,
                                     1,
                                     SDL_CONFLDUPLQ,
                                     "--align|--noalign");
@@ -842,7 +1183,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec, 1, SDL_INVQUAL, "-a|--align");
+                sdl_set_message(context->msgVec, 1, SDL_INVQUAL, "-a|--align");
                 retVal = EINVAL;
             }
             break;
@@ -855,7 +1196,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec,
+                sdl_set_message(context->msgVec,
                                 1,
                                 SDL_CONFLDUPLQ,
                                 "--comments|--nocomments");
@@ -871,7 +1212,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec,
+                sdl_set_message(context->msgVec,
                                 1,
                                 SDL_CONFLDUPLQ,
                                 "--check|--nocheck");
@@ -954,14 +1295,17 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                          * Now let's do a bit of initialization of the new
                          * entry.
                          */
-                        langs[index].langStr = strdup(arg);
+                        langs[index].langStr = sdl_strdup_heap(arg);
 
                         /*
                          * Try and load the shared library for this language.
                          */
-                        status = sdl_load_plugin(arg,
+                        sdl_stats_begin(PhasePlugins);
+                        status = sdl_load_plugin(context,
+                                                 arg,
                                                  &langs[index].extension,
                                                  &langs[index].langVal);
+                        sdl_stats_end();
                         if (status == SDL_NORMAL)
                         {
                             if (*ptr != '\0')
@@ -982,10 +1326,36 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                 }
                 else
                 {
-                    sdl_set_message(msgVec, 1, SDL_DUPLANG, arg);
+                    sdl_set_message(context->msgVec, 1, SDL_DUPLANG, arg);
+                    retVal = EINVAL;
+                }
+            }
+            break;
+
+        case 'j':
+            if ((arg != NULL) && (args[ArgJobs].present == false))
+            {
+                char *ptr;
+
+                args[ArgJobs].present = true;
+                args[ArgJobs].value = strtol(arg, &ptr, 10);
+                if ((*ptr != '\0') || (args[ArgJobs].value <= 0))
+                {
+                    sdl_set_message(context->msgVec,
+                                    1,
+                                    SDL_INVQUAL,
+                                    "-j|--jobs");
                     retVal = EINVAL;
                 }
             }
+            else
+            {
+                sdl_set_message(context->msgVec,
+                                1,
+                                SDL_CONFLDUPLQ,
+                                "-j|--jobs");
+                retVal = EINVAL;
+            }
             break;
 
         case 'm':
@@ -996,7 +1366,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec,
+                sdl_set_message(context->msgVec,
                                 1,
                                 SDL_CONFLDUPLQ,
                                 "--member|--nomember");
@@ -1005,7 +1375,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             break;
 
         case 'p':
-            sdl_set_message(msgVec, 1, SDL_INVQUAL, "-p|--parse");
+            sdl_set_message(context->msgVec, 1, SDL_INVQUAL, "-p|--parse");
             retVal = ARGP_ERR_UNKNOWN;
             break;
 
@@ -1063,7 +1433,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                         }
                         else
                         {
-                            sdl_set_message(msgVec,
+                            sdl_set_message(context->msgVec,
                                             1,
                                             SDL_SYMALRDEF,
                                             "-s||--symbol");
@@ -1072,7 +1442,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                     }
                     else
                     {
-                        sdl_set_message(msgVec,
+                        sdl_set_message(context->msgVec,
                                         1,
                                         SDL_ABORT,
                                         "-s||--symbol");
@@ -1081,7 +1451,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
                 }
                 else
                 {
-                    sdl_set_message(msgVec,
+                    sdl_set_message(context->msgVec,
                                     1,
                                     SDL_INVQUAL,
                                     "-s||--symbol");
@@ -1090,7 +1460,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             else
             {
-                sdl_set_message(msgVec,
+                sdl_set_message(context->msgVec,
                                 1,
                                 SDL_INVQUAL,
                                 "-s||--symbol");
@@ -1106,6 +1476,22 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             }
             break;
 
+        case 'u':
+            if (args[ArgUpdate].present == false)
+            {
+                args[ArgUpdate].present = true;
+                args[ArgUpdate].on = true;
+            }
+            else
+            {
+                sdl_set_message(context->msgVec,
+                                1,
+                                SDL_CONFLDUPLQ,
+                                "--update|--noupdate");
+                retVal = EINVAL;
+            }
+            break;
+
         case 'v':
             if ((args[ArgTrace].present == false) ||
                 (args[ArgVerbose].present == false))
@@ -1120,19 +1506,21 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
         case ARGP_KEY_END:
             if (args[ArgLanguage].present == false)
             {
-                sdl_set_message(msgVec, 1, SDL_NOOUTPUT);
+                sdl_set_message(context->msgVec, 1, SDL_NOOUTPUT);
                 retVal = ARGP_ERR_UNKNOWN;
             }
             break;
 
         case ARGP_KEY_NO_ARGS:
-            sdl_set_message(msgVec, 1, SDL_NOOUTPUT);
+            sdl_set_message(context->msgVec, 1, SDL_NOOUTPUT);
             retVal = ARGP_ERR_UNKNOWN;
             break;
 
         case ARGP_KEY_INIT:
             args[ArgAlignment].present = false;
             args[ArgAlignment].value = 0;
+            args[ArgCacheDir].present = false;
+            args[ArgCacheDir].fileName = NULL;
             args[ArgCheckAlignment].present = false;
             args[ArgCheckAlignment].on = false;
             args[ArgComments].present = false;
@@ -1141,10 +1529,20 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             args[ArgCopyright].on = false;
             args[ArgCopyrightFile].present = false;
             args[ArgCopyrightFile].fileName = NULL;
+            args[ArgCounters].present = false;
+            args[ArgCounters].on = false;
+            args[ArgDepend].present = false;
+            args[ArgDepend].on = false;
+            args[ArgDependFile].present = false;
+            args[ArgDependFile].fileName = NULL;
             args[ArgHeader].present = false;
             args[ArgHeader].on = true;
             args[ArgInputFile].present = false;
             args[ArgInputFile].fileName = NULL;
+            args[ArgInputList].present = false;
+            args[ArgInputList].inputs->listUsed = 0;
+            args[ArgJobs].present = false;
+            args[ArgJobs].value = 1;
             args[ArgLanguage].present = false;
             args[ArgListing].present = false;
             args[ArgListing].on = false;
@@ -1152,6 +1550,10 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             args[ArgListingFile].fileName = NULL;
             args[ArgMemberAlign].present = false;
             args[ArgMemberAlign].on = true;
+            args[ArgReplay].present = false;
+            args[ArgReplay].on = false;
+            args[ArgStats].present = false;
+            args[ArgStats].value = SDL_K_STATS_TEXT;
             args[ArgSymbols].present = false;
             args[ArgSymbols].symbol->symbols = NULL;
             args[ArgSymbols].symbol->listSize = 0;
@@ -1164,6 +1566,10 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             args[ArgTraceMemory].on = false;
             args[ArgTrace].present = false;
             args[ArgTrace].on = false;
+            args[ArgUpdate].present = false;
+            args[ArgUpdate].on = false;
+            args[ArgVariant].present = false;
+            args[ArgVariant].variants->listUsed = 0;
             args[ArgVerbose].present = false;
             args[ArgVerbose].on = false;
             args[ArgWordSize].present = false;
@@ -1178,7 +1584,7 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
             break;
 
         default:
-            sdl_set_message(msgVec, 1, SDL_INVQUAL, &key);
+            sdl_set_message(context->msgVec, 1, SDL_INVQUAL, &key);
             retVal = ARGP_ERR_UNKNOWN;
             break;
     }
@@ -1190,167 +1596,1393 @@ static error_t _sdl_parse_opt(int key, char *arg, struct argp_state *state)
 }
 
 /*
- * main
- *  This is the main function called by the image activator.  It initializes
- *  the context, other data, and parses the command line arguments into the
- *  context.
+ * _sdl_add_input
+ *  This function is called to add a file to the list of input files to be
+ *  compiled.  If the file name starts with an '@', then it is a response
+ *  file, and each of the whitespace separated file names in it is added
+ *  instead.
  *
  * Input Parameters:
- *  argc:
- *	A value indicating the number of arguments specified in argv.
- *  argv:
- *	A pointer to an array or strings containing the command line arguments.
+ *  context:
+ *      A pointer to the context structure into which the command line
+ *      arguments are being parsed.
+ *  fileName:
+ *      A pointer to the input file name, or '@' followed by the response file
+ *      name.
  *
  * Output Parameters:
  *  None.
  *
  * Return Values:
- *  0: for success.
- *  1: for failure.
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_INFILOPN:   Unable to open an input or response file.
+ *  SDL_ABORT:      An error occurred allocating memory.
  */
-int main(int argc, char *argv[])
+static uint32_t _sdl_add_input(SDL_CONTEXT *context, char *fileName)
 {
-    FILE            *cfp = NULL;
-    FILE            *fp;
-    char            *msgTxt = NULL;
-    struct tm       *timeInfo;
-    SDL_ARGUMENTS   *args = context.argument;
-    SDL_LANGUAGES   *languages;
-    SDL_SYMBOL_LIST symbols;
-    time_t          localTime;
-    uint32_t        status;
-    int             ii, jj;
-
-    /*
-     * Turn off generating a list file, by default.  It may get set when
-     * parsing the command line arguments.
-     */
-    listing = false;
-    memset(&context, 0, sizeof(SDL_CONTEXT));
-    SDL_Q_INIT(&literal);
-
-    /*
-     * Get the current time as the start time.
-     */
-    localTime = time(NULL);
-    timeInfo = localtime(&localTime);
-    memcpy(&context.runTimeInfo, timeInfo, sizeof(struct tm));
-
-    /*
-     * Initialize the parsing context.
-     */
-    args[ArgLanguage].languages = NULL;
-    args[ArgSymbols].symbol = &symbols;
-    context.processingEnabled = true;
+    SDL_INPUT_LIST *list = context->argument[ArgInputList].inputs;
+    uint32_t retVal = SDL_NORMAL;
 
-    /*
-     * Initialize the dimension array and the options index.
-     */
-    for (ii = 0; ii < SDL_K_MAX_DIMENSIONS; ii++)
+    if (fileName[0] == '@')
     {
-        context.dimensions[ii].inUse = false;
-    }
-
-    /*
-     * Set the options, parameters and languages workspace.
-     */
-    context.options = NULL;
-    context.optionsSize = 0;
-    context.optionsIdx = 0;
-    context.parameters = NULL;
-    context.parameterSize = 0;
-    context.parameterIdx = 0;
-    context.stateStack = NULL;
-    context.stateSize = 0;
-    context.stateIdx = 0;
-    context.langCondList.lang = NULL;
-    context.langCondList.listSize = 0;
-    context.langCondList.listUsed = 0;
-    context.langEnableVec = NULL;
-    context.languagesSpecified = 0;
-
-    /*
-     * Set the message vector to a success value.
-     */
-    sdl_set_message(msgVec, 1, SDL_NORMAL);
+        FILE *fp = fopen(&fileName[1], "r");
+        char name[PATH_MAX];
 
-    /*
-     * Parse out the command line arguments.
-     */
-    status = argp_parse(&argp, argc, argv, 0, 0, &context);
-    if ((status != 0) ||
-        (errno != 0) ||
-        (msgVec[0].msgCode.msgCode != SDL_NORMAL))
-    {
-        status = sdl_get_message(msgVec, &msgTxt);
-        if (status == SDL_NORMAL)
+        if (fp != NULL)
         {
-            fprintf(stderr, errFmt, msgTxt);
+            while ((retVal == SDL_NORMAL) &&
+                   (fscanf(fp, "%4095s", name) == 1))
+            {
+                retVal = _sdl_add_input(context, name);
+            }
+            fclose(fp);
+        }
+        else
+        {
+            retVal = SDL_INFILOPN;
+            sdl_set_message(context->msgVec, 1, retVal, &fileName[1]);
         }
-        sdl_free(msgTxt);
-        return (-1);
     }
 
     /*
-     * Set some global variables that all the other code needs to be aware.
+     * We at least need read access to the file.
      */
-    listing = args[ArgListing].on;
-    if (args[ArgTraceMemory].on == true)
+    else if (access(fileName, R_OK) != 0)
     {
-        sdl_set_trace_memory();
+        retVal = SDL_INFILOPN;
+        sdl_set_message(context->msgVec, 1, retVal, fileName);
     }
-    trace = args[ArgTrace].on;
-    _verbose = (args[ArgVerbose].on ? 1 : 0);
-
-    /*
-     * If tracing is turned on, write out this call (calls only, no returns).
-     */
-    if (trace == true)
+    else
     {
-        printf("%s:%d:main\n", __FILE__, __LINE__);
+        if (list->listUsed >= list->listSize)
+        {
+            char **newFiles;
+
+            newFiles = sdl_realloc(list->files,
+                                   ((list->listSize + SDL_K_INPUT_INCR) *
+                                    sizeof(char *)));
+            if (newFiles != NULL)
+            {
+                list->files = newFiles;
+                list->listSize += SDL_K_INPUT_INCR;
+            }
+            else
+            {
+                retVal = SDL_ABORT;
+                sdl_set_message(context->msgVec, 1, retVal);
+            }
+        }
+        if (retVal == SDL_NORMAL)
+        {
+            list->files[list->listUsed++] = sdl_strdup_heap(fileName);
+        }
     }
 
     /*
-     * We now know the languages for which we are going to be generating output
-     * files.
+     * Return the results back to the caller.
      */
-    languages = args[ArgLanguage].languages;
+    return(retVal);
+}
 
-    /*
-     * Initialize the parsing states.
+/*
+ * _sdl_variant_symbol
+ *  This function is called to add a symbol to the ones for a variant.
+ *
+ * Input Parameters:
+ *  variant:
+ *      A pointer to the variant.
+ *  symbol:
+ *      A pointer to the name of the symbol.  A copy of it is kept.
+ *  length:
+ *      A value indicating the length of the name of the symbol.
+ *  value:
+ *      A value to be given to the symbol.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_SYMALRDEF:  The symbol has already been given a value.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ */
+static uint32_t _sdl_variant_symbol(SDL_VARIANT *variant,
+                                    char *symbol,
+                                    size_t length,
+                                    int value)
+{
+    SDL_SYMBOL_LIST *list = &variant->symbols;
+    uint32_t retVal = SDL_NORMAL;
+    int ii;
+
+    for (ii = 0; ((ii < list->listUsed) && (retVal == SDL_NORMAL)); ii++)
+    {
+        if ((strncmp(list->symbols[ii].symbol, symbol, length) == 0) &&
+            (list->symbols[ii].symbol[length] == '\0'))
+        {
+            retVal = SDL_SYMALRDEF;
+        }
+    }
+    if ((retVal == SDL_NORMAL) && (list->listUsed >= list->listSize))
+    {
+        SDL_SYMBOL *newSymbols;
+
+        newSymbols = sdl_realloc(list->symbols,
+                                 ((list->listSize + 1) * sizeof(SDL_SYMBOL)));
+        if (newSymbols != NULL)
+        {
+            list->symbols = newSymbols;
+            list->listSize++;
+        }
+        else
+        {
+            retVal = SDL_ABORT;
+        }
+    }
+    if (retVal == SDL_NORMAL)
+    {
+        char *name = sdl_calloc(length + 1, 1);
+
+        if (name != NULL)
+        {
+            memcpy(name, symbol, length);
+            list->symbols[list->listUsed].symbol = name;
+            list->symbols[list->listUsed++].value = value;
+        }
+        else
+        {
+            retVal = SDL_ABORT;
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_variant_free
+ *  This function is called to free what was allocated for a variant.
+ *
+ * Input Parameters:
+ *  variant:
+ *      A pointer to the variant.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_variant_free(SDL_VARIANT *variant)
+{
+    int ii;
+
+    for (ii = 0; ii < variant->symbols.listUsed; ii++)
+    {
+        sdl_free(variant->symbols.symbols[ii].symbol);
+    }
+    if (variant->symbols.symbols != NULL)
+    {
+        sdl_free(variant->symbols.symbols);
+    }
+    if (variant->name != NULL)
+    {
+        sdl_free(variant->name);
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_add_variant
+ *  This function is called to add a variant to the list of them.  It is
+ *  specified as the name of the variant, optionally followed by a ':' and a
+ *  comma separated list of b32, b64, align=<value> and <symbol>=<value>.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure into which the command line
+ *      arguments are being parsed.
+ *  arg:
+ *      A pointer to the variant specification.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     Normal Successful Completion.
+ *  SDL_INVQUAL:    The variant specification is not valid.
+ *  SDL_CONFLDUPLQ: A variant with the same name has already been specified.
+ *  SDL_SYMALRDEF:  A symbol has been given a value more than once.
+ *  SDL_INVALIGN:   The alignment is not valid.
+ *  SDL_ABORT:      An error occurred allocating memory.
+ */
+static uint32_t _sdl_add_variant(SDL_CONTEXT *context, char *arg)
+{
+    SDL_VARIANT_LIST *list = context->argument[ArgVariant].variants;
+    SDL_VARIANT *variant;
+    char *option;
+    char *next;
+    size_t nameLen;
+    uint32_t retVal = SDL_NORMAL;
+    int ii;
+
+    /*
+     * The name is made up of the characters that can be put in a file name
+     * without surprises.
+     */
+    nameLen = (arg != NULL) ? strcspn(arg, ":") : 0;
+    if (nameLen == 0)
+    {
+        retVal = SDL_INVQUAL;
+    }
+    for (ii = 0; ((ii < nameLen) && (retVal == SDL_NORMAL)); ii++)
+    {
+        if ((isalnum(arg[ii]) == 0) && (arg[ii] != '_') && (arg[ii] != '-'))
+        {
+            retVal = SDL_INVQUAL;
+        }
+    }
+    for (ii = 0; ((ii < list->listUsed) && (retVal == SDL_NORMAL)); ii++)
+    {
+        if ((strncmp(list->variants[ii].name, arg, nameLen) == 0) &&
+            (list->variants[ii].name[nameLen] == '\0'))
+        {
+            retVal = SDL_CONFLDUPLQ;
+        }
+    }
+    if ((retVal == SDL_NORMAL) && (list->listUsed >= list->listSize))
+    {
+        SDL_VARIANT *newVariants;
+
+        newVariants = sdl_realloc(list->variants,
+                                  ((list->listSize + 1) *
+                                   sizeof(SDL_VARIANT)));
+        if (newVariants != NULL)
+        {
+            list->variants = newVariants;
+            list->listSize++;
+        }
+        else
+        {
+            retVal = SDL_ABORT;
+        }
+    }
+    if (retVal != SDL_NORMAL)
+    {
+        sdl_set_message(context->msgVec, 1, retVal, "--variant");
+        return(retVal);
+    }
+
+    /*
+     * Fill in the variant, starting with what it gets from the rest of the
+     * command line.
+     */
+    variant = &list->variants[list->listUsed];
+    memset(variant, 0, sizeof(SDL_VARIANT));
+    variant->wordSize = 0;
+    variant->alignment = -1;
+    variant->name = sdl_calloc(nameLen + 1, 1);
+    if (variant->name == NULL)
+    {
+        retVal = SDL_ABORT;
+    }
+    else
+    {
+        memcpy(variant->name, arg, nameLen);
+    }
+    option = (arg[nameLen] == ':') ? &arg[nameLen + 1] : NULL;
+    while ((option != NULL) && (retVal == SDL_NORMAL))
+    {
+        size_t optLen = strcspn(option, ",");
+        char *equals = memchr(option, '=', optLen);
+
+        next = (option[optLen] == ',') ? &option[optLen + 1] : NULL;
+        if ((optLen == 3) && (strncasecmp(option, "b32", 3) == 0))
+        {
+            variant->wordSize = 32;
+        }
+        else if ((optLen == 3) && (strncasecmp(option, "b64", 3) == 0))
+        {
+            variant->wordSize = 64;
+        }
+        else if ((equals == NULL) || (equals == option))
+        {
+            retVal = SDL_INVQUAL;
+        }
+        else if (((equals - option) == 5) &&
+                 (strncasecmp(option, "align", 5) == 0))
+        {
+            if ((optLen != 7) || (strchr("01248", equals[1]) == NULL))
+            {
+                retVal = SDL_INVALIGN;
+            }
+            else
+            {
+                variant->alignment = equals[1] - '0';
+            }
+        }
+        else
+        {
+            retVal = _sdl_variant_symbol(variant,
+                                         option,
+                                         (equals - option),
+                                         strtol(&equals[1], NULL, 10));
+        }
+        option = next;
+    }
+
+    /*
+     * If the variant is good, then keep it.  Otherwise, free what there is
+     * of it.
+     */
+    if (retVal == SDL_NORMAL)
+    {
+        list->listUsed++;
+    }
+    else
+    {
+        _sdl_variant_free(variant);
+        if (retVal == SDL_INVALIGN)
+        {
+            sdl_set_message(context->msgVec, 1, retVal);
+        }
+        else
+        {
+            sdl_set_message(context->msgVec, 1, retVal, "--variant");
+        }
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_variant_file
+ *  This function is called to get the name of an output file for a variant,
+ *  which has '_' and the name of the variant added ahead of the file
+ *  extension of the name it would otherwise have.
+ *
+ * Input Parameters:
+ *  fileName:
+ *      A pointer to the name of the output file.
+ *  variant:
+ *      A pointer to the variant.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL:       An error occurred allocating memory.
+ *  !NULL:      A pointer to the name of the output file for the variant,
+ *              which is to be freed by calling sdl_free.
+ */
+static char *_sdl_variant_file(char *fileName, SDL_VARIANT *variant)
+{
+    char *retVal;
+    char *dot = strrchr(fileName, '.');
+    char *slash = strrchr(fileName, '/');
+    size_t baseLen;
+
+    if ((dot == NULL) || ((slash != NULL) && (dot < slash)))
+    {
+        baseLen = strlen(fileName);
+    }
+    else
+    {
+        baseLen = dot - fileName;
+    }
+    retVal = sdl_calloc(strlen(fileName) + strlen(variant->name) + 2, 1);
+    if (retVal != NULL)
+    {
+        memcpy(retVal, fileName, baseLen);
+        retVal[baseLen] = '_';
+        strcpy(&retVal[baseLen + 1], variant->name);
+        strcat(retVal, &fileName[baseLen]);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_report
+ *  This function is called to write out the message currently in the message
+ *  vector of a context to the context's error file.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure containing the message vector.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_report(SDL_CONTEXT *context)
+{
+    char *msgTxt = NULL;
+
+    if (sdl_get_message(context->msgVec, &msgTxt) == SDL_NORMAL)
+    {
+        fprintf(context->errFP, errFmt, msgTxt);
+    }
+    if (msgTxt != NULL)
+    {
+        sdl_free(msgTxt);
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_compile_variant
+ *  This function is called to compile a single input file, or one variant of
+ *  it.  A context of its own is created for the input file from the context
+ *  into which the command line arguments were parsed, so that this function
+ *  can be called for more than one input file at a time, each on its own
+ *  thread.  For a variant, the symbols, word size and alignment are the
+ *  variant's, the output file names have its name added to them, and the
+ *  input file is parsed from the recording of its tokens, which is made by
+ *  the first variant that needs it.
+ *
+ * Input Parameters:
+ *  options:
+ *      A pointer to the context structure into which the command line
+ *      arguments were parsed.  This is not modified.
+ *  fileName:
+ *      A pointer to the name of the input file to be compiled.
+ *  errFP:
+ *      A pointer to the file to which the diagnostics for this input file are
+ *      to be written.
+ *  variant:
+ *      A pointer to the variant to be compiled, or NULL to compile the input
+ *      file without one.
+ *  tape:
+ *      A pointer to the location of the recording of the tokens in the input
+ *      file, which is NULL until it has been made.  This is NULL if there are
+ *      no variants.
+ *
+ * Output Parameters:
+ *  tape:
+ *      A pointer to the location to receive the recording of the tokens, if
+ *      this variant made it.
+ *
+ * Return Values:
+ *  0:      The input file was compiled.
+ *  -1:     An error occurred, which has been written to errFP.
+ */
+static int _sdl_compile_variant(SDL_CONTEXT *options,
+                                char *fileName,
+                                FILE *errFP,
+                                SDL_VARIANT *variant,
+                                struct _sdl_tape **tape)
+{
+    SDL_CONTEXT     *context;
+    SDL_ARGUMENTS   *args;
+    SDL_LANGUAGES   *languages;
+    SDL_CACHE_KEY   cacheKey;
+    SDL_STATS       *prevStats = NULL;
+    FILE            *cfp = NULL;
+    FILE            *fp = NULL;
+    FILE            *diagFP = NULL;
+    char            **outFileName;
+    char            **tmpFileName;
+    char            *listFileName = NULL;
+    char            *cacheDir = NULL;
+    char            *diagBuf = NULL;
+    size_t          diagLen = 0;
+    struct tm       timeInfo;
+    uint32_t        status;
+    uint32_t        parseStatus = SDL_NORMAL;
+    int             retVal = 0;
+    bool            cached = false;
+    int             ii, jj;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("_sdl_compile_variant");
+
+    context = sdl_calloc(1, sizeof(SDL_CONTEXT));
+    outFileName = sdl_calloc(options->languagesSpecified + 1, sizeof(char *));
+    tmpFileName = sdl_calloc(options->languagesSpecified + 1, sizeof(char *));
+    if ((context == NULL) || (outFileName == NULL) || (tmpFileName == NULL))
+    {
+        fprintf(errFP,
+                "%%SDL-F-ABORT, Fatal internal error. Unable to continue "
+                "execution\n-SYSTEM-E-ENOMEM, Not enough space\n");
+        if (context != NULL)
+        {
+            sdl_free(context);
+        }
+        if (outFileName != NULL)
+        {
+            sdl_free(outFileName);
+        }
+        if (tmpFileName != NULL)
+        {
+            sdl_free(tmpFileName);
+        }
+        return(-1);
+    }
+
+    /*
+     * Initialize the parsing context, starting with the command line
+     * arguments.
+     */
+    memcpy(context->argument, options->argument, sizeof(context->argument));
+    memcpy(&context->runTimeInfo, &options->runTimeInfo, sizeof(struct tm));
+    args = context->argument;
+    args[ArgInputFile].present = true;
+    args[ArgInputFile].fileName = fileName;
+    if (variant != NULL)
+    {
+        args[ArgSymbols].present = (variant->symbols.listUsed > 0);
+        args[ArgSymbols].symbol = &variant->symbols;
+        if (variant->wordSize != 0)
+        {
+            args[ArgWordSize].present = true;
+            args[ArgWordSize].value = variant->wordSize;
+        }
+        if (variant->alignment >= 0)
+        {
+            args[ArgAlignment].present = true;
+            args[ArgAlignment].value = variant->alignment;
+        }
+    }
+    languages = args[ArgLanguage].languages;
+    context->errFP = errFP;
+    context->languagesSpecified = options->languagesSpecified;
+
+    /*
+     * If statistics were asked for, gather them for this input file (and
+     * variant) from here on.
+     */
+    if (args[ArgStats].present == true)
+    {
+        if (sdl_stats_init(&context->stats, sdl_plugin_count()) == true)
+        {
+            for (ii = 0; ii < context->stats.langCount; ii++)
+            {
+                context->stats.lang[ii].name = sdl_plugin_lang(ii);
+            }
+        }
+        prevStats = sdl_stats_set(&context->stats);
+    }
+
+    /*
+     * If the output cache is being used, the diagnostics are collected in
+     * memory, so that they can be put in the cache with the output files.
+     * The cache is not used when there is a listing file.
+     */
+    if ((args[ArgCacheDir].present == true) &&
+        (args[ArgListing].on == false))
+    {
+        diagFP = open_memstream(&diagBuf, &diagLen);
+        if (diagFP != NULL)
+        {
+            cacheDir = args[ArgCacheDir].fileName;
+            context->errFP = diagFP;
+        }
+    }
+
+    /*
+     * Initialize the parsing states and the context queues.
+     */
+    if (sdl_context_init(context, sdl_plugin_count()) != SDL_NORMAL)
+    {
+        fprintf(errFP,
+                "%%SDL-F-ABORT, Fatal internal error. Unable to continue "
+                "execution\n-SYSTEM-E-ENOMEM, Not enough space\n");
+        retVal = -1;
+    }
+
+    /*
+     * Open the input file or reading.
+     */
+    else if ((fp = fopen(fileName, "r")) == NULL)
+    {
+        status = sdl_set_message(context->msgVec,
+                                 2,
+                                 SDL_INFILOPN,
+                                 fileName,
+                                 errno);
+        if (status == SDL_NORMAL)
+        {
+            _sdl_report(context);
+        }
+        retVal = -1;
+    }
+
+    /*
+     * If the user indicated that they wanted the copyright information at the
+     * start of the file, then open it for read.  A recording already has it.
+     */
+    if ((retVal == 0) &&
+        (args[ArgCopyright].on == true) &&
+        (args[ArgReplay].on == false))
+    {
+        if (args[ArgCopyrightFile].present == false)
+        {
+            status = sdl_set_message(context->msgVec, 1, SDL_NOCOPYFIL);
+            if (status == SDL_NORMAL)
+            {
+                _sdl_report(context);
+            }
+            retVal = -1;
+        }
+        else if ((cfp = fopen(args[ArgCopyrightFile].fileName,
+                              "r")) == NULL)
+        {
+            status = sdl_set_message(context->msgVec,
+                                     2,
+                                     SDL_INFILOPN,
+                                     args[ArgCopyrightFile].fileName,
+                                     errno);
+            if (status == SDL_NORMAL)
+            {
+                _sdl_report(context);
+            }
+            retVal = -1;
+        }
+    }
+
+    /*
+     * Loop through each of the supported languages, getting the name of the
+     * output file for each.
+     */
+    for (ii = 0; ((ii < context->languagesSpecified) && (retVal == 0)); ii++)
+    {
+        if (languages[ii].outFileName == NULL)
+        {
+            bool addDot = false;
+
+            /*
+             * Go find the last '.' in the file name, this will be where the
+             * file extension starts.
+             */
+            for (jj = strlen(fileName); jj >= 0; jj--)
+            {
+                if (fileName[jj] == '.')
+                {
+                    jj++;
+                    break;
+                }
+            }
+
+            /*
+             * If we ended up at the beginning of the file, then there was no
+             * file extension specified.  Use the whole filename.
+             */
+            if (jj <= 0)
+            {
+                jj = strlen(fileName);
+                addDot = true;
+            }
+
+            /*
+             * Now allocate a buffer large enough for the file name,
+             * extension, and null terminator.
+             */
+            outFileName[ii] =
+                    sdl_calloc((jj + strlen(languages[ii].extension) + 2), 1);
+
+            /*
+             * Copy the extension for this language after the last '.' (or
+             * the one just added).
+             */
+            strncpy(outFileName[ii], fileName, jj);
+            if (addDot == true)
+            {
+                outFileName[ii][jj++] = '.';
+            }
+            strcpy(&outFileName[ii][jj], languages[ii].extension);
+        }
+        else
+        {
+            outFileName[ii] = sdl_strdup_heap(languages[ii].outFileName);
+        }
+
+        /*
+         * A variant has its name added to the file name.
+         */
+        if ((variant != NULL) && (outFileName[ii] != NULL))
+        {
+            char *variantName = _sdl_variant_file(outFileName[ii], variant);
+
+            sdl_free(outFileName[ii]);
+            outFileName[ii] = variantName;
+        }
+        if (outFileName[ii] == NULL)
+        {
+            fprintf(errFP,
+                    "%%SDL-F-ABORT, Fatal internal error. Unable to continue "
+                    "execution\n-SYSTEM-E-ENOMEM, Not enough space\n");
+            retVal = -1;
+        }
+    }
+
+    /*
+     * If the output files are in the cache, then they have been written and
+     * there is nothing left to do.
+     */
+    if ((retVal == 0) && (cacheDir != NULL))
+    {
+        if (sdl_cache_key(context, fileName, cacheKey) == SDL_NORMAL)
+        {
+            cached = sdl_cache_fetch(cacheDir, cacheKey, context, outFileName);
+        }
+        else
+        {
+            cacheDir = NULL;
+        }
+    }
+
+    /*
+     * Loop through each of the supported languages, opening the output file
+     * for each.
+     */
+    for (ii = 0;
+         ((ii < context->languagesSpecified) &&
+          (retVal == 0) &&
+          (cached == false));
+         ii++)
+    {
+        FILE *outFP;
+
+        /*
+         * Try and open the file for this language.  If it fails, we are
+         * done.  In update mode, this is a temporary file.
+         */
+        outFP = sdl_output_open(outFileName[ii],
+                                args[ArgUpdate].on,
+                                &tmpFileName[ii]);
+        if (outFP == NULL)
+        {
+            status = sdl_set_message(context->msgVec,
+                                     2,
+                                     SDL_OUTFILOPN,
+                                     outFileName[ii],
+                                     errno);
+            if (status == SDL_NORMAL)
+            {
+                _sdl_report(context);
+            }
+            retVal = -1;
+        }
+        else
+        {
+            status = sdl_load_fp(context, languages[ii].langVal, outFP);
+            if (status != SDL_NORMAL)
+            {
+                _sdl_report(context);
+                fclose(outFP);
+                retVal = -1;
+            }
+            else
+            {
+                context->langEnableVec[languages[ii].langVal] = true;
+            }
+        }
+    }
+    if ((retVal == 0) &&
+        (cached == false) &&
+        (args[ArgHeader].on == true) &&
+        (args[ArgReplay].on == false))
+    {
+
+        struct stat fileStats;
+
+        /*
+         * OK, we successfully opened the files.  Insert the header
+         * comments.  First starting with a row of '*'s, then information
+         * about OpenSDL, then information about the file we are about to
+         * parse, and finally another row of '*'s.  In update mode, the time
+         * the output was created is the time the input file was modified,
+         * so that an output file generated again from the same input file
+         * is the same, and is left alone.
+         */
+        context->inputPath = realpath(fileName, NULL);
+        if (context->inputPath == NULL)
+        {
+            context->inputPath = strdup(fileName);
+        }
+        if (stat(context->inputPath, &fileStats) != 0)
+        {
+            memset(&timeInfo, 0, sizeof(struct tm));
+            timeInfo.tm_year = -42;
+            timeInfo.tm_mon = 10;
+            timeInfo.tm_mday = 17;
+        }
+        else
+        {
+            localtime_r(&fileStats.st_mtime, &timeInfo);
+        }
+        memcpy(&context->inputTimeInfo, &timeInfo, sizeof(struct tm));
+        sdl_stats_begin(PhaseEmit);
+        status = sdl_call_commentStars(context->langEnableVec);
+        if (status == SDL_NORMAL)
+        {
+            status = sdl_call_createdByInfo(context->langEnableVec,
+                                            (args[ArgUpdate].on == true) ?
+                                                &context->inputTimeInfo :
+                                                &context->runTimeInfo);
+        }
+        if (status == SDL_NORMAL)
+        {
+            status = sdl_call_fileInfo(context->langEnableVec,
+                                       &context->inputTimeInfo,
+                                       context->inputPath);
+        }
+        if (status == SDL_NORMAL)
+        {
+            status = sdl_call_commentStars(context->langEnableVec);
+        }
+        sdl_stats_end();
+        if (status != SDL_NORMAL)
+        {
+            _sdl_report(context);
+            retVal = -1;
+        }
+    }
+
+    /*
+     * A recording is replayed, in place of parsing the input file, with the
+     * header and copyright that were recorded.
+     */
+    if ((retVal == 0) && (cached == false) && (args[ArgReplay].on == true))
+    {
+        parseStatus = sdl_replay_file(context, fp);
+        if (parseStatus != SDL_NORMAL)
+        {
+            _sdl_report(context);
+            retVal = -1;
+        }
+    }
+    else if ((retVal == 0) && (cached == false))
+    {
+        SDL_Q_INIT(&context->locals);
+        sdl_symtab_reset(&context->localSymtab);
+        context->module = NULL;
+        context->ident = NULL;
+
+        /*
+         * If the copyright needs to be put into the file, then do so now.
+         */
+        if (cfp != NULL)
+        {
+            parseStatus = sdl_parse_file(context, cfp);
+        }
+
+        /*
+         * If we are being asked to create a listing file, then do so now.
+         */
+        if (args[ArgListing].on == true)
+        {
+
+            /*
+             * If the listing file name was not specified by the user, then
+             * generate one from the input file, using '.lis' as the file
+             * extension.
+             */
+            if (args[ArgListingFile].present == false)
+            {
+                for (ii = strlen(fileName); ii >= 0; ii--)
+                {
+                    if (fileName[ii] == '.')
+                    {
+                        break;
+                    }
+                }
+                if (ii <= 0)
+                {
+                    ii = strlen(fileName);
+                }
+                listFileName = sdl_calloc(ii + 5, 1);
+                strncpy(listFileName, fileName, ii);
+                strcpy(&listFileName[ii], ".lis");
+                args[ArgListingFile].fileName = listFileName;
+            }
+
+            /*
+             * Before we begin parsing the input file, open the listing file.
+             */
+            sdl_open_list(context);
+        }
+
+        /*
+         * Start parsing the real input file.  For a variant, it is parsed
+         * from the recording of its tokens, which is made first if this is
+         * the first variant to need it.
+         */
+        if (tape == NULL)
+        {
+            status = sdl_parse_file(context, fp);
+        }
+        else
+        {
+            status = SDL_NORMAL;
+            if (*tape == NULL)
+            {
+                status = sdl_tape_record(context, fp, tape);
+            }
+            if (status == SDL_NORMAL)
+            {
+                status = sdl_parse_tape(context, *tape);
+            }
+        }
+        if (parseStatus == SDL_NORMAL)
+        {
+            parseStatus = status;
+        }
+
+        /*
+         * If were asked to create a listing file, then close it now.
+         */
+        if (context->listing.on == true)
+        {
+            sdl_close_list(context);
+        }
+    }
+
+    /*
+     * Go close all the output files.  This is when the output is actually
+     * written out, so it can fail.
      */
-    context.state = Initial;
-    context.condState.state = sdl_calloc(SDL_K_COND_STATE_SIZE,
-                                         sizeof(SDL_COND_STATES));
-    context.condState.state[0] = CondNone;
-    context.condState.top = 0;
-    context.condState.bottom = SDL_K_COND_STATE_SIZE;
-    context.langEnableVec = sdl_calloc(context.languagesSpecified, sizeof(bool));
+    sdl_stats_begin(PhaseEmit);
+    status = sdl_call_close();
+    sdl_stats_end();
+    if (status != SDL_NORMAL)
+    {
+        _sdl_report(context);
+        retVal = -1;
+    }
+    if (trace == true)
+    {
+        fprintf(stderr, "'%s' has been processed\n", fileName);
+    }
 
     /*
-     * Initialize the context queues.
+     * In update mode, replace each output file that has changed.
      */
-    SDL_Q_INIT(&context.locals);
-    SDL_Q_INIT(&context.constants);
-    SDL_Q_INIT(&context.declares.header);
-    context.declares.nextID = SDL_K_DECLARE_MIN;
-    SDL_Q_INIT(&context.items.header);
-    context.items.nextID = SDL_K_ITEM_MIN;
-    SDL_Q_INIT(&context.aggregates.header);
-    context.aggregates.nextID = SDL_K_AGGREGATE_MIN;
-    SDL_Q_INIT(&context.enums.header);
-    context.enums.nextID = SDL_K_ENUM_MIN;
-    SDL_Q_INIT(&context.entries);
-
-    if (args[ArgInputFile].present == false)
-    {
-        status = sdl_set_message(msgVec,
-                                 1,
-                                 SDL_NOINPFIL);
-        if (status == SDL_NORMAL)
+    for (ii = 0; ii < context->languagesSpecified; ii++)
+    {
+        if ((tmpFileName[ii] != NULL) &&
+            (sdl_output_commit(outFileName[ii],
+                               tmpFileName[ii]) != SDL_NORMAL))
+        {
+            status = sdl_set_message(context->msgVec,
+                                     2,
+                                     SDL_OUTFILOPN,
+                                     outFileName[ii],
+                                     errno);
+            if (status == SDL_NORMAL)
+            {
+                _sdl_report(context);
+            }
+            retVal = -1;
+        }
+    }
+
+    /*
+     * If asked for, write the dependency file, now that all the INCLUDE files
+     * are known.
+     */
+    if ((retVal == 0) && (args[ArgDepend].on == true))
+    {
+        char *depFileName = args[ArgDependFile].fileName;
+        char *depBuf = NULL;
+
+        /*
+         * If the dependency file name was not specified by the user, then
+         * generate one from the input file.
+         */
+        if (args[ArgDependFile].present == false)
+        {
+            for (ii = strlen(fileName); ii >= 0; ii--)
+            {
+                if (fileName[ii] == '.')
+                {
+                    break;
+                }
+            }
+            if (ii <= 0)
+            {
+                ii = strlen(fileName);
+            }
+            depBuf = sdl_calloc(ii + 4, 1);
+            if (depBuf != NULL)
+            {
+                strncpy(depBuf, fileName, ii);
+                strcpy(&depBuf[ii], ".d");
+            }
+            depFileName = depBuf;
+        }
+        if ((variant != NULL) && (depFileName != NULL))
+        {
+            char *variantName = _sdl_variant_file(depFileName, variant);
+
+            if (depBuf != NULL)
+            {
+                sdl_free(depBuf);
+            }
+            depBuf = variantName;
+            depFileName = depBuf;
+        }
+        if ((depFileName == NULL) ||
+            (sdl_output_depfile(context,
+                                depFileName,
+                                fileName,
+                                outFileName) != SDL_NORMAL))
+        {
+            status = sdl_set_message(context->msgVec,
+                                     2,
+                                     SDL_OUTFILOPN,
+                                     (depFileName != NULL) ?
+                                         depFileName : fileName,
+                                     errno);
+            if (status == SDL_NORMAL)
+            {
+                _sdl_report(context);
+            }
+            retVal = -1;
+        }
+        if (depBuf != NULL)
+        {
+            sdl_free(depBuf);
+        }
+    }
+
+    /*
+     * If the input file was compiled without error, put the output files and
+     * the diagnostics in the cache.  Then write out the diagnostics.  Not
+     * being able to put them in the cache is not an error.
+     */
+    if (diagFP != NULL)
+    {
+        fclose(diagFP);
+        context->errFP = errFP;
+        if ((cacheDir != NULL) &&
+            (cached == false) &&
+            (retVal == 0) &&
+            (parseStatus == SDL_NORMAL))
+        {
+            sdl_cache_store(cacheDir,
+                            cacheKey,
+                            context,
+                            outFileName,
+                            diagBuf,
+                            diagLen);
+        }
+        if (diagBuf != NULL)
+        {
+            fwrite(diagBuf, 1, diagLen, errFP);
+            free(diagBuf);
+        }
+    }
+
+    /*
+     * If statistics were being gathered, write them out after the
+     * diagnostics.  The bytes written for each language are the size of its
+     * output file, wherever it came from.
+     */
+    if (args[ArgStats].present == true)
+    {
+        char *statsName = NULL;
+
+        sdl_stats_finish(&context->stats);
+        for (ii = 0;
+             ((ii < context->languagesSpecified) &&
+              (context->stats.lang != NULL));
+             ii++)
+        {
+            struct stat fileStats;
+
+            if ((outFileName[ii] != NULL) &&
+                (stat(outFileName[ii], &fileStats) == 0))
+            {
+                context->stats.lang[languages[ii].langVal].bytes =
+                    fileStats.st_size;
+            }
+        }
+        if (variant != NULL)
+        {
+            statsName = _sdl_variant_file(fileName, variant);
+        }
+        sdl_stats_write(errFP,
+                        &context->stats,
+                        (statsName != NULL) ? statsName : fileName,
+                        args[ArgStats].value == SDL_K_STATS_JSON);
+        if (statsName != NULL)
+        {
+            sdl_free(statsName);
+        }
+        sdl_stats_free(&context->stats);
+        sdl_stats_set(prevStats);
+    }
+
+    /*
+     * Clean-up memory, starting with what is left in the arena from the last
+     * MODULE.
+     */
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+    if (cfp != NULL)
+    {
+        fclose(cfp);
+    }
+    sdl_context_free(context);
+    for (ii = 0; ii < context->languagesSpecified; ii++)
+    {
+        if (outFileName[ii] != NULL)
+        {
+            sdl_free(outFileName[ii]);
+        }
+    }
+    sdl_free(outFileName);
+    sdl_free(tmpFileName);
+    if (listFileName != NULL)
+    {
+        sdl_free(listFileName);
+    }
+    sdl_free(context);
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_compile
+ *  This function is called to compile a single input file.  If variants were
+ *  specified, the input file itself, and then each of them, is compiled in
+ *  turn, on the calling thread, from a single scan of the input file.  Only
+ *  the scan is shared, since what is parsed depends on the symbols, and the
+ *  layout on the word size and alignment.
+ *
+ * Input Parameters:
+ *  options:
+ *      A pointer to the context structure into which the command line
+ *      arguments were parsed.  This is not modified.
+ *  fileName:
+ *      A pointer to the name of the input file to be compiled.
+ *  errFP:
+ *      A pointer to the file to which the diagnostics for this input file are
+ *      to be written.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  0:      The input file was compiled.
+ *  -1:     An error occurred, which has been written to errFP.
+ */
+static int _sdl_compile(SDL_CONTEXT *options, char *fileName, FILE *errFP)
+{
+    SDL_ARGUMENTS *args = options->argument;
+    struct _sdl_tape *tape = NULL;
+    int retVal = 0;
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("_sdl_compile");
+
+    if (args[ArgVariant].present == false)
+    {
+        retVal = _sdl_compile_variant(options, fileName, errFP, NULL, NULL);
+    }
+    else
+    {
+        retVal = _sdl_compile_variant(options, fileName, errFP, NULL, &tape);
+        for (ii = 0; ii < args[ArgVariant].variants->listUsed; ii++)
+        {
+            if (_sdl_compile_variant(options,
+                                     fileName,
+                                     errFP,
+                                     &args[ArgVariant].variants->variants[ii],
+                                     &tape) != 0)
+            {
+                retVal = -1;
+            }
+        }
+        sdl_tape_free(tape);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_worker
+ *  This function is the start routine for each of the worker threads.  It
+ *  compiles the next input file that no other worker has started on, until
+ *  there are none left.  The diagnostics for each input file are collected in
+ *  memory, so that the main thread can write them out in the order the input
+ *  files were specified.
+ *
+ * Input Parameters:
+ *  arg:
+ *      A pointer to the context structure into which the command line
+ *      arguments were parsed.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL.
+ */
+static void *_sdl_worker(void *arg)
+{
+    SDL_CONTEXT *options = (SDL_CONTEXT *) arg;
+    bool done = false;
+
+    while (done == false)
+    {
+        SDL_COMPILE_JOB *job = NULL;
+        FILE *errFP;
+
+        pthread_mutex_lock(&_sdl_job_mutex);
+        if (_sdl_job_next < _sdl_job_count)
+        {
+            job = &_sdl_jobs[_sdl_job_next++];
+        }
+        pthread_mutex_unlock(&_sdl_job_mutex);
+        if (job != NULL)
+        {
+            errFP = open_memstream(&job->errBuf, &job->errLen);
+            if (errFP != NULL)
+            {
+                job->retVal = _sdl_compile(options, job->fileName, errFP);
+                fclose(errFP);
+            }
+            else
+            {
+                job->retVal = _sdl_compile(options, job->fileName, stderr);
+            }
+            pthread_mutex_lock(&_sdl_job_mutex);
+            job->done = true;
+            pthread_cond_broadcast(&_sdl_job_done);
+            pthread_mutex_unlock(&_sdl_job_mutex);
+        }
+        else
         {
-            status = sdl_get_message(msgVec, &msgTxt);
+            done = true;
         }
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return(NULL);
+}
+
+/*
+ * _sdl_main
+ *  This function is called to run a command line.  It initializes the
+ *  context, other data, and parses the command line arguments into the
+ *  context.  Each of the input files is then compiled, either one after the
+ *  other, or across a pool of worker threads when -j specifies more than one.
+ *  The compile server calls this, in a child process, for each request.
+ *
+ * Input Parameters:
+ *  argc:
+ *	A value indicating the number of arguments specified in argv.
+ *  argv:
+ *	A pointer to an array or strings containing the command line arguments.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  0: for success.
+ *  1: for failure.
+ */
+static int _sdl_main(int argc, char *argv[])
+{
+    char            *msgTxt = NULL;
+    struct tm       *timeInfo;
+    SDL_ARGUMENTS   *args = context.argument;
+    SDL_LANGUAGES   *languages;
+    SDL_SYMBOL_LIST symbols;
+    SDL_INPUT_LIST  inputs;
+    SDL_VARIANT_LIST variants;
+    pthread_t       *workers = NULL;
+    time_t          localTime;
+    uint32_t        status;
+    int             retVal = 0;
+    int             jobs;
+    int             ii;
+
+    /*
+     * Start with a clean context.  This also turns off generating a list file,
+     * by default.  It may get set when parsing the command line arguments.
+     */
+    memset(&context, 0, sizeof(SDL_CONTEXT));
+    memset(&inputs, 0, sizeof(SDL_INPUT_LIST));
+    memset(&variants, 0, sizeof(SDL_VARIANT_LIST));
+    context.errFP = stderr;
+
+    /*
+     * The statistics for the whole run are always gathered, as we do not yet
+     * know whether they were asked for.  They are only written out if they
+     * were.
+     */
+    sdl_stats_init(&context.stats, 0);
+    sdl_stats_set(&context.stats);
+
+    /*
+     * Get the current time as the start time.
+     */
+    localTime = time(NULL);
+    timeInfo = localtime(&localTime);
+    memcpy(&context.runTimeInfo, timeInfo, sizeof(struct tm));
+
+    /*
+     * Initialize the parsing context.
+     */
+    args[ArgLanguage].languages = NULL;
+    args[ArgSymbols].symbol = &symbols;
+    args[ArgInputList].inputs = &inputs;
+    args[ArgVariant].variants = &variants;
+    context.languagesSpecified = 0;
+
+    /*
+     * Set the message vector to a success value.
+     */
+    sdl_set_message(context.msgVec, 1, SDL_NORMAL);
+
+    /*
+     * Parse out the command line arguments.
+     */
+    sdl_stats_begin(PhaseOptions);
+    status = argp_parse(&argp, argc, argv, 0, 0, &context);
+    sdl_stats_end();
+    if ((status != 0) ||
+        (errno != 0) ||
+        (context.msgVec[0].msgCode.msgCode != SDL_NORMAL))
+    {
+        status = sdl_get_message(context.msgVec, &msgTxt);
         if (status == SDL_NORMAL)
         {
             fprintf(stderr, errFmt, msgTxt);
@@ -1360,376 +2992,235 @@ int main(int argc, char *argv[])
     }
 
     /*
-     * Open the input file or reading.
+     * Set some global variables that all the other code needs to be aware.
+     */
+    if (args[ArgTraceMemory].on == true)
+    {
+        sdl_set_trace_memory();
+    }
+    if (args[ArgCounters].on == true)
+    {
+        sdl_stats_counters();
+    }
+    trace = args[ArgTrace].on;
+    _verbose = (args[ArgVerbose].on ? 1 : 0);
+#ifdef SDL_TRACE_ENABLED
+    if (trace == true)
+    {
+        sdl_trace_init(SDL_K_TRACE_FILE);
+    }
+#endif
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("main");
+
+    /*
+     * We now know the languages for which we are going to be generating output
+     * files.
      */
-    if ((fp = fopen(args[ArgInputFile].fileName, "r")) == NULL)
+    languages = args[ArgLanguage].languages;
+
+    if (inputs.listUsed == 0)
     {
-        status = sdl_set_message(msgVec,
-                                 2,
-                                 SDL_INFILOPN,
-                                 args[ArgInputFile].fileName,
-                                 errno);
-        if (status == SDL_NORMAL)
-        {
-            status = sdl_get_message(msgVec, &msgTxt);
-        }
+        status = sdl_set_message(context.msgVec,
+                                 1,
+                                 SDL_NOINPFIL);
         if (status == SDL_NORMAL)
         {
-            fprintf(stderr, errFmt, msgTxt);
+            _sdl_report(&context);
         }
-        sdl_free(msgTxt);
         return (-1);
     }
 
     /*
-     * If the user indicated that they wanted the copyright information at the
-     * start of the file, then open it for read.
+     * An output or listing file name can only be specified when there is
+     * just one input file.
      */
-    if (args[ArgCopyright].on == true)
+    if (inputs.listUsed > 1)
     {
-        if (args[ArgCopyrightFile].present == false)
+        bool named = args[ArgListingFile].present ||
+                     args[ArgDependFile].present;
+
+        for (ii = 0; ii < context.languagesSpecified; ii++)
         {
-            status = sdl_set_message(msgVec, 1, SDL_NOCOPYFIL);
-            if (status == SDL_NORMAL)
+            if (languages[ii].outFileName != NULL)
             {
-                status = sdl_get_message(msgVec, &msgTxt);
-            }
-            if (status == SDL_NORMAL)
-            {
-                fprintf(stderr, errFmt, msgTxt);
+                named = true;
             }
         }
-        else if ((cfp = fopen(args[ArgCopyrightFile].fileName,
-                              "r")) == NULL)
+        if (named == true)
         {
-            status = sdl_set_message(msgVec,
-                                     2,
-                                     SDL_INFILOPN,
-                                     args[ArgCopyrightFile].fileName,
-                                     errno);
-            if (status == SDL_NORMAL)
-            {
-                status = sdl_get_message(msgVec, &msgTxt);
-            }
+            status = sdl_set_message(context.msgVec,
+                                     1,
+                                     SDL_CONFLDUPLQ,
+                                     "multiple input files and a filespec");
             if (status == SDL_NORMAL)
             {
-                fprintf(stderr, errFmt, msgTxt);
+                _sdl_report(&context);
             }
-        }
-        if (msgTxt != NULL)
-        {
-            sdl_free(msgTxt);
             return (-1);
         }
     }
 
     /*
-     * Loop through each of the supported languages.
+     * Variants are parsed from a recording of the tokens, which a listing
+     * file cannot be made from, and a recording of the output has nothing
+     * for them to change.  Each variant gets the symbols from the rest of
+     * the command line that it does not give a value itself.
      */
-    for (ii = 0; ii < context.languagesSpecified; ii++)
+    if (args[ArgVariant].present == true)
     {
-        FILE *outFP;
-
-        if (languages[ii].outFileName == NULL)
-        {
-            bool addDot = false;
-
-            /*
-             * Go find the last '.' in the file name, this will be where the
-             * file extension starts.
-             */
-            for (jj = strlen(context.argument[ArgInputFile].fileName);
-                 jj >= 0;
-                 jj--)
-            {
-                if (context.argument[ArgInputFile].fileName[jj] == '.')
-                {
-                    jj++;
-                    break;
-                }
-            }
-
-            /*
-             * If we ended up at the beginning of the file, then there was no
-             * file extension specified.  Use the whole filename.
-             */
-            if (jj <= 0)
-            {
-                jj = strlen(args[ArgInputFile].fileName);
-                addDot = true;
-            }
-
-            /*
-             * Now allocate a buffer large enough for the file name,
-             * extension, and null terminator.
-             */
-            languages[ii].outFileName =
-                    sdl_calloc((jj + strlen(languages[ii].extension) + 2), 1);
-
-            /*
-             * Copy the extension for this language after the last '.' (or
-             * the one just added).
-             */
-            strncpy(languages[ii].outFileName, args[ArgInputFile].fileName, jj);
-            if (addDot == true)
-            {
-                languages[ii].outFileName[jj++] = '.';
-            }
-            strcpy(&languages[ii].outFileName[jj],
-                   languages[ii].extension);
-        }
-
-        /*
-         * Try and open the file for this language.  If it fails, we are
-         * done.
-         */
-        if ((outFP = fopen(languages[ii].outFileName, "w")) == NULL)
+        if ((args[ArgListing].on == true) || (args[ArgReplay].on == true))
         {
-            status = sdl_set_message(msgVec,
-                                     2,
-                                     SDL_OUTFILOPN,
-                                     languages[ii].outFileName,
-                                     errno);
-            if (status == SDL_NORMAL)
-            {
-                status = sdl_get_message(msgVec, &msgTxt);
-            }
+            status = sdl_set_message(context.msgVec,
+                                     1,
+                                     SDL_CONFLDUPLQ,
+                                     "--variant|--list|--replay");
             if (status == SDL_NORMAL)
             {
-                fprintf(stderr, errFmt, msgTxt);
+                _sdl_report(&context);
             }
-            sdl_free(msgTxt);
             return (-1);
         }
-        else
-        {
-            status = sdl_load_fp(ii, outFP);
-            if (status != SDL_NORMAL)
-            {
-                status = sdl_get_message(msgVec, &msgTxt);
-                if (status == SDL_NORMAL)
-                {
-                    fprintf(stderr, errFmt, msgTxt);
-                }
-                sdl_free(msgTxt);
-                return (-1);
-            }
-            context.langEnableVec[ii] = true;
-        }
-    }
-    if (args[ArgHeader].on == true)
-    {
-
-        /*
-         * OK, we successfully opened the files.  Insert the header
-         * comments.  First starting with a row of '*'s.
-         */
-        if (sdl_call_commentStars() == SDL_NORMAL)
+        for (ii = 0; ii < variants.listUsed; ii++)
         {
+            SDL_SYMBOL_LIST *list = args[ArgSymbols].symbol;
+            int jj;
 
-            /*
-             * If we put the row of '*'s in, now put in information
-             * about OpenSDL.
-             */
-            if (sdl_call_createdByInfo(&context.runTimeInfo) == SDL_NORMAL)
+            for (jj = 0; jj < list->listUsed; jj++)
             {
-                struct stat fileStats;
-
-                context.inputPath = realpath(args[ArgInputFile].fileName,
-                                             NULL);
-                if (context.inputPath == NULL)
-                {
-                    context.inputPath = strdup(args[ArgInputFile].fileName);
-                }
-                if (stat(context.inputPath, &fileStats) != 0)
-                {
-                    timeInfo->tm_year = -42;
-                    timeInfo->tm_mon = 10;
-                    timeInfo->tm_mday = 17;
-                    timeInfo->tm_hour = 0;
-                    timeInfo->tm_min = 0;
-                    timeInfo->tm_sec = 0;
-                }
-                else
-                    timeInfo = localtime(&fileStats.st_mtime);
-
-                /*
-                 * OK, if we put in the row of information about
-                 * OpenSDL, let's put in information about the file we
-                 * are about to parse.
-                 */
-                memcpy(&context.inputTimeInfo, timeInfo, sizeof(struct tm));
-                if (sdl_call_fileInfo(&context.inputTimeInfo,
-                                      context.inputPath) == SDL_NORMAL)
-                {
-
-                    /*
-                     * Finally, if we get here, we just need to output
-                     * another row of '*'s, and then can begin our
-                     * actual input file parsing and output file
-                     * generation.
-                     */
-                    if (sdl_call_commentStars() != SDL_NORMAL)
-                    {
-                        status = sdl_get_message(msgVec, &msgTxt);
-                        if (status == SDL_NORMAL)
-                        {
-                            fprintf(stderr, errFmt, msgTxt);
-                        }
-                        sdl_free(msgTxt);
-                        return (-1);
-                    }
-                }
-                else
+                status = _sdl_variant_symbol(&variants.variants[ii],
+                                             list->symbols[jj].symbol,
+                                             strlen(list->symbols[jj].symbol),
+                                             list->symbols[jj].value);
+                if (status == SDL_ABORT)
                 {
-                    status = sdl_get_message(msgVec, &msgTxt);
-                    if (status == SDL_NORMAL)
-                    {
-                        fprintf(stderr, errFmt, msgTxt);
-                    }
-                    sdl_free(msgTxt);
+                    sdl_set_message(context.msgVec, 1, status, "--variant");
+                    _sdl_report(&context);
                     return (-1);
                 }
             }
-            else
-            {
-                status = sdl_get_message(msgVec, &msgTxt);
-                if (status == SDL_NORMAL)
-                {
-                    fprintf(stderr, errFmt, msgTxt);
-                }
-                sdl_free(msgTxt);
-                return (-1);
-            }
-        }
-        else
-        {
-            status = sdl_get_message(msgVec, &msgTxt);
-            if (status == SDL_NORMAL)
-            {
-                fprintf(stderr, errFmt, msgTxt);
-            }
-            sdl_free(msgTxt);
-            return (-1);
         }
     }
 
     /*
-     * If we get this far, then go and write out the header information to each
-     * languages output file.
+     * Set up a job for each of the input files.
      */
-
-    SDL_Q_INIT(&context.locals);
-    context.module = NULL;
-    context.ident = NULL;
+    _sdl_jobs = sdl_calloc(inputs.listUsed, sizeof(SDL_COMPILE_JOB));
+    if (_sdl_jobs == NULL)
+    {
+        fprintf(stderr,
+                "%%SDL-F-ABORT, Fatal internal error. Unable to continue "
+                "execution\n-SYSTEM-E-ENOMEM, Not enough space\n");
+        return (-1);
+    }
+    for (ii = 0; ii < inputs.listUsed; ii++)
+    {
+        _sdl_jobs[ii].fileName = inputs.files[ii];
+    }
+    _sdl_job_count = inputs.listUsed;
+    jobs = args[ArgJobs].value;
+    if (jobs > _sdl_job_count)
+    {
+        jobs = _sdl_job_count;
+    }
 
     /*
-     * If the copyright needs to be put into the file, then do so now.
+     * If there is only one job at a time, then just compile each of the input
+     * files, in order, with the diagnostics going straight to stderr.
      */
-    if (cfp != NULL)
+    if (jobs <= 1)
     {
-        bool deferListing = listing;
-
-        listing = false;
-        yylex_init(&scanner);
-        yyset_debug(_verbose, scanner);
-        yyset_in(cfp, scanner);
-        yyparse(scanner);
-        yylex_destroy(scanner);
-        listing = deferListing;
+        for (ii = 0; ii < _sdl_job_count; ii++)
+        {
+            _sdl_jobs[ii].retVal = _sdl_compile(&context,
+                                                _sdl_jobs[ii].fileName,
+                                                stderr);
+        }
     }
 
     /*
-     * If we are being asked to create a listing file, then do so now.
+     * Otherwise, start up the worker threads, and then write out the
+     * diagnostics for each input file, in order, as soon as it has been
+     * compiled.
      */
-    if (listing == true)
+    else
     {
+        workers = sdl_calloc(jobs, sizeof(pthread_t));
+        for (ii = 0; ((workers != NULL) && (ii < jobs)); ii++)
+        {
+            if (pthread_create(&workers[ii],
+                               NULL,
+                               _sdl_worker,
+                               &context) != 0)
+            {
+                break;
+            }
+        }
+        jobs = (workers != NULL) ? ii : 0;
 
         /*
-         * If the listing file name was not specified by the user, then
-         * generate one from the input file, using '.lis' as the file
-         * extension.
+         * If no workers could be started, do the work on this thread.
          */
-        if (args[ArgListingFile].present == false)
+        if (jobs == 0)
+        {
+            _sdl_worker(&context);
+        }
+        for (ii = 0; ii < _sdl_job_count; ii++)
         {
-            for (ii = strlen(args[ArgInputFile].fileName);
-                 ii >= 0;
-                 ii--)
+            pthread_mutex_lock(&_sdl_job_mutex);
+            while (_sdl_jobs[ii].done == false)
             {
-                if (args[ArgInputFile].fileName[ii] == '.')
-                {
-                    break;
-                }
+                pthread_cond_wait(&_sdl_job_done, &_sdl_job_mutex);
             }
-            if (ii <= 0)
+            pthread_mutex_unlock(&_sdl_job_mutex);
+            if (_sdl_jobs[ii].errBuf != NULL)
             {
-                ii = strlen(args[ArgInputFile].fileName);
+                fwrite(_sdl_jobs[ii].errBuf, 1, _sdl_jobs[ii].errLen, stderr);
+                free(_sdl_jobs[ii].errBuf);
             }
-            args[ArgListingFile].fileName = sdl_calloc(ii + 5, 1);
-            strncpy(args[ArgListingFile].fileName,
-                    args[ArgInputFile].fileName, ii);
-            strcpy(&args[ArgListingFile].fileName[ii], ".lis");
         }
-
-        /*
-         * Before we begin parsing the input file, open the listing file.
-         */
-        listingFP = sdl_open_list(&context);
+        for (ii = 0; ii < jobs; ii++)
+        {
+            pthread_join(workers[ii], NULL);
+        }
+        if (workers != NULL)
+        {
+            sdl_free(workers);
+        }
     }
-
-    /*
-     * Start parsing the real input file
-     */
-    yylex_init(&scanner);
-    yyset_debug(_verbose, scanner);
-
-    /*
-     * Associate the input file to the parser.
-     */
-    yyset_in(fp, scanner);
-
-    /*
-     * Do the parsing.
-     */
-    yyparse(scanner);
-
-    /*
-     * All done parsing, do the clean-up.
-     */
-    yylex_destroy(scanner);
-
-    /*
-     * If were asked to create a listing file, then close it now.
-     */
-    if (listing == true)
+    for (ii = 0; ii < _sdl_job_count; ii++)
     {
-        sdl_close_list(&context);
-        listingFP = NULL;
-        listing = false;
+        if (_sdl_jobs[ii].retVal != 0)
+        {
+            retVal = -1;
+        }
     }
 
     /*
-     * Go close all the output files.
+     * If statistics were asked for, finish off with the ones for the whole
+     * run.
      */
-    sdl_call_close();
+    sdl_stats_finish(&context.stats);
+    if (args[ArgStats].present == true)
+    {
+        sdl_stats_write(stderr,
+                        &context.stats,
+                        NULL,
+                        args[ArgStats].value == SDL_K_STATS_JSON);
+    }
+    sdl_stats_free(&context.stats);
 
     /*
-     * Return the results back to the caller.
+     * Now that all the output files have been closed, unload the plugins.
      */
-    if (trace == true)
-    {
-        fprintf(stderr,
-                "'%s' has been processed\n",
-                args[ArgInputFile].fileName);
-    }
+    sdl_unload_plugins();
 
     /*
      * Clean-up memory.
      */
-    for (ii = 0; ii < context.langCondList.listUsed; ii++)
-    {
-        sdl_free(context.langCondList.lang[ii]);
-    }
     for (ii = 0; ii < args[ArgSymbols].symbol->listUsed; ii++)
     {
         if (args[ArgSymbols].symbol->symbols[ii].symbol != NULL)
@@ -1756,18 +3247,132 @@ int main(int argc, char *argv[])
     {
         sdl_free(args[ArgSymbols].symbol->symbols);
     }
-    if (args[ArgInputFile].fileName != NULL)
+    for (ii = 0; ii < inputs.listUsed; ii++)
     {
-        sdl_free(args[ArgInputFile].fileName);
+        sdl_free(inputs.files[ii]);
     }
-    if (context.inputPath != NULL)
+    if (inputs.files != NULL)
     {
-        sdl_free(context.inputPath);
+        sdl_free(inputs.files);
     }
+    for (ii = 0; ii < variants.listUsed; ii++)
+    {
+        _sdl_variant_free(&variants.variants[ii]);
+    }
+    if (variants.variants != NULL)
+    {
+        sdl_free(variants.variants);
+    }
+    sdl_free(_sdl_jobs);
+
+    /*
+     * Return back to the caller.
+     */
+    return (retVal);
+}
+
+/*
+ * _sdl_serve
+ *  This function is called to run the compile server.  The plugins for the
+ *  languages specified are loaded before the server starts, so that each
+ *  request starts with them already loaded.
+ *
+ * Input Parameters:
+ *  socketPath:
+ *      A pointer to the path of the socket to listen on.
+ *  langCount:
+ *      A value indicating the number of languages in langs.
+ *  langs:
+ *      A pointer to an array of strings containing the languages to be
+ *      loaded.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  0:  The server was told to stop.
+ *  -1: The server could not be started, or failed.
+ */
+static int _sdl_serve(char *socketPath, int langCount, char *langs[])
+{
+    char        *fileExt;
+    uint32_t    langId;
+    uint32_t    status = SDL_NORMAL;
+    int         ii;
+
+    memset(&context, 0, sizeof(SDL_CONTEXT));
+    context.errFP = stderr;
+    sdl_set_message(context.msgVec, 1, SDL_NORMAL);
+    for (ii = 0; ((ii < langCount) && (status == SDL_NORMAL)); ii++)
+    {
+        status = sdl_load_plugin(&context, langs[ii], &fileExt, &langId);
+    }
+    if (status == SDL_NORMAL)
+    {
+        status = sdl_server(&context, socketPath, _sdl_main);
+    }
+    if (status != SDL_NORMAL)
+    {
+        _sdl_report(&context);
+    }
+    sdl_unload_plugins();
 
     /*
      * Return back to the caller.
      */
-    return (0);
+    return((status == SDL_NORMAL) ? 0 : -1);
 }
 
+/*
+ * main
+ *  This is the main function called by the image activator.  If the first
+ *  argument is --server=<socket>, then this image becomes a compile server,
+ *  with the plugins for any languages that follow already loaded.  If the
+ *  first argument is --connect=<socket>, then the rest of the command line is
+ *  run by the compile server listening on that socket, or by this image if
+ *  there is no server.  Otherwise, the command line is run by this image.
+ *
+ * Input Parameters:
+ *  argc:
+ *	A value indicating the number of arguments specified in argv.
+ *  argv:
+ *	A pointer to an array or strings containing the command line arguments.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  0: for success.
+ *  1: for failure.
+ */
+int main(int argc, char *argv[])
+{
+    int retVal;
+
+    if ((argc > 1) && (strncmp(argv[1], "--server=", 9) == 0))
+    {
+        retVal = _sdl_serve(&argv[1][9], argc - 2, &argv[2]);
+    }
+    else if ((argc > 1) && (strncmp(argv[1], "--connect=", 10) == 0))
+    {
+        char *socketPath = &argv[1][10];
+
+        /*
+         * Drop the --connect argument, keeping the program name.
+         */
+        argv[1] = argv[0];
+        if (sdl_client(socketPath, argc - 1, &argv[1], &retVal) == false)
+        {
+            retVal = _sdl_main(argc - 1, &argv[1]);
+        }
+    }
+    else
+    {
+        retVal = _sdl_main(argc, argv);
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return (retVal);
+}
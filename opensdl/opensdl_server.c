@@ -0,0 +1,827 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the compile server and its client.  The server
+ *  loads the plugins once, and keeps the INCLUDE files it has seen in the
+ *  INCLUDE file cache.  Each request is run in a child process forked from
+ *  the server, so it starts with the plugins already loaded and the cache
+ *  already filled, and anything it does to the process, including exiting, or
+ *  changing directory, is gone when it is done.  The child sends the server
+ *  the names of the INCLUDE files it had to read, so that the server can load
+ *  them for the next request.  They are loaded by the thread that forks, just
+ *  before it does, so that no other thread can be holding a lock the child
+ *  needs.
+ *
+ * Revision History:
+ *
+ *  V01.000	15-OCT-2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	16-OCT-2026	Jonathan D. Belanger
+ *  Calls are recorded in the trace rather than written to standard output.
+ *
+ *  V01.002	16-OCT-2026	Jonathan D. Belanger
+ *  Being told to stop is an orderly stop.  The server stops listening and
+ *  returns normally, rather than exiting from the signal handler.  The
+ *  request is run with errno cleared, as it would be in a new process.
+ *
+ *  V01.003	16-OCT-2026	Jonathan D. Belanger
+ *  The INCLUDE files a child had to read are loaded into the cache by the
+ *  thread accepting requests, before it forks the next child, rather than by
+ *  the thread that waited for the child.  A child could be forked while that
+ *  thread was holding the cache or memory tracing locks.  The thread waiting
+ *  for a child now only uses the C library.
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "opensdl_defs.h"
+#include "opensdl/opensdl_main.h"
+#include "opensdl/opensdl_server.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_trace.h"
+#include "library/utility/opensdl_include.h"
+
+/*
+ * What the server needs to finish a request, after the child has been
+ * started.
+ */
+typedef struct
+{
+    pid_t	pid;
+    int		conn;
+    int		missFD;
+} SDL_SERVER_CHILD;
+
+/*
+ * The names of the INCLUDE files a child had to read, one after the other,
+ * waiting to be loaded into the cache.
+ */
+typedef struct _sdl_server_misses
+{
+    struct _sdl_server_misses *next;
+    char	*names;
+    size_t	length;
+} SDL_SERVER_MISSES;
+
+/*
+ * Local Variables
+ */
+static char *_sdl_server_path = NULL;
+static volatile sig_atomic_t _sdl_server_stop = 0;
+static SDL_SERVER_MISSES *_sdl_server_misses = NULL;
+static pthread_mutex_t _sdl_server_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Local Prototypes
+ */
+static bool _sdl_server_io(int fd, void *buf, size_t len, bool writing);
+static void _sdl_server_request(int sock, int conn, SDL_SERVER_MAIN compile);
+static void *_sdl_server_finish(void *arg);
+static void _sdl_server_load(void);
+static void _sdl_server_signal(int sig);
+
+/*
+ * sdl_server
+ *  This function is called to run the compile server.  It listens on a Unix
+ *  domain socket, and runs each request it receives, until it is told to
+ *  stop with SIGINT or SIGTERM, or there is an error with the socket.
+ *
+ * Input Parameters:
+ *  context:
+ *      A pointer to the context structure, where the message vector is
+ *      maintained.
+ *  socketPath:
+ *      A pointer to the path of the socket to listen on.  Anything already at
+ *      this path is removed.
+ *  compile:
+ *      The address of the function to call, in the child process, for each
+ *      request.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  SDL_NORMAL:     The server was told to stop.
+ *  SDL_SRVSOCKET:  The socket could not be created, or failed.
+ *  SDL_ERREXIT:    Error exit.
+ */
+uint32_t sdl_server(SDL_CONTEXT *context,
+                    char *socketPath,
+                    SDL_SERVER_MAIN compile)
+{
+    struct sockaddr_un addr;
+    uint32_t retVal = SDL_SRVSOCKET;
+    int sock;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_server");
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(socketPath) >= sizeof(addr.sun_path))
+    {
+        errno = ENAMETOOLONG;
+        sock = -1;
+    }
+    else
+    {
+        strcpy(addr.sun_path, socketPath);
+        unlink(socketPath);
+        sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    }
+    if ((sock >= 0) &&
+        ((bind(sock, (struct sockaddr *) &addr, sizeof(addr)) != 0) ||
+         (listen(sock, SOMAXCONN) != 0)))
+    {
+        int saveErrno = errno;
+
+        close(sock);
+        errno = saveErrno;
+        sock = -1;
+    }
+
+    /*
+     * Turn on the INCLUDE file cache, and remove the socket when we are told
+     * to stop.  A client that goes away must not stop the server.
+     */
+    if (sock >= 0)
+    {
+        struct sigaction action;
+
+        /*
+         * The signals are not restarted, so that accept returns when we are
+         * told to stop.
+         */
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = _sdl_server_signal;
+        sigemptyset(&action.sa_mask);
+        _sdl_server_path = socketPath;
+        sdl_include_cache_enable();
+        signal(SIGPIPE, SIG_IGN);
+        sigaction(SIGINT, &action, NULL);
+        sigaction(SIGTERM, &action, NULL);
+        if (trace == true)
+        {
+            fprintf(stderr, "Compile server listening on '%s'\n", socketPath);
+        }
+        while (_sdl_server_stop == 0)
+        {
+            int conn = accept(sock, NULL, NULL);
+
+            if (conn >= 0)
+            {
+                _sdl_server_request(sock, conn, compile);
+            }
+            else if (errno != EINTR)
+            {
+                break;
+            }
+        }
+        close(sock);
+        unlink(socketPath);
+        if (_sdl_server_stop != 0)
+        {
+            retVal = SDL_NORMAL;
+        }
+    }
+    if ((retVal != SDL_NORMAL) &&
+        (sdl_set_message(context->msgVec,
+                         2,
+                         retVal,
+                         socketPath,
+                         errno) != SDL_NORMAL))
+    {
+        retVal = SDL_ERREXIT;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * sdl_client
+ *  This function is called to have a compile server run a command line for
+ *  us.  The server writes straight to our standard output and error, so all
+ *  we do is wait for the exit status.
+ *
+ * Input Parameters:
+ *  socketPath:
+ *      A pointer to the path of the socket the server is listening on.
+ *  argc:
+ *      A value indicating the number of arguments specified in argv.
+ *  argv:
+ *      A pointer to an array of strings containing the command line
+ *      arguments to be run, starting with the program name.
+ *
+ * Output Parameters:
+ *  exitStatus:
+ *      A pointer to an integer to receive the exit status of the command
+ *      line.
+ *
+ * Return Values:
+ *  true:   The request was sent to the server, and the exit status returned.
+ *  false:  There is no server, or the request could not be sent.  Nothing
+ *          has been run, so the caller can run the command line itself.
+ */
+bool sdl_client(char *socketPath, int argc, char *argv[], int *exitStatus)
+{
+    SDL_SERVER_REQUEST req;
+    struct sockaddr_un addr;
+    struct msghdr msg;
+    struct iovec iov;
+    struct cmsghdr *cmsg;
+    char control[CMSG_SPACE(2 * sizeof(int))];
+    char *cwd = NULL;
+    char *body = NULL;
+    int32_t status;
+    bool retVal = false;
+    int sock;
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("sdl_client");
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(socketPath) >= sizeof(addr.sun_path))
+    {
+        return(false);
+    }
+    strcpy(addr.sun_path, socketPath);
+    sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0)
+    {
+        return(false);
+    }
+    if (connect(sock, (struct sockaddr *) &addr, sizeof(addr)) != 0)
+    {
+        close(sock);
+        return(false);
+    }
+
+    /*
+     * Put the working directory and arguments, one after the other, into the
+     * body of the request.
+     */
+    cwd = getcwd(NULL, 0);
+    req.magic = SDL_K_SERVER_MAGIC;
+    req.argc = argc;
+    req.length = (cwd != NULL) ? (strlen(cwd) + 1) : 0;
+    for (ii = 0; ii < argc; ii++)
+    {
+        req.length += strlen(argv[ii]) + 1;
+    }
+    body = sdl_calloc(req.length + 1, 1);
+    if ((cwd != NULL) && (body != NULL) &&
+        (req.length <= SDL_K_SERVER_MAXREQ))
+    {
+        char *ptr = body;
+
+        strcpy(ptr, cwd);
+        ptr += strlen(cwd) + 1;
+        for (ii = 0; ii < argc; ii++)
+        {
+            strcpy(ptr, argv[ii]);
+            ptr += strlen(argv[ii]) + 1;
+        }
+
+        /*
+         * Send the header, with our standard output and error, and then the
+         * body.
+         */
+        memset(&msg, 0, sizeof(msg));
+        memset(control, 0, sizeof(control));
+        iov.iov_base = &req;
+        iov.iov_len = sizeof(req);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(2 * sizeof(int));
+        ((int *) CMSG_DATA(cmsg))[0] = STDOUT_FILENO;
+        ((int *) CMSG_DATA(cmsg))[1] = STDERR_FILENO;
+        fflush(stdout);
+        fflush(stderr);
+        if ((sendmsg(sock, &msg, 0) == sizeof(req)) &&
+            (_sdl_server_io(sock, body, req.length, true) == true))
+        {
+
+            /*
+             * The request has been sent, so whatever happens now, it must not
+             * be run again.
+             */
+            retVal = true;
+            if (_sdl_server_io(sock, &status, sizeof(status), false) == true)
+            {
+                *exitStatus = status;
+            }
+            else
+            {
+                fprintf(stderr,
+                        "%%SDL-E-SRVSOCKET, Unable to use compile server "
+                        "socket %s\n-SYSTEM-E-ECONNRESET, %s\n",
+                        socketPath,
+                        strerror(ECONNRESET));
+                *exitStatus = -1;
+            }
+        }
+    }
+
+    /*
+     * Clean-up memory.
+     */
+    close(sock);
+    if (body != NULL)
+    {
+        sdl_free(body);
+    }
+    if (cwd != NULL)
+    {
+        free(cwd);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_server_io
+ *  This function is called to read or write all of a buffer on a socket.
+ *
+ * Input Parameters:
+ *  fd:
+ *      A value indicating the socket to be read or written.
+ *  buf:
+ *      A pointer to the buffer to be written, or to receive what is read.
+ *  len:
+ *      A value indicating the number of bytes to be read or written.
+ *  writing:
+ *      A boolean indicating that the buffer is to be written.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  true:   The whole buffer was read or written.
+ *  false:  An error occurred, or the other end closed the socket.
+ */
+static bool _sdl_server_io(int fd, void *buf, size_t len, bool writing)
+{
+    char *ptr = (char *) buf;
+
+    while (len > 0)
+    {
+        ssize_t count = (writing == true) ?
+                            write(fd, ptr, len) : read(fd, ptr, len);
+
+        if (count > 0)
+        {
+            ptr += count;
+            len -= count;
+        }
+        else if ((count < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            return(false);
+        }
+    }
+    return(true);
+}
+
+/*
+ * _sdl_server_request
+ *  This function is called to start running a request the server has
+ *  received.  The child process runs the command line, and a thread waits for
+ *  it to finish, so the server can accept the next request straight away.
+ *
+ * Input Parameters:
+ *  sock:
+ *      A value indicating the socket the server is listening on.
+ *  conn:
+ *      A value indicating the connection to the client.
+ *  compile:
+ *      The address of the function to call, in the child process, to run the
+ *      command line.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_server_request(int sock, int conn, SDL_SERVER_MAIN compile)
+{
+    SDL_SERVER_REQUEST req;
+    SDL_SERVER_CHILD *child = NULL;
+    struct msghdr msg;
+    struct iovec iov;
+    struct cmsghdr *cmsg;
+    char control[CMSG_SPACE(2 * sizeof(int))];
+    char **argv = NULL;
+    char *body = NULL;
+    int fds[2] = {-1, -1};
+    int missPipe[2] = {-1, -1};
+    bool ok = false;
+    int ii;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("_sdl_server_request");
+
+    /*
+     * Get the header, and the client's standard output and error.
+     */
+    memset(&msg, 0, sizeof(msg));
+    iov.iov_base = &req;
+    iov.iov_len = sizeof(req);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(conn, &msg, MSG_WAITALL) == sizeof(req))
+    {
+        for (cmsg = CMSG_FIRSTHDR(&msg);
+             cmsg != NULL;
+             cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if ((cmsg->cmsg_level == SOL_SOCKET) &&
+                (cmsg->cmsg_type == SCM_RIGHTS) &&
+                (cmsg->cmsg_len == CMSG_LEN(2 * sizeof(int))))
+            {
+                fds[0] = ((int *) CMSG_DATA(cmsg))[0];
+                fds[1] = ((int *) CMSG_DATA(cmsg))[1];
+            }
+        }
+        ok = (fds[0] >= 0) && (fds[1] >= 0) &&
+             (req.magic == SDL_K_SERVER_MAGIC) &&
+             (req.argc > 0) &&
+             (req.length <= SDL_K_SERVER_MAXREQ);
+    }
+
+    /*
+     * Get the body, and point an argument at each string after the working
+     * directory.  The strings must account for the whole body.
+     */
+    if (ok == true)
+    {
+        body = sdl_calloc(req.length + 1, 1);
+        argv = sdl_calloc(req.argc + 1, sizeof(char *));
+        ok = (body != NULL) && (argv != NULL) &&
+             (_sdl_server_io(conn, body, req.length, false) == true);
+    }
+    if (ok == true)
+    {
+        char *ptr = body + strlen(body) + 1;
+
+        for (ii = 0; ((ii < req.argc) && (ptr < (body + req.length))); ii++)
+        {
+            argv[ii] = ptr;
+            ptr += strlen(ptr) + 1;
+        }
+        ok = (ii == req.argc) && (ptr == (body + req.length));
+    }
+    if (ok == true)
+    {
+        child = calloc(1, sizeof(SDL_SERVER_CHILD));
+        ok = (child != NULL) && (pipe(missPipe) == 0);
+    }
+
+    /*
+     * Start the child process, with the files earlier children had to read
+     * loaded into the cache.  It writes to the client's standard output and
+     * error, from the client's working directory.
+     */
+    if (ok == true)
+    {
+        _sdl_server_load();
+        fflush(stdout);
+        fflush(stderr);
+        child->pid = fork();
+        if (child->pid == 0)
+        {
+            FILE *missFP;
+            int status = -1;
+
+            close(sock);
+            close(conn);
+            close(missPipe[0]);
+            dup2(fds[0], STDOUT_FILENO);
+            dup2(fds[1], STDERR_FILENO);
+            close(fds[0]);
+            close(fds[1]);
+            signal(SIGPIPE, SIG_DFL);
+            signal(SIGINT, SIG_DFL);
+            signal(SIGTERM, SIG_DFL);
+            if (chdir(body) == 0)
+            {
+                errno = 0;
+                status = (*compile)(req.argc, argv);
+            }
+            else
+            {
+                fprintf(stderr,
+                        "%%SDL-E-SRVSOCKET, Unable to use compile server "
+                        "socket %s\n-SYSTEM-E-ENOENT, %s: %s\n",
+                        _sdl_server_path,
+                        body,
+                        strerror(errno));
+            }
+            fflush(stdout);
+            fflush(stderr);
+            missFP = fdopen(missPipe[1], "w");
+            if (missFP != NULL)
+            {
+                sdl_include_write_misses(missFP);
+                fclose(missFP);
+            }
+            _exit(status & 0xff);
+        }
+        ok = child->pid > 0;
+    }
+
+    /*
+     * The client's files now belong to the child.
+     */
+    if (fds[0] >= 0)
+    {
+        close(fds[0]);
+    }
+    if (fds[1] >= 0)
+    {
+        close(fds[1]);
+    }
+    if (missPipe[1] >= 0)
+    {
+        close(missPipe[1]);
+    }
+    if (body != NULL)
+    {
+        sdl_free(body);
+    }
+    if (argv != NULL)
+    {
+        sdl_free(argv);
+    }
+
+    /*
+     * Wait for the child on a thread of its own.  If one cannot be started,
+     * then wait for it here.
+     */
+    if (ok == true)
+    {
+        pthread_t thread;
+        sigset_t stopSignals, oldSignals;
+        int error;
+
+        /*
+         * The thread is started with SIGINT and SIGTERM blocked, so that they
+         * are delivered to the thread waiting in accept.
+         */
+        child->conn = conn;
+        child->missFD = missPipe[0];
+        sigemptyset(&stopSignals);
+        sigaddset(&stopSignals, SIGINT);
+        sigaddset(&stopSignals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &stopSignals, &oldSignals);
+        error = pthread_create(&thread, NULL, _sdl_server_finish, child);
+        pthread_sigmask(SIG_SETMASK, &oldSignals, NULL);
+        if (error == 0)
+        {
+            pthread_detach(thread);
+        }
+        else
+        {
+            _sdl_server_finish(child);
+        }
+    }
+    else
+    {
+        if (missPipe[0] >= 0)
+        {
+            close(missPipe[0]);
+        }
+        if (child != NULL)
+        {
+            free(child);
+        }
+        close(conn);
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_server_finish
+ *  This function is called to wait for a child process to finish, send its
+ *  exit status to the client, and queue the names of the INCLUDE files it had
+ *  to read, to be loaded into the cache before the next child is started.
+ *  This runs on a thread of its own, while a child may be forked, so it only
+ *  uses the C library, which is safe to fork around.
+ *
+ * Input Parameters:
+ *  arg:
+ *      A pointer to the information about the child process.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  NULL.
+ */
+static void *_sdl_server_finish(void *arg)
+{
+    SDL_SERVER_CHILD *child = (SDL_SERVER_CHILD *) arg;
+    FILE *missFP = fdopen(child->missFD, "r");
+    char *misses = NULL;
+    size_t missLen = 0;
+    int32_t exitStatus = -1;
+    int status = -1;
+
+    /*
+     * Read the names of the files the child read, before waiting for it, so
+     * that it cannot block writing them.
+     */
+    if (missFP != NULL)
+    {
+        FILE *memFP = open_memstream(&misses, &missLen);
+        char buf[BUFSIZ];
+        size_t count;
+
+        while ((count = fread(buf, 1, sizeof(buf), missFP)) > 0)
+        {
+            if (memFP != NULL)
+            {
+                fwrite(buf, 1, count, memFP);
+            }
+        }
+        if (memFP != NULL)
+        {
+            fclose(memFP);
+        }
+        fclose(missFP);
+    }
+    else
+    {
+        close(child->missFD);
+    }
+    while ((waitpid(child->pid, &status, 0) < 0) && (errno == EINTR))
+    {
+        continue;
+    }
+    if (WIFEXITED(status))
+    {
+        exitStatus = WEXITSTATUS(status);
+    }
+    _sdl_server_io(child->conn, &exitStatus, sizeof(exitStatus), true);
+    close(child->conn);
+
+    /*
+     * Now that the client has its answer, queue the files to be loaded.
+     */
+    if ((misses != NULL) && (missLen > 0))
+    {
+        SDL_SERVER_MISSES *pending = malloc(sizeof(SDL_SERVER_MISSES));
+
+        if (pending != NULL)
+        {
+            pending->names = misses;
+            pending->length = missLen;
+            pthread_mutex_lock(&_sdl_server_mutex);
+            pending->next = _sdl_server_misses;
+            _sdl_server_misses = pending;
+            pthread_mutex_unlock(&_sdl_server_mutex);
+            misses = NULL;
+        }
+    }
+    if (misses != NULL)
+    {
+        free(misses);
+    }
+    free(child);
+
+    /*
+     * Return back to the caller.
+     */
+    return(NULL);
+}
+
+/*
+ * _sdl_server_load
+ *  This function is called, on the thread accepting requests, to load the
+ *  INCLUDE files that earlier children had to read into the cache.
+ *
+ * Input Parameters:
+ *  None.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_server_load(void)
+{
+    SDL_SERVER_MISSES *pending;
+
+    /*
+     * If tracing is turned on, record this call.
+     */
+    SDL_TRACE("_sdl_server_load");
+
+    /*
+     * Take the whole queue, so that the lock is not held while the files are
+     * read.
+     */
+    pthread_mutex_lock(&_sdl_server_mutex);
+    pending = _sdl_server_misses;
+    _sdl_server_misses = NULL;
+    pthread_mutex_unlock(&_sdl_server_mutex);
+    while (pending != NULL)
+    {
+        SDL_SERVER_MISSES *next = pending->next;
+        char *ptr = pending->names;
+
+        while (ptr < (pending->names + pending->length))
+        {
+            sdl_include_cache_load(ptr);
+            ptr += strlen(ptr) + 1;
+        }
+        free(pending->names);
+        free(pending);
+        pending = next;
+    }
+
+    /*
+     * Return back to the caller.
+     */
+    return;
+}
+
+/*
+ * _sdl_server_signal
+ *  This function is called when the server is told to stop.  It removes the
+ *  socket, so that clients compile for themselves from then on, and has the
+ *  server stop listening.
+ *
+ * Input Parameters:
+ *  sig:
+ *      A value indicating the signal received.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  None.
+ */
+static void _sdl_server_signal(int sig)
+{
+    if (_sdl_server_path != NULL)
+    {
+        unlink(_sdl_server_path);
+    }
+    _sdl_server_stop = 1;
+}
@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This source file contains the utility that turns a trace file written by
+ *  OpenSDL (see opensdl_trace.h) into text.  The events from all the threads
+ *  are merged into the order they were recorded in, and each one is written
+ *  out on a line of its own, with the time since the first event in
+ *  microseconds, the thread that recorded it, where it was recorded, and its
+ *  arguments.
+ *
+ * USAGE:
+ *	$ ./OpenSDL_trace [trace_file]
+ *		trace_file	The trace file to be turned into text.  By
+ *				default this is opensdl.sdltrace.
+ *
+ * Revision History:
+ *
+ *  V01.000 16-OCT-2026 Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_trace.h"
+
+/*
+ * A place an event was recorded from, as read from the trace file.
+ */
+typedef struct
+{
+    char            *name;
+    char            *file;
+    uint32_t        line;
+    uint32_t        argCount;
+} SDL_TRACE_PLACE;
+
+/*
+ * Local Functions
+ */
+static uint8_t *_sdl_trace_read(char *fileName, size_t *length);
+static int _sdl_trace_compare(const void *a, const void *b);
+static char *_sdl_trace_basename(char *file);
+
+/*
+ * main
+ *  This is the main function for the utility.  It reads the trace file,
+ *  merges the events from each of the ring buffers, and writes them out.
+ *
+ * Input Parameters:
+ *  argc:
+ *    A value indicating the number of arguments.
+ *  argv:
+ *    A pointer to the arguments.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  0:          Normal Successful Completion.
+ *  1:          The trace file could not be read, or is not a trace file.
+ */
+int main(int argc, char **argv)
+{
+    SDL_TRACE_HEADER *header;
+    SDL_TRACE_PLACE *places = NULL;
+    SDL_TRACE_EVENT *events = NULL;
+    char *fileName = (argc > 1) ? argv[1] : SDL_K_TRACE_FILE;
+    uint8_t *buffer;
+    size_t length = 0;
+    size_t offset;
+    size_t eventCount = 0;
+    uint32_t ii;
+    int retVal = 1;
+
+    buffer = _sdl_trace_read(fileName, &length);
+    if (buffer == NULL)
+    {
+        fprintf(stderr, "Unable to read '%s': %s\n", fileName, strerror(errno));
+        return(retVal);
+    }
+    header = (SDL_TRACE_HEADER *) buffer;
+    if ((length < sizeof(SDL_TRACE_HEADER)) ||
+        (memcmp(header->magic,
+                SDL_K_TRACE_MAGIC,
+                SDL_K_TRACE_MAGIC_LEN) != 0) ||
+        (header->version != SDL_K_TRACE_VERSION) ||
+        (header->eventSize != sizeof(SDL_TRACE_EVENT)))
+    {
+        fprintf(stderr, "'%s' is not an OpenSDL trace file\n", fileName);
+        free(buffer);
+        return(retVal);
+    }
+
+    /*
+     * Get each of the places an event was recorded from.  They are kept by
+     * identifier, starting at 1.
+     */
+    places = calloc(header->siteCount + 1, sizeof(SDL_TRACE_PLACE));
+    offset = sizeof(SDL_TRACE_HEADER);
+    for (ii = 0; (places != NULL) && (ii < header->siteCount); ii++)
+    {
+        SDL_TRACE_SITE_REC rec;
+
+        if ((offset + sizeof(rec)) > length)
+        {
+            break;
+        }
+        memcpy(&rec, &buffer[offset], sizeof(rec));
+        offset += sizeof(rec);
+        if (((offset + rec.nameLength + rec.fileLength) > length) ||
+            (rec.id == 0) ||
+            (rec.id > header->siteCount))
+        {
+            break;
+        }
+        places[rec.id].name = strndup((char *) &buffer[offset],
+                                      rec.nameLength);
+        offset += rec.nameLength;
+        places[rec.id].file = strndup((char *) &buffer[offset],
+                                      rec.fileLength);
+        offset += rec.fileLength;
+        places[rec.id].line = rec.line;
+        places[rec.id].argCount = rec.argCount;
+    }
+
+    /*
+     * Gather up the events from all the ring buffers, noting how many each
+     * of them lost when it wrapped.
+     */
+    for (ii = 0;
+         (places != NULL) && (ii < header->ringCount) &&
+            ((offset + sizeof(SDL_TRACE_RING_REC)) <= length);
+         ii++)
+    {
+        SDL_TRACE_RING_REC rec;
+        size_t size;
+
+        memcpy(&rec, &buffer[offset], sizeof(rec));
+        offset += sizeof(rec);
+        size = (size_t) rec.count * sizeof(SDL_TRACE_EVENT);
+        if ((offset + size) > length)
+        {
+            break;
+        }
+        if (rec.recorded > rec.count)
+        {
+            printf("Ring buffer %u: %lu events recorded, %lu lost\n",
+                   ii + 1,
+                   rec.recorded,
+                   rec.recorded - rec.count);
+        }
+        events = realloc(events,
+                         (eventCount + rec.count) * sizeof(SDL_TRACE_EVENT));
+        if (events == NULL)
+        {
+            break;
+        }
+        memcpy(&events[eventCount], &buffer[offset], size);
+        eventCount += rec.count;
+        offset += size;
+    }
+
+    /*
+     * Put them in the order they were recorded in, and write them out.
+     */
+    if ((places != NULL) && ((events != NULL) || (eventCount == 0)))
+    {
+        size_t jj;
+
+        qsort(events, eventCount, sizeof(SDL_TRACE_EVENT), _sdl_trace_compare);
+        for (jj = 0; jj < eventCount; jj++)
+        {
+            SDL_TRACE_EVENT *event = &events[jj];
+            SDL_TRACE_PLACE *place;
+            uint32_t kk;
+
+            if ((event->siteID == 0) || (event->siteID > header->siteCount))
+            {
+                continue;
+            }
+            place = &places[event->siteID];
+            printf("%12.3f [%u] %s:%u:%s",
+                   (double) (event->timestamp - events[0].timestamp) / 1000.0,
+                   event->thread,
+                   _sdl_trace_basename(place->file),
+                   place->line,
+                   place->name);
+            for (kk = 0;
+                 (kk < place->argCount) && (kk < SDL_K_TRACE_ARGS);
+                 kk++)
+            {
+                printf("%s%ld", (kk == 0) ? "(" : ", ", event->arg[kk]);
+            }
+            printf("%s\n", (place->argCount > 0) ? ")" : "");
+        }
+        retVal = 0;
+    }
+    else
+    {
+        fprintf(stderr, "Unable to allocate memory for '%s'\n", fileName);
+    }
+
+    /*
+     * Clean up and return back to the caller.
+     */
+    if (places != NULL)
+    {
+        for (ii = 0; ii <= header->siteCount; ii++)
+        {
+            free(places[ii].name);
+            free(places[ii].file);
+        }
+        free(places);
+    }
+    free(events);
+    free(buffer);
+    return(retVal);
+}
+
+/************************************************************************/
+/* Local Functions                            */
+/************************************************************************/
+
+/*
+ * _sdl_trace_read
+ *  This function is called to read the whole of the trace file into memory.
+ *
+ * Input Parameters:
+ *  fileName:
+ *    A pointer to the name of the trace file.
+ *
+ * Output Parameters:
+ *  length:
+ *    A pointer to receive the length of the trace file.
+ *
+ * Return Values:
+ *  NULL:       An error occurred reading the trace file.
+ *  !NULL:      A pointer to an allocated buffer with the trace file in it.
+ */
+static uint8_t *_sdl_trace_read(char *fileName, size_t *length)
+{
+    FILE *fp = fopen(fileName, "rb");
+    uint8_t *retVal = NULL;
+
+    if (fp != NULL)
+    {
+        long size;
+
+        if ((fseek(fp, 0, SEEK_END) == 0) &&
+            ((size = ftell(fp)) >= 0) &&
+            (fseek(fp, 0, SEEK_SET) == 0))
+        {
+            retVal = malloc(size + 1);
+            if ((retVal != NULL) &&
+                (fread(retVal, 1, size, fp) != (size_t) size))
+            {
+                free(retVal);
+                retVal = NULL;
+            }
+            *length = size;
+        }
+        fclose(fp);
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_trace_compare
+ *  This function is called by qsort to put the events in the order they were
+ *  recorded in.  Events recorded at the same time are put in thread order.
+ *
+ * Input Parameters:
+ *  a:
+ *    A pointer to the first event to be compared.
+ *  b:
+ *    A pointer to the second event to be compared.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  <0:         The first event was recorded before the second.
+ *  0:          The events were recorded at the same time, by the same thread.
+ *  >0:         The first event was recorded after the second.
+ */
+static int _sdl_trace_compare(const void *a, const void *b)
+{
+    const SDL_TRACE_EVENT *first = (const SDL_TRACE_EVENT *) a;
+    const SDL_TRACE_EVENT *second = (const SDL_TRACE_EVENT *) b;
+    int retVal = 0;
+
+    if (first->timestamp != second->timestamp)
+    {
+        retVal = (first->timestamp < second->timestamp) ? -1 : 1;
+    }
+    else if (first->thread != second->thread)
+    {
+        retVal = (first->thread < second->thread) ? -1 : 1;
+    }
+
+    /*
+     * Return the results back to the caller.
+     */
+    return(retVal);
+}
+
+/*
+ * _sdl_trace_basename
+ *  This function is called to get the name of a source file, without the
+ *  directory it was compiled from.
+ *
+ * Input Parameters:
+ *  file:
+ *    A pointer to the source file name.
+ *
+ * Output Parameters:
+ *  None.
+ *
+ * Return Values:
+ *  A pointer to the name, within the source file name.
+ */
+static char *_sdl_trace_basename(char *file)
+{
+    char *retVal = (file != NULL) ? strrchr(file, '/') : NULL;
+
+    /*
+     * Return the results back to the caller.
+     */
+    return((retVal != NULL) ? retVal + 1 : ((file != NULL) ? file : "?"));
+}
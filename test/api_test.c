@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, api_test.c, verifies the embeddable interface.  SDL source in
+ *  memory is compiled to C in memory.  Then source with errors in it is
+ *  compiled, which must return a status and diagnostics to the caller, rather
+ *  than ending the program.  Finally, what is kept between compilations is
+ *  released, and the source must still compile after that.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 15, 2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	Oct 16, 2026	Jonathan D. Belanger
+ *  Compile again after sdl_compile_release.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_message.h"
+#include "library/api/opensdl_api.h"
+
+static const char _good[] =
+    "MODULE api_test IDENT \"V1.0\";\n"
+    "CONSTANT max_count EQUALS 10;\n"
+    "AGGREGATE point STRUCTURE PREFIX pt_;\n"
+    "    x LONGWORD;\n"
+    "    y LONGWORD;\n"
+    "END point;\n"
+    "END_MODULE api_test;\n";
+
+static const char _bad[] =
+    "MODULE api_test;\n"
+    "AGGREGATE point STRUCTURE;\n"
+    "    x LONGWORD\n"
+    "END_MODULE;\n";
+
+int main(void)
+{
+    SDL_COMPILE_OPTIONS options;
+    SDL_COMPILE_RESULT result;
+    const char *languages[] = {"c"};
+    uint32_t status;
+    int failed = 0;
+
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+    sdl_compile_options_init(&options);
+    options.header = false;
+
+    /*
+     * The good source must compile, and the output must have the aggregate in
+     * it.
+     */
+    status = sdl_compile_buffer(_good,
+                                strlen(_good),
+                                "api_test.sdl",
+                                &options,
+                                languages,
+                                1,
+                                &result);
+    if ((status != SDL_NORMAL) ||
+        (result.outputCount != 1) ||
+        (result.outputs[0].length == 0) ||
+        (strstr(result.outputs[0].buffer, "pt_x") == NULL))
+    {
+        printf("api_test: good source failed (0x%08x)\n%s\n",
+               status,
+               (result.diagnostics != NULL) ? result.diagnostics : "");
+        failed++;
+    }
+    sdl_compile_result_free(&result);
+
+    /*
+     * The bad source must fail, with the reason in the diagnostics.
+     */
+    status = sdl_compile_buffer(_bad,
+                                strlen(_bad),
+                                "api_bad.sdl",
+                                &options,
+                                languages,
+                                1,
+                                &result);
+    if ((status == SDL_NORMAL) || (result.diagLen == 0))
+    {
+        printf("api_test: bad source was not reported (0x%08x)\n", status);
+        failed++;
+    }
+    sdl_compile_result_free(&result);
+
+    /*
+     * An unknown language must be reported, not loaded.
+     */
+    languages[0] = "no-such-language";
+    status = sdl_compile_buffer(_good,
+                                strlen(_good),
+                                NULL,
+                                NULL,
+                                languages,
+                                1,
+                                &result);
+    if ((status == SDL_NORMAL) || (result.diagLen == 0))
+    {
+        printf("api_test: unknown language was not reported (0x%08x)\n",
+               status);
+        failed++;
+    }
+    sdl_compile_result_free(&result);
+
+    /*
+     * After the plugins and the identifiers are released, the next
+     * compilation must start them again.
+     */
+    sdl_compile_release();
+    languages[0] = "c";
+    status = sdl_compile_buffer(_good,
+                                strlen(_good),
+                                "api_test.sdl",
+                                &options,
+                                languages,
+                                1,
+                                &result);
+    if ((status != SDL_NORMAL) ||
+        (result.outputCount != 1) ||
+        (strstr(result.outputs[0].buffer, "pt_x") == NULL))
+    {
+        printf("api_test: source failed after release (0x%08x)\n", status);
+        failed++;
+    }
+    sdl_compile_result_free(&result);
+    sdl_compile_release();
+
+    printf("api_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
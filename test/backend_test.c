@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, backend_test.c, verifies generating more than one language at
+ *  the same time.  Each test SDL file is compiled by OpenSDL to C and to a
+ *  recording in one run, where each language is generated on a thread of its
+ *  own, and then to each of them in a run of its own, where the language is
+ *  generated on the parsing thread.  The output files and the diagnostics
+ *  must be the same.  Then the C output file is written to /dev/full, so
+ *  that it fails, and the message for it, and the exit status, must be the
+ *  same whether or not the recording is being made at the same time.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define BACKEND_K_ARGS		8
+
+static const char *_files[] =
+{
+    "SDLNODEF.SDL",
+    "SDLSHR.SDL",
+    "SDLTOKDEF.SDL",
+    "SDLTYPDEF.SDL",
+    "STSDEF.SDL",
+    "example_1_1.sdl",
+    "test_1.sdl",
+    "test_2.sdl",
+    "test_3.sdl",
+    "test_4.sdl",
+    "test_5.sdl",
+    "test_6.sdl",
+    "test_7.sdl",
+    "test_8.sdl",
+    "test_9.sdl"
+};
+#define BACKEND_K_FILES		(sizeof(_files) / sizeof(_files[0]))
+
+/*
+ * The files written by the test, in the temporary directory.
+ */
+typedef enum
+{
+    BothC,
+    BothRec,
+    BothErr,
+    OnlyC,
+    OnlyCErr,
+    OnlyRec,
+    OnlyRecErr,
+    FileMax
+} BACKEND_FILE;
+
+static const char *_names[FileMax] =
+{
+    "both.h",
+    "both.sdlrec",
+    "both.err",
+    "only.h",
+    "only.err",
+    "only.sdlrec",
+    "only_rec.err"
+};
+static char _paths[FileMax][PATH_MAX];
+
+/*
+ * Run OpenSDL with the language options and input file, with standard error
+ * written to the errors file, and return the exit status.
+ */
+static int _run(BACKEND_FILE errFile,
+                const char *lang1,
+                const char *lang2,
+                const char *inFile)
+{
+    const char *args[BACKEND_K_ARGS];
+    int status = 0;
+    int count = 0;
+    pid_t pid;
+
+    args[count++] = SDL_OPENSDL;
+    args[count++] = "--noheader";
+    args[count++] = lang1;
+    if (lang2 != NULL)
+    {
+        args[count++] = lang2;
+    }
+    args[count++] = inFile;
+    args[count] = NULL;
+    pid = fork();
+    if (pid == 0)
+    {
+        int fd = open(_paths[errFile], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd >= 0)
+        {
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        execv(SDL_OPENSDL, (char **) args);
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Read the whole of a file into memory, and return it, or NULL if it could
+ * not be read.
+ */
+static char *_read(const char *fileName, size_t *length)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *retVal = NULL;
+    long size;
+
+    if (fp == NULL)
+    {
+        return(NULL);
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) &&
+        ((size = ftell(fp)) >= 0) &&
+        (fseek(fp, 0, SEEK_SET) == 0) &&
+        ((retVal = malloc(size + 1)) != NULL))
+    {
+        if (fread(retVal, 1, size, fp) == (size_t) size)
+        {
+            retVal[size] = '\0';
+            *length = size;
+        }
+        else
+        {
+            free(retVal);
+            retVal = NULL;
+        }
+    }
+    fclose(fp);
+    return(retVal);
+}
+
+/*
+ * Return true if the two files have the same contents.
+ */
+static bool _same(BACKEND_FILE first, BACKEND_FILE second)
+{
+    size_t firstLen = 0;
+    size_t secondLen = 0;
+    char *firstBuf = _read(_paths[first], &firstLen);
+    char *secondBuf = _read(_paths[second], &secondLen);
+    bool retVal;
+
+    retVal = (firstBuf != NULL) && (secondBuf != NULL) &&
+             (firstLen == secondLen) &&
+             (memcmp(firstBuf, secondBuf, firstLen) == 0);
+    free(firstBuf);
+    free(secondBuf);
+    return(retVal);
+}
+
+int main(void)
+{
+    char tmpDir[] = "/tmp/sdl_backendXXXXXX";
+    char bothC[PATH_MAX + 16];
+    char bothRec[PATH_MAX + 16];
+    char onlyC[PATH_MAX + 16];
+    char onlyRec[PATH_MAX + 16];
+    int both, only;
+    int failed = 0;
+    int ii;
+
+    if ((chdir(SDL_TEST_DIR) != 0) || (mkdtemp(tmpDir) == NULL))
+    {
+        printf("backend_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+    for (ii = 0; ii < FileMax; ii++)
+    {
+        snprintf(_paths[ii], sizeof(_paths[ii]), "%s/%s", tmpDir, _names[ii]);
+    }
+    snprintf(bothC, sizeof(bothC), "--lang=c=%s", _paths[BothC]);
+    snprintf(bothRec, sizeof(bothRec), "--lang=record=%s", _paths[BothRec]);
+    snprintf(onlyC, sizeof(onlyC), "--lang=c=%s", _paths[OnlyC]);
+    snprintf(onlyRec, sizeof(onlyRec), "--lang=record=%s", _paths[OnlyRec]);
+
+    /*
+     * Each language generated on a thread of its own must be the same as
+     * each language generated on its own.
+     */
+    for (ii = 0; ii < BACKEND_K_FILES; ii++)
+    {
+        both = _run(BothErr, bothC, bothRec, _files[ii]);
+        only = _run(OnlyCErr, onlyC, NULL, _files[ii]);
+        if ((both != 0) ||
+            (only != 0) ||
+            (_run(OnlyRecErr, onlyRec, NULL, _files[ii]) != 0))
+        {
+            printf("backend_test: %s compilation failed\n", _files[ii]);
+            failed++;
+        }
+        else if ((_same(BothC, OnlyC) == false) ||
+                 (_same(BothRec, OnlyRec) == false))
+        {
+            printf("backend_test: %s output differs\n", _files[ii]);
+            failed++;
+        }
+        else if ((_same(BothErr, OnlyCErr) == false) ||
+                 (_same(BothErr, OnlyRecErr) == false))
+        {
+            printf("backend_test: %s diagnostics differ\n", _files[ii]);
+            failed++;
+        }
+    }
+
+    /*
+     * A language that fails reports the same message, and fails the
+     * compilation the same way, on a thread of its own.
+     */
+    both = _run(BothErr, "--lang=c=/dev/full", bothRec, _files[0]);
+    only = _run(OnlyCErr, "--lang=c=/dev/full", NULL, _files[0]);
+    if ((both == 0) || (both != only))
+    {
+        printf("backend_test: failing language exited with %d, and %d on "
+                   "its own\n",
+               both,
+               only);
+        failed++;
+    }
+    else if (_same(BothErr, OnlyCErr) == false)
+    {
+        printf("backend_test: failing language reported differently\n");
+        failed++;
+    }
+    for (ii = 0; ii < FileMax; ii++)
+    {
+        remove(_paths[ii]);
+    }
+    rmdir(tmpDir);
+
+    printf("backend_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
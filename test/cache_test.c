@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, cache_test.c, verifies the output cache.  A test SDL file,
+ *  which INCLUDEs another, is compiled to C by OpenSDL with --cache and
+ *  --stats=json, twice.  The first compilation must scan the input, and the
+ *  second must not, since its output comes from the cache.  Both must
+ *  generate the same output file and diagnostics.  Then the INCLUDE file is
+ *  changed, and the next compilation must scan the input again, and generate
+ *  what a compilation without the cache does.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#define CACHE_K_LINE		4096
+
+static const char _input[] =
+    "MODULE cache_test;\n"
+    "INCLUDE \"cache_inc.sdl\";\n"
+    "CONSTANT cache_value EQUALS 1;\n"
+    "AGGREGATE cache_rec STRUCTURE;\n"
+    "    cache_flag BYTE;\n"
+    "    cache_count LONGWORD;\n"
+    "END cache_rec;\n"
+    "END_MODULE;\n";
+static const char _include[] =
+    "CONSTANT include_value EQUALS 2;\n";
+static const char _includeChanged[] =
+    "CONSTANT include_value EQUALS 3;\n";
+
+/*
+ * Write the text to a file, and return zero if it was all written.
+ */
+static int _write(const char *fileName, const char *text)
+{
+    FILE *fp = fopen(fileName, "w");
+    bool ok;
+
+    if (fp == NULL)
+    {
+        return(-1);
+    }
+    ok = fputs(text, fp) >= 0;
+    return(((fclose(fp) == 0) && (ok == true)) ? 0 : -1);
+}
+
+/*
+ * Compile the input file to C, with the cache directory if there is one, and
+ * standard error written to the errors file.  Return the exit status.
+ */
+static int _compile(const char *errFile, bool cache)
+{
+    int status = 0;
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        int fd = open(errFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd >= 0)
+        {
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        if (cache == true)
+        {
+            execl(SDL_OPENSDL,
+                  SDL_OPENSDL,
+                  "--noheader",
+                  "--cache=cache",
+                  "--stats=json",
+                  "--lang=c=cache_test.h",
+                  "cache_test.sdl",
+                  (char *) NULL);
+        }
+        else
+        {
+            execl(SDL_OPENSDL,
+                  SDL_OPENSDL,
+                  "--noheader",
+                  "--lang=c=expected.h",
+                  "cache_test.sdl",
+                  (char *) NULL);
+        }
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Read the whole of a file into memory, and return it, or NULL if it could
+ * not be read.
+ */
+static char *_read(const char *fileName)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *retVal = NULL;
+    long size;
+
+    if (fp == NULL)
+    {
+        return(NULL);
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) &&
+        ((size = ftell(fp)) >= 0) &&
+        (fseek(fp, 0, SEEK_SET) == 0) &&
+        ((retVal = malloc(size + 1)) != NULL))
+    {
+        if (fread(retVal, 1, size, fp) == (size_t) size)
+        {
+            retVal[size] = '\0';
+        }
+        else
+        {
+            free(retVal);
+            retVal = NULL;
+        }
+    }
+    fclose(fp);
+    return(retVal);
+}
+
+/*
+ * Return true if the two files have the same contents.
+ */
+static bool _same(const char *first, const char *second)
+{
+    char *firstBuf = _read(first);
+    char *secondBuf = _read(second);
+    bool retVal;
+
+    retVal = (firstBuf != NULL) && (secondBuf != NULL) &&
+             (strcmp(firstBuf, secondBuf) == 0);
+    free(firstBuf);
+    free(secondBuf);
+    return(retVal);
+}
+
+/*
+ * Split the errors file into the diagnostics, which are written to their own
+ * file, and the statistics for the input file.  Return the number of tokens
+ * scanned, or -1 if there are no statistics for the input file.
+ */
+static long _tokens(const char *errFile, const char *diagFile)
+{
+    FILE *errFP = fopen(errFile, "r");
+    FILE *diagFP = fopen(diagFile, "w");
+    char line[CACHE_K_LINE];
+    long retVal = -1;
+
+    while ((errFP != NULL) &&
+           (diagFP != NULL) &&
+           (fgets(line, sizeof(line), errFP) != NULL))
+    {
+        char *tokens = strstr(line, "\"tokens\":");
+
+        if (line[0] != '{')
+        {
+            fputs(line, diagFP);
+        }
+        else if ((strncmp(line, "{\"file\":\"", 9) == 0) && (tokens != NULL))
+        {
+            retVal = strtol(&tokens[9], NULL, 10);
+        }
+    }
+    if (errFP != NULL)
+    {
+        fclose(errFP);
+    }
+    if (diagFP != NULL)
+    {
+        fclose(diagFP);
+    }
+    return(retVal);
+}
+
+/*
+ * Remove the files in the cache directory, and then the directory.
+ */
+static void _clean(const char *dirName)
+{
+    DIR *dir = opendir(dirName);
+    struct dirent *entry;
+    char path[PATH_MAX];
+
+    if (dir == NULL)
+    {
+        return;
+    }
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if ((strcmp(entry->d_name, ".") != 0) &&
+            (strcmp(entry->d_name, "..") != 0))
+        {
+            snprintf(path, sizeof(path), "%s/%s", dirName, entry->d_name);
+            remove(path);
+        }
+    }
+    closedir(dir);
+    rmdir(dirName);
+    return;
+}
+
+int main(void)
+{
+    char tmpDir[] = "/tmp/sdl_cacheXXXXXX";
+    long tokens;
+    int failed = 0;
+
+    if ((mkdtemp(tmpDir) == NULL) ||
+        (chdir(tmpDir) != 0) ||
+        (mkdir("cache", 0755) != 0) ||
+        (_write("cache_test.sdl", _input) != 0) ||
+        (_write("cache_inc.sdl", _include) != 0))
+    {
+        printf("cache_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+
+    /*
+     * The first compilation is a miss, and the second a hit.
+     */
+    if ((_compile("miss.err", true) != 0) ||
+        (rename("cache_test.h", "miss.h") != 0))
+    {
+        printf("cache_test: first compilation failed\n");
+        failed++;
+    }
+    else if ((tokens = _tokens("miss.err", "miss.diag")) <= 0)
+    {
+        printf("cache_test: first compilation scanned %ld tokens\n", tokens);
+        failed++;
+    }
+    else if (_compile("hit.err", true) != 0)
+    {
+        printf("cache_test: second compilation failed\n");
+        failed++;
+    }
+    else if ((tokens = _tokens("hit.err", "hit.diag")) != 0)
+    {
+        printf("cache_test: second compilation scanned %ld tokens\n", tokens);
+        failed++;
+    }
+    else if (_same("miss.h", "cache_test.h") == false)
+    {
+        printf("cache_test: output from the cache differs\n");
+        failed++;
+    }
+    else if (_same("miss.diag", "hit.diag") == false)
+    {
+        printf("cache_test: diagnostics from the cache differ\n");
+        failed++;
+    }
+
+    /*
+     * Once the INCLUDE file has changed, the cache must be missed.
+     */
+    if ((failed == 0) && (_write("cache_inc.sdl", _includeChanged) != 0))
+    {
+        printf("cache_test: unable to change cache_inc.sdl (%s)\n",
+               strerror(errno));
+        failed++;
+    }
+    if (failed == 0)
+    {
+        if ((_compile("changed.err", true) != 0) ||
+            (_compile("expected.err", false) != 0))
+        {
+            printf("cache_test: third compilation failed\n");
+            failed++;
+        }
+        else if ((tokens = _tokens("changed.err", "changed.diag")) <= 0)
+        {
+            printf("cache_test: changed INCLUDE file scanned %ld tokens\n",
+                   tokens);
+            failed++;
+        }
+        else if (_same("expected.h", "cache_test.h") == false)
+        {
+            printf("cache_test: changed INCLUDE file was not used\n");
+            failed++;
+        }
+    }
+    _clean("cache");
+    remove("cache_test.sdl");
+    remove("cache_inc.sdl");
+    remove("cache_test.h");
+    remove("expected.h");
+    remove("miss.h");
+    remove("miss.err");
+    remove("miss.diag");
+    remove("hit.err");
+    remove("hit.diag");
+    remove("changed.err");
+    remove("changed.diag");
+    remove("expected.err");
+    if (chdir("/") == 0)
+    {
+        rmdir(tmpDir);
+    }
+
+    printf("cache_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
@@ -0,0 +1,465 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, counters_test.c, verifies that --counters does no harm when the
+ *  hardware counters cannot be read.  Two SDL files are compiled to C by
+ *  OpenSDL, with -j2, without --counters, and then with it, both as JSON and
+ *  as text, with perf_event_open made to fail with EACCES by a seccomp
+ *  filter.  The compilations must succeed and generate the same output
+ *  files, and the statistics must say why there are no counters, rather than
+ *  having any.  Without the filter, the compilation must succeed too, with
+ *  whatever counters this system has.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#ifdef __linux__
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#endif
+
+#define COUNTERS_K_ARGS		16
+#define COUNTERS_K_LINE		8192
+
+static const char *_files[][2] =
+{
+    {
+        "counters_1.sdl",
+        "MODULE counters_1;\n"
+        "CONSTANT first_value EQUALS 1;\n"
+        "AGGREGATE first_rec STRUCTURE;\n"
+        "    flag BYTE;\n"
+        "    count LONGWORD;\n"
+        "END first_rec;\n"
+        "END_MODULE;\n"
+    },
+    {
+        "counters_2.sdl",
+        "MODULE counters_2;\n"
+        "CONSTANT second_value EQUALS 2;\n"
+        "ITEM second_item QUADWORD;\n"
+        "END_MODULE;\n"
+    }
+};
+#define COUNTERS_K_FILES	(sizeof(_files) / sizeof(_files[0]))
+
+static const char *_outputs[COUNTERS_K_FILES] =
+{
+    "counters_1.h",
+    "counters_2.h"
+};
+
+/*
+ * How the statistics are asked for: as JSON without the counters, and with
+ * them as JSON or as text.
+ */
+typedef enum
+{
+    Plain,
+    Json,
+    Text
+} COUNTERS_RUN;
+
+#ifdef __linux__
+/*
+ * Make perf_event_open fail with EACCES, as it does when the counters are
+ * not allowed, for this process and the ones it runs.
+ */
+static int _deny_counters(void)
+{
+    struct sock_filter filter[] =
+    {
+        BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, nr)),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_perf_event_open, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | EACCES),
+        BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW)
+    };
+    struct sock_fprog program =
+    {
+        sizeof(filter) / sizeof(filter[0]),
+        filter
+    };
+
+    if ((prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) != 0) ||
+        (prctl(PR_SET_SECCOMP, SECCOMP_MODE_FILTER, &program) != 0))
+    {
+        return(-1);
+    }
+    return(0);
+}
+#endif
+
+/*
+ * Compile the input files, with the statistics asked for, and the counters
+ * denied or not, with standard error written to the errors file.  Return
+ * the exit status.
+ */
+static int _compile(COUNTERS_RUN run, bool deny, const char *errFile)
+{
+    const char *args[COUNTERS_K_ARGS];
+    int status = 0;
+    int count = 0;
+    pid_t pid;
+    int ii;
+
+    args[count++] = SDL_OPENSDL;
+    args[count++] = "--noheader";
+    args[count++] = "-j2";
+    if (run != Plain)
+    {
+        args[count++] = "--counters";
+    }
+    if (run != Text)
+    {
+        args[count++] = "--stats=json";
+    }
+    args[count++] = "--lang=c";
+    for (ii = 0; ii < COUNTERS_K_FILES; ii++)
+    {
+        args[count++] = _files[ii][0];
+    }
+    args[count] = NULL;
+    pid = fork();
+    if (pid == 0)
+    {
+        int fd = open(errFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd >= 0)
+        {
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+#ifdef __linux__
+        if ((deny == true) && (_deny_counters() != 0))
+        {
+            _exit(126);
+        }
+#endif
+        execv(SDL_OPENSDL, (char **) args);
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Read the whole of a file into memory, and return it, or NULL if it could
+ * not be read.
+ */
+static char *_read(const char *fileName)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *retVal = NULL;
+    long size;
+
+    if (fp == NULL)
+    {
+        return(NULL);
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) &&
+        ((size = ftell(fp)) >= 0) &&
+        (fseek(fp, 0, SEEK_SET) == 0) &&
+        ((retVal = malloc(size + 1)) != NULL))
+    {
+        if (fread(retVal, 1, size, fp) == (size_t) size)
+        {
+            retVal[size] = '\0';
+        }
+        else
+        {
+            free(retVal);
+            retVal = NULL;
+        }
+    }
+    fclose(fp);
+    return(retVal);
+}
+
+/*
+ * Return true if the two files have the same contents.
+ */
+static bool _same(const char *first, const char *second)
+{
+    char *firstBuf = _read(first);
+    char *secondBuf = _read(second);
+    bool retVal;
+
+    retVal = (firstBuf != NULL) && (secondBuf != NULL) &&
+             (strcmp(firstBuf, secondBuf) == 0);
+    free(firstBuf);
+    free(secondBuf);
+    return(retVal);
+}
+
+/*
+ * Return true if a line of JSON statistics has any of the counters in it.
+ */
+static bool _counters(const char *line)
+{
+    return((strstr(line, "\"cycles\":") != NULL) ||
+           (strstr(line, "\"instructions\":") != NULL) ||
+           (strstr(line, "\"cache_misses\":") != NULL) ||
+           (strstr(line, "\"branch_misses\":") != NULL));
+}
+
+/*
+ * Check each line of JSON statistics.  When the counters were denied, each
+ * must say so, and have none of them.  Otherwise, a line may only say why
+ * there are no counters when it has none.  Return the number of failures.
+ */
+static int _json(const char *errFile, bool denied)
+{
+    FILE *fp = fopen(errFile, "r");
+    char line[COUNTERS_K_LINE];
+    char reason[COUNTERS_K_LINE];
+    bool counters, unavailable;
+    int lines = 0;
+    int retVal = 0;
+
+    snprintf(reason,
+             sizeof(reason),
+             "\"counters_unavailable\":\"%s\"}",
+             strerror(EACCES));
+    while ((fp != NULL) && (fgets(line, sizeof(line), fp) != NULL))
+    {
+        if (line[0] != '{')
+        {
+            continue;
+        }
+        counters = _counters(line);
+        unavailable = strstr(line, "\"counters_unavailable\":") != NULL;
+        if ((denied == true) &&
+            ((counters == true) || (strstr(line, reason) == NULL)))
+        {
+            printf("counters_test: denied counters reported as: %s", line);
+            retVal++;
+        }
+        else if ((denied == false) &&
+                 (counters == true) &&
+                 (unavailable == true))
+        {
+            printf("counters_test: counters reported as: %s", line);
+            retVal++;
+        }
+        lines++;
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+    if (lines != (COUNTERS_K_FILES + 1))
+    {
+        printf("counters_test: %d lines of statistics, expected %d\n",
+               lines,
+               (int) (COUNTERS_K_FILES + 1));
+        retVal++;
+    }
+    return(retVal);
+}
+
+/*
+ * Check the text statistics, when the counters were denied.  Each set of
+ * them must say why there are no counters, and have none.  Return the number
+ * of failures.
+ */
+static int _text(const char *errFile)
+{
+    FILE *fp = fopen(errFile, "r");
+    char line[COUNTERS_K_LINE];
+    char reason[COUNTERS_K_LINE];
+    int sets = 0;
+    int reasons = 0;
+    int retVal = 0;
+
+    snprintf(reason,
+             sizeof(reason),
+             "  Hardware counters are not available: %s\n",
+             strerror(EACCES));
+    while ((fp != NULL) && (fgets(line, sizeof(line), fp) != NULL))
+    {
+        if (strncmp(line, "Statistics for ", 15) == 0)
+        {
+            sets++;
+        }
+        else if (strcmp(line, reason) == 0)
+        {
+            reasons++;
+        }
+        else if (strncmp(line, "  Counters ", 11) == 0)
+        {
+            printf("counters_test: denied counters reported\n");
+            retVal++;
+        }
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+    if ((sets != (COUNTERS_K_FILES + 1)) || (reasons != sets))
+    {
+        printf("counters_test: %d sets of statistics, %d saying why there "
+                   "are no counters\n",
+               sets,
+               reasons);
+        retVal++;
+    }
+    return(retVal);
+}
+
+int main(void)
+{
+#ifdef __linux__
+    char tmpDir[] = "/tmp/sdl_countersXXXXXX";
+    char plain[COUNTERS_K_FILES][PATH_MAX];
+    FILE *fp;
+    int failed = 0;
+    int status;
+    int ii;
+
+    if ((mkdtemp(tmpDir) == NULL) || (chdir(tmpDir) != 0))
+    {
+        printf("counters_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    for (ii = 0; ii < COUNTERS_K_FILES; ii++)
+    {
+        if (((fp = fopen(_files[ii][0], "w")) == NULL) ||
+            (fputs(_files[ii][1], fp) < 0) ||
+            (fclose(fp) != 0))
+        {
+            printf("counters_test: unable to write %s (%s)\n",
+                   _files[ii][0],
+                   strerror(errno));
+            return(1);
+        }
+        snprintf(plain[ii], sizeof(plain[ii]), "plain_%s", _outputs[ii]);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+
+    /*
+     * Compile without the counters, to get the output files.
+     */
+    if (_compile(Plain, false, "plain.err") != 0)
+    {
+        printf("counters_test: compilation without --counters failed\n");
+        failed++;
+    }
+    for (ii = 0; ii < COUNTERS_K_FILES; ii++)
+    {
+        if (rename(_outputs[ii], plain[ii]) != 0)
+        {
+            printf("counters_test: %s was not written\n", _outputs[ii]);
+            failed++;
+        }
+    }
+
+    /*
+     * With the counters denied, the compilations succeed, and say why there
+     * are no counters.
+     */
+    if (failed == 0)
+    {
+        status = _compile(Json, true, "denied.err");
+        if (status == 126)
+        {
+            printf("counters_test: unable to deny the counters, so that is "
+                       "not tested\n");
+        }
+        else if (status != 0)
+        {
+            printf("counters_test: compilation with denied counters exited "
+                       "with %d\n",
+                   status);
+            failed++;
+        }
+        else
+        {
+            failed += _json("denied.err", true);
+            for (ii = 0; ii < COUNTERS_K_FILES; ii++)
+            {
+                if (_same(plain[ii], _outputs[ii]) == false)
+                {
+                    printf("counters_test: %s differs with denied counters\n",
+                           _outputs[ii]);
+                    failed++;
+                }
+            }
+            if (_compile(Text, true, "text.err") != 0)
+            {
+                printf("counters_test: compilation with denied counters, and "
+                           "text statistics, failed\n");
+                failed++;
+            }
+            else
+            {
+                failed += _text("text.err");
+            }
+        }
+    }
+
+    /*
+     * Whatever counters this system has, the compilation succeeds.
+     */
+    if (_compile(Json, false, "allowed.err") != 0)
+    {
+        printf("counters_test: compilation with --counters failed\n");
+        failed++;
+    }
+    else
+    {
+        failed += _json("allowed.err", false);
+    }
+    for (ii = 0; ii < COUNTERS_K_FILES; ii++)
+    {
+        remove(_files[ii][0]);
+        remove(_outputs[ii]);
+        remove(plain[ii]);
+    }
+    remove("plain.err");
+    remove("denied.err");
+    remove("text.err");
+    remove("allowed.err");
+    if (chdir("/") == 0)
+    {
+        rmdir(tmpDir);
+    }
+
+    printf("counters_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+#else
+    printf("counters_test: the counters are only read on Linux, 0 failed\n");
+    return(0);
+#endif
+}
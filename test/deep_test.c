@@ -0,0 +1,330 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, deep_test.c, verifies deeply nested input.  A test SDL file,
+ *  with IFSYMBOLs, each with an ELSE in it, and subaggregates nested many
+ *  times deeper than the conditional state stack starts out, and an inactive
+ *  region with as many IFSYMBOLs nested in it, is compiled to C by OpenSDL
+ *  with --trace.  Every level must generate what it should, and nothing in
+ *  an inactive region may be generated.  The memory profile must show that
+ *  the state stack and the conditional state stack grew, and that nothing
+ *  was left in either of them when the compilation was done.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define DEEP_K_DEPTH		64
+#define DEEP_K_LINE		256
+#define DEEP_K_NAME		32
+
+/*
+ * Write the test SDL file, and return zero if it was all written.
+ */
+static int _write(const char *fileName)
+{
+    FILE *fp = fopen(fileName, "w");
+    bool ok;
+    int ii;
+
+    if (fp == NULL)
+    {
+        return(-1);
+    }
+    fprintf(fp, "MODULE deep_test;\n");
+
+    /*
+     * Each level is active, and has an inactive IFSYMBOL with an active ELSE
+     * in it.
+     */
+    for (ii = 1; ii <= DEEP_K_DEPTH; ii++)
+    {
+        fprintf(fp,
+                "IFSYMBOL on;\n"
+                "CONSTANT in_%d_x EQUALS %d;\n"
+                "IFSYMBOL off;\n"
+                "CONSTANT off_%d_x EQUALS %d;\n"
+                "ELSE;\n"
+                "CONSTANT else_%d_x EQUALS %d;\n"
+                "END_IFSYMBOL;\n",
+                ii, ii, ii, ii, ii, ii);
+    }
+    for (ii = 1; ii <= DEEP_K_DEPTH; ii++)
+    {
+        fprintf(fp, "END_IFSYMBOL;\n");
+    }
+
+    /*
+     * An inactive region with the IFSYMBOLs nested in it.
+     */
+    fprintf(fp, "IFSYMBOL off;\n");
+    for (ii = 1; ii <= DEEP_K_DEPTH; ii++)
+    {
+        fprintf(fp,
+                "IFSYMBOL on;\n"
+                "CONSTANT skipped_%d_x EQUALS %d;\n",
+                ii, ii);
+    }
+    for (ii = 1; ii <= DEEP_K_DEPTH; ii++)
+    {
+        fprintf(fp, "END_IFSYMBOL;\n");
+    }
+    fprintf(fp,
+            "ELSE;\n"
+            "CONSTANT after_x EQUALS 0;\n"
+            "END_IFSYMBOL;\n");
+
+    /*
+     * The subaggregates, with a member at each level.
+     */
+    fprintf(fp, "AGGREGATE deep_rec STRUCTURE;\n");
+    for (ii = 1; ii <= DEEP_K_DEPTH; ii++)
+    {
+        fprintf(fp,
+                "level_%d_x STRUCTURE;\n"
+                "field_%d_x BYTE;\n",
+                ii, ii);
+    }
+    fprintf(fp, "leaf_x LONGWORD;\n");
+    for (ii = DEEP_K_DEPTH; ii >= 1; ii--)
+    {
+        fprintf(fp, "END level_%d_x;\n", ii);
+    }
+    fprintf(fp, "END deep_rec;\nEND_MODULE;\n");
+    ok = ferror(fp) == 0;
+    return(((fclose(fp) == 0) && (ok == true)) ? 0 : -1);
+}
+
+/*
+ * Compile the test SDL file, with standard error written to the errors file,
+ * and return the exit status.
+ */
+static int _compile(const char *errFile)
+{
+    int status = 0;
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        int fd = open(errFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd >= 0)
+        {
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        execl(SDL_OPENSDL,
+              SDL_OPENSDL,
+              "--noheader",
+              "--trace",
+              "--symbol=on=1",
+              "--symbol=off=0",
+              "--lang=c",
+              "deep_test.sdl",
+              (char *) NULL);
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Read the whole of a file into memory, and return it, or NULL if it could
+ * not be read.
+ */
+static char *_read(const char *fileName)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *retVal = NULL;
+    long size;
+
+    if (fp == NULL)
+    {
+        return(NULL);
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) &&
+        ((size = ftell(fp)) >= 0) &&
+        (fseek(fp, 0, SEEK_SET) == 0) &&
+        ((retVal = malloc(size + 1)) != NULL))
+    {
+        if (fread(retVal, 1, size, fp) == (size_t) size)
+        {
+            retVal[size] = '\0';
+        }
+        else
+        {
+            free(retVal);
+            retVal = NULL;
+        }
+    }
+    fclose(fp);
+    return(retVal);
+}
+
+/*
+ * Check that a name is, or is not, in the output, and return the number of
+ * failures.
+ */
+static int _expect(const char *output, const char *name, bool present)
+{
+    if ((strstr(output, name) != NULL) != present)
+    {
+        printf("deep_test: %s %s in the output\n",
+               name,
+               (present == true) ? "is not" : "is");
+        return(1);
+    }
+    return(0);
+}
+
+/*
+ * Check the line of the memory profile for a site.  It must have been
+ * allocated at least the number of times given, and nothing of it may still
+ * be in use.  Return the number of failures.
+ */
+static int _site(const char *errFile, const char *site, unsigned long allocs)
+{
+    FILE *fp = fopen(errFile, "r");
+    char line[DEEP_K_LINE];
+    char name[DEEP_K_LINE];
+    unsigned long count, frees, bytes, peak, inUse;
+    bool found = false;
+    int retVal = 1;
+
+    while ((found == false) &&
+           (fp != NULL) &&
+           (fgets(line, sizeof(line), fp) != NULL))
+    {
+        if ((sscanf(line,
+                    "%s %lu %lu %lu %lu %lu",
+                    name,
+                    &count,
+                    &frees,
+                    &bytes,
+                    &peak,
+                    &inUse) == 6) &&
+            (strcmp(name, site) == 0))
+        {
+            found = true;
+            if ((count < allocs) || (inUse != 0))
+            {
+                printf("deep_test: %s was allocated %lu times, and %lu bytes "
+                           "are still in use\n",
+                       site,
+                       count,
+                       inUse);
+            }
+            else
+            {
+                retVal = 0;
+            }
+        }
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+    if (found == false)
+    {
+        printf("deep_test: %s is not in the memory profile\n", site);
+    }
+    return(retVal);
+}
+
+int main(void)
+{
+    char tmpDir[] = "/tmp/sdl_deepXXXXXX";
+    char name[DEEP_K_NAME];
+    char *output;
+    int failed = 0;
+    int ii;
+
+    if ((mkdtemp(tmpDir) == NULL) ||
+        (chdir(tmpDir) != 0) ||
+        (_write("deep_test.sdl") != 0))
+    {
+        printf("deep_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+
+    if (_compile("deep_test.err") != 0)
+    {
+        printf("deep_test: compilation failed\n");
+        failed++;
+    }
+    else if ((output = _read("deep_test.h")) == NULL)
+    {
+        printf("deep_test: deep_test.h was not written\n");
+        failed++;
+    }
+    else
+    {
+        for (ii = 1; ii <= DEEP_K_DEPTH; ii++)
+        {
+            snprintf(name, sizeof(name), "in_%d_x", ii);
+            failed += _expect(output, name, true);
+            snprintf(name, sizeof(name), "else_%d_x", ii);
+            failed += _expect(output, name, true);
+            snprintf(name, sizeof(name), "off_%d_x", ii);
+            failed += _expect(output, name, false);
+            snprintf(name, sizeof(name), "skipped_%d_x", ii);
+            failed += _expect(output, name, false);
+            snprintf(name, sizeof(name), "level_%d_x", ii);
+            failed += _expect(output, name, true);
+            snprintf(name, sizeof(name), "field_%d_x", ii);
+            failed += _expect(output, name, true);
+        }
+        failed += _expect(output, "after_x", true);
+        failed += _expect(output, "leaf_x", true);
+        free(output);
+
+        /*
+         * The state stack has an entry for the MODULE, the AGGREGATE and each
+         * subaggregate, and is grown by one at a time.  The conditional state
+         * stack starts out with 8 entries, and is grown by 8 at a time.
+         */
+        failed += _site("deep_test.err", "state_stack", DEEP_K_DEPTH + 2);
+        failed += _site("deep_test.err", "cond_stack", DEEP_K_DEPTH / 8);
+    }
+    remove("deep_test.sdl");
+    remove("deep_test.h");
+    remove("deep_test.err");
+    if (chdir("/") == 0)
+    {
+        rmdir(tmpDir);
+    }
+
+    printf("deep_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
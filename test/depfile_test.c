@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, depfile_test.c, verifies dependency files.  A test SDL file
+ *  INCLUDEs a chain of files, one of them twice, and has another INCLUDE in
+ *  an inactive IFSYMBOL region.  It is compiled by OpenSDL with --depfile,
+ *  first with the output and dependency file names given, and then with the
+ *  default ones.  Each dependency file must be exactly what "cc -MD -MP"
+ *  would write: the output files depending on the input file and each
+ *  INCLUDE file that was opened, once, in the order they were opened, and an
+ *  empty rule for each INCLUDE file.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+static const char *_files[][2] =
+{
+    {
+        "depfile_test.sdl",
+        "MODULE depfile_test;\n"
+        "INCLUDE \"dep_a.sdl\";\n"
+        "IFSYMBOL never;\n"
+        "INCLUDE \"dep_skip.sdl\";\n"
+        "END_IFSYMBOL;\n"
+        "INCLUDE \"dep_b.sdl\";\n"
+        "CONSTANT main_value EQUALS 0;\n"
+        "END_MODULE;\n"
+    },
+    {
+        "dep_a.sdl",
+        "CONSTANT a_value EQUALS 1;\n"
+        "INCLUDE \"dep_b.sdl\";\n"
+    },
+    {
+        "dep_b.sdl",
+        "{ Included by dep_a.sdl and depfile_test.sdl.\n"
+        "INCLUDE \"dep_c.sdl\";\n"
+    },
+    {
+        "dep_c.sdl",
+        "{ The end of the INCLUDE chain.\n"
+    },
+    {
+        "dep_skip.sdl",
+        "CONSTANT skip_value EQUALS 2;\n"
+    }
+};
+#define DEPFILE_K_FILES		(sizeof(_files) / sizeof(_files[0]))
+
+static const char _named[] =
+    "depfile_test.h depfile_test.sdlrec: depfile_test.sdl \\\n"
+    " dep_a.sdl \\\n"
+    " dep_b.sdl \\\n"
+    " dep_c.sdl\n"
+    "\n"
+    "dep_a.sdl:\n"
+    "\n"
+    "dep_b.sdl:\n"
+    "\n"
+    "dep_c.sdl:\n";
+static const char _default[] =
+    "depfile_test.h: depfile_test.sdl \\\n"
+    " dep_a.sdl \\\n"
+    " dep_b.sdl \\\n"
+    " dep_c.sdl\n"
+    "\n"
+    "dep_a.sdl:\n"
+    "\n"
+    "dep_b.sdl:\n"
+    "\n"
+    "dep_c.sdl:\n";
+
+/*
+ * Compile the input file with a dependency file, with the output and
+ * dependency file names given or not, and return the exit status.
+ */
+static int _compile(bool named)
+{
+    int status = 0;
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        if (named == true)
+        {
+            execl(SDL_OPENSDL,
+                  SDL_OPENSDL,
+                  "--symbol=never=0",
+                  "--depfile=named.d",
+                  "--lang=c=depfile_test.h",
+                  "--lang=record=depfile_test.sdlrec",
+                  "depfile_test.sdl",
+                  (char *) NULL);
+        }
+        else
+        {
+            execl(SDL_OPENSDL,
+                  SDL_OPENSDL,
+                  "--symbol=never=0",
+                  "--depfile",
+                  "--lang=c",
+                  "depfile_test.sdl",
+                  (char *) NULL);
+        }
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Read the whole of a file into memory, and return it, or NULL if it could
+ * not be read.
+ */
+static char *_read(const char *fileName)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *retVal = NULL;
+    long size;
+
+    if (fp == NULL)
+    {
+        return(NULL);
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) &&
+        ((size = ftell(fp)) >= 0) &&
+        (fseek(fp, 0, SEEK_SET) == 0) &&
+        ((retVal = malloc(size + 1)) != NULL))
+    {
+        if (fread(retVal, 1, size, fp) == (size_t) size)
+        {
+            retVal[size] = '\0';
+        }
+        else
+        {
+            free(retVal);
+            retVal = NULL;
+        }
+    }
+    fclose(fp);
+    return(retVal);
+}
+
+/*
+ * Check a dependency file against what is expected, and return the number
+ * of failures.
+ */
+static int _expect(const char *depFile, const char *expected)
+{
+    char *contents = _read(depFile);
+    int retVal = 0;
+
+    if (contents == NULL)
+    {
+        printf("depfile_test: %s was not written\n", depFile);
+        retVal++;
+    }
+    else if (strcmp(contents, expected) != 0)
+    {
+        printf("depfile_test: %s is\n%s\nexpected\n%s\n",
+               depFile,
+               contents,
+               expected);
+        retVal++;
+    }
+    free(contents);
+    return(retVal);
+}
+
+int main(void)
+{
+    char tmpDir[] = "/tmp/sdl_depfileXXXXXX";
+    FILE *fp;
+    int failed = 0;
+    int ii;
+
+    if ((mkdtemp(tmpDir) == NULL) || (chdir(tmpDir) != 0))
+    {
+        printf("depfile_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    for (ii = 0; ii < DEPFILE_K_FILES; ii++)
+    {
+        if (((fp = fopen(_files[ii][0], "w")) == NULL) ||
+            (fputs(_files[ii][1], fp) < 0) ||
+            (fclose(fp) != 0))
+        {
+            printf("depfile_test: unable to write %s (%s)\n",
+                   _files[ii][0],
+                   strerror(errno));
+            return(1);
+        }
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+
+    if (_compile(true) != 0)
+    {
+        printf("depfile_test: compilation with file names failed\n");
+        failed++;
+    }
+    else
+    {
+        failed += _expect("named.d", _named);
+    }
+    remove("depfile_test.h");
+    if (_compile(false) != 0)
+    {
+        printf("depfile_test: compilation with default file names failed\n");
+        failed++;
+    }
+    else
+    {
+        failed += _expect("depfile_test.d", _default);
+    }
+    for (ii = 0; ii < DEPFILE_K_FILES; ii++)
+    {
+        remove(_files[ii][0]);
+    }
+    remove("named.d");
+    remove("depfile_test.d");
+    remove("depfile_test.h");
+    remove("depfile_test.sdlrec");
+    if (chdir("/") == 0)
+    {
+        rmdir(tmpDir);
+    }
+
+    printf("depfile_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
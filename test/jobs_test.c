@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, jobs_test.c, verifies compiling many input files at the same
+ *  time.  The test SDL files, with two that have errors in them among them,
+ *  are copied into two directories.  In one, they are all compiled by one
+ *  run of OpenSDL with -j1, and in the other, with -j4 from a response file.
+ *  Each output file, the diagnostics, in the order they were written, and
+ *  the exit status must be the same for both.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#define JOBS_K_ARGS		32
+
+/*
+ * The input files, in the order they are compiled, and the output file for
+ * each.  The ones without a directory are written by the test.
+ */
+static const char *_files[][2] =
+{
+    {SDL_TEST_DIR "/SDLNODEF.SDL",	"SDLNODEF.h"},
+    {SDL_TEST_DIR "/SDLSHR.SDL",	"SDLSHR.h"},
+    {"bad_1.sdl",			"bad_1.h"},
+    {SDL_TEST_DIR "/SDLTOKDEF.SDL",	"SDLTOKDEF.h"},
+    {SDL_TEST_DIR "/SDLTYPDEF.SDL",	"SDLTYPDEF.h"},
+    {SDL_TEST_DIR "/STSDEF.SDL",	"STSDEF.h"},
+    {SDL_TEST_DIR "/example_1_1.sdl",	"example_1_1.h"},
+    {SDL_TEST_DIR "/test_1.sdl",	"test_1.h"},
+    {SDL_TEST_DIR "/test_2.sdl",	"test_2.h"},
+    {SDL_TEST_DIR "/test_3.sdl",	"test_3.h"},
+    {"bad_2.sdl",			"bad_2.h"},
+    {SDL_TEST_DIR "/test_4.sdl",	"test_4.h"},
+    {SDL_TEST_DIR "/test_5.sdl",	"test_5.h"},
+    {SDL_TEST_DIR "/test_6.sdl",	"test_6.h"},
+    {SDL_TEST_DIR "/test_7.sdl",	"test_7.h"},
+    {SDL_TEST_DIR "/test_8.sdl",	"test_8.h"},
+    {SDL_TEST_DIR "/test_9.sdl",	"test_9.h"}
+};
+#define JOBS_K_FILES		(sizeof(_files) / sizeof(_files[0]))
+
+static const char _bad1[] =
+    "MODULE bad_1;\n"
+    "CONSTANT EQUALS 1;\n"
+    "END_MODULE;\n";
+static const char _bad2[] =
+    "MODULE bad_2;\n"
+    "AGGREGATE bad_rec STRUCTURE;\n"
+    "    field LONGWORD;\n"
+    "END other_rec;\n"
+    "END_MODULE;\n";
+
+/*
+ * Run OpenSDL with the arguments, in the directory, with standard error
+ * written to the errors file, and return the exit status.
+ */
+static int _run(const char *dirName, const char *errFile, const char **args)
+{
+    int status = 0;
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        int fd = open(errFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd >= 0)
+        {
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        if (chdir(dirName) == 0)
+        {
+            execv(SDL_OPENSDL, (char **) args);
+        }
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Read the whole of a file into memory, and return it, or NULL if it could
+ * not be read.
+ */
+static char *_read(const char *fileName, size_t *length)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *retVal = NULL;
+    long size;
+
+    if (fp == NULL)
+    {
+        return(NULL);
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) &&
+        ((size = ftell(fp)) >= 0) &&
+        (fseek(fp, 0, SEEK_SET) == 0) &&
+        ((retVal = malloc(size + 1)) != NULL))
+    {
+        if (fread(retVal, 1, size, fp) == (size_t) size)
+        {
+            retVal[size] = '\0';
+            *length = size;
+        }
+        else
+        {
+            free(retVal);
+            retVal = NULL;
+        }
+    }
+    fclose(fp);
+    return(retVal);
+}
+
+/*
+ * Write the buffer to a file, and return zero if it was all written.
+ */
+static int _write(const char *fileName, const char *buffer, size_t length)
+{
+    FILE *fp = fopen(fileName, "w");
+    bool ok;
+
+    if (fp == NULL)
+    {
+        return(-1);
+    }
+    ok = fwrite(buffer, 1, length, fp) == length;
+    return(((fclose(fp) == 0) && (ok == true)) ? 0 : -1);
+}
+
+/*
+ * Copy an input file, or write one of the ones with errors, into the
+ * directory, and return zero if it was written.
+ */
+static int _copy(const char *dirName, const char *fileName)
+{
+    const char *baseName = strrchr(fileName, '/');
+    char path[PATH_MAX];
+    size_t length = 0;
+    char *buffer;
+    int retVal;
+
+    snprintf(path,
+             sizeof(path),
+             "%s/%s",
+             dirName,
+             (baseName != NULL) ? &baseName[1] : fileName);
+    if (strcmp(fileName, "bad_1.sdl") == 0)
+    {
+        return(_write(path, _bad1, strlen(_bad1)));
+    }
+    if (strcmp(fileName, "bad_2.sdl") == 0)
+    {
+        return(_write(path, _bad2, strlen(_bad2)));
+    }
+    if ((buffer = _read(fileName, &length)) == NULL)
+    {
+        return(-1);
+    }
+    retVal = _write(path, buffer, length);
+    free(buffer);
+    return(retVal);
+}
+
+/*
+ * Return true if the two files have the same contents, or neither of them
+ * exists.
+ */
+static bool _same(const char *first, const char *second)
+{
+    size_t firstLen = 0;
+    size_t secondLen = 0;
+    char *firstBuf = _read(first, &firstLen);
+    char *secondBuf = _read(second, &secondLen);
+    bool retVal;
+
+    if ((firstBuf == NULL) || (secondBuf == NULL))
+    {
+        retVal = (firstBuf == NULL) && (secondBuf == NULL) &&
+                 (access(first, F_OK) != 0) && (access(second, F_OK) != 0);
+    }
+    else
+    {
+        retVal = (firstLen == secondLen) &&
+                 (memcmp(firstBuf, secondBuf, firstLen) == 0);
+    }
+    free(firstBuf);
+    free(secondBuf);
+    return(retVal);
+}
+
+/*
+ * Remove the input and output files from the directory, and then the
+ * directory.
+ */
+static void _clean(const char *dirName)
+{
+    const char *baseName;
+    char path[PATH_MAX];
+    int ii;
+
+    for (ii = 0; ii < JOBS_K_FILES; ii++)
+    {
+        baseName = strrchr(_files[ii][0], '/');
+        snprintf(path,
+                 sizeof(path),
+                 "%s/%s",
+                 dirName,
+                 (baseName != NULL) ? &baseName[1] : _files[ii][0]);
+        remove(path);
+        snprintf(path, sizeof(path), "%s/%s", dirName, _files[ii][1]);
+        remove(path);
+    }
+    snprintf(path, sizeof(path), "%s/inputs.rsp", dirName);
+    remove(path);
+    rmdir(dirName);
+    return;
+}
+
+int main(void)
+{
+    char tmpDir[] = "/tmp/sdl_jobsXXXXXX";
+    const char *args[JOBS_K_ARGS];
+    char first[PATH_MAX];
+    char second[PATH_MAX];
+    const char *baseName;
+    FILE *fp = NULL;
+    int serial, parallel;
+    int failed = 0;
+    int count;
+    int ii;
+
+    if ((mkdtemp(tmpDir) == NULL) ||
+        (chdir(tmpDir) != 0) ||
+        (mkdir("serial", 0755) != 0) ||
+        (mkdir("parallel", 0755) != 0) ||
+        ((fp = fopen("parallel/inputs.rsp", "w")) == NULL))
+    {
+        printf("jobs_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+
+    /*
+     * Copy the input files into both directories, and list them in the
+     * response file, in the same order they are given to the serial run.
+     */
+    count = 0;
+    args[count++] = SDL_OPENSDL;
+    args[count++] = "--noheader";
+    args[count++] = "-j1";
+    args[count++] = "--lang=c";
+    for (ii = 0; ii < JOBS_K_FILES; ii++)
+    {
+        baseName = strrchr(_files[ii][0], '/');
+        baseName = (baseName != NULL) ? &baseName[1] : _files[ii][0];
+        if ((_copy("serial", _files[ii][0]) != 0) ||
+            (_copy("parallel", _files[ii][0]) != 0))
+        {
+            printf("jobs_test: unable to copy %s\n", _files[ii][0]);
+            failed++;
+        }
+        args[count++] = baseName;
+        fprintf(fp, "%s\n", baseName);
+    }
+    args[count] = NULL;
+    if (fclose(fp) != 0)
+    {
+        printf("jobs_test: unable to write the response file\n");
+        failed++;
+    }
+
+    /*
+     * Compile them all one at a time, and then 4 at a time.
+     */
+    if (failed == 0)
+    {
+        serial = _run("serial", "serial.err", args);
+        count = 0;
+        args[count++] = SDL_OPENSDL;
+        args[count++] = "--noheader";
+        args[count++] = "-j4";
+        args[count++] = "--lang=c";
+        args[count++] = "@inputs.rsp";
+        args[count] = NULL;
+        parallel = _run("parallel", "parallel.err", args);
+        if ((serial < 0) || (serial == 127) || (serial != parallel))
+        {
+            printf("jobs_test: exit status %d with -j1, %d with -j4\n",
+                   serial,
+                   parallel);
+            failed++;
+        }
+        if (_same("serial.err", "parallel.err") == false)
+        {
+            printf("jobs_test: diagnostics differ with -j4\n");
+            failed++;
+        }
+        for (ii = 0; ii < JOBS_K_FILES; ii++)
+        {
+            snprintf(first, sizeof(first), "serial/%s", _files[ii][1]);
+            snprintf(second, sizeof(second), "parallel/%s", _files[ii][1]);
+            if (_same(first, second) == false)
+            {
+                printf("jobs_test: %s differs with -j4\n", _files[ii][1]);
+                failed++;
+            }
+        }
+    }
+    _clean("serial");
+    _clean("parallel");
+    remove("serial.err");
+    remove("parallel.err");
+    if (chdir("/") == 0)
+    {
+        rmdir(tmpDir);
+    }
+
+    printf("jobs_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, layout_test.c, verifies that the layout of a whole AGGREGATE,
+ *  given to a plugin in one call, generates what calling the plugin for each
+ *  entry in it does.  Each test SDL file, and one with nested, dimensioned
+ *  and bitfield members in it, is compiled by OpenSDL to C, which is given
+ *  the layout, and to the "member" language (see member_plugin.c), which is
+ *  the C language without its SDL_API_AGGREGATE_V2 function.  The output
+ *  files, the diagnostics and the exit status must be the same.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+static const char *_files[] =
+{
+    "SDLNODEF.SDL",
+    "SDLSHR.SDL",
+    "SDLTOKDEF.SDL",
+    "SDLTYPDEF.SDL",
+    "STSDEF.SDL",
+    "example_1_1.sdl",
+    "test_1.sdl",
+    "test_2.sdl",
+    "test_3.sdl",
+    "test_4.sdl",
+    "test_5.sdl",
+    "test_6.sdl",
+    "test_7.sdl",
+    "test_8.sdl",
+    "test_9.sdl",
+    NULL
+};
+
+static const char _input[] =
+    "MODULE layout_test;\n"
+    "AGGREGATE layout_rec STRUCTURE PREFIX \"lay$\";\n"
+    "    flags STRUCTURE;\n"
+    "        ready BITFIELD LENGTH 1;\n"
+    "        state BITFIELD LENGTH 3;\n"
+    "        spare BITFIELD LENGTH 4;\n"
+    "    END flags;\n"
+    "    value UNION;\n"
+    "        as_long LONGWORD;\n"
+    "        as_words WORD DIMENSION 2;\n"
+    "        as_bytes STRUCTURE;\n"
+    "            low BYTE;\n"
+    "            high BYTE;\n"
+    "        END as_bytes;\n"
+    "    END value;\n"
+    "    link ADDRESS;\n"
+    "    table QUADWORD DIMENSION 0:3;\n"
+    "    name CHARACTER LENGTH 12;\n"
+    "END layout_rec;\n"
+    "AGGREGATE layout_empty UNION;\n"
+    "    only BYTE;\n"
+    "END layout_empty;\n"
+    "END_MODULE;\n";
+
+/*
+ * Compile the input file to the language, with the plugins found in the
+ * directory, and standard error written to the errors file.  Return the exit
+ * status.
+ */
+static int _compile(const char *pluginDir,
+                    const char *lang,
+                    const char *errFile,
+                    const char *inFile)
+{
+    int status = 0;
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        int fd = open(errFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd >= 0)
+        {
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        setenv("SDL_SHARED_LIBRARY_PATH", pluginDir, 1);
+        execl(SDL_OPENSDL,
+              SDL_OPENSDL,
+              "--noheader",
+              lang,
+              inFile,
+              (char *) NULL);
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Read the whole of a file into memory, and return it, or NULL if it could
+ * not be read.
+ */
+static char *_read(const char *fileName, size_t *length)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *retVal = NULL;
+    long size;
+
+    if (fp == NULL)
+    {
+        return(NULL);
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) &&
+        ((size = ftell(fp)) >= 0) &&
+        (fseek(fp, 0, SEEK_SET) == 0) &&
+        ((retVal = malloc(size + 1)) != NULL))
+    {
+        if (fread(retVal, 1, size, fp) == (size_t) size)
+        {
+            retVal[size] = '\0';
+            *length = size;
+        }
+        else
+        {
+            free(retVal);
+            retVal = NULL;
+        }
+    }
+    fclose(fp);
+    return(retVal);
+}
+
+/*
+ * Return true if the two files have the same contents.
+ */
+static bool _same(const char *first, const char *second)
+{
+    size_t firstLen = 0;
+    size_t secondLen = 0;
+    char *firstBuf = _read(first, &firstLen);
+    char *secondBuf = _read(second, &secondLen);
+    bool retVal;
+
+    retVal = (firstBuf != NULL) && (secondBuf != NULL) &&
+             (firstLen == secondLen) &&
+             (memcmp(firstBuf, secondBuf, firstLen) == 0);
+    free(firstBuf);
+    free(secondBuf);
+    return(retVal);
+}
+
+/*
+ * Compile the input file both ways, and return the number of failures.
+ */
+static int _check(const char *tmpDir, const char *inFile)
+{
+    char layoutOut[PATH_MAX];
+    char memberOut[PATH_MAX];
+    char layoutErr[PATH_MAX];
+    char memberErr[PATH_MAX];
+    char layoutLang[PATH_MAX + 16];
+    char memberLang[PATH_MAX + 16];
+    int layout, member;
+    int retVal = 0;
+
+    snprintf(layoutOut, sizeof(layoutOut), "%s/layout.h", tmpDir);
+    snprintf(memberOut, sizeof(memberOut), "%s/member.h", tmpDir);
+    snprintf(layoutErr, sizeof(layoutErr), "%s/layout.err", tmpDir);
+    snprintf(memberErr, sizeof(memberErr), "%s/member.err", tmpDir);
+    snprintf(layoutLang, sizeof(layoutLang), "--lang=c=%s", layoutOut);
+    snprintf(memberLang, sizeof(memberLang), "--lang=member=%s", memberOut);
+    layout = _compile(SDL_PLUGIN_DIR, layoutLang, layoutErr, inFile);
+    member = _compile(SDL_MEMBER_DIR, memberLang, memberErr, inFile);
+    if ((layout != 0) || (member != 0))
+    {
+        printf("layout_test: %s exited with %d, and %d for each member\n",
+               inFile,
+               layout,
+               member);
+        retVal++;
+    }
+    else if (_same(layoutOut, memberOut) == false)
+    {
+        printf("layout_test: %s output differs for each member\n", inFile);
+        retVal++;
+    }
+    else if (_same(layoutErr, memberErr) == false)
+    {
+        printf("layout_test: %s diagnostics differ for each member\n",
+               inFile);
+        retVal++;
+    }
+    remove(layoutOut);
+    remove(memberOut);
+    remove(layoutErr);
+    remove(memberErr);
+    return(retVal);
+}
+
+int main(void)
+{
+    char tmpDir[] = "/tmp/sdl_layoutXXXXXX";
+    char inFile[PATH_MAX];
+    FILE *fp;
+    int failed = 0;
+    int ii;
+
+    if ((chdir(SDL_TEST_DIR) != 0) || (mkdtemp(tmpDir) == NULL))
+    {
+        printf("layout_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    snprintf(inFile, sizeof(inFile), "%s/layout_test.sdl", tmpDir);
+    if (((fp = fopen(inFile, "w")) == NULL) ||
+        (fputs(_input, fp) < 0) ||
+        (fclose(fp) != 0))
+    {
+        printf("layout_test: unable to write %s (%s)\n",
+               inFile,
+               strerror(errno));
+        rmdir(tmpDir);
+        return(1);
+    }
+
+    for (ii = 0; _files[ii] != NULL; ii++)
+    {
+        failed += _check(tmpDir, _files[ii]);
+    }
+    failed += _check(tmpDir, inFile);
+    remove(inFile);
+    rmdir(tmpDir);
+
+    printf("layout_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
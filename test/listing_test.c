@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, listing_test.c, verifies the listing file.  A test SDL file,
+ *  with an INCLUDE of a quoted file name, a LITERAL, block comments and a
+ *  list of constant names, is compiled by OpenSDL with --list.  Each line of
+ *  the input, with the lines of the INCLUDE file after the INCLUDE, must be
+ *  in the listing once, in order.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define LISTING_K_LINE		256
+
+static const char *_include[] =
+{
+    "CONSTANT included EQUALS 3;",
+    NULL
+};
+static const char *_input[] =
+{
+    "MODULE listing_test;",
+    "INCLUDE \"listinc.sdl\";",
+    "/+",
+    " The first block comment.",
+    "/-",
+    "CONSTANT (alpha, beta) EQUALS 1 INCREMENT 1;",
+    "/+ The second block comment. /-",
+    "LITERAL;",
+    "#define LISTING_TEST 1",
+    "END_LITERAL;",
+    "END_MODULE;",
+    NULL
+};
+
+/*
+ * Write the lines to the file.
+ */
+static int _write(const char *fileName, const char **lines)
+{
+    FILE *fp = fopen(fileName, "w");
+    int ii;
+
+    if (fp == NULL)
+    {
+        return(-1);
+    }
+    for (ii = 0; lines[ii] != NULL; ii++)
+    {
+        fprintf(fp, "%s\n", lines[ii]);
+    }
+    return((fclose(fp) == 0) ? 0 : -1);
+}
+
+/*
+ * Compile the input file to C with a listing, and return the exit status.
+ */
+static int _compile(const char *inFile)
+{
+    int status = 0;
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        execl(SDL_OPENSDL,
+              SDL_OPENSDL,
+              "--list=listing_test.lis",
+              "--lang=c=listing_test.h",
+              inFile,
+              (char *) NULL);
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Return the source text of a listing line, or NULL if it is not one.  A
+ * source line starts with its line number, in a field of 6, between spaces.
+ */
+static char *_source(char *line)
+{
+    size_t length = strcspn(line, "\n");
+    int ii;
+
+    line[length] = '\0';
+    if ((length < 8) ||
+        (line[0] != ' ') ||
+        (line[7] != ' ') ||
+        (isdigit(line[6]) == 0))
+    {
+        return(NULL);
+    }
+    for (ii = 1; ii < 7; ii++)
+    {
+        if ((line[ii] != ' ') && (isdigit(line[ii]) == 0))
+        {
+            return(NULL);
+        }
+    }
+    return(&line[8]);
+}
+
+/*
+ * Check the next expected line against the listing, and return the number
+ * of failures.
+ */
+static int _expect(const char *expected, const char *listed)
+{
+    if ((listed == NULL) || (strcmp(expected, listed) != 0))
+    {
+        printf("listing_test: expected \"%s\", listed \"%s\"\n",
+               expected,
+               (listed != NULL) ? listed : "<end>");
+        return(1);
+    }
+    return(0);
+}
+
+int main(void)
+{
+    char tmpDir[] = "/tmp/sdl_listingXXXXXX";
+    char line[LISTING_K_LINE];
+    char *listed[LISTING_K_LINE];
+    FILE *fp;
+    int count = 0;
+    int next = 0;
+    int failed = 0;
+    int ii, jj;
+
+    if ((mkdtemp(tmpDir) == NULL) ||
+        (chdir(tmpDir) != 0) ||
+        (_write("listinc.sdl", _include) != 0) ||
+        (_write("listing_test.sdl", _input) != 0))
+    {
+        printf("listing_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+
+    if ((_compile("listing_test.sdl") != 0) ||
+        ((fp = fopen("listing_test.lis", "r")) == NULL))
+    {
+        printf("listing_test: compilation failed\n");
+        failed++;
+    }
+    else
+    {
+
+        /*
+         * Collect the source lines from the listing, leaving out the page
+         * headers.
+         */
+        while ((count < LISTING_K_LINE) &&
+               (fgets(line, sizeof(line), fp) != NULL))
+        {
+            char *text = _source(line);
+
+            if (text != NULL)
+            {
+                listed[count++] = strdup(text);
+            }
+        }
+        fclose(fp);
+
+        /*
+         * Each input line must be listed once, with the INCLUDE file listed
+         * after the INCLUDE.
+         */
+        for (ii = 0; _input[ii] != NULL; ii++)
+        {
+            failed += _expect(_input[ii],
+                              (next < count) ? listed[next] : NULL);
+            next++;
+            if (strncmp(_input[ii], "INCLUDE", 7) == 0)
+            {
+                for (jj = 0; _include[jj] != NULL; jj++)
+                {
+                    failed += _expect(_include[jj],
+                                      (next < count) ? listed[next] : NULL);
+                    next++;
+                }
+            }
+        }
+        if (next < count)
+        {
+            printf("listing_test: %d more lines listed than expected\n",
+                   count - next);
+            failed++;
+        }
+        for (ii = 0; ii < count; ii++)
+        {
+            free(listed[ii]);
+        }
+    }
+    remove("listinc.sdl");
+    remove("listing_test.sdl");
+    remove("listing_test.lis");
+    remove("listing_test.h");
+    if (chdir("/") == 0)
+    {
+        rmdir(tmpDir);
+    }
+
+    printf("listing_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, member_plugin.c, is the "member" language used by
+ *  layout_test.c.  It is the C language, built into this shared library as
+ *  sdl_c_onLoad, without its SDL_API_AGGREGATE_V2 function.  OpenSDL then
+ *  calls its SDL_API_AGGREGATE function for each entry in the layout of an
+ *  AGGREGATE, as it does for a plugin that does not support the layout.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <stdint.h>
+#include "opensdl_defs.h"
+#include "library/utility/opensdl_plugin.h"
+
+uint32_t sdl_c_onLoad(SDL_API_TV *tv);
+
+/*
+ * onLoad
+ *  This function is called with the transfer vector, and passes it on to the
+ *  C language.  Then the SDL_API_AGGREGATE_V2 function the C language
+ *  returned, if any, is taken back out of it.
+ *
+ * Input Parameters:
+ *  tv:
+ *      A pointer to a transfer vector with the API version and address of the
+ *      message vector.
+ *
+ * Output Parameters:
+ *  tv:
+ *      A pointer to a transfer vector to receive the addresses of the
+ *      functions that need to be called by OpenSDL.
+ *
+ * Return Values:
+ *  Any status returned by the C language's onLoad function.
+ */
+uint32_t onLoad(SDL_API_TV *tv)
+{
+    uint32_t retVal = sdl_c_onLoad(tv);
+    uint32_t ii;
+
+    for (ii = 0; tv[ii].tag != SDL_API_NULL; ii++)
+    {
+        if (tv[ii].tag == SDL_API_AGGREGATE_V2)
+        {
+            tv[ii].sdl_tv_aggregateV2 = NULL;
+        }
+    }
+    return(retVal);
+}
@@ -0,0 +1,372 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, precomp_test.c, verifies precompiled INCLUDE files.  A test SDL
+ *  file INCLUDEs a file outside of its MODULE, which has a MODULE that
+ *  INCLUDEs another file.  It is compiled by OpenSDL with --cache, which
+ *  precompiles the outer INCLUDE file, and then a copy of it, under another
+ *  name so that the output cache is not used, is compiled with the same
+ *  cache.  The outer INCLUDE file is changed in between, but left with the
+ *  same size and modification time, so the second compilation must have
+ *  replayed it to generate what the first one did.  Then the nested INCLUDE
+ *  file is changed, which must cause the outer one to be read again, so that
+ *  the change is in what is generated.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+/*
+ * The number of seconds the nested INCLUDE file's modification time is moved
+ * forward when it is changed, so that it is different on any file system.
+ */
+#define PRECOMP_K_TOUCH		10
+
+static const char _main[] =
+    "INCLUDE \"common.sdl\";\n"
+    "MODULE precomp_test;\n"
+    "CONSTANT main_value EQUALS 2;\n"
+    "END_MODULE;\n";
+static const char _common[] =
+    "MODULE common;\n"
+    "CONSTANT common_value EQUALS 1;\n"
+    "AGGREGATE common_rec STRUCTURE;\n"
+    "    common_field LONGWORD;\n"
+    "END common_rec;\n"
+    "INCLUDE \"nested.sdl\";\n"
+    "END_MODULE;\n";
+static const char _commonChanged[] =
+    "MODULE common;\n"
+    "CONSTANT common_value EQUALS 7;\n"
+    "AGGREGATE common_rec STRUCTURE;\n"
+    "    common_field LONGWORD;\n"
+    "END common_rec;\n"
+    "INCLUDE \"nested.sdl\";\n"
+    "END_MODULE;\n";
+static const char _nested[] =
+    "CONSTANT nested_value EQUALS 5;\n";
+static const char _nestedChanged[] =
+    "CONSTANT nested_value EQUALS 6;\n";
+
+/*
+ * Write the text to a file, and return zero if it was all written.
+ */
+static int _write(const char *fileName, const char *text)
+{
+    FILE *fp = fopen(fileName, "w");
+    bool ok;
+
+    if (fp == NULL)
+    {
+        return(-1);
+    }
+    ok = fputs(text, fp) >= 0;
+    return(((fclose(fp) == 0) && (ok == true)) ? 0 : -1);
+}
+
+/*
+ * Set the modification time of a file, and return zero if it was set.
+ */
+static int _touch(const char *fileName, struct timespec *mtime)
+{
+    struct timespec times[2];
+
+    times[0] = *mtime;
+    times[1] = *mtime;
+    return(utimensat(AT_FDCWD, fileName, times, 0));
+}
+
+/*
+ * Compile the input file to C, with the cache directory if there is one,
+ * and return the exit status.
+ */
+static int _compile(const char *inFile, const char *outFile, bool cache)
+{
+    char output[PATH_MAX + 16];
+    int status = 0;
+    pid_t pid;
+
+    snprintf(output, sizeof(output), "--lang=c=%s", outFile);
+    pid = fork();
+    if (pid == 0)
+    {
+        if (cache == true)
+        {
+            execl(SDL_OPENSDL,
+                  SDL_OPENSDL,
+                  "--noheader",
+                  "--cache=cache",
+                  output,
+                  inFile,
+                  (char *) NULL);
+        }
+        else
+        {
+            execl(SDL_OPENSDL,
+                  SDL_OPENSDL,
+                  "--noheader",
+                  output,
+                  inFile,
+                  (char *) NULL);
+        }
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Read the whole of a file into memory, and return it, or NULL if it could
+ * not be read.
+ */
+static char *_read(const char *fileName)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *retVal = NULL;
+    long size;
+
+    if (fp == NULL)
+    {
+        return(NULL);
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) &&
+        ((size = ftell(fp)) >= 0) &&
+        (fseek(fp, 0, SEEK_SET) == 0) &&
+        ((retVal = malloc(size + 1)) != NULL))
+    {
+        if (fread(retVal, 1, size, fp) == (size_t) size)
+        {
+            retVal[size] = '\0';
+        }
+        else
+        {
+            free(retVal);
+            retVal = NULL;
+        }
+    }
+    fclose(fp);
+    return(retVal);
+}
+
+/*
+ * Return true if the two files have the same contents.
+ */
+static bool _same(const char *first, const char *second)
+{
+    char *firstBuf = _read(first);
+    char *secondBuf = _read(second);
+    bool retVal;
+
+    retVal = (firstBuf != NULL) && (secondBuf != NULL) &&
+             (strcmp(firstBuf, secondBuf) == 0);
+    free(firstBuf);
+    free(secondBuf);
+    return(retVal);
+}
+
+/*
+ * Remove the files in the cache directory, and then the directory.
+ */
+static void _clean(const char *dirName)
+{
+    DIR *dir = opendir(dirName);
+    struct dirent *entry;
+    char path[PATH_MAX];
+
+    if (dir == NULL)
+    {
+        return;
+    }
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if ((strcmp(entry->d_name, ".") != 0) &&
+            (strcmp(entry->d_name, "..") != 0))
+        {
+            snprintf(path, sizeof(path), "%s/%s", dirName, entry->d_name);
+            remove(path);
+        }
+    }
+    closedir(dir);
+    rmdir(dirName);
+    return;
+}
+
+/*
+ * Count the precompiled INCLUDE files in the cache directory.
+ */
+static int _count(const char *dirName)
+{
+    DIR *dir = opendir(dirName);
+    struct dirent *entry;
+    int retVal = 0;
+
+    if (dir == NULL)
+    {
+        return(0);
+    }
+    while ((entry = readdir(dir)) != NULL)
+    {
+        size_t length = strlen(entry->d_name);
+
+        if ((length > 7) &&
+            (strcmp(&entry->d_name[length - 7], ".sdlpcm") == 0))
+        {
+            retVal++;
+        }
+    }
+    closedir(dir);
+    return(retVal);
+}
+
+int main(void)
+{
+    char tmpDir[] = "/tmp/sdl_precompXXXXXX";
+    struct stat common;
+    struct stat nested;
+    int failed = 0;
+
+    if ((mkdtemp(tmpDir) == NULL) ||
+        (chdir(tmpDir) != 0) ||
+        (mkdir("cache", 0755) != 0) ||
+        (_write("precomp_test.sdl", _main) != 0) ||
+        (_write("precomp_copy.sdl", _main) != 0) ||
+        (_write("precomp_last.sdl", _main) != 0) ||
+        (_write("common.sdl", _common) != 0) ||
+        (_write("nested.sdl", _nested) != 0) ||
+        (stat("common.sdl", &common) != 0) ||
+        (stat("nested.sdl", &nested) != 0))
+    {
+        printf("precomp_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+
+    /*
+     * Without the cache, and then with it, which precompiles common.sdl.
+     */
+    if (_compile("precomp_test.sdl", "expected.h", false) != 0)
+    {
+        printf("precomp_test: compilation without the cache failed\n");
+        failed++;
+    }
+    else if (_compile("precomp_test.sdl", "first.h", true) != 0)
+    {
+        printf("precomp_test: first compilation failed\n");
+        failed++;
+    }
+    else if (_same("expected.h", "first.h") == false)
+    {
+        printf("precomp_test: first compilation differs\n");
+        failed++;
+    }
+    else if (_count("cache") == 0)
+    {
+        printf("precomp_test: common.sdl was not precompiled\n");
+        failed++;
+    }
+
+    /*
+     * Change common.sdl, without changing its size or modification time.
+     * What was precompiled is still up to date, so it must be what is used.
+     */
+    if ((failed == 0) &&
+        ((_write("common.sdl", _commonChanged) != 0) ||
+         (_touch("common.sdl", &common.st_mtim) != 0)))
+    {
+        printf("precomp_test: unable to change common.sdl (%s)\n",
+               strerror(errno));
+        failed++;
+    }
+    if (failed == 0)
+    {
+        if (_compile("precomp_copy.sdl", "second.h", true) != 0)
+        {
+            printf("precomp_test: second compilation failed\n");
+            failed++;
+        }
+        else if (_same("expected.h", "second.h") == false)
+        {
+            printf("precomp_test: precompiled common.sdl was not used\n");
+            failed++;
+        }
+    }
+
+    /*
+     * Put common.sdl back, and change the file it INCLUDEs.  What was
+     * precompiled is no longer up to date, so the change must be seen.
+     */
+    nested.st_mtim.tv_sec += PRECOMP_K_TOUCH;
+    if ((failed == 0) &&
+        ((_write("common.sdl", _common) != 0) ||
+         (_touch("common.sdl", &common.st_mtim) != 0) ||
+         (_write("nested.sdl", _nestedChanged) != 0) ||
+         (_touch("nested.sdl", &nested.st_mtim) != 0)))
+    {
+        printf("precomp_test: unable to change nested.sdl (%s)\n",
+               strerror(errno));
+        failed++;
+    }
+    if (failed == 0)
+    {
+        if ((_compile("precomp_test.sdl", "expected.h", false) != 0) ||
+            (_compile("precomp_last.sdl", "third.h", true) != 0))
+        {
+            printf("precomp_test: third compilation failed\n");
+            failed++;
+        }
+        else if ((_same("expected.h", "third.h") == false) ||
+                 (_same("first.h", "third.h") == true))
+        {
+            printf("precomp_test: changed nested.sdl was not used\n");
+            failed++;
+        }
+    }
+    _clean("cache");
+    remove("precomp_test.sdl");
+    remove("precomp_copy.sdl");
+    remove("precomp_last.sdl");
+    remove("common.sdl");
+    remove("nested.sdl");
+    remove("expected.h");
+    remove("first.h");
+    remove("second.h");
+    remove("third.h");
+    if (chdir("/") == 0)
+    {
+        rmdir(tmpDir);
+    }
+
+    printf("precomp_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
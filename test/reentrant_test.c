@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, reentrant_test.c, verifies that more than one file can be
+ *  compiled at the same time.  Each of the test SDL files is compiled to C,
+ *  one after the other, to get the expected output.  Then all of them are
+ *  compiled again, several times over, each on its own thread, and the output
+ *  of every one of these compilations must match the expected output.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 15, 2026	Jonathan D. Belanger
+ *  Initially written.
+ *
+ *  V01.001	Oct 16, 2026	Jonathan D. Belanger
+ *  The context is set up, and cleaned up, by sdl_context_init and
+ *  sdl_context_free, in the same way as the opensdl main program.
+ *
+ *  V01.002	Oct 16, 2026	Jonathan D. Belanger
+ *  Each compilation has its own identifier pool, so there is no pool to
+ *  release at the end.
+ */
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_symtab.h"
+#include "library/utility/opensdl_plugin_funcs.h"
+#include "library/utility/opensdl_include.h"
+#include "library/utility/opensdl_utility.h"
+#include "library/parser/opensdl_parser.h"
+
+/*
+ * The number of times each file is compiled concurrently.
+ */
+#define REENT_K_COPIES		4
+
+/*
+ * These are normally defined by the opensdl main program.
+ */
+bool trace = false;
+int _verbose = 0;
+
+static const char *_files[] =
+{
+    "SDLNODEF.SDL",
+    "SDLSHR.SDL",
+    "SDLTOKDEF.SDL",
+    "SDLTYPDEF.SDL",
+    "STSDEF.SDL",
+    "example_1_1.sdl",
+    "test_1.sdl",
+    "test_2.sdl",
+    "test_3.sdl",
+    "test_4.sdl",
+    "test_5.sdl",
+    "test_6.sdl",
+    "test_7.sdl",
+    "test_8.sdl",
+    "test_9.sdl"
+};
+#define REENT_K_FILES		(sizeof(_files) / sizeof(_files[0]))
+
+typedef struct
+{
+    pthread_t	thread;
+    const char	*inFile;
+    char	outFile[PATH_MAX];
+    uint32_t	langId;
+    uint32_t	status;
+} REENT_JOB;
+
+/*
+ * Compile one file into one output file, with a context of its own, in the
+ * same way the opensdl main program does.
+ */
+static void *_compile(void *arg)
+{
+    REENT_JOB *job = (REENT_JOB *) arg;
+    SDL_CONTEXT *context = calloc(1, sizeof(SDL_CONTEXT));
+    SDL_ARGUMENTS *args;
+    SDL_SYMBOL_LIST symbols;
+    FILE *inFP = NULL;
+    FILE *outFP = NULL;
+
+    job->status = SDL_ABORT;
+    if (context == NULL)
+    {
+        return(NULL);
+    }
+    args = context->argument;
+    memset(&symbols, 0, sizeof(symbols));
+    args[ArgSymbols].symbol = &symbols;
+    args[ArgComments].on = true;
+    args[ArgHeader].on = false;
+    args[ArgMemberAlign].on = true;
+    args[ArgWordSize].value = 64;
+    context->languagesSpecified = 1;
+
+    if (sdl_context_init(context, sdl_plugin_count()) == SDL_NORMAL)
+    {
+        inFP = fopen(job->inFile, "r");
+        outFP = fopen(job->outFile, "w");
+    }
+    if ((inFP != NULL) && (outFP != NULL) &&
+        (sdl_load_fp(context, job->langId, outFP) == SDL_NORMAL))
+    {
+        context->langEnableVec[job->langId] = true;
+        job->status = sdl_parse_file(context, inFP);
+        sdl_call_close();
+        outFP = NULL;
+    }
+    if (inFP != NULL)
+    {
+        fclose(inFP);
+    }
+    if (outFP != NULL)
+    {
+        fclose(outFP);
+    }
+
+    sdl_context_free(context);
+    free(context);
+    return(NULL);
+}
+
+/*
+ * Read an entire file into memory.  Returns NULL if the file could not be
+ * read.
+ */
+static char *_read_file(const char *fileName, long *length)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *retVal = NULL;
+
+    if (fp != NULL)
+    {
+        fseek(fp, 0, SEEK_END);
+        *length = ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+        retVal = malloc(*length + 1);
+        if ((retVal != NULL) &&
+            (fread(retVal, 1, *length, fp) != (size_t) *length))
+        {
+            free(retVal);
+            retVal = NULL;
+        }
+        fclose(fp);
+    }
+    return(retVal);
+}
+
+/*
+ * Compare the output of a concurrent compilation to the expected output.
+ */
+static bool _same(const char *expected, const char *actual)
+{
+    long expLen = 0, actLen = 0;
+    char *expBuf = _read_file(expected, &expLen);
+    char *actBuf = _read_file(actual, &actLen);
+    bool retVal;
+
+    retVal = (expBuf != NULL) && (actBuf != NULL) && (expLen > 0) &&
+             (expLen == actLen) && (memcmp(expBuf, actBuf, expLen) == 0);
+    free(expBuf);
+    free(actBuf);
+    return(retVal);
+}
+
+int main(void)
+{
+    REENT_JOB expected[REENT_K_FILES];
+    REENT_JOB jobs[REENT_K_FILES * REENT_K_COPIES];
+    SDL_CONTEXT *loader = calloc(1, sizeof(SDL_CONTEXT));
+    char tmpDir[] = "/tmp/sdl_reentXXXXXX";
+    char *fileExt;
+    uint32_t langId;
+    int failed = 0;
+    int ii;
+
+    if ((chdir(SDL_TEST_DIR) != 0) || (mkdtemp(tmpDir) == NULL))
+    {
+        printf("reentrant_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+
+    /*
+     * The plugins are loaded once, before any compilation is started.
+     */
+    if ((loader == NULL) ||
+        (sdl_load_plugin(loader, "c", &fileExt, &langId) != SDL_NORMAL))
+    {
+        printf("reentrant_test: unable to load the C plugin\n");
+        return(1);
+    }
+
+    /*
+     * Get the expected output by compiling each file, one at a time.
+     */
+    for (ii = 0; ii < REENT_K_FILES; ii++)
+    {
+        expected[ii].inFile = _files[ii];
+        expected[ii].langId = langId;
+        sprintf(expected[ii].outFile, "%s/expected_%d.h", tmpDir, ii);
+        _compile(&expected[ii]);
+    }
+
+    /*
+     * Now compile them all at the same time.
+     */
+    for (ii = 0; ii < (REENT_K_FILES * REENT_K_COPIES); ii++)
+    {
+        jobs[ii].inFile = _files[ii % REENT_K_FILES];
+        jobs[ii].langId = langId;
+        sprintf(jobs[ii].outFile, "%s/actual_%d.h", tmpDir, ii);
+        if (pthread_create(&jobs[ii].thread, NULL, _compile, &jobs[ii]) != 0)
+        {
+            printf("reentrant_test: unable to create thread %d\n", ii);
+            return(1);
+        }
+    }
+    for (ii = 0; ii < (REENT_K_FILES * REENT_K_COPIES); ii++)
+    {
+        int jj = ii % REENT_K_FILES;
+
+        pthread_join(jobs[ii].thread, NULL);
+        if ((jobs[ii].status != expected[jj].status) ||
+            (_same(expected[jj].outFile, jobs[ii].outFile) == false))
+        {
+            printf("reentrant_test: %s differs when compiled concurrently\n",
+                   jobs[ii].inFile);
+            failed++;
+        }
+        remove(jobs[ii].outFile);
+    }
+    for (ii = 0; ii < REENT_K_FILES; ii++)
+    {
+        remove(expected[ii].outFile);
+    }
+    rmdir(tmpDir);
+    sdl_unload_plugins();
+    free(loader);
+
+    printf("%d compilations of %d files, %d failed\n",
+           (int) (REENT_K_FILES * REENT_K_COPIES),
+           (int) REENT_K_FILES,
+           failed);
+    return((failed == 0) ? 0 : 1);
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, replay_test.c, verifies recording and replaying.  Each test SDL
+ *  file is compiled to C, and recorded with --lang=record, by OpenSDL.  The
+ *  recording is then replayed to C with --replay, and what is generated must
+ *  be byte for byte what the compilation generated.  The header is included,
+ *  with --update, so that its creation time is the same in both.  Then the
+ *  recording of one of them is cut short at several places, and given a
+ *  version and a magic string that are not known, and each of these must be
+ *  rejected with BADREPLAY.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/*
+ * The number of places the recording is cut short, and where its version is
+ * (just after the 8 byte magic string).
+ */
+#define REPLAY_K_CUTS		16
+#define REPLAY_K_VERSION	8
+
+static const char *_files[] =
+{
+    "SDLNODEF.SDL",
+    "SDLSHR.SDL",
+    "SDLTOKDEF.SDL",
+    "SDLTYPDEF.SDL",
+    "STSDEF.SDL",
+    "example_1_1.sdl",
+    "test_1.sdl",
+    "test_2.sdl",
+    "test_3.sdl",
+    "test_4.sdl",
+    "test_5.sdl",
+    "test_6.sdl",
+    "test_7.sdl",
+    "test_8.sdl",
+    "test_9.sdl"
+};
+#define REPLAY_K_FILES		(sizeof(_files) / sizeof(_files[0]))
+
+static char _direct[PATH_MAX];
+static char _record[PATH_MAX];
+static char _replay[PATH_MAX];
+static char _bad[PATH_MAX];
+static char _badOut[PATH_MAX];
+static char _errors[PATH_MAX];
+
+/*
+ * Run OpenSDL with the language option and input file, and return the exit
+ * status.  Standard error is written to the errors file.
+ */
+static int _run(const char *option, const char *lang, const char *inFile)
+{
+    int status = 0;
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        int fd = open(_errors, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd >= 0)
+        {
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        execl(SDL_OPENSDL,
+              SDL_OPENSDL,
+              option,
+              lang,
+              inFile,
+              (char *) NULL);
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Read the whole of a file into memory, and return it, or NULL if it could
+ * not be read.
+ */
+static char *_read(const char *fileName, size_t *length)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *retVal = NULL;
+    long size;
+
+    if (fp == NULL)
+    {
+        return(NULL);
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) &&
+        ((size = ftell(fp)) >= 0) &&
+        (fseek(fp, 0, SEEK_SET) == 0) &&
+        ((retVal = malloc(size + 1)) != NULL))
+    {
+        if (fread(retVal, 1, size, fp) == (size_t) size)
+        {
+            retVal[size] = '\0';
+            *length = size;
+        }
+        else
+        {
+            free(retVal);
+            retVal = NULL;
+        }
+    }
+    fclose(fp);
+    return(retVal);
+}
+
+/*
+ * Write the buffer to a file, and return zero if it was all written.
+ */
+static int _write(const char *fileName, const char *buffer, size_t length)
+{
+    FILE *fp = fopen(fileName, "w");
+    bool ok;
+
+    if (fp == NULL)
+    {
+        return(-1);
+    }
+    ok = fwrite(buffer, 1, length, fp) == length;
+    return(((fclose(fp) == 0) && (ok == true)) ? 0 : -1);
+}
+
+/*
+ * Return true if the two files have the same contents.
+ */
+static bool _same(const char *first, const char *second)
+{
+    size_t firstLen = 0;
+    size_t secondLen = 0;
+    char *firstBuf = _read(first, &firstLen);
+    char *secondBuf = _read(second, &secondLen);
+    bool retVal;
+
+    retVal = (firstBuf != NULL) && (secondBuf != NULL) &&
+             (firstLen == secondLen) &&
+             (memcmp(firstBuf, secondBuf, firstLen) == 0);
+    free(firstBuf);
+    free(secondBuf);
+    return(retVal);
+}
+
+/*
+ * Replay a bad recording, which must be rejected, and return the number of
+ * failures.
+ */
+static int _reject(const char *what, const char *buffer, size_t length)
+{
+    char lang[PATH_MAX + 16];
+    size_t errLen = 0;
+    char *errors;
+    int retVal = 0;
+
+    snprintf(lang, sizeof(lang), "--lang=c=%s", _badOut);
+    if (_write(_bad, buffer, length) != 0)
+    {
+        printf("replay_test: unable to write the %s recording\n", what);
+        return(1);
+    }
+    if (_run("--replay", lang, _bad) == 0)
+    {
+        printf("replay_test: %s recording was replayed\n", what);
+        retVal++;
+    }
+    else if (((errors = _read(_errors, &errLen)) == NULL) ||
+             (strstr(errors, "BADREPLAY") == NULL))
+    {
+        printf("replay_test: %s recording was not reported as BADREPLAY\n",
+               what);
+        retVal++;
+        free(errors);
+    }
+    else
+    {
+        free(errors);
+    }
+    return(retVal);
+}
+
+int main(void)
+{
+    char tmpDir[] = "/tmp/sdl_replayXXXXXX";
+    char direct[PATH_MAX + 16];
+    char record[PATH_MAX + 16];
+    char replay[PATH_MAX + 16];
+    char what[32];
+    size_t length = 0;
+    char *recording = NULL;
+    int failed = 0;
+    int ii;
+
+    if ((chdir(SDL_TEST_DIR) != 0) || (mkdtemp(tmpDir) == NULL))
+    {
+        printf("replay_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+    snprintf(_direct, sizeof(_direct), "%s/direct.h", tmpDir);
+    snprintf(_record, sizeof(_record), "%s/record.sdlrec", tmpDir);
+    snprintf(_replay, sizeof(_replay), "%s/replay.h", tmpDir);
+    snprintf(_bad, sizeof(_bad), "%s/bad.sdlrec", tmpDir);
+    snprintf(_badOut, sizeof(_badOut), "%s/bad.h", tmpDir);
+    snprintf(_errors, sizeof(_errors), "%s/errors.txt", tmpDir);
+    snprintf(direct, sizeof(direct), "--lang=c=%s", _direct);
+    snprintf(record, sizeof(record), "--lang=record=%s", _record);
+    snprintf(replay, sizeof(replay), "--lang=c=%s", _replay);
+
+    /*
+     * Replaying the recording of each file must generate what compiling it
+     * does.
+     */
+    for (ii = 0; ii < REPLAY_K_FILES; ii++)
+    {
+        remove(_direct);
+        remove(_record);
+        remove(_replay);
+        if (_run("--update", direct, _files[ii]) != 0)
+        {
+            printf("replay_test: %s compilation failed\n", _files[ii]);
+            failed++;
+        }
+        else if (_run("--update", record, _files[ii]) != 0)
+        {
+            printf("replay_test: %s recording failed\n", _files[ii]);
+            failed++;
+        }
+        else if (_run("--replay", replay, _record) != 0)
+        {
+            printf("replay_test: %s replay failed\n", _files[ii]);
+            failed++;
+        }
+        else if (_same(_direct, _replay) == false)
+        {
+            printf("replay_test: %s replay differs from compilation\n",
+                   _files[ii]);
+            failed++;
+        }
+    }
+
+    /*
+     * The last recording is cut short in several places, and then has its
+     * version and magic string changed.  None of them can be replayed.
+     */
+    if ((recording = _read(_record, &length)) == NULL)
+    {
+        printf("replay_test: unable to read the recording\n");
+        failed++;
+    }
+    else if (length <= (REPLAY_K_VERSION + 1))
+    {
+        printf("replay_test: recording is too short (%zu)\n", length);
+        failed++;
+    }
+    else
+    {
+        for (ii = 0; ii < REPLAY_K_CUTS; ii++)
+        {
+            size_t cut = (length * ii) / REPLAY_K_CUTS;
+
+            snprintf(what, sizeof(what), "%zu byte", cut);
+            failed += _reject(what, recording, cut);
+        }
+        failed += _reject("last byte short", recording, length - 1);
+        recording[REPLAY_K_VERSION]++;
+        failed += _reject("next version", recording, length);
+        recording[REPLAY_K_VERSION]--;
+        recording[0] ^= 0x20;
+        failed += _reject("bad magic", recording, length);
+        free(recording);
+    }
+    remove(_direct);
+    remove(_record);
+    remove(_replay);
+    remove(_bad);
+    remove(_badOut);
+    remove(_errors);
+    rmdir(tmpDir);
+
+    printf("replay_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
@@ -0,0 +1,423 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, sdl_bench.c, is the scaling benchmark.  Each of the synthetic
+ *  workloads written by sdl_generate is compiled to C by OpenSDL, at each
+ *  of the counts, SDL_BENCH_K_RUNS times over.  The fastest run is the one
+ *  recorded, with the time each phase took taken from --stats=json, and the
+ *  peak resident set size of the largest run.  A row is appended to the CSV
+ *  file for each workload and count, so that the file tracks the throughput
+ *  from one build to the next.
+ *
+ *  USAGE:
+ *	$ ./sdl_bench <sdl_generate> <opensdl> <directory> <csv_file> [count]...
+ *
+ *  The counts default to 100, 1000 and 10000.  The workloads and the output
+ *  from compiling them are written to the directory.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+#define SDL_BENCH_K_RUNS	3
+
+static const char *_workloads[] =
+{
+    "constants",
+    "declares",
+    "aggregates",
+    "bitfields",
+    "entries",
+    "includes",
+    "ifsymbols",
+    "mixed"
+};
+#define SDL_BENCH_K_WORKLOADS	(sizeof(_workloads) / sizeof(_workloads[0]))
+
+/*
+ * The phases recorded, by the names --stats=json gives them.
+ */
+static const char *_phases[] =
+{
+    "lex",
+    "parse",
+    "layout",
+    "emit",
+    "teardown"
+};
+#define SDL_BENCH_K_PHASES	(sizeof(_phases) / sizeof(_phases[0]))
+
+static const int _counts[] =
+{
+    100,
+    1000,
+    10000
+};
+#define SDL_BENCH_K_COUNTS	(sizeof(_counts) / sizeof(_counts[0]))
+
+typedef struct
+{
+    int		status;
+    uint64_t	wallNs;
+    uint64_t	cpuNs;
+    long	peakRssKB;
+    uint64_t	phaseNs[SDL_BENCH_K_PHASES];
+} SDL_BENCH_RUN;
+
+static uint64_t _now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return(((uint64_t) ts.tv_sec * 1000000000) + ts.tv_nsec);
+}
+
+/*
+ * Have sdl_generate write a workload, and get back the name of the file it
+ * wrote and the number of lines in it and its INCLUDE files.
+ */
+static bool _generate(const char *generate,
+                      const char *dir,
+                      const char *workload,
+                      int count,
+                      char *fileName,
+                      long *lines)
+{
+    char command[PATH_MAX * 3];
+    FILE *fp;
+    bool retVal = false;
+
+    snprintf(command,
+             sizeof(command),
+             "'%s' '%s' %s %d",
+             generate,
+             dir,
+             workload,
+             count);
+    fp = popen(command, "r");
+    if (fp != NULL)
+    {
+        retVal = fscanf(fp, "%4095s %ld", fileName, lines) == 2;
+        retVal = (pclose(fp) == 0) && retVal;
+    }
+    return(retVal);
+}
+
+/*
+ * Get the time a phase took from the statistics OpenSDL wrote for the
+ * input file (the first line of the --stats=json output).
+ */
+static uint64_t _phase_ns(const char *stats, const char *phase)
+{
+    char key[64];
+    const char *ptr;
+    unsigned long value = 0;
+
+    snprintf(key, sizeof(key), "\"%s\":{", phase);
+    ptr = strstr(stats, key);
+    if (ptr != NULL)
+    {
+        ptr = strstr(ptr, "\"wall_ns\":");
+        if (ptr != NULL)
+        {
+            sscanf(ptr + strlen("\"wall_ns\":"), "%lu", &value);
+        }
+    }
+    return(value);
+}
+
+/*
+ * Compile a workload to C once, in the directory it was written to, and
+ * time it.  The statistics are written to stats.json in that directory.
+ */
+static void _run(const char *opensdl,
+                 const char *dir,
+                 const char *fileName,
+                 SDL_BENCH_RUN *run)
+{
+    char statsName[PATH_MAX];
+    char output[PATH_MAX];
+    const char *base = strrchr(fileName, '/');
+    struct rusage usage;
+    uint64_t start;
+    int status = 0;
+    pid_t pid;
+    int ii;
+
+    base = (base != NULL) ? base + 1 : fileName;
+    snprintf(statsName, sizeof(statsName), "%s/stats.json", dir);
+    snprintf(output, sizeof(output), "--lang=c=%.*s.h",
+             (int) (strlen(base) - strlen(".sdl")),
+             base);
+    memset(run, 0, sizeof(SDL_BENCH_RUN));
+    run->status = -1;
+
+    start = _now();
+    pid = fork();
+    if (pid == 0)
+    {
+        int fd = open(statsName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int null = open("/dev/null", O_WRONLY);
+
+        if ((fd < 0) || (null < 0) || (chdir(dir) != 0))
+        {
+            _exit(127);
+        }
+        dup2(fd, STDERR_FILENO);
+        dup2(null, STDOUT_FILENO);
+        execl(opensdl,
+              opensdl,
+              "--stats=json",
+              "-s:bench_off=0",
+              output,
+              base,
+              (char *) NULL);
+        _exit(127);
+    }
+    if ((pid < 0) || (wait4(pid, &status, 0, &usage) != pid))
+    {
+        return;
+    }
+    run->wallNs = _now() - start;
+    run->cpuNs = ((uint64_t) usage.ru_utime.tv_sec * 1000000000) +
+                 ((uint64_t) usage.ru_utime.tv_usec * 1000) +
+                 ((uint64_t) usage.ru_stime.tv_sec * 1000000000) +
+                 ((uint64_t) usage.ru_stime.tv_usec * 1000);
+    run->peakRssKB = usage.ru_maxrss;
+    run->status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+
+    /*
+     * The statistics for the input file come before the ones for the run.
+     */
+    if (run->status == 0)
+    {
+        FILE *fp = fopen(statsName, "r");
+        char *line = NULL;
+        size_t size = 0;
+
+        if (fp != NULL)
+        {
+            while (getline(&line, &size, fp) > 0)
+            {
+                if ((strncmp(line, "{\"file\":\"", 9) == 0) &&
+                    (strstr(line, base) != NULL))
+                {
+                    for (ii = 0; ii < SDL_BENCH_K_PHASES; ii++)
+                    {
+                        run->phaseNs[ii] = _phase_ns(line, _phases[ii]);
+                    }
+                    break;
+                }
+            }
+            free(line);
+            fclose(fp);
+        }
+    }
+    return;
+}
+
+static double _per_sec(long lines, uint64_t ns)
+{
+    return((ns > 0) ? ((double) lines * 1000000000.0) / (double) ns : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+    char opensdl[PATH_MAX];
+    char date[32];
+    time_t now = time(NULL);
+    struct stat st;
+    FILE *csv;
+    int counts[64];
+    int countCount = 0;
+    int failed = 0;
+    int ii, jj, kk;
+
+    if (argc < 5)
+    {
+        fprintf(stderr,
+                "Usage: sdl_bench <sdl_generate> <opensdl> <directory> "
+                "<csv_file> [count]...\n");
+        return(1);
+    }
+
+    /*
+     * OpenSDL is run from the directory, so it needs a full path.
+     */
+    if (realpath(argv[2], opensdl) == NULL)
+    {
+        fprintf(stderr,
+                "sdl_bench: unable to find '%s' (%s)\n",
+                argv[2],
+                strerror(errno));
+        return(1);
+    }
+    for (ii = 5; (ii < argc) && (countCount < 64); ii++)
+    {
+        counts[countCount++] = atoi(argv[ii]);
+    }
+    if (countCount == 0)
+    {
+        for (ii = 0; ii < SDL_BENCH_K_COUNTS; ii++)
+        {
+            counts[countCount++] = _counts[ii];
+        }
+    }
+    if ((mkdir(argv[3], 0755) != 0) && (errno != EEXIST))
+    {
+        fprintf(stderr,
+                "sdl_bench: unable to create '%s' (%s)\n",
+                argv[3],
+                strerror(errno));
+        return(1);
+    }
+
+    /*
+     * The header is only written to a new CSV file.
+     */
+    csv = fopen(argv[4], "a");
+    if (csv == NULL)
+    {
+        fprintf(stderr,
+                "sdl_bench: unable to open '%s' (%s)\n",
+                argv[4],
+                strerror(errno));
+        return(1);
+    }
+    if ((fstat(fileno(csv), &st) == 0) && (st.st_size == 0))
+    {
+        fprintf(csv,
+                "date,workload,count,lines,status,wall_ms,cpu_ms,"
+                "lines_per_sec,peak_rss_kb");
+        for (ii = 0; ii < SDL_BENCH_K_PHASES; ii++)
+        {
+            fprintf(csv, ",%s_ms,%s_lines_per_sec", _phases[ii], _phases[ii]);
+        }
+        fprintf(csv, "\n");
+    }
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    printf("%-10s %8s %9s %10s %14s %10s\n",
+           "workload",
+           "count",
+           "lines",
+           "wall ms",
+           "lines/sec",
+           "peak KB");
+    for (ii = 0; ii < SDL_BENCH_K_WORKLOADS; ii++)
+    {
+        for (jj = 0; jj < countCount; jj++)
+        {
+            SDL_BENCH_RUN best = {-1, 0, 0, 0, {0}};
+            char fileName[PATH_MAX];
+            long lines = 0;
+            long peakRssKB = 0;
+
+            if (_generate(argv[1],
+                          argv[3],
+                          _workloads[ii],
+                          counts[jj],
+                          fileName,
+                          &lines) == false)
+            {
+                fprintf(stderr,
+                        "sdl_bench: unable to generate %s %d\n",
+                        _workloads[ii],
+                        counts[jj]);
+                failed++;
+                continue;
+            }
+            for (kk = 0; kk < SDL_BENCH_K_RUNS; kk++)
+            {
+                SDL_BENCH_RUN run;
+
+                _run(opensdl, argv[3], fileName, &run);
+                if ((kk == 0) ||
+                    ((run.status == 0) && (run.wallNs < best.wallNs)))
+                {
+                    best = run;
+                }
+                if (run.peakRssKB > peakRssKB)
+                {
+                    peakRssKB = run.peakRssKB;
+                }
+                if (run.status != 0)
+                {
+                    break;
+                }
+            }
+            if (best.status != 0)
+            {
+                fprintf(stderr,
+                        "sdl_bench: %s failed (see %s/stats.json)\n",
+                        fileName,
+                        argv[3]);
+                failed++;
+            }
+            fprintf(csv,
+                    "%s,%s,%d,%ld,%d,%.3f,%.3f,%.0f,%ld",
+                    date,
+                    _workloads[ii],
+                    counts[jj],
+                    lines,
+                    best.status,
+                    best.wallNs / 1000000.0,
+                    best.cpuNs / 1000000.0,
+                    _per_sec(lines, best.wallNs),
+                    peakRssKB);
+            for (kk = 0; kk < SDL_BENCH_K_PHASES; kk++)
+            {
+                fprintf(csv,
+                        ",%.3f,%.0f",
+                        best.phaseNs[kk] / 1000000.0,
+                        _per_sec(lines, best.phaseNs[kk]));
+            }
+            fprintf(csv, "\n");
+            fflush(csv);
+            printf("%-10s %8d %9ld %10.3f %14.0f %10ld\n",
+                   _workloads[ii],
+                   counts[jj],
+                   lines,
+                   best.wallNs / 1000000.0,
+                   _per_sec(lines, best.wallNs),
+                   peakRssKB);
+        }
+    }
+    if (fclose(csv) != 0)
+    {
+        fprintf(stderr, "sdl_bench: unable to write '%s'\n", argv[4]);
+        failed++;
+    }
+    return((failed == 0) ? 0 : 1);
+}
@@ -0,0 +1,464 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, sdl_generate.c, writes out a synthetic SDL workload for the
+ *  benchmark (see sdl_bench.c).  A workload is one kind of definition,
+ *  repeated count times, in a MODULE of its own:
+ *
+ *	constants	CONSTANTs, numeric and string.
+ *	declares	DECLAREs, each with an ITEM of the same size.
+ *	aggregates	AGGREGATEs nested SDL_GEN_K_DEPTH deep, with a few
+ *			members at each level.
+ *	bitfields	AGGREGATEs with runs of BITFIELDs of different
+ *			lengths.
+ *	entries		ENTRYs with up to 4 PARAMETERs each.
+ *	includes	CONSTANTs and AGGREGATEs spread over INCLUDE files,
+ *			SDL_GEN_K_PER_INCLUDE definitions to a file.
+ *	ifsymbols	IFSYMBOLs nested in each other's ELSE, with the
+ *			regions that are turned off much larger than the ones
+ *			that are not.  Needs --symbol=bench_off=0.
+ *	mixed		All of the above, except the INCLUDE files.
+ *
+ *  The file written is <directory>/<workload>_<count>.sdl, and the INCLUDE
+ *  files <directory>/<workload>_<count>_<n>.sdl.  The name of the file and
+ *  the number of lines written to it and its INCLUDE files are written to
+ *  standard output.  INCLUDE files are named relative to the directory.
+ *
+ *  USAGE:
+ *	$ ./sdl_generate <directory> <workload> <count>
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define SDL_GEN_K_DEPTH		8
+#define SDL_GEN_K_PER_AGGR	4
+#define SDL_GEN_K_PER_INCLUDE	20
+#define SDL_GEN_K_BITS		64
+
+typedef struct
+{
+    FILE	*fp;
+    long	lines;
+} SDL_GEN_FILE;
+
+static const char *_workloads[] =
+{
+    "constants",
+    "declares",
+    "aggregates",
+    "bitfields",
+    "entries",
+    "includes",
+    "ifsymbols",
+    "mixed"
+};
+#define SDL_GEN_K_WORKLOADS	(sizeof(_workloads) / sizeof(_workloads[0]))
+
+static const char *_types[] =
+{
+    "BYTE",
+    "WORD",
+    "LONGWORD",
+    "QUADWORD",
+    "ADDRESS",
+    "CHARACTER LENGTH 16",
+    "T_FLOATING",
+    "LONGWORD UNSIGNED"
+};
+#define SDL_GEN_K_TYPES		(sizeof(_types) / sizeof(_types[0]))
+
+/*
+ * Write a line to a generated file, counting it.
+ */
+static void _line(SDL_GEN_FILE *file, const char *format, ...)
+    __attribute__ ((format (printf, 2, 3)));
+
+static void _line(SDL_GEN_FILE *file, const char *format, ...)
+{
+    va_list ap;
+
+    va_start(ap, format);
+    vfprintf(file->fp, format, ap);
+    va_end(ap);
+    fputc('\n', file->fp);
+    file->lines++;
+    return;
+}
+
+static void _constants(SDL_GEN_FILE *file, const char *prefix, int count)
+{
+    int ii;
+
+    for (ii = 0; ii < count; ii++)
+    {
+        if ((ii % 8) == 7)
+        {
+            _line(file,
+                  "CONSTANT %s_str%d EQUALS STRING \"constant number %d\";",
+                  prefix,
+                  ii,
+                  ii);
+        }
+        else
+        {
+            _line(file,
+                  "CONSTANT %s_c%d EQUALS %d PREFIX b_ TAG K;",
+                  prefix,
+                  ii,
+                  (ii * 7) + 1);
+        }
+    }
+    return;
+}
+
+static void _declares(SDL_GEN_FILE *file, const char *prefix, int count)
+{
+    int ii;
+
+    for (ii = 0; ii < count; ii++)
+    {
+        _line(file,
+              "DECLARE %s_d%d SIZEOF (%d) PREFIX b_;",
+              prefix,
+              ii,
+              ((ii % 16) + 1) * 4);
+        _line(file,
+              "ITEM %s_i%d %s;",
+              prefix,
+              ii,
+              _types[ii % SDL_GEN_K_TYPES]);
+    }
+    return;
+}
+
+/*
+ * Each AGGREGATE has SDL_GEN_K_DEPTH levels, each one a STRUCTURE or UNION
+ * inside the one before it, with SDL_GEN_K_PER_AGGR members at each level.
+ */
+static void _aggregates(SDL_GEN_FILE *file, const char *prefix, int count)
+{
+    int members = SDL_GEN_K_DEPTH * SDL_GEN_K_PER_AGGR;
+    int aggrs = (count + members - 1) / members;
+    int ii, jj, kk;
+
+    for (ii = 0; ii < aggrs; ii++)
+    {
+        _line(file, "AGGREGATE %s_a%d STRUCTURE PREFIX b_;", prefix, ii);
+        for (jj = 0; jj < SDL_GEN_K_DEPTH; jj++)
+        {
+            for (kk = 0; kk < SDL_GEN_K_PER_AGGR; kk++)
+            {
+                _line(file,
+                      "%*sm%d_%d %s;",
+                      (jj + 1) * 4,
+                      "",
+                      jj,
+                      kk,
+                      _types[(ii + jj + kk) % SDL_GEN_K_TYPES]);
+            }
+            if (jj < (SDL_GEN_K_DEPTH - 1))
+            {
+                _line(file,
+                      "%*sl%d %s;",
+                      (jj + 1) * 4,
+                      "",
+                      jj + 1,
+                      ((jj % 2) == 0) ? "UNION" : "STRUCTURE");
+            }
+        }
+        for (jj = SDL_GEN_K_DEPTH - 1; jj > 0; jj--)
+        {
+            _line(file, "%*sEND l%d;", jj * 4, "", jj);
+        }
+        _line(file, "END %s_a%d;", prefix, ii);
+    }
+    return;
+}
+
+/*
+ * Runs of SDL_GEN_K_BITS bits, made up of BITFIELDs of 1 to 5 bits.
+ */
+static void _bitfields(SDL_GEN_FILE *file, const char *prefix, int count)
+{
+    int written = 0;
+    int ii = 0;
+
+    while (written < count)
+    {
+        int bits = 0;
+        int jj = 0;
+
+        _line(file, "AGGREGATE %s_b%d STRUCTURE PREFIX b_;", prefix, ii);
+        _line(file, "    flags QUADWORD;");
+        while ((written < count) && (bits < SDL_GEN_K_BITS))
+        {
+            int length = (jj % 5) + 1;
+
+            if ((bits + length) > SDL_GEN_K_BITS)
+            {
+                length = SDL_GEN_K_BITS - bits;
+            }
+            if (length == 1)
+            {
+                _line(file, "    f%d BITFIELD;", jj);
+            }
+            else
+            {
+                _line(file,
+                      "    f%d BITFIELD QUADWORD LENGTH %d MASK;",
+                      jj,
+                      length);
+            }
+            bits += length;
+            jj++;
+            written++;
+        }
+        _line(file, "    tail LONGWORD;");
+        _line(file, "END %s_b%d;", prefix, ii);
+        ii++;
+    }
+    return;
+}
+
+static void _entries(SDL_GEN_FILE *file, const char *prefix, int count)
+{
+    int ii, jj;
+
+    for (ii = 0; ii < count; ii++)
+    {
+        int params = ii % 5;
+
+        if (params == 0)
+        {
+            _line(file, "ENTRY %s_e%d;", prefix, ii);
+            continue;
+        }
+        _line(file, "ENTRY %s_e%d", prefix, ii);
+        _line(file, "    PARAMETER (");
+        for (jj = 0; jj < params; jj++)
+        {
+            _line(file,
+                  "        %s NAMED p%d %s%s",
+                  ((jj % 2) == 0) ? "LONGWORD VALUE" : "ADDRESS",
+                  jj,
+                  ((jj % 2) == 0) ? "IN" : "OUT DEFAULT 0",
+                  (jj < (params - 1)) ? "," : ")");
+        }
+        _line(file, "    RETURNS LONGWORD NAMED status;");
+    }
+    return;
+}
+
+/*
+ * Nest the IFSYMBOLs in the ELSE of the one before, as an IFSYMBOL is not
+ * allowed directly inside another.  The first region of each is turned off.
+ */
+static void _ifsymbols(SDL_GEN_FILE *file, const char *prefix, int count)
+{
+    char name[64];
+    int ii = 0;
+
+    while (ii < count)
+    {
+        int depth = 0;
+        int jj;
+
+        while ((ii < count) && (depth < SDL_GEN_K_DEPTH))
+        {
+            _line(file, "IFSYMBOL bench_off;");
+            snprintf(name, sizeof(name), "%s_off%d", prefix, ii);
+            _constants(file, name, SDL_GEN_K_PER_AGGR);
+            _aggregates(file, name, SDL_GEN_K_PER_AGGR);
+            _line(file, "ELSE;");
+            snprintf(name, sizeof(name), "%s_on%d", prefix, ii);
+            _constants(file, name, SDL_GEN_K_PER_AGGR);
+            depth++;
+            ii++;
+        }
+        for (jj = 0; jj < depth; jj++)
+        {
+            _line(file, "END_IFSYMBOL;");
+        }
+    }
+    return;
+}
+
+static bool _open(SDL_GEN_FILE *file, const char *name)
+{
+    file->fp = fopen(name, "w");
+    if (file->fp == NULL)
+    {
+        fprintf(stderr,
+                "sdl_generate: unable to create '%s' (%s)\n",
+                name,
+                strerror(errno));
+        return(false);
+    }
+    return(true);
+}
+
+static bool _close(SDL_GEN_FILE *file, const char *name)
+{
+    if ((ferror(file->fp) != 0) || (fclose(file->fp) != 0))
+    {
+        fprintf(stderr, "sdl_generate: unable to write '%s'\n", name);
+        return(false);
+    }
+    return(true);
+}
+
+int main(int argc, char **argv)
+{
+    SDL_GEN_FILE file = {NULL, 0};
+    const char *workload;
+    char fileName[PATH_MAX];
+    char prefix[64];
+    long lines = 0;
+    int count;
+    int ii;
+
+    if (argc != 4)
+    {
+        fprintf(stderr,
+                "Usage: sdl_generate <directory> <workload> <count>\n");
+        return(1);
+    }
+    workload = argv[2];
+    count = atoi(argv[3]);
+    for (ii = 0; ii < SDL_GEN_K_WORKLOADS; ii++)
+    {
+        if (strcmp(workload, _workloads[ii]) == 0)
+        {
+            break;
+        }
+    }
+    if ((ii == SDL_GEN_K_WORKLOADS) || (count <= 0))
+    {
+        fprintf(stderr,
+                "sdl_generate: unknown workload '%s' or count '%s'\n",
+                workload,
+                argv[3]);
+        return(1);
+    }
+    snprintf(prefix, sizeof(prefix), "%.8s%d", workload, count);
+
+    /*
+     * The INCLUDE files are written first, each with a MODULE of its own.
+     */
+    if (strcmp(workload, "includes") == 0)
+    {
+        int files = (count + SDL_GEN_K_PER_INCLUDE - 1) / SDL_GEN_K_PER_INCLUDE;
+
+        for (ii = 0; ii < files; ii++)
+        {
+            snprintf(fileName,
+                     sizeof(fileName),
+                     "%s/%s_%d_%d.sdl",
+                     argv[1],
+                     workload,
+                     count,
+                     ii);
+            if (_open(&file, fileName) == false)
+            {
+                return(1);
+            }
+            _line(&file, "MODULE %s_%d IDENT \"V1.0\";", prefix, ii);
+            snprintf(prefix, sizeof(prefix), "%.8s%d_%d", workload, count, ii);
+            _constants(&file, prefix, SDL_GEN_K_PER_INCLUDE / 2);
+            _aggregates(&file, prefix, SDL_GEN_K_PER_INCLUDE / 2);
+            snprintf(prefix, sizeof(prefix), "%.8s%d", workload, count);
+            _line(&file, "END_MODULE %s_%d;", prefix, ii);
+            if (_close(&file, fileName) == false)
+            {
+                return(1);
+            }
+            lines += file.lines;
+            file.lines = 0;
+        }
+    }
+
+    snprintf(fileName,
+             sizeof(fileName),
+             "%s/%s_%d.sdl",
+             argv[1],
+             workload,
+             count);
+    if (_open(&file, fileName) == false)
+    {
+        return(1);
+    }
+    _line(&file, "{ Synthetic %s workload, count %d.", workload, count);
+    if (strcmp(workload, "includes") == 0)
+    {
+        int files = (count + SDL_GEN_K_PER_INCLUDE - 1) / SDL_GEN_K_PER_INCLUDE;
+
+        for (ii = 0; ii < files; ii++)
+        {
+            _line(&file, "INCLUDE \"%s_%d_%d.sdl\";", workload, count, ii);
+        }
+    }
+    else
+    {
+        bool mixed = strcmp(workload, "mixed") == 0;
+
+        _line(&file, "MODULE %s IDENT \"V1.0\";", prefix);
+        if ((mixed == true) || (strcmp(workload, "constants") == 0))
+        {
+            _constants(&file, prefix, count);
+        }
+        if ((mixed == true) || (strcmp(workload, "declares") == 0))
+        {
+            _declares(&file, prefix, count);
+        }
+        if ((mixed == true) || (strcmp(workload, "aggregates") == 0))
+        {
+            _aggregates(&file, prefix, count);
+        }
+        if ((mixed == true) || (strcmp(workload, "bitfields") == 0))
+        {
+            _bitfields(&file, prefix, count);
+        }
+        if ((mixed == true) || (strcmp(workload, "entries") == 0))
+        {
+            _entries(&file, prefix, count);
+        }
+        if ((mixed == true) || (strcmp(workload, "ifsymbols") == 0))
+        {
+            _ifsymbols(&file, prefix, count);
+        }
+        _line(&file, "END_MODULE %s;", prefix);
+    }
+    if (_close(&file, fileName) == false)
+    {
+        return(1);
+    }
+    lines += file.lines;
+
+    printf("%s %ld\n", fileName, lines);
+    return(0);
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, skip_test.c, verifies that an inactive IFSYMBOL region is
+ *  skipped correctly when the END_IFSYMBOL that ends it is split across a
+ *  refill of the scanner's buffer.  Source in memory is read through a
+ *  stream, as standard input is, so the scanner reads it a buffer at a time.
+ *  The inactive region is padded so that the END_IFSYMBOL starts at each of
+ *  the positions around the end of the first buffer, and the definition
+ *  after it must be in the output every time.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_message.h"
+#include "library/api/opensdl_api.h"
+
+/*
+ * The size of the scanner's buffer, the number of positions around the end
+ * of it at which the END_IFSYMBOL is put, and the room for the source.
+ */
+#define SKIP_K_BUFFER		16384
+#define SKIP_K_SHIFTS		48
+#define SKIP_K_SOURCE		(SKIP_K_BUFFER * 2)
+
+static const char _head[] =
+    "MODULE skip_test;\n"
+    "CONSTANT before EQUALS 1;\n"
+    "IFSYMBOL skip;\n";
+static const char _filler[] = "CONSTANT filler EQUALS 0;\n";
+static const char _tail[] =
+    "END_IFSYMBOL;\n"
+    "CONSTANT after EQUALS 2;\n"
+    "END_MODULE;\n";
+
+/*
+ * Build the source, with the END_IFSYMBOL starting at the indicated offset.
+ */
+static size_t _build(char *source, size_t offset)
+{
+    size_t length = strlen(_head);
+
+    memcpy(source, _head, length);
+    while ((length + strlen(_filler)) < offset)
+    {
+        memcpy(&source[length], _filler, strlen(_filler));
+        length += strlen(_filler);
+    }
+    while (length < offset)
+    {
+        source[length++] = ' ';
+    }
+    memcpy(&source[length], _tail, strlen(_tail));
+    return(length + strlen(_tail));
+}
+
+int main(void)
+{
+    SDL_COMPILE_SYMBOL symbol = {"skip", 0};
+    SDL_COMPILE_OPTIONS options;
+    SDL_COMPILE_RESULT result;
+    const char *languages[] = {"c"};
+    char *source = malloc(SKIP_K_SOURCE);
+    uint32_t status;
+    size_t offset;
+    int failed = 0;
+
+    if (source == NULL)
+    {
+        printf("skip_test: unable to allocate the source\n");
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+    sdl_compile_options_init(&options);
+    options.header = false;
+    options.symbols = &symbol;
+    options.symbolCount = 1;
+
+    for (offset = SKIP_K_BUFFER - SKIP_K_SHIFTS;
+         offset < (SKIP_K_BUFFER + SKIP_K_SHIFTS);
+         offset++)
+    {
+        status = sdl_compile_buffer(source,
+                                    _build(source, offset),
+                                    "skip_test.sdl",
+                                    &options,
+                                    languages,
+                                    1,
+                                    &result);
+        if ((status != SDL_NORMAL) ||
+            (result.outputCount != 1) ||
+            (result.outputs[0].buffer == NULL) ||
+            (strstr(result.outputs[0].buffer, "before") == NULL) ||
+            (strstr(result.outputs[0].buffer, "after") == NULL) ||
+            (strstr(result.outputs[0].buffer, "filler") != NULL))
+        {
+            printf("skip_test: END_IFSYMBOL at %zu failed (0x%08x)\n%s\n",
+                   offset,
+                   status,
+                   (result.diagnostics != NULL) ? result.diagnostics : "");
+            failed++;
+        }
+        sdl_compile_result_free(&result);
+    }
+    sdl_compile_release();
+    free(source);
+
+    printf("skip_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
@@ -0,0 +1,537 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, stats_test.c, verifies the statistics written with
+ *  --stats=json.  Two SDL files, one with a quote and a backslash in its
+ *  name, are compiled to C by one run of OpenSDL.  Every line written to
+ *  standard error must be a JSON object, parsed here in full, with the
+ *  members the statistics are documented to have, in order.  There must be
+ *  one for each input file, with its name, followed by one for the whole
+ *  run, with a null name.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define STATS_K_LINE		8192
+#define STATS_K_NAME		256
+#define STATS_K_KEYS		16
+#define STATS_K_DEPTH		8
+
+static const char _quoted[] = "stats \"quoted\\\".sdl";
+static const char _input[] =
+    "MODULE stats_test;\n"
+    "CONSTANT stats_value EQUALS 1;\n"
+    "AGGREGATE stats_rec STRUCTURE;\n"
+    "    flag BYTE;\n"
+    "    count LONGWORD;\n"
+    "END stats_rec;\n"
+    "END_MODULE;\n";
+
+/*
+ * The members of each object, in the order they are written.  The phases
+ * are followed by "other", and the counters are left out, since they are
+ * only there when they can be read.
+ */
+static const char *_members[] =
+{
+    "file", "total", "phases", "languages", "blocks", "symbols", "tokens",
+    NULL
+};
+static const char *_timeMembers[] =
+{
+    "count", "wall_ns", "cpu_ns", NULL
+};
+static const char *_phaseMembers[] =
+{
+    "options", "plugins", "lex", "parse", "layout", "emit", "listing",
+    "teardown", "other", NULL
+};
+static const char *_blockMembers[] =
+{
+    "local", "literal", "constant", "enum_member", "enumerate", "declare",
+    "item", "aggr_member", "aggregate", "parameter", "entry", NULL
+};
+static const char *_symbolMembers[] =
+{
+    "lookups", "inserts", NULL
+};
+static const char *_langMembers[] =
+{
+    "c", NULL
+};
+static const char *_noMembers[] =
+{
+    NULL
+};
+
+/*
+ * The keys of an object, as they were parsed.
+ */
+typedef struct
+{
+    char	name[STATS_K_KEYS][STATS_K_NAME];
+    int		count;
+} STATS_KEYS;
+
+static bool _value(const char **ptr, int depth, STATS_KEYS *keys);
+
+/*
+ * Skip the white space.
+ */
+static void _space(const char **ptr)
+{
+    while (isspace((unsigned char) **ptr) && (**ptr != '\n'))
+    {
+        (*ptr)++;
+    }
+    return;
+}
+
+/*
+ * Parse a JSON string, and return it, without its escapes, in the buffer.
+ * Return true if it was a string.
+ */
+static bool _string(const char **ptr, char *buffer, size_t length)
+{
+    const char *str = *ptr;
+    size_t used = 0;
+    char ch;
+
+    if (*str++ != '"')
+    {
+        return(false);
+    }
+    while (*str != '"')
+    {
+        ch = *str++;
+        if ((unsigned char) ch < ' ')
+        {
+            return(false);
+        }
+        if (ch == '\\')
+        {
+            ch = *str++;
+            if (ch == 'u')
+            {
+                char hex[5];
+                int ii;
+
+                for (ii = 0; ii < 4; ii++)
+                {
+                    if (isxdigit((unsigned char) str[ii]) == 0)
+                    {
+                        return(false);
+                    }
+                    hex[ii] = str[ii];
+                }
+                hex[4] = '\0';
+                ch = (char) strtol(hex, NULL, 16);
+                str += 4;
+            }
+            else if (ch == 'n')
+            {
+                ch = '\n';
+            }
+            else if (ch == 't')
+            {
+                ch = '\t';
+            }
+            else if ((ch != '"') && (ch != '\\') && (ch != '/'))
+            {
+                return(false);
+            }
+        }
+        if (used + 1 < length)
+        {
+            buffer[used++] = ch;
+        }
+    }
+    buffer[used] = '\0';
+    *ptr = str + 1;
+    return(true);
+}
+
+/*
+ * Parse a JSON number.  The statistics only have unsigned integers in them,
+ * other than the instructions per cycle, which has a fraction.
+ */
+static bool _number(const char **ptr)
+{
+    const char *str = *ptr;
+
+    if (isdigit((unsigned char) *str) == 0)
+    {
+        return(false);
+    }
+    while (isdigit((unsigned char) *str))
+    {
+        str++;
+    }
+    if (*str == '.')
+    {
+        str++;
+        if (isdigit((unsigned char) *str) == 0)
+        {
+            return(false);
+        }
+        while (isdigit((unsigned char) *str))
+        {
+            str++;
+        }
+    }
+    *ptr = str;
+    return(true);
+}
+
+/*
+ * Parse a JSON object, and return its keys, in order, if they are wanted.
+ */
+static bool _object(const char **ptr, int depth, STATS_KEYS *keys)
+{
+    char name[STATS_K_NAME];
+
+    if ((**ptr != '{') || (depth >= STATS_K_DEPTH))
+    {
+        return(false);
+    }
+    (*ptr)++;
+    _space(ptr);
+    if (keys != NULL)
+    {
+        keys->count = 0;
+    }
+    if (**ptr == '}')
+    {
+        (*ptr)++;
+        return(true);
+    }
+    while (true)
+    {
+        _space(ptr);
+        if (_string(ptr, name, sizeof(name)) == false)
+        {
+            return(false);
+        }
+        if ((keys != NULL) && (keys->count < STATS_K_KEYS))
+        {
+            strcpy(keys->name[keys->count++], name);
+        }
+        _space(ptr);
+        if (*(*ptr)++ != ':')
+        {
+            return(false);
+        }
+        _space(ptr);
+        if (_value(ptr, depth + 1, NULL) == false)
+        {
+            return(false);
+        }
+        _space(ptr);
+        if (**ptr == '}')
+        {
+            (*ptr)++;
+            return(true);
+        }
+        if (*(*ptr)++ != ',')
+        {
+            return(false);
+        }
+    }
+}
+
+/*
+ * Parse any JSON value that the statistics can have in them.
+ */
+static bool _value(const char **ptr, int depth, STATS_KEYS *keys)
+{
+    char buffer[STATS_K_NAME];
+
+    switch (**ptr)
+    {
+        case '{':
+            return(_object(ptr, depth, keys));
+
+        case '"':
+            return(_string(ptr, buffer, sizeof(buffer)));
+
+        case 'n':
+            if (strncmp(*ptr, "null", 4) == 0)
+            {
+                *ptr += 4;
+                return(true);
+            }
+            return(false);
+
+        default:
+            return(_number(ptr));
+    }
+}
+
+/*
+ * Look for a member of an object, and return a pointer to its value, or
+ * NULL if it is not there.  The object must already have been parsed.
+ */
+static const char *_member(const char *object, const char *name)
+{
+    const char *ptr = object + 1;
+    char key[STATS_K_NAME];
+
+    while (true)
+    {
+        _space(&ptr);
+        if (_string(&ptr, key, sizeof(key)) == false)
+        {
+            return(NULL);
+        }
+        _space(&ptr);
+        ptr++;
+        _space(&ptr);
+        if (strcmp(key, name) == 0)
+        {
+            return(ptr);
+        }
+        if (_value(&ptr, 0, NULL) == false)
+        {
+            return(NULL);
+        }
+        _space(&ptr);
+        if (*ptr++ != ',')
+        {
+            return(NULL);
+        }
+    }
+}
+
+/*
+ * Check that the keys of an object are the ones expected, in order.  Any
+ * more that follow are allowed when there may be more.
+ */
+static bool _keys(STATS_KEYS *keys, const char **expected, bool more)
+{
+    int ii;
+
+    for (ii = 0; expected[ii] != NULL; ii++)
+    {
+        if ((ii >= keys->count) || (strcmp(keys->name[ii], expected[ii]) != 0))
+        {
+            return(false);
+        }
+    }
+    return((more == true) || (ii == keys->count));
+}
+
+/*
+ * Check a member of an object that is itself an object, with the keys
+ * expected.  When the keys are for a time, each member of it must be a time.
+ */
+static bool _nested(const char *object,
+                    const char *name,
+                    const char **expected,
+                    bool times)
+{
+    const char *value = _member(object, name);
+    const char *ptr = value;
+    STATS_KEYS keys;
+    STATS_KEYS timeKeys;
+    int ii;
+
+    if ((value == NULL) ||
+        (_object(&ptr, 0, &keys) == false) ||
+        (_keys(&keys, expected, expected == _timeMembers) == false))
+    {
+        return(false);
+    }
+    for (ii = 0; (times == true) && (ii < keys.count); ii++)
+    {
+        ptr = _member(value, keys.name[ii]);
+        if ((ptr == NULL) ||
+            (_object(&ptr, 0, &timeKeys) == false) ||
+            (_keys(&timeKeys, _timeMembers, true) == false))
+        {
+            return(false);
+        }
+    }
+    return(true);
+}
+
+/*
+ * Parse a line of statistics, and check the members in it.  Return the name
+ * of the file they are for, or an empty string for the whole run, in the
+ * buffer, and true if the line is what it should be.  The languages are only
+ * counted for each file.
+ */
+static bool _line(const char *line, char *fileName, size_t length)
+{
+    const char *ptr = line;
+    const char *value;
+    STATS_KEYS keys;
+
+    if ((_object(&ptr, 0, &keys) == false) ||
+        (strcmp(ptr, "\n") != 0) ||
+        (_keys(&keys, _members, false) == false))
+    {
+        return(false);
+    }
+    value = _member(line, "file");
+    if (strncmp(value, "null", 4) == 0)
+    {
+        fileName[0] = '\0';
+    }
+    else if (_string(&value, fileName, length) == false)
+    {
+        return(false);
+    }
+    value = _member(line, "tokens");
+    return((_nested(line, "total", _timeMembers, false) == true) &&
+           (_nested(line, "phases", _phaseMembers, true) == true) &&
+           (_nested(line,
+                    "languages",
+                    (fileName[0] != '\0') ? _langMembers : _noMembers,
+                    true) == true) &&
+           (_nested(line, "blocks", _blockMembers, false) == true) &&
+           (_nested(line, "symbols", _symbolMembers, false) == true) &&
+           (_number(&value) == true));
+}
+
+/*
+ * Compile the input files, with standard error written to the errors file,
+ * and return the exit status.
+ */
+static int _compile(const char *errFile)
+{
+    int status = 0;
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        int fd = open(errFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd >= 0)
+        {
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        execl(SDL_OPENSDL,
+              SDL_OPENSDL,
+              "--noheader",
+              "--stats=json",
+              "--lang=c",
+              _quoted,
+              "stats_test.sdl",
+              (char *) NULL);
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+int main(void)
+{
+    static const char *expected[] = {_quoted, "stats_test.sdl", ""};
+    char tmpDir[] = "/tmp/sdl_statsXXXXXX";
+    char line[STATS_K_LINE];
+    char fileName[STATS_K_NAME];
+    FILE *fp;
+    int failed = 0;
+    int lines = 0;
+    int ii;
+
+    if ((mkdtemp(tmpDir) == NULL) || (chdir(tmpDir) != 0))
+    {
+        printf("stats_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    for (ii = 0; ii < 2; ii++)
+    {
+        if (((fp = fopen(expected[ii], "w")) == NULL) ||
+            (fputs(_input, fp) < 0) ||
+            (fclose(fp) != 0))
+        {
+            printf("stats_test: unable to write %s (%s)\n",
+                   expected[ii],
+                   strerror(errno));
+            return(1);
+        }
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+
+    if (_compile("stats.err") != 0)
+    {
+        printf("stats_test: compilation failed\n");
+        failed++;
+    }
+    else if ((fp = fopen("stats.err", "r")) == NULL)
+    {
+        printf("stats_test: no statistics were written\n");
+        failed++;
+    }
+    else
+    {
+        while (fgets(line, sizeof(line), fp) != NULL)
+        {
+            if (_line(line, fileName, sizeof(fileName)) == false)
+            {
+                printf("stats_test: line %d is not valid: %s", lines + 1, line);
+                failed++;
+            }
+            else if ((lines >= 3) || (strcmp(fileName, expected[lines]) != 0))
+            {
+                printf("stats_test: line %d is for \"%s\"\n",
+                       lines + 1,
+                       fileName);
+                failed++;
+            }
+            lines++;
+        }
+        fclose(fp);
+        if (lines != 3)
+        {
+            printf("stats_test: %d lines of statistics, expected 3\n", lines);
+            failed++;
+        }
+    }
+    remove(_quoted);
+    remove("stats \"quoted\\\".h");
+    remove("stats_test.sdl");
+    remove("stats_test.h");
+    remove("stats.err");
+    if (chdir("/") == 0)
+    {
+        rmdir(tmpDir);
+    }
+
+    printf("stats_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
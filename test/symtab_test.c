@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, symtab_test.c, verifies the symbol table routines and measures
+ *  how the insert and lookup times scale with the number of symbols.  The
+ *  time per symbol should stay roughly flat as the number of symbols grows,
+ *  rather than growing with it as it did when the queues were searched.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 15, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "opensdl_defs.h"
+#include "library/common/opensdl_blocks.h"
+#include "library/common/opensdl_message.h"
+#include "library/common/opensdl_symtab.h"
+
+/*
+ * The largest per-symbol time at the biggest size may be no more than this
+ * many times the per-symbol time at the smallest size.  A linear search
+ * would be about 100 times slower over the sizes below.
+ */
+#define SYMTAB_K_MAX_RATIO	10.0
+
+static const int _sizes[] = {1000, 10000, 100000};
+#define SYMTAB_K_SIZES		(sizeof(_sizes) / sizeof(_sizes[0]))
+
+static double _now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((double) ts.tv_sec + ((double) ts.tv_nsec / 1.0e9));
+}
+
+/*
+ * Insert count names and type IDs and then look every one of them up by name
+ * and by type ID.  Returns the time per symbol in nanoseconds, or a negative
+ * value if any lookup did not return the inserted block.
+ */
+static double _run(int count)
+{
+    SDL_SYMTAB symtab;
+    char **names = calloc(count, sizeof(char *));
+    SDL_DECLARE *blocks = calloc(count, sizeof(SDL_DECLARE));
+    double start, elapsed;
+    bool ok = true;
+    int ii;
+
+    if ((names == NULL) || (blocks == NULL))
+    {
+        return(-1.0);
+    }
+    for (ii = 0; ii < count; ii++)
+    {
+        names[ii] = malloc(32);
+        sprintf(names[ii], "SYM_%d$NAME", ii);
+        blocks[ii].id = names[ii];
+        blocks[ii].typeID = SDL_K_DECLARE_MIN + ii;
+    }
+    sdl_symtab_init(&symtab, SDL_K_DECLARE_MIN);
+
+    start = _now();
+    for (ii = 0; (ii < count) && (ok == true); ii++)
+    {
+        ok = sdl_symtab_insert(&symtab,
+                               blocks[ii].id,
+                               blocks[ii].typeID,
+                               &blocks[ii]) == SDL_NORMAL;
+    }
+    for (ii = 0; (ii < count) && (ok == true); ii++)
+    {
+        char name[32];
+
+        sprintf(name, "SYM_%d$NAME", ii);
+        ok = (sdl_symtab_lookup(&symtab, name) == &blocks[ii]) &&
+             (sdl_symtab_lookup_id(&symtab, blocks[ii].typeID) == &blocks[ii]);
+    }
+    elapsed = _now() - start;
+
+    /*
+     * Names and type IDs that were never inserted must not be found.
+     */
+    if (ok == true)
+    {
+        ok = (sdl_symtab_lookup(&symtab, "NOT$DEFINED") == NULL) &&
+             (sdl_symtab_lookup_id(&symtab, SDL_K_DECLARE_MIN + count) == NULL) &&
+             (sdl_symtab_lookup_id(&symtab, SDL_K_DECLARE_MIN - 1) == NULL);
+    }
+
+    /*
+     * The first name inserted wins, just as the first one found when
+     * searching the queue from the head.
+     */
+    if (ok == true)
+    {
+        SDL_DECLARE dup;
+
+        dup.id = names[0];
+        ok = (sdl_symtab_insert(&symtab, dup.id, 0, &dup) == SDL_NORMAL) &&
+             (sdl_symtab_lookup(&symtab, names[0]) == &blocks[0]);
+    }
+
+    sdl_symtab_reset(&symtab);
+    if ((ok == true) && (sdl_symtab_lookup(&symtab, names[0]) != NULL))
+    {
+        ok = false;
+    }
+    for (ii = 0; ii < count; ii++)
+    {
+        free(names[ii]);
+    }
+    free(names);
+    free(blocks);
+    return((ok == true) ? ((elapsed * 1.0e9) / count) : -1.0);
+}
+
+int main(void)
+{
+    double perSymbol[SYMTAB_K_SIZES];
+    int ii;
+
+    printf("%10s %16s\n", "symbols", "ns/symbol");
+    for (ii = 0; ii < SYMTAB_K_SIZES; ii++)
+    {
+        perSymbol[ii] = _run(_sizes[ii]);
+        if (perSymbol[ii] < 0.0)
+        {
+            printf("symtab_test: lookup failed with %d symbols\n", _sizes[ii]);
+            return(1);
+        }
+        printf("%10d %16.1f\n", _sizes[ii], perSymbol[ii]);
+    }
+    if (perSymbol[SYMTAB_K_SIZES - 1] >
+        (perSymbol[0] * SYMTAB_K_MAX_RATIO))
+    {
+        printf("symtab_test: lookups do not scale (%.1f vs %.1f ns/symbol)\n",
+               perSymbol[SYMTAB_K_SIZES - 1],
+               perSymbol[0]);
+        return(1);
+    }
+    return(0);
+}
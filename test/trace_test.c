@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, trace_test.c, verifies the trace file.  A test SDL file is
+ *  compiled to C by OpenSDL with --verbose, which writes opensdl.sdltrace, and
+ *  the OpenSDL_trace utility then turns it into text.  Every line must be an
+ *  event, in the order they were recorded, and there must be events from the
+ *  OpenSDL image and from the C language, which records them with the
+ *  function it is given by onLoad.  The utility must also refuse a file that
+ *  is not a trace file, and not crash on one that has been cut short.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "library/common/opensdl_trace.h"
+
+#define TRACE_K_LINE		1024
+
+/*
+ * The events that must be in the trace.  The first is recorded by the
+ * OpenSDL image itself, and the others by the C language.
+ */
+static const char *_events[] =
+{
+    "main",
+    "sdl_context_init",
+    "sdl_c_module",
+    "sdl_c_layout",
+    "sdl_c_constant",
+    NULL
+};
+
+/*
+ * Run the program, with standard output written to the output file, and
+ * return the exit status, or -1 if it did not exit.
+ */
+static int _run(const char *outFile, const char **args)
+{
+    int status = 0;
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        int fd = open(outFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd >= 0)
+        {
+            dup2(fd, STDOUT_FILENO);
+            close(fd);
+        }
+        execv(args[0], (char **) args);
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Check the text the utility turned the trace into, and return the number
+ * of failures.
+ */
+static int _check(const char *textFile)
+{
+    FILE *fp = fopen(textFile, "r");
+    char line[TRACE_K_LINE];
+    char file[TRACE_K_LINE];
+    char name[TRACE_K_LINE];
+    bool found[sizeof(_events) / sizeof(_events[0])];
+    double previous = 0.0;
+    double when;
+    unsigned thread, lineNo;
+    int events = 0;
+    int retVal = 0;
+    int ii;
+
+    if (fp == NULL)
+    {
+        printf("trace_test: %s was not written\n", textFile);
+        return(1);
+    }
+    memset(found, 0, sizeof(found));
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        char *paren;
+
+        if (strncmp(line, "Ring buffer ", 12) == 0)
+        {
+            continue;
+        }
+        if (sscanf(line,
+                   "%lf [%u] %[^:]:%u:%s",
+                   &when,
+                   &thread,
+                   file,
+                   &lineNo,
+                   name) != 5)
+        {
+            printf("trace_test: not an event: %s", line);
+            retVal++;
+            continue;
+        }
+        if ((paren = strchr(name, '(')) != NULL)
+        {
+            *paren = '\0';
+        }
+        if (((events == 0) && (when != 0.0)) || (when < previous))
+        {
+            printf("trace_test: event out of order: %s", line);
+            retVal++;
+        }
+        if ((strlen(file) < 3) || (strcmp(&file[strlen(file) - 2], ".c") != 0))
+        {
+            printf("trace_test: event from an unknown file: %s", line);
+            retVal++;
+        }
+        for (ii = 0; _events[ii] != NULL; ii++)
+        {
+            if (strcmp(name, _events[ii]) == 0)
+            {
+                found[ii] = true;
+            }
+        }
+        previous = when;
+        events++;
+    }
+    fclose(fp);
+    for (ii = 0; _events[ii] != NULL; ii++)
+    {
+        if (found[ii] == false)
+        {
+            printf("trace_test: no %s event in the trace\n", _events[ii]);
+            retVal++;
+        }
+    }
+    return(retVal);
+}
+
+/*
+ * Copy the first part of a file to another, and return zero if it was
+ * copied.
+ */
+static int _truncate(const char *fromFile, const char *toFile)
+{
+    FILE *inFP = fopen(fromFile, "r");
+    FILE *outFP = fopen(toFile, "w");
+    char *buffer = NULL;
+    long size = 0;
+    int retVal = -1;
+
+    if ((inFP != NULL) &&
+        (outFP != NULL) &&
+        (fseek(inFP, 0, SEEK_END) == 0) &&
+        ((size = ftell(inFP)) > 0) &&
+        (fseek(inFP, 0, SEEK_SET) == 0) &&
+        ((buffer = malloc(size)) != NULL) &&
+        (fread(buffer, 1, size, inFP) == (size_t) size) &&
+        (fwrite(buffer, 1, size / 2, outFP) == (size_t) (size / 2)))
+    {
+        retVal = 0;
+    }
+    free(buffer);
+    if (inFP != NULL)
+    {
+        fclose(inFP);
+    }
+    if ((outFP != NULL) && (fclose(outFP) != 0))
+    {
+        retVal = -1;
+    }
+    return(retVal);
+}
+
+int main(void)
+{
+#ifdef SDL_TRACE_ENABLED
+    const char *compile[] =
+    {
+        SDL_OPENSDL,
+        "--noheader",
+        "--verbose",
+        "--lang=c=test_8.h",
+        SDL_TEST_DIR "/test_8.sdl",
+        NULL
+    };
+    const char *decode[] = {SDL_OPENSDL_TRACE, NULL};
+    const char *decodeBad[] = {SDL_OPENSDL_TRACE, "bad.sdltrace", NULL};
+    const char *decodeShort[] = {SDL_OPENSDL_TRACE, "short.sdltrace", NULL};
+    char tmpDir[] = "/tmp/sdl_traceXXXXXX";
+    FILE *fp;
+    int failed = 0;
+    int status;
+
+    if ((mkdtemp(tmpDir) == NULL) || (chdir(tmpDir) != 0))
+    {
+        printf("trace_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+
+    /*
+     * Write the trace, and turn it into text.
+     */
+    if (_run("compile.out", compile) != 0)
+    {
+        printf("trace_test: compilation failed\n");
+        failed++;
+    }
+    else if (access(SDL_K_TRACE_FILE, R_OK) != 0)
+    {
+        printf("trace_test: %s was not written\n", SDL_K_TRACE_FILE);
+        failed++;
+    }
+    else if (_run("decode.out", decode) != 0)
+    {
+        printf("trace_test: %s could not be turned into text\n",
+               SDL_K_TRACE_FILE);
+        failed++;
+    }
+    else
+    {
+        failed += _check("decode.out");
+    }
+
+    /*
+     * A file that is not a trace file is refused, and one that has been cut
+     * short does not crash the utility.
+     */
+    if (((fp = fopen("bad.sdltrace", "w")) == NULL) ||
+        (fputs("This is not a trace file.\n", fp) < 0) ||
+        (fclose(fp) != 0))
+    {
+        printf("trace_test: unable to write bad.sdltrace\n");
+        failed++;
+    }
+    else if (_run("bad.out", decodeBad) != 1)
+    {
+        printf("trace_test: bad.sdltrace was not refused\n");
+        failed++;
+    }
+    if ((failed == 0) &&
+        (_truncate(SDL_K_TRACE_FILE, "short.sdltrace") == 0))
+    {
+        status = _run("short.out", decodeShort);
+        if ((status != 0) && (status != 1))
+        {
+            printf("trace_test: short.sdltrace exited with %d\n", status);
+            failed++;
+        }
+    }
+    remove(SDL_K_TRACE_FILE);
+    remove("test_8.h");
+    remove("compile.out");
+    remove("decode.out");
+    remove("bad.sdltrace");
+    remove("bad.out");
+    remove("short.sdltrace");
+    remove("short.out");
+    if (chdir("/") == 0)
+    {
+        rmdir(tmpDir);
+    }
+
+    printf("trace_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+#else
+    printf("trace_test: tracing is not built in, 0 failed\n");
+    return(0);
+#endif
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, update_test.c, verifies update mode.  A test SDL file is
+ *  compiled to C by OpenSDL with --update and otherwise the default options,
+ *  so the output file has the header, with the time it was created, in it.
+ *  After waiting long enough for that time to be different, the same file is
+ *  compiled again, and the output file must not have been replaced, so its
+ *  modification time must not have changed.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+/*
+ * The creation time in the header is to the second, so waiting this many
+ * seconds between the compilations makes sure it would be different.
+ */
+#define UPDATE_K_WAIT		2
+
+/*
+ * Compile the input file to C with --update, writing the output file, and
+ * return the exit status.
+ */
+static int _compile(const char *inFile, const char *outFile)
+{
+    char output[PATH_MAX + 16];
+    int status = 0;
+    pid_t pid;
+
+    snprintf(output, sizeof(output), "--lang=c=%s", outFile);
+    pid = fork();
+    if (pid == 0)
+    {
+        execl(SDL_OPENSDL,
+              SDL_OPENSDL,
+              "--update",
+              output,
+              inFile,
+              (char *) NULL);
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+int main(void)
+{
+    struct stat first;
+    struct stat second;
+    char tmpDir[] = "/tmp/sdl_updateXXXXXX";
+    char outFile[PATH_MAX];
+    int failed = 0;
+
+    if ((chdir(SDL_TEST_DIR) != 0) || (mkdtemp(tmpDir) == NULL))
+    {
+        printf("update_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+    snprintf(outFile, sizeof(outFile), "%s/test_1.h", tmpDir);
+
+    /*
+     * The first compilation creates the output file.  The second one, of the
+     * same input file, must leave it alone.
+     */
+    if ((_compile("test_1.sdl", outFile) != 0) ||
+        (stat(outFile, &first) != 0))
+    {
+        printf("update_test: first compilation failed\n");
+        failed++;
+    }
+    else
+    {
+        sleep(UPDATE_K_WAIT);
+        if ((_compile("test_1.sdl", outFile) != 0) ||
+            (stat(outFile, &second) != 0))
+        {
+            printf("update_test: second compilation failed\n");
+            failed++;
+        }
+        else if ((first.st_mtim.tv_sec != second.st_mtim.tv_sec) ||
+                 (first.st_mtim.tv_nsec != second.st_mtim.tv_nsec) ||
+                 (first.st_ino != second.st_ino))
+        {
+            printf("update_test: unchanged output file was replaced\n");
+            failed++;
+        }
+    }
+    remove(outFile);
+    rmdir(tmpDir);
+
+    printf("update_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}
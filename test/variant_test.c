@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) Jonathan D. Belanger 2018.
+ *
+ *  OpenSDL is free software: you can redistribute it and/or modify it under
+ *  the terms of the GNU General Public License as published by the Free
+ *  Software Foundation, either version 3 of the License, or (at your option)
+ *  any later version.
+ *
+ *  OpenSDL is distributed in the hope that it will be useful, but WITHOUT ANY
+ *  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ *  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ *  details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with OpenSDL.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Description:
+ *
+ *  This file, variant_test.c, verifies multi-variant compilation.  A test
+ *  SDL file, whose output depends on a symbol, the word size and the
+ *  alignment, is compiled by OpenSDL with several --variant options.  The
+ *  output file for each variant must be the same as the one generated by a
+ *  separate compilation with the options of the variant, and so must the
+ *  one without a variant.  The test file also has an INCLUDE of a file that
+ *  does not exist, in a region that is inactive for every variant, which must
+ *  not be opened.
+ *
+ * Revision History:
+ *
+ *  V01.000	Oct 16, 2026	Jonathan D. Belanger
+ *  Initially written.
+ */
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#define VARIANT_K_ARGS		16
+
+static const char _input[] =
+    "MODULE variant_test;\n"
+    "IFSYMBOL never;\n"
+    "INCLUDE \"variant_missing.sdl\";\n"
+    "CONSTANT never_value EQUALS 1;\n"
+    "END_IFSYMBOL;\n"
+    "IFSYMBOL debug;\n"
+    "CONSTANT debug_value EQUALS 1;\n"
+    "ELSE;\n"
+    "CONSTANT release_value EQUALS 0;\n"
+    "END_IFSYMBOL;\n"
+    "AGGREGATE variant_rec STRUCTURE;\n"
+    "    flag BYTE;\n"
+    "    link ADDRESS;\n"
+    "    count WORD;\n"
+    "    total QUADWORD;\n"
+    "    size LONGWORD;\n"
+    "END variant_rec;\n"
+    "END_MODULE;\n";
+
+/*
+ * Each variant, and the options for a separate compilation that generates
+ * the same output file.  The first one is the compilation without a
+ * variant.
+ */
+typedef struct
+{
+    const char	*variant;
+    const char	*outFile;
+    const char	*options[4];
+} VARIANT_CASE;
+
+static const VARIANT_CASE _cases[] =
+{
+    {
+        NULL,
+        "variant_test.h",
+        {"--symbol=debug=0", NULL}
+    },
+    {
+        "--variant=v32:b32,debug=1",
+        "variant_test_v32.h",
+        {"--b32", "--symbol=debug=1", NULL}
+    },
+    {
+        "--variant=a4:align=4",
+        "variant_test_a4.h",
+        {"--align=4", "--symbol=debug=0", NULL}
+    },
+    {
+        "--variant=both:b32,align=8,debug=1",
+        "variant_test_both.h",
+        {"--b32", "--align=8", "--symbol=debug=1", NULL}
+    }
+};
+#define VARIANT_K_CASES		(sizeof(_cases) / sizeof(_cases[0]))
+
+/*
+ * Run OpenSDL with the arguments, in the directory, and return the exit
+ * status.
+ */
+static int _run(const char *dirName, const char **args)
+{
+    int status = 0;
+    pid_t pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        if (chdir(dirName) == 0)
+        {
+            execv(SDL_OPENSDL, (char **) args);
+        }
+        _exit(127);
+    }
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return(-1);
+    }
+    return(WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*
+ * Read the whole of a file into memory, and return it, or NULL if it could
+ * not be read.
+ */
+static char *_read(const char *fileName)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *retVal = NULL;
+    long size;
+
+    if (fp == NULL)
+    {
+        return(NULL);
+    }
+    if ((fseek(fp, 0, SEEK_END) == 0) &&
+        ((size = ftell(fp)) >= 0) &&
+        (fseek(fp, 0, SEEK_SET) == 0) &&
+        ((retVal = malloc(size + 1)) != NULL))
+    {
+        if (fread(retVal, 1, size, fp) == (size_t) size)
+        {
+            retVal[size] = '\0';
+        }
+        else
+        {
+            free(retVal);
+            retVal = NULL;
+        }
+    }
+    fclose(fp);
+    return(retVal);
+}
+
+/*
+ * Return true if the two files have the same contents.
+ */
+static bool _same(const char *first, const char *second)
+{
+    char *firstBuf = _read(first);
+    char *secondBuf = _read(second);
+    bool retVal;
+
+    retVal = (firstBuf != NULL) && (secondBuf != NULL) &&
+             (strcmp(firstBuf, secondBuf) == 0);
+    free(firstBuf);
+    free(secondBuf);
+    return(retVal);
+}
+
+int main(void)
+{
+    char tmpDir[] = "/tmp/sdl_variantXXXXXX";
+    const char *args[VARIANT_K_ARGS];
+    char output[PATH_MAX];
+    char first[PATH_MAX];
+    char second[PATH_MAX];
+    FILE *fp;
+    int failed = 0;
+    int count;
+    int ii, jj;
+
+    if ((mkdtemp(tmpDir) == NULL) ||
+        (chdir(tmpDir) != 0) ||
+        (mkdir("variants", 0755) != 0) ||
+        (mkdir("separate", 0755) != 0) ||
+        ((fp = fopen("variant_test.sdl", "w")) == NULL) ||
+        (fputs(_input, fp) < 0) ||
+        (fclose(fp) != 0))
+    {
+        printf("variant_test: unable to set up (%s)\n", strerror(errno));
+        return(1);
+    }
+    setenv("SDL_SHARED_LIBRARY_PATH", SDL_PLUGIN_DIR, 1);
+
+    /*
+     * Compile all the variants at once.  The symbol that is never turned on
+     * is given a value, so that the only thing that can go wrong with the
+     * INCLUDE is opening it.
+     */
+    count = 0;
+    args[count++] = SDL_OPENSDL;
+    args[count++] = "--noheader";
+    args[count++] = "--symbol=never=0";
+    args[count++] = "--symbol=debug=0";
+    for (ii = 0; ii < VARIANT_K_CASES; ii++)
+    {
+        if (_cases[ii].variant != NULL)
+        {
+            args[count++] = _cases[ii].variant;
+        }
+    }
+    args[count++] = "--lang=c=variant_test.h";
+    args[count++] = "../variant_test.sdl";
+    args[count] = NULL;
+    if (_run("variants", args) != 0)
+    {
+        printf("variant_test: compilation of the variants failed\n");
+        failed++;
+    }
+
+    /*
+     * Compile each variant on its own, and compare the output files.
+     */
+    for (ii = 0; ((ii < VARIANT_K_CASES) && (failed == 0)); ii++)
+    {
+        count = 0;
+        args[count++] = SDL_OPENSDL;
+        args[count++] = "--noheader";
+        args[count++] = "--symbol=never=0";
+        for (jj = 0; _cases[ii].options[jj] != NULL; jj++)
+        {
+            args[count++] = _cases[ii].options[jj];
+        }
+        snprintf(output, sizeof(output), "--lang=c=%s", _cases[ii].outFile);
+        args[count++] = output;
+        args[count++] = "../variant_test.sdl";
+        args[count] = NULL;
+        snprintf(first, sizeof(first), "variants/%s", _cases[ii].outFile);
+        snprintf(second, sizeof(second), "separate/%s", _cases[ii].outFile);
+        if (_run("separate", args) != 0)
+        {
+            printf("variant_test: separate compilation of %s failed\n",
+                   _cases[ii].outFile);
+            failed++;
+        }
+        else if (_same(first, second) == false)
+        {
+            printf("variant_test: %s differs from a separate compilation\n",
+                   _cases[ii].outFile);
+            failed++;
+        }
+    }
+    for (ii = 0; ii < VARIANT_K_CASES; ii++)
+    {
+        snprintf(first, sizeof(first), "variants/%s", _cases[ii].outFile);
+        snprintf(second, sizeof(second), "separate/%s", _cases[ii].outFile);
+        remove(first);
+        remove(second);
+    }
+    rmdir("variants");
+    rmdir("separate");
+    remove("variant_test.sdl");
+    if (chdir("/") == 0)
+    {
+        rmdir(tmpDir);
+    }
+
+    printf("variant_test: %d failed\n", failed);
+    return((failed == 0) ? 0 : 1);
+}